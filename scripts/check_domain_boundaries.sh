@@ -122,13 +122,21 @@ check_no_matches "out-of-scope strategy markers leaked into io/mmap actor" \
   src/emel/io/mmap
 
 # v2 strategy implementations are deferred. Until those milestones land, no
-# src/ code should declare async, device, or copy strategy guards/states.
+# src/ code should declare device or copy strategy guards/states.
 # (Staged-read and external-buffer routing legitimately exists today only in
 # src/emel/io/loader, so they are excluded here.)
 check_no_matches "deferred v2 strategy implementations leaked into src/" \
-  'strategy_async|strategy_device|strategy_copy' \
+  'strategy_device|strategy_copy' \
   src
 
+# The async_read strategy is routed only by the strategy selectors: io/loader
+# picks the actor and model/loader sizes its storage. The actor itself and the
+# other strategies never name it.
+check_no_matches "async strategy routing outside the strategy selectors" \
+  'strategy_async' \
+  src/emel/io/async_read src/emel/io/read src/emel/io/staged_read \
+  src/emel/io/mmap src/emel/model/tensor
+
 # VAL-02: tensor residency lifecycle ownership stays in model/tensor.
 # Loader, mmap, and io must never write or branch on the lifecycle::*
 # residency enumerators (mmap_resident, resident, evicted, none). Tools and
@@ -0,0 +1,18 @@
+#pragma once
+
+#include <cstdint>
+
+// Owner-injected time for every opt-in instrument (model::load_profile,
+// text::generator::latency, trace, the tensor window's adaptive prefetch).
+//
+// src/emel never reads an OS clock: the owner allocates the instrument's
+// recorder, injects a monotonic nanosecond clock_fn and hands the pointer to
+// the actors through their events or runtime policy. Every instrumented site
+// accepts a null recorder (or clock) and then costs one compare, so an
+// uninstrumented run pays nothing measurable. kernel::profile follows the
+// same contract with a counter-read callback instead of a clock.
+namespace emel {
+
+using clock_fn = uint64_t (*)() noexcept;
+
+}  // namespace emel
@@ -1,10 +1,13 @@
 #pragma once
 
+#include <array>
 #include <cstddef>
+#include <cstdint>
 #include <span>
 #include <vector>
 
 #include "emel/kernel/sm.hpp"
+#include "emel/memory/footprint.hpp"
 
 namespace emel::diarization::sortformer::detail {
 
@@ -15,6 +18,29 @@ struct dense_weight_cache {
   std::vector<float> lhs_4row = {};
 };
 
+inline uint64_t prepared_bytes(const dense_weight_cache & cache) noexcept {
+  return emel::memory::footprint::bytes_of(cache.lhs_4row);
+}
+
+template <size_t count>
+uint64_t prepared_bytes(const std::array<dense_weight_cache, count> & caches) noexcept {
+  uint64_t bytes = 0u;
+  for (const dense_weight_cache & cache : caches) {
+    bytes += prepared_bytes(cache);
+  }
+  return bytes;
+}
+
+// Counts the tensor a contract view is bound to; unbound views add nothing.
+template <class tensor_view_type>
+void add_bound_tensor(emel::memory::footprint::report & out,
+                      const tensor_view_type & view,
+                      const emel::memory::footprint::probe & residency) noexcept {
+  if (view.tensor != nullptr) {
+    emel::memory::footprint::add_tensor(out, *view.tensor, residency);
+  }
+}
+
 float compute_dot_64(const float *lhs, const float *rhs) noexcept;
 
 float compute_dot_24(const float *lhs, const float *rhs) noexcept;
@@ -12,18 +12,7 @@ constexpr std::string_view k_filter_bank_name = "prep.feat.fb";
 constexpr std::string_view k_window_name = "prep.feat.win";
 constexpr float k_pi = 3.14159265358979323846f;
 
-const emel::model::data::tensor_record * find_tensor(
-    const emel::model::data & model_data,
-    const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
-    const auto & tensor = model_data.tensors[index];
-    if (emel::model::tensor_name_view(model_data, tensor) == name) {
-      return &tensor;
-    }
-  }
-
-  return nullptr;
-}
+using emel::model::find_tensor;
 
 bool tensor_has_shape(const emel::model::data::tensor_record & tensor,
                       const int32_t n_dims,
@@ -174,6 +174,40 @@ inline void publish_hidden_stage(const event::execute_run & runtime_ev,
   runtime_ev.request.hidden_dim_out = detail::k_hidden_dim;
 }
 
+inline void add_memory_footprint(const context & ctx,
+                                 emel::memory::footprint::report & out,
+                                 const emel::memory::footprint::probe & residency) noexcept {
+  namespace footprint = emel::memory::footprint;
+  namespace sortformer_detail = emel::diarization::sortformer::detail;
+  for (const auto & layer : ctx.transformer.layers) {
+    for (const auto * view : {&layer.key_bias, &layer.key_weight, &layer.output_bias,
+                              &layer.output_weight, &layer.query_bias, &layer.query_weight,
+                              &layer.value_bias, &layer.value_weight,
+                              &layer.layer_norm_1_bias, &layer.layer_norm_1_weight,
+                              &layer.layer_norm_2_bias, &layer.layer_norm_2_weight,
+                              &layer.feed_forward_in_bias, &layer.feed_forward_in_weight,
+                              &layer.feed_forward_out_bias, &layer.feed_forward_out_weight}) {
+      sortformer_detail::add_bound_tensor(out, *view, residency);
+    }
+  }
+
+  const auto & workspace = ctx.transformer_workspace;
+  out.prepared_weight_bytes +=
+      sortformer_detail::prepared_bytes(ctx.encoder_projection_weight_cache) +
+      sortformer_detail::prepared_bytes(workspace.attention_weight_caches) +
+      sortformer_detail::prepared_bytes(workspace.feed_forward_weight_caches);
+  out.recurrent_state_bytes += footprint::bytes_of(ctx.cache.speaker);
+  out.scratch_bytes +=
+      footprint::bytes_of(workspace.query) + footprint::bytes_of(workspace.key) +
+      footprint::bytes_of(workspace.value) + footprint::bytes_of(workspace.first_norm) +
+      footprint::bytes_of(workspace.feed_forward_rows) +
+      footprint::bytes_of(workspace.dense_transposed_input) +
+      footprint::bytes_of(workspace.dense_transposed_output) +
+      footprint::bytes_of(workspace.frame) + footprint::bytes_of(workspace.attended) +
+      footprint::bytes_of(workspace.feed_forward) + footprint::bytes_of(workspace.scores) +
+      footprint::bytes_of(ctx.hidden_a) + footprint::bytes_of(ctx.hidden_b);
+}
+
 struct effect_begin_execute {
   void operator()(const event::execute_run & runtime_ev, context &) const noexcept {
     runtime_ev.ctx.err = detail::to_error(error::none);
@@ -296,6 +330,13 @@ struct effect_publish_error_and_emit_error {
   }
 };
 
+struct effect_capture_memory_footprint {
+  void operator()(const event::capture_memory_footprint & ev,
+                  const context & ctx) const noexcept {
+    add_memory_footprint(ctx, ev.out, ev.residency);
+  }
+};
+
 struct effect_on_unexpected {
   template <class unexpected_event_type>
   void operator()(const unexpected_event_type &, context &) const noexcept {}
@@ -334,6 +375,7 @@ inline constexpr effect_publish_success_and_emit_done effect_publish_success_and
 inline constexpr effect_store_error_error effect_store_error_error{};
 inline constexpr effect_emit_error effect_emit_error{};
 inline constexpr effect_publish_error_and_emit_error effect_publish_error_and_emit_error{};
+inline constexpr effect_capture_memory_footprint effect_capture_memory_footprint{};
 inline constexpr effect_on_unexpected effect_on_unexpected{};
 
 }  // namespace emel::diarization::sortformer::executor::action
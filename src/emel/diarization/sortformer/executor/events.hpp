@@ -6,6 +6,7 @@
 #include "emel/callback.hpp"
 #include "emel/diarization/sortformer/executor/errors.hpp"
 #include "emel/error/error.hpp"
+#include "emel/memory/footprint.hpp"
 #include "emel/model/sortformer/any.hpp"
 
 namespace emel::diarization::sortformer::executor::events {
@@ -48,6 +49,11 @@ struct execute_run {
   execute_ctx & ctx;
 };
 
+// Adds the transformer weights bound by the last execute, their prepared
+// copies, the speaker cache and the layer scratch to `out`. The module
+// weights are counted by the pipeline that binds them too.
+using capture_memory_footprint = emel::memory::footprint::capture;
+
 }  // namespace emel::diarization::sortformer::executor::event
 
 namespace emel::diarization::sortformer::executor::events {
@@ -214,6 +214,12 @@ struct model {
       , sml::state<state_ready> <= sml::state<state_errored>
           + sml::completion<event::execute_run>
 
+      //------------------------------------------------------------------------------//
+      // Memory footprint.
+      , sml::state<state_ready> <= sml::state<state_ready>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint
+
       //------------------------------------------------------------------------------//
       // Unexpected events.
       , sml::state<state_ready> <= sml::state<state_ready> + sml::unexpected_event<sml::_>
@@ -300,6 +306,10 @@ struct sm : public emel::sm<model, action::context> {
     const bool accepted = base_type::process_event(runtime_ev);
     return accepted && ctx.err == detail::to_error(error::none);
   }
+
+  bool process_event(const event::capture_memory_footprint & ev) {
+    return base_type::process_event(ev);
+  }
 };
 
 using Executor = sm;
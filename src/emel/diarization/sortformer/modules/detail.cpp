@@ -41,18 +41,7 @@ bool tensor_has_expected_shape(const emel::model::data::tensor_record & tensor,
   return true;
 }
 
-const emel::model::data::tensor_record * find_tensor(
-    const emel::model::data & model_data,
-    const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
-    const auto & tensor = model_data.tensors[index];
-    if (emel::model::tensor_name_view(model_data, tensor) == name) {
-      return &tensor;
-    }
-  }
-
-  return nullptr;
-}
+using emel::model::find_tensor;
 
 bool bind_tensor(const emel::model::data & model_data,
                  const tensor_spec & spec,
@@ -16,6 +16,58 @@ inline void effect_record_kernel_result(event::run_ctx & runtime_ctx,
       static_cast<emel::error::type>(!ok);
 }
 
+inline void add_memory_footprint(const context & ctx,
+                                 emel::memory::footprint::report & out,
+                                 const emel::memory::footprint::probe & residency) noexcept {
+  namespace footprint = emel::memory::footprint;
+  namespace sortformer_detail = emel::diarization::sortformer::detail;
+  for (const auto & view : ctx.encoder.pre) {
+    sortformer_detail::add_bound_tensor(out, view, residency);
+  }
+  for (const auto & layer : ctx.encoder.layers) {
+    for (const auto & view : layer) {
+      sortformer_detail::add_bound_tensor(out, view, residency);
+    }
+  }
+  for (const auto * view : {&ctx.modules.encoder_projection_weight,
+                            &ctx.modules.encoder_projection_bias,
+                            &ctx.modules.frame_hidden_weight,
+                            &ctx.modules.frame_hidden_bias,
+                            &ctx.modules.hidden_to_speaker_weight,
+                            &ctx.modules.hidden_to_speaker_bias,
+                            &ctx.modules.speaker_hidden_to_speaker_weight,
+                            &ctx.modules.speaker_hidden_to_speaker_bias}) {
+    sortformer_detail::add_bound_tensor(out, *view, residency);
+  }
+
+  const auto & workspace = ctx.encoder_workspace;
+  out.prepared_weight_bytes +=
+      sortformer_detail::prepared_bytes(workspace.pre_output_weight_cache) +
+      sortformer_detail::prepared_bytes(workspace.attention_weight_caches) +
+      sortformer_detail::prepared_bytes(workspace.convolution_weight_caches) +
+      sortformer_detail::prepared_bytes(workspace.feed_forward_weight_caches);
+  out.scratch_bytes +=
+      footprint::bytes_of(workspace.conv0_rows) + footprint::bytes_of(workspace.stage1_rows) +
+      footprint::bytes_of(workspace.stage1_depthwise) +
+      footprint::bytes_of(workspace.stage2_depthwise) +
+      footprint::bytes_of(workspace.stage2_row) + footprint::bytes_of(workspace.flattened) +
+      footprint::bytes_of(workspace.pre_encoder_rows) +
+      footprint::bytes_of(workspace.layer_input) +
+      footprint::bytes_of(workspace.layer_output) +
+      footprint::bytes_of(workspace.layer_norm) +
+      footprint::bytes_of(workspace.layer_result) + footprint::bytes_of(workspace.query) +
+      footprint::bytes_of(workspace.key) + footprint::bytes_of(workspace.value) +
+      footprint::bytes_of(workspace.position) +
+      footprint::bytes_of(workspace.position_projection) +
+      footprint::bytes_of(workspace.feed_forward_rows) +
+      footprint::bytes_of(workspace.dense_transposed_input) +
+      footprint::bytes_of(workspace.dense_transposed_output) +
+      footprint::bytes_of(workspace.frame) + footprint::bytes_of(workspace.attended) +
+      footprint::bytes_of(workspace.feed_forward) + footprint::bytes_of(workspace.scores) +
+      footprint::bytes_of(workspace.gated) + footprint::bytes_of(ctx.features) +
+      footprint::bytes_of(ctx.encoder_frames) + footprint::bytes_of(ctx.hidden);
+}
+
 struct effect_begin_run {
   void operator()(const event::run_flow & runtime_ev, context &) const noexcept {
     runtime_ev.ctx.err = detail::to_error(error::none);
@@ -175,6 +227,16 @@ struct effect_publish_error {
   }
 };
 
+struct effect_capture_memory_footprint {
+  void operator()(const event::capture_memory_footprint & ev, context & ctx) const noexcept {
+    ev.out = {};
+    add_memory_footprint(ctx, ev.out, ev.residency);
+    ctx.executor.process_event(
+        emel::diarization::sortformer::executor::event::capture_memory_footprint{
+            ev.out, ev.residency});
+  }
+};
+
 struct effect_on_unexpected {
   template <class unexpected_event_type>
   void operator()(const unexpected_event_type &, context &) const noexcept {}
@@ -198,6 +260,7 @@ inline constexpr effect_compute_probabilities effect_compute_probabilities{};
 inline constexpr effect_decode_segments effect_decode_segments{};
 inline constexpr effect_publish_success effect_publish_success{};
 inline constexpr effect_publish_error effect_publish_error{};
+inline constexpr effect_capture_memory_footprint effect_capture_memory_footprint{};
 inline constexpr effect_on_unexpected effect_on_unexpected{};
 
 }  // namespace emel::diarization::sortformer::pipeline::action
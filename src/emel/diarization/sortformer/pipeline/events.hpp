@@ -6,6 +6,7 @@
 #include "emel/diarization/sortformer/output/any.hpp"
 #include "emel/diarization/sortformer/pipeline/errors.hpp"
 #include "emel/error/error.hpp"
+#include "emel/memory/footprint.hpp"
 #include "emel/model/sortformer/any.hpp"
 
 namespace emel::diarization::sortformer::pipeline::event {
@@ -53,4 +54,9 @@ struct run_flow {
   run_ctx & ctx;
 };
 
+// Fills `out` with what the pipeline and its executor hold: the weights bound
+// by the last run (none before the first), their prepared copies, the speaker
+// cache and the encoder, transformer and feature scratch.
+using capture_memory_footprint = emel::memory::footprint::capture;
+
 }  // namespace emel::diarization::sortformer::pipeline::event
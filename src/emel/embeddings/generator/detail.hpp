@@ -80,6 +80,15 @@ inline void finish_benchmark_publish(runtime_event_type & runtime_ev) noexcept {
   timings.total_ns = ev.ctx.publish_end_ns - ev.ctx.total_start_ns;
 }
 
+// Model-owned part of a footprint capture; the route adds what it prepared.
+inline void begin_memory_footprint(const event::capture_memory_footprint & ev,
+                                   const action::context & ctx) noexcept {
+  ev.out = {};
+  if (ctx.model != nullptr) {
+    emel::memory::footprint::add_model(ev.out, *ctx.model, ev.residency);
+  }
+}
+
 inline bool is_valid_preprocessor(
     const emel::text::tokenizer::preprocessor::preprocessor_kind value) noexcept {
   switch (value) {
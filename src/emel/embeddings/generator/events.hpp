@@ -7,6 +7,7 @@
 #include "emel/callback.hpp"
 #include "emel/error/error.hpp"
 #include "emel/embeddings/generator/errors.hpp"
+#include "emel/memory/footprint.hpp"
 #include "emel/text/formatter/format.hpp"
 #include "emel/text/tokenizer/events.hpp"
 
@@ -245,6 +246,9 @@ struct embed_audio_run {
   embed_audio_ctx & ctx;
 };
 
+// Resident bytes of the route by holder (emel::memory::footprint).
+using capture_memory_footprint = emel::memory::footprint::capture;
+
 }  // namespace emel::embeddings::generator::event
 
 namespace emel::embeddings::generator::events {
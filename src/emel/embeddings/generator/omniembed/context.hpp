@@ -289,6 +289,8 @@ struct scratch_buffers {
   std::unique_ptr<float[]> audio_embedding = {};
   std::unique_ptr<emel::kernel::detail::quant::block_q8_0[]> q8_input = {};
   size_t q8_input_block_capacity = 0u;
+  // Bytes requested by every allocation above (capture_memory_footprint).
+  uint64_t bytes = 0u;
   bool ready = false;
 };
 
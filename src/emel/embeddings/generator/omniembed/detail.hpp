@@ -172,16 +172,7 @@ inline void copy_name(std::array<char, 256> & buffer, const std::string_view tex
   }
 }
 
-inline const emel::model::data::tensor_record *
-find_tensor(const emel::model::data & model, const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model.n_tensors; ++index) {
-    const auto & tensor = model.tensors[index];
-    if (emel::model::tensor_name_view(model, tensor) == name) {
-      return &tensor;
-    }
-  }
-  return nullptr;
-}
+using emel::model::find_tensor;
 
 inline bool bind_vector_f32(const emel::model::data::tensor_record & tensor,
                             const int32_t expected_size,
@@ -1935,18 +1926,21 @@ inline bool reserve_scratch(action::context & ctx, const emel::model::data & mod
   const size_t q8_block_capacity =
       max_q8_cols / static_cast<size_t>(emel::kernel::detail::quant::QK8_0);
 
-  auto allocate_i32 = [](const size_t count) noexcept {
+  action::scratch_buffers scratch = {};
+  auto allocate_i32 = [&scratch](const size_t count) noexcept {
+    scratch.bytes += count * sizeof(int32_t);
     return std::unique_ptr<int32_t[]>{new (std::nothrow) int32_t[count]};
   };
-  auto allocate_f32 = [](const size_t count) noexcept {
+  auto allocate_f32 = [&scratch](const size_t count) noexcept {
+    scratch.bytes += count * sizeof(float);
     return std::unique_ptr<float[]>{new (std::nothrow) float[count]};
   };
-  auto allocate_q8 = [](const size_t count) noexcept {
+  auto allocate_q8 = [&scratch](const size_t count) noexcept {
+    scratch.bytes += count * sizeof(emel::kernel::detail::quant::block_q8_0);
     return std::unique_ptr<emel::kernel::detail::quant::block_q8_0[]>(
         new (std::nothrow) emel::kernel::detail::quant::block_q8_0[count]);
   };
 
-  action::scratch_buffers scratch = {};
   scratch.token_ids = allocate_i32(token_count);
   scratch.sequence_a = allocate_f32(token_count * hidden_size);
   scratch.sequence_b = allocate_f32(token_count * hidden_size);
@@ -2024,6 +2018,109 @@ inline bool reserve_scratch(action::context & ctx, const emel::model::data & mod
   return runtime(ctx).scratch.ready;
 }
 
+// Prepared-weight walk for capture_memory_footprint: the f32 expansions,
+// transposes and kernel-major packs the bind step made of the model's f16
+// tensors, sized from the view extents (the unique_ptr copies carry none).
+inline uint64_t prepared_bytes(const action::matrix_view & view) noexcept {
+  const uint64_t elements =
+      static_cast<uint64_t>(view.rows) * static_cast<uint64_t>(view.cols);
+  const uint64_t copies = static_cast<uint64_t>(view.expanded_f32 != nullptr) +
+      static_cast<uint64_t>(view.transposed_f32 != nullptr) +
+      static_cast<uint64_t>(view.packed_rhs_f32 != nullptr);
+  return copies * elements * sizeof(float);
+}
+
+inline uint64_t prepared_bytes(const action::conv2d_view & view) noexcept {
+  const uint64_t elements = static_cast<uint64_t>(view.kernel_w) *
+      static_cast<uint64_t>(view.kernel_h) * static_cast<uint64_t>(view.input_channels) *
+      static_cast<uint64_t>(view.output_channels);
+  const uint64_t copies = static_cast<uint64_t>(view.expanded_f32 != nullptr) +
+      static_cast<uint64_t>(view.kernel_major_storage != nullptr) +
+      static_cast<uint64_t>(view.depthwise_kernel_major_storage != nullptr);
+  return copies * elements * sizeof(float);
+}
+
+inline uint64_t prepared_bytes(const action::batch_norm_view & view) noexcept {
+  const uint64_t copies = static_cast<uint64_t>(view.scale_storage != nullptr) +
+      static_cast<uint64_t>(view.shift_storage != nullptr);
+  return copies * static_cast<uint64_t>(view.channels) * sizeof(float);
+}
+
+inline uint64_t prepared_bytes(const action::projection_runtime & projection) noexcept {
+  return prepared_bytes(projection.expand) + prepared_bytes(projection.residual) +
+      prepared_bytes(projection.project);
+}
+
+inline uint64_t prepared_bytes(const action::conv_norm_runtime & block) noexcept {
+  return prepared_bytes(block.conv) + prepared_bytes(block.norm);
+}
+
+inline uint64_t prepared_bytes(const action::audio_conv_norm_runtime & block) noexcept {
+  return prepared_bytes(block.conv) + prepared_bytes(block.norm);
+}
+
+inline uint64_t prepared_bytes(const action::text_runtime & text) noexcept {
+  uint64_t bytes = prepared_bytes(text.word_embeddings) +
+      prepared_bytes(text.position_embeddings) + prepared_bytes(text.token_type_embeddings) +
+      prepared_bytes(text.dense) + prepared_bytes(text.projection);
+  for (const action::layer_weights & layer : text.layers) {
+    bytes += prepared_bytes(layer.attention_query) + prepared_bytes(layer.attention_key) +
+        prepared_bytes(layer.attention_value) + prepared_bytes(layer.attention_output) +
+        prepared_bytes(layer.intermediate) + prepared_bytes(layer.output);
+  }
+  return bytes;
+}
+
+inline uint64_t prepared_bytes(const action::image_runtime & image) noexcept {
+  uint64_t bytes = prepared_bytes(image.stem) + prepared_bytes(image.stem_bn) +
+      prepared_bytes(image.stage0.conv_exp) + prepared_bytes(image.stage0.bn1) +
+      prepared_bytes(image.stage0.conv_pwl) + prepared_bytes(image.stage0.bn2) +
+      prepared_bytes(image.stage4) + prepared_bytes(image.head) +
+      prepared_bytes(image.projection);
+  for (const action::universal_inverted_runtime & block : image.blocks) {
+    bytes += prepared_bytes(block.dw_start) + prepared_bytes(block.dw_start_bn) +
+        prepared_bytes(block.pw_exp) + prepared_bytes(block.pw_exp_bn) +
+        prepared_bytes(block.dw_mid) + prepared_bytes(block.dw_mid_bn) +
+        prepared_bytes(block.pw_proj) + prepared_bytes(block.pw_proj_bn);
+  }
+  return bytes;
+}
+
+// The mel filterbank and FFT tables are derived once at bind and count with
+// the prepared weights.
+inline uint64_t prepared_bytes(const action::audio_runtime & audio) noexcept {
+  const uint64_t n_fft = static_cast<uint64_t>(std::max(audio.n_fft, 0));
+  const uint64_t mel_bins = static_cast<uint64_t>(std::max(audio.num_mel_bins, 0));
+  uint64_t bytes = prepared_bytes(audio.stem) + prepared_bytes(audio.head) +
+      prepared_bytes(audio.projection);
+  for (const action::audio_inverted_residual_runtime & block : audio.blocks) {
+    bytes += prepared_bytes(block.expand) + prepared_bytes(block.expand_bn) +
+        prepared_bytes(block.depthwise) + prepared_bytes(block.depthwise_bn) +
+        prepared_bytes(block.se.fc1) + prepared_bytes(block.se.fc2) +
+        prepared_bytes(block.project) + prepared_bytes(block.project_bn);
+  }
+  bytes += static_cast<uint64_t>(audio.fft_window != nullptr) * n_fft * sizeof(float) +
+      static_cast<uint64_t>(audio.mel_filters != nullptr) * mel_bins * (n_fft / 2u + 1u) *
+          sizeof(float) +
+      static_cast<uint64_t>(audio.fft_twiddle_cos != nullptr) * (n_fft / 2u) * sizeof(float) +
+      static_cast<uint64_t>(audio.fft_twiddle_sin != nullptr) * (n_fft / 2u) * sizeof(float) +
+      static_cast<uint64_t>(audio.fft_bit_reverse != nullptr) * n_fft * sizeof(int32_t) +
+      static_cast<uint64_t>(audio.mel_bin_start != nullptr) * mel_bins * sizeof(int32_t) +
+      static_cast<uint64_t>(audio.mel_bin_end != nullptr) * mel_bins * sizeof(int32_t);
+  return bytes;
+}
+
+inline void capture_memory_footprint(const action::context & ctx,
+                                     emel::memory::footprint::report & out) noexcept {
+  const auto * state = runtime_state_or_null(ctx);
+  if (state == nullptr) {
+    return;
+  }
+  out.prepared_weight_bytes += prepared_bytes(state->text) + prepared_bytes(state->image) +
+      prepared_bytes(state->audio);
+  out.scratch_bytes += state->scratch.bytes;
+}
+
 inline bool is_valid_preprocessor(
     const emel::text::tokenizer::preprocessor::preprocessor_kind value) noexcept {
   switch (value) {
@@ -63,6 +63,14 @@ struct route {
       emel::embeddings::generator::detail::finish_benchmark_encode(ev);
     }
   };
+
+  struct effect_capture_memory_footprint {
+    void operator()(const event::capture_memory_footprint & ev,
+                    const action::context & ctx) const noexcept {
+      emel::embeddings::generator::detail::begin_memory_footprint(ev, ctx);
+      detail::capture_memory_footprint(ctx, ev.out);
+    }
+  };
 };
 
 }  // namespace emel::embeddings::generator::omniembed
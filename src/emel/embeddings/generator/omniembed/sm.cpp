@@ -41,4 +41,10 @@ void run_audio_embedding(const event::embed_audio_run & ev,
   detail::finish_benchmark_encode(ev);
 }
 
+void capture_memory_footprint(const event::capture_memory_footprint & ev,
+                              const action::context & ctx) noexcept {
+  detail::begin_memory_footprint(ev, ctx);
+  omniembed::detail::capture_memory_footprint(ctx, ev.out);
+}
+
 }  // namespace emel::embeddings::generator::component_route
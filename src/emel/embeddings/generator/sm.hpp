@@ -316,6 +316,21 @@ struct model {
       , sml::state<state_errored> <= sml::state<state_embed_error_channel_decision>
           + sml::completion<event::embed_audio_run> [ guard::guard_no_embed_error_callback ]
 
+      //------------------------------------------------------------------------------//
+      // Footprint capture leaves the lifecycle where it is.
+      , sml::state<state_uninitialized> <= sml::state<state_uninitialized>
+          + sml::event<event::capture_memory_footprint>
+          / typename Route::effect_capture_memory_footprint{}
+      , sml::state<state_idle> <= sml::state<state_idle>
+          + sml::event<event::capture_memory_footprint>
+          / typename Route::effect_capture_memory_footprint{}
+      , sml::state<state_done> <= sml::state<state_done>
+          + sml::event<event::capture_memory_footprint>
+          / typename Route::effect_capture_memory_footprint{}
+      , sml::state<state_errored> <= sml::state<state_errored>
+          + sml::event<event::capture_memory_footprint>
+          / typename Route::effect_capture_memory_footprint{}
+
       //------------------------------------------------------------------------------//
       , sml::state<state_uninitialized> <= sml::state<state_uninitialized> + sml::unexpected_event<sml::_>
           / action::effect_reject_unexpected
@@ -377,6 +392,8 @@ void run_image_embedding(const event::embed_image_run & ev,
                          action::context & ctx) noexcept;
 void run_audio_embedding(const event::embed_audio_run & ev,
                          action::context & ctx) noexcept;
+void capture_memory_footprint(const event::capture_memory_footprint & ev,
+                              const action::context & ctx) noexcept;
 
 }  // namespace component_route
 
@@ -432,6 +449,13 @@ struct route {
       component_route::run_audio_embedding(ev, ctx);
     }
   };
+
+  struct effect_capture_memory_footprint {
+    void operator()(const event::capture_memory_footprint & ev,
+                    const action::context & ctx) const noexcept {
+      component_route::capture_memory_footprint(ev, ctx);
+    }
+  };
 };
 
 template <class Route>
@@ -487,6 +511,10 @@ struct basic_sm : public emel::sm<model<Route>, action::context> {
     const bool accepted = base_type::process_event(runtime);
     return accepted && ctx.err == detail::to_error(error::none);
   }
+
+  bool process_event(const event::capture_memory_footprint & ev) {
+    return base_type::process_event(ev);
+  }
 };
 
 using sm = basic_sm<route>;
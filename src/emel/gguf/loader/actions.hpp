@@ -1,5 +1,8 @@
 #pragma once
 
+#include <algorithm>
+#include <cstdint>
+
 #include "emel/gguf/loader/context.hpp"
 #include "emel/gguf/loader/detail.hpp"
 #include "emel/gguf/loader/events.hpp"
@@ -57,7 +60,13 @@ struct mark_parse_capacity {
 
 struct exec_probe {
   void operator()(const event::probe_runtime & ev, context & ctx) const noexcept {
+    const uint64_t started = emel::model::load_profile::start(ev.request.profile);
     ev.ctx.err = loader::detail::probe_requirements(ev.request.file_image, ev.ctx.requirements_out);
+    // Everything ahead of the tensor data is what the scan walked.
+    const uint64_t file_bytes = ev.request.file_image.size();
+    emel::model::load_profile::stop(
+        ev.request.profile, emel::model::load_profile::phase::gguf_header, started,
+        file_bytes - std::min(file_bytes, ev.ctx.requirements_out.tensor_data_bytes));
     ctx.probed = ev.ctx.requirements_out;
     ctx.kv_arena = {};
     ctx.kv_entries = {};
@@ -82,12 +91,16 @@ struct exec_bind {
 
 struct exec_parse {
   void operator()(const event::parse_runtime & ev, context & ctx) const noexcept {
+    const uint64_t started = emel::model::load_profile::start(ev.request.profile);
     ev.ctx.err = loader::detail::parse_bound_storage(
         ev.request.file_image,
         ctx.kv_arena,
         ctx.kv_entries,
         ctx.tensors,
         ctx.probed);
+    emel::model::load_profile::stop(
+        ev.request.profile, emel::model::load_profile::phase::gguf_metadata, started,
+        ctx.kv_arena.size());
   }
 };
 
@@ -7,6 +7,7 @@
 #include "emel/error/error.hpp"
 #include "emel/gguf/loader/errors.hpp"
 #include "emel/model/data.hpp"
+#include "emel/model/load_profile.hpp"
 
 namespace emel::gguf::loader {
 
@@ -51,6 +52,7 @@ struct probe {
   requirements & requirements_out;
   const probe_done_fn & on_done;
   const probe_error_fn & on_error;
+  emel::model::load_profile::recorder * profile = nullptr;
 
   probe(std::span<const uint8_t> file_image_in,
         requirements & requirements_out_in,
@@ -85,6 +87,7 @@ struct parse {
   std::span<const uint8_t> file_image = {};
   const parse_done_fn & on_done;
   const parse_error_fn & on_error;
+  emel::model::load_profile::recorder * profile = nullptr;
 
   parse(std::span<const uint8_t> file_image_in,
         const parse_done_fn & on_done_in,
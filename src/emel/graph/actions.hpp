@@ -126,6 +126,8 @@ inline processor::event::execute bind_execute_request(const compute_event & ev,
     .bind_inputs = ev.request.bind_inputs,
     .run_kernel = ev.request.run_kernel,
     .extract_outputs = ev.request.extract_outputs,
+    .kernel_plan = ev.request.kernel_plan,
+    .kernel_dispatch = ev.request.kernel_dispatch,
     .dispatch_done = {&capture, on_execute_done},
     .dispatch_error = {&capture, on_execute_error},
   };
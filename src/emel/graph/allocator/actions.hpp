@@ -12,6 +12,9 @@ inline void reset_plan(event::allocation_plan & plan) noexcept {
   plan.tensor_count = 0;
   plan.interval_count = 0;
   plan.required_buffer_bytes = 0;
+  plan.naive_buffer_bytes = 0;
+  plan.peak_live_bytes = 0;
+  plan.inplace_count = 0;
 }
 
 struct reject_invalid_allocate_with_dispatch {
@@ -46,7 +49,10 @@ struct begin_allocate {
     ev.ctx.placement_outcome = placement_pass::events::phase_outcome::unknown;
     ev.ctx.required_intervals = 0;
     ev.ctx.sorted_tensor_count = 0;
+    ev.ctx.inplace_count = 0;
     ev.ctx.required_buffer_bytes = 0;
+    ev.ctx.naive_buffer_bytes = 0;
+    ev.ctx.peak_live_bytes = 0;
     ++ctx.dispatch_generation;
     reset_plan(*ev.request.plan_out);
   }
@@ -57,6 +63,9 @@ struct commit_plan {
     ev.request.plan_out->tensor_count = ev.ctx.sorted_tensor_count;
     ev.request.plan_out->interval_count = ev.ctx.required_intervals;
     ev.request.plan_out->required_buffer_bytes = ev.ctx.required_buffer_bytes;
+    ev.request.plan_out->naive_buffer_bytes = ev.ctx.naive_buffer_bytes;
+    ev.request.plan_out->peak_live_bytes = ev.ctx.peak_live_bytes;
+    ev.request.plan_out->inplace_count = ev.ctx.inplace_count;
   }
 };
 
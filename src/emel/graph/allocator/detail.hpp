@@ -0,0 +1,237 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <limits>
+#include <span>
+
+#include "emel/graph/allocator/events.hpp"
+
+// Size-aware activation planning for allocate_graph requests that describe
+// their tensors (event::tensor_desc). Staged: no assembler pass fills
+// tensor_desc yet, so reserve/assemble still plan bytes_per_tensor slots.
+//
+//   liveness:  validate the intervals and fold in-place outputs into the slot
+//              of the input they overwrite, so a chain of in-place ops is one
+//              slot living from the first producer to the last consumer.
+//   ordering:  slots largest-first (greedy-by-size), earliest producer first
+//              among equal sizes.
+//   placement: best fit; each slot takes the tightest aligned gap left by the
+//              already placed slots whose live ranges intersect its own, and
+//              only grows the arena when no gap fits.
+//
+// The arena is then bounded by the live set, not by tensor count x max size.
+// Ordering is O(n log n) and placement O(n^2) in the slot count (one
+// offset-ordered sweep of the placed slots per slot); both run once per
+// reserve, never per step.
+namespace emel::graph::allocator::detail {
+
+inline constexpr uint32_t k_default_alignment = 64u;
+
+inline uint64_t align_up(const uint64_t value, const uint64_t alignment) noexcept {
+  return (value + alignment - 1u) & ~(alignment - 1u);
+}
+
+inline uint32_t alignment_of(const event::tensor_desc & tensor) noexcept {
+  return tensor.alignment == 0u ? k_default_alignment : tensor.alignment;
+}
+
+inline bool is_power_of_two(const uint32_t value) noexcept {
+  return value != 0u && (value & (value - 1u)) == 0u;
+}
+
+inline bool tensor_desc_valid(const event::tensor_desc & tensor, const uint32_t index,
+                              const uint32_t node_count) noexcept {
+  return tensor.bytes != 0u &&
+         tensor.bytes <= std::numeric_limits<uint64_t>::max() / 2u &&
+         (tensor.alignment == 0u || is_power_of_two(tensor.alignment)) &&
+         tensor.producer <= tensor.last_consumer &&
+         tensor.last_consumer < node_count &&
+         tensor.inplace_source < static_cast<int32_t>(index);
+}
+
+// Whether the request's tensor, placement and order spans describe exactly
+// tensor_count tensors with well-formed live intervals.
+inline bool described_request_valid(const event::allocate_graph & request) noexcept {
+  if (request.tensors.size() != request.tensor_count ||
+      request.placements_out.size() != request.tensor_count ||
+      request.allocation_order.size() != request.tensor_count) {
+    return false;
+  }
+  for (uint32_t index = 0; index < request.tensor_count; ++index) {
+    if (!tensor_desc_valid(request.tensors[index], index, request.node_count)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+struct liveness_summary {
+  uint32_t slot_count = 0;
+  uint32_t inplace_count = 0;
+  uint64_t naive_bytes = 0;
+  uint64_t peak_live_bytes = 0;
+};
+
+// Whether `producer` already writes the slot rooted at `root`, either as the
+// root itself or as an earlier in-place output folded into it.
+inline bool slot_written_by(const std::span<const event::tensor_placement> placements,
+                            const uint32_t root, const uint32_t limit,
+                            const uint32_t producer) noexcept {
+  if (placements[root].live_begin == producer) {
+    return true;
+  }
+  for (uint32_t index = root + 1u; index < limit; ++index) {
+    if (placements[index].inplace_of == static_cast<int32_t>(root) &&
+        placements[index].live_begin == producer) {
+      return true;
+    }
+  }
+  return false;
+}
+
+// An output may take over its input's slot when the op reading the input is
+// that input's last consumer and the output fits the slot's size and
+// alignment. A slot takes at most one output per op: a second output of the
+// same node (possible when the first is unread, so the slot still ends at
+// that node) keeps its own slot. The request must have passed
+// described_request_valid().
+inline liveness_summary build_live_intervals(const event::allocate_graph & request) noexcept {
+  const std::span<const event::tensor_desc> tensors = request.tensors;
+  const std::span<event::tensor_placement> placements = request.placements_out;
+  liveness_summary summary{};
+  for (uint32_t index = 0; index < tensors.size(); ++index) {
+    const event::tensor_desc & tensor = tensors[index];
+    const uint64_t slot_bytes = align_up(tensor.bytes, alignment_of(tensor));
+    summary.naive_bytes += slot_bytes;
+    placements[index] = event::tensor_placement{
+      .offset = 0u,
+      .bytes = slot_bytes,
+      .live_begin = tensor.producer,
+      .live_end = tensor.last_consumer,
+      .inplace_of = -1,
+    };
+    if (tensor.inplace_source < 0) {
+      continue;
+    }
+    const auto source = static_cast<uint32_t>(tensor.inplace_source);
+    const uint32_t root = placements[source].inplace_of < 0
+                              ? source
+                              : static_cast<uint32_t>(placements[source].inplace_of);
+    event::tensor_placement & slot = placements[root];
+    if (slot.live_end != tensor.producer || slot_bytes > slot.bytes ||
+        alignment_of(tensor) > alignment_of(tensors[root]) ||
+        slot_written_by(placements, root, index, tensor.producer)) {
+      continue;
+    }
+    slot.live_end = tensor.last_consumer;
+    placements[index].inplace_of = static_cast<int32_t>(root);
+    ++summary.inplace_count;
+  }
+
+  summary.slot_count = static_cast<uint32_t>(tensors.size()) - summary.inplace_count;
+  for (uint32_t node = 0; node < request.node_count; ++node) {
+    uint64_t live_bytes = 0u;
+    for (const event::tensor_placement & slot : placements) {
+      const bool live = slot.inplace_of < 0 && slot.live_begin <= node && node <= slot.live_end;
+      live_bytes += live ? slot.bytes : 0u;
+    }
+    summary.peak_live_bytes = std::max(summary.peak_live_bytes, live_bytes);
+  }
+  return summary;
+}
+
+// Writes the slot roots into allocation_order, largest first, followed by
+// the in-place tensors; returns the number of slot roots.
+inline uint32_t order_slots_by_size(const event::allocate_graph & request) noexcept {
+  const std::span<const event::tensor_placement> placements = request.placements_out;
+  const std::span<uint32_t> order = request.allocation_order;
+  uint32_t count = 0u;
+  for (uint32_t index = 0; index < placements.size(); ++index) {
+    if (placements[index].inplace_of < 0) {
+      order[count++] = index;
+    }
+  }
+  std::sort(order.begin(), order.begin() + count,
+            [placements](const uint32_t lhs, const uint32_t rhs) noexcept {
+              const event::tensor_placement & a = placements[lhs];
+              const event::tensor_placement & b = placements[rhs];
+              if (a.bytes != b.bytes) {
+                return a.bytes > b.bytes;
+              }
+              if (a.live_begin != b.live_begin) {
+                return a.live_begin < b.live_begin;
+              }
+              return lhs < rhs;
+            });
+  uint32_t tail = count;
+  for (uint32_t index = 0; index < placements.size(); ++index) {
+    if (placements[index].inplace_of >= 0) {
+      order[tail++] = index;
+    }
+  }
+  return count;
+}
+
+inline bool live_ranges_overlap(const event::tensor_placement & a,
+                                const event::tensor_placement & b) noexcept {
+  return a.live_begin <= b.live_end && b.live_begin <= a.live_end;
+}
+
+// Best-fit offsets for the first slot_count entries of allocation_order, then
+// in-place tensors inherit their slot's offset. Returns the arena size.
+//
+// The placed prefix of allocation_order is kept sorted by offset, so each
+// slot finds its tightest gap in one sweep over the placed slots (skipping
+// those whose live ranges miss it) and is then inserted into the prefix:
+// O(slot_count) per slot. On return allocation_order[0, slot_count) lists the
+// slots by offset rather than by size.
+inline uint64_t assign_offsets(const event::allocate_graph & request,
+                               const uint32_t slot_count) noexcept {
+  const std::span<event::tensor_placement> placements = request.placements_out;
+  const std::span<uint32_t> order = request.allocation_order;
+  uint64_t arena_bytes = 0u;
+  for (uint32_t rank = 0; rank < slot_count; ++rank) {
+    const uint32_t slot_index = order[rank];
+    event::tensor_placement & slot = placements[slot_index];
+    const uint64_t alignment = alignment_of(request.tensors[slot_index]);
+    uint64_t best_offset = 0u;
+    uint64_t best_gap = std::numeric_limits<uint64_t>::max();
+    // candidate is the aligned end of every conflicting slot swept so far; the
+    // next conflicting slot at or past it closes a free gap.
+    uint64_t candidate = 0u;
+    for (uint32_t placed_rank = 0; placed_rank < rank; ++placed_rank) {
+      const event::tensor_placement & placed = placements[order[placed_rank]];
+      if (!live_ranges_overlap(slot, placed)) {
+        continue;
+      }
+      if (placed.offset >= candidate) {
+        const uint64_t gap = placed.offset - candidate;
+        if (gap >= slot.bytes && gap < best_gap) {
+          best_offset = candidate;
+          best_gap = gap;
+        }
+      }
+      candidate = std::max(candidate, align_up(placed.offset + placed.bytes, alignment));
+    }
+    // No enclosed gap fits: take the open tail past every conflicting slot.
+    slot.offset = best_gap == std::numeric_limits<uint64_t>::max() ? candidate : best_offset;
+    arena_bytes = std::max(arena_bytes, slot.offset + slot.bytes);
+    uint32_t insert_rank = rank;
+    while (insert_rank > 0u && placements[order[insert_rank - 1u]].offset > slot.offset) {
+      order[insert_rank] = order[insert_rank - 1u];
+      --insert_rank;
+    }
+    order[insert_rank] = slot_index;
+  }
+  for (event::tensor_placement & placement : placements) {
+    if (placement.inplace_of >= 0) {
+      const event::tensor_placement & slot = placements[static_cast<size_t>(placement.inplace_of)];
+      placement.offset = slot.offset;
+      placement.bytes = slot.bytes;
+    }
+  }
+  return arena_bytes;
+}
+
+}  // namespace emel::graph::allocator::detail
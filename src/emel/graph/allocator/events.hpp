@@ -1,6 +1,7 @@
 #pragma once
 
 #include <cstdint>
+#include <span>
 
 #include "emel/callback.hpp"
 #include "emel/error/error.hpp"
@@ -22,6 +23,33 @@ struct allocation_plan {
   uint32_t tensor_count = 0;
   uint32_t interval_count = 0;
   uint64_t required_buffer_bytes = 0;
+  // Sum of every tensor's own slot, i.e. the arena without any reuse.
+  uint64_t naive_buffer_bytes = 0;
+  // Largest byte total live at a single node: the lower bound for the arena.
+  uint64_t peak_live_bytes = 0;
+  uint32_t inplace_count = 0;
+};
+
+// Per-tensor input for size-aware planning. Node indices follow execution
+// order: `producer` writes the tensor and `last_consumer` is the last node
+// reading it (== producer for an output nobody reads). Not yet supplied by
+// the assembler; see detail.hpp.
+struct tensor_desc {
+  uint64_t bytes = 0;
+  uint32_t alignment = 0;  // power of two; 0 selects detail::k_default_alignment
+  uint32_t producer = 0;
+  uint32_t last_consumer = 0;
+  // Earlier tensor the producing op may overwrite in place, or -1. Honored
+  // only when that op is the source's last consumer and the output fits.
+  int32_t inplace_source = -1;
+};
+
+struct tensor_placement {
+  uint64_t offset = 0;
+  uint64_t bytes = 0;
+  uint32_t live_begin = 0;
+  uint32_t live_end = 0;
+  int32_t inplace_of = -1;  // tensor whose slot this one reuses
 };
 
 struct allocate_graph {
@@ -37,6 +65,11 @@ struct allocate_graph {
       {};
   ::emel::callback<bool(const ::emel::graph::allocator::events::allocation_error &)>
       dispatch_error = {};
+  // Optional size-aware planning (all three spans hold tensor_count entries).
+  // When `tensors` is empty every tensor gets its own bytes_per_tensor slot.
+  std::span<const tensor_desc> tensors = {};
+  std::span<tensor_placement> placements_out = {};
+  std::span<uint32_t> allocation_order = {};
 };
 
 // Internal context object carried via completion<allocate_graph_plan>.
@@ -49,7 +82,10 @@ struct allocate_graph_ctx {
       placement_pass::events::phase_outcome::unknown;
   uint32_t required_intervals = 0;
   uint32_t sorted_tensor_count = 0;
+  uint32_t inplace_count = 0;
   uint64_t required_buffer_bytes = 0;
+  uint64_t naive_buffer_bytes = 0;
+  uint64_t peak_live_bytes = 0;
   emel::error::type err = emel::error::cast(error::none);
 };
 
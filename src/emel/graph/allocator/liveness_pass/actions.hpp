@@ -1,5 +1,6 @@
 #pragma once
 
+#include "emel/graph/allocator/detail.hpp"
 #include "emel/graph/allocator/liveness_pass/context.hpp"
 #include "emel/graph/allocator/liveness_pass/events.hpp"
 #include "emel/graph/allocator/errors.hpp"
@@ -16,6 +17,20 @@ struct mark_done {
   }
 };
 
+struct mark_done_described {
+  void operator()(const allocator::event::allocate_graph_plan & ev,
+                  context &) const noexcept {
+    const allocator::detail::liveness_summary summary =
+        allocator::detail::build_live_intervals(ev.request);
+    ev.ctx.liveness_outcome = events::phase_outcome::done;
+    ev.ctx.required_intervals = summary.slot_count;
+    ev.ctx.inplace_count = summary.inplace_count;
+    ev.ctx.naive_buffer_bytes = summary.naive_bytes;
+    ev.ctx.peak_live_bytes = summary.peak_live_bytes;
+    ev.ctx.err = emel::error::cast(allocator::error::none);
+  }
+};
+
 struct mark_failed_prefailed {
   void operator()(const allocator::event::allocate_graph_plan & ev,
                   context &) const noexcept {
@@ -58,6 +73,7 @@ struct on_unexpected {
 };
 
 inline constexpr mark_done mark_done{};
+inline constexpr mark_done_described mark_done_described{};
 inline constexpr mark_failed_prefailed mark_failed_prefailed{};
 inline constexpr mark_failed_invalid_request mark_failed_invalid_request{};
 inline constexpr mark_failed_capacity mark_failed_capacity{};
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "emel/graph/allocator/detail.hpp"
 #include "emel/graph/allocator/liveness_pass/context.hpp"
 #include "emel/graph/allocator/errors.hpp"
 #include "emel/graph/allocator/events.hpp"
@@ -20,7 +21,30 @@ struct phase_done {
            ev.request.graph_topology != nullptr &&
            ev.request.node_count != 0u &&
            ev.request.tensor_count != 0u &&
-           ev.request.tensor_count <= ev.request.tensor_capacity;
+           ev.request.tensor_count <= ev.request.tensor_capacity &&
+           ev.request.tensors.empty();
+  }
+};
+
+struct phase_done_described {
+  bool operator()(const allocator::event::allocate_graph_plan & ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(allocator::error::none) &&
+           ev.request.graph_topology != nullptr &&
+           ev.request.node_count != 0u &&
+           ev.request.tensor_count != 0u &&
+           ev.request.tensor_count <= ev.request.tensor_capacity &&
+           !ev.request.tensors.empty() &&
+           allocator::detail::described_request_valid(ev.request);
+  }
+};
+
+struct phase_invalid_described {
+  bool operator()(const allocator::event::allocate_graph_plan & ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(allocator::error::none) &&
+           !ev.request.tensors.empty() &&
+           !allocator::detail::described_request_valid(ev.request);
   }
 };
 
@@ -24,6 +24,11 @@ struct model {
                  [ guard::phase_prefailed{} ]
                  / action::mark_failed_prefailed
 
+      , sml::state<allocated> <= sml::state<deciding> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 [ guard::phase_done_described{} ]
+                 / action::mark_done_described
+
       , sml::state<allocated> <= sml::state<deciding> +
                sml::completion<allocator::event::allocate_graph_plan>
                  [ guard::phase_done{} ]
@@ -39,6 +44,11 @@ struct model {
                  [ guard::phase_capacity_exceeded{} ]
                  / action::mark_failed_capacity
 
+      , sml::state<allocate_failed> <= sml::state<deciding> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 [ guard::phase_invalid_described{} ]
+                 / action::mark_failed_invalid_request
+
       , sml::state<allocate_failed> <= sml::state<deciding> +
                sml::completion<allocator::event::allocate_graph_plan>
                  / action::mark_failed_internal
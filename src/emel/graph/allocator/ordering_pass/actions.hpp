@@ -2,6 +2,7 @@
 
 #include <cstdint>
 
+#include "emel/graph/allocator/detail.hpp"
 #include "emel/graph/allocator/ordering_pass/context.hpp"
 #include "emel/graph/allocator/ordering_pass/events.hpp"
 #include "emel/graph/allocator/errors.hpp"
@@ -16,6 +17,18 @@ struct mark_done {
     ev.ctx.sorted_tensor_count = ev.ctx.required_intervals;
     ev.ctx.required_buffer_bytes =
         static_cast<uint64_t>(ev.ctx.required_intervals) * ev.request.bytes_per_tensor;
+    ev.ctx.naive_buffer_bytes = ev.ctx.required_buffer_bytes;
+    ev.ctx.peak_live_bytes = ev.ctx.required_buffer_bytes;
+    ev.ctx.err = emel::error::cast(allocator::error::none);
+  }
+};
+
+struct mark_done_described {
+  void operator()(const allocator::event::allocate_graph_plan & ev,
+                  context &) const noexcept {
+    ev.ctx.required_intervals = allocator::detail::order_slots_by_size(ev.request);
+    ev.ctx.sorted_tensor_count = ev.request.tensor_count;
+    ev.ctx.ordering_outcome = events::phase_outcome::done;
     ev.ctx.err = emel::error::cast(allocator::error::none);
   }
 };
@@ -78,6 +91,7 @@ struct on_unexpected {
 };
 
 inline constexpr mark_done mark_done{};
+inline constexpr mark_done_described mark_done_described{};
 inline constexpr mark_failed_prefailed mark_failed_prefailed{};
 inline constexpr mark_failed_prereq mark_failed_prereq{};
 inline constexpr mark_failed_capacity mark_failed_capacity{};
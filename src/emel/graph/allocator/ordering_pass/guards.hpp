@@ -30,7 +30,19 @@ struct phase_done {
            ev.ctx.required_intervals <= ev.request.interval_capacity &&
            ev.request.bytes_per_tensor != 0u &&
            !product_overflows_u64(static_cast<uint64_t>(ev.ctx.required_intervals),
-                                  ev.request.bytes_per_tensor);
+                                  ev.request.bytes_per_tensor) &&
+           ev.request.tensors.empty();
+  }
+};
+
+struct phase_done_described {
+  bool operator()(const allocator::event::allocate_graph_plan & ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(allocator::error::none) &&
+           ev.ctx.liveness_outcome == liveness_pass::events::phase_outcome::done &&
+           ev.ctx.required_intervals != 0u &&
+           ev.ctx.required_intervals <= ev.request.interval_capacity &&
+           !ev.request.tensors.empty();
   }
 };
 
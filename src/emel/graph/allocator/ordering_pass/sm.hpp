@@ -24,6 +24,11 @@ struct model {
                  [ guard::phase_prefailed{} ]
                  / action::mark_failed_prefailed
 
+      , sml::state<allocated> <= sml::state<deciding> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 [ guard::phase_done_described{} ]
+                 / action::mark_done_described
+
       , sml::state<allocated> <= sml::state<deciding> +
                sml::completion<allocator::event::allocate_graph_plan>
                  [ guard::phase_done{} ]
@@ -1,5 +1,6 @@
 #pragma once
 
+#include "emel/graph/allocator/detail.hpp"
 #include "emel/graph/allocator/placement_pass/context.hpp"
 #include "emel/graph/allocator/placement_pass/events.hpp"
 #include "emel/graph/allocator/errors.hpp"
@@ -15,6 +16,14 @@ struct mark_done {
   }
 };
 
+struct assign_offsets {
+  void operator()(const allocator::event::allocate_graph_plan & ev,
+                  context &) const noexcept {
+    ev.ctx.required_buffer_bytes =
+        allocator::detail::assign_offsets(ev.request, ev.ctx.required_intervals);
+  }
+};
+
 struct mark_failed_prefailed {
   void operator()(const allocator::event::allocate_graph_plan & ev,
                   context &) const noexcept {
@@ -65,6 +74,7 @@ struct on_unexpected {
 };
 
 inline constexpr mark_done mark_done{};
+inline constexpr assign_offsets assign_offsets{};
 inline constexpr mark_failed_prefailed mark_failed_prefailed{};
 inline constexpr mark_failed_prereq mark_failed_prereq{};
 inline constexpr mark_failed_capacity mark_failed_capacity{};
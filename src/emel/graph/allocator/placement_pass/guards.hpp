@@ -21,10 +21,38 @@ struct phase_done {
            ev.ctx.ordering_outcome == ordering_pass::events::phase_outcome::done &&
            ev.request.plan_out != nullptr &&
            ev.ctx.sorted_tensor_count != 0u &&
+           ev.ctx.required_buffer_bytes <= ev.request.workspace_capacity_bytes &&
+           ev.request.tensors.empty();
+  }
+};
+
+struct phase_plan_described {
+  bool operator()(const allocator::event::allocate_graph_plan & ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(allocator::error::none) &&
+           ev.ctx.ordering_outcome == ordering_pass::events::phase_outcome::done &&
+           ev.request.plan_out != nullptr &&
+           ev.ctx.sorted_tensor_count != 0u &&
+           !ev.request.tensors.empty();
+  }
+};
+
+struct planned_fits {
+  bool operator()(const allocator::event::allocate_graph_plan & ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(allocator::error::none) &&
            ev.ctx.required_buffer_bytes <= ev.request.workspace_capacity_bytes;
   }
 };
 
+struct planned_capacity_exceeded {
+  bool operator()(const allocator::event::allocate_graph_plan & ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(allocator::error::none) &&
+           ev.ctx.required_buffer_bytes > ev.request.workspace_capacity_bytes;
+  }
+};
+
 struct phase_prereq_failed {
   bool operator()(const allocator::event::allocate_graph_plan & ev,
                   const action::context &) const noexcept {
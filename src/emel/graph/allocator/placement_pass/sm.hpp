@@ -8,6 +8,7 @@
 namespace emel::graph::allocator::placement_pass {
 
 struct deciding {};
+struct planned {};
 struct allocated {};
 struct allocate_failed {};
 struct unexpected_event {};
@@ -24,6 +25,11 @@ struct model {
                  [ guard::phase_prefailed{} ]
                  / action::mark_failed_prefailed
 
+      , sml::state<planned> <= sml::state<deciding> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 [ guard::phase_plan_described{} ]
+                 / action::assign_offsets
+
       , sml::state<allocated> <= sml::state<deciding> +
                sml::completion<allocator::event::allocate_graph_plan>
                  [ guard::phase_done{} ]
@@ -48,6 +54,22 @@ struct model {
                sml::completion<allocator::event::allocate_graph_plan>
                  / action::mark_failed_internal
 
+      //------------------------------------------------------------------------------//
+      // Size-aware plans check the arena against the workspace once placed.
+      , sml::state<allocated> <= sml::state<planned> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 [ guard::planned_fits{} ]
+                 / action::mark_done
+
+      , sml::state<allocate_failed> <= sml::state<planned> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 [ guard::planned_capacity_exceeded{} ]
+                 / action::mark_failed_capacity
+
+      , sml::state<allocate_failed> <= sml::state<planned> +
+               sml::completion<allocator::event::allocate_graph_plan>
+                 / action::mark_failed_internal
+
       //------------------------------------------------------------------------------//
       , sml::X <= sml::state<allocated>
       , sml::X <= sml::state<allocate_failed>
@@ -55,6 +77,8 @@ struct model {
       //------------------------------------------------------------------------------//
       , sml::state<unexpected_event> <= sml::state<deciding> + sml::unexpected_event<sml::_>
                  / action::on_unexpected
+      , sml::state<unexpected_event> <= sml::state<planned> + sml::unexpected_event<sml::_>
+                 / action::on_unexpected
       , sml::state<unexpected_event> <= sml::state<allocated> + sml::unexpected_event<sml::_>
                  / action::on_unexpected
       , sml::state<unexpected_event> <= sml::state<allocate_failed> + sml::unexpected_event<sml::_>
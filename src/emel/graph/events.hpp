@@ -88,6 +88,8 @@ struct compute {
   bind_inputs_fn bind_inputs = nullptr;
   run_kernel_fn run_kernel = nullptr;
   extract_outputs_fn extract_outputs = nullptr;
+  const processor::schedule::plan * kernel_plan = nullptr;
+  const processor::schedule::dispatch * kernel_dispatch = nullptr;
   ::emel::callback<bool(const ::emel::graph::events::compute_done &)> dispatch_done = {};
   ::emel::callback<bool(const ::emel::graph::events::compute_error &)> dispatch_error = {};
 };
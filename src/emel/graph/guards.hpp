@@ -46,7 +46,7 @@ inline bool guard_valid_compute_execution_request(const compute_request & reques
          request.seq_primary_ids_count >= 0 &&
          request.prepare_graph != nullptr &&
          request.bind_inputs != nullptr &&
-         request.run_kernel != nullptr &&
+         (request.run_kernel != nullptr || request.kernel_plan != nullptr) &&
          request.extract_outputs != nullptr &&
          static_cast<bool>(request.dispatch_done) &&
          static_cast<bool>(request.dispatch_error);
@@ -60,6 +60,7 @@ struct begin_execute {
     ev.ctx.outputs_produced = 0;
     ev.ctx.phase_callback_ok = false;
     ev.ctx.phase_callback_err = 0;
+    ev.ctx.kernel_failed_node = -1;
     ++ctx.dispatch_generation;
     reset_output(*ev.request.output_out);
   }
@@ -137,6 +138,7 @@ struct dispatch_error {
     ev.request.dispatch_error(events::execution_error{
       *ev.request.output_out,
       static_cast<int32_t>(ev.ctx.err),
+      ev.ctx.kernel_failed_node,
     });
   }
 };
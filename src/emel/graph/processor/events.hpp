@@ -17,6 +17,11 @@ namespace emel::graph::tensor {
 struct sm;
 }  // namespace emel::graph::tensor
 
+namespace emel::graph::processor::schedule {
+struct plan;
+struct dispatch;
+}  // namespace emel::graph::processor::schedule
+
 namespace emel::graph::processor::events {
 
 struct execution_done;
@@ -91,6 +96,11 @@ struct execute {
   bind_inputs_fn bind_inputs = nullptr;
   run_kernel_fn run_kernel = nullptr;
   extract_outputs_fn extract_outputs = nullptr;
+  // Optional DAG of the step's ops (schedule.hpp); when set, the kernel phase
+  // runs it wave by wave instead of calling run_kernel. No production owner
+  // sets it yet.
+  const schedule::plan * kernel_plan = nullptr;
+  const schedule::dispatch * kernel_dispatch = nullptr;
   ::emel::callback<bool(const ::emel::graph::processor::events::execution_done &)> dispatch_done =
       {};
   ::emel::callback<bool(const ::emel::graph::processor::events::execution_error &)> dispatch_error =
@@ -124,6 +134,8 @@ struct execute_ctx {
   int32_t outputs_produced = 0;
   bool phase_callback_ok = false;
   int32_t phase_callback_err = 0;
+  // Lowest kernel_plan node that failed the kernel phase; -1 when none did.
+  int32_t kernel_failed_node = -1;
   emel::error::type err = emel::error::cast(error::none);
 };
 
@@ -144,6 +156,8 @@ struct execution_done {
 struct execution_error {
   event::execution_output & output;
   int32_t err = 0;
+  // kernel_plan node behind a kernel_failed error; -1 otherwise.
+  int32_t failed_node = -1;
 };
 
 }  // namespace emel::graph::processor::events
@@ -1,9 +1,14 @@
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 #include "emel/graph/processor/kernel_step/context.hpp"
 #include "emel/graph/processor/kernel_step/events.hpp"
 #include "emel/graph/processor/errors.hpp"
 #include "emel/graph/processor/events.hpp"
+#include "emel/graph/processor/schedule.hpp"
 
 namespace emel::graph::processor::kernel_step::action {
 
@@ -16,6 +21,23 @@ struct run_callback {
   }
 };
 
+// A failed node surfaces as a callback failure without an error code, which
+// the callback_decision rows map to kernel_failed; the node id rides along to
+// the execution_error.
+struct run_schedule {
+  void operator()(const processor::event::execute_step & ev, context &) const noexcept {
+    const schedule::run_result result =
+        schedule::run_plan(*ev.request.kernel_plan, *ev.request.kernel_dispatch);
+    const std::array<int32_t, 2> failed_nodes{
+      static_cast<int32_t>(result.failed_node),
+      -1,
+    };
+    ev.ctx.phase_callback_ok = result.ok;
+    ev.ctx.phase_callback_err = 0;
+    ev.ctx.kernel_failed_node = failed_nodes[static_cast<size_t>(result.ok)];
+  }
+};
+
 struct mark_done {
   void operator()(const processor::event::execute_step & ev, context &) const noexcept {
     ev.ctx.kernel_outcome = events::phase_outcome::done;
@@ -61,6 +83,7 @@ struct on_unexpected {
 };
 
 inline constexpr run_callback run_callback{};
+inline constexpr run_schedule run_schedule{};
 inline constexpr mark_done mark_done{};
 inline constexpr mark_failed_existing_error mark_failed_existing_error{};
 inline constexpr mark_failed_callback_error mark_failed_callback_error{};
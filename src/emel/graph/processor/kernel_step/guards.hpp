@@ -3,6 +3,7 @@
 #include "emel/graph/processor/kernel_step/context.hpp"
 #include "emel/graph/processor/errors.hpp"
 #include "emel/graph/processor/events.hpp"
+#include "emel/graph/processor/schedule.hpp"
 
 namespace emel::graph::processor::kernel_step::guard {
 
@@ -12,17 +13,29 @@ struct phase_prefailed {
   }
 };
 
+struct phase_request_schedule {
+  bool operator()(const processor::event::execute_step & ev, const action::context &) const noexcept {
+    return ev.ctx.err == emel::error::cast(processor::error::none) &&
+           schedule::ready(ev.request.kernel_plan, ev.request.kernel_dispatch);
+  }
+};
+
 struct phase_request_callback {
   bool operator()(const processor::event::execute_step & ev, const action::context &) const noexcept {
     return ev.ctx.err == emel::error::cast(processor::error::none) &&
+           ev.request.kernel_plan == nullptr &&
            ev.request.run_kernel != nullptr;
   }
 };
 
+// Neither a runnable schedule nor a callback: a plan without a usable
+// dispatch is rejected rather than silently run through run_kernel.
 struct phase_missing_callback {
   bool operator()(const processor::event::execute_step & ev, const action::context &) const noexcept {
-    return ev.ctx.err == emel::error::cast(processor::error::none) &&
-           ev.request.run_kernel == nullptr;
+    const bool has_schedule = schedule::ready(ev.request.kernel_plan, ev.request.kernel_dispatch);
+    const bool has_callback = ev.request.kernel_plan == nullptr && ev.request.run_kernel != nullptr;
+    return ev.ctx.err == emel::error::cast(processor::error::none) && !has_schedule &&
+           !has_callback;
   }
 };
 
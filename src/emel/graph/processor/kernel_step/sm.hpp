@@ -24,6 +24,10 @@ struct model {
                  [ guard::phase_prefailed{} ]
                  / action::mark_failed_existing_error
 
+      , sml::state<callback_decision> <= sml::state<deciding> + sml::completion<processor::event::execute_step>
+                 [ guard::phase_request_schedule{} ]
+                 / action::run_schedule
+
       , sml::state<callback_decision> <= sml::state<deciding> + sml::completion<processor::event::execute_step>
                  [ guard::phase_request_callback{} ]
                  / action::run_callback
@@ -0,0 +1,251 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
+#include "emel/sm.hpp"
+
+// Dependency-driven kernel scheduling for graph::processor.
+//
+// An owner that can describe a step as a DAG of ops hands the kernel phase a
+// plan and a dispatch instead of one opaque run_kernel callback. Nodes are
+// numbered in a topological order (every dependency has a lower id, which is
+// the order the assembler emits).
+//
+//   build_plan: puts every node one wave past its deepest dependency, so a
+//               wave only holds nodes with no edges between them (the Q/K/V
+//               projections, gate/up, parallel conv branches), and numbers
+//               the lane slices each node splits into.
+//   run_plan:   runs one wave at a time. All slices of all nodes in the wave
+//               share one task counter that the pool workers and the calling
+//               thread drain together, so GEMVs too small to fill the lanes
+//               on their own keep them busy side by side. After the join the
+//               wave's nodes are committed in node order, and the lowest
+//               failing node is the one reported, whatever order the workers
+//               finished in.
+//
+// Slice counts come from the plan, not from how many workers happen to be
+// idle, so every node computes the same bytes with or without a pool.
+//
+// Infrastructure only: no production owner supplies a plan yet. The text
+// generator still runs each step through run_kernel; its Q/K/V and gate/up
+// GEMVs are the intended first callers.
+namespace emel::graph::processor::schedule {
+
+// Same pool type as kernel::matmul::lane_pool, so one pool serves both.
+using lane_pool = emel::policy::fork_join_lane_pool<7u, 128u, 1048576u>;
+
+inline constexpr uint32_t k_max_slices =
+    static_cast<uint32_t>(lane_pool::static_worker_count) + 1u;
+inline constexpr uint32_t k_no_node = 0xffffffffu;
+
+struct node {
+  const uint32_t * deps = nullptr;
+  uint32_t dep_count = 0u;
+  // Disjoint pieces the op can be split into (row ranges of a GEMV, say);
+  // clamped to [1, k_max_slices].
+  uint32_t slices = 1u;
+};
+
+// Caller-owned storage; build_plan fills everything but `nodes`.
+struct plan {
+  std::span<const node> nodes = {};
+  std::span<uint32_t> wave_of = {};     // nodes.size()
+  std::span<uint32_t> order = {};       // nodes.size(): ids by wave, ascending within one
+  std::span<uint32_t> wave_begin = {};  // nodes.size() + 1: offsets into order
+  std::span<uint32_t> task_begin = {};  // nodes.size() + 1: first slice task of order[i]
+  uint32_t wave_count = 0u;
+  uint32_t task_count = 0u;
+};
+
+// run_slice runs concurrently for distinct nodes or slices of one wave.
+// `lane` is in [0, k_max_slices): 0 is the calling thread, 1.. the pool
+// helpers of the current wave, and no two concurrent calls share one, so ctx
+// can keep one kernel actor per lane. Outputs must be disjoint.
+using run_slice_fn = bool (*)(void * ctx, uint32_t lane, uint32_t node,
+                              uint32_t slice, uint32_t slice_count) noexcept;
+using commit_fn = bool (*)(void * ctx, uint32_t node) noexcept;
+
+struct dispatch {
+  lane_pool * pool = nullptr;  // nullptr runs every slice on the calling thread
+  void * ctx = nullptr;
+  run_slice_fn run_slice = nullptr;
+  commit_fn commit = nullptr;  // optional; called on the calling thread only
+};
+
+struct run_result {
+  bool ok = false;
+  uint32_t failed_node = k_no_node;
+  uint32_t waves_run = 0u;
+};
+
+inline uint32_t slice_count(const node & item) noexcept {
+  return std::clamp(item.slices, 1u, k_max_slices);
+}
+
+inline bool plan_storage_valid(const plan & dag) noexcept {
+  const size_t count = dag.nodes.size();
+  return count != 0u && count < k_no_node && dag.wave_of.size() == count &&
+         dag.order.size() == count && dag.wave_begin.size() == count + 1u &&
+         dag.task_begin.size() == count + 1u;
+}
+
+// Levels the DAG and lays out the wave and slice tables. Returns false for
+// mis-sized storage or a dependency that does not point to an earlier node.
+inline bool build_plan(plan & dag) noexcept {
+  dag.wave_count = 0u;
+  dag.task_count = 0u;
+  if (!plan_storage_valid(dag)) {
+    return false;
+  }
+  const auto count = static_cast<uint32_t>(dag.nodes.size());
+  uint32_t wave_count = 0u;
+  std::fill(dag.wave_begin.begin(), dag.wave_begin.end(), 0u);
+  for (uint32_t id = 0; id < count; ++id) {
+    const node & item = dag.nodes[id];
+    if (item.dep_count != 0u && item.deps == nullptr) {
+      return false;
+    }
+    uint32_t wave = 0u;
+    for (uint32_t dep_index = 0; dep_index < item.dep_count; ++dep_index) {
+      const uint32_t dep = item.deps[dep_index];
+      if (dep >= id) {
+        return false;
+      }
+      wave = std::max(wave, dag.wave_of[dep] + 1u);
+    }
+    dag.wave_of[id] = wave;
+    dag.wave_begin[wave + 1u] += 1u;
+    wave_count = std::max(wave_count, wave + 1u);
+  }
+  for (uint32_t wave = 0; wave < wave_count; ++wave) {
+    dag.wave_begin[wave + 1u] += dag.wave_begin[wave];
+  }
+
+  // Counting sort by wave; task_begin doubles as the insertion cursors and
+  // ids are visited ascending, so each wave stays in node order.
+  std::copy_n(dag.wave_begin.begin(), wave_count, dag.task_begin.begin());
+  for (uint32_t id = 0; id < count; ++id) {
+    dag.order[dag.task_begin[dag.wave_of[id]]++] = id;
+  }
+  dag.task_begin[0] = 0u;
+  for (uint32_t position = 0; position < count; ++position) {
+    dag.task_begin[position + 1u] =
+        dag.task_begin[position] + slice_count(dag.nodes[dag.order[position]]);
+  }
+  dag.wave_count = wave_count;
+  dag.task_count = dag.task_begin[count];
+  return true;
+}
+
+inline bool ready(const plan * dag, const dispatch * lanes) noexcept {
+  return dag != nullptr && lanes != nullptr && dag->wave_count != 0u &&
+         lanes->run_slice != nullptr;
+}
+
+namespace detail {
+
+struct wave_state {
+  const plan & dag;
+  const dispatch & lanes;
+  uint32_t first_position = 0u;
+  uint32_t end_position = 0u;
+  uint32_t end_task = 0u;
+  std::atomic<uint32_t> next_task = 0u;
+  std::atomic<uint32_t> failed_position = k_no_node;
+};
+
+inline void record_failure(std::atomic<uint32_t> & failed_position,
+                           const uint32_t position) noexcept {
+  uint32_t current = failed_position.load(std::memory_order_relaxed);
+  while (position < current &&
+         !failed_position.compare_exchange_weak(current, position,
+                                                std::memory_order_acq_rel,
+                                                std::memory_order_relaxed)) {
+  }
+}
+
+// Claims slice tasks until the wave is exhausted. Runs on the calling thread
+// (lane 0) and on every worker that accepted a helper task.
+inline void drain_wave(wave_state & wave, const uint32_t lane) noexcept {
+  const uint32_t * const task_begin = wave.dag.task_begin.data();
+  for (uint32_t task = wave.next_task.fetch_add(1u, std::memory_order_relaxed);
+       task < wave.end_task;
+       task = wave.next_task.fetch_add(1u, std::memory_order_relaxed)) {
+    const uint32_t * const owner =
+        std::upper_bound(task_begin + wave.first_position,
+                         task_begin + wave.end_position, task) - 1;
+    const auto position = static_cast<uint32_t>(owner - task_begin);
+    const uint32_t slices = owner[1] - owner[0];
+    const bool ok = wave.lanes.run_slice(wave.lanes.ctx, lane, wave.dag.order[position],
+                                         task - owner[0], slices);
+    if (!ok) {
+      record_failure(wave.failed_position, position);
+    }
+  }
+}
+
+// Commits the wave in node order up to its first failed node; returns the
+// position that stopped it, or end_position.
+inline uint32_t commit_wave(const wave_state & wave) noexcept {
+  const uint32_t failed = wave.failed_position.load(std::memory_order_acquire);
+  const uint32_t end = std::min(failed, wave.end_position);
+  for (uint32_t position = wave.first_position; position < end; ++position) {
+    const bool committed = wave.lanes.commit == nullptr ||
+                           wave.lanes.commit(wave.lanes.ctx, wave.dag.order[position]);
+    if (!committed) {
+      return position;
+    }
+  }
+  return end;
+}
+
+}  // namespace detail
+
+// Runs a built plan wave by wave. The calling thread always drains too, so
+// a missing, busy or nested pool degrades to serial execution, not failure.
+inline run_result run_plan(const plan & dag, const dispatch & lanes) noexcept {
+  run_result result{.ok = true};
+  for (uint32_t wave_index = 0; wave_index < dag.wave_count; ++wave_index) {
+    const uint32_t first_position = dag.wave_begin[wave_index];
+    const uint32_t end_position = dag.wave_begin[wave_index + 1u];
+    detail::wave_state wave{
+        .dag = dag,
+        .lanes = lanes,
+        .first_position = first_position,
+        .end_position = end_position,
+        .end_task = dag.task_begin[end_position],
+    };
+    wave.next_task.store(dag.task_begin[first_position], std::memory_order_relaxed);
+
+    lane_pool::join_group group{};
+    const uint32_t tasks = wave.end_task - dag.task_begin[first_position];
+    const uint32_t helpers =
+        lanes.pool == nullptr
+            ? 0u
+            : std::min(tasks - 1u,
+                       static_cast<uint32_t>(lanes.pool->active_worker_count()));
+    detail::wave_state * const shared = &wave;
+    for (uint32_t helper = 0; helper < helpers; ++helper) {
+      (void)lanes.pool->try_submit(group, [shared, helper]() noexcept {
+        detail::drain_wave(*shared, helper + 1u);
+      });
+    }
+    detail::drain_wave(wave, 0u);
+    (void)group.wait();
+
+    result.waves_run = wave_index + 1u;
+    const uint32_t stopped = detail::commit_wave(wave);
+    if (stopped != end_position) {
+      result.ok = false;
+      result.failed_node = dag.order[stopped];
+      return result;
+    }
+  }
+  return result;
+}
+
+}  // namespace emel::graph::processor::schedule
@@ -0,0 +1,927 @@
+#include "emel/io/async_read/actions.hpp"
+
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <span>
+#include <string_view>
+
+#if EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/uio.h>
+#include <unistd.h>
+#endif
+
+#if EMEL_IO_ASYNC_READ_IO_URING
+#include <linux/io_uring.h>
+#include <sys/syscall.h>
+#endif
+
+namespace emel::io::async_read::action {
+
+#if EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED
+
+namespace {
+
+using tensor_span = std::span<const emel::io::event::tensor_load_span>;
+using tensor_counters = std::span<std::atomic<uint64_t>>;
+
+// Registered buffer stride: one block plus the outward rounding of an
+// unaligned slice start and end.
+constexpr uint64_t k_slot_bytes = k_block_bytes + k_direct_io_alignment;
+
+// Enters spent waiting out a failed batch's reads before the ring is retired.
+constexpr uint32_t k_ring_abandon_enters = 64u;
+
+struct open_file {
+  std::string_view path = {};
+  int fd = -1;
+};
+
+// Files of the batch in flight. Every distinct path is opened once before the
+// first read and closed after the last completion.
+struct file_table {
+  std::array<open_file, k_max_open_files> files{};
+  uint32_t count = 0u;
+  uint32_t last_hit = 0u;
+
+  int find(const std::string_view path) noexcept {
+    if (count != 0u && files[last_hit].path == path) {
+      return files[last_hit].fd;
+    }
+    for (uint32_t index = 0u; index < count; ++index) {
+      if (files[index].path == path) {
+        last_hit = index;
+        return files[index].fd;
+      }
+    }
+    return -1;
+  }
+
+  // Read-only lookup for lanes that share the table during a batch.
+  int lookup(const std::string_view path) const noexcept {
+    for (uint32_t index = 0u; index < count; ++index) {
+      if (files[index].path == path) {
+        return files[index].fd;
+      }
+    }
+    return -1;
+  }
+
+  void close_all() noexcept {
+    for (uint32_t index = 0u; index < count; ++index) {
+      ::close(files[index].fd);
+      files[index] = {};
+    }
+    count = 0u;
+    last_hit = 0u;
+  }
+};
+
+int open_path(const std::string_view path, const bool direct_io) noexcept {
+  std::array<char, k_max_file_path_bytes + 1u> path_buffer{};
+  std::memcpy(path_buffer.data(), path.data(), path.size());
+  path_buffer[path.size()] = '\0';
+  const int flags = O_RDONLY | O_CLOEXEC;
+#if defined(O_DIRECT)
+  if (direct_io) {
+    const int fd = ::open(path_buffer.data(), flags | O_DIRECT);
+    if (fd >= 0) {
+      return fd;
+    }
+  }
+#else
+  (void)direct_io;
+#endif
+  return ::open(path_buffer.data(), flags);
+}
+
+void record_failure(detail::read_batch_attempt_status &status,
+                    const uint32_t tensor_index,
+                    const error failure) noexcept {
+  const bool first = status.err == emel::error::cast(error::none);
+  if (first || tensor_index < status.failed_index) {
+    status.err = emel::error::cast(failure);
+    status.failed_index = tensor_index;
+  }
+  status.ok = false;
+}
+
+bool open_batch_files(file_table &files, const tensor_span tensors,
+                      const bool direct_io,
+                      detail::read_batch_attempt_status &status) noexcept {
+  for (uint32_t index = 0u; index < static_cast<uint32_t>(tensors.size());
+       ++index) {
+    const std::string_view path = tensors[index].file_path;
+    if (files.find(path) >= 0) {
+      continue;
+    }
+    if (files.count == k_max_open_files) {
+      record_failure(status, index, error::resource_exhausted);
+      return false;
+    }
+    const int fd = open_path(path, direct_io);
+    if (fd < 0) {
+      record_failure(status, index, error::file_open_failed);
+      return false;
+    }
+    files.files[files.count] = {path, fd};
+    files.last_hit = files.count;
+    files.count += 1u;
+  }
+  return true;
+}
+
+// One contiguous piece of one tensor, at most `k_block_bytes` long.
+struct slice {
+  uint32_t tensor = 0u;
+  int fd = -1;
+  uint64_t file_offset = 0u;
+  uint64_t length = 0u;
+  unsigned char *target = nullptr;
+};
+
+// Walks tensors in request order, cutting each into block-sized slices, so
+// the queue always holds the next reads of the whole model rather than of a
+// single tensor.
+struct slice_cursor {
+  uint32_t tensor = 0u;
+  uint64_t offset = 0u;
+
+  bool next(const tensor_span tensors, file_table &files,
+            slice &out) noexcept {
+    if (tensor >= tensors.size()) {
+      return false;
+    }
+    const auto &span = tensors[tensor];
+    const uint64_t remaining = span.byte_size - offset;
+    const uint64_t length = remaining < k_block_bytes ? remaining : k_block_bytes;
+    out.tensor = tensor;
+    out.fd = files.find(span.file_path);
+    out.file_offset = span.file_offset + offset;
+    out.length = length;
+    out.target = static_cast<unsigned char *>(span.target) + offset;
+    offset += length;
+    if (offset == span.byte_size) {
+      tensor += 1u;
+      offset = 0u;
+    }
+    return true;
+  }
+};
+
+uint64_t batch_bytes(const tensor_span tensors) noexcept {
+  uint64_t bytes = 0u;
+  for (const auto &span : tensors) {
+    bytes += span.byte_size;
+  }
+  return bytes;
+}
+
+void add_tensor_bytes(const tensor_counters counters, const uint32_t tensor,
+                      const uint64_t bytes) noexcept {
+  counters[tensor].fetch_add(bytes, std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// pread engine on the owner's lane pool
+
+// Packed (tensor << 32 | error) of the lowest failing tensor; the all-ones
+// value means no read has failed.
+constexpr uint64_t k_no_failure = ~uint64_t{0};
+
+// Shared by every reader of one batch. Readers claim runs of batch bytes with
+// one fetch_add and never wait on each other: `queued` claims block-sized
+// runs in request order, `sharded` claims whole byte-balanced shards.
+struct pool_batch {
+  tensor_span tensors = {};
+  const file_table *files = nullptr;
+  tensor_counters tensor_bytes = {};
+  event::read_mode mode = event::read_mode::queued;
+  uint64_t total_bytes = 0u;
+  uint32_t shard_count = 1u;
+  std::atomic<uint64_t> next_claim{0u};
+  std::atomic<uint64_t> failure{k_no_failure};
+  std::atomic<uint64_t> bytes_read{0u};
+  std::atomic<uint32_t> in_flight{0u};
+  std::atomic<uint32_t> peak_in_flight{0u};
+};
+
+// Tensor holding the batch byte a reader is at. Claims of one reader only
+// move forward, so the cursor never rewinds.
+struct pool_cursor {
+  uint32_t tensor = 0u;
+  uint64_t tensor_begin = 0u;
+  std::string_view path = {};
+  int fd = -1;
+};
+
+bool pread_slice(const slice &piece, error &failure) noexcept {
+  uint64_t received = 0u;
+  while (received < piece.length) {
+    const ssize_t got =
+        ::pread(piece.fd, piece.target + received,
+                static_cast<size_t>(piece.length - received),
+                static_cast<off_t>(piece.file_offset + received));
+    if (got < 0 && errno == EINTR) {
+      continue;
+    }
+    if (got < 0) {
+      failure = error::read_failed;
+      return false;
+    }
+    if (got == 0) {
+      failure = error::short_read;
+      return false;
+    }
+    received += static_cast<uint64_t>(got);
+  }
+  return true;
+}
+
+bool pool_failed(const pool_batch &batch) noexcept {
+  return batch.failure.load(std::memory_order_relaxed) != k_no_failure;
+}
+
+void record_pool_failure(pool_batch &batch, const uint32_t tensor,
+                         const error failure) noexcept {
+  const uint64_t packed = (static_cast<uint64_t>(tensor) << 32u) |
+                          static_cast<uint64_t>(failure);
+  uint64_t current = batch.failure.load(std::memory_order_relaxed);
+  while (packed < current &&
+         !batch.failure.compare_exchange_weak(current, packed,
+                                              std::memory_order_relaxed)) {
+  }
+}
+
+void enter_pool_read(pool_batch &batch) noexcept {
+  const uint32_t now =
+      batch.in_flight.fetch_add(1u, std::memory_order_relaxed) + 1u;
+  uint32_t peak = batch.peak_in_flight.load(std::memory_order_relaxed);
+  while (now > peak &&
+         !batch.peak_in_flight.compare_exchange_weak(
+             peak, now, std::memory_order_relaxed)) {
+  }
+}
+
+// Batch byte where shard `shard` of `shard_count` equal runs starts.
+uint64_t shard_boundary(const pool_batch &batch, const uint32_t shard) noexcept {
+  const uint64_t count = batch.shard_count;
+  return (batch.total_bytes / count) * shard +
+         ((batch.total_bytes % count) * shard) / count;
+}
+
+bool claim_pool_range(pool_batch &batch, uint64_t &begin,
+                      uint64_t &end) noexcept {
+  if (batch.mode == event::read_mode::sharded) {
+    const uint64_t shard =
+        batch.next_claim.fetch_add(1u, std::memory_order_relaxed);
+    if (shard >= batch.shard_count) {
+      return false;
+    }
+    begin = shard_boundary(batch, static_cast<uint32_t>(shard));
+    end = shard_boundary(batch, static_cast<uint32_t>(shard + 1u));
+    return true;
+  }
+  begin = batch.next_claim.fetch_add(k_block_bytes, std::memory_order_relaxed);
+  if (begin >= batch.total_bytes) {
+    return false;
+  }
+  end = batch.total_bytes - begin < k_block_bytes ? batch.total_bytes
+                                                  : begin + k_block_bytes;
+  return true;
+}
+
+// Reads batch bytes [begin, end) straight into the targets. A run may cross
+// tensor boundaries; each pread stays inside one tensor and carries at most
+// `max_read` bytes.
+void read_pool_range(pool_batch &batch, pool_cursor &cursor, uint64_t begin,
+                     const uint64_t end, const uint64_t max_read) noexcept {
+  while (begin < end && !pool_failed(batch)) {
+    while (cursor.tensor_begin + batch.tensors[cursor.tensor].byte_size <=
+           begin) {
+      cursor.tensor_begin += batch.tensors[cursor.tensor].byte_size;
+      cursor.tensor += 1u;
+    }
+    const auto &span = batch.tensors[cursor.tensor];
+    if (span.file_path != cursor.path) {
+      cursor.path = span.file_path;
+      cursor.fd = batch.files->lookup(cursor.path);
+    }
+    const uint64_t offset = begin - cursor.tensor_begin;
+    uint64_t length = span.byte_size - offset;
+    length = length < end - begin ? length : end - begin;
+    length = length < max_read ? length : max_read;
+    const slice piece{
+        .tensor = cursor.tensor,
+        .fd = cursor.fd,
+        .file_offset = span.file_offset + offset,
+        .length = length,
+        .target = static_cast<unsigned char *>(span.target) + offset,
+    };
+    error failure = error::none;
+    if (!pread_slice(piece, failure)) {
+      record_pool_failure(batch, cursor.tensor, failure);
+      return;
+    }
+    add_tensor_bytes(batch.tensor_bytes, cursor.tensor, length);
+    batch.bytes_read.fetch_add(length, std::memory_order_relaxed);
+    begin += length;
+  }
+}
+
+// One reader: the dispatching thread or a lane. Claims runs until the batch
+// is exhausted or any read failed.
+void drain_pool_batch(pool_batch &batch) noexcept {
+  const uint64_t max_read = batch.mode == event::read_mode::sharded
+                                ? k_shard_read_bytes
+                                : k_block_bytes;
+  pool_cursor cursor{};
+  uint64_t begin = 0u;
+  uint64_t end = 0u;
+  while (!pool_failed(batch) && claim_pool_range(batch, begin, end)) {
+    enter_pool_read(batch);
+    read_pool_range(batch, cursor, begin, end, max_read);
+    batch.in_flight.fetch_sub(1u, std::memory_order_relaxed);
+  }
+}
+
+// Forks one reader per owner lane, reads alongside them and joins. Claims are
+// dynamic, so a lane the pool refuses only leaves more for the others.
+void pool_read_batch(detail::lane_pool *lanes,
+                     const detail::read_batch_plan &plan,
+                     const file_table &files,
+                     detail::read_batch_attempt_status &status) noexcept {
+  const uint32_t lane_count =
+      lanes == nullptr ? 0u
+                       : static_cast<uint32_t>(lanes->active_worker_count());
+  pool_batch batch{};
+  batch.tensors = plan.tensors;
+  batch.files = &files;
+  batch.tensor_bytes = plan.tensor_bytes;
+  batch.mode = plan.mode;
+  batch.total_bytes = batch_bytes(plan.tensors);
+  batch.shard_count = lane_count + 1u;
+
+  detail::lane_pool::join_group group{};
+  pool_batch *batch_ptr = &batch;
+  for (uint32_t lane = 0u; lane < lane_count; ++lane) {
+    lanes->try_submit(group,
+                      [batch_ptr]() noexcept { drain_pool_batch(*batch_ptr); });
+  }
+  drain_pool_batch(batch);
+  group.wait();
+
+  const uint64_t failure = batch.failure.load(std::memory_order_relaxed);
+  if (failure != k_no_failure) {
+    record_failure(status, static_cast<uint32_t>(failure >> 32u),
+                   static_cast<error>(failure & 0xffffffffu));
+  }
+  status.bytes_read = batch.bytes_read.load(std::memory_order_relaxed);
+  status.peak_in_flight =
+      batch.peak_in_flight.load(std::memory_order_relaxed);
+}
+
+//------------------------------------------------------------------------------
+// io_uring engine
+
+#if EMEL_IO_ASYNC_READ_IO_URING
+
+struct ring_read {
+  uint32_t tensor = 0u;
+  int fd = -1;
+  // Aligned file window read into the slot buffer.
+  uint64_t read_offset = 0u;
+  uint32_t read_length = 0u;
+  uint32_t received = 0u;
+  // Bytes of the window that must arrive: the slice plus its leading pad.
+  uint32_t needed = 0u;
+  uint32_t skip = 0u;
+  uint64_t copy_bytes = 0u;
+  unsigned char *target = nullptr;
+};
+
+struct ring_engine {
+  int ring_fd = -1;
+  unsigned char *sq_ring = nullptr;
+  size_t sq_ring_bytes = 0u;
+  unsigned char *cq_ring = nullptr;
+  size_t cq_ring_bytes = 0u;
+  io_uring_sqe *sqes = nullptr;
+  size_t sqes_bytes = 0u;
+  unsigned *sq_tail = nullptr;
+  unsigned *sq_mask = nullptr;
+  unsigned *sq_array = nullptr;
+  unsigned *cq_head = nullptr;
+  unsigned *cq_tail = nullptr;
+  unsigned *cq_mask = nullptr;
+  io_uring_cqe *cqes = nullptr;
+  unsigned char *buffers = nullptr;
+  size_t buffers_bytes = 0u;
+  bool fixed_buffers = false;
+  // Set when a hard io_uring_enter failure left reads the ring could not
+  // reap; the kernel may still write those slot buffers, so queued batches
+  // move to the pread path for the rest of the engine's life.
+  bool broken = false;
+  unsigned pending_submit = 0u;
+  std::array<ring_read, k_queue_depth> reads = {};
+  std::array<uint32_t, k_queue_depth> free_slots = {};
+  uint32_t free_count = 0u;
+};
+
+int sys_io_uring_setup(const unsigned entries, io_uring_params &params) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_setup, entries, &params));
+}
+
+int sys_io_uring_enter(const int fd, const unsigned to_submit,
+                       const unsigned min_complete) noexcept {
+  return static_cast<int>(::syscall(__NR_io_uring_enter, fd, to_submit,
+                                    min_complete, IORING_ENTER_GETEVENTS,
+                                    nullptr, 0));
+}
+
+int sys_io_uring_register(const int fd, const unsigned opcode, void *args,
+                          const unsigned count) noexcept {
+  return static_cast<int>(
+      ::syscall(__NR_io_uring_register, fd, opcode, args, count));
+}
+
+void *map_ring(const int fd, const size_t bytes, const off_t offset) noexcept {
+  void *address = ::mmap(nullptr, bytes, PROT_READ | PROT_WRITE,
+                         MAP_SHARED | MAP_POPULATE, fd, offset);
+  return address == MAP_FAILED ? nullptr : address;
+}
+
+void ring_teardown(ring_engine &ring) noexcept {
+  if (ring.buffers != nullptr) {
+    ::munmap(ring.buffers, ring.buffers_bytes);
+  }
+  if (ring.sqes != nullptr) {
+    ::munmap(ring.sqes, ring.sqes_bytes);
+  }
+  if (ring.cq_ring != nullptr && ring.cq_ring != ring.sq_ring) {
+    ::munmap(ring.cq_ring, ring.cq_ring_bytes);
+  }
+  if (ring.sq_ring != nullptr) {
+    ::munmap(ring.sq_ring, ring.sq_ring_bytes);
+  }
+  if (ring.ring_fd >= 0) {
+    // Closing the ring also drops the buffer registration.
+    ::close(ring.ring_fd);
+  }
+  ring = ring_engine{};
+}
+
+bool ring_setup(ring_engine &ring) noexcept {
+  io_uring_params params{};
+  const int fd = sys_io_uring_setup(k_queue_depth, params);
+  if (fd < 0) {
+    return false;
+  }
+  ring.ring_fd = fd;
+  ring.sq_ring_bytes =
+      params.sq_off.array + params.sq_entries * sizeof(unsigned);
+  ring.cq_ring_bytes =
+      params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+  const bool single_mmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0u;
+  if (single_mmap) {
+    const size_t bytes = ring.sq_ring_bytes > ring.cq_ring_bytes
+                             ? ring.sq_ring_bytes
+                             : ring.cq_ring_bytes;
+    ring.sq_ring_bytes = bytes;
+    ring.cq_ring_bytes = bytes;
+  }
+  ring.sq_ring = static_cast<unsigned char *>(
+      map_ring(fd, ring.sq_ring_bytes, IORING_OFF_SQ_RING));
+  ring.cq_ring = single_mmap
+                     ? ring.sq_ring
+                     : static_cast<unsigned char *>(map_ring(
+                           fd, ring.cq_ring_bytes, IORING_OFF_CQ_RING));
+  ring.sqes_bytes = params.sq_entries * sizeof(io_uring_sqe);
+  ring.sqes = static_cast<io_uring_sqe *>(
+      map_ring(fd, ring.sqes_bytes, IORING_OFF_SQES));
+  if (ring.sq_ring == nullptr || ring.cq_ring == nullptr ||
+      ring.sqes == nullptr || params.sq_entries < k_queue_depth) {
+    ring_teardown(ring);
+    return false;
+  }
+
+  ring.sq_tail = reinterpret_cast<unsigned *>(ring.sq_ring + params.sq_off.tail);
+  ring.sq_mask =
+      reinterpret_cast<unsigned *>(ring.sq_ring + params.sq_off.ring_mask);
+  ring.sq_array =
+      reinterpret_cast<unsigned *>(ring.sq_ring + params.sq_off.array);
+  ring.cq_head = reinterpret_cast<unsigned *>(ring.cq_ring + params.cq_off.head);
+  ring.cq_tail = reinterpret_cast<unsigned *>(ring.cq_ring + params.cq_off.tail);
+  ring.cq_mask =
+      reinterpret_cast<unsigned *>(ring.cq_ring + params.cq_off.ring_mask);
+  ring.cqes = reinterpret_cast<io_uring_cqe *>(ring.cq_ring + params.cq_off.cqes);
+
+  ring.buffers_bytes = static_cast<size_t>(k_queue_depth * k_slot_bytes);
+  void *buffers = ::mmap(nullptr, ring.buffers_bytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+  if (buffers == MAP_FAILED) {
+    ring.buffers = nullptr;
+    ring_teardown(ring);
+    return false;
+  }
+  ring.buffers = static_cast<unsigned char *>(buffers);
+
+  // Fixed buffers skip the per-read page pinning; a kernel that refuses the
+  // registration (memlock limits) still gets plain reads into the same slots.
+  std::array<iovec, k_queue_depth> iovecs{};
+  for (uint32_t slot = 0u; slot < k_queue_depth; ++slot) {
+    iovecs[slot].iov_base = ring.buffers + slot * k_slot_bytes;
+    iovecs[slot].iov_len = static_cast<size_t>(k_slot_bytes);
+  }
+  ring.fixed_buffers = sys_io_uring_register(fd, IORING_REGISTER_BUFFERS,
+                                             iovecs.data(), k_queue_depth) == 0;
+
+  for (uint32_t slot = 0u; slot < k_queue_depth; ++slot) {
+    ring.free_slots[slot] = (k_queue_depth - 1u) - slot;
+  }
+  ring.free_count = k_queue_depth;
+  return true;
+}
+
+unsigned char *slot_buffer(ring_engine &ring, const uint32_t slot) noexcept {
+  return ring.buffers + slot * k_slot_bytes;
+}
+
+void ring_push(ring_engine &ring, const uint32_t slot) noexcept {
+  const ring_read &read = ring.reads[slot];
+  const unsigned tail = *ring.sq_tail;
+  const unsigned index = tail & *ring.sq_mask;
+  io_uring_sqe &sqe = ring.sqes[index];
+  std::memset(&sqe, 0, sizeof(sqe));
+  sqe.opcode = static_cast<uint8_t>(ring.fixed_buffers ? IORING_OP_READ_FIXED
+                                                       : IORING_OP_READ);
+  sqe.fd = read.fd;
+  sqe.off = read.read_offset + read.received;
+  sqe.addr = reinterpret_cast<uint64_t>(slot_buffer(ring, slot) + read.received);
+  sqe.len = read.read_length - read.received;
+  sqe.buf_index = static_cast<uint16_t>(ring.fixed_buffers ? slot : 0u);
+  sqe.user_data = slot;
+  ring.sq_array[index] = index;
+  std::atomic_ref<unsigned>(*ring.sq_tail)
+      .store(tail + 1u, std::memory_order_release);
+  ring.pending_submit += 1u;
+}
+
+void ring_prepare(ring_engine &ring, const uint32_t slot,
+                  const slice &piece) noexcept {
+  ring_read &read = ring.reads[slot];
+  const uint64_t aligned_offset =
+      piece.file_offset - (piece.file_offset % k_direct_io_alignment);
+  const uint64_t skip = piece.file_offset - aligned_offset;
+  const uint64_t needed = skip + piece.length;
+  const uint64_t window =
+      ((needed + k_direct_io_alignment - 1u) / k_direct_io_alignment) *
+      k_direct_io_alignment;
+  read.tensor = piece.tensor;
+  read.fd = piece.fd;
+  read.read_offset = aligned_offset;
+  read.read_length = static_cast<uint32_t>(window);
+  read.received = 0u;
+  read.needed = static_cast<uint32_t>(needed);
+  read.skip = static_cast<uint32_t>(skip);
+  read.copy_bytes = piece.length;
+  read.target = piece.target;
+}
+
+void ring_release(ring_engine &ring, const uint32_t slot,
+                  uint32_t &in_flight) noexcept {
+  ring.free_slots[ring.free_count] = slot;
+  ring.free_count += 1u;
+  in_flight -= 1u;
+}
+
+// Reaps every visible completion. Finished windows are copied out of their
+// slot; short windows are resubmitted from where they stopped.
+void ring_reap(ring_engine &ring, uint32_t &in_flight,
+               const tensor_counters tensor_bytes,
+               detail::read_batch_attempt_status &status) noexcept {
+  unsigned head = *ring.cq_head;
+  const unsigned tail =
+      std::atomic_ref<unsigned>(*ring.cq_tail).load(std::memory_order_acquire);
+  while (head != tail) {
+    const io_uring_cqe &cqe = ring.cqes[head & *ring.cq_mask];
+    const uint32_t slot = static_cast<uint32_t>(cqe.user_data);
+    const int32_t result = cqe.res;
+    head += 1u;
+    ring_read &read = ring.reads[slot];
+    const bool failed = status.err != emel::error::cast(error::none);
+    if (result < 0) {
+      record_failure(status, read.tensor, error::read_failed);
+      ring_release(ring, slot, in_flight);
+      continue;
+    }
+    if (result == 0) {
+      record_failure(status, read.tensor, error::short_read);
+      ring_release(ring, slot, in_flight);
+      continue;
+    }
+    read.received += static_cast<uint32_t>(result);
+    if (read.received < read.needed) {
+      if (failed) {
+        ring_release(ring, slot, in_flight);
+      } else {
+        ring_push(ring, slot);
+      }
+      continue;
+    }
+    std::memcpy(read.target, slot_buffer(ring, slot) + read.skip,
+                static_cast<size_t>(read.copy_bytes));
+    status.bytes_read += read.copy_bytes;
+    add_tensor_bytes(tensor_bytes, read.tensor, read.copy_bytes);
+    ring_release(ring, slot, in_flight);
+  }
+  std::atomic_ref<unsigned>(*ring.cq_head)
+      .store(head, std::memory_order_release);
+}
+
+// Completions still arriving after a hard io_uring_enter failure; the batch
+// is rerun on the pread path, so their bytes are dropped.
+void ring_discard(ring_engine &ring, uint32_t &in_flight) noexcept {
+  unsigned head = *ring.cq_head;
+  const unsigned tail =
+      std::atomic_ref<unsigned>(*ring.cq_tail).load(std::memory_order_acquire);
+  while (head != tail) {
+    const io_uring_cqe &cqe = ring.cqes[head & *ring.cq_mask];
+    ring_release(ring, static_cast<uint32_t>(cqe.user_data), in_flight);
+    head += 1u;
+  }
+  std::atomic_ref<unsigned>(*ring.cq_head)
+      .store(head, std::memory_order_release);
+}
+
+// Recovers every slot of a batch whose io_uring_enter failed hard. A failed
+// enter consumed none of the pending entries, so they are withdrawn from the
+// submission tail; reads the kernel already holds are waited out for a
+// bounded number of enters. Only reads that never complete retire the ring.
+void ring_abandon(ring_engine &ring, uint32_t &in_flight) noexcept {
+  const unsigned tail = *ring.sq_tail;
+  for (unsigned index = 0u; index < ring.pending_submit; ++index) {
+    const io_uring_sqe &sqe = ring.sqes[(tail - 1u - index) & *ring.sq_mask];
+    ring_release(ring, static_cast<uint32_t>(sqe.user_data), in_flight);
+  }
+  std::atomic_ref<unsigned>(*ring.sq_tail)
+      .store(tail - ring.pending_submit, std::memory_order_release);
+  ring.pending_submit = 0u;
+  ring_discard(ring, in_flight);
+  for (uint32_t attempt = 0u;
+       in_flight != 0u && attempt < k_ring_abandon_enters; ++attempt) {
+    (void)sys_io_uring_enter(ring.ring_fd, 0u, in_flight);
+    ring_discard(ring, in_flight);
+  }
+  ring.broken = in_flight != 0u;
+}
+
+// Returns false when io_uring_enter failed hard. The ring's slots are then
+// recovered and the caller reruns the batch on the pread path.
+bool ring_read_batch(ring_engine &ring, const detail::read_batch_plan &plan,
+                     file_table &files,
+                     detail::read_batch_attempt_status &status) noexcept {
+  const tensor_span tensors = plan.tensors;
+  slice_cursor cursor{};
+  uint32_t in_flight = 0u;
+  for (;;) {
+    while (status.err == emel::error::cast(error::none) &&
+           ring.free_count != 0u) {
+      slice piece{};
+      if (!cursor.next(tensors, files, piece)) {
+        break;
+      }
+      ring.free_count -= 1u;
+      const uint32_t slot = ring.free_slots[ring.free_count];
+      ring_prepare(ring, slot, piece);
+      ring_push(ring, slot);
+      in_flight += 1u;
+    }
+    if (in_flight > status.peak_in_flight) {
+      status.peak_in_flight = in_flight;
+    }
+    if (in_flight == 0u) {
+      return true;
+    }
+    const int entered =
+        sys_io_uring_enter(ring.ring_fd, ring.pending_submit, 1u);
+    if (entered < 0 &&
+        (errno == EINTR || errno == EAGAIN || errno == EBUSY)) {
+      ring_reap(ring, in_flight, plan.tensor_bytes, status);
+      continue;
+    }
+    if (entered < 0) {
+      ring_abandon(ring, in_flight);
+      return false;
+    }
+    ring.pending_submit -= static_cast<unsigned>(entered);
+    ring_reap(ring, in_flight, plan.tensor_bytes, status);
+  }
+}
+
+#endif // EMEL_IO_ASYNC_READ_IO_URING
+
+} // namespace
+
+struct engine {
+  event::engine_kind kind = event::engine_kind::none;
+  bool direct_io = false;
+  file_table files = {};
+#if EMEL_IO_ASYNC_READ_IO_URING
+  ring_engine ring = {};
+#endif
+};
+
+namespace {
+
+engine *platform_create(const engine_config &config) noexcept {
+  auto *io_engine = new (std::nothrow) engine{};
+  if (io_engine == nullptr) {
+    return nullptr;
+  }
+  io_engine->direct_io = config.direct_io;
+  io_engine->kind = config.preference == engine_preference::io_uring
+                        ? event::engine_kind::none
+                        : event::engine_kind::thread_pool;
+#if EMEL_IO_ASYNC_READ_IO_URING
+  if (config.preference != engine_preference::thread_pool &&
+      ring_setup(io_engine->ring)) {
+    io_engine->kind = event::engine_kind::io_uring;
+  }
+#endif
+  if (io_engine->kind == event::engine_kind::none) {
+    delete io_engine;
+    return nullptr;
+  }
+  return io_engine;
+}
+
+void platform_destroy(engine *io_engine) noexcept {
+  if (io_engine == nullptr) {
+    return;
+  }
+#if EMEL_IO_ASYNC_READ_IO_URING
+  ring_teardown(io_engine->ring);
+#endif
+  delete io_engine;
+}
+
+event::engine_kind platform_kind(const engine *io_engine) noexcept {
+  return io_engine == nullptr ? event::engine_kind::none : io_engine->kind;
+}
+
+void reset_batch(const detail::read_batch_plan &plan,
+                 detail::read_batch_attempt_status &status) noexcept {
+  for (uint32_t index = 0u; index < static_cast<uint32_t>(plan.tensors.size());
+       ++index) {
+    plan.tensor_bytes[index].store(0u, std::memory_order_relaxed);
+  }
+  status.err = emel::error::cast(error::none);
+  status.ok = false;
+  status.done_count = 0u;
+  status.bytes_read = 0u;
+  status.failed_index = 0u;
+  status.peak_in_flight = 0u;
+}
+
+void pool_read_files(engine &io_engine, const detail::read_batch_plan &plan,
+                     detail::read_batch_attempt_status &status) noexcept {
+  if (open_batch_files(io_engine.files, plan.tensors, false, status)) {
+    pool_read_batch(plan.lanes, plan, io_engine.files, status);
+  }
+  io_engine.files.close_all();
+}
+
+void platform_read_batch(engine *io_engine, const detail::read_batch_plan &plan,
+                         detail::read_batch_attempt_status &status) noexcept {
+  const tensor_span tensors = plan.tensors;
+  reset_batch(plan, status);
+
+  // Direct I/O needs the aligned slot buffers; the pread path reads straight
+  // into caller targets and stays buffered.
+#if EMEL_IO_ASYNC_READ_IO_URING
+  const bool on_ring = io_engine->kind == event::engine_kind::io_uring &&
+                       !io_engine->ring.broken &&
+                       plan.mode == event::read_mode::queued;
+  if (on_ring) {
+    bool ring_ok = true;
+    if (open_batch_files(io_engine->files, tensors, io_engine->direct_io,
+                         status)) {
+      ring_ok = ring_read_batch(io_engine->ring, plan, io_engine->files,
+                                status);
+    }
+    io_engine->files.close_all();
+    if (!ring_ok) {
+      // The ring failed under this batch; read it again from the start.
+      reset_batch(plan, status);
+      pool_read_files(*io_engine, plan, status);
+    }
+  } else {
+    pool_read_files(*io_engine, plan, status);
+  }
+#else
+  pool_read_files(*io_engine, plan, status);
+#endif
+
+  uint32_t done_count = 0u;
+  for (uint32_t index = 0u; index < static_cast<uint32_t>(tensors.size());
+       ++index) {
+    done_count += static_cast<uint32_t>(
+        plan.tensor_bytes[index].load(std::memory_order_relaxed) ==
+        tensors[index].byte_size);
+  }
+  status.ok = status.err == emel::error::cast(error::none) &&
+              status.bytes_read == batch_bytes(tensors);
+  status.done_count = done_count;
+}
+
+} // namespace
+
+#else // EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED
+
+struct engine {};
+
+namespace {
+
+engine *platform_create(const engine_config &) noexcept { return nullptr; }
+
+void platform_destroy(engine *) noexcept {}
+
+event::engine_kind platform_kind(const engine *) noexcept {
+  return event::engine_kind::none;
+}
+
+void platform_read_batch(engine *, const detail::read_batch_plan &,
+                         detail::read_batch_attempt_status &status) noexcept {
+  status.err = emel::error::cast(error::engine_unavailable);
+  status.ok = false;
+}
+
+} // namespace
+
+#endif // EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED
+
+platform_ops default_platform_ops() noexcept {
+  platform_ops ops{};
+  ops.create = &platform_create;
+  ops.destroy = &platform_destroy;
+  ops.kind = &platform_kind;
+  ops.read_batch = &platform_read_batch;
+  return ops;
+}
+
+context::context() noexcept : context(default_platform_ops(), {}) {}
+
+context::context(const engine_config &config) noexcept
+    : context(default_platform_ops(), config) {}
+
+context::context(const platform_ops &platform_in,
+                 const engine_config &config) noexcept
+    : platform(platform_in),
+      lanes(config.lanes),
+      tensor_bytes(config.max_batch_tensors < k_max_batch_tensors
+                       ? config.max_batch_tensors
+                       : k_max_batch_tensors) {
+  // Null fields seed from the defaults so no effect ever calls through a null
+  // platform pointer.
+  const platform_ops defaults = default_platform_ops();
+  if (platform.create == nullptr) {
+    platform.create = defaults.create;
+  }
+  if (platform.destroy == nullptr) {
+    platform.destroy = defaults.destroy;
+  }
+  if (platform.kind == nullptr) {
+    platform.kind = defaults.kind;
+  }
+  if (platform.read_batch == nullptr) {
+    platform.read_batch = defaults.read_batch;
+  }
+  io_engine = platform.create(config);
+  engine_kind = platform.kind(io_engine);
+}
+
+context::~context() noexcept {
+  platform.destroy(io_engine);
+  io_engine = nullptr;
+}
+
+void effect_execute_read_batch::operator()(const detail::read_batch_runtime &ev,
+                                           context &ctx) const noexcept {
+  const detail::read_batch_plan plan{
+      .tensors = ev.request.tensors,
+      .mode = ev.request.mode,
+      .tensor_bytes = std::span<std::atomic<uint64_t>>{
+          ctx.tensor_bytes.data(), ev.request.tensors.size()},
+      .lanes = ctx.lanes,
+  };
+  ctx.platform.read_batch(ctx.io_engine, plan, ev.status);
+}
+
+} // namespace emel::io::async_read::action
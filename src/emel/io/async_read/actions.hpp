@@ -0,0 +1,165 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+
+#include "emel/io/async_read/context.hpp"
+#include "emel/io/async_read/detail.hpp"
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/async_read/events.hpp"
+#include "emel/io/async_read/guards.hpp"
+
+namespace emel::io::async_read::action {
+
+struct effect_begin_read_batch {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.status.err = emel::error::cast(error::none);
+    ev.status.ok = false;
+    ev.status.done_count = 0u;
+    ev.status.bytes_read = 0u;
+    ev.status.failed_index = 0u;
+    ev.status.peak_in_flight = 0u;
+  }
+};
+
+struct effect_mark_invalid_callbacks {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.status.err = emel::error::cast(error::invalid_callbacks);
+    ev.status.ok = false;
+  }
+};
+
+struct effect_mark_invalid_request {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.status.err = emel::error::cast(error::invalid_request);
+    ev.status.ok = false;
+    ev.status.failed_index = guard::first_invalid_request_index(ev);
+  }
+};
+
+struct effect_mark_engine_unavailable {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.status.err = emel::error::cast(error::engine_unavailable);
+    ev.status.ok = false;
+  }
+};
+
+struct effect_mark_batch_too_large {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &ctx) const noexcept {
+    ev.status.err = emel::error::cast(error::resource_exhausted);
+    ev.status.ok = false;
+    ev.status.failed_index = static_cast<uint32_t>(ctx.tensor_bytes.size());
+  }
+};
+
+// Runs the whole batch on the bound engine in the requested `read_mode` and
+// joins every lane before returning.
+struct effect_execute_read_batch {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &ctx) const noexcept;
+};
+
+struct effect_publish_read_batch_done {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &ctx) const noexcept {
+    ev.request.on_done(events::read_batch_done{
+        .intent = ev.request,
+        .engine = ctx.engine_kind,
+        .done_count = ev.status.done_count,
+        .bytes_read = ev.status.bytes_read,
+        .peak_in_flight = ev.status.peak_in_flight,
+    });
+  }
+};
+
+inline void publish_tensor_done_none(const detail::read_batch_runtime &,
+                                     uint32_t, uint64_t) noexcept {}
+
+inline void publish_tensor_done_some(const detail::read_batch_runtime &ev,
+                                     const uint32_t index,
+                                     const uint64_t bytes) noexcept {
+  ev.request.on_tensor_done(events::read_tensor_done{
+      .intent = ev.request,
+      .tensor_index = index,
+      .bytes_read = bytes,
+  });
+}
+
+// Lanes are joined by now, so the relaxed counter loads see every add.
+struct effect_publish_tensor_completions {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &ctx) const noexcept {
+    using publish_handler_t = void (*)(const detail::read_batch_runtime &,
+                                       uint32_t, uint64_t) noexcept;
+    const publish_handler_t publish_handlers[2] = {
+        publish_tensor_done_none,
+        publish_tensor_done_some,
+    };
+    for (uint32_t index = 0u;
+         index < static_cast<uint32_t>(ev.request.tensors.size()); ++index) {
+      const uint64_t landed =
+          ctx.tensor_bytes[index].load(std::memory_order_relaxed);
+      publish_handlers[static_cast<size_t>(
+          landed == ev.request.tensors[index].byte_size)](ev, index, landed);
+    }
+  }
+};
+
+struct effect_publish_read_batch_error {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.request.on_error(events::read_batch_error{
+        .intent = ev.request,
+        .err = ev.status.err,
+        .failed_index = ev.status.failed_index,
+    });
+  }
+};
+
+struct effect_record_read_batch_done {
+  void operator()(const detail::read_batch_runtime &,
+                  context &) const noexcept {}
+};
+
+struct effect_record_read_batch_error {
+  void operator()(const detail::read_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.status.ok = false;
+  }
+};
+
+struct effect_on_unexpected {
+  template <class event_type>
+  void operator()(const event_type &ev, context &) const noexcept {
+    if constexpr (requires { ev.status.err; }) {
+      ev.status.err = emel::error::cast(error::internal_error);
+      ev.status.ok = false;
+    }
+  }
+};
+
+inline constexpr effect_begin_read_batch effect_begin_read_batch{};
+inline constexpr effect_mark_invalid_callbacks effect_mark_invalid_callbacks{};
+inline constexpr effect_mark_invalid_request effect_mark_invalid_request{};
+inline constexpr effect_mark_engine_unavailable
+    effect_mark_engine_unavailable{};
+inline constexpr effect_mark_batch_too_large effect_mark_batch_too_large{};
+inline constexpr effect_execute_read_batch effect_execute_read_batch{};
+inline constexpr effect_publish_tensor_completions
+    effect_publish_tensor_completions{};
+inline constexpr effect_publish_read_batch_done
+    effect_publish_read_batch_done{};
+inline constexpr effect_publish_read_batch_error
+    effect_publish_read_batch_error{};
+inline constexpr effect_record_read_batch_done effect_record_read_batch_done{};
+inline constexpr effect_record_read_batch_error
+    effect_record_read_batch_error{};
+inline constexpr effect_on_unexpected effect_on_unexpected{};
+
+} // namespace emel::io::async_read::action
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "emel/io/async_read/detail.hpp"
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/async_read/events.hpp"
+#include "emel/io/events.hpp"
+
+namespace emel::io::async_read::action {
+
+enum class engine_preference : uint8_t {
+  // io_uring when the kernel grants a ring, the pread path otherwise.
+  automatic = 0u,
+  io_uring = 1u,
+  thread_pool = 2u,
+};
+
+struct engine_config {
+  engine_preference preference = engine_preference::automatic;
+  // Open files with O_DIRECT on the io_uring engine where the filesystem
+  // accepts it, so a cold multi-GB load streams from the device instead of
+  // evicting the page cache. Falls back to buffered reads per file.
+  bool direct_io = true;
+  // Owner lanes that run pread reads alongside the dispatching thread. They
+  // serve `sharded` batches on every engine and `queued` batches when no ring
+  // is available; nullptr reads on the dispatching thread alone. The pool
+  // must outlive the actor.
+  detail::lane_pool *lanes = nullptr;
+  // Largest batch the actor accepts; sizes the per-tensor completion
+  // counters, clamped to `k_max_batch_tensors`.
+  uint32_t max_batch_tensors = k_max_batch_tensors;
+};
+
+// Opaque engine state (ring mappings, registered buffers, open files),
+// defined in actions.cpp.
+struct engine;
+
+// Platform I/O boundary, injected at construction like io/mmap. Production
+// defaults own the ring setup and the syscalls; tests
+// supply failing operations to drive the modeled failure routes. The engine
+// is created once per actor so no allocation or thread start happens during
+// dispatch.
+struct platform_ops {
+  engine *(*create)(const engine_config &config) noexcept = nullptr;
+  void (*destroy)(engine *io_engine) noexcept = nullptr;
+  event::engine_kind (*kind)(const engine *io_engine) noexcept = nullptr;
+  void (*read_batch)(engine *io_engine, const detail::read_batch_plan &plan,
+                     detail::read_batch_attempt_status &status_out) noexcept =
+      nullptr;
+};
+
+// The production operations; exposed so an injector can override a single op
+// and keep the rest.
+platform_ops default_platform_ops() noexcept;
+
+using lane_pool = detail::lane_pool;
+
+struct context {
+  platform_ops platform{};
+  lane_pool *lanes = nullptr;
+  engine *io_engine = nullptr;
+  event::engine_kind engine_kind = event::engine_kind::none;
+  std::vector<std::atomic<uint64_t>> tensor_bytes;
+
+  context() noexcept;
+  explicit context(const engine_config &config) noexcept;
+  context(const platform_ops &platform_in,
+          const engine_config &config) noexcept;
+  ~context() noexcept;
+
+  context(const context &) = delete;
+  context &operator=(const context &) = delete;
+  context(context &&) = delete;
+  context &operator=(context &&) = delete;
+};
+
+} // namespace emel::io::async_read::action
@@ -0,0 +1,44 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <span>
+
+#include "emel/error/error.hpp"
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/async_read/events.hpp"
+#include "emel/sm.hpp"
+
+namespace emel::io::async_read::detail {
+
+// Same pool type as kernel::matmul::lane_pool, so the owner can lend the
+// loader the lanes decode uses later.
+using lane_pool = emel::policy::fork_join_lane_pool<7u, 128u, 1048576u>;
+
+struct read_batch_attempt_status {
+  emel::error::type err = emel::error::cast(error::none);
+  bool ok = false;
+  uint32_t done_count = 0u;
+  uint64_t bytes_read = 0u;
+  uint32_t failed_index = 0u;
+  uint32_t peak_in_flight = 0u;
+};
+
+// What the engine reads and where it reports progress. `tensor_bytes` holds
+// one landed-byte counter per tensor, owned by the context; lanes add to it
+// concurrently. `lanes` is the owner's pool; nullptr leaves the pread path to
+// the dispatching thread alone.
+struct read_batch_plan {
+  std::span<const emel::io::event::tensor_load_span> tensors = {};
+  event::read_mode mode = event::read_mode::queued;
+  std::span<std::atomic<uint64_t>> tensor_bytes = {};
+  lane_pool *lanes = nullptr;
+};
+
+// INTERNAL-only synchronous carrier; mutable status is not exposed publicly.
+struct read_batch_runtime {
+  const event::read_batch &request;
+  read_batch_attempt_status &status;
+};
+
+} // namespace emel::io::async_read::detail
@@ -0,0 +1,85 @@
+#pragma once
+
+#include <cstdint>
+
+#include "emel/error/error.hpp"
+
+#ifndef EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED
+#if defined(__APPLE__) || defined(__linux__) || defined(__unix__)
+#define EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED 1
+#else
+#define EMEL_IO_ASYNC_READ_PLATFORM_SUPPORTED 0
+#endif
+#endif
+
+// The io_uring engine talks to the kernel through raw syscalls and only needs
+// the uapi header; hosts without it keep the pread engine.
+#ifndef EMEL_IO_ASYNC_READ_IO_URING
+#if defined(__linux__) && defined(__has_include)
+#if __has_include(<linux/io_uring.h>)
+#define EMEL_IO_ASYNC_READ_IO_URING 1
+#endif
+#endif
+#endif
+#ifndef EMEL_IO_ASYNC_READ_IO_URING
+#define EMEL_IO_ASYNC_READ_IO_URING 0
+#endif
+
+#ifndef EMEL_IO_ASYNC_READ_QUEUE_DEPTH
+#define EMEL_IO_ASYNC_READ_QUEUE_DEPTH 64u
+#endif
+
+#ifndef EMEL_IO_ASYNC_READ_BLOCK_BYTES
+#define EMEL_IO_ASYNC_READ_BLOCK_BYTES (256u * 1024u)
+#endif
+
+#ifndef EMEL_IO_ASYNC_READ_SHARD_READ_BYTES
+#define EMEL_IO_ASYNC_READ_SHARD_READ_BYTES (8u * 1024u * 1024u)
+#endif
+
+#ifndef EMEL_IO_ASYNC_READ_MAX_OPEN_FILES
+#define EMEL_IO_ASYNC_READ_MAX_OPEN_FILES 128u
+#endif
+
+#ifndef EMEL_IO_ASYNC_READ_MAX_BATCH_TENSORS
+#define EMEL_IO_ASYNC_READ_MAX_BATCH_TENSORS 65536u
+#endif
+
+namespace emel::io::async_read {
+
+enum class error : emel::error::type {
+  none = 0u,
+  invalid_callbacks = (1u << 0),
+  invalid_request = (1u << 1),
+  engine_unavailable = (1u << 2),
+  file_open_failed = (1u << 3),
+  resource_exhausted = (1u << 4),
+  read_failed = (1u << 5),
+  short_read = (1u << 6),
+  internal_error = (1u << 7),
+};
+
+// Reads in flight at once; also the number of registered io_uring buffers.
+inline constexpr uint32_t k_queue_depth = EMEL_IO_ASYNC_READ_QUEUE_DEPTH;
+// Largest tensor slice carried by one read.
+inline constexpr uint64_t k_block_bytes = EMEL_IO_ASYNC_READ_BLOCK_BYTES;
+// O_DIRECT offset/length/buffer alignment; registered buffers carry one extra
+// alignment unit so any unaligned slice fits after rounding outward.
+inline constexpr uint64_t k_direct_io_alignment = 4096u;
+// Largest single pread issued by a sharded batch.
+inline constexpr uint64_t k_shard_read_bytes =
+    EMEL_IO_ASYNC_READ_SHARD_READ_BYTES;
+// Covers every file of a split GGUF (`model::data::k_max_split_files`).
+inline constexpr uint32_t k_max_open_files = EMEL_IO_ASYNC_READ_MAX_OPEN_FILES;
+// Tensors tracked per batch for per-tensor completion.
+inline constexpr uint32_t k_max_batch_tensors =
+    EMEL_IO_ASYNC_READ_MAX_BATCH_TENSORS;
+inline constexpr uint64_t k_max_file_path_bytes = 4095u;
+
+static_assert((k_queue_depth & (k_queue_depth - 1u)) == 0u,
+              "async_read queue depth must be a power of two");
+static_assert(k_block_bytes % k_direct_io_alignment == 0u,
+              "async_read block must be a multiple of the direct I/O unit");
+static_assert(k_shard_read_bytes > 0u, "async_read shard reads need bytes");
+
+} // namespace emel::io::async_read
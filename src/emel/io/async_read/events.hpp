@@ -0,0 +1,89 @@
+#pragma once
+
+#include <cstdint>
+#include <span>
+
+#include "emel/callback.hpp"
+#include "emel/error/error.hpp"
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/events.hpp"
+
+namespace emel::io::async_read::events {
+
+struct read_tensor_done;
+struct read_batch_done;
+struct read_batch_error;
+
+} // namespace emel::io::async_read::events
+
+namespace emel::io::async_read::event {
+
+// I/O engine bound at actor construction. `io_uring` keeps up to
+// `k_queue_depth` fixed-buffer reads in flight from one submitting thread;
+// `thread_pool` issues blocking preads on the owner's lane pool.
+enum class engine_kind : uint8_t {
+  none = 0u,
+  io_uring = 1u,
+  thread_pool = 2u,
+};
+
+// How a batch is spread over the engine.
+//
+// `queued` cuts every tensor into `k_block_bytes` slices that share the
+// engine's queue in request order. `sharded` splits the batch into
+// byte-balanced contiguous shards, one per owner lane plus the dispatching
+// thread, and reads each shard with preads of up to `k_shard_read_bytes`
+// straight into the targets. Shards run concurrently. A batch whose tensors
+// come from several split files therefore reads those files at the same time.
+// `sharded` always runs on the pread path, even on an io_uring engine.
+enum class read_mode : uint8_t {
+  queued = 0u,
+  sharded = 1u,
+};
+
+// Reads every tensor span straight from `file_path` at `file_offset` into the
+// caller-owned `target`. Unlike io/read, the filesystem work happens inside
+// this dispatch: `source_buffer` and `source_error` are ignored. Slices of all
+// tensors share one submission queue, so small tensors and the tail of large
+// ones overlap instead of waiting on each other.
+struct read_batch {
+  std::span<const emel::io::event::tensor_load_span> tensors = {};
+  emel::callback<void(const events::read_batch_done &)> on_done = {};
+  emel::callback<void(const events::read_batch_error &)> on_error = {};
+  read_mode mode = read_mode::queued;
+  // Optional. Published once for each tensor whose bytes all landed. Calls
+  // come after the lanes join and before `on_done` or `on_error`, so a
+  // failed batch still reports which targets are complete.
+  emel::callback<void(const events::read_tensor_done &)> on_tensor_done = {};
+
+  explicit read_batch(
+      std::span<const emel::io::event::tensor_load_span> tensors_in) noexcept
+      : tensors(tensors_in) {}
+};
+
+} // namespace emel::io::async_read::event
+
+namespace emel::io::async_read::events {
+
+struct read_tensor_done {
+  const event::read_batch &intent;
+  uint32_t tensor_index = 0u;
+  uint64_t bytes_read = 0u;
+};
+
+struct read_batch_done {
+  const event::read_batch &intent;
+  event::engine_kind engine = event::engine_kind::none;
+  uint32_t done_count = 0u;
+  uint64_t bytes_read = 0u;
+  // Highest number of reads the engine had outstanding during the batch.
+  uint32_t peak_in_flight = 0u;
+};
+
+struct read_batch_error {
+  const event::read_batch &intent;
+  emel::error::type err = emel::error::cast(error::none);
+  uint32_t failed_index = 0u;
+};
+
+} // namespace emel::io::async_read::events
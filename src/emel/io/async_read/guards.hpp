@@ -0,0 +1,140 @@
+#pragma once
+
+#include <cstdint>
+
+#include "emel/io/async_read/context.hpp"
+#include "emel/io/async_read/detail.hpp"
+#include "emel/io/async_read/errors.hpp"
+
+namespace emel::io::async_read::guard {
+
+inline bool
+tensor_request_valid(const emel::io::event::tensor_load_span &tensor) noexcept {
+  return tensor.byte_size > 0u &&
+         tensor.file_offset <= ~0ull - tensor.byte_size &&
+         tensor.target != nullptr && tensor.target_bytes >= tensor.byte_size &&
+         !tensor.file_path.empty() &&
+         tensor.file_path.size() <= k_max_file_path_bytes;
+}
+
+inline void update_first_failure_index(uint32_t &failed_index,
+                                       uint32_t &found, const uint32_t index,
+                                       const bool failed) noexcept {
+  const uint32_t failed_value = static_cast<uint32_t>(failed);
+  const uint32_t take = (1u - found) * failed_value;
+  failed_index = (failed_index * (1u - take)) + (index * take);
+  found = found | failed_value;
+}
+
+inline uint32_t
+first_invalid_request_index(const detail::read_batch_runtime &ev) noexcept {
+  uint32_t failed_index = 0u;
+  uint32_t found = 0u;
+  for (uint32_t index = 0u;
+       index < static_cast<uint32_t>(ev.request.tensors.size()); ++index) {
+    update_first_failure_index(
+        failed_index, found, index,
+        !tensor_request_valid(ev.request.tensors[index]));
+  }
+  return failed_index;
+}
+
+struct guard_read_batch_callbacks_present {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &) const noexcept {
+    return static_cast<bool>(ev.request.on_done) &&
+           static_cast<bool>(ev.request.on_error);
+  }
+};
+
+struct guard_read_batch_callbacks_missing {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return !guard_read_batch_callbacks_present{}(ev, ctx);
+  }
+};
+
+struct guard_read_batch_requests_valid {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &) const noexcept {
+    bool valid = !ev.request.tensors.empty();
+    for (uint32_t index = 0u;
+         index < static_cast<uint32_t>(ev.request.tensors.size()); ++index) {
+      valid = valid && tensor_request_valid(ev.request.tensors[index]);
+    }
+    return valid;
+  }
+};
+
+struct guard_read_batch_requests_invalid {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return !guard_read_batch_requests_valid{}(ev, ctx);
+  }
+};
+
+struct guard_read_batch_within_capacity {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return ev.request.tensors.size() <= ctx.tensor_bytes.size();
+  }
+};
+
+struct guard_read_batch_exceeds_capacity {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return !guard_read_batch_within_capacity{}(ev, ctx);
+  }
+};
+
+struct guard_engine_available {
+  bool operator()(const detail::read_batch_runtime &,
+                  const action::context &ctx) const noexcept {
+    return ctx.io_engine != nullptr;
+  }
+};
+
+struct guard_engine_unavailable {
+  bool operator()(const detail::read_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return !guard_engine_available{}(ev, ctx);
+  }
+};
+
+struct guard_read_batch_succeeded {
+  bool operator()(const detail::read_batch_runtime &ev) const noexcept {
+    return ev.status.ok;
+  }
+};
+
+struct guard_read_batch_failed {
+  bool operator()(const detail::read_batch_runtime &ev) const noexcept {
+    return !guard_read_batch_succeeded{}(ev);
+  }
+};
+
+struct tensor_done_callback_present {
+  bool operator()(const detail::read_batch_runtime &ev) const noexcept {
+    return static_cast<bool>(ev.request.on_tensor_done);
+  }
+};
+
+struct tensor_done_callback_absent {
+  bool operator()(const detail::read_batch_runtime &ev) const noexcept {
+    return !tensor_done_callback_present{}(ev);
+  }
+};
+
+struct batch_error_callback_present {
+  bool operator()(const detail::read_batch_runtime &ev) const noexcept {
+    return static_cast<bool>(ev.request.on_error);
+  }
+};
+
+struct batch_error_callback_absent {
+  bool operator()(const detail::read_batch_runtime &ev) const noexcept {
+    return !batch_error_callback_present{}(ev);
+  }
+};
+
+} // namespace emel::io::async_read::guard
@@ -0,0 +1,215 @@
+#pragma once
+
+// benchmark: designed
+
+#include "emel/io/async_read/actions.hpp"
+#include "emel/io/async_read/context.hpp"
+#include "emel/io/async_read/detail.hpp"
+#include "emel/io/async_read/events.hpp"
+#include "emel/io/async_read/guards.hpp"
+#include "emel/sm.hpp"
+
+namespace emel::io::async_read {
+
+struct state_ready {};
+struct state_guard_callbacks_decision {};
+struct state_guard_requests_decision {};
+struct state_guard_capacity_decision {};
+struct state_guard_engine_decision {};
+struct state_tensor_completions_decision {};
+struct state_read_outcome_decision {};
+struct state_done_callback {};
+struct state_invalid_callbacks_error_decision {};
+struct state_invalid_request_error_decision {};
+struct state_capacity_error_decision {};
+struct state_engine_unavailable_error_decision {};
+struct state_read_failed_error_decision {};
+struct state_error_callback {};
+
+struct model {
+  auto operator()() const {
+    namespace sml = stateforward::sml;
+
+    // clang-format off
+    return sml::make_transition_table(
+      //------------------------------------------------------------------------------//
+      // Batch contract validation; the engine runs only once every span is valid.
+        sml::state<state_guard_callbacks_decision> <= *sml::state<state_ready>
+          + sml::event<detail::read_batch_runtime>
+          / action::effect_begin_read_batch
+      , sml::state<state_guard_requests_decision> <=
+          sml::state<state_guard_callbacks_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_callbacks_present{} ]
+      , sml::state<state_invalid_callbacks_error_decision> <=
+          sml::state<state_guard_callbacks_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_callbacks_missing{} ]
+          / action::effect_mark_invalid_callbacks
+      , sml::state<state_guard_capacity_decision> <=
+          sml::state<state_guard_requests_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_requests_valid{} ]
+      , sml::state<state_invalid_request_error_decision> <=
+          sml::state<state_guard_requests_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_requests_invalid{} ]
+          / action::effect_mark_invalid_request
+      , sml::state<state_guard_engine_decision> <=
+          sml::state<state_guard_capacity_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_within_capacity{} ]
+      , sml::state<state_capacity_error_decision> <=
+          sml::state<state_guard_capacity_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_exceeds_capacity{} ]
+          / action::effect_mark_batch_too_large
+      , sml::state<state_tensor_completions_decision> <=
+          sml::state<state_guard_engine_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_engine_available{} ]
+          / action::effect_execute_read_batch
+      , sml::state<state_engine_unavailable_error_decision> <=
+          sml::state<state_guard_engine_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_engine_unavailable{} ]
+          / action::effect_mark_engine_unavailable
+
+      //------------------------------------------------------------------------------//
+      // Engine outcome. Every slice has completed or been drained before the
+      // execute effect returns, so targets are final on both legs and
+      // per-tensor completions go out ahead of the batch result.
+      , sml::state<state_read_outcome_decision> <=
+          sml::state<state_tensor_completions_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::tensor_done_callback_present{} ]
+          / action::effect_publish_tensor_completions
+      , sml::state<state_read_outcome_decision> <=
+          sml::state<state_tensor_completions_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::tensor_done_callback_absent{} ]
+      , sml::state<state_done_callback> <=
+          sml::state<state_read_outcome_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_succeeded{} ]
+          / action::effect_publish_read_batch_done
+      , sml::state<state_read_failed_error_decision> <=
+          sml::state<state_read_outcome_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::guard_read_batch_failed{} ]
+      , sml::state<state_ready> <= sml::state<state_done_callback>
+          + sml::completion<detail::read_batch_runtime>
+          / action::effect_record_read_batch_done
+
+      //------------------------------------------------------------------------------//
+      // Error publication.
+      , sml::state<state_error_callback> <=
+          sml::state<state_invalid_callbacks_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_present{} ]
+          / action::effect_publish_read_batch_error
+      , sml::state<state_ready> <=
+          sml::state<state_invalid_callbacks_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_absent{} ]
+          / action::effect_record_read_batch_error
+      , sml::state<state_error_callback> <=
+          sml::state<state_invalid_request_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_present{} ]
+          / action::effect_publish_read_batch_error
+      , sml::state<state_ready> <=
+          sml::state<state_invalid_request_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_absent{} ]
+          / action::effect_record_read_batch_error
+      , sml::state<state_error_callback> <=
+          sml::state<state_capacity_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_present{} ]
+          / action::effect_publish_read_batch_error
+      , sml::state<state_ready> <=
+          sml::state<state_capacity_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_absent{} ]
+          / action::effect_record_read_batch_error
+      , sml::state<state_error_callback> <=
+          sml::state<state_engine_unavailable_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_present{} ]
+          / action::effect_publish_read_batch_error
+      , sml::state<state_ready> <=
+          sml::state<state_engine_unavailable_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_absent{} ]
+          / action::effect_record_read_batch_error
+      , sml::state<state_error_callback> <=
+          sml::state<state_read_failed_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_present{} ]
+          / action::effect_publish_read_batch_error
+      , sml::state<state_ready> <=
+          sml::state<state_read_failed_error_decision>
+          + sml::completion<detail::read_batch_runtime>
+          [ guard::batch_error_callback_absent{} ]
+          / action::effect_record_read_batch_error
+      , sml::state<state_ready> <= sml::state<state_error_callback>
+          + sml::completion<detail::read_batch_runtime>
+          / action::effect_record_read_batch_error
+
+      //------------------------------------------------------------------------------//
+      // Unexpected handling.
+      , sml::state<state_ready> <= sml::state<state_ready>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_guard_callbacks_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_guard_requests_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_guard_capacity_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_guard_engine_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_tensor_completions_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_read_outcome_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_done_callback>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_invalid_callbacks_error_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_invalid_request_error_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_capacity_error_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_engine_unavailable_error_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_read_failed_error_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_error_callback>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+    );
+    // clang-format on
+  }
+};
+
+struct sm : public emel::sm<model, action::context> {
+  using base_type = emel::sm<model, action::context>;
+  using base_type::base_type;
+  using base_type::is;
+  using base_type::process_event;
+  using base_type::visit_current_states;
+
+  bool process_event(const event::read_batch &ev) {
+    detail::read_batch_attempt_status status{};
+    detail::read_batch_runtime runtime{ev, status};
+    const bool accepted = base_type::process_event(runtime);
+    return accepted && status.ok;
+  }
+};
+
+} // namespace emel::io::async_read
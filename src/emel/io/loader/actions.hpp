@@ -1,5 +1,10 @@
 #pragma once
 
+#include <cstddef>
+
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/async_read/events.hpp"
+#include "emel/io/async_read/sm.hpp"
 #include "emel/io/loader/context.hpp"
 #include "emel/io/loader/detail.hpp"
 #include "emel/io/loader/errors.hpp"
@@ -223,6 +228,63 @@ inline void on_read_batch_error(
 
 } // namespace read_batch_callbacks
 
+namespace async_read_callbacks {
+
+inline void on_async_read_done(
+    void *object,
+    const emel::io::async_read::events::read_batch_done &ev) noexcept {
+  auto *status = static_cast<detail::runtime_status *>(object);
+  status->err = emel::error::cast(error::none);
+  status->strategy_err = emel::error::cast(emel::io::async_read::error::none);
+  status->ok = true;
+  status->bytes_copied = ev.bytes_read;
+  status->buffer = ev.intent.tensors[0].target;
+}
+
+inline void on_async_read_error(
+    void *object,
+    const emel::io::async_read::events::read_batch_error &ev) noexcept {
+  auto *status = static_cast<detail::runtime_status *>(object);
+  status->err = emel::error::cast(error::unavailable);
+  status->strategy_err = ev.err;
+  status->ok = false;
+}
+
+inline void on_async_read_batch_done(
+    void *object,
+    const emel::io::async_read::events::read_batch_done &ev) noexcept {
+  auto *status = static_cast<detail::batch_runtime_status *>(object);
+  status->err = emel::error::cast(error::none);
+  status->strategy_err = emel::error::cast(emel::io::async_read::error::none);
+  status->ok = true;
+  status->done_count = ev.done_count;
+  status->bytes_done = ev.bytes_read;
+}
+
+inline void on_async_read_batch_error(
+    void *object,
+    const emel::io::async_read::events::read_batch_error &ev) noexcept {
+  auto *status = static_cast<detail::batch_runtime_status *>(object);
+  status->err = emel::error::cast(error::unavailable);
+  status->strategy_err = ev.err;
+  status->ok = false;
+  status->failed_index = ev.failed_index;
+}
+
+inline void on_async_read_batch_tensor_done(
+    void *object,
+    const emel::io::async_read::events::read_tensor_done &ev) noexcept {
+  const auto *runtime =
+      static_cast<const detail::load_tensor_batch_runtime *>(object);
+  runtime->request.on_tensor_done(events::load_tensor_batch_tensor_done{
+      .request = runtime->request,
+      .tensor_index = ev.tensor_index,
+      .bytes_done = ev.bytes_read,
+  });
+}
+
+} // namespace async_read_callbacks
+
 struct effect_dispatch_read_tensor {
   void operator()(const detail::load_tensor_runtime &ev,
                   context &ctx) const noexcept {
@@ -318,6 +380,52 @@ struct effect_dispatch_staged_read_tensor_batch {
   }
 };
 
+// A single tensor rides the same engine as a one-span batch; its slices
+// still overlap in the submission queue.
+struct effect_dispatch_async_read_tensor {
+  void operator()(const detail::load_tensor_runtime &ev,
+                  context &ctx) const noexcept {
+    emel::io::async_read::event::read_batch read{
+        std::span<const tensor_load_span>{&ev.request.tensor, 1u}};
+    read.on_done = {static_cast<void *>(&ev.ctx),
+                    async_read_callbacks::on_async_read_done};
+    read.on_error = {static_cast<void *>(&ev.ctx),
+                     async_read_callbacks::on_async_read_error};
+    static_cast<void>(ctx.io_async_read->process_event(read));
+  }
+};
+
+// Serves async_read batches and the parallel mode of read_copy and
+// staged_read batches. The per-tensor forwarder is bound only when the caller
+// asked for per-tensor completions.
+struct effect_dispatch_async_read_tensor_batch {
+  void operator()(const detail::load_tensor_batch_runtime &ev,
+                  context &ctx) const noexcept {
+    using tensor_done_thunk_t =
+        void (*)(void *,
+                 const emel::io::async_read::events::read_tensor_done &) noexcept;
+    const tensor_done_thunk_t tensor_done_thunks[2] = {
+        nullptr,
+        async_read_callbacks::on_async_read_batch_tensor_done,
+    };
+    const emel::io::async_read::event::read_mode read_modes[2] = {
+        emel::io::async_read::event::read_mode::queued,
+        emel::io::async_read::event::read_mode::sharded,
+    };
+    emel::io::async_read::event::read_batch read{ev.request.tensors};
+    read.on_done = {static_cast<void *>(&ev.status),
+                    async_read_callbacks::on_async_read_batch_done};
+    read.on_error = {static_cast<void *>(&ev.status),
+                     async_read_callbacks::on_async_read_batch_error};
+    read.mode = read_modes[static_cast<size_t>(
+        ev.request.policy.batch == event::batch_mode::parallel)];
+    read.on_tensor_done = {
+        ev, tensor_done_thunks[static_cast<size_t>(
+            static_cast<bool>(ev.request.on_tensor_done))]};
+    ev.status.accepted = ctx.io_async_read->process_event(read);
+  }
+};
+
 struct effect_on_unexpected {
   template <class event_type>
   void operator()(const event_type &ev, context &) const noexcept {
@@ -367,6 +475,10 @@ inline constexpr effect_dispatch_read_tensor_batch
     effect_dispatch_read_tensor_batch{};
 inline constexpr effect_dispatch_staged_read_tensor_batch
     effect_dispatch_staged_read_tensor_batch{};
+inline constexpr effect_dispatch_async_read_tensor
+    effect_dispatch_async_read_tensor{};
+inline constexpr effect_dispatch_async_read_tensor_batch
+    effect_dispatch_async_read_tensor_batch{};
 inline constexpr effect_on_unexpected effect_on_unexpected{};
 
 } // namespace emel::io::loader::action
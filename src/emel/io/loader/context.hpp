@@ -8,11 +8,16 @@ namespace emel::io::staged_read {
 struct sm;
 } // namespace emel::io::staged_read
 
+namespace emel::io::async_read {
+struct sm;
+} // namespace emel::io::async_read
+
 namespace emel::io::loader::action {
 
 struct context {
   emel::io::read::sm *io_read = nullptr;
   emel::io::staged_read::sm *io_staged_read = nullptr;
+  emel::io::async_read::sm *io_async_read = nullptr;
 };
 
 } // namespace emel::io::loader::action
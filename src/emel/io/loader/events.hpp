@@ -13,6 +13,7 @@ namespace emel::io::loader::events {
 
 struct load_tensor_done;
 struct load_tensor_error;
+struct load_tensor_batch_tensor_done;
 struct load_tensor_batch_done;
 struct load_tensor_batch_error;
 
@@ -28,11 +29,23 @@ enum class strategy_kind : uint8_t {
   read_copy = 2u,
   external_buffer = 3u,
   staged_read = 4u,
+  async_read = 5u,
+};
+
+// How a batch walks its tensors. `serial` copies tensor by tensor through
+// the selected strategy actor. `parallel` reads read_copy, staged_read and
+// async_read batches straight from `file_path` through the bound io/async_read
+// actor. The batch is split into byte-balanced shards read concurrently with
+// large preads. `source_buffer` is ignored on that route.
+enum class batch_mode : uint8_t {
+  serial = 0u,
+  parallel = 1u,
 };
 
 struct strategy_policy {
   strategy_kind strategy = strategy_kind::none;
   uint64_t staged_chunk_bytes = k_default_staged_read_chunk_bytes;
+  batch_mode batch = batch_mode::serial;
 };
 
 using tensor_load_span = emel::io::event::tensor_load_span;
@@ -53,6 +66,10 @@ struct load_tensor_batch {
   const strategy_policy &policy;
   emel::callback<void(const events::load_tensor_batch_done &)> on_done = {};
   emel::callback<void(const events::load_tensor_batch_error &)> on_error = {};
+  // Optional. Published once per fully loaded tensor, ahead of `on_done` or
+  // `on_error`. Only the async_read route reports it.
+  emel::callback<void(const events::load_tensor_batch_tensor_done &)>
+      on_tensor_done = {};
 
   load_tensor_batch(std::span<const tensor_load_span> tensors_in,
                     const strategy_policy &policy_in) noexcept
@@ -76,6 +93,12 @@ struct load_tensor_error {
   emel::error::type strategy_err = emel::error::cast(error::none);
 };
 
+struct load_tensor_batch_tensor_done {
+  const event::load_tensor_batch &request;
+  uint32_t tensor_index = 0u;
+  uint64_t bytes_done = 0u;
+};
+
 struct load_tensor_batch_done {
   const event::load_tensor_batch &request;
   event::strategy_kind strategy = event::strategy_kind::none;
@@ -62,9 +62,22 @@ struct strategy_read_copy {
   }
 };
 
+struct batch_mode_serial {
+  bool operator()(const detail::load_tensor_batch_runtime &ev) const noexcept {
+    return ev.request.policy.batch == event::batch_mode::serial;
+  }
+};
+
+struct batch_mode_parallel {
+  bool operator()(const detail::load_tensor_batch_runtime &ev) const noexcept {
+    return ev.request.policy.batch == event::batch_mode::parallel;
+  }
+};
+
 struct strategy_read_copy_batch {
   bool operator()(const detail::load_tensor_batch_runtime &ev) const noexcept {
-    return ev.request.policy.strategy == event::strategy_kind::read_copy;
+    return ev.request.policy.strategy == event::strategy_kind::read_copy &&
+           batch_mode_serial{}(ev);
   }
 };
 
@@ -76,7 +89,31 @@ struct strategy_staged_read {
 
 struct strategy_staged_read_batch {
   bool operator()(const detail::load_tensor_batch_runtime &ev) const noexcept {
-    return ev.request.policy.strategy == event::strategy_kind::staged_read;
+    return ev.request.policy.strategy == event::strategy_kind::staged_read &&
+           batch_mode_serial{}(ev);
+  }
+};
+
+// read_copy and staged_read batches that asked for the parallel mode.
+// Parallel async_read batches keep the async_read selectors.
+struct strategy_parallel_copy_batch {
+  bool operator()(const detail::load_tensor_batch_runtime &ev) const noexcept {
+    const auto strategy = ev.request.policy.strategy;
+    return (strategy == event::strategy_kind::read_copy ||
+            strategy == event::strategy_kind::staged_read) &&
+           batch_mode_parallel{}(ev);
+  }
+};
+
+struct strategy_async_read {
+  bool operator()(const detail::load_tensor_runtime &ev) const noexcept {
+    return ev.request.policy.strategy == event::strategy_kind::async_read;
+  }
+};
+
+struct strategy_async_read_batch {
+  bool operator()(const detail::load_tensor_batch_runtime &ev) const noexcept {
+    return ev.request.policy.strategy == event::strategy_kind::async_read;
   }
 };
 
@@ -104,6 +141,18 @@ struct staged_read_actor_absent {
   }
 };
 
+struct async_read_actor_present {
+  bool operator()(const action::context &ctx) const noexcept {
+    return ctx.io_async_read != nullptr;
+  }
+};
+
+struct async_read_actor_absent {
+  bool operator()(const action::context &ctx) const noexcept {
+    return !async_read_actor_present{}(ctx);
+  }
+};
+
 struct strategy_read_copy_with_actor {
   bool operator()(const detail::load_tensor_runtime &ev,
                   const action::context &ctx) const noexcept {
@@ -162,6 +211,50 @@ struct strategy_staged_read_batch_without_actor {
   }
 };
 
+struct strategy_async_read_with_actor {
+  bool operator()(const detail::load_tensor_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return strategy_async_read{}(ev) && async_read_actor_present{}(ctx);
+  }
+};
+
+struct strategy_async_read_without_actor {
+  bool operator()(const detail::load_tensor_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return strategy_async_read{}(ev) && async_read_actor_absent{}(ctx);
+  }
+};
+
+struct strategy_async_read_batch_with_actor {
+  bool operator()(const detail::load_tensor_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return strategy_async_read_batch{}(ev) && async_read_actor_present{}(ctx);
+  }
+};
+
+struct strategy_async_read_batch_without_actor {
+  bool operator()(const detail::load_tensor_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return strategy_async_read_batch{}(ev) && async_read_actor_absent{}(ctx);
+  }
+};
+
+struct strategy_parallel_copy_batch_with_actor {
+  bool operator()(const detail::load_tensor_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return strategy_parallel_copy_batch{}(ev) &&
+           async_read_actor_present{}(ctx);
+  }
+};
+
+struct strategy_parallel_copy_batch_without_actor {
+  bool operator()(const detail::load_tensor_batch_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return strategy_parallel_copy_batch{}(ev) &&
+           async_read_actor_absent{}(ctx);
+  }
+};
+
 struct staged_read_source_span_valid {
   bool operator()(const detail::load_tensor_runtime &ev) const noexcept {
     const auto &tensor = ev.request.tensor;
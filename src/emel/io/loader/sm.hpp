@@ -18,6 +18,7 @@ struct state_unsupported_strategy_error_decision {};
 struct state_error_callback {};
 struct state_read_dispatch_decision {};
 struct state_staged_read_dispatch_decision {};
+struct state_async_read_dispatch_decision {};
 struct state_done_decision {};
 struct state_done_callback {};
 struct state_batch_request_decision {};
@@ -25,6 +26,7 @@ struct state_batch_unsupported_strategy_error_decision {};
 struct state_batch_error_callback {};
 struct state_batch_read_dispatch_decision {};
 struct state_batch_staged_read_dispatch_decision {};
+struct state_batch_async_read_dispatch_decision {};
 struct state_batch_done_decision {};
 struct state_batch_done_callback {};
 
@@ -64,6 +66,11 @@ struct model {
           + sml::completion<detail::load_tensor_runtime>
           [ guard::strategy_staged_read_with_actor_and_source_span_invalid{} ]
           / action::effect_mark_invalid_request
+      , sml::state<state_async_read_dispatch_decision> <=
+          sml::state<state_request_decision>
+          + sml::completion<detail::load_tensor_runtime>
+          [ guard::strategy_async_read_with_actor{} ]
+          / action::effect_dispatch_async_read_tensor
       , sml::state<state_unsupported_strategy_error_decision> <=
           sml::state<state_request_decision>
           + sml::completion<detail::load_tensor_runtime>
@@ -74,6 +81,11 @@ struct model {
           + sml::completion<detail::load_tensor_runtime>
           [ guard::strategy_staged_read_without_actor{} ]
           / action::effect_mark_unsupported_strategy
+      , sml::state<state_unsupported_strategy_error_decision> <=
+          sml::state<state_request_decision>
+          + sml::completion<detail::load_tensor_runtime>
+          [ guard::strategy_async_read_without_actor{} ]
+          / action::effect_mark_unsupported_strategy
       , sml::state<state_unsupported_strategy_error_decision> <=
           sml::state<state_request_decision>
           + sml::completion<detail::load_tensor_runtime>
@@ -103,6 +115,14 @@ struct model {
           sml::state<state_staged_read_dispatch_decision>
           + sml::completion<detail::load_tensor_runtime>
           [ guard::read_load_failed{} ]
+      , sml::state<state_done_decision> <=
+          sml::state<state_async_read_dispatch_decision>
+          + sml::completion<detail::load_tensor_runtime>
+          [ guard::read_load_succeeded{} ]
+      , sml::state<state_unsupported_strategy_error_decision> <=
+          sml::state<state_async_read_dispatch_decision>
+          + sml::completion<detail::load_tensor_runtime>
+          [ guard::read_load_failed{} ]
 
       //------------------------------------------------------------------------------//
       // Completion/error publication is explicit even before concrete strategies exist.
@@ -143,6 +163,7 @@ struct model {
       //------------------------------------------------------------------------------//
       // Batch read/copy route. The selected strategy dispatches exactly one
       // public io/read batch event; source copying remains owned by io/read.
+      // Parallel read_copy and staged_read batches go to io/async_read.
       , sml::state<state_batch_request_decision> <= *sml::state<state_ready>
           + sml::event<detail::load_tensor_batch_runtime>
           [ guard::batch_span_valid{} ]
@@ -167,6 +188,16 @@ struct model {
           + sml::completion<detail::load_tensor_batch_runtime>
           [ guard::strategy_staged_read_batch_with_actor_and_source_span_invalid{} ]
           / action::effect_mark_load_tensor_batch_invalid_request
+      , sml::state<state_batch_async_read_dispatch_decision> <=
+          sml::state<state_batch_request_decision>
+          + sml::completion<detail::load_tensor_batch_runtime>
+          [ guard::strategy_async_read_batch_with_actor{} ]
+          / action::effect_dispatch_async_read_tensor_batch
+      , sml::state<state_batch_async_read_dispatch_decision> <=
+          sml::state<state_batch_request_decision>
+          + sml::completion<detail::load_tensor_batch_runtime>
+          [ guard::strategy_parallel_copy_batch_with_actor{} ]
+          / action::effect_dispatch_async_read_tensor_batch
       , sml::state<state_batch_unsupported_strategy_error_decision> <=
           sml::state<state_batch_request_decision>
           + sml::completion<detail::load_tensor_batch_runtime>
@@ -177,6 +208,16 @@ struct model {
           + sml::completion<detail::load_tensor_batch_runtime>
           [ guard::strategy_staged_read_batch_without_actor{} ]
           / action::effect_mark_load_tensor_batch_unsupported_strategy
+      , sml::state<state_batch_unsupported_strategy_error_decision> <=
+          sml::state<state_batch_request_decision>
+          + sml::completion<detail::load_tensor_batch_runtime>
+          [ guard::strategy_async_read_batch_without_actor{} ]
+          / action::effect_mark_load_tensor_batch_unsupported_strategy
+      , sml::state<state_batch_unsupported_strategy_error_decision> <=
+          sml::state<state_batch_request_decision>
+          + sml::completion<detail::load_tensor_batch_runtime>
+          [ guard::strategy_parallel_copy_batch_without_actor{} ]
+          / action::effect_mark_load_tensor_batch_unsupported_strategy
       , sml::state<state_batch_unsupported_strategy_error_decision> <=
           sml::state<state_batch_request_decision>
           + sml::completion<detail::load_tensor_batch_runtime>
@@ -200,6 +241,15 @@ struct model {
           + sml::completion<detail::load_tensor_batch_runtime>
           [ guard::read_batch_failed{} ]
           / action::effect_record_read_tensor_batch_failed
+      , sml::state<state_batch_done_decision> <=
+          sml::state<state_batch_async_read_dispatch_decision>
+          + sml::completion<detail::load_tensor_batch_runtime>
+          [ guard::read_batch_succeeded{} ]
+      , sml::state<state_batch_unsupported_strategy_error_decision> <=
+          sml::state<state_batch_async_read_dispatch_decision>
+          + sml::completion<detail::load_tensor_batch_runtime>
+          [ guard::read_batch_failed{} ]
+          / action::effect_record_read_tensor_batch_failed
 
       //------------------------------------------------------------------------------//
       // Batch completion/error publication.
@@ -247,6 +297,9 @@ struct model {
       , sml::state<state_ready> <=
           sml::state<state_staged_read_dispatch_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_async_read_dispatch_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_done_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_done_callback>
@@ -264,6 +317,9 @@ struct model {
       , sml::state<state_ready> <=
           sml::state<state_batch_staged_read_dispatch_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <=
+          sml::state<state_batch_async_read_dispatch_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_batch_done_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_batch_done_callback>
@@ -9,6 +9,7 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 #else
+#include <cerrno>
 #include <fcntl.h>
 #include <sys/mman.h>
 #include <sys/stat.h>
@@ -247,6 +248,29 @@ bool platform_advise_dontneed(void *base, uint64_t offset,
 #endif
 }
 
+bool platform_advise_hugepage(void *base, uint64_t offset,
+                              uint64_t length) noexcept {
+#if defined(__linux__) && defined(MADV_HUGEPAGE)
+  // Only whole huge pages can be promoted; the kernel ignores the unaligned
+  // head and tail, so page granularity suffices here. A kernel built without
+  // THP (or with it disabled) rejects the advice with EINVAL: the mapping
+  // keeps base pages, which is the documented fallback, not a failure.
+  const advise_window window = shrink_to_pages(base, offset, length);
+  if (window.length == 0u) {
+    return true;
+  }
+  return ::madvise(window.address, window.length, MADV_HUGEPAGE) == 0 ||
+         errno == EINVAL;
+#else
+  // No transparent huge-page advice for file mappings on this platform; the
+  // hint degrades to a successful no-op and the span keeps base pages.
+  (void)base;
+  (void)offset;
+  (void)length;
+  return true;
+#endif
+}
+
 } // namespace
 
 platform_ops default_platform_ops() noexcept {
@@ -259,6 +283,7 @@ platform_ops default_platform_ops() noexcept {
   ops.advise_sequential = &platform_advise_sequential;
   ops.advise_willneed = &platform_advise_willneed;
   ops.advise_dontneed = &platform_advise_dontneed;
+  ops.advise_hugepage = &platform_advise_hugepage;
   return ops;
 }
 
@@ -295,6 +320,9 @@ context::context(const platform_ops &platform_in) noexcept
   if (platform.advise_dontneed == nullptr) {
     platform.advise_dontneed = defaults.advise_dontneed;
   }
+  if (platform.advise_hugepage == nullptr) {
+    platform.advise_hugepage = defaults.advise_hugepage;
+  }
   for (uint32_t i = 0; i < k_max_mappings; ++i) {
     free_stack[i] = (k_max_mappings - 1u) - i;
   }
@@ -441,4 +469,11 @@ void effect_attempt_advise_dontneed::operator()(
       slot_ref.base, ev.request.offset, ev.request.length);
 }
 
+void effect_attempt_advise_hugepage::operator()(
+    const detail::advise_mapping_runtime &ev, context &ctx) const noexcept {
+  const slot &slot_ref = ctx.slots[ev.request.handle];
+  ev.status.advise_ok = ctx.platform.advise_hugepage(
+      slot_ref.base, ev.request.offset, ev.request.length);
+}
+
 } // namespace emel::io::mmap::action
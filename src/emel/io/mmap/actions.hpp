@@ -304,6 +304,11 @@ struct effect_attempt_advise_dontneed {
                   context &ctx) const noexcept;
 };
 
+struct effect_attempt_advise_hugepage {
+  void operator()(const detail::advise_mapping_runtime &ev,
+                  context &ctx) const noexcept;
+};
+
 struct effect_mark_advise_failed {
   void operator()(const detail::advise_mapping_runtime &ev,
                   context &) const noexcept {
@@ -419,6 +424,8 @@ inline constexpr effect_attempt_advise_willneed
     effect_attempt_advise_willneed{};
 inline constexpr effect_attempt_advise_dontneed
     effect_attempt_advise_dontneed{};
+inline constexpr effect_attempt_advise_hugepage
+    effect_attempt_advise_hugepage{};
 inline constexpr effect_mark_advise_failed effect_mark_advise_failed{};
 inline constexpr effect_commit_advise effect_commit_advise{};
 inline constexpr effect_publish_advise_mapping_done
@@ -37,6 +37,8 @@ struct platform_ops {
                           uint64_t length) noexcept = nullptr;
   bool (*advise_dontneed)(void *base, uint64_t offset,
                           uint64_t length) noexcept = nullptr;
+  bool (*advise_hugepage)(void *base, uint64_t offset,
+                          uint64_t length) noexcept = nullptr;
 };
 
 // The production operations (defaulted into every context by the default
@@ -54,11 +54,14 @@ struct release_mapping {
 
 // Access-pattern hint for a live mapping: k_sequential marks the whole span
 // for sequential readahead, k_willneed prefetches the given window ahead of
-// use, k_dontneed drops consumed pages behind a streaming window.
+// use, k_dontneed drops consumed pages behind a streaming window, k_hugepage
+// asks for transparent huge pages over a resident weight span (decode sweeps
+// every weight page per token, so TLB reach matters more than readahead).
 enum class advice : uint8_t {
   k_sequential = 0,
   k_willneed = 1,
   k_dontneed = 2,
+  k_hugepage = 3,
 };
 
 struct advise_mapping {
@@ -373,6 +373,13 @@ struct guard_advise_kind_dontneed {
   }
 };
 
+struct guard_advise_kind_hugepage {
+  bool operator()(const detail::advise_mapping_runtime &ev,
+                  const action::context &) const noexcept {
+    return ev.request.kind == event::advice::k_hugepage;
+  }
+};
+
 // Catch-all for advice values outside the modeled kinds (for example a cast
 // from a C ABI boundary): the kind decision must always take a transition.
 struct guard_advise_kind_invalid {
@@ -380,7 +387,8 @@ struct guard_advise_kind_invalid {
                   const action::context &ctx) const noexcept {
     return !guard_advise_kind_sequential{}(ev, ctx) &&
            !guard_advise_kind_willneed{}(ev, ctx) &&
-           !guard_advise_kind_dontneed{}(ev, ctx);
+           !guard_advise_kind_dontneed{}(ev, ctx) &&
+           !guard_advise_kind_hugepage{}(ev, ctx);
   }
 };
 
@@ -411,6 +411,11 @@ struct model {
           + sml::completion<detail::advise_mapping_runtime>
           [ guard::guard_advise_kind_dontneed{} ]
           / action::effect_attempt_advise_dontneed
+      , sml::state<state_advise_attempt_decision> <=
+          sml::state<state_advise_kind_decision>
+          + sml::completion<detail::advise_mapping_runtime>
+          [ guard::guard_advise_kind_hugepage{} ]
+          / action::effect_attempt_advise_hugepage
       , sml::state<state_advise_invalid_kind_error_decision> <=
           sml::state<state_advise_kind_decision>
           + sml::completion<detail::advise_mapping_runtime>
@@ -7,8 +7,10 @@
 #include "emel/kernel/aarch64/sm.hpp"
 #include "emel/kernel/detail.hpp"
 #include "emel/kernel/events.hpp"
+#include "emel/kernel/profile.hpp"
 #include "emel/kernel/x86_64/sm.hpp"
 #include "emel/sm.hpp"
+#include "emel/trace.hpp"
 
 namespace emel::kernel {
 
@@ -35,6 +37,13 @@ class any {
     return true;
   }
 
+  bool process_event(const event::configure_profile &ev) {
+    profile_ = ev.recorder;
+    return true;
+  }
+
+  profile::recorder * profiler() const noexcept { return profile_; }
+
   bool process_event(const event::capture_diagnostics &ev) {
     ev.out.optimized_flash_dispatch_calls = optimized_flash_dispatch_count();
     ev.out.shared_flash_dispatch_calls = shared_flash_dispatch_count();
@@ -76,7 +85,12 @@ class any {
   template <class event_type>
     requires(::emel::kernel::is_op_event_v<event_type>)
   bool process_event(const event_type & ev) {
-    return core_.process_event(ev);
+    const trace::span traced{trace::category::kernel,
+                             op_name(op_id_v<event_type>)};
+    const profile::mark opened = profile::begin(profile_);
+    const bool accepted = core_.process_event(ev);
+    profile::end(profile_, kind(), ev, opened);
+    return accepted;
   }
 
   uint64_t optimized_flash_dispatch_count() const noexcept {
@@ -390,6 +404,7 @@ class any {
       >;
 
   emel::sm_any<kernel_kind, sm_list, event_list> core_{};
+  profile::recorder * profile_ = nullptr;
 };
 
 }  // namespace emel::kernel
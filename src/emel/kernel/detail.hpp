@@ -7,6 +7,7 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <string_view>
 #include <type_traits>
 
 #if defined(__aarch64__) || defined(__ARM_NEON)
@@ -18,7 +19,8 @@
 #endif
 
 // Keep this list aligned with `tmp/llama.cpp/ggml/include/ggml.h` (`enum
-// ggml_op`), excluding sentinel entries (`NONE`, `COUNT`).
+// ggml_op`), excluding sentinel entries (`NONE`, `COUNT`). The fused op after
+// `op_glu` is emel-specific and has no ggml counterpart.
 #define EMEL_KERNEL_OP_EVENT_LIST(X)                                           \
   X(op_dup)                                                                    \
   X(op_add)                                                                    \
@@ -139,6 +141,38 @@ EMEL_KERNEL_OP_EVENT_LIST(EMEL_KERNEL_MARK_OP_EVENT)
 template <class event_type>
 inline constexpr bool is_op_event_v = is_op_event<event_type>::value;
 
+// Dense index of each op event in EMEL_KERNEL_OP_EVENT_LIST order, for tables
+// keyed by op (kernel::profile).
+enum class op_id : uint16_t {
+#define EMEL_KERNEL_OP_ID(op_name) op_name,
+  EMEL_KERNEL_OP_EVENT_LIST(EMEL_KERNEL_OP_ID)
+#undef EMEL_KERNEL_OP_ID
+  count,
+};
+
+template <class event_type> struct op_id_of;
+
+#define EMEL_KERNEL_OP_ID_OF(op_name)                                          \
+  template <> struct op_id_of<event::op_name> {                                \
+    static constexpr op_id value = op_id::op_name;                             \
+  };
+EMEL_KERNEL_OP_EVENT_LIST(EMEL_KERNEL_OP_ID_OF)
+#undef EMEL_KERNEL_OP_ID_OF
+
+template <class event_type>
+inline constexpr op_id op_id_v = op_id_of<event_type>::value;
+
+inline constexpr std::string_view op_name(const op_id id) noexcept {
+  constexpr std::string_view names[] = {
+#define EMEL_KERNEL_OP_NAME(op_name) #op_name,
+      EMEL_KERNEL_OP_EVENT_LIST(EMEL_KERNEL_OP_NAME)
+#undef EMEL_KERNEL_OP_NAME
+  };
+  const auto index = static_cast<size_t>(id);
+  return index < static_cast<size_t>(op_id::count) ? names[index]
+                                                   : std::string_view{};
+}
+
 } // namespace emel::kernel
 
 namespace emel::kernel::detail {
@@ -11,6 +11,10 @@ namespace emel::kernel::action {
 struct context;
 }
 
+namespace emel::kernel::profile {
+struct recorder;
+}
+
 namespace emel::kernel {
 
 enum class kernel_kind : uint8_t {
@@ -36,6 +40,12 @@ struct configure_kind {
   emel::kernel::kernel_kind kind = emel::kernel::kernel_kind::x86_64;
 };
 
+// Attaches an owner-allocated hardware-counter recorder (kernel::profile) to
+// every op dispatched after it; nullptr detaches.
+struct configure_profile {
+  ::emel::kernel::profile::recorder *recorder = nullptr;
+};
+
 struct diagnostics {
   uint64_t optimized_flash_dispatch_calls = 0u;
   uint64_t shared_flash_dispatch_calls = 0u;
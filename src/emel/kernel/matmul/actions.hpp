@@ -9,12 +9,14 @@
 
 #include "emel/kernel/matmul/context.hpp"
 #include "emel/kernel/matmul/events.hpp"
+#include "emel/trace.hpp"
 
 namespace emel::kernel::matmul::action {
 
 struct lane_dispatch {
   emel::kernel::sm *kernel = nullptr;
   const emel::kernel::event::op_mul_mat *request = nullptr;
+  const emel::memory::numa::replica_table *replicas = nullptr;
   bool accepted = false;
 };
 
@@ -35,13 +37,29 @@ struct effect_configure_kernel_kind {
   }
 };
 
+struct effect_configure_weight_replicas {
+  void operator()(const event::configure_weight_replicas &ev,
+                  context &ctx) const noexcept {
+    ctx.weight_replicas = ev.replicas;
+  }
+};
+
+struct effect_configure_profile {
+  void operator()(const event::configure_profile &ev,
+                  context &ctx) const noexcept {
+    ctx.kernel.process_event(
+        emel::kernel::event::configure_profile{ev.recorder});
+  }
+};
+
 struct effect_execute_serial {
   void operator()(const event::execute_serial &ev,
                   context &ctx) const noexcept {
     ev.result = {};
     ev.result.lane_count = 1u;
     ev.result.all_submitted = true;
-    ev.result.all_lanes_accepted = ctx.kernel.process_event(ev.request);
+    ev.result.all_lanes_accepted = ctx.kernel.process_event(
+        detail::compute_node_local_mul_mat(ev.request, ctx.weight_replicas));
   }
 };
 
@@ -79,6 +97,7 @@ inline void prepare_fixed_lanes(
         lane_dispatch{
             .kernel = &ctx.lanes->kernels[lanes],
             .request = &lane_events[lanes],
+            .replicas = ctx.weight_replicas,
         }),
    ...);
 }
@@ -91,7 +110,11 @@ inline size_t submit_fixed_worker_lanes(
   ((lane_dispatches[lane_offsets + 1u].accepted = false), ...);
   return ctx.parallel_matmul_lanes->try_submit_batch(
       group, ([&dispatch = lane_dispatches[lane_offsets + 1u]]() noexcept {
-        dispatch.accepted = dispatch.kernel->process_event(*dispatch.request);
+        const emel::trace::span traced{emel::trace::category::lane,
+                                       "matmul/lane"};
+        dispatch.accepted = dispatch.kernel->process_event(
+            detail::compute_node_local_mul_mat(*dispatch.request,
+                                               dispatch.replicas));
       })...);
 }
 
@@ -124,9 +147,19 @@ struct effect_execute_parallel {
         std::make_index_sequence<lane_count - 1u>{});
     ev.result.all_submitted =
         ev.result.submitted_worker_lanes == lane_count - 1u;
-    const bool owner_accepted =
-        ctx.lanes->kernels[0].process_event(lane_events[0]);
-    (void)group.wait();
+    bool owner_accepted = false;
+    {
+      const emel::trace::span traced{emel::trace::category::lane,
+                                     "matmul/owner_lane"};
+      owner_accepted = ctx.lanes->kernels[0].process_event(
+          detail::compute_node_local_mul_mat(lane_events[0],
+                                             ctx.weight_replicas));
+    }
+    {
+      const emel::trace::span traced{emel::trace::category::lane,
+                                     "matmul/join"};
+      (void)group.wait();
+    }
     ev.result.drained_worker_lanes = ev.result.submitted_worker_lanes;
     ev.result.all_lanes_accepted =
         owner_accepted &&
@@ -290,6 +323,9 @@ struct effect_capture_diagnostics {
 };
 
 inline constexpr effect_configure_kernel_kind effect_configure_kernel_kind{};
+inline constexpr effect_configure_weight_replicas
+    effect_configure_weight_replicas{};
+inline constexpr effect_configure_profile effect_configure_profile{};
 inline constexpr effect_execute_serial effect_execute_serial{};
 inline constexpr effect_accept_serial_execution
     effect_accept_serial_execution{};
@@ -48,6 +48,7 @@ struct context {
   lane_pool *parallel_matmul_lanes = nullptr;
   emel::kernel::kernel_kind kernel_kind = emel::kernel::kernel_kind::x86_64;
   size_t active_lanes = 1u;
+  const emel::memory::numa::replica_table *weight_replicas = nullptr;
   emel::kernel::sm kernel = {};
   std::unique_ptr<lane_storage> lanes = {};
 };
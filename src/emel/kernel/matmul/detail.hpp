@@ -6,6 +6,7 @@
 
 #include "emel/kernel/detail.hpp"
 #include "emel/kernel/events.hpp"
+#include "emel/memory/numa_replicas.hpp"
 #include "emel/sm.hpp"
 
 namespace emel::kernel::matmul {
@@ -53,6 +54,18 @@ compute_sliced_mul_mat_event(const emel::kernel::event::op_mul_mat &ev,
   return sliced;
 }
 
+// Points src0 at the weight copy local to the calling lane's node. Runs on
+// the lane's own thread so the lookup sees where that lane actually executes;
+// without replicas (or for unregistered operands) the event is unchanged.
+inline emel::kernel::event::op_mul_mat compute_node_local_mul_mat(
+    const emel::kernel::event::op_mul_mat &ev,
+    const emel::memory::numa::replica_table *replicas) noexcept {
+  emel::kernel::event::op_mul_mat local = ev;
+  local.src0.data =
+      replicas == nullptr ? ev.src0.data : replicas->resolve_local(ev.src0.data);
+  return local;
+}
+
 } // namespace detail
 
 } // namespace emel::kernel::matmul
@@ -27,6 +27,18 @@ struct configure_kernel_kind {
   emel::kernel::kernel_kind kind = emel::kernel::kernel_kind::x86_64;
 };
 
+// Read-only weight replicas lanes translate src0 through; nullptr detaches.
+// The table must outlive every execute that follows.
+struct configure_weight_replicas {
+  const emel::memory::numa::replica_table *replicas = nullptr;
+};
+
+// Hardware-counter recorder (kernel::profile) for the serial kernel; worker
+// lanes run on other threads and stay unprofiled. nullptr detaches.
+struct configure_profile {
+  emel::kernel::profile::recorder *recorder = nullptr;
+};
+
 struct dispatch_result {
   size_t lane_count = 0u;
   size_t submitted_worker_lanes = 0u;
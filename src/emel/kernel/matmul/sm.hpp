@@ -30,6 +30,12 @@ struct model {
         sml::state<state_ready> <= *sml::state<state_ready>
                  + sml::event<event::configure_kernel_kind>
                  / action::effect_configure_kernel_kind
+      , sml::state<state_ready> <= sml::state<state_ready>
+                 + sml::event<event::configure_weight_replicas>
+                 / action::effect_configure_weight_replicas
+      , sml::state<state_ready> <= sml::state<state_ready>
+                 + sml::event<event::configure_profile>
+                 / action::effect_configure_profile
 
       //------------------------------------------------------------------------------//
       // Explicit serial versus parallel matmul execution.
@@ -227,6 +233,14 @@ struct sm : public emel::sm<model, action::context> {
     return base_type::process_event(ev);
   }
 
+  bool process_event(const event::configure_weight_replicas &ev) {
+    return base_type::process_event(ev);
+  }
+
+  bool process_event(const event::configure_profile &ev) {
+    return base_type::process_event(ev);
+  }
+
   bool process_event(const event::execute_serial &ev) {
     return base_type::process_event(ev);
   }
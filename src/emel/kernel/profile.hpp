@@ -0,0 +1,216 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "emel/kernel/detail.hpp"
+#include "emel/kernel/events.hpp"
+#include "emel/kernel/roofline.hpp"
+
+// Opt-in hardware-counter profile of kernel dispatches.
+//
+// The owner opens the counters (perf_event_open on Linux; see tools/bench)
+// and injects a read callback in place of a clock (emel/clock.hpp): src/emel
+// never makes the syscalls itself. kernel::any samples the counters around every op it
+// dispatches once configure_profile attached the recorder, and charges the
+// delta plus the bytes the op's source views span to
+//
+//   routes: (kernel kind, op, src0 dtype, src1 dtype), which is what tells
+//           one quantized matmul route from another;
+//   stages: (layer, stage), as last set by attribute() from the generator.
+//
+// Cycles per byte against instructions per cycle separates routes stalled on
+// memory from routes bound by compute. The counters belong to the owner's
+// thread, so only kernels dispatched on it are profiled: a matmul actor
+// forwards the recorder to its serial kernel, not to its worker lanes, and
+// profiling runs should use serial matmul lanes.
+namespace emel::kernel::profile {
+
+struct counters {
+  uint64_t cycles = 0u;
+  uint64_t instructions = 0u;
+  uint64_t llc_misses = 0u;
+};
+
+using read_fn = bool (*)(void *owner, counters &out) noexcept;
+
+enum class stage : uint8_t {
+  unattributed = 0,
+  attention_projection = 1,  // input norm/quantize + q/k/v
+  attention = 2,             // attention or shortconv token mixing
+  attention_output = 3,
+  feed_forward = 4,          // input norm/quantize + gate/up/down
+  logits = 5,                // output norm + output projection
+  count = 6,
+};
+
+inline constexpr size_t k_stage_count = static_cast<size_t>(stage::count);
+inline constexpr size_t k_max_routes = 128u;
+// Layers at or past this share the last stage row with unlayered work
+// (logits, unattributed).
+inline constexpr int32_t k_max_layers = 256;
+
+inline constexpr std::string_view stage_name(const stage which) noexcept {
+  constexpr std::array<std::string_view, k_stage_count> names = {
+      "unattributed", "attention_projection", "attention",
+      "attention_output", "feed_forward", "logits",
+  };
+  const auto index = static_cast<size_t>(which);
+  return index < k_stage_count ? names[index] : std::string_view{};
+}
+
+struct totals {
+  uint64_t calls = 0u;
+  uint64_t cycles = 0u;
+  uint64_t instructions = 0u;
+  uint64_t llc_misses = 0u;
+  uint64_t bytes_read = 0u;
+};
+
+struct route_key {
+  kernel_kind kind = kernel_kind::x86_64;
+  op_id op = op_id::count;
+  event::dtype src0 = event::dtype::unknown;
+  event::dtype src1 = event::dtype::unknown;
+
+  bool operator==(const route_key &) const = default;
+};
+
+struct route_sample {
+  route_key key = {};
+  totals total = {};
+};
+
+struct recorder {
+  read_fn read = nullptr;
+  void *owner = nullptr;
+  int32_t layer = -1;
+  stage current = stage::unattributed;
+  std::array<route_sample, k_max_routes> routes = {};
+  uint32_t route_count = 0u;
+  std::array<totals, (static_cast<size_t>(k_max_layers) + 1u) * k_stage_count>
+      stages = {};
+  // Dispatches lost to a failed counter read or a full route table.
+  uint64_t dropped = 0u;
+};
+
+// Counter snapshot opening one dispatch; armed only when profiling.
+struct mark {
+  counters start = {};
+  bool armed = false;
+};
+
+inline void reset(recorder &profile, const read_fn read, void *owner) noexcept {
+  profile = recorder{};
+  profile.read = read;
+  profile.owner = owner;
+}
+
+// Charges the dispatches that follow to `layer` (-1 outside the layer loop)
+// and `which`.
+inline void attribute(recorder *profile, const int32_t layer,
+                      const stage which) noexcept {
+  if (profile == nullptr) {
+    return;
+  }
+  profile->layer = layer;
+  profile->current = which;
+}
+
+// attribute() for the lifetime of a scope; dispatches after it go back to
+// unattributed, so work no scope claims is never charged to a stale stage.
+class scope {
+ public:
+  scope(recorder *profile, const int32_t layer, const stage which) noexcept
+      : profile_(profile) {
+    attribute(profile_, layer, which);
+  }
+  ~scope() { attribute(profile_, -1, stage::unattributed); }
+  scope(const scope &) = delete;
+  scope &operator=(const scope &) = delete;
+
+ private:
+  recorder *profile_;
+};
+
+inline size_t stage_index(const int32_t layer, const stage which) noexcept {
+  const size_t row = layer >= 0 && layer < k_max_layers
+                         ? static_cast<size_t>(layer)
+                         : static_cast<size_t>(k_max_layers);
+  return row * k_stage_count +
+         std::min(static_cast<size_t>(which), k_stage_count - 1u);
+}
+
+inline const totals &stage_totals(const recorder &profile, const int32_t layer,
+                                  const stage which) noexcept {
+  return profile.stages[stage_index(layer, which)];
+}
+
+inline void accumulate(totals &into, const totals &delta) noexcept {
+  into.calls += delta.calls;
+  into.cycles += delta.cycles;
+  into.instructions += delta.instructions;
+  into.llc_misses += delta.llc_misses;
+  into.bytes_read += delta.bytes_read;
+}
+
+inline route_sample *find_route(recorder &profile, const route_key &key) noexcept {
+  for (uint32_t index = 0; index < profile.route_count; ++index) {
+    if (profile.routes[index].key == key) {
+      return &profile.routes[index];
+    }
+  }
+  if (profile.route_count == profile.routes.size()) {
+    return nullptr;
+  }
+  route_sample &added = profile.routes[profile.route_count++];
+  added.key = key;
+  return &added;
+}
+
+inline mark begin(const recorder *profile) noexcept {
+  mark opened{};
+  opened.armed = profile != nullptr && profile->read != nullptr &&
+                 profile->read(profile->owner, opened.start);
+  return opened;
+}
+
+template <class event_type>
+  requires(::emel::kernel::is_op_event_v<event_type>)
+inline void end(recorder *profile, const kernel_kind kind, const event_type &ev,
+                const mark &opened) noexcept {
+  if (profile == nullptr || !opened.armed) {
+    return;
+  }
+  counters now{};
+  if (!profile->read(profile->owner, now)) {
+    ++profile->dropped;
+    return;
+  }
+  const totals delta{
+      .calls = 1u,
+      .cycles = now.cycles - opened.start.cycles,
+      .instructions = now.instructions - opened.start.instructions,
+      .llc_misses = now.llc_misses - opened.start.llc_misses,
+      .bytes_read = roofline::view_bytes(ev.src0) + roofline::view_bytes(ev.src1) +
+                    roofline::view_bytes(ev.src2),
+  };
+  accumulate(profile->stages[stage_index(profile->layer, profile->current)], delta);
+  route_sample *const route = find_route(
+      *profile, route_key{
+                    .kind = kind,
+                    .op = op_id_v<event_type>,
+                    .src0 = ev.src0.type,
+                    .src1 = ev.src1.type,
+                });
+  if (route == nullptr) {
+    ++profile->dropped;
+    return;
+  }
+  accumulate(route->total, delta);
+}
+
+}  // namespace emel::kernel::profile
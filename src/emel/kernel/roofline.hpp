@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstdint>
+#include <type_traits>
+
+#include "emel/kernel/detail.hpp"
+#include "emel/kernel/events.hpp"
+
+// Static roofline cost of one kernel dispatch: the floating-point work the
+// op's math implies and the bytes it must move, both read off the event's
+// views, never off the route that ends up running it. x86_64 and aarch64
+// routes of one op therefore share a cost, and achieved GB/s or GFLOP/s
+// against a host peak says how far a route is from its ceiling.
+//
+//   mul_mat family:  2*k per output (x2 plus the swiglu epilogue for glu);
+//                    bytes are the weight, input and output storage, so a
+//                    quantized GEMV is charged its packed bytes.
+//   flash_attn_ext:  4*head_dim + 5 (online softmax) per query/key score
+//                    over the active KV window.
+//   norms:           3-5 per element; fused norm ops add the weight
+//                    multiply (and residual add).
+//   rope:            3 per element (one rotation per pair).
+//   get_rows:        no flops; bytes are the gathered rows, not the table.
+//   data movement:   no flops (dup, cpy, cont, views, concat, ...).
+//   everything else: one flop per output element.
+//
+// Dense views are charged element count times element size, so a strided
+// KV window counts the tokens it covers, not the capacity behind it;
+// block-quantized and packed views are contiguous and charged their span.
+namespace emel::kernel::roofline {
+
+struct cost {
+  uint64_t flops = 0u;
+  uint64_t bytes = 0u;
+};
+
+inline void accumulate(cost &into, const cost &delta) noexcept {
+  into.flops += delta.flops;
+  into.bytes += delta.bytes;
+}
+
+template <class view_type>
+inline uint64_t view_bytes(const view_type &view) noexcept {
+  if (view.data == nullptr) {
+    return 0u;
+  }
+  const uint8_t type = detail::dtype_code(view.type);
+  const bool dense = type == detail::dtype_f32 || type == detail::dtype_f16 ||
+                     type == detail::dtype_bf16 || type == detail::dtype_i32;
+  return dense ? detail::tensor_element_count(view) *
+                     detail::dtype_size_bytes(type)
+               : view.ne[3] * view.nb[3];
+}
+
+template <class event_type>
+inline uint64_t io_bytes(const event_type &ev) noexcept {
+  return view_bytes(ev.src0) + view_bytes(ev.src1) + view_bytes(ev.src2) +
+         view_bytes(ev.dst);
+}
+
+template <class event_type>
+inline constexpr bool is_data_movement_v =
+    std::is_same_v<event_type, event::op_dup> ||
+    std::is_same_v<event_type, event::op_cpy> ||
+    std::is_same_v<event_type, event::op_cont> ||
+    std::is_same_v<event_type, event::op_reshape> ||
+    std::is_same_v<event_type, event::op_view> ||
+    std::is_same_v<event_type, event::op_permute> ||
+    std::is_same_v<event_type, event::op_transpose> ||
+    std::is_same_v<event_type, event::op_set> ||
+    std::is_same_v<event_type, event::op_set_rows> ||
+    std::is_same_v<event_type, event::op_repeat> ||
+    std::is_same_v<event_type, event::op_concat> ||
+    std::is_same_v<event_type, event::op_fill>;
+
+// Flops per output element of the row-wise ops.
+template <class event_type>
+inline constexpr uint64_t row_flops_v =
+    std::is_same_v<event_type, event::op_rms_norm> ||
+            std::is_same_v<event_type, event::op_l2_norm> ||
+            std::is_same_v<event_type, event::op_rope>
+        ? 3u
+    : std::is_same_v<event_type, event::op_norm> ||
+            std::is_same_v<event_type, event::op_group_norm> ||
+            std::is_same_v<event_type, event::op_soft_max> ||
+            std::is_same_v<event_type, event::op_glu>
+        ? 5u
+        : 1u;
+
+template <class event_type>
+  requires(::emel::kernel::is_op_event_v<event_type>)
+inline cost op_cost(const event_type &ev) noexcept {
+  if constexpr (std::is_same_v<event_type, event::op_mul_mat> ||
+                std::is_same_v<event_type, event::op_mul_mat_argmax>) {
+    // src1 holds n input vectors of length k in either the ggml [k, n] or
+    // the vector [n, k] layout; its element count is k * n in both.
+    const uint64_t k = ev.src0.ne[0];
+    const uint64_t m = ev.src0.ne[1];
+    const uint64_t n = k == 0u ? 0u : detail::tensor_element_count(ev.src1) / k;
+    return cost{.flops = 2u * k * m * n, .bytes = io_bytes(ev)};
+  } else if constexpr (std::is_same_v<event_type, event::op_flash_attn_ext>) {
+    const uint64_t head_dim = ev.src0.ne[0];
+    const uint64_t queries = ev.src0.ne[1] * ev.src0.ne[2] * ev.src0.ne[3];
+    const uint64_t keys = ev.src1.ne[1];
+    return cost{.flops = queries * keys * (4u * head_dim + 5u),
+                .bytes = io_bytes(ev)};
+  } else if constexpr (std::is_same_v<event_type, event::op_get_rows>) {
+    const uint64_t rows = detail::tensor_element_count(ev.src1);
+    const uint64_t row_bytes = ev.src0.data == nullptr ? 0u : ev.src0.nb[1];
+    return cost{.flops = 0u,
+                .bytes = rows * row_bytes + view_bytes(ev.src1) +
+                         view_bytes(ev.dst)};
+  } else if constexpr (is_data_movement_v<event_type>) {
+    return cost{.flops = 0u, .bytes = io_bytes(ev)};
+  } else {
+    return cost{.flops = row_flops_v<event_type> *
+                         detail::tensor_element_count(ev.dst),
+                .bytes = io_bytes(ev)};
+  }
+}
+
+} // namespace emel::kernel::roofline
@@ -8,6 +8,7 @@
 #include "emel/embeddings/generator/sm.hpp"
 #include "emel/gguf/loader/sm.hpp"
 #include "emel/graph/processor/sm.hpp"
+#include "emel/io/async_read/sm.hpp"
 #include "emel/io/loader/sm.hpp"
 #include "emel/io/mmap/sm.hpp"
 #include "emel/io/read/sm.hpp"
@@ -51,6 +52,7 @@ using EncoderRwkv = emel::text::encoders::rwkv::sm;
 using EncoderPlamo2 = emel::text::encoders::plamo2::sm;
 using EncoderFallback = emel::text::encoders::fallback::sm;
 using Generator = emel::text::generator::sm;
+using IoAsyncRead = emel::io::async_read::sm;
 using IoLoader = emel::io::loader::sm;
 using IoMmap = emel::io::mmap::sm;
 using IoRead = emel::io::read::sm;
@@ -0,0 +1,139 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "emel/model/data.hpp"
+
+// Per-session byte accounting behind capture_memory_footprint (text and
+// embeddings generators, speech transcriber and generator, sortformer
+// pipeline): what a session keeps resident, by what holds it, so capacity
+// plans come from bytes per session rather than from process RSS.
+//
+// Mapped weights are the tensor bytes the model records point at; how much of
+// them is actually resident is a page-cache question (mincore(2)) that only
+// the owner may ask, so it injects a probe and src/emel never makes the
+// syscall. Everything else is memory the actor allocated for itself and is
+// counted from its buffers' sizes: a capture allocates nothing and touches no
+// weight page.
+namespace emel::memory::footprint {
+
+// Bytes of [data, data + size) resident in RAM.
+using resident_fn = uint64_t (*)(const void *data, uint64_t size,
+                                 void *user) noexcept;
+
+struct probe {
+  resident_fn resident = nullptr;
+  void *user = nullptr;
+};
+
+struct report {
+  // Weight bytes the session reads in place, and the resident part of them
+  // (0 unless weights_probed).
+  uint64_t mapped_weight_bytes = 0u;
+  uint64_t mapped_weight_touched_bytes = 0u;
+  // Repacked, dequantized, transposed or NUMA-replicated weight copies.
+  uint64_t prepared_weight_bytes = 0u;
+  uint64_t kv_cache_bytes = 0u;
+  uint64_t recurrent_state_bytes = 0u;
+  // Activations, quantized inputs, logits and other per-step working sets.
+  uint64_t scratch_bytes = 0u;
+  // Vocabulary, merge and charsmap tables the loader wrote.
+  uint64_t tokenizer_bytes = 0u;
+  bool weights_probed = false;
+};
+
+// capture_memory_footprint event shared by every actor above; `residency` lets
+// the owner report how much of the mapped weights is paged in.
+struct capture {
+  explicit capture(report &out_ref, const probe residency_in = {}) noexcept
+      : out(out_ref), residency(residency_in) {}
+
+  report &out;
+  probe residency = {};
+};
+
+inline uint64_t untouched_weight_bytes(const report &from) noexcept {
+  return from.weights_probed
+             ? from.mapped_weight_bytes - from.mapped_weight_touched_bytes
+             : 0u;
+}
+
+// Bytes the session owns outright; mapped weights are shared through the page
+// cache by every session on the same file.
+inline uint64_t session_bytes(const report &from) noexcept {
+  return from.prepared_weight_bytes + from.kv_cache_bytes +
+         from.recurrent_state_bytes + from.scratch_bytes + from.tokenizer_bytes;
+}
+
+// Session bytes plus the resident weights: touched bytes when probed, every
+// mapped byte otherwise.
+inline uint64_t resident_bytes(const report &from) noexcept {
+  return session_bytes(from) + (from.weights_probed
+                                    ? from.mapped_weight_touched_bytes
+                                    : from.mapped_weight_bytes);
+}
+
+template <class value_type, class allocator_type>
+inline uint64_t bytes_of(
+    const std::vector<value_type, allocator_type> &values) noexcept {
+  return static_cast<uint64_t>(values.capacity()) * sizeof(value_type);
+}
+
+template <class value_type, size_t count>
+inline constexpr uint64_t bytes_of(
+    const std::array<value_type, count> &) noexcept {
+  return static_cast<uint64_t>(count) * sizeof(value_type);
+}
+
+inline void add_tensor(report &out,
+                       const emel::model::data::tensor_record &tensor,
+                       const probe &residency) noexcept {
+  if (tensor.data == nullptr || tensor.data_size == 0u) {
+    return;
+  }
+  out.mapped_weight_bytes += tensor.data_size;
+  out.weights_probed = residency.resident != nullptr;
+  if (residency.resident != nullptr) {
+    out.mapped_weight_touched_bytes +=
+        residency.resident(tensor.data, tensor.data_size, residency.user);
+  }
+}
+
+inline void add_weights(report &out, const emel::model::data &model,
+                        const probe &residency) noexcept {
+  for (uint32_t index = 0u; index < model.n_tensors; ++index) {
+    add_tensor(out, model.tensors[index], residency);
+  }
+}
+
+// Only the prefix of each lazily reserved table the loader wrote is
+// resident; the untouched tail of its calloc block is never faulted in.
+inline uint64_t tokenizer_table_bytes(
+    const emel::model::data::vocab &vocab) noexcept {
+  using vocab_type = emel::model::data::vocab;
+  const uint64_t tokens = vocab.n_tokens;
+  const uint64_t merges = vocab.n_merges;
+  const uint64_t flag_bytes = (tokens + 7u) / 8u;
+  return tokens * sizeof(emel::model::data::vocab_entry) +
+         vocab.token_bytes_used + vocab.merge_bytes_used +
+         merges * (sizeof(uint32_t) * 2u) + vocab.precompiled_charsmap_size +
+         static_cast<uint64_t>(vocab.n_pieces) *
+             sizeof(emel::model::data::vocab_piece) +
+         static_cast<uint64_t>(vocab.token_trie_units) * 3u * sizeof(int32_t) +
+         (vocab.lstrip_flags.materialized() ? flag_bytes : 0u) +
+         (vocab.rstrip_flags.materialized() ? flag_bytes : 0u) +
+         sizeof(vocab_type::tokenizer_model_name) +
+         sizeof(vocab_type::tokenizer_pre_name);
+}
+
+// Weights and tokenizer tables of a model the session reads.
+inline void add_model(report &out, const emel::model::data &model,
+                      const probe &residency) noexcept {
+  add_weights(out, model, residency);
+  out.tokenizer_bytes += tokenizer_table_bytes(model.vocab_data);
+}
+
+}  // namespace emel::memory::footprint
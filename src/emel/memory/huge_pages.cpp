@@ -0,0 +1,155 @@
+#include "emel/memory/huge_pages.hpp"
+
+#include <cstdint>
+#include <new>
+
+#if defined(_WIN32)
+#define WIN32_LEAN_AND_MEAN
+#include <windows.h>
+#else
+#include <sys/mman.h>
+#endif
+
+namespace emel::memory::huge_pages {
+
+namespace {
+
+#if defined(_WIN32)
+
+void *map_aligned(const uint64_t bytes) noexcept {
+  // VirtualAlloc reservations are 64 KiB aligned; large pages need
+  // SeLockMemoryPrivilege, so Windows always takes the base-page fallback.
+  return ::VirtualAlloc(nullptr, static_cast<SIZE_T>(bytes),
+                        MEM_RESERVE | MEM_COMMIT, PAGE_READWRITE);
+}
+
+void unmap(void *base, uint64_t) noexcept {
+  ::VirtualFree(base, 0, MEM_RELEASE);
+}
+
+void *map_explicit(uint64_t) noexcept { return nullptr; }
+
+bool advise_transparent(void *, uint64_t) noexcept { return false; }
+
+#else
+
+#if !defined(MAP_ANONYMOUS)
+#define MAP_ANONYMOUS MAP_ANON
+#endif
+
+// Over-maps by one huge page and trims the unaligned head and tail so the
+// kept span starts on a huge-page boundary; THP can only promote aligned
+// 2 MiB extents.
+void *map_aligned(const uint64_t bytes) noexcept {
+  const uint64_t padded = bytes + k_huge_page_bytes;
+  void *raw = ::mmap(nullptr, static_cast<size_t>(padded),
+                     PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1,
+                     0);
+  if (raw == MAP_FAILED) {
+    return nullptr;
+  }
+  const auto raw_address = reinterpret_cast<uintptr_t>(raw);
+  const uintptr_t aligned_address =
+      (raw_address + k_huge_page_bytes - 1u) & ~(k_huge_page_bytes - 1u);
+  const uint64_t head = aligned_address - raw_address;
+  const uint64_t tail = padded - head - bytes;
+  if (head != 0u) {
+    ::munmap(raw, static_cast<size_t>(head));
+  }
+  if (tail != 0u) {
+    ::munmap(reinterpret_cast<void *>(aligned_address + bytes),
+             static_cast<size_t>(tail));
+  }
+  return reinterpret_cast<void *>(aligned_address);
+}
+
+void unmap(void *base, const uint64_t bytes) noexcept {
+  ::munmap(base, static_cast<size_t>(bytes));
+}
+
+void *map_explicit(const uint64_t bytes) noexcept {
+#if defined(MAP_HUGETLB)
+  // Fails with ENOMEM unless the administrator reserved hugetlbfs pages
+  // (vm.nr_hugepages); the caller then falls back to transparent pages.
+#if defined(MAP_HUGE_2MB)
+  // Pin the page size: munmap lengths must be multiples of it, and
+  // mapped_bytes_for() rounds to 2 MiB whatever the system default is.
+  constexpr int huge_flags = MAP_HUGETLB | MAP_HUGE_2MB;
+#else
+  constexpr int huge_flags = MAP_HUGETLB;
+#endif
+  void *base = ::mmap(nullptr, static_cast<size_t>(bytes),
+                      PROT_READ | PROT_WRITE,
+                      MAP_PRIVATE | MAP_ANONYMOUS | huge_flags, -1, 0);
+  return base == MAP_FAILED ? nullptr : base;
+#else
+  (void)bytes;
+  return nullptr;
+#endif
+}
+
+bool advise_transparent(void *base, const uint64_t bytes) noexcept {
+#if defined(MADV_HUGEPAGE)
+  return ::madvise(base, static_cast<size_t>(bytes), MADV_HUGEPAGE) == 0;
+#else
+  (void)base;
+  (void)bytes;
+  return false;
+#endif
+}
+
+#endif
+
+allocation allocate_heap(const uint64_t bytes) noexcept {
+  void *base = ::operator new(static_cast<std::size_t>(bytes),
+                              k_heap_alignment, std::nothrow);
+  return {base, base == nullptr ? backing::unavailable : backing::heap};
+}
+
+allocation allocate_mapped(const uint64_t bytes, const policy requested,
+                           const numa::placement where) noexcept {
+  const uint64_t mapped = mapped_bytes_for(bytes);
+  if (requested == policy::explicit_pages) {
+    void *base = map_explicit(mapped);
+    if (base != nullptr) {
+      (void)numa::apply(base, mapped, where);
+      return {base, backing::explicit_pages};
+    }
+  }
+  void *base = map_aligned(mapped);
+  if (base == nullptr) {
+    return {};
+  }
+  (void)numa::apply(base, mapped, where);
+  const bool promoted = requested != policy::none &&
+                        advise_transparent(base, mapped);
+  return {base, promoted ? backing::transparent : backing::base_pages};
+}
+
+}  // namespace
+
+allocation allocate(const uint64_t bytes, const policy requested,
+                    const numa::placement where) noexcept {
+  if (bytes == 0u) {
+    return {};
+  }
+  if (bytes < k_arena_min_bytes) {
+    return allocate_heap(bytes);
+  }
+  return allocate_mapped(bytes, requested, where);
+}
+
+void release(void *base, const uint64_t bytes) noexcept {
+  if (base == nullptr) {
+    return;
+  }
+  if (bytes < k_arena_min_bytes) {
+    ::operator delete(base, k_heap_alignment);
+    return;
+  }
+  // Explicit, transparent and base-page spans all cover exactly
+  // mapped_bytes_for(bytes) from an aligned base, so one unmap fits all.
+  unmap(base, mapped_bytes_for(bytes));
+}
+
+}  // namespace emel::memory::huge_pages
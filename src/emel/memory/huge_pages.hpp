@@ -0,0 +1,104 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <type_traits>
+#include <vector>
+
+#include "emel/memory/numa.hpp"
+
+// Huge-page backed arenas for the large, long-lived buffers a decode step
+// sweeps every token (KV caches, packed/prepared weights). Large allocations
+// are served from anonymous page mappings aligned to k_huge_page_bytes so the
+// kernel can back them with huge pages; small ones stay on the heap.
+//
+// Policy fallback chain, each step taken only when the previous one is
+// unavailable:
+//   explicit_pages: MAP_HUGETLB from the reserved hugetlbfs pool
+//   transparent:    aligned anonymous mapping + MADV_HUGEPAGE
+//   none:           aligned anonymous mapping with base pages
+// Release never depends on the policy or the backing that was obtained, so
+// every allocator instance compares equal. A NUMA placement (numa.hpp) is
+// installed on mapped spans before anything touches them; heap-served small
+// blocks keep first-touch placement.
+namespace emel::memory::huge_pages {
+
+enum class policy : uint8_t {
+  none = 0,
+  transparent = 1,
+  explicit_pages = 2,
+};
+
+enum class backing : uint8_t {
+  unavailable = 0,
+  heap = 1,
+  base_pages = 2,
+  transparent = 3,
+  explicit_pages = 4,
+};
+
+inline constexpr uint64_t k_huge_page_bytes = 2u * 1024u * 1024u;
+// Below one huge page the TLB gain is nil; keep those on the heap.
+inline constexpr uint64_t k_arena_min_bytes = k_huge_page_bytes;
+inline constexpr std::align_val_t k_heap_alignment{64};
+
+struct allocation {
+  void *base = nullptr;
+  backing kind = backing::unavailable;
+};
+
+inline constexpr uint64_t mapped_bytes_for(const uint64_t bytes) noexcept {
+  return (bytes + k_huge_page_bytes - 1u) & ~(k_huge_page_bytes - 1u);
+}
+
+// Returns base == nullptr (kind unavailable) when no backing could be
+// obtained. Zero-byte requests also report unavailable.
+allocation allocate(uint64_t bytes, policy requested,
+                    numa::placement where = {}) noexcept;
+void release(void *base, uint64_t bytes) noexcept;
+
+template <class value_type_in>
+struct allocator {
+  using value_type = value_type_in;
+  using propagate_on_container_copy_assignment = std::true_type;
+  using propagate_on_container_move_assignment = std::true_type;
+  using propagate_on_container_swap = std::true_type;
+  using is_always_equal = std::true_type;
+
+  huge_pages::policy requested = huge_pages::policy::transparent;
+  numa::placement where = {};
+
+  constexpr allocator() noexcept = default;
+  constexpr explicit allocator(const huge_pages::policy requested_in,
+                               const numa::placement where_in = {}) noexcept
+      : requested(requested_in), where(where_in) {}
+  template <class other_type>
+  constexpr allocator(const allocator<other_type> &other) noexcept
+      : requested(other.requested), where(other.where) {}
+
+  value_type *allocate(const std::size_t count) {
+    const allocation block =
+        huge_pages::allocate(static_cast<uint64_t>(count) * sizeof(value_type),
+                             requested, where);
+    if (block.base == nullptr) {
+      throw std::bad_alloc{};
+    }
+    return static_cast<value_type *>(block.base);
+  }
+
+  void deallocate(value_type *pointer, const std::size_t count) noexcept {
+    huge_pages::release(pointer,
+                        static_cast<uint64_t>(count) * sizeof(value_type));
+  }
+
+  template <class other_type>
+  constexpr bool operator==(const allocator<other_type> &) const noexcept {
+    return true;
+  }
+};
+
+template <class value_type>
+using vector = std::vector<value_type, allocator<value_type>>;
+
+}  // namespace emel::memory::huge_pages
@@ -0,0 +1,101 @@
+#include "emel/memory/numa.hpp"
+
+#include <bit>
+
+#if defined(__linux__)
+#include <sched.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+namespace emel::memory::numa {
+
+namespace {
+
+#if defined(__linux__) && defined(SYS_mbind) && defined(SYS_get_mempolicy)
+
+// <numaif.h> belongs to libnuma; the raw syscalls need only these values.
+constexpr int k_mpol_bind = 2;
+constexpr int k_mpol_interleave = 3;
+constexpr unsigned long k_mpol_f_mems_allowed = 1ul << 2u;
+constexpr uint64_t k_page_bytes = 4096u;
+
+uint32_t query_allowed_node_mask() noexcept {
+  unsigned long mask[16] = {};
+  int mode = 0;
+  const long rc =
+      ::syscall(SYS_get_mempolicy, &mode, mask, sizeof(mask) * 8u, nullptr,
+                k_mpol_f_mems_allowed);
+  const uint32_t nodes =
+      static_cast<uint32_t>(mask[0] & ((1ul << k_max_nodes) - 1u));
+  return rc == 0 && nodes != 0u ? nodes : 1u;
+}
+
+bool install(void *base, const uint64_t bytes, const int mode,
+             const uint32_t nodes) noexcept {
+  const auto begin = reinterpret_cast<uintptr_t>(base);
+  const uintptr_t first = (begin + k_page_bytes - 1u) & ~(k_page_bytes - 1u);
+  const uintptr_t last = (begin + bytes) & ~(k_page_bytes - 1u);
+  if (last <= first) {
+    return false;
+  }
+  const unsigned long mask = nodes;
+  return ::syscall(SYS_mbind, reinterpret_cast<void *>(first),
+                   static_cast<unsigned long>(last - first), mode, &mask,
+                   static_cast<unsigned long>(k_max_nodes + 1u), 0u) == 0;
+}
+
+#else
+
+uint32_t query_allowed_node_mask() noexcept { return 1u; }
+
+bool install(void *, uint64_t, int, uint32_t) noexcept { return false; }
+
+constexpr int k_mpol_bind = 0;
+constexpr int k_mpol_interleave = 0;
+
+#endif
+
+}  // namespace
+
+uint32_t allowed_node_mask() noexcept {
+  // The allowed set only changes under cpuset reconfiguration; one probe per
+  // process keeps the hot lane lookups syscall-free.
+  static const uint32_t mask = query_allowed_node_mask();
+  return mask;
+}
+
+uint32_t node_count() noexcept {
+  return static_cast<uint32_t>(std::popcount(allowed_node_mask()));
+}
+
+uint32_t current_node() noexcept {
+#if defined(__linux__) && defined(__GLIBC__) &&                                \
+    (__GLIBC__ > 2 || (__GLIBC__ == 2 && __GLIBC_MINOR__ >= 29))
+  // glibc's getcpu goes through the vDSO: no kernel entry per lane dispatch.
+  unsigned int cpu = 0u;
+  unsigned int node = 0u;
+  if (::getcpu(&cpu, &node) != 0 || node >= k_max_nodes) {
+    return 0u;
+  }
+  return node;
+#else
+  return 0u;
+#endif
+}
+
+bool apply(void *base, const uint64_t bytes, const placement where) noexcept {
+  if (base == nullptr || bytes == 0u ||
+      where.mode == placement::kind::first_touch || node_count() < 2u) {
+    return false;
+  }
+  if (where.mode == placement::kind::interleave) {
+    return install(base, bytes, k_mpol_interleave, allowed_node_mask());
+  }
+  if (where.node >= k_max_nodes) {
+    return false;
+  }
+  return install(base, bytes, k_mpol_bind, 1u << where.node);
+}
+
+}  // namespace emel::memory::numa
@@ -0,0 +1,52 @@
+#pragma once
+
+#include <cstdint>
+
+// NUMA placement for the large read-mostly buffers a decode step sweeps.
+//
+// On multi-socket hosts first-touch puts a whole buffer on the node of the
+// thread that initialized it, so matmul lanes on the other socket stream
+// their rows across the interconnect. Two remedies:
+//   interleave: spread an anonymous mapping's pages round-robin over the
+//               allowed nodes, halving the remote share on two sockets.
+//   replicate:  keep one copy of each read-only weight per node
+//               (numa_replicas.hpp) and let every lane read its local copy.
+// Everything here is best effort: single-node hosts, non-Linux builds and
+// kernels without mempolicy support report one node and leave placement to
+// first touch.
+namespace emel::memory::numa {
+
+inline constexpr uint32_t k_max_nodes = 8u;
+// Replica budget with no cap; a budget of 0 replicates nothing.
+inline constexpr uint64_t k_unlimited_replica_budget = ~uint64_t{0};
+
+enum class policy : uint8_t {
+  first_touch = 0,
+  interleave = 1,
+  replicate = 2,
+};
+
+// Per-allocation placement applied before the pages are first touched.
+struct placement {
+  enum class kind : uint8_t {
+    first_touch = 0,
+    interleave = 1,
+    bind = 2,
+  };
+
+  placement::kind mode = kind::first_touch;
+  uint32_t node = 0u;
+};
+
+// Bit n set when node n (< k_max_nodes) may hold this process's memory.
+uint32_t allowed_node_mask() noexcept;
+uint32_t node_count() noexcept;
+// Node of the CPU the calling thread currently runs on; 0 when unknown.
+uint32_t current_node() noexcept;
+
+// Applies `where` to the page-aligned span inside [base, base + bytes).
+// Returns false when the policy could not be installed; the memory stays
+// usable with first-touch placement either way.
+bool apply(void *base, uint64_t bytes, placement where) noexcept;
+
+}  // namespace emel::memory::numa
@@ -0,0 +1,159 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <iterator>
+
+#include "emel/memory/huge_pages.hpp"
+#include "emel/memory/numa.hpp"
+
+// Per-node replicas of read-only weights (numa::policy::replicate).
+//
+// The owner registers each weight span once after its bytes are final; every
+// allowed node then gets a copy bound to that node before the copy touches
+// it. Hot-path readers translate a pointer anywhere inside a registered span
+// to the same offset in the copy local to the calling thread, so a matmul
+// lane's row slice comes from its own socket. Unregistered pointers resolve
+// to themselves, which keeps the translation safe to call on any operand.
+//
+// Registration is setup-time only: it maps each copy straight from
+// huge_pages::allocate and skips a span whose mapping fails, so it never
+// throws. resolve() is read-only and safe from any number of lanes once
+// registration is done.
+namespace emel::memory::numa {
+
+class replica_table {
+ public:
+  // Decode registers at most the output matrices plus every block matrix;
+  // spans past this count stay on first touch.
+  static constexpr size_t k_max_regions = 1024u;
+
+  struct region {
+    const uint8_t *base = nullptr;
+    uint64_t bytes = 0u;
+    std::array<uint8_t *, k_max_nodes> copies = {};
+  };
+
+  replica_table() = default;
+  replica_table(const replica_table &) = delete;
+  replica_table &operator=(const replica_table &) = delete;
+  ~replica_table() { release_copies(); }
+
+  // Drops every replica. budget_bytes caps the total bytes of all copies
+  // (0 replicates nothing, k_unlimited_replica_budget has no cap); node_mask
+  // selects the nodes that receive copies.
+  void reset(const uint64_t budget_bytes,
+             const uint32_t node_mask = allowed_node_mask()) noexcept {
+    release_copies();
+    budget_bytes_ = budget_bytes;
+    used_bytes_ = 0u;
+    node_mask_ = node_mask & ((1u << k_max_nodes) - 1u);
+  }
+
+  // Copies [base, base + bytes) onto every selected node. Returns false
+  // (registering nothing) for a single-node mask, an overlap with a
+  // registered span, spans too small to leave the heap, a full table, a
+  // copy that would exceed the budget, or a node whose mapping could not be
+  // obtained; callers register hottest-first so the budget keeps the most
+  // valuable spans.
+  bool add(const void *base, const uint64_t bytes) noexcept {
+    const auto *begin = static_cast<const uint8_t *>(base);
+    const uint64_t copies = static_cast<uint64_t>(std::popcount(node_mask_));
+    if (begin == nullptr || bytes < huge_pages::k_arena_min_bytes ||
+        copies < 2u || copies * bytes > budget_bytes_ - used_bytes_ ||
+        region_count_ == k_max_regions) {
+      return false;
+    }
+    region *const first = regions_.data();
+    region *const last = first + region_count_;
+    region *const next = std::lower_bound(
+        first, last, begin,
+        [](const region &item, const uint8_t *key) { return item.base < key; });
+    const bool overlaps_next = next != last && next->base < begin + bytes;
+    const bool overlaps_prev = next != first &&
+                               std::prev(next)->base + std::prev(next)->bytes > begin;
+    if (overlaps_next || overlaps_prev) {
+      return false;
+    }
+    region item{.base = begin, .bytes = bytes};
+    for (uint32_t node = 0; node < k_max_nodes; ++node) {
+      if ((node_mask_ & (1u << node)) == 0u) {
+        continue;
+      }
+      // The mapping is bound to `node` before the copy's first write, so the
+      // pages materialize there.
+      const huge_pages::allocation block = huge_pages::allocate(
+          bytes, huge_pages::policy::transparent,
+          placement{.mode = placement::kind::bind, .node = node});
+      if (block.base == nullptr) {
+        release_region(item);
+        return false;
+      }
+      item.copies[node] = static_cast<uint8_t *>(block.base);
+      std::memcpy(item.copies[node], begin, static_cast<size_t>(bytes));
+    }
+    std::move_backward(next, last, last + 1);
+    *next = item;
+    region_count_ += 1u;
+    used_bytes_ += copies * bytes;
+    return true;
+  }
+
+  // Same offset inside `node`'s copy of the span holding `data`, or `data`
+  // itself when no registered span (or no copy on that node) covers it.
+  const void *resolve(const void *data, const uint32_t node) const noexcept {
+    if (region_count_ == 0u || node >= k_max_nodes) {
+      return data;
+    }
+    const auto *pointer = static_cast<const uint8_t *>(data);
+    const region *const first = regions_.data();
+    const region *const next = std::upper_bound(
+        first, first + region_count_, pointer,
+        [](const uint8_t *key, const region &item) { return key < item.base; });
+    if (next == first) {
+      return data;
+    }
+    const region &item = *std::prev(next);
+    const uint64_t offset = static_cast<uint64_t>(pointer - item.base);
+    if (offset >= item.bytes || item.copies[node] == nullptr) {
+      return data;
+    }
+    return item.copies[node] + offset;
+  }
+
+  const void *resolve_local(const void *data) const noexcept {
+    return region_count_ == 0u ? data : resolve(data, current_node());
+  }
+
+  size_t region_count() const noexcept { return region_count_; }
+  uint64_t replicated_bytes() const noexcept { return used_bytes_; }
+
+ private:
+  static void release_region(region &item) noexcept {
+    for (uint8_t *&copy : item.copies) {
+      if (copy != nullptr) {
+        huge_pages::release(copy, item.bytes);
+        copy = nullptr;
+      }
+    }
+  }
+
+  void release_copies() noexcept {
+    for (size_t index = 0; index < region_count_; ++index) {
+      release_region(regions_[index]);
+    }
+    region_count_ = 0u;
+  }
+
+  std::array<region, k_max_regions> regions_ = {};
+  size_t region_count_ = 0u;
+  uint64_t budget_bytes_ = 0u;
+  uint64_t used_bytes_ = 0u;
+  uint32_t node_mask_ = 0u;
+};
+
+}  // namespace emel::memory::numa
@@ -1,5 +1,8 @@
 #include "emel/model/data.hpp"
 
+#include <tuple>
+#include <utility>
+
 #include "emel/model/architecture/detail.hpp"
 #include "emel/model/gemma4/detail.hpp"
 #include "emel/model/lfm2/detail.hpp"
@@ -10,6 +13,82 @@
 
 namespace emel::model {
 
+namespace {
+
+constexpr uint32_t k_tensor_name_slot_mask =
+    data::k_tensor_name_index_slots - 1u;
+static_assert((data::k_tensor_name_index_slots & k_tensor_name_slot_mask) ==
+              0u);
+
+uint32_t tensor_name_hash(const std::string_view name) noexcept {
+  uint32_t hash = 2166136261u;
+  for (const char c : name) {
+    hash ^= static_cast<uint8_t>(c);
+    hash *= 16777619u;
+  }
+  return hash;
+}
+
+const data::tensor_record *scan_tensor(const data &model_data,
+                                       const std::string_view name) noexcept {
+  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
+    const auto &tensor = model_data.tensors[index];
+    if (tensor_name_view(model_data, tensor) == name) {
+      return &tensor;
+    }
+  }
+  return nullptr;
+}
+
+} // namespace
+
+bool reserve_tables(data &model_data, const uint32_t tensor_count,
+                    const uint32_t kv_count) noexcept {
+  if (tensor_count > static_cast<uint32_t>(data::k_max_tensors)) {
+    return false;
+  }
+
+  bool reserved = true;
+  if (tensor_count > 0u) {
+    reserved = model_data.tensors.reserve() &&
+               model_data.name_storage.reserve() &&
+               model_data.tensor_name_index.reserve();
+  }
+  if (reserved && kv_count > 0u) {
+    reserved = model_data.meta.blob.reserve() &&
+               reserve_vocab_tables(model_data.vocab_data);
+  }
+  return reserved;
+}
+
+bool reserve_vocab_tables(data::vocab &vocab) noexcept {
+  return vocab.token_storage.reserve() && vocab.merge_storage.reserve() &&
+         vocab.entries.reserve() && vocab.merge_offsets.reserve() &&
+         vocab.merge_lengths.reserve() && vocab.precompiled_charsmap.reserve() &&
+         vocab.lstrip_flags.reserve() && vocab.rstrip_flags.reserve() &&
+         vocab.pieces.reserve() && vocab.token_trie.reserve();
+}
+
+void reset_vocab(data::vocab &vocab) noexcept {
+  // Avoid materializing a large temporary vocabulary aggregate on the stack
+  // while preserving the struct's negative-sentinel/default member
+  // initializers. Reserved blocks are moved aside and back, so a reset never
+  // frees a table the owner reserved; loads only read them up to the counts
+  // reset here.
+  static const data::vocab k_default_vocab = {};
+  auto kept = std::make_tuple(
+      std::move(vocab.token_storage), std::move(vocab.merge_storage),
+      std::move(vocab.entries), std::move(vocab.merge_offsets),
+      std::move(vocab.merge_lengths), std::move(vocab.precompiled_charsmap),
+      std::move(vocab.lstrip_flags), std::move(vocab.rstrip_flags),
+      std::move(vocab.pieces), std::move(vocab.token_trie));
+  vocab = k_default_vocab;
+  std::tie(vocab.token_storage, vocab.merge_storage, vocab.entries,
+           vocab.merge_offsets, vocab.merge_lengths, vocab.precompiled_charsmap,
+           vocab.lstrip_flags, vocab.rstrip_flags, vocab.pieces,
+           vocab.token_trie) = std::move(kept);
+}
+
 std::string_view tensor_name_view(const data &model_data,
                                   const data::tensor_record &tensor) noexcept {
   const size_t begin = static_cast<size_t>(tensor.name_offset);
@@ -21,6 +100,51 @@ std::string_view tensor_name_view(const data &model_data,
   return std::string_view{model_data.name_storage.data() + begin, length};
 }
 
+void build_tensor_name_index(data &model_data) noexcept {
+  model_data.tensor_name_index_count = 0u;
+  if (model_data.n_tensors > static_cast<uint32_t>(data::k_max_tensors) ||
+      !model_data.tensor_name_index.reserve()) {
+    return;
+  }
+
+  model_data.tensor_name_index.fill(0u);
+
+  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
+    const auto name = tensor_name_view(model_data, model_data.tensors[index]);
+    uint32_t slot = tensor_name_hash(name) & k_tensor_name_slot_mask;
+    while (model_data.tensor_name_index[slot] != 0u) {
+      const uint32_t other = model_data.tensor_name_index[slot] - 1u;
+      if (tensor_name_view(model_data, model_data.tensors[other]) == name) {
+        break; // duplicate name: the first record wins, as with a scan
+      }
+      slot = (slot + 1u) & k_tensor_name_slot_mask;
+    }
+    if (model_data.tensor_name_index[slot] == 0u) {
+      model_data.tensor_name_index[slot] = index + 1u;
+    }
+  }
+  model_data.tensor_name_index_count = model_data.n_tensors;
+}
+
+const data::tensor_record *find_tensor(const data &model_data,
+                                       const std::string_view name) noexcept {
+  if (model_data.tensor_name_index_count != model_data.n_tensors ||
+      model_data.n_tensors == 0u) {
+    return scan_tensor(model_data, name);
+  }
+
+  uint32_t slot = tensor_name_hash(name) & k_tensor_name_slot_mask;
+  while (model_data.tensor_name_index[slot] != 0u) {
+    const auto &tensor =
+        model_data.tensors[model_data.tensor_name_index[slot] - 1u];
+    if (tensor_name_view(model_data, tensor) == name) {
+      return &tensor;
+    }
+    slot = (slot + 1u) & k_tensor_name_slot_mask;
+  }
+  return nullptr;
+}
+
 std::string_view
 metadata_string_view(const data::metadata &metadata,
                      const data::metadata::string_view &value) noexcept {
@@ -5,6 +5,7 @@
 #include <string_view>
 
 #include "emel/error/error.hpp"
+#include "emel/model/lazy_array.hpp"
 
 namespace emel::model {
 
@@ -39,6 +40,9 @@ struct data {
   static constexpr int32_t k_max_architecture_name = 64;
   static constexpr int32_t k_max_vocab_tokens = 320000;
   static constexpr int32_t k_max_vocab_bytes = 8 * 1024 * 1024;
+  // A token trie has at most one unit per token byte plus the root; the few
+  // placement gaps fit in the slack of real vocabs, far below the byte cap.
+  static constexpr int32_t k_max_token_trie_units = k_max_vocab_bytes;
   static constexpr int32_t k_max_tokenizer_model = 64;
   static constexpr int32_t k_max_tokenizer_pre = 64;
   static constexpr int32_t k_max_merges = 600000;
@@ -55,6 +59,9 @@ struct data {
   static constexpr int32_t k_max_xielu_values = 256;
   static constexpr int32_t k_max_clip_image_stats = 16;
   static constexpr int32_t k_max_clip_layer_indexes = 512;
+  // Open-addressed, power-of-two slot count at <= 50% load for k_max_tensors.
+  static constexpr uint32_t k_tensor_name_index_slots =
+      2u * static_cast<uint32_t>(k_max_tensors);
 
   enum class tokenizer_model : uint8_t {
     NONE = 0,
@@ -334,6 +341,15 @@ struct data {
     int32_t type = 0;
   };
 
+  // One token as the detokenizer emits it, resolved from vocab_entry at load
+  // (text::detokenizer::detail::prepare_piece_table).
+  struct vocab_piece {
+    // token_storage offset of the piece; the decoded byte for byte pieces.
+    uint32_t offset = 0;
+    // piece length in the low bits, detokenizer flags above them.
+    uint32_t length = 0;
+  };
+
   struct vocab {
     uint32_t n_tokens = 0;
     uint32_t n_token_types = 0;
@@ -344,17 +360,30 @@ struct data {
 
     std::array<char, k_max_tokenizer_model> tokenizer_model_name = {};
     std::array<char, k_max_tokenizer_pre> tokenizer_pre_name = {};
-    std::array<char, k_max_vocab_bytes> token_storage = {};
-    std::array<char, k_max_merge_bytes> merge_storage = {};
+    lazy_array<char, k_max_vocab_bytes> token_storage = {};
+    lazy_array<char, k_max_merge_bytes> merge_storage = {};
 
-    std::array<vocab_entry, k_max_vocab_tokens> entries = {};
-    std::array<uint32_t, k_max_merges> merge_offsets = {};
-    std::array<uint32_t, k_max_merges> merge_lengths = {};
-    std::array<uint8_t, k_max_precompiled_charsmap_bytes> precompiled_charsmap =
+    lazy_array<vocab_entry, k_max_vocab_tokens> entries = {};
+    lazy_array<uint32_t, k_max_merges> merge_offsets = {};
+    lazy_array<uint32_t, k_max_merges> merge_lengths = {};
+    lazy_array<uint8_t, k_max_precompiled_charsmap_bytes> precompiled_charsmap =
         {};
     static constexpr uint32_t k_attr_flag_bytes = (k_max_vocab_tokens + 7) / 8;
-    std::array<uint8_t, k_attr_flag_bytes> lstrip_flags = {};
-    std::array<uint8_t, k_attr_flag_bytes> rstrip_flags = {};
+    using attr_flags = lazy_array<uint8_t, k_attr_flag_bytes>;
+    attr_flags lstrip_flags = {};
+    attr_flags rstrip_flags = {};
+    // Token->piece table shared by every detokenizer bound to this vocab;
+    // n_pieces stays 0 for a vocab assembled without the loader.
+    lazy_array<vocab_piece, k_max_vocab_tokens> pieces = {};
+    uint32_t n_pieces = 0;
+    // Byte trie over every token text (text::encoders::detail::double_array_trie
+    // cells: base, check, value per unit), built once at load and walked in
+    // place by every encoder bound to this vocab. token_trie_units stays 0
+    // until text::encoders::detail::prepare_token_trie runs, and encoders
+    // reject a vocab without a trie.
+    lazy_array<int32_t, 3 * k_max_token_trie_units> token_trie = {};
+    uint32_t token_trie_units = 0;
+    uint32_t token_trie_max_key = 0;
 
     tokenizer_model tokenizer_model_id = tokenizer_model::UNKNOWN;
     tokenizer_pre tokenizer_pre_id = tokenizer_pre::DEFAULT;
@@ -593,15 +622,20 @@ struct data {
     diffusion diffusion_data = {};
 
     uint32_t blob_bytes_used = 0;
-    std::array<char, k_max_metadata_blob_bytes> blob = {};
+    lazy_array<char, k_max_metadata_blob_bytes> blob = {};
   };
 
   int32_t n_layers = 0;
   uint32_t n_tensors = 0;
   uint32_t name_bytes_used = 0;
   std::array<char, k_max_architecture_name> architecture_name = {};
-  std::array<char, k_max_name_bytes> name_storage = {};
-  std::array<tensor_record, k_max_tensors> tensors = {};
+  lazy_array<char, k_max_name_bytes> name_storage = {};
+  lazy_array<tensor_record, k_max_tensors> tensors = {};
+  // Name -> tensor slot table (tensor index + 1, 0 = empty) built by
+  // build_tensor_name_index(). find_tensor() only trusts it while
+  // tensor_name_index_count still equals n_tensors.
+  uint32_t tensor_name_index_count = 0;
+  lazy_array<uint32_t, k_tensor_name_index_slots> tensor_name_index = {};
   const void *weights_data = nullptr;
   uint64_t weights_size = 0;
   uint16_t weights_split_count = 1;
@@ -615,8 +649,24 @@ struct data {
   mimi_hparams mimi = {};
 };
 
+// Reserves the tables a GGUF load writes, from the tensor and kv counts the
+// gguf probe reports, so loader dispatch never allocates them. Returns false
+// when a count exceeds its table or a block cannot be reserved.
+bool reserve_tables(data &model_data, uint32_t tensor_count,
+                    uint32_t kv_count) noexcept;
+bool reserve_vocab_tables(data::vocab &vocab) noexcept;
+// Restores the vocab defaults, keeping any table blocks already reserved.
+void reset_vocab(data::vocab &vocab) noexcept;
 std::string_view tensor_name_view(const data &model_data,
                                   const data::tensor_record &tensor) noexcept;
+// Rebuilds the name index over tensors[0, n_tensors). Call again after the
+// tensor table or name_storage is rewritten. When the index cannot be
+// reserved it stays empty and find_tensor() scans.
+void build_tensor_name_index(data &model_data) noexcept;
+// Indexed lookup once build_tensor_name_index() has run for the current
+// n_tensors; a linear scan otherwise (hand-built fixtures).
+const data::tensor_record *find_tensor(const data &model_data,
+                                       std::string_view name) noexcept;
 std::string_view
 metadata_string_view(const data::metadata &metadata,
                      const data::metadata::string_view &value) noexcept;
@@ -8,14 +8,18 @@
 #include <span>
 
 #include "emel/model/loader/errors.hpp"
+#include "emel/text/detokenizer/detail.hpp"
+#include "emel/text/encoders/types.hpp"
 #include "emel/text/tokenizer/detail.hpp"
 #include "emel/text/tokenizer/preprocessor/detail.hpp"
 
 namespace emel::model::detail {
 
-bool load_hparams_from_gguf(const kv_binding & binding,
-                            const emel::model::architectures available_architectures,
-  emel::model::data & model_out) noexcept {
+namespace {
+
+bool load_hparams_unprofiled(const kv_binding & binding,
+                             const emel::model::architectures available_architectures,
+                             emel::model::data & model_out) noexcept {
   model_out.params = {};
 
   const auto * architecture_entry = find_kv_entry(binding, "general.architecture");
@@ -58,6 +62,18 @@ bool load_hparams_from_gguf(const kv_binding & binding,
   return true;
 }
 
+}  // namespace
+
+bool load_hparams_from_gguf(const kv_binding & binding,
+                            const emel::model::architectures available_architectures,
+                            emel::model::data & model_out) noexcept {
+  const uint64_t started = emel::model::load_profile::start(binding.profile);
+  const bool loaded = load_hparams_unprofiled(binding, available_architectures, model_out);
+  emel::model::load_profile::stop(binding.profile, emel::model::load_profile::phase::hparams,
+                                  started, 0u);
+  return loaded;
+}
+
 bool load_hparams_from_gguf(const kv_binding & binding, emel::model::data & model_out) noexcept {
   return load_hparams_from_gguf(binding, emel::model::default_architecture_span(), model_out);
 }
@@ -75,8 +91,26 @@ void mark_special_token_type(emel::model::data::vocab & vocab,
   }
 }
 
-bool load_vocab_from_gguf(const kv_binding & binding,
-                          emel::model::data::vocab & vocab_out) noexcept {
+namespace {
+
+// Restores a trie image stored with the model (a u8 array written by
+// text::encoders::detail::serialize_token_trie); a missing or stale image
+// leaves the trie to be built from the vocab.
+bool restore_token_trie(const kv_binding & binding,
+                        emel::model::data::vocab & vocab_out) noexcept {
+  namespace constants = emel::gguf::loader::detail::constants;
+  const auto * entry =
+      find_kv_entry(binding, emel::text::encoders::detail::k_token_trie_image_key);
+  array_header header = {};
+  return entry != nullptr && decode_array_header(binding, *entry, header) &&
+         (header.element_type == constants::gguf_type_uint8 ||
+          header.element_type == constants::gguf_type_int8) &&
+         emel::text::encoders::detail::deserialize_token_trie(
+             vocab_out, header.payload.data(), header.payload.size());
+}
+
+bool load_vocab_unprofiled(const kv_binding & binding,
+                           emel::model::data::vocab & vocab_out) noexcept {
   const auto fail = [](const char * stage) noexcept {
     if (std::getenv("EMEL_DEBUG_GGUF_VOCAB") != nullptr) {
       std::fprintf(stderr, "load_vocab_from_gguf failed at %s\n", stage);
@@ -84,10 +118,10 @@ bool load_vocab_from_gguf(const kv_binding & binding,
     return false;
   };
 
-  // Avoid materializing a large temporary vocabulary aggregate on the stack here while
-  // preserving the struct's negative-sentinel/default member initializers.
-  static const emel::model::data::vocab k_default_vocab = {};
-  vocab_out = k_default_vocab;
+  emel::model::reset_vocab(vocab_out);
+  if (!emel::model::reserve_vocab_tables(vocab_out)) {
+    return fail("reserve_vocab_tables");
+  }
 
   const auto * model_entry =
       find_kv_entry_any(binding, {"tokenizer.model", "tokenizer.ggml.model"});
@@ -395,7 +429,26 @@ bool load_vocab_from_gguf(const kv_binding & binding,
     return fail("unknown_tokenizer_model");
   }
 
+  // Derived after the special-token types above, which decide piece flags.
+  emel::text::detokenizer::detail::prepare_piece_table(vocab_out);
+  if (!restore_token_trie(binding, vocab_out) &&
+      !emel::text::encoders::detail::prepare_token_trie(vocab_out)) {
+    return fail("prepare_token_trie");
+  }
   return true;
 }
 
+}  // namespace
+
+bool load_vocab_from_gguf(const kv_binding & binding,
+                          emel::model::data::vocab & vocab_out) noexcept {
+  const uint64_t started = emel::model::load_profile::start(binding.profile);
+  const bool loaded = load_vocab_unprofiled(binding, vocab_out);
+  // Token text plus merge text is what ingest copied out of the kv arena.
+  emel::model::load_profile::stop(
+      binding.profile, emel::model::load_profile::phase::vocab_ingest, started,
+      static_cast<uint64_t>(vocab_out.token_bytes_used) + vocab_out.merge_bytes_used);
+  return loaded;
+}
+
 }  // namespace emel::model::detail
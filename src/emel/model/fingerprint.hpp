@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "emel/model/data.hpp"
+
+// Cheap identity checks for owner-persisted sidecar images derived from a
+// model file (text::generator::prepared_cache, tensor::window::sidecar).
+//
+// model_fingerprint() stands in for a full model-file hash: the tensor table
+// (names, dtypes, extents, file offsets) plus split sizes pins the file layout
+// without reading every weight byte at startup. source_probe() samples a few
+// spans of one tensor's bytes so a re-quantized model with an identical
+// tensor table still misses.
+namespace emel::model {
+
+inline constexpr uint64_t k_fingerprint_offset = 14695981039346656037ull;
+inline constexpr uint64_t k_fingerprint_prime = 1099511628211ull;
+inline constexpr uint64_t k_source_probe_count = 16u;
+inline constexpr uint64_t k_source_probe_bytes = 32u;
+
+inline uint64_t fingerprint_bytes(uint64_t hash, const void *data,
+                                  const size_t size) noexcept {
+  const auto *bytes = static_cast<const uint8_t *>(data);
+  for (size_t i = 0; i < size; ++i) {
+    hash ^= static_cast<uint64_t>(bytes[i]);
+    hash *= k_fingerprint_prime;
+  }
+  return hash;
+}
+
+template <class value_type>
+inline uint64_t fingerprint_value(const uint64_t hash,
+                                  const value_type &value) noexcept {
+  return fingerprint_bytes(hash, &value, sizeof(value));
+}
+
+inline uint64_t model_fingerprint(const data &model) noexcept {
+  uint64_t hash = k_fingerprint_offset;
+  hash = fingerprint_value(hash, model.n_tensors);
+  hash = fingerprint_bytes(hash, model.name_storage.data(),
+                           static_cast<size_t>(model.name_bytes_used));
+  for (uint32_t i = 0; i < model.n_tensors; ++i) {
+    const auto &tensor = model.tensors[i];
+    hash = fingerprint_value(hash, tensor.type);
+    hash = fingerprint_value(hash, tensor.n_dims);
+    hash = fingerprint_value(hash, tensor.dims);
+    hash = fingerprint_value(hash, tensor.file_offset);
+    hash = fingerprint_value(hash, tensor.data_size);
+    hash = fingerprint_value(hash, tensor.file_index);
+  }
+  hash = fingerprint_value(hash, model.weights_split_count);
+  for (uint16_t i = 0; i < model.weights_split_count; ++i) {
+    hash = fingerprint_value(hash, model.weights_split_sizes[i]);
+  }
+  return hash;
+}
+
+inline uint64_t source_probe(const uint8_t *bytes,
+                             const uint64_t size) noexcept {
+  uint64_t hash = k_fingerprint_offset;
+  if (bytes == nullptr || size == 0u) {
+    return hash;
+  }
+  const uint64_t span =
+      size < k_source_probe_bytes ? size : k_source_probe_bytes;
+  const uint64_t last = size - span;
+  for (uint64_t i = 0; i < k_source_probe_count; ++i) {
+    const uint64_t offset = (last * i) / (k_source_probe_count - 1u);
+    hash = fingerprint_bytes(hash, bytes + offset, static_cast<size_t>(span));
+  }
+  return hash;
+}
+
+}  // namespace emel::model
@@ -14,18 +14,6 @@ namespace {
 
 constexpr std::string_view k_output_name = "output.weight";
 
-const data::tensor_record *
-find_tensor_by_name(const data &model_data,
-                    const std::string_view name) noexcept {
-  for (uint32_t i = 0u; i < model_data.n_tensors; ++i) {
-    const auto &tensor = model_data.tensors[i];
-    if (emel::model::tensor_name_view(model_data, tensor) == name) {
-      return &tensor;
-    }
-  }
-  return nullptr;
-}
-
 bool tensor_has_storage(const data::tensor_record &tensor) noexcept {
   if (tensor.data == nullptr || tensor.data_size == 0u || tensor.n_dims <= 0) {
     return false;
@@ -230,14 +218,14 @@ emel::error::type build_contract(const emel::model::data &model_data,
 
 bool has_tensor_named(const emel::model::data &model_data,
                       const std::string_view name) noexcept {
-  const auto *tensor = find_tensor_by_name(model_data, name);
+  const auto *tensor = find_tensor(model_data, name);
   return tensor != nullptr && tensor_has_storage(*tensor);
 }
 
 bool bind_tensor_view(const emel::model::data &model_data,
                       const std::string_view name,
                       tensor_view &view_out) noexcept {
-  const auto *tensor = find_tensor_by_name(model_data, name);
+  const auto *tensor = find_tensor(model_data, name);
   if (tensor == nullptr || !tensor_has_storage(*tensor)) {
     return false;
   }
@@ -0,0 +1,142 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <type_traits>
+
+namespace emel::model {
+
+// Fixed-capacity array for the worst-case-sized tables in model::data.
+//
+// std::array members made every data/vocab object carry ~40 MiB that was
+// zero-filled on construction, even for a 200-tensor sidecar model. A
+// lazy_array keeps the std::array surface (operator[], data(), size(),
+// begin()/end(), fill()) but only holds a block once reserve() callocs one:
+// large blocks come back as untouched zero pages, so resident memory tracks
+// the records a loader actually writes.
+//
+// Owners reserve before any dispatch writes a table (model::reserve_tables,
+// from the GGUF header counts), and reserve() reports failure instead of
+// throwing. A mutable access to an unreserved array reserves on demand, for
+// fixtures assembled outside dispatch, and yields nullptr if that fails.
+//
+// Reads through a const reference before any reserve see a static zero block;
+// copying an array that was never reserved stays free.
+template <class value_type_in, size_t capacity>
+class lazy_array {
+ public:
+  using value_type = value_type_in;
+  using size_type = size_t;
+  using reference = value_type &;
+  using const_reference = const value_type &;
+  using pointer = value_type *;
+  using const_pointer = const value_type *;
+  using iterator = value_type *;
+  using const_iterator = const value_type *;
+
+  // calloc()'s all-zero bytes must equal a value-initialized element.
+  static_assert(std::is_trivially_copyable_v<value_type>);
+  static_assert(capacity > 0u);
+
+  lazy_array() noexcept = default;
+
+  lazy_array(const lazy_array &other) noexcept { copy_from(other); }
+
+  lazy_array(lazy_array &&other) noexcept : storage_(other.storage_) {
+    other.storage_ = nullptr;
+  }
+
+  lazy_array &operator=(const lazy_array &other) noexcept {
+    if (this != &other) {
+      copy_from(other);
+    }
+    return *this;
+  }
+
+  lazy_array &operator=(lazy_array &&other) noexcept {
+    if (this != &other) {
+      std::free(storage_);
+      storage_ = other.storage_;
+      other.storage_ = nullptr;
+    }
+    return *this;
+  }
+
+  ~lazy_array() { std::free(storage_); }
+
+  static constexpr size_type size() noexcept { return capacity; }
+  static constexpr size_type max_size() noexcept { return capacity; }
+  static constexpr bool empty() noexcept { return false; }
+
+  // True once reserve() (or a mutable access) reserved the block.
+  bool materialized() const noexcept { return storage_ != nullptr; }
+
+  // Reserves the zeroed block; false when it cannot be allocated.
+  bool reserve() noexcept {
+    if (storage_ == nullptr) {
+      storage_ =
+          static_cast<pointer>(std::calloc(capacity, sizeof(value_type)));
+    }
+    return storage_ != nullptr;
+  }
+
+  pointer data() noexcept {
+    (void)reserve();
+    return storage_;
+  }
+  const_pointer data() const noexcept {
+    return storage_ != nullptr ? storage_ : zero_block();
+  }
+
+  reference operator[](const size_type index) noexcept {
+    return data()[index];
+  }
+  const_reference operator[](const size_type index) const noexcept {
+    return data()[index];
+  }
+
+  iterator begin() noexcept { return data(); }
+  iterator end() noexcept { return data() + capacity; }
+  const_iterator begin() const noexcept { return data(); }
+  const_iterator end() const noexcept { return data() + capacity; }
+  const_iterator cbegin() const noexcept { return data(); }
+  const_iterator cend() const noexcept { return data() + capacity; }
+
+  void fill(const value_type &value) noexcept {
+    pointer items = data();
+    const size_type count = capacity * static_cast<size_type>(items != nullptr);
+    for (size_type index = 0; index < count; ++index) {
+      items[index] = value;
+    }
+  }
+
+  // Drops the block so the array reads as zero again without touching pages.
+  void release() noexcept {
+    std::free(storage_);
+    storage_ = nullptr;
+  }
+
+ private:
+  static constexpr size_t k_bytes = capacity * sizeof(value_type);
+
+  static const_pointer zero_block() noexcept {
+    // Zero-initialized static storage that is never written: its pages stay
+    // unbacked, so const reads cost address space only and cannot fail.
+    alignas(value_type) static std::byte block[k_bytes];
+    return reinterpret_cast<const_pointer>(block);
+  }
+
+  // A copy that cannot reserve its block stays unreserved and reads as zero.
+  void copy_from(const lazy_array &other) noexcept {
+    if (other.storage_ == nullptr || !reserve()) {
+      release();
+      return;
+    }
+    std::memcpy(storage_, other.storage_, k_bytes);
+  }
+
+  pointer storage_ = nullptr;
+};
+
+}  // namespace emel::model
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "emel/clock.hpp"
+
+// Cold-start breakdown: wall time and bytes per load phase, from the GGUF
+// header scan through the generator's weight repack and KV allocation.
+//
+// One recorder per load, threaded through the load events (injection and
+// null-recorder contract: emel/clock.hpp). Each site times only its own leaf
+// work, so phases never nest and their sum is the instrumented share of the
+// cold start. Owner-side phases (mapping the file, prefaulting it) are
+// recorded with the same start()/stop() pair.
+namespace emel::model::load_profile {
+
+using emel::clock_fn;
+
+enum class phase : uint8_t {
+  gguf_header = 0,      // gguf::loader probe: header + metadata scan
+  gguf_metadata = 1,    // gguf::loader parse: kv arena + tensor infos
+  hparams = 2,          // architecture hyperparameters from the kv arena
+  vocab_ingest = 3,     // tokens, scores, types and merges
+  tensor_plan = 4,      // model::tensor bind/plan/apply
+  tensor_read = 5,      // io::loader map/read of tensor bytes
+  layer_validate = 6,   // layer mapping + structure/architecture checks
+  map_file = 7,         // owner: open + map the model file
+  prefault = 8,         // owner: fault the mapped weights in
+  weight_repack = 9,    // generator: packed/prepared weight layouts
+  kv_allocate = 10,     // generator: KV cache arenas
+  count = 11,
+};
+
+inline constexpr size_t k_phase_count = static_cast<size_t>(phase::count);
+
+struct phase_sample {
+  uint64_t ns = 0u;
+  uint64_t bytes = 0u;
+  uint32_t calls = 0u;
+};
+
+struct recorder {
+  clock_fn clock = nullptr;
+  std::array<phase_sample, k_phase_count> phases = {};
+};
+
+// Structured report published with the load/initialize done events.
+struct report {
+  std::array<phase_sample, k_phase_count> phases = {};
+  uint64_t total_ns = 0u;
+  uint64_t total_bytes = 0u;
+};
+
+inline constexpr std::string_view phase_name(const phase which) noexcept {
+  constexpr std::array<std::string_view, k_phase_count> names = {
+      "gguf_header", "gguf_metadata",  "hparams",       "vocab_ingest",
+      "tensor_plan", "tensor_read",    "layer_validate", "map_file",
+      "prefault",    "weight_repack",  "kv_allocate",
+  };
+  const size_t index = static_cast<size_t>(which);
+  return index < k_phase_count ? names[index] : std::string_view{};
+}
+
+inline void reset(recorder &profile, const clock_fn clock) noexcept {
+  profile.clock = clock;
+  profile.phases = {};
+}
+
+// Timestamp opening a phase; 0 when the load is not profiled.
+inline uint64_t start(const recorder *profile) noexcept {
+  return profile != nullptr && profile->clock != nullptr ? profile->clock()
+                                                         : 0u;
+}
+
+inline void stop(recorder *profile, const phase which, const uint64_t started,
+                 const uint64_t bytes) noexcept {
+  if (profile == nullptr || profile->clock == nullptr ||
+      which >= phase::count) {
+    return;
+  }
+  const uint64_t now = profile->clock();
+  phase_sample &sample = profile->phases[static_cast<size_t>(which)];
+  sample.ns += now >= started ? now - started : 0u;
+  sample.bytes += bytes;
+  sample.calls += 1u;
+}
+
+inline report make_report(const recorder &profile) noexcept {
+  report out{.phases = profile.phases};
+  for (const phase_sample &sample : profile.phases) {
+    out.total_ns += sample.ns;
+    out.total_bytes += sample.bytes;
+  }
+  return out;
+}
+
+}  // namespace emel::model::load_profile
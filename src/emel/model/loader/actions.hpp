@@ -7,6 +7,7 @@
 namespace emel::model::loader::action {
 
 namespace err = emel::error;
+namespace load_profile = emel::model::load_profile;
 
 namespace detail {
 
@@ -231,8 +232,19 @@ struct run_parse {
   }
 };
 
+// Runs only on the parse-success edge; a failed parse leaves nothing to index.
+struct effect_build_tensor_name_index {
+  void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
+    emel::model::build_tensor_name_index(ev.request.model_data);
+    load_profile::stop(ev.request.profile, load_profile::phase::tensor_plan,
+                       started, 0u);
+  }
+};
+
 struct effect_dispatch_tensor_bind_storage {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     detail::reset_tensor_bind_events(ev.tensor_events);
 
     emel::model::tensor::event::bind_storage bind{
@@ -243,11 +255,14 @@ struct effect_dispatch_tensor_bind_storage {
     bind.on_done = {&ev.tensor_events, detail::record_bind_done_event};
     bind.on_error = {&ev.tensor_events, detail::record_bind_error_event};
     static_cast<void>(ev.request.tensor_loader->process_event(bind));
+    load_profile::stop(ev.request.profile, load_profile::phase::tensor_plan,
+                       started, 0u);
   }
 };
 
 struct effect_dispatch_tensor_plan_load {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     detail::reset_tensor_plan_events(ev.tensor_events);
 
     emel::model::tensor::event::plan_load plan{ev.request.effect_requests};
@@ -255,6 +270,8 @@ struct effect_dispatch_tensor_plan_load {
     plan.on_done = {&ev.tensor_events, detail::record_plan_done_event};
     plan.on_error = {&ev.tensor_events, detail::record_plan_error_event};
     static_cast<void>(ev.request.tensor_loader->process_event(plan));
+    load_profile::stop(ev.request.profile, load_profile::phase::tensor_plan,
+                       started, 0u);
   }
 };
 
@@ -274,6 +291,7 @@ struct effect_mark_io_strategy_used {
 
 struct effect_dispatch_io_load_batch {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     const uint32_t effect_count = ev.tensor_events.plan_done.effect_count;
     effect_reset_io_load_events(*ev.io_events, effect_count);
 
@@ -302,11 +320,14 @@ struct effect_dispatch_io_load_batch {
     load.on_done = {ev.io_events, effect_record_io_load_batch_done_event};
     load.on_error = {ev.io_events, effect_record_io_load_batch_error_event};
     static_cast<void>(ev.request.io_loader->process_event(load));
+    load_profile::stop(ev.request.profile, load_profile::phase::tensor_read,
+                       started, ev.io_events->load_done.bytes_done);
   }
 };
 
 struct effect_dispatch_io_read_copy_load_batch {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     const uint32_t effect_count = ev.tensor_events.plan_done.effect_count;
     effect_reset_io_load_events(*ev.io_events, effect_count);
 
@@ -339,11 +360,14 @@ struct effect_dispatch_io_read_copy_load_batch {
     load.on_done = {ev.io_events, effect_record_io_load_batch_done_event};
     load.on_error = {ev.io_events, effect_record_io_load_batch_error_event};
     static_cast<void>(ev.request.io_loader->process_event(load));
+    load_profile::stop(ev.request.profile, load_profile::phase::tensor_read,
+                       started, ev.io_events->load_done.bytes_done);
   }
 };
 
 struct effect_dispatch_tensor_apply_results {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     const uint32_t effect_count = ev.tensor_events.plan_done.effect_count;
     detail::reset_tensor_apply_events(ev.tensor_events);
 
@@ -365,6 +389,8 @@ struct effect_dispatch_tensor_apply_results {
     apply.on_done = {&ev.tensor_events, detail::record_apply_done_event};
     apply.on_error = {&ev.tensor_events, detail::record_apply_error_event};
     static_cast<void>(ev.request.tensor_loader->process_event(apply));
+    load_profile::stop(ev.request.profile, load_profile::phase::tensor_plan,
+                       started, 0u);
   }
 };
 
@@ -435,19 +461,28 @@ struct effect_mark_tensor_apply_error {
 
 struct run_map_layers {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     ev.ctx.err = ev.request.map_layers(ev.request);
+    load_profile::stop(ev.request.profile, load_profile::phase::layer_validate,
+                       started, 0u);
   }
 };
 
 struct run_validate_structure {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     ev.ctx.err = ev.request.validate_structure(ev.request);
+    load_profile::stop(ev.request.profile, load_profile::phase::layer_validate,
+                       started, 0u);
   }
 };
 
 struct run_validate_architecture {
   void operator()(const event::load_runtime &ev, context &) const noexcept {
+    const uint64_t started = load_profile::start(ev.request.profile);
     ev.ctx.err = ev.request.validate_architecture_impl(ev.request);
+    load_profile::stop(ev.request.profile, load_profile::phase::layer_validate,
+                       started, 0u);
   }
 };
 
@@ -462,6 +497,7 @@ struct publish_done {
         .bytes_done = runtime_ev.ctx.bytes_done,
         .used_mmap = runtime_ev.ctx.used_mmap,
         .used_io_strategy = runtime_ev.ctx.used_io_strategy,
+        .profile = runtime_ev.request.profile,
     });
   }
 };
@@ -509,6 +545,8 @@ inline constexpr mark_internal_error mark_internal_error{};
 inline constexpr mark_model_invalid mark_model_invalid{};
 inline constexpr mark_untracked mark_untracked{};
 inline constexpr run_parse run_parse{};
+inline constexpr effect_build_tensor_name_index
+    effect_build_tensor_name_index{};
 inline constexpr effect_dispatch_tensor_bind_storage
     effect_dispatch_tensor_bind_storage{};
 inline constexpr effect_dispatch_tensor_plan_load
@@ -13,12 +13,15 @@
 #include "emel/gguf/loader/detail.hpp"
 #include "emel/gguf/loader/events.hpp"
 #include "emel/model/data.hpp"
+#include "emel/model/load_profile.hpp"
 
 namespace emel::model::detail {
 
 struct kv_binding {
   std::span<const uint8_t> arena = {};
   std::span<const emel::gguf::loader::kv_entry> entries = {};
+  // Optional cold-start recorder for the hparams/vocab ingest phases.
+  emel::model::load_profile::recorder * profile = nullptr;
 };
 
 inline uint32_t read_u32_le(const std::span<const uint8_t> bytes) noexcept {
@@ -9,6 +9,7 @@
 #include "emel/io/events.hpp"
 #include "emel/io/loader/events.hpp"
 #include "emel/model/data.hpp"
+#include "emel/model/load_profile.hpp"
 #include "emel/model/loader/errors.hpp"
 #include "emel/model/tensor/events.hpp"
 #include "emel/model/tensor/sm.hpp"
@@ -63,11 +64,15 @@ struct load {
   std::span<emel::model::tensor::effect_result> effect_results = {};
   std::span<emel::io::event::tensor_load_span> io_load_spans = {};
   // Shared caller-owned staging/output backing span for storage-backed strategies
-  // (`read_copy` and `staged_read`) before tensor apply publishes handles.
+  // (`read_copy`, `staged_read` and `async_read`) before tensor apply publishes
+  // handles.
   std::span<uint8_t> read_copy_storage = {};
   map_layers_fn map_layers = {};
   validate_structure_fn validate_structure = {};
   validate_architecture_fn validate_architecture_impl = {};
+  // Optional cold-start recorder; the loader times its tensor plan/read and
+  // validation phases into it. parse_model owns the gguf/vocab phases.
+  emel::model::load_profile::recorder *profile = nullptr;
 
   emel::callback<void(const events::load_done &)> on_done = {};
   emel::callback<void(const events::load_error &)> on_error = {};
@@ -161,6 +166,7 @@ struct load_done {
   bool used_mmap = false;
   emel::io::loader::event::strategy_kind used_io_strategy =
       emel::io::loader::event::strategy_kind::none;
+  const emel::model::load_profile::recorder *profile = nullptr;
 };
 
 struct load_error {
@@ -204,9 +204,17 @@ struct io_strategy_staged_read {
   }
 };
 
+struct io_strategy_async_read {
+  bool operator()(const event::load_runtime &ev) const noexcept {
+    return ev.request.io_strategy ==
+           emel::io::loader::event::strategy_kind::async_read;
+  }
+};
+
 struct io_strategy_requires_staging_storage {
   bool operator()(const event::load_runtime &ev) const noexcept {
-    return io_strategy_read_copy{}(ev) || io_strategy_staged_read{}(ev);
+    return io_strategy_read_copy{}(ev) || io_strategy_staged_read{}(ev) ||
+           io_strategy_async_read{}(ev);
   }
 };
 
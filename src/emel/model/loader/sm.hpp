@@ -63,6 +63,7 @@ struct model {
           + sml::completion<event::load_runtime>
       , sml::state<parse_load_tensors_policy_decision> <= sml::state<parse_phase_decision>
           + sml::completion<event::load_runtime> [ guard::error_none{} ]
+          / action::effect_build_tensor_name_index
       , sml::state<errored> <= sml::state<parse_phase_decision>
           + sml::completion<event::load_runtime> [ guard::error_invalid_request{} ]
       , sml::state<errored> <= sml::state<parse_phase_decision>
@@ -453,19 +453,6 @@ bool assign_family_view(
   return family_out.tensor_count > 0u;
 }
 
-const emel::model::data::tensor_record *
-find_tensor(const emel::model::data &model_data,
-            const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
-    const auto &tensor = model_data.tensors[index];
-    if (emel::model::tensor_name_view(model_data, tensor) == name) {
-      return &tensor;
-    }
-  }
-
-  return nullptr;
-}
-
 bool bind_exact_tensor(const emel::model::data &model_data,
                        const std::string_view name,
                        tensor_view &view_out) noexcept {
@@ -55,7 +55,9 @@ inline void bind_and_submit_layer_load(context &ctx,
   ticket.source_bytes = ctx.window.source_bytes;
   ticket.slot_base = slot.storage;
   ticket.stage_chunk_bytes = ctx.window.stage_chunk_bytes;
+  ticket.clock = ctx.window.clock;
   ticket.ok = false;
+  ticket.load_ns = 0u;
 
   scheduler.source(slot_index).arm();
   const bool submitted = ctx.io_pool->try_submit_with_completion(
@@ -140,6 +142,9 @@ struct effect_scan_layer_plan {
     ctx.window.budget_bytes = ev.request.request.budget_bytes;
     ctx.window.prefetch_depth = ev.request.request.prefetch_depth;
     ctx.window.stage_chunk_bytes = ev.request.request.stage_chunk_bytes;
+    ctx.window.prefetch_cursor = ev.request.request.prefetch_depth;
+    ctx.window.clock = ev.request.request.clock;
+    ctx.window.adaptive = ev.request.request.adaptive_prefetch;
   }
 };
 
@@ -265,7 +270,8 @@ struct effect_record_bind_error {
 
 struct effect_begin_acquire_resolve {
   void operator()(const detail::acquire_resolve_runtime &ev,
-                  context &) const noexcept {
+                  context &ctx) const noexcept {
+    detail::record_compute_sample(ctx.window);
     ev.status.err = emel::error::cast(error::none);
     ev.status.ok = false;
     ev.status.slot_base = nullptr;
@@ -365,6 +371,7 @@ struct effect_commit_slot_load {
         ticket.layout->file_begin, ticket.layout->file_span,
         emel::io::mmap::event::advice::k_dontneed};
     (void)ctx.io_mmap->process_event(dontneed);
+    detail::record_load_sample(ctx.window, ticket);
   }
 };
 
@@ -380,6 +387,21 @@ struct effect_stage_acquire_result {
     ev.status.layout =
         &ctx.window.plan[static_cast<uint32_t>(ev.request.layer_index)];
     ev.status.ok = true;
+    detail::record_publish(ctx.window);
+  }
+};
+
+struct effect_retune_adaptive_prefetch {
+  void operator()(const detail::acquire_publish_runtime &,
+                  context &ctx) const noexcept {
+    detail::retune_adaptive_prefetch(ctx.window);
+  }
+};
+
+struct effect_hold_prefetch {
+  void operator()(const detail::acquire_publish_runtime &,
+                  context &ctx) const noexcept {
+    detail::hold_prefetch(ctx.window);
   }
 };
 
@@ -391,28 +413,37 @@ struct effect_mark_slot_copy_failed {
   }
 };
 
-// Ring advance: prefetch the layer prefetch_depth ahead (wrapping into the
-// next pass for a warm window across tokens) so its slot load overlaps the
-// caller's compute on the just-published layer. The prefetch-needed decision
-// is a guard (guard_prefetch_ahead_needed); this effect only executes it.
+// Ring advance step: prefetch the layer prefetch_cursor ahead (wrapping into
+// the next pass for a warm window across tokens) so its slot load overlaps
+// the caller's compute on the just-published layer, then move the cursor.
+// Whether the target needs a load is guard_prefetch_cursor_needed.
 struct effect_advance_window {
   void operator()(const detail::acquire_publish_runtime &ev,
                   context &ctx) const noexcept {
-    const int32_t ahead = ev.request.layer_index +
-                          static_cast<int32_t>(ctx.window.prefetch_depth);
-    const int32_t wrapped =
-        ahead % static_cast<int32_t>(ctx.window.layer_count);
-    bind_and_submit_layer_load(ctx, ev.scheduler, wrapped);
+    bind_and_submit_layer_load(
+        ctx, ev.scheduler,
+        detail::compute_ahead_layer(ctx.window, ev.request.layer_index,
+                                    ctx.window.prefetch_cursor));
+    ctx.window.prefetch_cursor += 1u;
+  }
+};
+
+struct effect_skip_prefetch_cursor {
+  void operator()(const detail::acquire_publish_runtime &,
+                  context &ctx) const noexcept {
+    ctx.window.prefetch_cursor += 1u;
   }
 };
 
 struct effect_publish_acquire_done {
   void operator()(const detail::acquire_publish_runtime &ev,
-                  context &) const noexcept {
+                  context &ctx) const noexcept {
     ev.request.on_done(events::acquire_layer_window_done{
         .request = ev.request,
         .slot_base = ev.status.slot_base,
         .layout = *ev.status.layout,
+        .prefetch_depth = ctx.window.prefetch_depth,
+        .stage_chunk_bytes = ctx.window.stage_chunk_bytes,
     });
   }
 };
@@ -645,7 +676,11 @@ inline constexpr effect_require_layer_completion effect_require_layer_completion
 inline constexpr effect_commit_slot_load effect_commit_slot_load{};
 inline constexpr effect_stage_acquire_result effect_stage_acquire_result{};
 inline constexpr effect_mark_slot_copy_failed effect_mark_slot_copy_failed{};
+inline constexpr effect_retune_adaptive_prefetch
+    effect_retune_adaptive_prefetch{};
+inline constexpr effect_hold_prefetch effect_hold_prefetch{};
 inline constexpr effect_advance_window effect_advance_window{};
+inline constexpr effect_skip_prefetch_cursor effect_skip_prefetch_cursor{};
 inline constexpr effect_publish_acquire_done effect_publish_acquire_done{};
 inline constexpr effect_record_acquire_done effect_record_acquire_done{};
 inline constexpr effect_publish_acquire_error effect_publish_acquire_error{};
@@ -0,0 +1,278 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+
+// Block codec for compressed streaming extents (see sidecar.hpp).
+//
+// An extent is cut into k_block_bytes blocks; each block is byte-plane
+// shuffled at the extent's stride (all byte 0s of every element, then all
+// byte 1s, ...) so the near-constant scale/exponent bytes of quantized blocks
+// line up into runs, then compressed with an LZ4-class byte-oriented LZ77:
+//   token (hi nibble literal length, lo nibble match length - 4), extended
+//   lengths as 255-runs, literals, 16-bit little-endian match offset.
+// Decoding is a bounded copy loop with no entropy stage, fast enough to run
+// on the stream I/O pool ahead of the slot publish.
+//
+// Block stream per extent: repeated [uint32 header][payload]. The header's
+// low 31 bits are the payload length; k_stored_flag marks a block kept
+// verbatim (unshuffled) because compression did not shrink it.
+namespace emel::model::tensor::window::codec {
+
+inline constexpr uint64_t k_block_bytes = 32u * 1024u;
+inline constexpr uint32_t k_stored_flag = 1u << 31u;
+inline constexpr uint32_t k_block_header_bytes = 4u;
+inline constexpr uint32_t k_min_match = 4u;
+inline constexpr uint32_t k_max_offset = 65535u;
+inline constexpr uint32_t k_hash_bits = 12u;
+
+using block_scratch = std::array<uint8_t, k_block_bytes>;
+
+inline void shuffle(const uint8_t *src, uint8_t *dst, const uint64_t bytes,
+                    const uint32_t stride) noexcept {
+  const uint64_t count = stride > 1u ? bytes / stride : 0u;
+  for (uint32_t plane = 0; plane < stride && count > 0u; ++plane) {
+    for (uint64_t element = 0; element < count; ++element) {
+      dst[plane * count + element] = src[element * stride + plane];
+    }
+  }
+  const uint64_t shuffled = count * stride;
+  std::memcpy(dst + shuffled, src + shuffled,
+              static_cast<size_t>(bytes - shuffled));
+}
+
+inline void unshuffle(const uint8_t *src, uint8_t *dst, const uint64_t bytes,
+                      const uint32_t stride) noexcept {
+  const uint64_t count = stride > 1u ? bytes / stride : 0u;
+  for (uint32_t plane = 0; plane < stride && count > 0u; ++plane) {
+    for (uint64_t element = 0; element < count; ++element) {
+      dst[element * stride + plane] = src[plane * count + element];
+    }
+  }
+  const uint64_t shuffled = count * stride;
+  std::memcpy(dst + shuffled, src + shuffled,
+              static_cast<size_t>(bytes - shuffled));
+}
+
+// Worst-case LZ output for `bytes` of input (all literals).
+inline constexpr uint64_t compress_bound(const uint64_t bytes) noexcept {
+  return bytes + bytes / 255u + 16u;
+}
+
+namespace detail {
+
+inline uint32_t read_u32(const uint8_t *src) noexcept {
+  uint32_t value = 0u;
+  std::memcpy(&value, src, sizeof(value));
+  return value;
+}
+
+inline uint32_t hash_u32(const uint32_t value) noexcept {
+  return (value * 2654435761u) >> (32u - k_hash_bits);
+}
+
+inline uint8_t *write_length(uint8_t *out, uint64_t remainder) noexcept {
+  while (remainder >= 255u) {
+    *out++ = 255u;
+    remainder -= 255u;
+  }
+  *out++ = static_cast<uint8_t>(remainder);
+  return out;
+}
+
+inline uint8_t *write_sequence(uint8_t *out, const uint8_t *literals,
+                               const uint64_t literal_bytes,
+                               const uint32_t offset,
+                               const uint64_t match_bytes) noexcept {
+  const uint64_t match_code = match_bytes > 0u ? match_bytes - k_min_match : 0u;
+  uint8_t *token = out++;
+  *token = static_cast<uint8_t>(
+      ((literal_bytes < 15u ? literal_bytes : 15u) << 4u) |
+      (match_code < 15u ? match_code : 15u));
+  if (literal_bytes >= 15u) {
+    out = write_length(out, literal_bytes - 15u);
+  }
+  std::memcpy(out, literals, static_cast<size_t>(literal_bytes));
+  out += literal_bytes;
+  if (match_bytes == 0u) {
+    return out;
+  }
+  *out++ = static_cast<uint8_t>(offset & 0xffu);
+  *out++ = static_cast<uint8_t>(offset >> 8u);
+  if (match_code >= 15u) {
+    out = write_length(out, match_code - 15u);
+  }
+  return out;
+}
+
+inline bool read_length(const uint8_t *src, const uint64_t src_bytes,
+                        uint64_t &cursor, uint64_t &length) noexcept {
+  uint8_t next = 255u;
+  while (next == 255u) {
+    if (cursor >= src_bytes) {
+      return false;
+    }
+    next = src[cursor++];
+    length += next;
+  }
+  return true;
+}
+
+}  // namespace detail
+
+// Greedy single-probe LZ77. `out` must hold compress_bound(bytes). Returns
+// the compressed length.
+inline uint64_t compress(const uint8_t *src, const uint64_t bytes,
+                         uint8_t *out) noexcept {
+  std::array<uint32_t, 1u << k_hash_bits> table{};
+  uint8_t *const out_begin = out;
+  uint64_t anchor = 0u;
+  uint64_t cursor = 0u;
+  while (cursor + k_min_match <= bytes) {
+    const uint32_t word = detail::read_u32(src + cursor);
+    uint32_t &bucket = table[detail::hash_u32(word)];
+    const uint64_t candidate = bucket;
+    bucket = static_cast<uint32_t>(cursor + 1u);
+    if (candidate == 0u || cursor + 1u - candidate > k_max_offset ||
+        detail::read_u32(src + candidate - 1u) != word) {
+      cursor += 1u;
+      continue;
+    }
+    const uint64_t match_begin = candidate - 1u;
+    uint64_t match_bytes = k_min_match;
+    while (cursor + match_bytes < bytes &&
+           src[match_begin + match_bytes] == src[cursor + match_bytes]) {
+      match_bytes += 1u;
+    }
+    out = detail::write_sequence(out, src + anchor, cursor - anchor,
+                                 static_cast<uint32_t>(cursor - match_begin),
+                                 match_bytes);
+    cursor += match_bytes;
+    anchor = cursor;
+  }
+  out = detail::write_sequence(out, src + anchor, bytes - anchor, 0u, 0u);
+  return static_cast<uint64_t>(out - out_begin);
+}
+
+// Bounds-checked decode: fails on any malformed sequence and unless the
+// stream produces exactly dst_bytes.
+inline bool decompress(const uint8_t *src, const uint64_t src_bytes,
+                       uint8_t *dst, const uint64_t dst_bytes) noexcept {
+  uint64_t in = 0u;
+  uint64_t out = 0u;
+  while (in < src_bytes) {
+    const uint8_t token = src[in++];
+    uint64_t literal_bytes = token >> 4u;
+    if (literal_bytes == 15u &&
+        !detail::read_length(src, src_bytes, in, literal_bytes)) {
+      return false;
+    }
+    if (literal_bytes > src_bytes - in || literal_bytes > dst_bytes - out) {
+      return false;
+    }
+    std::memcpy(dst + out, src + in, static_cast<size_t>(literal_bytes));
+    in += literal_bytes;
+    out += literal_bytes;
+    if (in == src_bytes) {
+      break;
+    }
+    if (src_bytes - in < 2u) {
+      return false;
+    }
+    const uint64_t offset =
+        static_cast<uint64_t>(src[in]) | (static_cast<uint64_t>(src[in + 1u]) << 8u);
+    in += 2u;
+    uint64_t match_bytes = token & 0x0fu;
+    if (match_bytes == 15u &&
+        !detail::read_length(src, src_bytes, in, match_bytes)) {
+      return false;
+    }
+    match_bytes += k_min_match;
+    if (offset == 0u || offset > out || match_bytes > dst_bytes - out) {
+      return false;
+    }
+    // Overlapping matches replicate runs, so copy forward byte by byte.
+    const uint8_t *from = dst + out - offset;
+    for (uint64_t index = 0; index < match_bytes; ++index) {
+      dst[out + index] = from[index];
+    }
+    out += match_bytes;
+  }
+  return out == dst_bytes;
+}
+
+inline uint64_t block_count(const uint64_t bytes) noexcept {
+  return (bytes + k_block_bytes - 1u) / k_block_bytes;
+}
+
+// Worst-case block stream for an extent of `bytes`.
+inline uint64_t stream_bound(const uint64_t bytes) noexcept {
+  return block_count(bytes) *
+             (k_block_header_bytes + compress_bound(k_block_bytes)) +
+         k_block_header_bytes;
+}
+
+// Encodes one extent into `out` (stream_bound(bytes) long). Returns the
+// stream length.
+inline uint64_t encode_stream(const uint8_t *src, const uint64_t bytes,
+                              const uint32_t stride, uint8_t *out,
+                              block_scratch &scratch) noexcept {
+  uint64_t written = 0u;
+  for (uint64_t begin = 0; begin < bytes; begin += k_block_bytes) {
+    const uint64_t block = bytes - begin < k_block_bytes ? bytes - begin
+                                                         : k_block_bytes;
+    shuffle(src + begin, scratch.data(), block, stride);
+    uint8_t *payload = out + written + k_block_header_bytes;
+    uint64_t payload_bytes = compress(scratch.data(), block, payload);
+    uint32_t header = static_cast<uint32_t>(payload_bytes);
+    if (payload_bytes >= block) {
+      std::memcpy(payload, src + begin, static_cast<size_t>(block));
+      payload_bytes = block;
+      header = static_cast<uint32_t>(block) | k_stored_flag;
+    }
+    std::memcpy(out + written, &header, sizeof(header));
+    written += k_block_header_bytes + payload_bytes;
+  }
+  return written;
+}
+
+// Decodes an extent's block stream into dst; the scratch block holds the
+// shuffled planes between the LZ decode and the unshuffle.
+inline bool decode_stream(const uint8_t *src, const uint64_t src_bytes,
+                          uint8_t *dst, const uint64_t dst_bytes,
+                          const uint32_t stride,
+                          block_scratch &scratch) noexcept {
+  uint64_t in = 0u;
+  for (uint64_t begin = 0; begin < dst_bytes; begin += k_block_bytes) {
+    const uint64_t block = dst_bytes - begin < k_block_bytes
+                               ? dst_bytes - begin
+                               : k_block_bytes;
+    if (src_bytes - in < k_block_header_bytes) {
+      return false;
+    }
+    uint32_t header = 0u;
+    std::memcpy(&header, src + in, sizeof(header));
+    in += k_block_header_bytes;
+    const uint64_t payload_bytes = header & ~k_stored_flag;
+    if (payload_bytes > src_bytes - in) {
+      return false;
+    }
+    if ((header & k_stored_flag) != 0u) {
+      if (payload_bytes != block) {
+        return false;
+      }
+      std::memcpy(dst + begin, src + in, static_cast<size_t>(block));
+    } else {
+      if (!decompress(src + in, payload_bytes, scratch.data(), block)) {
+        return false;
+      }
+      unshuffle(scratch.data(), dst + begin, block, stride);
+    }
+    in += payload_bytes;
+  }
+  return in == src_bytes;
+}
+
+}  // namespace emel::model::tensor::window::codec
@@ -6,11 +6,14 @@
 #include <span>
 #include <string_view>
 
+#include "emel/clock.hpp"
 #include "emel/io/mmap/errors.hpp"
 #include "emel/io/staged_read/events.hpp"
 #include "emel/io/staged_read/sm.hpp"
+#include "emel/model/tensor/window/codec.hpp"
 #include "emel/model/tensor/window/errors.hpp"
 #include "emel/sm.hpp"
+#include "emel/trace.hpp"
 
 namespace emel::model::tensor::window::detail {
 
@@ -23,19 +26,45 @@ inline constexpr uint64_t k_default_stream_chunk_bytes = 8u * 1024u * 1024u;
 inline constexpr uint64_t k_max_stream_chunk_bytes = 16u * 1024u * 1024u;
 inline constexpr uint64_t k_slot_alignment_bytes = 64u;
 inline constexpr int32_t k_stream_source_tensor_id = -2;
+// Adaptive prefetch: samples blend into the running estimate with weight
+// 1/2^k_tuning_ewma_shift, and the staged chunk targets this many
+// nanoseconds of copy time so large chunks only follow fast sources.
+inline constexpr uint32_t k_tuning_ewma_shift = 2u;
+inline constexpr uint64_t k_target_chunk_copy_ns = 2u * 1000u * 1000u;
+inline constexpr uint64_t k_ns_per_second = 1000u * 1000u * 1000u;
+
+// The owner's clock (emel/clock.hpp) must be callable from the I/O pool
+// workers.
+using emel::clock_fn;
 
 using stream_io_pool = emel::policy::thread_pool_scheduler<k_stream_io_lanes, 16u, 128u>;
 using stream_scheduler = emel::policy::external_completion_scheduler<k_max_window_slots>;
 
+enum class extent_codec : uint8_t {
+  raw = 0,
+  shuffled_lz = 1,
+};
+
 // One contiguous weight span inside the model file, placed at slot_offset
-// within its layer's window slot.
+// within its layer's window slot. A compressed extent (bound from a
+// streaming sidecar, see sidecar.hpp) stores a codec block stream of
+// stored_bytes at file_offset; byte_size stays the decoded slot length.
 struct weight_extent {
   int32_t tensor_id = -1;
   uint64_t file_offset = 0u;
   uint64_t byte_size = 0u;
   uint64_t slot_offset = 0u;
+  uint64_t stored_bytes = 0u;
+  uint32_t shuffle_stride = 1u;
+  extent_codec codec = extent_codec::raw;
 };
 
+// Bytes the extent occupies in the bound source file.
+inline uint64_t compute_stored_bytes(const weight_extent &extent) noexcept {
+  return extent.codec == extent_codec::raw ? extent.byte_size
+                                           : extent.stored_bytes;
+}
+
 struct layer_descriptor {
   std::array<weight_extent, k_max_weights_per_layer> weights = {};
   uint32_t weight_count = 0u;
@@ -61,7 +90,14 @@ struct load_ticket {
   uint64_t source_bytes = 0u;
   uint8_t *slot_base = nullptr;
   uint64_t stage_chunk_bytes = 0u;
+  clock_fn clock = nullptr;
   bool ok = false;
+  // Copy wall time for this load (zero without a clock); read by the commit
+  // under the same release/acquire pairing as ok.
+  uint64_t load_ns = 0u;
+  // Shuffled planes of the block being decoded; one per ticket keeps the
+  // slot-affine single-writer rule for compressed loads too.
+  codec::block_scratch scratch = {};
 
   // staged_read requires both callbacks; the ticket reads the dispatch's
   // synchronous bool result, so these only satisfy the contract.
@@ -71,11 +107,25 @@ struct load_ticket {
       void *, const emel::io::staged_read::events::staged_window_error &) noexcept {}
 
   // Runs on an I/O pool worker (or inline on submit rejection): one staged
-  // chunked copy per weight extent, monotonic bounded data-plane iteration.
+  // chunked copy per raw weight extent, or a block decode straight into the
+  // slot for a compressed one, so decompression overlaps the caller's
+  // compute like the copy does. Monotonic bounded data-plane iteration.
   void run() noexcept {
+    const emel::trace::span traced{emel::trace::category::io,
+                                   "window/slot_load"};
+    const uint64_t started_ns = clock != nullptr ? clock() : 0u;
     bool all_ok = true;
     for (uint32_t index = 0; index < layout->weight_count; ++index) {
       const weight_extent &extent = layout->weights[index];
+      if (extent.codec != extent_codec::raw) {
+        all_ok = codec::decode_stream(
+                     static_cast<const uint8_t *>(source_base) +
+                         extent.file_offset,
+                     extent.stored_bytes, slot_base + extent.slot_offset,
+                     extent.byte_size, extent.shuffle_stride, scratch) &&
+                 all_ok;
+        continue;
+      }
       // staged_read's single-window contract copies from the span start and
       // requires an exact-size span: pre-position it at the extent and clamp
       // the chunk to the logical length for small extents.
@@ -97,6 +147,7 @@ struct load_ticket {
       copy.on_error = {nullptr, &load_ticket::on_copy_error};
       all_ok = io_staged->process_event(copy) && all_ok;
     }
+    load_ns = clock != nullptr ? clock() - started_ns : 0u;
     ok = all_ok;
   }
 
@@ -132,6 +183,24 @@ struct window_state {
   int32_t next_prefetch_layer = -1;
   bool streaming_active = false;
   bool bound = false;
+
+  // Adaptive prefetch (bind_window_request::adaptive_prefetch): running
+  // estimates of the caller's per-layer compute time (publish to next
+  // acquire) and of slot-load copy time/bytes, from which
+  // retune_adaptive_prefetch picks prefetch_depth and stage_chunk_bytes after
+  // every publish. prefetch_cursor is the next ahead distance the ring advance
+  // examines, one guarded step per distance up to prefetch_depth: a deeper
+  // retune starts it at the previous depth so growing the lookahead leaves no
+  // unloaded gap.
+  clock_fn clock = nullptr;
+  bool adaptive = false;
+  uint32_t prefetch_cursor = 0u;
+  uint64_t last_publish_ns = 0u;
+  uint64_t compute_ns_estimate = 0u;
+  uint64_t load_ns_estimate = 0u;
+  uint64_t load_bytes_estimate = 0u;
+  uint32_t compute_samples = 0u;
+  uint32_t load_samples = 0u;
 };
 
 inline uint32_t compute_slot_for_layer(const window_state &window,
@@ -165,7 +234,8 @@ inline void scan_layer_descriptors(
       extent.slot_offset = slot_offset;
       slot_offset += compute_aligned_bytes(extent.byte_size);
       file_begin = extent.file_offset < file_begin ? extent.file_offset : file_begin;
-      const uint64_t extent_end = extent.file_offset + extent.byte_size;
+      const uint64_t extent_end =
+          extent.file_offset + compute_stored_bytes(extent);
       file_end = extent_end > file_end ? extent_end : file_end;
       layout.weights[index] = extent;
     }
@@ -185,6 +255,114 @@ inline uint64_t compute_total_stream_bytes(const window_state &window) noexcept
   return total;
 }
 
+// Ahead layer at `distance` from `layer`, wrapping into the next pass.
+inline int32_t compute_ahead_layer(const window_state &window,
+                                   const int32_t layer,
+                                   const uint32_t distance) noexcept {
+  return (layer + static_cast<int32_t>(distance)) %
+         static_cast<int32_t>(window.layer_count);
+}
+
+// Whether the ring advance after publishing `layer` must submit the ahead
+// layer at `distance`. Never targets the just-published layer's slot (the
+// caller reads that view until its next acquire), nor a slot already holding
+// or loading the target.
+inline bool prefetch_target_needed(const window_state &window,
+                                   const int32_t layer,
+                                   const uint32_t distance) noexcept {
+  const int32_t target = compute_ahead_layer(window, layer, distance);
+  const uint32_t target_slot = compute_slot_for_layer(window, target);
+  if (target_slot == compute_slot_for_layer(window, layer)) {
+    return false;
+  }
+  const window_slot &slot = window.slots[target_slot];
+  return slot.layer != target && slot.lifecycle != slot_lifecycle::loading;
+}
+
+inline uint64_t blend_estimate(const uint64_t estimate, const uint64_t sample,
+                               const uint32_t samples) noexcept {
+  if (samples == 0u) {
+    return sample;
+  }
+  return estimate - (estimate >> k_tuning_ewma_shift) +
+         (sample >> k_tuning_ewma_shift);
+}
+
+// Completion-side sample: one committed slot load's copy time and bytes.
+inline void record_load_sample(window_state &window,
+                               const load_ticket &ticket) noexcept {
+  if (window.clock == nullptr || !ticket.ok) {
+    return;
+  }
+  window.load_ns_estimate =
+      blend_estimate(window.load_ns_estimate, ticket.load_ns, window.load_samples);
+  window.load_bytes_estimate = blend_estimate(
+      window.load_bytes_estimate, ticket.layout->slot_bytes, window.load_samples);
+  window.load_samples += 1u;
+}
+
+// Acquire-side sample: time the caller spent computing on the previously
+// published layer. The first acquire of a bind has no predecessor.
+inline void record_compute_sample(window_state &window) noexcept {
+  if (window.clock == nullptr || window.last_publish_ns == 0u) {
+    return;
+  }
+  const uint64_t now_ns = window.clock();
+  window.compute_ns_estimate =
+      blend_estimate(window.compute_ns_estimate, now_ns - window.last_publish_ns,
+                     window.compute_samples);
+  window.compute_samples += 1u;
+}
+
+inline void record_publish(window_state &window) noexcept {
+  window.last_publish_ns = window.clock != nullptr ? window.clock() : 0u;
+}
+
+// Largest power-of-two chunk in [min, max] copied within the target time at
+// the observed bandwidth.
+inline uint64_t select_stage_chunk_bytes(const uint64_t bytes_per_second) noexcept {
+  const uint64_t wanted =
+      bytes_per_second / (k_ns_per_second / k_target_chunk_copy_ns);
+  uint64_t chunk = k_min_stream_chunk_bytes;
+  while (chunk < k_max_stream_chunk_bytes && chunk * 2u <= wanted) {
+    chunk *= 2u;
+  }
+  return chunk;
+}
+
+// Lookahead must cover one slot load with the caller's compute: a load that
+// takes n layers of compute needs n layers in flight plus the one being
+// consumed. The ring invariant caps the depth at slot_count - 1.
+inline uint32_t select_prefetch_depth(const window_state &window) noexcept {
+  const uint64_t compute_ns =
+      window.compute_ns_estimate > 0u ? window.compute_ns_estimate : 1u;
+  const uint64_t layers_per_load =
+      (window.load_ns_estimate + compute_ns - 1u) / compute_ns;
+  const uint64_t depth = layers_per_load + 1u;
+  const uint64_t max_depth = window.slot_count - 1u;
+  return static_cast<uint32_t>(depth < max_depth ? depth : max_depth);
+}
+
+// Adaptive publish with both estimates sampled: re-select depth and chunk,
+// and start the ring advance at the shallower of the old and new depths.
+inline void retune_adaptive_prefetch(window_state &window) noexcept {
+  const uint32_t previous_depth = window.prefetch_depth;
+  window.prefetch_depth = select_prefetch_depth(window);
+  const uint64_t load_ns =
+      window.load_ns_estimate > 0u ? window.load_ns_estimate : 1u;
+  window.stage_chunk_bytes = select_stage_chunk_bytes(
+      window.load_bytes_estimate * k_ns_per_second / load_ns);
+  window.prefetch_cursor = previous_depth < window.prefetch_depth
+                               ? previous_depth
+                               : window.prefetch_depth;
+}
+
+// Fixed mode (or adaptive before its first samples) keeps the bound
+// configuration and only covers the single prefetch_depth distance.
+inline void hold_prefetch(window_state &window) noexcept {
+  window.prefetch_cursor = window.prefetch_depth;
+}
+
 } // namespace emel::model::tensor::window::detail
 
 namespace emel::model::tensor::window::event {
@@ -282,6 +460,15 @@ inline void reset_window(window_state &window) noexcept {
   window.next_prefetch_layer = -1;
   window.streaming_active = false;
   window.bound = false;
+  window.clock = nullptr;
+  window.adaptive = false;
+  window.prefetch_cursor = 0u;
+  window.last_publish_ns = 0u;
+  window.compute_ns_estimate = 0u;
+  window.load_ns_estimate = 0u;
+  window.load_bytes_estimate = 0u;
+  window.compute_samples = 0u;
+  window.load_samples = 0u;
 }
 
 } // namespace emel::model::tensor::window::detail
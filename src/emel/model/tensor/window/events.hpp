@@ -45,6 +45,14 @@ struct bind_window_request {
   uint32_t window_slots = 0u;
   uint32_t prefetch_depth = 0u;
   uint64_t stage_chunk_bytes = detail::k_default_stream_chunk_bytes;
+  // Adaptive mode treats prefetch_depth and stage_chunk_bytes as starting
+  // points: every publish re-picks the lookahead (within [1, window_slots))
+  // from the measured per-layer compute time against slot-load copy time,
+  // and the staged chunk from the observed copy bandwidth. Both the
+  // measurements and adaptive mode need the owner clock; a clock alone only
+  // feeds the estimates.
+  bool adaptive_prefetch = false;
+  detail::clock_fn clock = nullptr;
 };
 
 struct bind_window {
@@ -95,6 +103,9 @@ struct acquire_layer_window_done {
   const event::acquire_layer_window &request;
   const uint8_t *slot_base = nullptr;
   const detail::layer_descriptor &layout;
+  // Lookahead and staged chunk in effect for the next ring advance.
+  uint32_t prefetch_depth = 0u;
+  uint64_t stage_chunk_bytes = 0u;
 };
 
 struct acquire_layer_window_error {
@@ -43,10 +43,15 @@ struct guard_bind_request_valid {
     // Every extent must lie inside the mapped source: load_ticket forms
     // source_base + file_offset for the staged copy, so an extent past
     // file_size_bytes (or one that overflows) would read beyond the mmap.
+    // Compressed extents are bounded by their stored block stream and need a
+    // shuffle stride the codec can walk.
     for (const detail::weight_extent &extent : request.extents) {
-      if (extent.byte_size == 0u ||
-          extent.byte_size > request.file_size_bytes ||
-          extent.file_offset > request.file_size_bytes - extent.byte_size) {
+      const uint64_t stored = detail::compute_stored_bytes(extent);
+      if (extent.byte_size == 0u || stored == 0u ||
+          stored > request.file_size_bytes ||
+          extent.file_offset > request.file_size_bytes - stored ||
+          extent.shuffle_stride == 0u ||
+          extent.codec > detail::extent_codec::shuffled_lz) {
         return false;
       }
     }
@@ -95,13 +100,15 @@ struct guard_bind_streaming_config_valid {
     const event::bind_window_request &request = ev.request.request;
     // A sized-but-null staged span is an owner misconfiguration: the prime
     // would index a null child actor from an I/O worker, so it must reject
-    // here as a modeled bind failure instead.
+    // here as a modeled bind failure instead. Adaptive prefetch measures
+    // through the owner clock, so it cannot bind without one.
     return request.window_slots >= 2u &&
            request.window_slots <= detail::k_max_window_slots &&
            request.prefetch_depth > 0u &&
            request.prefetch_depth < request.window_slots &&
            ctx.io_staged.data() != nullptr &&
-           ctx.io_staged.size() >= request.window_slots;
+           ctx.io_staged.size() >= request.window_slots &&
+           (!request.adaptive_prefetch || request.clock != nullptr);
   }
 };
 
@@ -435,33 +442,51 @@ struct guard_acquire_copy_failed {
   }
 };
 
-// Ring advance: the layer prefetch_depth ahead (wrapping into the next pass)
-// still needs a load submitted for its slot. Never target the just-published
-// layer's slot — the caller is reading that view until its next acquire, and
-// the pass wrap can alias them when layer_count % slot_count != 0.
-struct guard_prefetch_ahead_needed {
+// Publish retune: adaptive windows re-select depth and chunk once both the
+// compute and load estimates hold a sample; otherwise the bound
+// configuration stands.
+struct guard_prefetch_retune_ready {
+  bool operator()(const detail::acquire_publish_runtime &,
+                  const action::context &ctx) const noexcept {
+    return ctx.window.adaptive && ctx.window.compute_samples > 0u &&
+           ctx.window.load_samples > 0u;
+  }
+};
+
+struct guard_prefetch_retune_held {
   bool operator()(const detail::acquire_publish_runtime &ev,
                   const action::context &ctx) const noexcept {
-    const int32_t ahead = ev.request.layer_index +
-                          static_cast<int32_t>(ctx.window.prefetch_depth);
-    const int32_t wrapped =
-        ahead % static_cast<int32_t>(ctx.window.layer_count);
-    const uint32_t target_slot = detail::compute_slot_for_layer(ctx.window, wrapped);
-    const uint32_t published_slot =
-        detail::compute_slot_for_layer(ctx.window, ev.request.layer_index);
-    if (target_slot == published_slot) {
-      return false;
-    }
-    const detail::window_slot &slot = ctx.window.slots[target_slot];
-    return slot.layer != wrapped &&
-           slot.lifecycle != detail::slot_lifecycle::loading;
+    return !guard_prefetch_retune_ready{}(ev, ctx);
+  }
+};
+
+// Ring advance: one step per ahead distance from prefetch_cursor through
+// prefetch_depth. A step submits when the layer that far ahead (wrapping into
+// the next pass) still needs a load for its slot. Never target the
+// just-published layer's slot — the caller is reading that view until its
+// next acquire, and the pass wrap can alias them when
+// layer_count % slot_count != 0.
+struct guard_prefetch_cursor_exhausted {
+  bool operator()(const detail::acquire_publish_runtime &,
+                  const action::context &ctx) const noexcept {
+    return ctx.window.prefetch_cursor > ctx.window.prefetch_depth;
+  }
+};
+
+struct guard_prefetch_cursor_needed {
+  bool operator()(const detail::acquire_publish_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return !guard_prefetch_cursor_exhausted{}(ev, ctx) &&
+           detail::prefetch_target_needed(ctx.window, ev.request.layer_index,
+                                          ctx.window.prefetch_cursor);
   }
 };
 
-struct guard_prefetch_ahead_not_needed {
+struct guard_prefetch_cursor_not_needed {
   bool operator()(const detail::acquire_publish_runtime &ev,
                   const action::context &ctx) const noexcept {
-    return !guard_prefetch_ahead_needed{}(ev, ctx);
+    return !guard_prefetch_cursor_exhausted{}(ev, ctx) &&
+           !guard_prefetch_cursor_needed{}(ev, ctx);
   }
 };
 
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+
+#include "emel/model/fingerprint.hpp"
+#include "emel/model/tensor/window/codec.hpp"
+#include "emel/model/tensor/window/detail.hpp"
+
+// Streaming sidecar: the streamed layer weights of a model file re-encoded as
+// per-extent codec block streams (codec.hpp), so a streamed decode reads
+// fewer bytes per token from disk or a network filesystem.
+//
+// Image layout (little-endian, host struct layout):
+//   header | entry[extent_count] | payload (block streams, k_payload_alignment)
+//
+// Entries follow the bind's flattened extent order. The owner writes the
+// image once from the mapped model file, persists it, and on later runs binds
+// the window to the sidecar file with the extents open() rewrote; pinned
+// (non-streamed) tensors keep coming from the model file itself. The header
+// carries the model fingerprint (emel/model/fingerprint.hpp) and each entry a
+// source probe of its raw extent, so a re-quantized model with the same
+// extent table still misses. A sidecar that does not match leaves the extents
+// untouched, so binding falls back to the raw model file.
+namespace emel::model::tensor::window::sidecar {
+
+inline constexpr uint32_t k_magic = 0x43535745u;  // "EWSC"
+inline constexpr uint32_t k_layout_version = 2u;
+inline constexpr uint64_t k_payload_alignment = 64u;
+
+struct header {
+  uint32_t magic = k_magic;
+  uint32_t layout_version = k_layout_version;
+  uint32_t extent_count = 0u;
+  uint32_t block_bytes = static_cast<uint32_t>(codec::k_block_bytes);
+  uint64_t model_fingerprint = 0u;
+  uint64_t image_bytes = 0u;
+};
+
+struct entry {
+  int32_t tensor_id = -1;
+  uint32_t shuffle_stride = 1u;
+  uint64_t source_file_offset = 0u;
+  uint64_t byte_size = 0u;
+  uint64_t source_probe = 0u;
+  uint64_t packed_offset = 0u;
+  uint64_t packed_bytes = 0u;
+};
+
+inline uint64_t align_payload(const uint64_t offset) noexcept {
+  return (offset + k_payload_alignment - 1u) & ~(k_payload_alignment - 1u);
+}
+
+inline uint64_t payload_begin(const uint64_t extent_count) noexcept {
+  return align_payload(sizeof(header) + extent_count * sizeof(entry));
+}
+
+// Scratch size write_image() needs: every stream at its worst case.
+inline uint64_t image_bytes_bound(
+    const std::span<const detail::weight_extent> extents) noexcept {
+  uint64_t bytes = payload_begin(extents.size());
+  for (const detail::weight_extent &extent : extents) {
+    bytes = align_payload(bytes) + codec::stream_bound(extent.byte_size);
+  }
+  return bytes;
+}
+
+inline bool extent_in_source(const std::span<const uint8_t> source,
+                             const detail::weight_extent &extent) noexcept {
+  return extent.byte_size <= source.size() &&
+         extent.file_offset <= source.size() - extent.byte_size;
+}
+
+inline uint64_t extent_probe(const std::span<const uint8_t> source,
+                             const detail::weight_extent &extent) noexcept {
+  return emel::model::source_probe(source.data() + extent.file_offset,
+                                   extent.byte_size);
+}
+
+// Encodes every raw extent read from `source` (the mapped model file whose
+// emel::model::model_fingerprint() is `model_fingerprint`). shuffle_strides is
+// parallel to extents (the element width to de-interleave, e.g. the quantized
+// block size); an empty span shuffles nothing. Returns the image length, or 0
+// when the inputs do not fit.
+inline uint64_t write_image(const std::span<const uint8_t> source,
+                            const std::span<const detail::weight_extent> extents,
+                            const std::span<const uint32_t> shuffle_strides,
+                            const uint64_t model_fingerprint,
+                            const std::span<uint8_t> out) noexcept {
+  if (extents.empty() || out.size() < image_bytes_bound(extents) ||
+      (!shuffle_strides.empty() && shuffle_strides.size() != extents.size())) {
+    return 0u;
+  }
+  codec::block_scratch scratch{};
+  std::memset(out.data(), 0, static_cast<size_t>(payload_begin(extents.size())));
+  uint64_t offset = payload_begin(extents.size());
+  for (size_t index = 0; index < extents.size(); ++index) {
+    const detail::weight_extent &extent = extents[index];
+    const uint32_t stride =
+        shuffle_strides.empty() ? 1u : shuffle_strides[index];
+    if (extent.codec != detail::extent_codec::raw || stride == 0u ||
+        extent.byte_size == 0u || !extent_in_source(source, extent)) {
+      return 0u;
+    }
+    const uint64_t aligned = align_payload(offset);
+    std::memset(out.data() + offset, 0, static_cast<size_t>(aligned - offset));
+    offset = aligned;
+    const uint64_t packed_bytes = codec::encode_stream(
+        source.data() + extent.file_offset, extent.byte_size, stride,
+        out.data() + offset, scratch);
+    const entry row{
+        .tensor_id = extent.tensor_id,
+        .shuffle_stride = stride,
+        .source_file_offset = extent.file_offset,
+        .byte_size = extent.byte_size,
+        .source_probe = extent_probe(source, extent),
+        .packed_offset = offset,
+        .packed_bytes = packed_bytes,
+    };
+    std::memcpy(out.data() + sizeof(header) + index * sizeof(entry), &row,
+                sizeof(row));
+    offset += packed_bytes;
+  }
+  const header head{
+      .magic = k_magic,
+      .layout_version = k_layout_version,
+      .extent_count = static_cast<uint32_t>(extents.size()),
+      .block_bytes = static_cast<uint32_t>(codec::k_block_bytes),
+      .model_fingerprint = model_fingerprint,
+      .image_bytes = offset,
+  };
+  std::memcpy(out.data(), &head, sizeof(head));
+  return offset;
+}
+
+// Validates the image against the model fingerprint and the bind's raw
+// extents (including a source probe of each extent in the mapped model file)
+// and, only when every entry matches, rewrites them to the compressed streams
+// inside the image. Returns whether the extents now address the sidecar.
+inline bool open(const std::span<const uint8_t> image,
+                 const std::span<const uint8_t> source,
+                 const uint64_t model_fingerprint,
+                 const std::span<detail::weight_extent> extents) noexcept {
+  if (image.size() < sizeof(header) ||
+      (reinterpret_cast<uintptr_t>(image.data()) % alignof(entry)) != 0u) {
+    return false;
+  }
+  header head = {};
+  std::memcpy(&head, image.data(), sizeof(head));
+  if (head.magic != k_magic || head.layout_version != k_layout_version ||
+      head.block_bytes != codec::k_block_bytes ||
+      head.model_fingerprint != model_fingerprint ||
+      head.extent_count != extents.size() || head.image_bytes != image.size() ||
+      payload_begin(head.extent_count) > image.size()) {
+    return false;
+  }
+  const auto *rows =
+      reinterpret_cast<const entry *>(image.data() + sizeof(header));
+  for (size_t index = 0; index < extents.size(); ++index) {
+    const entry &row = rows[index];
+    const detail::weight_extent &extent = extents[index];
+    if (extent.codec != detail::extent_codec::raw ||
+        row.tensor_id != extent.tensor_id ||
+        row.source_file_offset != extent.file_offset ||
+        row.byte_size != extent.byte_size || row.shuffle_stride == 0u ||
+        !extent_in_source(source, extent) ||
+        row.source_probe != extent_probe(source, extent) ||
+        row.packed_offset < payload_begin(head.extent_count) ||
+        row.packed_bytes == 0u || row.packed_bytes > image.size() ||
+        row.packed_offset > image.size() - row.packed_bytes) {
+      return false;
+    }
+  }
+  for (size_t index = 0; index < extents.size(); ++index) {
+    const entry &row = rows[index];
+    detail::weight_extent &extent = extents[index];
+    extent.file_offset = row.packed_offset;
+    extent.stored_bytes = row.packed_bytes;
+    extent.shuffle_stride = row.shuffle_stride;
+    extent.codec = detail::extent_codec::shuffled_lz;
+  }
+  return true;
+}
+
+}  // namespace emel::model::tensor::window::sidecar
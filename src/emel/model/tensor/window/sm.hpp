@@ -32,7 +32,8 @@
 //
 // Invariants: slot_for(layer) = layer % slot_count with prefetch_depth <
 // slot_count means sequential acquire never lands on a slot mid-load for a
-// different layer; unbind requires every loading slot so the drain joins all
+// different layer (adaptive retunes keep prefetch_depth inside
+// [1, slot_count)); unbind requires every loading slot so the drain joins all
 // in-flight copies before teardown; completion source index == slot index.
 
 #include "emel/model/tensor/window/actions.hpp"
@@ -59,7 +60,9 @@ struct state_acquire_decision {};
 struct state_acquire_pending {};
 struct state_passthrough_acquire_resolved {};
 struct state_acquire_publish_decision {};
+struct state_acquire_retune_decision {};
 struct state_acquire_advance_decision {};
+struct state_acquire_advance_step {};
 struct state_acquire_publish_ready {};
 struct state_acquire_done_callback {};
 struct state_acquire_error_ready {};
@@ -246,7 +249,7 @@ struct model {
       , sml::state<state_acquire_publish_decision> <=
           sml::state<state_acquire_pending>
           + sml::event<detail::acquire_publish_runtime>
-      , sml::state<state_acquire_advance_decision> <=
+      , sml::state<state_acquire_retune_decision> <=
           sml::state<state_acquire_publish_decision>
           + sml::completion<detail::acquire_publish_runtime>
           [ guard::guard_acquire_result_ready{} ]
@@ -260,15 +263,35 @@ struct model {
           + sml::completion<detail::acquire_publish_runtime>
           [ guard::guard_acquire_copy_failed{} ]
           / action::effect_mark_slot_copy_failed
-      , sml::state<state_acquire_publish_ready> <=
+      , sml::state<state_acquire_advance_decision> <=
+          sml::state<state_acquire_retune_decision>
+          + sml::completion<detail::acquire_publish_runtime>
+          [ guard::guard_prefetch_retune_ready{} ]
+          / action::effect_retune_adaptive_prefetch
+      , sml::state<state_acquire_advance_decision> <=
+          sml::state<state_acquire_retune_decision>
+          + sml::completion<detail::acquire_publish_runtime>
+          [ guard::guard_prefetch_retune_held{} ]
+          / action::effect_hold_prefetch
+      // Ring advance: one guarded step per ahead distance until the cursor
+      // passes prefetch_depth.
+      , sml::state<state_acquire_advance_step> <=
           sml::state<state_acquire_advance_decision>
           + sml::completion<detail::acquire_publish_runtime>
-          [ guard::guard_prefetch_ahead_needed{} ]
+          [ guard::guard_prefetch_cursor_needed{} ]
           / action::effect_advance_window
+      , sml::state<state_acquire_advance_step> <=
+          sml::state<state_acquire_advance_decision>
+          + sml::completion<detail::acquire_publish_runtime>
+          [ guard::guard_prefetch_cursor_not_needed{} ]
+          / action::effect_skip_prefetch_cursor
       , sml::state<state_acquire_publish_ready> <=
           sml::state<state_acquire_advance_decision>
           + sml::completion<detail::acquire_publish_runtime>
-          [ guard::guard_prefetch_ahead_not_needed{} ]
+          [ guard::guard_prefetch_cursor_exhausted{} ]
+      , sml::state<state_acquire_advance_decision> <=
+          sml::state<state_acquire_advance_step>
+          + sml::completion<detail::acquire_publish_runtime>
       , sml::state<state_acquire_done_callback> <=
           sml::state<state_acquire_publish_ready>
           + sml::completion<detail::acquire_publish_runtime>
@@ -513,19 +513,6 @@ bool assign_family_view(const emel::model::data &model_data,
   return family_out.tensor_count > 0u;
 }
 
-const emel::model::data::tensor_record *
-find_tensor(const emel::model::data &model_data,
-            const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
-    const auto &tensor = model_data.tensors[index];
-    if (emel::model::tensor_name_view(model_data, tensor) == name) {
-      return &tensor;
-    }
-  }
-
-  return nullptr;
-}
-
 bool require_tensor_shape(const emel::model::data &model_data,
                           const std::string_view name,
                           const std::initializer_list<int64_t> dims) noexcept {
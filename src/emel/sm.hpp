@@ -22,6 +22,8 @@
 #include <tuple>
 #include <utility>
 
+#include "emel/trace.hpp"
+
 namespace emel {
 
 namespace policy {
@@ -739,6 +741,10 @@ class sm<model, void, policies...> {
 
   template <class event>
   bool process_event(const event & ev) {
+#if EMEL_TRACE
+    const trace::span traced{trace::category::sm, trace::type_name_v<model>,
+                             trace::type_name_v<event>};
+#endif
     return state_machine_.process_event(ev);
   }
 
@@ -814,6 +820,10 @@ class sm {
 
   template <class event>
   bool process_event(const event & ev) {
+#if EMEL_TRACE
+    const trace::span traced{trace::category::sm, trace::type_name_v<model>,
+                             trace::type_name_v<event>};
+#endif
     return state_machine_.process_event(ev);
   }
 
@@ -904,6 +914,10 @@ class co_sm<model, void, scheduler_policy, allocator_policy, policies...> {
 
   template <class event>
   bool process_event(const event & ev) {
+#if EMEL_TRACE
+    const trace::span traced{trace::category::sm, trace::type_name_v<model>,
+                             trace::type_name_v<event>};
+#endif
     return state_machine_.process_event(ev);
   }
 
@@ -1026,6 +1040,10 @@ class co_sm {
 
   template <class event>
   bool process_event(const event & ev) {
+#if EMEL_TRACE
+    const trace::span traced{trace::category::sm, trace::type_name_v<model>,
+                             trace::type_name_v<event>};
+#endif
     return state_machine_.process_event(ev);
   }
 
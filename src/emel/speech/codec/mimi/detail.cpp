@@ -14,17 +14,7 @@ namespace kev = emel::kernel::event;
 
 constexpr float k_layer_norm_eps = 1e-5f;
 
-const emel::model::data::tensor_record *
-find_tensor(const emel::model::data &model_data,
-            const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model_data.n_tensors; ++index) {
-    const auto &tensor = model_data.tensors[index];
-    if (emel::model::tensor_name_view(model_data, tensor) == name) {
-      return &tensor;
-    }
-  }
-  return nullptr;
-}
+using emel::model::find_tensor;
 
 const emel::model::data::tensor_record *
 find_layer_tensor(const emel::model::data &model_data, const char *format,
@@ -68,6 +68,16 @@ struct effect_mark_unsupported_variant {
   }
 };
 
+struct effect_bind_decoder_tensors {
+  void operator()(const event::decode_run &runtime_ev,
+                  context &ctx) const noexcept {
+    const auto &model = *runtime_ev.request.contract.model;
+    kdetail::bind_decoder_tensors(model, ctx.tensors);
+    ctx.bound_model = &model;
+    ctx.bound_weights = model.weights_data;
+  }
+};
+
 template <kdetail::linear_weight_variant Variant,
           kdetail::aux_weight_variant Aux = kdetail::aux_weight_variant::q8_0>
 struct effect_run_decoder_variant {
@@ -86,8 +96,7 @@ struct effect_run_decoder_variant {
         .space = tokens.space,
     };
     const uint64_t digest = kdetail::run_decoder_sequence<Variant, Aux>(
-        ctx.kernel,
-        *runtime_ev.request.contract.model,
+        ctx.kernel, ctx.tensors,
         runtime_ev.request.encoder_state.data(),
         static_cast<uint64_t>(runtime_ev.request.encoder_frame_count),
         policy, runtime_ev.request.policy.prompt_tokens.data(),
@@ -176,6 +185,7 @@ inline constexpr effect_mark_workspace_capacity_invalid
     effect_mark_workspace_capacity_invalid{};
 inline constexpr effect_mark_unsupported_variant
     effect_mark_unsupported_variant{};
+inline constexpr effect_bind_decoder_tensors effect_bind_decoder_tensors{};
 inline constexpr effect_run_decoder_q8_0_t effect_run_decoder_q8_0{};
 inline constexpr effect_run_decoder_q8_0_f32_aux_t
     effect_run_decoder_q8_0_f32_aux{};
@@ -3,11 +3,18 @@
 #include <cstdint>
 
 #include "emel/kernel/sm.hpp"
+#include "emel/model/data.hpp"
+#include "emel/speech/decoder/whisper/detail.hpp"
 
 namespace emel::speech::decoder::whisper::action {
 
 struct context {
   emel::kernel::sm kernel{emel::kernel::detect_host_kind()};
+  // Tensor handles of `bound_model`, resolved by name when a decode first
+  // names that model (or a model with other weights) and reused after.
+  const emel::model::data *bound_model = nullptr;
+  const void *bound_weights = nullptr;
+  detail::decoder_tensors tensors = {};
   uint64_t q8_0_dispatch_count = 0;
   uint64_t q4_0_dispatch_count = 0;
   uint64_t q4_1_dispatch_count = 0;
@@ -90,17 +90,7 @@ required_decoder_workspace_floats(const uint64_t encoder_frames) noexcept {
          std::max<uint64_t>(encoder_frames, tokens);
 }
 
-inline const emel::model::data::tensor_record *
-find_tensor(const emel::model::data &model,
-            const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model.n_tensors; ++index) {
-    const auto &tensor = model.tensors[index];
-    if (emel::model::tensor_name_view(model, tensor) == name) {
-      return &tensor;
-    }
-  }
-  return nullptr;
-}
+using emel::model::find_tensor;
 
 inline bool tensor_has_shape(const emel::model::data::tensor_record &tensor,
                              const int32_t n_dims,
@@ -436,27 +426,111 @@ inline uint64_t write_layer_tensor_name(char *output, const char *prefix,
   return append_literal(output, offset, suffix);
 }
 
+// Tensor handles resolved by name once per bound model (the actor keeps them
+// in its context) rather than inside every layer of every generated token.
+struct decoder_layer_tensors {
+  using tensor_record = emel::model::data::tensor_record;
+  const tensor_record *self_ln_w = nullptr;
+  const tensor_record *self_ln_b = nullptr;
+  const tensor_record *self_q_w = nullptr;
+  const tensor_record *self_q_b = nullptr;
+  const tensor_record *self_k_w = nullptr;
+  const tensor_record *self_v_w = nullptr;
+  const tensor_record *self_v_b = nullptr;
+  const tensor_record *self_o_w = nullptr;
+  const tensor_record *self_o_b = nullptr;
+  const tensor_record *cross_ln_w = nullptr;
+  const tensor_record *cross_ln_b = nullptr;
+  const tensor_record *cross_q_w = nullptr;
+  const tensor_record *cross_q_b = nullptr;
+  const tensor_record *cross_k_w = nullptr;
+  const tensor_record *cross_v_w = nullptr;
+  const tensor_record *cross_v_b = nullptr;
+  const tensor_record *cross_o_w = nullptr;
+  const tensor_record *cross_o_b = nullptr;
+  const tensor_record *final_ln_w = nullptr;
+  const tensor_record *final_ln_b = nullptr;
+  const tensor_record *fc1_w = nullptr;
+  const tensor_record *fc1_b = nullptr;
+  const tensor_record *fc2_w = nullptr;
+  const tensor_record *fc2_b = nullptr;
+};
+
+struct decoder_tensors {
+  using tensor_record = emel::model::data::tensor_record;
+  const tensor_record *token_embedding = nullptr;
+  const tensor_record *position_embedding = nullptr;
+  const tensor_record *final_w = nullptr;
+  const tensor_record *final_b = nullptr;
+  std::array<decoder_layer_tensors, static_cast<size_t>(k_decoder_block_count)>
+      layers = {};
+};
+
+inline void bind_decoder_layer_tensors(const emel::model::data &model,
+                                       const uint64_t layer,
+                                       decoder_layer_tensors &out) noexcept {
+  char name[96] = {};
+  const auto layer_tensor = [&](const char *suffix) noexcept {
+    const uint64_t name_size =
+        write_layer_tensor_name(name, "model.decoder.layers.", layer, suffix);
+    return find_tensor(model,
+                       std::string_view{name, static_cast<size_t>(name_size)});
+  };
+  out.self_ln_w = layer_tensor("self_attn_layer_norm.weight");
+  out.self_ln_b = layer_tensor("self_attn_layer_norm.bias");
+  out.self_q_w = layer_tensor("self_attn.q_proj.weight");
+  out.self_q_b = layer_tensor("self_attn.q_proj.bias");
+  out.self_k_w = layer_tensor("self_attn.k_proj.weight");
+  out.self_v_w = layer_tensor("self_attn.v_proj.weight");
+  out.self_v_b = layer_tensor("self_attn.v_proj.bias");
+  out.self_o_w = layer_tensor("self_attn.out_proj.weight");
+  out.self_o_b = layer_tensor("self_attn.out_proj.bias");
+  out.cross_ln_w = layer_tensor("encoder_attn_layer_norm.weight");
+  out.cross_ln_b = layer_tensor("encoder_attn_layer_norm.bias");
+  out.cross_q_w = layer_tensor("encoder_attn.q_proj.weight");
+  out.cross_q_b = layer_tensor("encoder_attn.q_proj.bias");
+  out.cross_k_w = layer_tensor("encoder_attn.k_proj.weight");
+  out.cross_v_w = layer_tensor("encoder_attn.v_proj.weight");
+  out.cross_v_b = layer_tensor("encoder_attn.v_proj.bias");
+  out.cross_o_w = layer_tensor("encoder_attn.out_proj.weight");
+  out.cross_o_b = layer_tensor("encoder_attn.out_proj.bias");
+  out.final_ln_w = layer_tensor("final_layer_norm.weight");
+  out.final_ln_b = layer_tensor("final_layer_norm.bias");
+  out.fc1_w = layer_tensor("fc1.weight");
+  out.fc1_b = layer_tensor("fc1.bias");
+  out.fc2_w = layer_tensor("fc2.weight");
+  out.fc2_b = layer_tensor("fc2.bias");
+}
+
+inline void bind_decoder_tensors(const emel::model::data &model,
+                                 decoder_tensors &out) noexcept {
+  out.token_embedding = find_tensor(model, "model.decoder.embed_tokens.weight");
+  out.position_embedding =
+      find_tensor(model, "model.decoder.embed_positions.weight");
+  out.final_w = find_tensor(model, "model.decoder.layer_norm.weight");
+  out.final_b = find_tensor(model, "model.decoder.layer_norm.bias");
+  for (uint64_t layer = 0; layer < static_cast<uint64_t>(k_decoder_block_count);
+       ++layer) {
+    bind_decoder_layer_tensors(model, layer,
+                               out.layers[static_cast<size_t>(layer)]);
+  }
+}
+
 template <linear_weight_variant Variant, aux_weight_variant Aux>
 inline void compute_decoder_cross_cache(::emel::kernel::sm &kernel,
-                                        const emel::model::data &model,
+                                        const decoder_tensors &tensors,
                                         const float *encoder_state,
                                         const uint64_t encoder_frames,
                                         float *cross_k_cache,
                                         float *cross_v_cache) noexcept {
-  char name[96] = {};
   const uint64_t width = static_cast<uint64_t>(k_embedding_length);
   const uint64_t layer_stride = encoder_frames * width;
   for (uint64_t layer = 0; layer < static_cast<uint64_t>(k_decoder_block_count);
        ++layer) {
-    const auto layer_tensor = [&](const char *suffix) noexcept {
-      const uint64_t name_size =
-          write_layer_tensor_name(name, "model.decoder.layers.", layer, suffix);
-      return *find_tensor(
-          model, std::string_view{name, static_cast<size_t>(name_size)});
-    };
-    const auto &cross_k_w = layer_tensor("encoder_attn.k_proj.weight");
-    const auto &cross_v_w = layer_tensor("encoder_attn.v_proj.weight");
-    const auto &cross_v_b = layer_tensor("encoder_attn.v_proj.bias");
+    const auto &layer_tensors = tensors.layers[static_cast<size_t>(layer)];
+    const auto &cross_k_w = *layer_tensors.cross_k_w;
+    const auto &cross_v_w = *layer_tensors.cross_v_w;
+    const auto &cross_v_b = *layer_tensors.cross_v_b;
     float *layer_cross_k = cross_k_cache + layer * layer_stride;
     float *layer_cross_v = cross_v_cache + layer * layer_stride;
     for (uint64_t frame = 0; frame < encoder_frames; ++frame) {
@@ -472,40 +546,32 @@ inline void compute_decoder_cross_cache(::emel::kernel::sm &kernel,
 
 template <linear_weight_variant Variant, aux_weight_variant Aux>
 inline void run_decoder_layer_sequence(
-    ::emel::kernel::sm &kernel, const emel::model::data &model,
-    const uint64_t layer, const uint64_t encoder_frames,
-    const uint64_t token_count, const float *cross_k, const float *cross_v,
-    float *hidden, float *next, float *q, float *k, float *v, float *attn,
-    float *norm, float *ff, float *scores) noexcept {
-  char name[96] = {};
-  const auto layer_tensor = [&](const char *suffix) noexcept {
-    const uint64_t name_size =
-        write_layer_tensor_name(name, "model.decoder.layers.", layer, suffix);
-    return *find_tensor(model,
-                        std::string_view{name, static_cast<size_t>(name_size)});
-  };
-
-  const auto &self_ln_w = layer_tensor("self_attn_layer_norm.weight");
-  const auto &self_ln_b = layer_tensor("self_attn_layer_norm.bias");
-  const auto &self_q_w = layer_tensor("self_attn.q_proj.weight");
-  const auto &self_q_b = layer_tensor("self_attn.q_proj.bias");
-  const auto &self_k_w = layer_tensor("self_attn.k_proj.weight");
-  const auto &self_v_w = layer_tensor("self_attn.v_proj.weight");
-  const auto &self_v_b = layer_tensor("self_attn.v_proj.bias");
-  const auto &self_o_w = layer_tensor("self_attn.out_proj.weight");
-  const auto &self_o_b = layer_tensor("self_attn.out_proj.bias");
-  const auto &cross_ln_w = layer_tensor("encoder_attn_layer_norm.weight");
-  const auto &cross_ln_b = layer_tensor("encoder_attn_layer_norm.bias");
-  const auto &cross_q_w = layer_tensor("encoder_attn.q_proj.weight");
-  const auto &cross_q_b = layer_tensor("encoder_attn.q_proj.bias");
-  const auto &cross_o_w = layer_tensor("encoder_attn.out_proj.weight");
-  const auto &cross_o_b = layer_tensor("encoder_attn.out_proj.bias");
-  const auto &final_ln_w = layer_tensor("final_layer_norm.weight");
-  const auto &final_ln_b = layer_tensor("final_layer_norm.bias");
-  const auto &fc1_w = layer_tensor("fc1.weight");
-  const auto &fc1_b = layer_tensor("fc1.bias");
-  const auto &fc2_w = layer_tensor("fc2.weight");
-  const auto &fc2_b = layer_tensor("fc2.bias");
+    ::emel::kernel::sm &kernel, const decoder_layer_tensors &tensors,
+    const uint64_t encoder_frames, const uint64_t token_count,
+    const float *cross_k, const float *cross_v, float *hidden, float *next,
+    float *q, float *k, float *v, float *attn, float *norm, float *ff,
+    float *scores) noexcept {
+  const auto &self_ln_w = *tensors.self_ln_w;
+  const auto &self_ln_b = *tensors.self_ln_b;
+  const auto &self_q_w = *tensors.self_q_w;
+  const auto &self_q_b = *tensors.self_q_b;
+  const auto &self_k_w = *tensors.self_k_w;
+  const auto &self_v_w = *tensors.self_v_w;
+  const auto &self_v_b = *tensors.self_v_b;
+  const auto &self_o_w = *tensors.self_o_w;
+  const auto &self_o_b = *tensors.self_o_b;
+  const auto &cross_ln_w = *tensors.cross_ln_w;
+  const auto &cross_ln_b = *tensors.cross_ln_b;
+  const auto &cross_q_w = *tensors.cross_q_w;
+  const auto &cross_q_b = *tensors.cross_q_b;
+  const auto &cross_o_w = *tensors.cross_o_w;
+  const auto &cross_o_b = *tensors.cross_o_b;
+  const auto &final_ln_w = *tensors.final_ln_w;
+  const auto &final_ln_b = *tensors.final_ln_b;
+  const auto &fc1_w = *tensors.fc1_w;
+  const auto &fc1_b = *tensors.fc1_b;
+  const auto &fc2_w = *tensors.fc2_w;
+  const auto &fc2_b = *tensors.fc2_b;
 
   const uint64_t width = static_cast<uint64_t>(k_embedding_length);
   for (uint64_t token = 0; token < token_count; ++token) {
@@ -621,7 +687,7 @@ inline uint64_t digest_f32(const float *values, const uint64_t count) noexcept {
 template <linear_weight_variant Variant,
           aux_weight_variant Aux = aux_weight_variant::q8_0>
 inline void compute_decoder_logits_for_tokens(
-    ::emel::kernel::sm &kernel, const emel::model::data &model,
+    ::emel::kernel::sm &kernel, const decoder_tensors &tensors,
     const uint64_t encoder_frames, const float *cross_k_cache,
     const float *cross_v_cache, const int32_t *tokens,
     const uint64_t token_count, float *workspace, float *logits,
@@ -638,10 +704,8 @@ inline void compute_decoder_logits_for_tokens(
   float *ff = norm + static_cast<uint64_t>(k_embedding_length);
   float *scores = ff + static_cast<uint64_t>(k_feed_forward_length);
 
-  const auto &token_embedding = *find_tensor(
-      model, "model.decoder.embed_tokens.weight"); // GCOVR_EXCL_BR_LINE
-  const auto &position_embedding = *find_tensor(
-      model, "model.decoder.embed_positions.weight"); // GCOVR_EXCL_BR_LINE
+  const auto &token_embedding = *tensors.token_embedding;
+  const auto &position_embedding = *tensors.position_embedding;
   for (uint64_t token = 0; token < token_count; ++token) {
     for (uint64_t dim = 0; dim < static_cast<uint64_t>(k_embedding_length);
          ++dim) {
@@ -662,15 +726,13 @@ inline void compute_decoder_logits_for_tokens(
     const uint64_t layer_offset =
         layer * encoder_frames * static_cast<uint64_t>(k_embedding_length);
     run_decoder_layer_sequence<Variant, Aux>(
-        kernel, model, layer, encoder_frames, token_count,
-        cross_k_cache + layer_offset, cross_v_cache + layer_offset, hidden,
-        next, q, k, v, attn, norm, ff, scores);
+        kernel, tensors.layers[static_cast<size_t>(layer)], encoder_frames,
+        token_count, cross_k_cache + layer_offset, cross_v_cache + layer_offset,
+        hidden, next, q, k, v, attn, norm, ff, scores);
   }
 
-  const auto &final_w = *find_tensor(
-      model, "model.decoder.layer_norm.weight"); // GCOVR_EXCL_BR_LINE
-  const auto &final_b = *find_tensor(
-      model, "model.decoder.layer_norm.bias"); // GCOVR_EXCL_BR_LINE
+  const auto &final_w = *tensors.final_w;
+  const auto &final_b = *tensors.final_b;
   const uint64_t last_token = token_count - 1u;
   layer_norm_frame<Aux>(hidden + last_token *
                                      static_cast<uint64_t>(k_embedding_length),
@@ -695,6 +757,21 @@ inline void compute_decoder_logits_for_tokens(
   digest_out = digest_f32(norm, static_cast<uint64_t>(k_embedding_length));
 }
 
+template <linear_weight_variant Variant,
+          aux_weight_variant Aux = aux_weight_variant::q8_0>
+inline void compute_decoder_logits_for_tokens(
+    ::emel::kernel::sm &kernel, const emel::model::data &model,
+    const uint64_t encoder_frames, const float *cross_k_cache,
+    const float *cross_v_cache, const int32_t *tokens,
+    const uint64_t token_count, float *workspace, float *logits,
+    float &confidence_out, uint64_t &digest_out) noexcept {
+  decoder_tensors tensors = {};
+  bind_decoder_tensors(model, tensors);
+  compute_decoder_logits_for_tokens<Variant, Aux>(
+      kernel, tensors, encoder_frames, cross_k_cache, cross_v_cache, tokens,
+      token_count, workspace, logits, confidence_out, digest_out);
+}
+
 inline int32_t select_greedy_timestamp_aware_token(
     const decode_policy_runtime &policy, const float *logits,
     const int32_t *generated_tokens, const uint64_t generated_token_count,
@@ -785,7 +862,7 @@ inline int32_t select_greedy_timestamp_aware_token(
 template <linear_weight_variant Variant,
           aux_weight_variant Aux = aux_weight_variant::q8_0>
 inline uint64_t run_decoder_sequence(
-    ::emel::kernel::sm &kernel, const emel::model::data &model,
+    ::emel::kernel::sm &kernel, const decoder_tensors &tensors,
     const float *encoder_state, const uint64_t encoder_frames,
     const decode_policy_runtime &policy, const int32_t *prompt_tokens,
     const uint64_t prompt_token_count, float *workspace, float *logits,
@@ -807,7 +884,7 @@ inline uint64_t run_decoder_sequence(
   float *cross_k_cache = workspace;
   float *cross_v_cache = cross_k_cache + cross_cache_count;
   float *step_workspace = cross_v_cache + cross_cache_count;
-  compute_decoder_cross_cache<Variant, Aux>(kernel, model, encoder_state,
+  compute_decoder_cross_cache<Variant, Aux>(kernel, tensors, encoder_state,
                                             encoder_frames, cross_k_cache,
                                             cross_v_cache);
   uint64_t token_count = prompt_token_count;
@@ -816,7 +893,7 @@ inline uint64_t run_decoder_sequence(
   for (uint64_t step = 0; step < generation_limit; ++step) {
     float raw_confidence = 0.0f;
     compute_decoder_logits_for_tokens<Variant, Aux>(
-        kernel, model, encoder_frames, cross_k_cache, cross_v_cache,
+        kernel, tensors, encoder_frames, cross_k_cache, cross_v_cache,
         tokens.data(), token_count, step_workspace, logits, raw_confidence,
         digest);
     const int32_t next_token = select_greedy_timestamp_aware_token(
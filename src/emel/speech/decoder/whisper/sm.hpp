@@ -17,6 +17,7 @@ struct state_decode_policy_decision {};
 struct state_generated_token_capacity_decision {};
 struct state_logits_capacity_decision {};
 struct state_workspace_capacity_decision {};
+struct state_tensor_binding_decision {};
 struct state_variant_decision {};
 struct state_running_q8_0 {};
 struct state_running_q8_0_f32_aux {};
@@ -70,12 +71,20 @@ struct model {
           + sml::completion<event::decode_run> [ guard::guard_logits_capacity_invalid{} ]
           / action::effect_mark_logits_capacity_invalid
 
-      , sml::state<state_variant_decision> <= sml::state<state_workspace_capacity_decision>
+      , sml::state<state_tensor_binding_decision> <= sml::state<state_workspace_capacity_decision>
           + sml::completion<event::decode_run> [ guard::guard_workspace_capacity_valid{} ]
       , sml::state<state_error_error_out_decision> <= sml::state<state_workspace_capacity_decision>
           + sml::completion<event::decode_run> [ guard::guard_workspace_capacity_invalid{} ]
           / action::effect_mark_workspace_capacity_invalid
 
+      //------------------------------------------------------------------------------//
+      // Tensor names resolve once per bound model, not on every decode.
+      , sml::state<state_variant_decision> <= sml::state<state_tensor_binding_decision>
+          + sml::completion<event::decode_run> [ guard::guard_tensors_bound{} ]
+      , sml::state<state_variant_decision> <= sml::state<state_tensor_binding_decision>
+          + sml::completion<event::decode_run> [ guard::guard_tensors_unbound{} ]
+          / action::effect_bind_decoder_tensors
+
       //------------------------------------------------------------------------------//
       // Explicit maintained quant variant routing.
       , sml::state<state_running_q8_0_f32_aux> <= sml::state<state_variant_decision>
@@ -145,6 +154,8 @@ struct model {
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_workspace_capacity_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_tensor_binding_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_variant_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_running_q8_0>
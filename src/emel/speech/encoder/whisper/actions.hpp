@@ -69,6 +69,16 @@ struct effect_mark_unsupported_variant {
   }
 };
 
+struct effect_bind_encoder_tensors {
+  void operator()(const event::encode_run &runtime_ev,
+                  context &ctx) const noexcept {
+    const auto &model = *runtime_ev.request.contract.model;
+    kdetail::bind_encoder_tensors(model, ctx.tensors);
+    ctx.bound_model = &model;
+    ctx.bound_weights = model.weights_data;
+  }
+};
+
 template <kdetail::linear_weight_variant Variant,
           kdetail::aux_weight_variant Aux = kdetail::aux_weight_variant::q8_0>
 struct effect_run_encoder_variant {
@@ -76,8 +86,7 @@ struct effect_run_encoder_variant {
                   context &ctx) const noexcept {
     uint64_t frame_count = 0u;
     const uint64_t digest = kdetail::run_encoder<Variant, Aux>(
-        ctx.kernel, *runtime_ev.request.contract.model,
-        runtime_ev.request.pcm.data(),
+        ctx.kernel, ctx.tensors, runtime_ev.request.pcm.data(),
         static_cast<uint64_t>(runtime_ev.request.pcm.size()),
         runtime_ev.request.workspace.data(),
         runtime_ev.request.encoder_state.data(), frame_count);
@@ -159,6 +168,7 @@ inline constexpr effect_mark_workspace_capacity_invalid
     effect_mark_workspace_capacity_invalid{};
 inline constexpr effect_mark_unsupported_variant
     effect_mark_unsupported_variant{};
+inline constexpr effect_bind_encoder_tensors effect_bind_encoder_tensors{};
 inline constexpr effect_run_encoder_q8_0_t effect_run_encoder_q8_0{};
 inline constexpr effect_run_encoder_q8_0_f32_aux_t
     effect_run_encoder_q8_0_f32_aux{};
@@ -106,17 +106,7 @@ required_workspace_floats(const uint64_t sample_count) noexcept {
          static_cast<uint64_t>(k_bluestein_fft_size) * 4u;
 }
 
-inline const emel::model::data::tensor_record *
-find_tensor(const emel::model::data &model,
-            const std::string_view name) noexcept {
-  for (uint32_t index = 0u; index < model.n_tensors; ++index) {
-    const auto &tensor = model.tensors[index];
-    if (emel::model::tensor_name_view(model, tensor) == name) {
-      return &tensor;
-    }
-  }
-  return nullptr;
-}
+using emel::model::find_tensor;
 
 inline bool tensor_has_shape(const emel::model::data::tensor_record &tensor,
                              const int32_t n_dims,
@@ -750,35 +740,107 @@ inline uint64_t write_layer_tensor_name(char *output, const char *prefix,
   return append_literal(output, offset, suffix);
 }
 
-template <linear_weight_variant Variant, aux_weight_variant Aux>
-inline void
-run_encoder_layer(::emel::kernel::sm &kernel, const emel::model::data &model,
-                  const uint64_t layer, const uint64_t encoder_frames,
-                  float *hidden, float *next, float *q, float *k, float *v,
-                  float *attn, float *norm, float *ff, float *scores) noexcept {
+// Tensor handles resolved by name once per bound model (the actor keeps them
+// in its context) rather than on every forward pass.
+struct encoder_layer_tensors {
+  using tensor_record = emel::model::data::tensor_record;
+  const tensor_record *ln1_w = nullptr;
+  const tensor_record *ln1_b = nullptr;
+  const tensor_record *q_w = nullptr;
+  const tensor_record *q_b = nullptr;
+  const tensor_record *k_w = nullptr;
+  const tensor_record *v_w = nullptr;
+  const tensor_record *v_b = nullptr;
+  const tensor_record *o_w = nullptr;
+  const tensor_record *o_b = nullptr;
+  const tensor_record *ln2_w = nullptr;
+  const tensor_record *ln2_b = nullptr;
+  const tensor_record *fc1_w = nullptr;
+  const tensor_record *fc1_b = nullptr;
+  const tensor_record *fc2_w = nullptr;
+  const tensor_record *fc2_b = nullptr;
+};
+
+struct encoder_tensors {
+  using tensor_record = emel::model::data::tensor_record;
+  const tensor_record *mel_filters = nullptr;
+  const tensor_record *conv1_w = nullptr;
+  const tensor_record *conv1_b = nullptr;
+  const tensor_record *conv2_w = nullptr;
+  const tensor_record *conv2_b = nullptr;
+  const tensor_record *positions = nullptr;
+  const tensor_record *final_w = nullptr;
+  const tensor_record *final_b = nullptr;
+  std::array<encoder_layer_tensors, static_cast<size_t>(k_encoder_block_count)>
+      layers = {};
+};
+
+inline void bind_encoder_layer_tensors(const emel::model::data &model,
+                                       const uint64_t layer,
+                                       encoder_layer_tensors &out) noexcept {
   char name[96] = {};
   const auto layer_tensor = [&](const char *suffix) noexcept {
     const uint64_t name_size =
         write_layer_tensor_name(name, "model.encoder.layers.", layer, suffix);
-    return *find_tensor(model,
-                        std::string_view{name, static_cast<size_t>(name_size)});
+    return find_tensor(model,
+                       std::string_view{name, static_cast<size_t>(name_size)});
   };
+  out.ln1_w = layer_tensor("self_attn_layer_norm.weight");
+  out.ln1_b = layer_tensor("self_attn_layer_norm.bias");
+  out.q_w = layer_tensor("self_attn.q_proj.weight");
+  out.q_b = layer_tensor("self_attn.q_proj.bias");
+  out.k_w = layer_tensor("self_attn.k_proj.weight");
+  out.v_w = layer_tensor("self_attn.v_proj.weight");
+  out.v_b = layer_tensor("self_attn.v_proj.bias");
+  out.o_w = layer_tensor("self_attn.out_proj.weight");
+  out.o_b = layer_tensor("self_attn.out_proj.bias");
+  out.ln2_w = layer_tensor("final_layer_norm.weight");
+  out.ln2_b = layer_tensor("final_layer_norm.bias");
+  out.fc1_w = layer_tensor("fc1.weight");
+  out.fc1_b = layer_tensor("fc1.bias");
+  out.fc2_w = layer_tensor("fc2.weight");
+  out.fc2_b = layer_tensor("fc2.bias");
+}
+
+inline void bind_encoder_tensors(const emel::model::data &model,
+                                 encoder_tensors &out) noexcept {
+  out.mel_filters = find_tensor(model, "mel_filters");
+  out.conv1_w = find_tensor(model, "model.encoder.conv1.weight");
+  out.conv1_b = find_tensor(model, "model.encoder.conv1.bias");
+  out.conv2_w = find_tensor(model, "model.encoder.conv2.weight");
+  out.conv2_b = find_tensor(model, "model.encoder.conv2.bias");
+  out.positions = find_tensor(model, "model.encoder.embed_positions.weight");
+  out.final_w = find_tensor(model, "model.encoder.layer_norm.weight");
+  out.final_b = find_tensor(model, "model.encoder.layer_norm.bias");
+  for (uint64_t layer = 0; layer < static_cast<uint64_t>(k_encoder_block_count);
+       ++layer) {
+    bind_encoder_layer_tensors(model, layer,
+                               out.layers[static_cast<size_t>(layer)]);
+  }
+}
 
-  const auto &ln1_w = layer_tensor("self_attn_layer_norm.weight");
-  const auto &ln1_b = layer_tensor("self_attn_layer_norm.bias");
-  const auto &q_w = layer_tensor("self_attn.q_proj.weight");
-  const auto &q_b = layer_tensor("self_attn.q_proj.bias");
-  const auto &k_w = layer_tensor("self_attn.k_proj.weight");
-  const auto &v_w = layer_tensor("self_attn.v_proj.weight");
-  const auto &v_b = layer_tensor("self_attn.v_proj.bias");
-  const auto &o_w = layer_tensor("self_attn.out_proj.weight");
-  const auto &o_b = layer_tensor("self_attn.out_proj.bias");
-  const auto &ln2_w = layer_tensor("final_layer_norm.weight");
-  const auto &ln2_b = layer_tensor("final_layer_norm.bias");
-  const auto &fc1_w = layer_tensor("fc1.weight");
-  const auto &fc1_b = layer_tensor("fc1.bias");
-  const auto &fc2_w = layer_tensor("fc2.weight");
-  const auto &fc2_b = layer_tensor("fc2.bias");
+template <linear_weight_variant Variant, aux_weight_variant Aux>
+inline void
+run_encoder_layer(::emel::kernel::sm &kernel,
+                  const encoder_layer_tensors &tensors,
+                  const uint64_t encoder_frames, float *hidden, float *next,
+                  float *q, float *k, float *v, float *attn, float *norm,
+                  float *ff, float *scores) noexcept {
+  const auto &ln1_w = *tensors.ln1_w;
+  const auto &ln1_b = *tensors.ln1_b;
+  const auto &q_w = *tensors.q_w;
+  const auto &q_b = *tensors.q_b;
+  const auto &k_w = *tensors.k_w;
+  const auto &v_w = *tensors.v_w;
+  const auto &v_b = *tensors.v_b;
+  const auto &o_w = *tensors.o_w;
+  const auto &o_b = *tensors.o_b;
+  const auto &ln2_w = *tensors.ln2_w;
+  const auto &ln2_b = *tensors.ln2_b;
+  const auto &fc1_w = *tensors.fc1_w;
+  const auto &fc1_b = *tensors.fc1_b;
+  const auto &fc2_w = *tensors.fc2_w;
+  const auto &fc2_b = *tensors.fc2_b;
 
   for (uint64_t frame = 0; frame < encoder_frames; ++frame) {
     const float *frame_in =
@@ -871,7 +933,7 @@ inline uint64_t digest_f32(const float *values, const uint64_t count) noexcept {
 template <linear_weight_variant Variant,
           aux_weight_variant Aux = aux_weight_variant::q8_0>
 inline uint64_t
-run_encoder(::emel::kernel::sm &kernel, const emel::model::data &model,
+run_encoder(::emel::kernel::sm &kernel, const encoder_tensors &tensors,
             const float *pcm, const uint64_t sample_count, float *workspace,
             float *output, uint64_t &encoder_frames_out) noexcept {
   const uint64_t mel_frames = mel_frame_count_for_samples(sample_count);
@@ -902,18 +964,12 @@ run_encoder(::emel::kernel::sm &kernel, const emel::model::data &model,
   float *chirp_real = window + static_cast<uint64_t>(k_fft_size);
   float *chirp_imag = chirp_real + static_cast<uint64_t>(k_fft_size);
 
-  const auto &mel_filters =
-      *find_tensor(model, "mel_filters"); // GCOVR_EXCL_BR_LINE
-  const auto &conv1_w =
-      *find_tensor(model, "model.encoder.conv1.weight"); // GCOVR_EXCL_BR_LINE
-  const auto &conv1_b =
-      *find_tensor(model, "model.encoder.conv1.bias"); // GCOVR_EXCL_BR_LINE
-  const auto &conv2_w =
-      *find_tensor(model, "model.encoder.conv2.weight"); // GCOVR_EXCL_BR_LINE
-  const auto &conv2_b =
-      *find_tensor(model, "model.encoder.conv2.bias"); // GCOVR_EXCL_BR_LINE
-  const auto &positions = *find_tensor(
-      model, "model.encoder.embed_positions.weight"); // GCOVR_EXCL_BR_LINE
+  const auto &mel_filters = *tensors.mel_filters;
+  const auto &conv1_w = *tensors.conv1_w;
+  const auto &conv1_b = *tensors.conv1_b;
+  const auto &conv2_w = *tensors.conv2_w;
+  const auto &conv2_b = *tensors.conv2_b;
+  const auto &positions = *tensors.positions;
   compute_mel_features(pcm, sample_count, mel_filters, mel, fft_real, fft_imag,
                        kernel_real, kernel_imag, window, chirp_real,
                        chirp_imag);
@@ -923,15 +979,13 @@ run_encoder(::emel::kernel::sm &kernel, const emel::model::data &model,
 
   for (uint64_t layer = 0; layer < static_cast<uint64_t>(k_encoder_block_count);
        ++layer) {
-    run_encoder_layer<Variant, Aux>(kernel, model, layer, encoder_frames,
-                                    hidden, next, q, k, v, attn, norm, ff,
-                                    scores);
+    run_encoder_layer<Variant, Aux>(
+        kernel, tensors.layers[static_cast<size_t>(layer)], encoder_frames,
+        hidden, next, q, k, v, attn, norm, ff, scores);
   }
 
-  const auto &final_w = *find_tensor(
-      model, "model.encoder.layer_norm.weight"); // GCOVR_EXCL_BR_LINE
-  const auto &final_b = *find_tensor(
-      model, "model.encoder.layer_norm.bias"); // GCOVR_EXCL_BR_LINE
+  const auto &final_w = *tensors.final_w;
+  const auto &final_b = *tensors.final_b;
   for (uint64_t frame = 0; frame < encoder_frames; ++frame) {
     layer_norm_frame<Aux>(
         hidden + frame * static_cast<uint64_t>(k_embedding_length), final_w,
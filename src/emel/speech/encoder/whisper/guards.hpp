@@ -215,6 +215,21 @@ struct guard_workspace_capacity_invalid {
   }
 };
 
+struct guard_tensors_bound {
+  bool operator()(const event::encode_run &runtime_ev,
+                  const action::context &ctx) const noexcept {
+    const auto *model = runtime_ev.request.contract.model;
+    return ctx.bound_model == model && ctx.bound_weights == model->weights_data;
+  }
+};
+
+struct guard_tensors_unbound {
+  bool operator()(const event::encode_run &runtime_ev,
+                  const action::context &ctx) const noexcept {
+    return !guard_tensors_bound{}(runtime_ev, ctx);
+  }
+};
+
 struct guard_q8_0_variant {
   bool operator()(const event::encode_run &runtime_ev,
                   const action::context &) const noexcept {
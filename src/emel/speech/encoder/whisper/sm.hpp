@@ -18,6 +18,7 @@ struct state_channel_count_decision {};
 struct state_pcm_shape_decision {};
 struct state_output_capacity_decision {};
 struct state_workspace_capacity_decision {};
+struct state_tensor_binding_decision {};
 struct state_variant_decision {};
 struct state_running_q8_0 {};
 struct state_running_q8_0_f32_aux {};
@@ -71,12 +72,20 @@ struct model {
           + sml::completion<event::encode_run> [ guard::guard_output_capacity_invalid{} ]
           / action::effect_mark_output_capacity_invalid
 
-      , sml::state<state_variant_decision> <= sml::state<state_workspace_capacity_decision>
+      , sml::state<state_tensor_binding_decision> <= sml::state<state_workspace_capacity_decision>
           + sml::completion<event::encode_run> [ guard::guard_workspace_capacity_valid{} ]
       , sml::state<state_error_error_out_decision> <= sml::state<state_workspace_capacity_decision>
           + sml::completion<event::encode_run> [ guard::guard_workspace_capacity_invalid{} ]
           / action::effect_mark_workspace_capacity_invalid
 
+      //------------------------------------------------------------------------------//
+      // Tensor names resolve once per bound model, not on every forward pass.
+      , sml::state<state_variant_decision> <= sml::state<state_tensor_binding_decision>
+          + sml::completion<event::encode_run> [ guard::guard_tensors_bound{} ]
+      , sml::state<state_variant_decision> <= sml::state<state_tensor_binding_decision>
+          + sml::completion<event::encode_run> [ guard::guard_tensors_unbound{} ]
+          / action::effect_bind_encoder_tensors
+
       //------------------------------------------------------------------------------//
       // Explicit maintained quant variant routing.
       , sml::state<state_running_q8_0_f32_aux> <= sml::state<state_variant_decision>
@@ -146,6 +155,8 @@ struct model {
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_workspace_capacity_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
+      , sml::state<state_ready> <= sml::state<state_tensor_binding_decision>
+          + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_variant_decision>
           + sml::unexpected_event<sml::_> / action::effect_on_unexpected
       , sml::state<state_ready> <= sml::state<state_running_q8_0>
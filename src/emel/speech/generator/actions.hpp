@@ -714,6 +714,41 @@ struct effect_reject_reset {
   }
 };
 
+template <class dependencies_type>
+void add_collaborator_memory_footprint(
+    const event::capture_memory_footprint &ev,
+    const context<dependencies_type> &ctx) noexcept {
+  if constexpr (requires {
+                  ctx.collaborators.capture_memory_footprint(ev.out,
+                                                             ev.residency);
+                }) {
+    ctx.collaborators.capture_memory_footprint(ev.out, ev.residency);
+  }
+}
+
+template <class dependencies_type>
+void add_owned_memory_footprint(
+    const context<dependencies_type> &ctx,
+    emel::memory::footprint::report &out) noexcept {
+  if constexpr (wavefront_dependencies<dependencies_type>) {
+    namespace footprint = emel::memory::footprint;
+    out.scratch_bytes += footprint::bytes_of(ctx.encoded_lane0_storage) +
+                         footprint::bytes_of(ctx.encoded_lane1_storage) +
+                         footprint::bytes_of(ctx.generated_lane0_storage) +
+                         footprint::bytes_of(ctx.generated_lane1_storage) +
+                         footprint::bytes_of(ctx.decoded_pcm_storage);
+  }
+}
+
+template <class dependencies_type> struct effect_capture_memory_footprint {
+  void operator()(const event::capture_memory_footprint &ev,
+                  const context<dependencies_type> &ctx) const noexcept {
+    ev.out = {};
+    add_collaborator_memory_footprint(ev, ctx);
+    add_owned_memory_footprint(ctx, ev.out);
+  }
+};
+
 template <class dependencies_type> struct effect_unexpected {
   static void
   effect_reject_origin(const event::initialize_run &runtime_ev,
@@ -6,6 +6,7 @@
 
 #include "emel/callback.hpp"
 #include "emel/error/error.hpp"
+#include "emel/memory/footprint.hpp"
 
 namespace emel::speech::generator::events {
 
@@ -191,6 +192,11 @@ struct wavefront_reset {
   emel::error::type &error_out;
 };
 
+// Fills `out` with the lane buffers the generator owns plus, when the
+// dependencies provide capture_memory_footprint(report &, probe), what their
+// collaborators hold; the generator itself never sees their models.
+using capture_memory_footprint = emel::memory::footprint::capture;
+
 struct initialize_ctx {
   emel::error::type err = {};
   emel::error::type child_err = {};
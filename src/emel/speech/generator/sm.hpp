@@ -535,6 +535,24 @@ template <class dependencies_type> struct duplex_model {
       , sml::state<state_errored> <= sml::state<state_errored>
           + sml::event<event::reset>
           / action::effect_reject_reset<dependencies_type, error::internal_error>{}
+      , sml::state<state_uninitialized> <= sml::state<state_uninitialized>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_condition_voice> <= sml::state<state_condition_voice>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_condition_prompt> <= sml::state<state_condition_prompt>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_ready> <= sml::state<state_ready>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_flushing> <= sml::state<state_flushing>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_errored> <= sml::state<state_errored>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
       , sml::state<state_errored> <= sml::state<state_uninitialized>
           + sml::unexpected_event<sml::_> / action::effect_unexpected<dependencies_type>{}
       , sml::state<state_errored> <= sml::state<state_condition_voice>
@@ -784,6 +802,15 @@ template <class dependencies_type> struct synthesis_model {
           / action::effect_reject_reset<dependencies_type, error::unsupported_request>{}
       , sml::state<state_errored> <= sml::state<state_errored> + sml::event<event::reset>
           / action::effect_reject_reset<dependencies_type, error::internal_error>{}
+      , sml::state<state_uninitialized> <= sml::state<state_uninitialized>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_ready> <= sml::state<state_ready>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_errored> <= sml::state<state_errored>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
       , sml::state<state_errored> <= sml::state<state_uninitialized>
           + sml::unexpected_event<sml::_> / action::effect_unexpected<dependencies_type>{}
       , sml::state<state_errored> <= sml::state<state_ready>
@@ -1747,6 +1774,33 @@ struct wavefront_model {
           sml::state<state_wavefront_reset_result> + sml::completion<event_reset>
           [ guard::guard_wavefront_reset_succeeded<dependencies_type>{} ]
           / action::effect_reset_wavefront_parent<dependencies_type>{}
+      , sml::state<state_wavefront_fill0> <= sml::state<state_wavefront_fill0>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_fill1_model0> <=
+          sml::state<state_wavefront_fill1_model0>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_steady_even> <= sml::state<state_wavefront_steady_even>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_steady_odd> <= sml::state<state_wavefront_steady_odd>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_final_decode_lane0> <=
+          sml::state<state_wavefront_final_decode_lane0>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_final_decode_lane1> <=
+          sml::state<state_wavefront_final_decode_lane1>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_complete> <= sml::state<state_wavefront_complete>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
+      , sml::state<state_wavefront_errored> <= sml::state<state_wavefront_errored>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint<dependencies_type>{}
       , sml::state<state_wavefront_errored> <= sml::state<state_wavefront_fill0>
           + sml::unexpected_event<sml::_>
           / action::effect_unexpected_wavefront<dependencies_type>{}
@@ -1881,6 +1935,10 @@ struct sm : private emel::sm<model<dependencies_type>,
         base_type::process_event(detail::event_wavefront_reset_run{ev, ctx});
     return accepted && ctx.err == action::error_code(error::none);
   }
+
+  bool process_event(const event::capture_memory_footprint &ev) {
+    return base_type::process_event(ev);
+  }
 };
 
 template <class dependencies_type>
@@ -250,6 +250,13 @@ struct effect_emit_recognize_error {
   }
 };
 
+struct effect_capture_memory_footprint {
+  void operator()(const event::capture_memory_footprint &ev,
+                  const context &ctx) const noexcept {
+    detail::capture_memory_footprint(ev, ctx);
+  }
+};
+
 struct effect_on_unexpected {
   template <class unexpected_event_type>
   void operator()(const unexpected_event_type &, context &) const noexcept {}
@@ -282,6 +289,8 @@ inline constexpr effect_store_recognize_success
 inline constexpr effect_store_recognize_error effect_store_recognize_error{};
 inline constexpr effect_emit_recognize_done effect_emit_recognize_done{};
 inline constexpr effect_emit_recognize_error effect_emit_recognize_error{};
+inline constexpr effect_capture_memory_footprint
+    effect_capture_memory_footprint{};
 inline constexpr effect_on_unexpected effect_on_unexpected{};
 
 } // namespace emel::speech::transcriber::action
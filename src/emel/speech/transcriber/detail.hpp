@@ -1,7 +1,10 @@
 #pragma once
 
 #include "emel/error/error.hpp"
+#include "emel/memory/footprint.hpp"
+#include "emel/speech/transcriber/context.hpp"
 #include "emel/speech/transcriber/errors.hpp"
+#include "emel/speech/transcriber/events.hpp"
 
 namespace emel::speech::transcriber::detail {
 
@@ -9,4 +12,23 @@ inline emel::error::type to_error(const error err) noexcept {
   return emel::error::cast(err);
 }
 
+// Whisper binds one model to both contracts; it is counted once.
+inline void capture_memory_footprint(const event::capture_memory_footprint &ev,
+                                     const action::context &ctx) noexcept {
+  const emel::model::data *encoder_model = ctx.deps.encoder_contract.model;
+  const emel::model::data *decoder_model = ctx.deps.decoder_contract.model;
+  ev.out = {};
+  if (encoder_model != nullptr) {
+    emel::memory::footprint::add_model(ev.out, *encoder_model, ev.residency);
+  }
+  if (decoder_model != nullptr && decoder_model != encoder_model) {
+    emel::memory::footprint::add_model(ev.out, *decoder_model, ev.residency);
+  }
+  ev.out.scratch_bytes = ev.storage.encoder_workspace.size_bytes() +
+                         ev.storage.encoder_state.size_bytes() +
+                         ev.storage.decoder_workspace.size_bytes() +
+                         ev.storage.logits.size_bytes() +
+                         ev.storage.generated_tokens.size_bytes();
+}
+
 } // namespace emel::speech::transcriber::detail
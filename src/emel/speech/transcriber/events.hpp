@@ -6,6 +6,7 @@
 
 #include "emel/callback.hpp"
 #include "emel/error/error.hpp"
+#include "emel/memory/footprint.hpp"
 #include "emel/model/data.hpp"
 #include "emel/speech/transcriber/errors.hpp"
 
@@ -186,6 +187,21 @@ struct recognize_run {
   recognize_ctx &ctx;
 };
 
+// Resident bytes of the transcriber by holder. The encoder and decoder models
+// are read in place; `storage` is the runtime storage the owner hands to
+// recognize, reported as scratch since the transcriber owns no buffers of its
+// own.
+struct capture_memory_footprint : emel::memory::footprint::capture {
+  explicit capture_memory_footprint(
+      emel::memory::footprint::report &out_ref,
+      const emel::memory::footprint::probe residency_in = {},
+      const runtime_storage storage_in = {}) noexcept
+      : emel::memory::footprint::capture(out_ref, residency_in),
+        storage(storage_in) {}
+
+  runtime_storage storage = {};
+};
+
 } // namespace emel::speech::transcriber::event
 
 namespace emel::speech::transcriber::events {
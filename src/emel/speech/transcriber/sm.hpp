@@ -264,6 +264,18 @@ struct model {
           sml::state<state_recognize_errored_error_callback_decision>
           + sml::completion<event::recognize_run> [ guard::guard_no_recognize_error_callback{} ]
 
+      //------------------------------------------------------------------------------//
+      // Footprint capture.
+      , sml::state<state_uninitialized> <= sml::state<state_uninitialized>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint
+      , sml::state<state_ready> <= sml::state<state_ready>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint
+      , sml::state<state_errored> <= sml::state<state_errored>
+          + sml::event<event::capture_memory_footprint>
+          / action::effect_capture_memory_footprint
+
       //------------------------------------------------------------------------------//
       // Unexpected events.
       , sml::state<state_uninitialized> <= sml::state<state_uninitialized>
@@ -312,6 +324,10 @@ struct sm : public emel::sm<model, action::context> {
     return accepted && ctx.err == detail::to_error(error::none);
   }
 
+  bool process_event(const event::capture_memory_footprint &ev) {
+    return base_type::process_event(ev);
+  }
+
 private:
   speech::encoder::any encoder_;
   speech::decoder::any decoder_;
@@ -1,8 +1,10 @@
 #pragma once
 
+#include <algorithm>
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string_view>
 
 #include "emel/text/detokenizer/context.hpp"
@@ -68,6 +70,31 @@ inline std::string_view token_piece(const event::detokenize & ev,
                           entry.text_length);
 }
 
+inline piece_entry resolve_piece(const emel::model::data::vocab & vocab,
+                                 const uint32_t token_id) noexcept {
+  const auto & entry = vocab.entries[token_id];
+  const std::string_view piece(vocab.token_storage.data() + entry.text_offset,
+                               entry.text_length);
+  uint8_t byte_value = 0;
+  const bool byte_piece = parse_plamo2_byte_token(piece, byte_value);
+  const bool special = is_special_token_type(entry.type);
+  piece_entry resolved = {};
+  resolved.offset = static_cast<uint32_t>(byte_piece) * static_cast<uint32_t>(byte_value) +
+                    static_cast<uint32_t>(!byte_piece) * entry.text_offset;
+  resolved.length = (entry.text_length & k_piece_length_mask) |
+                    static_cast<uint32_t>(special) * k_piece_special |
+                    static_cast<uint32_t>(byte_piece) * k_piece_byte;
+  return resolved;
+}
+
+inline void resolve_pieces(const emel::model::data::vocab & vocab,
+                           piece_entry * out,
+                           const uint32_t count) noexcept {
+  for (uint32_t id = 0; id < count; ++id) {
+    out[id] = resolve_piece(vocab, id);
+  }
+}
+
 inline void clear_request(context &) noexcept {}
 
 inline size_t read_output_length(const event::detokenize & ev) noexcept {
@@ -127,6 +154,8 @@ inline void reject_bind(const event::bind & ev, context & ctx) noexcept {
 }
 
 inline void commit_bind(const event::bind & ev, context & ctx) noexcept {
+  ctx.pieces = ctx.vocab->pieces.data();
+  ctx.piece_count = ctx.vocab->n_pieces;
   ctx.is_bound = true;
   set_bind_error(ev, error_code(error::none));
 }
@@ -244,6 +273,151 @@ inline void notify_detokenize_error(const event::detokenize & ev) noexcept {
   (void)ev.dispatch_error(ev.owner_sm, events::detokenize_error{ev, ev.error_out});
 }
 
+struct batch_cursor {
+  size_t output_length = 0;
+  size_t pending_length = 0;
+  size_t token_count = 0;
+  int32_t err = error_code(error::none);
+  bool live = true;
+};
+
+inline void fail_batch(batch_cursor & cursor, const bool failed, const int32_t err) noexcept {
+  cursor.err = static_cast<int32_t>(failed) * err + static_cast<int32_t>(!failed) * cursor.err;
+  cursor.live = cursor.live && !failed;
+}
+
+inline bool pending_continuations_valid(const uint8_t * pending, const size_t needed) noexcept {
+  bool continuation_ok = true;
+  for (size_t idx = 1; idx < needed; ++idx) {
+    continuation_ok = continuation_ok && is_utf8_continuation(pending[idx]);
+  }
+  return continuation_ok;
+}
+
+// Moves the pending head sequence to the output once it is complete and valid.
+// A complete sequence that does not fit fails the batch.
+inline void flush_pending_head(const event::detokenize_batch & ev,
+                               char * output,
+                               const bool active,
+                               batch_cursor & cursor) noexcept {
+  const size_t needed = utf8_sequence_length(ev.pending_bytes[0]);
+  const bool complete = active && cursor.live && cursor.pending_length != 0 && needed != 0 &&
+                        cursor.pending_length >= needed &&
+                        pending_continuations_valid(ev.pending_bytes, needed);
+  const bool fits = cursor.output_length + needed <= ev.output_capacity;
+  const size_t written = needed * static_cast<size_t>(complete && fits);
+  std::memcpy(output + cursor.output_length, ev.pending_bytes, written);
+  const size_t remaining = cursor.pending_length - written;
+  for (size_t i = 0; i < remaining; ++i) {
+    ev.pending_bytes[i] = ev.pending_bytes[i + written];
+  }
+  cursor.output_length += written;
+  cursor.pending_length = remaining;
+  fail_batch(cursor, complete && !fits, error_code(error::invalid_request));
+}
+
+// One token of a batch, with the same outcome as a single `detokenize`
+// dispatch. Once the cursor is no longer live every write is masked off, so
+// the first failing token keeps its error and the output before it.
+inline void gather_batch_token(const event::detokenize_batch & ev,
+                               const context & ctx,
+                               char * output,
+                               const int32_t token_id,
+                               batch_cursor & cursor) noexcept {
+  const bool in_vocab =
+      token_id >= 0 && static_cast<uint32_t>(token_id) < ctx.piece_count;
+  fail_batch(cursor, cursor.live && !in_vocab, error_code(error::model_invalid));
+
+  const piece_entry entry =
+      ctx.pieces[static_cast<uint32_t>(token_id) * static_cast<uint32_t>(in_vocab)];
+  const bool skip = (entry.length & k_piece_special) != 0u && !ev.emit_special;
+  const bool byte_piece = !skip && (entry.length & k_piece_byte) != 0u;
+  const bool text_piece = !skip && (entry.length & k_piece_byte) == 0u;
+
+  fail_batch(cursor,
+             cursor.live && byte_piece && cursor.pending_length >= ev.pending_capacity,
+             error_code(error::invalid_request));
+  const bool append = cursor.live && byte_piece;
+  const size_t append_index = cursor.pending_length * static_cast<size_t>(append);
+  ev.pending_bytes[append_index] = static_cast<uint8_t>(
+      static_cast<uint32_t>(append) * entry.offset +
+      static_cast<uint32_t>(!append) * ev.pending_bytes[append_index]);
+  cursor.pending_length += static_cast<size_t>(append);
+
+  const bool active = byte_piece || text_piece;
+  for (size_t pass = 0; pass < k_utf8_max_sequence_length; ++pass) {
+    flush_pending_head(ev, output, active, cursor);
+  }
+
+  const size_t needed = utf8_sequence_length(ev.pending_bytes[0]);
+  const bool head_invalid =
+      cursor.pending_length != 0 &&
+      (needed == 0 || (cursor.pending_length >= needed &&
+                       !pending_continuations_valid(ev.pending_bytes, needed)));
+  fail_batch(cursor, cursor.live && active && head_invalid,
+             error_code(error::invalid_request));
+  fail_batch(cursor, cursor.live && text_piece && cursor.pending_length != 0,
+             error_code(error::invalid_request));
+
+  const size_t length = static_cast<size_t>(entry.length & k_piece_length_mask);
+  const bool fits = cursor.output_length + length <= ev.output_capacity;
+  fail_batch(cursor, cursor.live && text_piece && length != 0 && !fits,
+             error_code(error::invalid_request));
+  const size_t written = length * static_cast<size_t>(cursor.live && text_piece);
+  std::memcpy(output + cursor.output_length,
+              ctx.vocab->token_storage.data() + entry.offset,
+              written);
+  cursor.output_length += written;
+  cursor.token_count += static_cast<size_t>(cursor.live);
+}
+
+inline void set_detokenize_batch_result(const event::detokenize_batch & ev,
+                                        const batch_cursor & cursor) noexcept {
+  ev.output_length_out = cursor.output_length;
+  ev.pending_length_out = cursor.pending_length;
+  ev.token_count_out = cursor.token_count;
+  ev.error_out = cursor.err;
+}
+
+inline void begin_detokenize_batch(const event::detokenize_batch & ev) noexcept {
+  batch_cursor cursor = {};
+  cursor.pending_length = ev.pending_length;
+  set_detokenize_batch_result(ev, cursor);
+}
+
+inline void reject_detokenize_batch(const event::detokenize_batch & ev) noexcept {
+  batch_cursor cursor = {};
+  cursor.pending_length = ev.pending_length;
+  cursor.err = error_code(error::invalid_request);
+  set_detokenize_batch_result(ev, cursor);
+}
+
+inline void gather_detokenize_batch(const event::detokenize_batch & ev,
+                                    const context & ctx) noexcept {
+  batch_cursor cursor = {};
+  cursor.pending_length = ev.pending_length;
+  char scratch = 0;
+  const std::array<char *, 2> output_candidates = {&scratch, ev.output};
+  char * output = output_candidates[static_cast<size_t>(ev.output != nullptr)];
+  for (const int32_t token_id : ev.token_ids) {
+    gather_batch_token(ev, ctx, output, token_id, cursor);
+  }
+  set_detokenize_batch_result(ev, cursor);
+}
+
+inline void notify_detokenize_batch_done(const event::detokenize_batch & ev) noexcept {
+  (void)ev.dispatch_done(ev.owner_sm,
+                         events::detokenize_batch_done{ev,
+                                                       ev.output_length_out,
+                                                       ev.pending_length_out,
+                                                       ev.token_count_out});
+}
+
+inline void notify_detokenize_batch_error(const event::detokenize_batch & ev) noexcept {
+  (void)ev.dispatch_error(
+      ev.owner_sm, events::detokenize_batch_error{ev, ev.error_out, ev.token_count_out});
+}
+
 template <class event_type>
 inline void on_unexpected(const event_type & ev) noexcept {
   (void)ev;
@@ -379,6 +553,36 @@ struct notify_detokenize_error {
   }
 };
 
+struct begin_detokenize_batch {
+  void operator()(const event::detokenize_batch & ev) const noexcept {
+    detail::begin_detokenize_batch(ev);
+  }
+};
+
+struct reject_detokenize_batch {
+  void operator()(const event::detokenize_batch & ev) const noexcept {
+    detail::reject_detokenize_batch(ev);
+  }
+};
+
+struct gather_detokenize_batch {
+  void operator()(const event::detokenize_batch & ev, const context & ctx) const noexcept {
+    detail::gather_detokenize_batch(ev, ctx);
+  }
+};
+
+struct notify_detokenize_batch_done {
+  void operator()(const event::detokenize_batch & ev) const noexcept {
+    detail::notify_detokenize_batch_done(ev);
+  }
+};
+
+struct notify_detokenize_batch_error {
+  void operator()(const event::detokenize_batch & ev) const noexcept {
+    detail::notify_detokenize_batch_error(ev);
+  }
+};
+
 struct on_unexpected {
   template <class event_type>
   void operator()(const event_type & ev, context &) const noexcept {
@@ -404,6 +608,11 @@ inline constexpr notify_bind_done notify_bind_done{};
 inline constexpr notify_bind_error notify_bind_error{};
 inline constexpr notify_detokenize_done notify_detokenize_done{};
 inline constexpr notify_detokenize_error notify_detokenize_error{};
+inline constexpr begin_detokenize_batch begin_detokenize_batch{};
+inline constexpr reject_detokenize_batch reject_detokenize_batch{};
+inline constexpr gather_detokenize_batch gather_detokenize_batch{};
+inline constexpr notify_detokenize_batch_done notify_detokenize_batch_done{};
+inline constexpr notify_detokenize_batch_error notify_detokenize_batch_error{};
 inline constexpr on_unexpected on_unexpected{};
 
 }  // namespace emel::text::detokenizer::action
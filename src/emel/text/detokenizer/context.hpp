@@ -8,9 +8,27 @@
 
 namespace emel::text::detokenizer::action {
 
+// One entry per vocab token, so batch detokenization is a table gather
+// instead of a per-token piece parse.
+using piece_entry = emel::model::data::vocab_piece;
+
+inline constexpr uint32_t k_piece_length_mask = 0x00FFFFFFu;
+inline constexpr uint32_t k_piece_special = 1u << 24;
+inline constexpr uint32_t k_piece_byte = 1u << 25;
+
+static_assert(static_cast<uint32_t>(emel::model::data::k_max_vocab_bytes) <=
+                  k_piece_length_mask,
+              "piece length must fit below the piece flags");
+
 struct context {
   const emel::model::data::vocab * vocab = nullptr;
   bool is_bound = false;
+
+  // Piece table the loader stored in the bound vocab, shared by every
+  // detokenizer. piece_count stays 0 for a vocab assembled without the loader
+  // until the owner runs detail::prepare_piece_table on it.
+  const piece_entry * pieces = nullptr;
+  uint32_t piece_count = 0;
 };
 
 }  // namespace emel::text::detokenizer::action
@@ -1,3 +1,17 @@
 #pragma once
 
+#include <cstdint>
+
+#include "emel/model/data.hpp"
 #include "emel/text/detokenizer/actions.hpp"
+
+namespace emel::text::detokenizer::detail {
+
+// Resolves the vocab's token->piece table once, at load, so every
+// detokenizer bound to the vocab gathers from the same table.
+inline void prepare_piece_table(emel::model::data::vocab & vocab) noexcept {
+  action::detail::resolve_pieces(vocab, vocab.pieces.data(), vocab.n_tokens);
+  vocab.n_pieces = vocab.n_tokens;
+}
+
+}  // namespace emel::text::detokenizer::detail
@@ -2,6 +2,7 @@
 
 #include <cstddef>
 #include <cstdint>
+#include <span>
 
 #include "emel/model/data.hpp"
 
@@ -11,6 +12,8 @@ struct binding_done;
 struct binding_error;
 struct detokenize_done;
 struct detokenize_error;
+struct detokenize_batch_done;
+struct detokenize_batch_error;
 
 }  // namespace emel::text::detokenizer::events
 
@@ -82,6 +85,60 @@ struct detokenize {
         dispatch_error(dispatch_error_in) {}
 };
 
+// Detokenizes a run of token ids in one dispatch. The result matches sending
+// each id as its own `detokenize` with the output written back to back and the
+// pending buffer threaded through; on error, everything before the failing
+// token is kept and `token_count_out` is its index.
+struct detokenize_batch {
+  std::span<const int32_t> token_ids;
+  bool emit_special;
+  uint8_t * pending_bytes;
+  size_t pending_length;
+  size_t pending_capacity;
+  char * output;
+  size_t output_capacity;
+  size_t & output_length_out;
+  size_t & pending_length_out;
+  size_t & token_count_out;
+  int32_t & error_out;
+  void * owner_sm = nullptr;
+  bool (*dispatch_done)(void * owner_sm,
+                        const events::detokenize_batch_done &) = nullptr;
+  bool (*dispatch_error)(void * owner_sm,
+                         const events::detokenize_batch_error &) = nullptr;
+
+  detokenize_batch(std::span<const int32_t> token_ids_in,
+                   bool emit_special_in,
+                   uint8_t * pending_bytes_in,
+                   size_t pending_length_in,
+                   size_t pending_capacity_in,
+                   char * output_in,
+                   size_t output_capacity_in,
+                   size_t & output_length_out_in,
+                   size_t & pending_length_out_in,
+                   size_t & token_count_out_in,
+                   int32_t & error_out_in,
+                   void * owner_sm_in = nullptr,
+                   bool (*dispatch_done_in)(void *, const events::detokenize_batch_done &) =
+                       nullptr,
+                   bool (*dispatch_error_in)(void *, const events::detokenize_batch_error &) =
+                       nullptr) noexcept
+      : token_ids(token_ids_in),
+        emit_special(emit_special_in),
+        pending_bytes(pending_bytes_in),
+        pending_length(pending_length_in),
+        pending_capacity(pending_capacity_in),
+        output(output_in),
+        output_capacity(output_capacity_in),
+        output_length_out(output_length_out_in),
+        pending_length_out(pending_length_out_in),
+        token_count_out(token_count_out_in),
+        error_out(error_out_in),
+        owner_sm(owner_sm_in),
+        dispatch_done(dispatch_done_in),
+        dispatch_error(dispatch_error_in) {}
+};
+
 }  // namespace emel::text::detokenizer::event
 
 namespace emel::text::detokenizer::events {
@@ -106,4 +163,17 @@ struct detokenize_error {
   int32_t err;
 };
 
+struct detokenize_batch_done {
+  const event::detokenize_batch & request;
+  size_t output_length;
+  size_t pending_length;
+  size_t token_count;
+};
+
+struct detokenize_batch_error {
+  const event::detokenize_batch & request;
+  int32_t err;
+  size_t token_index;
+};
+
 }  // namespace emel::text::detokenizer::events
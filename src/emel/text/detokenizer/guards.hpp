@@ -17,6 +17,10 @@ inline int32_t runtime_error(const event::detokenize & ev) noexcept {
   return ev.error_out;
 }
 
+inline int32_t runtime_error(const event::detokenize_batch & ev) noexcept {
+  return ev.error_out;
+}
+
 inline bool error_is(const int32_t runtime_err, const error expected) noexcept {
   return runtime_err == error_code(expected);
 }
@@ -64,7 +68,8 @@ struct invalid_bind {
 struct valid_detokenize {
   bool operator()(const event::detokenize & ev,
                   const action::context & ctx) const noexcept {
-    return ctx.is_bound && ctx.vocab != nullptr && ev.pending_bytes != nullptr &&
+    return ctx.is_bound && ctx.vocab != nullptr && ctx.vocab->pieces.materialized() &&
+           ctx.piece_count == ctx.vocab->n_tokens && ev.pending_bytes != nullptr &&
            ev.pending_capacity == action::detail::k_utf8_max_sequence_length &&
            ev.pending_length <= ev.pending_capacity &&
            (ev.output != nullptr || ev.output_capacity == 0);
@@ -139,6 +144,37 @@ struct detokenize_pending_no_capacity_for_byte {
   }
 };
 
+struct valid_detokenize_batch {
+  bool operator()(const event::detokenize_batch & ev,
+                  const action::context & ctx) const noexcept {
+    return ctx.is_bound && ctx.vocab != nullptr && ctx.vocab->pieces.materialized() &&
+           ctx.piece_count == ctx.vocab->n_tokens && ev.pending_bytes != nullptr &&
+           ev.pending_capacity == action::detail::k_utf8_max_sequence_length &&
+           ev.pending_length <= ev.pending_capacity &&
+           (ev.output != nullptr || ev.output_capacity == 0) &&
+           (ev.token_ids.data() != nullptr || ev.token_ids.empty());
+  }
+};
+
+struct invalid_detokenize_batch {
+  bool operator()(const event::detokenize_batch & ev,
+                  const action::context & ctx) const noexcept {
+    return !valid_detokenize_batch{}(ev, ctx);
+  }
+};
+
+struct detokenize_batch_error_none {
+  bool operator()(const event::detokenize_batch & ev) const noexcept {
+    return error_is(runtime_error(ev), error::none);
+  }
+};
+
+struct detokenize_batch_error_reported {
+  bool operator()(const event::detokenize_batch & ev) const noexcept {
+    return !error_is(runtime_error(ev), error::none);
+  }
+};
+
 struct bind_error_none {
   bool operator()(const event::bind & ev) const noexcept {
     return error_is(runtime_error(ev), error::none);
@@ -312,4 +348,28 @@ struct no_detokenize_error_callback {
   }
 };
 
+struct has_detokenize_batch_done_callback {
+  bool operator()(const event::detokenize_batch & ev) const noexcept {
+    return ev.dispatch_done != nullptr && ev.owner_sm != nullptr;
+  }
+};
+
+struct no_detokenize_batch_done_callback {
+  bool operator()(const event::detokenize_batch & ev) const noexcept {
+    return !has_detokenize_batch_done_callback{}(ev);
+  }
+};
+
+struct has_detokenize_batch_error_callback {
+  bool operator()(const event::detokenize_batch & ev) const noexcept {
+    return ev.dispatch_error != nullptr && ev.owner_sm != nullptr;
+  }
+};
+
+struct no_detokenize_batch_error_callback {
+  bool operator()(const event::detokenize_batch & ev) const noexcept {
+    return !has_detokenize_batch_error_callback{}(ev);
+  }
+};
+
 }  // namespace emel::text::detokenizer::guard
@@ -36,6 +36,13 @@ design doc: docs/designs/text/detokenizer.design.md
      the output buffer capacity, and optional synchronous callbacks (`dispatch_done`, `dispatch_error`).
    - outputs: writes utf-8 bytes to the output buffer, updates the pending byte buffer state, and
      invokes the appropriate callback before returning, completely avoiding context-reading race conditions.
+ - `event::detokenize_batch`
+   - inputs: a span of token ids plus the same pending buffer, output buffer, and callbacks.
+   - outputs: the bytes of the whole batch in one dispatch, identical to one `event::detokenize`
+     per id written back to back. pieces come from the token→piece table the loader stores in
+     the vocab (special and byte-fallback classification included), shared by every detokenizer
+     bound to it, so text pieces are a memcpy gather. a vocab assembled without the loader must
+     have its table prepared (`detail::prepare_piece_table`) before bind, or batches are rejected.
  
  ## state model
  
@@ -98,6 +105,8 @@ struct decode_text_pending_decision {};
 struct decode_text_pending_write {};
 struct decode_text_write {};
 struct decode_decision {};
+struct decoding_batch {};
+struct decode_batch_decision {};
 struct detokenize_done_decision {};
 struct detokenize_done_callback {};
 struct detokenize_error_decision {};
@@ -115,6 +124,7 @@ struct unexpected {};
  * - `binding_*_callback`: synchronous callback delivery before terminal state.
  * - `idle`: ready for detokenize requests.
  * - `decoding`/`decode_*`: explicit detokenize phases and branch decisions.
+ * - `decoding_batch`/`decode_batch_decision`: one gather over a batch of token ids.
  * - `detokenize_*_callback`: synchronous callback delivery before terminal state.
  * - `done`/`errored`: terminal outcomes for the latest request.
  * - `unexpected`: sequencing contract violation.
@@ -126,6 +136,7 @@ struct unexpected {};
  * action side effects:
  * - `begin_detokenize` initializes request output fields.
  * - `append_byte_piece`/`write_pending_head_sequence`/`write_text_piece` execute decode kernels.
+ * - `gather_detokenize_batch` runs the batch kernel over the vocab's piece table.
  * - `mark_done` finalizes success terminal status.
  */
 struct model {
@@ -142,6 +153,8 @@ struct model {
                    [ guard::invalid_bind{} ] / action::reject_bind
       , sml::state<detokenize_error_decision> <= sml::state<uninitialized> + sml::event<event::detokenize>
                    / action::reject_detokenize
+      , sml::state<detokenize_error_decision> <= sml::state<uninitialized>
+                   + sml::event<event::detokenize_batch> / action::reject_detokenize_batch
 
       , sml::state<binding> <= sml::state<idle> + sml::event<event::bind>
                    [ guard::valid_bind{} ] / action::begin_bind
@@ -151,6 +164,11 @@ struct model {
                    [ guard::valid_detokenize{} ] / action::begin_detokenize
       , sml::state<detokenize_error_decision> <= sml::state<idle> + sml::event<event::detokenize>
                    [ guard::invalid_detokenize{} ] / action::reject_detokenize
+      , sml::state<decoding_batch> <= sml::state<idle> + sml::event<event::detokenize_batch>
+                   [ guard::valid_detokenize_batch{} ] / action::begin_detokenize_batch
+      , sml::state<detokenize_error_decision> <= sml::state<idle>
+                   + sml::event<event::detokenize_batch>
+                   [ guard::invalid_detokenize_batch{} ] / action::reject_detokenize_batch
 
       , sml::state<binding> <= sml::state<done> + sml::event<event::bind>
                    [ guard::valid_bind{} ] / action::begin_bind
@@ -160,6 +178,11 @@ struct model {
                    [ guard::valid_detokenize{} ] / action::begin_detokenize
       , sml::state<detokenize_error_decision> <= sml::state<done> + sml::event<event::detokenize>
                    [ guard::invalid_detokenize{} ] / action::reject_detokenize
+      , sml::state<decoding_batch> <= sml::state<done> + sml::event<event::detokenize_batch>
+                   [ guard::valid_detokenize_batch{} ] / action::begin_detokenize_batch
+      , sml::state<detokenize_error_decision> <= sml::state<done>
+                   + sml::event<event::detokenize_batch>
+                   [ guard::invalid_detokenize_batch{} ] / action::reject_detokenize_batch
 
       , sml::state<binding> <= sml::state<errored> + sml::event<event::bind>
                    [ guard::valid_bind{} ] / action::begin_bind
@@ -169,6 +192,11 @@ struct model {
                    [ guard::valid_detokenize{} ] / action::begin_detokenize
       , sml::state<detokenize_error_decision> <= sml::state<errored> + sml::event<event::detokenize>
                    [ guard::invalid_detokenize{} ] / action::reject_detokenize
+      , sml::state<decoding_batch> <= sml::state<errored> + sml::event<event::detokenize_batch>
+                   [ guard::valid_detokenize_batch{} ] / action::begin_detokenize_batch
+      , sml::state<detokenize_error_decision> <= sml::state<errored>
+                   + sml::event<event::detokenize_batch>
+                   [ guard::invalid_detokenize_batch{} ] / action::reject_detokenize_batch
 
       , sml::state<binding> <= sml::state<unexpected> + sml::event<event::bind>
                    [ guard::valid_bind{} ] / action::begin_bind
@@ -178,6 +206,11 @@ struct model {
                    [ guard::valid_detokenize{} ] / action::begin_detokenize
       , sml::state<detokenize_error_decision> <= sml::state<unexpected> + sml::event<event::detokenize>
                    [ guard::invalid_detokenize{} ] / action::reject_detokenize
+      , sml::state<decoding_batch> <= sml::state<unexpected> + sml::event<event::detokenize_batch>
+                   [ guard::valid_detokenize_batch{} ] / action::begin_detokenize_batch
+      , sml::state<detokenize_error_decision> <= sml::state<unexpected>
+                   + sml::event<event::detokenize_batch>
+                   [ guard::invalid_detokenize_batch{} ] / action::reject_detokenize_batch
 
       //------------------------------------------------------------------------------//
       // Internal-state reentry rejection via unexpected external requests.
@@ -378,6 +411,33 @@ struct model {
                    [ guard::no_detokenize_error_callback{} ]
       , sml::state<errored> <= sml::state<detokenize_error_callback> + sml::completion<event::detokenize>
 
+      , sml::state<decode_batch_decision> <= sml::state<decoding_batch>
+                   + sml::completion<event::detokenize_batch> / action::gather_detokenize_batch
+      , sml::state<detokenize_done_decision> <= sml::state<decode_batch_decision>
+                   + sml::completion<event::detokenize_batch>
+                   [ guard::detokenize_batch_error_none{} ]
+      , sml::state<detokenize_error_decision> <= sml::state<decode_batch_decision>
+                   + sml::completion<event::detokenize_batch>
+                   [ guard::detokenize_batch_error_reported{} ]
+      , sml::state<detokenize_done_callback> <= sml::state<detokenize_done_decision>
+                   + sml::completion<event::detokenize_batch>
+                   [ guard::has_detokenize_batch_done_callback{} ]
+      , sml::state<done> <= sml::state<detokenize_done_decision>
+                   + sml::completion<event::detokenize_batch>
+                   [ guard::no_detokenize_batch_done_callback{} ]
+      , sml::state<done> <= sml::state<detokenize_done_callback>
+                   + sml::completion<event::detokenize_batch>
+                   / action::notify_detokenize_batch_done
+      , sml::state<detokenize_error_callback> <= sml::state<detokenize_error_decision>
+                   + sml::completion<event::detokenize_batch>
+                   [ guard::has_detokenize_batch_error_callback{} ]
+                   / action::notify_detokenize_batch_error
+      , sml::state<errored> <= sml::state<detokenize_error_decision>
+                   + sml::completion<event::detokenize_batch>
+                   [ guard::no_detokenize_batch_error_callback{} ]
+      , sml::state<errored> <= sml::state<detokenize_error_callback>
+                   + sml::completion<event::detokenize_batch>
+
       //------------------------------------------------------------------------------//
       // Unexpected events.
       , sml::state<unexpected> <= sml::state<uninitialized> + sml::unexpected_event<sml::_>
@@ -416,6 +476,10 @@ struct model {
                    / action::on_unexpected
       , sml::state<unexpected> <= sml::state<decode_decision> + sml::unexpected_event<sml::_>
                    / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<decoding_batch> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<decode_batch_decision> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
       , sml::state<unexpected> <= sml::state<detokenize_done_decision> + sml::unexpected_event<sml::_>
                    / action::on_unexpected
       , sml::state<unexpected> <= sml::state<detokenize_done_callback> + sml::unexpected_event<sml::_>
@@ -456,6 +520,14 @@ struct sm : public emel::sm<model, action::context> {
     return accepted & at_done;
   }
 
+  bool process_event(const event::detokenize_batch & ev) {
+    namespace sml = stateforward::sml;
+
+    const bool accepted = base_type::process_event(ev);
+    const bool at_done = this->is(sml::state<done>);
+    return accepted & at_done;
+  }
+
   using base_type::process_event;
   using base_type::is;
   using base_type::visit_current_states;
@@ -54,6 +54,15 @@ struct run_encode_merge_path {
   }
 };
 
+struct run_encode_cached_word {
+  void operator()(const event::encode_runtime & ev, context & ctx) const noexcept {
+    const auto result = emel::text::encoders::bpe::detail::encode_bpe_cached_word(
+      ev.request, ctx);
+    ev.ctx.token_count = result.token_count;
+    ev.ctx.err = result.error;
+  }
+};
+
 struct mark_done {
   void operator()(const event::encode_runtime & ev, context & ctx) const noexcept {
     emel::text::encoders::action::mark_done(ev, ctx);
@@ -79,6 +88,7 @@ inline constexpr reject_invalid_encode reject_invalid_encode{};
 inline constexpr prepare_tables prepare_tables{};
 inline constexpr run_encode_ignore_merges run_encode_ignore_merges{};
 inline constexpr run_encode_merge_path run_encode_merge_path{};
+inline constexpr run_encode_cached_word run_encode_cached_word{};
 inline constexpr mark_done mark_done{};
 inline constexpr ensure_last_error ensure_last_error{};
 inline constexpr on_unexpected on_unexpected{};
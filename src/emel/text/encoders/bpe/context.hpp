@@ -5,6 +5,8 @@
 namespace emel::text::encoders::bpe::action {
 
 struct context : emel::text::encoders::action::context {
+  detail::bpe_merge_heap merge_heap = {};
+  detail::bpe_word_cache word_cache = {};
 };
 
 }  // namespace emel::text::encoders::bpe::action
@@ -4,6 +4,7 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <utility>
 
 #include "emel/model/data.hpp"
 #include "emel/text/encoders/bpe/context.hpp"
@@ -108,40 +109,6 @@ inline bool bpe_merge_match(const std::string_view merge,
   return has_space && size_ok && left_view == left && right_view == right;
 }
 
-inline bool bpe_insert_token_map(emel::text::encoders::detail::token_map &map,
-                                 const emel::model::data::vocab &vocab,
-                                 const std::string_view text,
-                                 const int32_t id) noexcept {
-  const bool text_empty = text.empty();
-  bool done = text_empty;
-  bool success = text_empty;
-  const uint32_t hash = bpe_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = map.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t existing_id = map.values[slot];
-    const std::string_view existing_text = bpe_token_text(vocab, existing_id);
-    const bool same_text = hash_match && existing_text == text;
-    const bool claim_slot = empty_slot || same_text;
-
-    map.hashes[slot] = select_u32(claim_slot, hash, slot_hash);
-    map.values[slot] = select_i32(claim_slot, id, existing_id);
-    map.count += static_cast<uint32_t>(claim_slot && empty_slot);
-
-    success = success || claim_slot;
-    done = done || claim_slot;
-    slot = (slot + 1u) & mask;
-  }
-
-  return success;
-}
-
 inline bool
 bpe_insert_merge_map(emel::text::encoders::detail::merge_map &map,
                      const std::string_view left, const std::string_view right,
@@ -180,30 +147,8 @@ bpe_insert_merge_map(emel::text::encoders::detail::merge_map &map,
 inline int32_t
 bpe_lookup_token(const emel::text::encoders::bpe::action::context &ctx,
                  const std::string_view text) noexcept {
-  const bool has_vocab = ctx.vocab != nullptr;
-  const emel::model::data::vocab * vocab = ctx.vocab;
-  const bool active = has_vocab && !text.empty();
-  bool done = !active;
-  int32_t resolved = k_token_null;
-  const uint32_t hash = bpe_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const bool exact = hash_match && bpe_token_text(*vocab, id) == text;
-
-    resolved = select_i32(exact, id, resolved);
-    done = done || empty_slot || exact;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  const bool active = ctx.vocab != nullptr && !text.empty();
+  return select_i32(active, ctx.token_trie.find(text), k_token_null);
 }
 
 inline int32_t
@@ -335,22 +280,12 @@ inline bool bpe_push_token_if(const bool emit_token, const event::encode &ev,
 
 inline bool
 rebuild_bpe_tables(emel::text::encoders::bpe::action::context &ctx) noexcept {
-  bool ok = true;
-  ctx.token_to_id.clear();
   ctx.bpe_ranks.clear();
-  ctx.max_token_len = 0;
+  ctx.word_cache.clear();
 
   const emel::model::data::vocab &vocab = *ctx.vocab;
-  for (uint32_t id = 0; id < vocab.n_tokens; ++id) {
-    const std::string_view text =
-        bpe_token_text(vocab, static_cast<int32_t>(id));
-    const bool inserted = bpe_insert_token_map(ctx.token_to_id, vocab, text,
-                                               static_cast<int32_t>(id));
-    ok = ok && inserted;
-    const int32_t text_len = static_cast<int32_t>(text.size());
-    const bool longer = text_len > ctx.max_token_len;
-    ctx.max_token_len = select_i32(longer, text_len, ctx.max_token_len);
-  }
+  const bool ok = emel::text::encoders::detail::bind_token_trie(ctx.token_trie, vocab);
+  ctx.max_token_len = static_cast<int32_t>(ctx.token_trie.max_key_length);
 
   for (uint32_t idx = 0; idx < vocab.n_merges; ++idx) {
     const std::string_view merge =
@@ -394,6 +329,117 @@ ensure_bpe_tables(emel::text::encoders::bpe::action::context &ctx) noexcept {
   return has_vocab && ready;
 }
 
+inline bool bpe_heap_less(const emel::text::encoders::detail::bpe_bigram &lhs,
+                          const emel::text::encoders::detail::bpe_bigram &rhs) noexcept {
+  return lhs.rank < rhs.rank || (lhs.rank == rhs.rank && lhs.left < rhs.left);
+}
+
+inline size_t
+bpe_heap_min_child(const emel::text::encoders::detail::bpe_merge_heap &heap,
+                   const size_t idx) noexcept {
+  const size_t left_child = idx * 2u + 1u;
+  const size_t right_child = left_child + 1u;
+  const bool has_left = left_child < heap.count;
+  const bool has_right = right_child < heap.count;
+  const size_t safe_left = select_size(has_left, left_child, idx);
+  const size_t safe_right = select_size(has_right, right_child, idx);
+  const bool left_wins =
+      has_left && bpe_heap_less(heap.entries[safe_left], heap.entries[idx]);
+  const size_t best = select_size(left_wins, safe_left, idx);
+  const bool right_wins =
+      has_right && bpe_heap_less(heap.entries[safe_right], heap.entries[best]);
+  return select_size(right_wins, safe_right, best);
+}
+
+inline void bpe_heap_push(emel::text::encoders::detail::bpe_merge_heap &heap,
+                          const bool push,
+                          const emel::text::encoders::detail::bpe_bigram &entry) noexcept {
+  const bool has_space =
+      heap.count < emel::text::encoders::detail::k_bpe_merge_heap_capacity;
+  const bool write = push && has_space;
+  const size_t slot = select_size(
+      write, heap.count, emel::text::encoders::detail::k_bpe_merge_heap_capacity);
+  heap.entries[slot] = entry;
+  heap.count += static_cast<size_t>(write);
+
+  for (size_t idx = slot * static_cast<size_t>(write);
+       idx > 0u && bpe_heap_less(heap.entries[idx], heap.entries[(idx - 1u) / 2u]);
+       idx = (idx - 1u) / 2u) {
+    std::swap(heap.entries[idx], heap.entries[(idx - 1u) / 2u]);
+  }
+}
+
+inline emel::text::encoders::detail::bpe_bigram
+bpe_heap_pop(emel::text::encoders::detail::bpe_merge_heap &heap) noexcept {
+  const emel::text::encoders::detail::bpe_bigram top = heap.entries[0];
+  heap.count -= 1u;
+  heap.entries[0] = heap.entries[heap.count];
+
+  size_t idx = 0;
+  for (size_t child = bpe_heap_min_child(heap, idx); child != idx;
+       child = bpe_heap_min_child(heap, idx)) {
+    std::swap(heap.entries[idx], heap.entries[child]);
+    idx = child;
+  }
+  return top;
+}
+
+inline void bpe_push_pair_if(const bool active,
+                             emel::text::encoders::bpe::action::context &ctx,
+                             const emel::model::data::vocab &vocab,
+                             const std::string_view word, const int32_t left,
+                             const int32_t right) noexcept {
+  const bool has_pair = active && left >= 0 && right >= 0;
+  const size_t safe_left = static_cast<size_t>(select_i32(has_pair, left, 0));
+  const size_t safe_right = static_cast<size_t>(select_i32(has_pair, right, 0));
+  const size_t left_len =
+      ctx.scratch.lengths[safe_left] * static_cast<size_t>(has_pair);
+  const size_t right_len =
+      ctx.scratch.lengths[safe_right] * static_cast<size_t>(has_pair);
+  const std::string_view left_view(word.data() + ctx.scratch.offsets[safe_left],
+                                   left_len);
+  const std::string_view right_view(word.data() + ctx.scratch.offsets[safe_right],
+                                    right_len);
+  const int32_t rank = bpe_lookup_merge_rank(ctx, vocab, left_view, right_view);
+
+  emel::text::encoders::detail::bpe_bigram entry{};
+  entry.left = left;
+  entry.right = right;
+  entry.rank = rank;
+  entry.size = left_len + right_len;
+  bpe_heap_push(ctx.merge_heap, has_pair && rank != k_token_null, entry);
+}
+
+// Applies merges lowest-rank-first (ties broken by leftmost symbol) from a min-heap of adjacent
+// pairs. Stale entries are invalidated lazily: a popped pair is only merged while both symbols
+// still exist, are still adjacent and still span the byte length recorded when it was pushed.
+inline void bpe_apply_ranked_merges(emel::text::encoders::bpe::action::context &ctx,
+                                    const emel::model::data::vocab &vocab,
+                                    const std::string_view word,
+                                    const bool can_merge) noexcept {
+  ctx.merge_heap.clear();
+  for (int32_t left = select_i32(can_merge, 0, -1); left != -1;
+       left = ctx.scratch.next[static_cast<size_t>(left)]) {
+    bpe_push_pair_if(true, ctx, vocab, word, left,
+                     ctx.scratch.next[static_cast<size_t>(left)]);
+  }
+
+  for (; ctx.merge_heap.count > 0u;) {
+    const emel::text::encoders::detail::bpe_bigram top = bpe_heap_pop(ctx.merge_heap);
+    const size_t left = static_cast<size_t>(top.left);
+    const size_t right = static_cast<size_t>(top.right);
+    const uint32_t left_len = ctx.scratch.lengths[left];
+    const uint32_t right_len = ctx.scratch.lengths[right];
+    const bool live = left_len > 0u && right_len > 0u &&
+                      ctx.scratch.next[left] == top.right &&
+                      static_cast<size_t>(left_len) + static_cast<size_t>(right_len) ==
+                          top.size;
+    bpe_merge_symbols_if(ctx.scratch, live, top.left, top.right);
+    bpe_push_pair_if(live, ctx, vocab, word, ctx.scratch.prev[left], top.left);
+    bpe_push_pair_if(live, ctx, vocab, word, top.left, ctx.scratch.next[left]);
+  }
+}
+
 inline bool encode_bpe_word_merge_path(
     const event::encode &ev, emel::text::encoders::bpe::action::context &ctx,
     const emel::model::data::vocab &vocab, const std::string_view word,
@@ -401,43 +447,7 @@ inline bool encode_bpe_word_merge_path(
   bool ok = bpe_build_symbols(word, ctx.scratch, result);
 
   const bool can_merge = ok && ctx.scratch.symbol_count > 1;
-  const int32_t merge_pass_limit =
-      select_i32(can_merge, ctx.scratch.symbol_count - 1, 0);
-  bool merge_active = can_merge;
-
-  for (int32_t merge_pass = 0; merge_pass < merge_pass_limit; ++merge_pass) {
-    int32_t best_left = -1;
-    int32_t best_right = -1;
-    int32_t best_rank = std::numeric_limits<int32_t>::max();
-
-    for (int32_t left = select_i32(merge_active, 0, -1); left != -1;
-         left = ctx.scratch.next[static_cast<size_t>(left)]) {
-      const int32_t right = ctx.scratch.next[static_cast<size_t>(left)];
-      const bool has_right = right >= 0;
-      const int32_t safe_right = select_i32(has_right, right, 0);
-      const size_t left_off = ctx.scratch.offsets[static_cast<size_t>(left)];
-      const size_t left_len = ctx.scratch.lengths[static_cast<size_t>(left)];
-      const size_t right_off =
-          ctx.scratch.offsets[static_cast<size_t>(safe_right)];
-      const size_t right_len =
-          ctx.scratch.lengths[static_cast<size_t>(safe_right)] *
-          static_cast<size_t>(has_right);
-      const std::string_view left_view(word.data() + left_off, left_len);
-      const std::string_view right_view(word.data() + right_off, right_len);
-      const int32_t rank =
-          bpe_lookup_merge_rank(ctx, vocab, left_view, right_view);
-      const bool has_rank = has_right && rank != k_token_null;
-      const bool better = has_rank && (rank < best_rank ||
-                                       (rank == best_rank && left < best_left));
-      best_rank = select_i32(better, rank, best_rank);
-      best_left = select_i32(better, left, best_left);
-      best_right = select_i32(better, right, best_right);
-    }
-
-    const bool has_merge = merge_active && best_left >= 0 && best_right >= 0;
-    bpe_merge_symbols_if(ctx.scratch, has_merge, best_left, best_right);
-    merge_active = merge_active && has_merge;
-  }
+  bpe_apply_ranked_merges(ctx, vocab, word, can_merge);
 
   const bool has_symbol_chain = ok && ctx.scratch.symbol_count > 0;
   const int32_t first_symbol = select_i32(has_symbol_chain, 0, -1);
@@ -496,14 +506,99 @@ encode_bpe_ignore_merges(const event::encode &ev,
   return result;
 }
 
+inline emel::text::encoders::detail::bpe_word_cache_slot &
+bpe_word_cache_slot_for(emel::text::encoders::bpe::action::context &ctx,
+                        const uint32_t hash) noexcept {
+  const uint32_t mask =
+      static_cast<uint32_t>(emel::text::encoders::detail::k_bpe_word_cache_slots - 1u);
+  return ctx.word_cache.slots[hash & mask];
+}
+
+inline const emel::text::encoders::detail::bpe_word_cache_slot &
+bpe_word_cache_slot_for(const emel::text::encoders::bpe::action::context &ctx,
+                        const uint32_t hash) noexcept {
+  const uint32_t mask =
+      static_cast<uint32_t>(emel::text::encoders::detail::k_bpe_word_cache_slots - 1u);
+  return ctx.word_cache.slots[hash & mask];
+}
+
+inline bool bpe_word_cache_hit(
+    const emel::text::encoders::detail::bpe_word_cache_slot &slot,
+    const uint32_t hash, const std::string_view word) noexcept {
+  const bool cacheable =
+      word.size() <= emel::text::encoders::detail::k_bpe_word_cache_max_bytes;
+  const bool same_shape = cacheable && slot.hash == hash &&
+                          static_cast<size_t>(slot.word_length) == word.size() &&
+                          slot.token_count > 0u;
+  const size_t compare_len = word.size() * static_cast<size_t>(same_shape);
+  return same_shape && std::memcmp(slot.word.data(), word.data(), compare_len) == 0;
+}
+
+inline bool bpe_word_cache_hit(const emel::text::encoders::bpe::action::context &ctx,
+                               const std::string_view word) noexcept {
+  const uint32_t hash = bpe_hash_sv(word);
+  return bpe_word_cache_hit(bpe_word_cache_slot_for(ctx, hash), hash, word);
+}
+
+inline bool bpe_encode_word_and_memoize(
+    const event::encode &ev, emel::text::encoders::bpe::action::context &ctx,
+    const emel::model::data::vocab &vocab,
+    emel::text::encoders::detail::bpe_word_cache_slot &slot, int32_t &count,
+    encode_result &result) {
+  const int32_t first = count;
+  const bool ok = encode_bpe_word_merge_path(ev, ctx, vocab, ev.text, count, result);
+  const size_t produced = static_cast<size_t>(count - first);
+  const bool store =
+      ok && produced > 0u &&
+      produced <= emel::text::encoders::detail::k_bpe_word_cache_max_tokens &&
+      ev.text.size() <= emel::text::encoders::detail::k_bpe_word_cache_max_bytes;
+
+  emel::text::encoders::detail::bpe_word_cache_slot &target =
+      *emel::text::encoders::detail::pick_ptr(store, &slot, &ctx.word_cache.sink);
+  const size_t word_len = select_size(store, ev.text.size(), 0u);
+  const size_t token_len = select_size(store, produced, 0u);
+  std::memcpy(target.word.data(), ev.text.data(), word_len);
+  const int32_t *token_source = emel::text::encoders::detail::pick_ptr<const int32_t>(
+      store, ev.token_ids.data() + first * static_cast<int32_t>(store),
+      slot.tokens.data());
+  std::memcpy(target.tokens.data(), token_source, token_len * sizeof(int32_t));
+  ctx.word_cache.count += static_cast<uint32_t>(store && slot.token_count == 0u);
+  target.hash = bpe_hash_sv(ev.text);
+  target.word_length = static_cast<uint32_t>(word_len);
+  target.token_count = static_cast<uint32_t>(token_len);
+  return ok;
+}
+
+// Replays the memoized tokens of a word; the caller has already routed on
+// bpe_word_cache_hit().
+inline encode_result
+encode_bpe_cached_word(const event::encode &ev,
+                       const emel::text::encoders::bpe::action::context &ctx) {
+  encode_result result{};
+  int32_t count = 0;
+  const emel::text::encoders::detail::bpe_word_cache_slot &slot =
+      bpe_word_cache_slot_for(ctx, bpe_hash_sv(ev.text));
+  bool ok = true;
+  for (uint32_t idx = 0; idx < slot.token_count; ++idx) {
+    ok = bpe_push_token(ev, slot.tokens[idx], count) && ok;
+  }
+  const std::array<int32_t, 2> errors{emel::text::encoders::error::to_emel(emel::text::encoders::error::code::invalid_argument), emel::text::encoders::error::to_emel(emel::text::encoders::error::code::ok)};
+  result.error = errors[static_cast<size_t>(ok)];
+  result.token_count = count * static_cast<int32_t>(ok);
+  return result;
+}
+
+// Merges the word and memoizes it in its cache slot, evicting the previous
+// occupant.
 inline encode_result
 encode_bpe_merge_path(const event::encode &ev,
                       emel::text::encoders::bpe::action::context &ctx,
                       const emel::model::data::vocab &vocab) {
   encode_result result{};
   int32_t count = 0;
-  const bool ok =
-      encode_bpe_word_merge_path(ev, ctx, vocab, ev.text, count, result);
+  emel::text::encoders::detail::bpe_word_cache_slot &slot =
+      bpe_word_cache_slot_for(ctx, bpe_hash_sv(ev.text));
+  const bool ok = bpe_encode_word_and_memoize(ev, ctx, vocab, slot, count, result);
   const std::array<int32_t, 2> errors{result.error, emel::text::encoders::error::to_emel(emel::text::encoders::error::code::ok)};
   result.error = errors[static_cast<size_t>(ok)];
   result.token_count = count * static_cast<int32_t>(ok);
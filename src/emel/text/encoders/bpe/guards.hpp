@@ -141,6 +141,18 @@ struct merge_symbol_capacity_exceeded {
   }
 };
 
+struct word_cache_hit {
+  bool operator()(const event::encode_runtime & ev, const action::context & ctx) const noexcept {
+    return emel::text::encoders::bpe::detail::bpe_word_cache_hit(ctx, ev.request.text);
+  }
+};
+
+struct word_cache_miss {
+  bool operator()(const event::encode_runtime & ev, const action::context & ctx) const noexcept {
+    return !word_cache_hit{}(ev, ctx);
+  }
+};
+
 struct vocab_changed {
   bool operator()(const event::encode_runtime & ev, const action::context & ctx) const noexcept {
     return emel::text::encoders::guard::vocab_changed{}(ev, ctx);
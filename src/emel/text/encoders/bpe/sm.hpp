@@ -39,7 +39,8 @@ struct unexpected {};
  * - 'encode_path_decision': explicit `ignore_merges` policy routing.
  * - 'encode_direct_word_policy_decision': explicit direct-word availability routing.
  * - 'encode_merge_input_capacity_decision': explicit merge-path symbol-capacity routing.
- * - 'encode_exec'/'encode_result_decision': run selected kernel and branch on phase error.
+ * - 'encode_exec': route on the word cache, then run the selected kernel.
+ * - 'encode_result_decision': branch on phase error.
  * - 'done'/'errored': terminal outcomes.
  * - 'unexpected': sequencing contract violation.
  *
@@ -49,13 +50,16 @@ struct unexpected {};
  * - 'text_empty'/'text_non_empty' and 'preprocessed'/'not_preprocessed' route precheck decisions.
  * - 'ignore_merges_enabled' and 'direct_word_token_available' route algorithm path selection.
  * - 'merge_symbol_capacity_within_limit'/'merge_symbol_capacity_exceeded' route merge-path intake.
+ * - 'word_cache_hit'/'word_cache_miss' route between replaying a memoized word and merging it.
  * - 'phase_*' guards observe runtime phase errors.
  *
  * action side effects:
  * - 'begin_encode' resets runtime per-request outputs.
  * - 'begin_encode_sync_vocab' refreshes per-vocab cached tables.
  * - 'prepare_tables' builds lookup tables before path routing.
- * - 'run_encode_ignore_merges' and 'run_encode_merge_path' execute bounded kernels.
+ * - 'run_encode_ignore_merges' and 'run_encode_merge_path' execute bounded kernels;
+ *   'run_encode_merge_path' also memoizes the word.
+ * - 'run_encode_cached_word' replays a memoized word.
  * - 'mark_done'/'ensure_last_error' finalize runtime status.
  * - 'on_unexpected' reports sequencing violations.
  */
@@ -168,7 +172,11 @@ struct model {
       // Encode Execution
       //------------------------------------------------------------------------------//
       , sml::state<encode_result_decision> <= sml::state<encode_exec>
-          + sml::completion<event::encode_runtime> / action::run_encode_merge_path
+          + sml::completion<event::encode_runtime>[guard::word_cache_hit{}]
+          / action::run_encode_cached_word
+      , sml::state<encode_result_decision> <= sml::state<encode_exec>
+          + sml::completion<event::encode_runtime>[guard::word_cache_miss{}]
+          / action::run_encode_merge_path
       , sml::state<done> <= sml::state<encode_result_decision>
           + sml::completion<event::encode_runtime>[guard::encode_result_ok{}]
           / action::mark_done
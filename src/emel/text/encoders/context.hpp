@@ -12,7 +12,7 @@ struct context {
   bool ugm_ready = false;
 
   int32_t max_token_len = 0;
-  detail::token_map token_to_id = {};
+  detail::double_array_trie token_trie = {};
   detail::merge_map bpe_ranks = {};
   detail::encode_scratch scratch = {};
 };
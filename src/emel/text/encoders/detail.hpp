@@ -218,42 +218,6 @@ inline bool merge_match(const std::string_view merge,
   return non_empty && has_separator && size_match && left_match && right_match;
 }
 
-inline bool insert_token_map(token_map &map,
-                             const emel::model::data::vocab &vocab,
-                             const std::string_view text,
-                             const int32_t id) {
-  const bool active = !text.empty();
-  bool success = !active;
-  bool loop_active = active;
-
-  const uint32_t hash = hash_sv(text);
-  const uint32_t mask = k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0; probes < k_token_hash_size; ++probes) {
-    const bool step_active = loop_active;
-    const uint32_t slot_hash = map.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t existing = map.values[slot];
-    const std::string_view existing_text = token_text(vocab, existing);
-    const bool same_text = step_active && hash_match && existing_text == text;
-    const bool claim_slot = step_active && (empty_slot || same_text);
-    const bool collision = step_active && hash_match && !same_text;
-
-    map.hashes[slot] = select_u32(claim_slot, hash, slot_hash);
-    map.values[slot] = select_i32(claim_slot, id, existing);
-    map.count += static_cast<uint32_t>(claim_slot && empty_slot);
-
-    success = success || claim_slot;
-    const bool step_done = claim_slot || collision;
-    loop_active = loop_active && !step_done;
-    slot = (slot + 1u) & mask;
-  }
-
-  return success;
-}
-
 inline bool insert_merge_map(merge_map &map,
                              const std::string_view left,
                              const std::string_view right,
@@ -293,76 +257,16 @@ inline bool insert_merge_map(merge_map &map,
 
 inline int32_t lookup_token(const action::context &ctx,
                             const std::string_view text) {
-  const bool active = !text.empty();
-  bool loop_active = active;
-  int32_t resolved = k_token_null;
-
-  const uint32_t hash = hash_sv(text);
-  const uint32_t mask = k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0; probes < k_token_hash_size; ++probes) {
-    const bool step_active = loop_active;
-    const uint32_t entry = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = entry == 0u;
-    const bool hash_match = entry == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const bool exact_match = step_active && hash_match && token_text(*ctx.vocab, id) == text;
-    const bool collision = step_active && hash_match && !exact_match;
-
-    resolved = select_i32(exact_match, id, resolved);
-    const bool step_done = step_active && (empty_slot || exact_match || collision);
-    loop_active = loop_active && !step_done;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  return ctx.token_trie.find(text);
 }
 
 inline int32_t lookup_token_concat(const action::context &ctx,
                                    const std::string_view left,
                                    const std::string_view right) {
-  const uint32_t hash = hash_concat(left, right);
-  const uint32_t mask = k_token_hash_size - 1u;
-  const size_t combined_len = left.size() + right.size();
-  uint32_t slot = hash & mask;
-  int32_t resolved = k_token_null;
-  bool loop_active = true;
-
-  for (uint32_t probes = 0; probes < k_token_hash_size; ++probes) {
-    const bool step_active = loop_active;
-    const uint32_t entry = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = entry == 0u;
-    const bool hash_match = entry == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const std::string_view token = token_text(*ctx.vocab, id);
-    const bool size_match = token.size() == combined_len;
-
-    const char empty_byte = '\0';
-    const std::array<const char *, 2> token_ptrs = {&empty_byte, token.data()};
-    const std::array<const char *, 2> left_ptrs = {&empty_byte, left.data()};
-    const std::array<const char *, 2> right_ptrs = {&empty_byte, right.data()};
-
-    const size_t left_len = select_size(size_match, left.size(), 0u);
-    const size_t right_len = select_size(size_match, right.size(), 0u);
-    const size_t right_offset = left_len;
-
-    const char *token_ptr = token_ptrs[static_cast<size_t>(size_match)];
-    const char *left_ptr = left_ptrs[static_cast<size_t>(!left.empty())];
-    const char *right_ptr = right_ptrs[static_cast<size_t>(!right.empty())];
-
-    const bool left_match = std::memcmp(token_ptr, left_ptr, left_len) == 0;
-    const bool right_match = std::memcmp(token_ptr + right_offset, right_ptr, right_len) == 0;
-    const bool exact_match =
-        step_active && hash_match && size_match && left_match && right_match;
-
-    resolved = select_i32(exact_match, id, resolved);
-    const bool step_done = step_active && (empty_slot || exact_match);
-    loop_active = loop_active && !step_done;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  const auto &trie = ctx.token_trie;
+  const bool active = !left.empty() || !right.empty();
+  const int32_t state = trie.walk(trie.walk(trie.k_root, left), right);
+  return select_i32(active, trie.value(state), k_token_null);
 }
 
 inline int32_t lookup_merge_rank(const action::context &ctx,
@@ -579,20 +483,6 @@ inline void ensure_tables_insert_merge_none(action::context &,
                                             const emel::model::data::vocab &) noexcept {
 }
 
-inline bool ensure_tables_insert_token_none(action::context &,
-                                            const emel::model::data::vocab &,
-                                            const std::string_view,
-                                            const int32_t) noexcept {
-  return true;
-}
-
-inline bool ensure_tables_insert_token_some(action::context &ctx,
-                                            const emel::model::data::vocab &vocab,
-                                            const std::string_view text,
-                                            const int32_t id) noexcept {
-  return insert_token_map(ctx.token_to_id, vocab, text, id);
-}
-
 inline void ensure_tables_insert_merge_some(action::context &ctx,
                                             const std::string_view left,
                                             const std::string_view right,
@@ -602,33 +492,11 @@ inline void ensure_tables_insert_merge_some(action::context &ctx,
 }
 
 inline void ensure_tables_build_some(action::context &ctx, bool &ok) noexcept {
-  ctx.token_to_id.clear();
   ctx.bpe_ranks.clear();
-  ctx.max_token_len = 0;
 
   const emel::model::data::vocab &vocab = *ctx.vocab;
-  using insert_token_handler_t = bool (*)(action::context &,
-                                          const emel::model::data::vocab &,
-                                          std::string_view,
-                                          int32_t) noexcept;
-  const insert_token_handler_t insert_token_handlers[2] = {
-      ensure_tables_insert_token_none,
-      ensure_tables_insert_token_some,
-  };
-
-  bool loop_active = true;
-  for (uint32_t id = 0; id < vocab.n_tokens; ++id) {
-    const bool step_active = loop_active;
-    const std::string_view text = token_text(vocab, static_cast<int32_t>(id));
-    const bool inserted = insert_token_handlers[static_cast<size_t>(step_active)](
-        ctx, vocab, text, static_cast<int32_t>(id));
-
-    const int32_t text_len = static_cast<int32_t>(text.size());
-    const bool longer = step_active && text_len > ctx.max_token_len;
-    ctx.max_token_len = select_i32(longer, text_len, ctx.max_token_len);
-    loop_active = loop_active && inserted;
-  }
-  const bool build_ok = loop_active;
+  const bool build_ok = bind_token_trie(ctx.token_trie, vocab);
+  ctx.max_token_len = static_cast<int32_t>(ctx.token_trie.max_key_length);
 
   using insert_merge_handler_t = void (*)(action::context &,
                                           std::string_view,
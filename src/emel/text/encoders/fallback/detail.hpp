@@ -28,23 +28,6 @@ inline uint32_t select_u32(const bool choose_true,
   return (false_value & ~mask) | (true_value & mask);
 }
 
-constexpr uint32_t k_fnv_offset = 2166136261u;
-constexpr uint32_t k_fnv_prime = 16777619u;
-
-inline uint32_t fallback_hash_bytes(const uint32_t seed,
-                                    const std::string_view text) noexcept {
-  uint32_t hash = seed;
-  for (const unsigned char byte : text) {
-    hash ^= byte;
-    hash *= k_fnv_prime;
-  }
-  return select_u32(hash != 0u, hash, 1u);
-}
-
-inline uint32_t fallback_hash_sv(const std::string_view text) noexcept {
-  return fallback_hash_bytes(k_fnv_offset, text);
-}
-
 inline std::string_view fallback_token_text(const emel::model::data::vocab &vocab,
                                             const int32_t id) noexcept {
   const bool valid_id = id >= 0 && static_cast<uint32_t>(id) < vocab.n_tokens;
@@ -58,40 +41,6 @@ inline std::string_view fallback_token_text(const emel::model::data::vocab &voca
     static_cast<size_t>(length));
 }
 
-inline bool fallback_insert_token_map(emel::text::encoders::detail::token_map &map,
-                                      const emel::model::data::vocab &vocab,
-                                      const std::string_view text,
-                                      const int32_t id) noexcept {
-  const bool text_empty = text.empty();
-  bool done = text_empty;
-  bool success = text_empty;
-  const uint32_t hash = fallback_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = map.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t existing_id = map.values[slot];
-    const std::string_view existing_text = fallback_token_text(vocab, existing_id);
-    const bool same_text = hash_match && existing_text == text;
-    const bool claim_slot = empty_slot || same_text;
-
-    map.hashes[slot] = select_u32(claim_slot, hash, slot_hash);
-    map.values[slot] = select_i32(claim_slot, id, existing_id);
-    map.count += static_cast<uint32_t>(claim_slot && empty_slot);
-
-    success = success || claim_slot;
-    done = done || claim_slot;
-    slot = (slot + 1u) & mask;
-  }
-
-  return success;
-}
-
 inline bool ensure_fallback_tables(emel::text::encoders::action::context &ctx,
                                    const emel::model::data::vocab &vocab) noexcept {
   auto rebuild_none = [](emel::text::encoders::action::context &,
@@ -102,20 +51,10 @@ inline bool ensure_fallback_tables(emel::text::encoders::action::context &ctx,
                          bool &ok_value) noexcept {
     ctx_value.vocab = &vocab_value;
     ctx_value.tables_ready = false;
-    ctx_value.token_to_id.clear();
     ctx_value.bpe_ranks.clear();
-    ctx_value.max_token_len = 0;
-
-    for (uint32_t id = 0; id < vocab_value.n_tokens; ++id) {
-      const std::string_view text =
-          fallback_token_text(vocab_value, static_cast<int32_t>(id));
-      const bool inserted = fallback_insert_token_map(
-          ctx_value.token_to_id, vocab_value, text, static_cast<int32_t>(id));
-      ok_value = ok_value && inserted;
-      const int32_t text_len = static_cast<int32_t>(text.size());
-      const bool longer = text_len > ctx_value.max_token_len;
-      ctx_value.max_token_len = select_i32(longer, text_len, ctx_value.max_token_len);
-    }
+    ok_value = ok_value &&
+               emel::text::encoders::detail::bind_token_trie(ctx_value.token_trie, vocab_value);
+    ctx_value.max_token_len = static_cast<int32_t>(ctx_value.token_trie.max_key_length);
 
     ctx_value.tables_ready = ok_value;
   };
@@ -132,30 +71,9 @@ inline bool ensure_fallback_tables(emel::text::encoders::action::context &ctx,
 }
 
 inline int32_t fallback_lookup_token(const emel::text::encoders::action::context &ctx,
-                                     const emel::model::data::vocab &vocab,
+                                     const emel::model::data::vocab &,
                                      const std::string_view text) noexcept {
-  const bool active = !text.empty();
-  bool done = !active;
-  int32_t resolved = k_token_null;
-  const uint32_t hash = fallback_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const bool exact = hash_match && fallback_token_text(vocab, id) == text;
-
-    resolved = select_i32(exact, id, resolved);
-    done = done || empty_slot || exact;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  return ctx.token_trie.find(text);
 }
 
 inline bool fallback_push_token(const event::encode &ev,
@@ -4,6 +4,9 @@
 #include <cstdint>
 #include <cstring>
 #include <limits>
+#include <string_view>
+#include <utility>
+#include <vector>
 
 #include "emel/model/data.hpp"
 #include "emel/text/encoders/detail.hpp"
@@ -111,11 +114,6 @@ inline uint32_t spm_hash_sv(const std::string_view text) noexcept {
   return spm_hash_bytes(k_fnv_offset, text);
 }
 
-inline uint32_t spm_hash_concat(const std::string_view left,
-                                const std::string_view right) noexcept {
-  return spm_hash_bytes(spm_hash_bytes(k_fnv_offset, left), right);
-}
-
 inline uint32_t spm_hash_pair(const std::string_view left,
                               const std::string_view right) noexcept {
   const uint32_t h1 = spm_hash_sv(left);
@@ -124,40 +122,6 @@ inline uint32_t spm_hash_pair(const std::string_view left,
   return select_u32(mixed != 0u, mixed, 1u);
 }
 
-inline bool spm_insert_token_map(emel::text::encoders::detail::token_map &map,
-                                 const emel::model::data::vocab &vocab,
-                                 const std::string_view text,
-                                 const int32_t id) noexcept {
-  const bool text_empty = text.empty();
-  bool done = text_empty;
-  bool success = text_empty;
-  const uint32_t hash = spm_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = map.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t existing_id = map.values[slot];
-    const std::string_view existing_text = spm_token_text(vocab, existing_id);
-    const bool same_text = hash_match && existing_text == text;
-    const bool claim_slot = empty_slot || same_text;
-
-    map.hashes[slot] = select_u32(claim_slot, hash, slot_hash);
-    map.values[slot] = select_i32(claim_slot, id, existing_id);
-    map.count += static_cast<uint32_t>(claim_slot && empty_slot);
-
-    success = success || claim_slot;
-    done = done || claim_slot;
-    slot = (slot + 1u) & mask;
-  }
-
-  return success;
-}
-
 inline bool
 spm_insert_merge_map(emel::text::encoders::detail::merge_map &map,
                      const std::string_view left, const std::string_view right,
@@ -196,63 +160,19 @@ spm_insert_merge_map(emel::text::encoders::detail::merge_map &map,
 inline int32_t
 spm_lookup_token(const emel::text::encoders::spm::action::context &ctx,
                  const std::string_view text) noexcept {
-  const bool has_vocab = ctx.vocab != nullptr;
-  const bool active = has_vocab && !text.empty();
-  bool done = !active;
-  int32_t resolved = k_token_null;
-  const uint32_t hash = spm_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const bool exact = hash_match && spm_token_text(*ctx.vocab, id) == text;
-
-    resolved = select_i32(exact, id, resolved);
-    done = done || empty_slot || exact;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  const bool active = ctx.vocab != nullptr && !text.empty();
+  const int32_t id = ctx.token_trie.find(text);
+  return select_i32(active, id, k_token_null);
 }
 
 inline int32_t
 spm_lookup_token_concat(const emel::text::encoders::spm::action::context &ctx,
                         const std::string_view left,
                         const std::string_view right) noexcept {
-  const bool has_vocab = ctx.vocab != nullptr;
-  const bool active = has_vocab && (!left.empty() || !right.empty());
-  bool done = !active;
-  int32_t resolved = k_token_null;
-  const uint32_t hash = spm_hash_concat(left, right);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  const size_t combined_len = left.size() + right.size();
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const std::string_view token = spm_token_text(*ctx.vocab, id);
-    const bool size_match = token.size() == combined_len;
-    const bool left_match = size_match && token.substr(0, left.size()) == left;
-    const bool right_match = size_match && token.substr(left.size()) == right;
-    const bool exact = hash_match && left_match && right_match;
-
-    resolved = select_i32(exact, id, resolved);
-    done = done || empty_slot || exact;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  const bool active = ctx.vocab != nullptr && (!left.empty() || !right.empty());
+  const auto &trie = ctx.token_trie;
+  const int32_t state = trie.walk(trie.walk(trie.k_root, left), right);
+  return select_i32(active, trie.value(state), k_token_null);
 }
 
 inline bool spm_push_token(const event::encode &ev, const int32_t token,
@@ -360,22 +280,11 @@ spm_tables_ready(const emel::text::encoders::spm::action::context &ctx,
 
 inline bool
 rebuild_spm_tables(emel::text::encoders::spm::action::context &ctx) noexcept {
-  bool ok = true;
-  ctx.token_to_id.clear();
   ctx.bpe_ranks.clear();
-  ctx.max_token_len = 0;
 
   const emel::model::data::vocab &vocab = *ctx.vocab;
-  for (uint32_t id = 0; id < vocab.n_tokens; ++id) {
-    const std::string_view text =
-        spm_token_text(vocab, static_cast<int32_t>(id));
-    const bool inserted = spm_insert_token_map(ctx.token_to_id, vocab, text,
-                                               static_cast<int32_t>(id));
-    ok = ok && inserted;
-    const int32_t text_len = static_cast<int32_t>(text.size());
-    const bool longer = text_len > ctx.max_token_len;
-    ctx.max_token_len = select_i32(longer, text_len, ctx.max_token_len);
-  }
+  const bool ok = emel::text::encoders::detail::bind_token_trie(ctx.token_trie, vocab);
+  ctx.max_token_len = static_cast<int32_t>(ctx.token_trie.max_key_length);
 
   for (uint32_t idx = 0; idx < vocab.n_merges; ++idx) {
     const std::string_view merge =
@@ -4,6 +4,7 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <memory>
 #include <string>
 #include <string_view>
@@ -78,6 +79,406 @@ struct naive_trie {
 
 using naive_trie = naive_trie;
 
+// Byte-level double-array trie over vocab texts. Transitions are one add and
+// one compare against a flat cell array, so longest-prefix walks touch a few
+// cache lines per byte instead of a 1 KiB naive_trie node.
+//
+// A unit is three int32 cells: base, check (the parent unit, -1 while free)
+// and value. The cells are owned after build() or borrowed with attach() from
+// the vocab the loader built them into, so every encoder bound to a loaded
+// vocab walks the same array.
+struct double_array_trie {
+  struct key {
+    std::string_view text = {};
+    int32_t value = k_token_null;
+  };
+
+  static constexpr size_t k_unit_cells = 3u;
+  static constexpr size_t k_base = 0u;
+  static constexpr size_t k_check = 1u;
+  static constexpr size_t k_value = 2u;
+  static constexpr int32_t k_root = 0;
+
+  uint32_t max_key_length = 0;
+
+  double_array_trie() { clear(); }
+
+  double_array_trie(const double_array_trie &other) { *this = other; }
+
+  double_array_trie &operator=(const double_array_trie &other) {
+    if (this != &other) {
+      owned_ = other.owned_;
+      cells_ = other.borrowed() ? other.cells_ : owned_.data();
+      unit_count_ = other.unit_count_;
+      max_key_length = other.max_key_length;
+    }
+    return *this;
+  }
+
+  void clear() {
+    owned_.clear();
+    append_free_units(1u);
+    owned_[k_check] = 0;
+    cells_ = owned_.data();
+    unit_count_ = 1u;
+    max_key_length = 0;
+  }
+
+  // Walks `unit_count` units of cells owned elsewhere; they must outlive the
+  // trie and every copy of it.
+  void attach(const int32_t *cells, const uint32_t unit_count,
+              const uint32_t max_key) noexcept {
+    owned_ = {};
+    cells_ = cells;
+    unit_count_ = unit_count;
+    max_key_length = max_key;
+  }
+
+  bool borrowed() const noexcept { return cells_ != owned_.data(); }
+  size_t size() const noexcept { return unit_count_; }
+  const int32_t *cells() const noexcept { return cells_; }
+
+  // Follows byte `c` out of `state`. Dead states are negative and stay dead.
+  int32_t step(const int32_t state, const uint8_t c) const noexcept {
+    const uint32_t live_mask = 0u - static_cast<uint32_t>(state >= 0);
+    const uint32_t from = static_cast<uint32_t>(state) & live_mask;
+    const uint32_t next = static_cast<uint32_t>(cell(from, k_base)) + c;
+    const bool in_range = next < unit_count_;
+    const uint32_t safe_next = next & (0u - static_cast<uint32_t>(in_range));
+    const bool hit = state >= 0 && in_range &&
+                     cell(safe_next, k_check) == static_cast<int32_t>(from);
+    const uint32_t hit_mask = 0u - static_cast<uint32_t>(hit);
+    return static_cast<int32_t>(next | ~hit_mask);
+  }
+
+  int32_t value(const int32_t state) const noexcept {
+    const uint32_t live_mask = 0u - static_cast<uint32_t>(state >= 0);
+    const uint32_t from = static_cast<uint32_t>(state) & live_mask;
+    const uint32_t value_bits = static_cast<uint32_t>(cell(from, k_value));
+    return static_cast<int32_t>((value_bits & live_mask) |
+                                (static_cast<uint32_t>(k_token_null) & ~live_mask));
+  }
+
+  int32_t walk(int32_t state, const std::string_view text) const noexcept {
+    for (const char c : text) {
+      state = step(state, static_cast<uint8_t>(c));
+    }
+    return state;
+  }
+
+  int32_t find(const std::string_view text) const noexcept {
+    const int32_t state = walk(k_root, text);
+    const int32_t id = value(state);
+    const uint32_t keep = 0u - static_cast<uint32_t>(!text.empty());
+    return static_cast<int32_t>((static_cast<uint32_t>(id) & keep) |
+                                (static_cast<uint32_t>(k_token_null) & ~keep));
+  }
+
+  // Builds the trie from `keys` into owned cells. Empty texts are skipped and
+  // a repeated text keeps the value that appears last, matching naive_trie.
+  void build(std::vector<key> keys) {
+    clear();
+    std::stable_sort(keys.begin(), keys.end(), [](const key &l, const key &r) {
+      return l.text < r.text;
+    });
+    std::vector<key> unique = {};
+    unique.reserve(keys.size());
+    for (const key &entry : keys) {
+      if (entry.text.empty()) {
+        continue;
+      }
+      if (!unique.empty() && unique.back().text == entry.text) {
+        unique.back().value = entry.value;
+        continue;
+      }
+      unique.push_back(entry);
+      max_key_length = std::max(max_key_length, static_cast<uint32_t>(entry.text.size()));
+    }
+
+    builder state{*this};
+    state.grow(static_cast<size_t>(unique.size()) * 2u + 256u);
+
+    struct pending {
+      int32_t node = 0;
+      size_t lo = 0;
+      size_t hi = 0;
+      size_t depth = 0;
+    };
+    std::vector<pending> stack = {};
+    stack.push_back({k_root, 0u, unique.size(), 0u});
+    std::array<uint8_t, 256> labels = {};
+    std::array<size_t, 257> bounds = {};
+    while (!stack.empty()) {
+      const pending item = stack.back();
+      stack.pop_back();
+      size_t lo = item.lo;
+      if (lo < item.hi && unique[lo].text.size() == item.depth) {
+        owned_cell(static_cast<size_t>(item.node), k_value) = unique[lo].value;
+        lo += 1;
+      }
+      size_t label_count = 0;
+      for (size_t idx = lo; idx < item.hi; ++idx) {
+        const uint8_t c = static_cast<uint8_t>(unique[idx].text[item.depth]);
+        if (label_count == 0 || labels[label_count - 1] != c) {
+          labels[label_count] = c;
+          bounds[label_count] = idx;
+          label_count += 1;
+        }
+      }
+      if (label_count == 0) {
+        continue;
+      }
+      bounds[label_count] = item.hi;
+      const int32_t base = state.place(labels.data(), label_count);
+      owned_cell(static_cast<size_t>(item.node), k_base) = base;
+      for (size_t idx = 0; idx < label_count; ++idx) {
+        const int32_t child = base + labels[idx];
+        state.occupy(static_cast<size_t>(child));
+        owned_cell(static_cast<size_t>(child), k_check) = item.node;
+        stack.push_back({child, bounds[idx], bounds[idx + 1], item.depth + 1u});
+      }
+    }
+
+    size_t used = 1;
+    for (size_t idx = 0; idx < owned_units(); ++idx) {
+      used = std::max(used,
+                      static_cast<size_t>(owned_cell(idx, k_check) >= 0) * (idx + 1u));
+    }
+    owned_.resize(used * k_unit_cells);
+    owned_.shrink_to_fit();
+    cells_ = owned_.data();
+    unit_count_ = static_cast<uint32_t>(used);
+  }
+
+ private:
+  int32_t cell(const uint32_t unit, const size_t field) const noexcept {
+    return cells_[static_cast<size_t>(unit) * k_unit_cells + field];
+  }
+
+  int32_t &owned_cell(const size_t unit, const size_t field) noexcept {
+    return owned_[unit * k_unit_cells + field];
+  }
+
+  size_t owned_units() const noexcept { return owned_.size() / k_unit_cells; }
+
+  void append_free_units(const size_t count) {
+    for (size_t idx = 0; idx < count; ++idx) {
+      owned_.push_back(0);
+      owned_.push_back(-1);
+      owned_.push_back(k_token_null);
+    }
+  }
+
+  // Free slots form a doubly linked ring so base placement skips occupied
+  // regions instead of rescanning them.
+  struct builder {
+    double_array_trie &trie;
+    std::vector<int32_t> next_free = {};
+    std::vector<int32_t> prev_free = {};
+    int32_t free_head = -1;
+
+    void grow(const size_t target) {
+      const size_t old_size = trie.owned_units();
+      if (target <= old_size) {
+        return;
+      }
+      trie.append_free_units(target - old_size);
+      next_free.resize(target, -1);
+      prev_free.resize(target, -1);
+      for (size_t idx = old_size; idx < target; ++idx) {
+        link(static_cast<int32_t>(idx));
+      }
+    }
+
+    void link(const int32_t slot) {
+      if (free_head < 0) {
+        next_free[static_cast<size_t>(slot)] = slot;
+        prev_free[static_cast<size_t>(slot)] = slot;
+        free_head = slot;
+        return;
+      }
+      const int32_t tail = prev_free[static_cast<size_t>(free_head)];
+      next_free[static_cast<size_t>(tail)] = slot;
+      prev_free[static_cast<size_t>(slot)] = tail;
+      next_free[static_cast<size_t>(slot)] = free_head;
+      prev_free[static_cast<size_t>(free_head)] = slot;
+    }
+
+    void occupy(const size_t slot) {
+      const int32_t next = next_free[slot];
+      const int32_t prev = prev_free[slot];
+      if (next == static_cast<int32_t>(slot)) {
+        free_head = -1;
+        return;
+      }
+      next_free[static_cast<size_t>(prev)] = next;
+      prev_free[static_cast<size_t>(next)] = prev;
+      if (free_head == static_cast<int32_t>(slot)) {
+        free_head = next;
+      }
+    }
+
+    bool fits(const int32_t base, const uint8_t *labels, const size_t count) {
+      grow(static_cast<size_t>(base) + 256u);
+      for (size_t idx = 0; idx < count; ++idx) {
+        if (trie.owned_cell(static_cast<size_t>(base) + labels[idx], k_check) >= 0) {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    int32_t place(const uint8_t *labels, const size_t count) {
+      int32_t slot = free_head;
+      while (slot >= 0) {
+        const int32_t base = slot - static_cast<int32_t>(labels[0]);
+        if (base >= 1 && fits(base, labels, count)) {
+          return base;
+        }
+        slot = next_free[static_cast<size_t>(slot)];
+        if (slot == free_head) {
+          break;
+        }
+      }
+      const int32_t base =
+          std::max<int32_t>(1, static_cast<int32_t>(trie.owned_units()) - labels[0]);
+      grow(static_cast<size_t>(base) + 256u);
+      return base;
+    }
+  };
+
+  std::vector<int32_t> owned_ = {};
+  const int32_t *cells_ = nullptr;
+  uint32_t unit_count_ = 0;
+};
+
+inline std::string_view vocab_token_text(const emel::model::data::vocab &vocab,
+                                         const uint32_t id) noexcept {
+  const auto &entry = vocab.entries[id];
+  return std::string_view(vocab.token_storage.data() + entry.text_offset,
+                          entry.text_length);
+}
+
+// Normal, user-defined and unused pieces take part in the UGM Viterbi
+// lattice; control, unknown and byte pieces never match input text.
+inline bool ugm_matchable_type(const int32_t type) noexcept {
+  return type == 1 || type == 4 || type == 5;
+}
+
+// A UGM vocab's trie holds only matchable pieces, so a text shared with a
+// control or byte piece resolves to its last matchable id.
+inline bool token_trie_keeps(const emel::model::data::vocab &vocab,
+                             const uint32_t id) noexcept {
+  return vocab.tokenizer_model_id != emel::model::data::tokenizer_model::UGM ||
+         ugm_matchable_type(vocab.entries[id].type);
+}
+
+inline void build_token_trie(double_array_trie &trie,
+                             const emel::model::data::vocab &vocab) {
+  std::vector<double_array_trie::key> keys(vocab.n_tokens);
+  for (uint32_t id = 0; id < vocab.n_tokens; ++id) {
+    const std::string_view text = vocab_token_text(vocab, id);
+    // Empty keys are dropped by the build, which stands in for a skipped key.
+    keys[id] = {text.substr(0, text.size() * static_cast<size_t>(token_trie_keeps(vocab, id))),
+                static_cast<int32_t>(id)};
+  }
+  trie.build(std::move(keys));
+}
+
+// Builds the vocab's shared token trie once, at load. Returns false when the
+// trie outgrows the vocab's capacity; encoders reject a vocab without one.
+inline bool prepare_token_trie(emel::model::data::vocab &vocab) {
+  vocab.token_trie_units = 0;
+  vocab.token_trie_max_key = 0;
+  double_array_trie trie = {};
+  build_token_trie(trie, vocab);
+  if (trie.size() > static_cast<size_t>(emel::model::data::k_max_token_trie_units)) {
+    return false;
+  }
+  std::memcpy(vocab.token_trie.data(), trie.cells(),
+              trie.size() * double_array_trie::k_unit_cells * sizeof(int32_t));
+  vocab.token_trie_units = static_cast<uint32_t>(trie.size());
+  vocab.token_trie_max_key = trie.max_key_length;
+  return true;
+}
+
+// Flat little-endian word image of a prepared token trie: magic, version,
+// token count, unit count, longest key, then the cells. Stored next to the
+// model, it lets the loader restore the trie without rebuilding it.
+inline constexpr uint32_t k_token_trie_image_magic = 0x54414445u;  // "EDAT"
+inline constexpr uint32_t k_token_trie_image_version = 2u;
+inline constexpr size_t k_token_trie_image_header_words = 5u;
+inline constexpr std::string_view k_token_trie_image_key = "tokenizer.emel.token_trie";
+
+inline size_t token_trie_image_words(const emel::model::data::vocab &vocab) noexcept {
+  return k_token_trie_image_header_words +
+         static_cast<size_t>(vocab.token_trie_units) * double_array_trie::k_unit_cells;
+}
+
+inline bool serialize_token_trie(const emel::model::data::vocab &vocab,
+                                 uint32_t *out, const size_t capacity) noexcept {
+  if (out == nullptr || vocab.token_trie_units == 0u ||
+      capacity < token_trie_image_words(vocab)) {
+    return false;
+  }
+  out[0] = k_token_trie_image_magic;
+  out[1] = k_token_trie_image_version;
+  out[2] = vocab.n_tokens;
+  out[3] = vocab.token_trie_units;
+  out[4] = vocab.token_trie_max_key;
+  const size_t cell_count = token_trie_image_words(vocab) - k_token_trie_image_header_words;
+  for (size_t idx = 0; idx < cell_count; ++idx) {
+    out[k_token_trie_image_header_words + idx] = static_cast<uint32_t>(vocab.token_trie[idx]);
+  }
+  return true;
+}
+
+inline uint32_t token_trie_image_word(const uint8_t *bytes, const size_t index) noexcept {
+  const uint8_t *word = bytes + index * sizeof(uint32_t);
+  return static_cast<uint32_t>(word[0]) | (static_cast<uint32_t>(word[1]) << 8u) |
+         (static_cast<uint32_t>(word[2]) << 16u) | (static_cast<uint32_t>(word[3]) << 24u);
+}
+
+// Restores an image written by serialize_token_trie for this vocab into its
+// reserved trie table. A foreign or truncated image leaves the vocab without
+// a trie and returns false.
+inline bool deserialize_token_trie(emel::model::data::vocab &vocab, const uint8_t *bytes,
+                                   const size_t byte_count) noexcept {
+  vocab.token_trie_units = 0;
+  vocab.token_trie_max_key = 0;
+  const size_t header_bytes = k_token_trie_image_header_words * sizeof(uint32_t);
+  if (bytes == nullptr || byte_count < header_bytes ||
+      token_trie_image_word(bytes, 0u) != k_token_trie_image_magic ||
+      token_trie_image_word(bytes, 1u) != k_token_trie_image_version ||
+      token_trie_image_word(bytes, 2u) != vocab.n_tokens) {
+    return false;
+  }
+  const uint32_t units = token_trie_image_word(bytes, 3u);
+  const size_t cell_count = static_cast<size_t>(units) * double_array_trie::k_unit_cells;
+  int32_t *cells = vocab.token_trie.data();
+  if (units == 0u || units > static_cast<uint32_t>(emel::model::data::k_max_token_trie_units) ||
+      byte_count != header_bytes + cell_count * sizeof(uint32_t) || cells == nullptr ||
+      token_trie_image_word(bytes, k_token_trie_image_header_words +
+                                       double_array_trie::k_check) != 0u) {
+    return false;
+  }
+  for (size_t idx = 0; idx < cell_count; ++idx) {
+    cells[idx] = static_cast<int32_t>(
+        token_trie_image_word(bytes, k_token_trie_image_header_words + idx));
+  }
+  vocab.token_trie_units = units;
+  vocab.token_trie_max_key = token_trie_image_word(bytes, 4u);
+  return true;
+}
+
+// Points `trie` at the vocab's shared trie. Returns false for a vocab whose
+// trie was never prepared; encoders do not build one during dispatch.
+inline bool bind_token_trie(double_array_trie &trie,
+                            const emel::model::data::vocab &vocab) noexcept {
+  trie.attach(vocab.token_trie.data(), vocab.token_trie_units, vocab.token_trie_max_key);
+  return vocab.token_trie_units != 0u;
+}
+
 struct spm_bigram {
   struct comparator {
     bool operator()(const spm_bigram &l, const spm_bigram &r) const {
@@ -122,35 +523,10 @@ constexpr uint32_t next_pow2(uint32_t v) {
   return v + 1;
 }
 
-constexpr uint32_t k_token_hash_size = next_pow2(
-  static_cast<uint32_t>(emel::model::data::k_max_vocab_tokens * 3u / 2u));
 constexpr uint32_t k_merge_hash_size = next_pow2(
   static_cast<uint32_t>(emel::model::data::k_max_merges * 3u / 2u));
-static_assert((k_token_hash_size & (k_token_hash_size - 1)) == 0, "token hash size");
 static_assert((k_merge_hash_size & (k_merge_hash_size - 1)) == 0, "merge hash size");
 
-struct token_map {
-  std::unique_ptr<uint32_t[]> hashes = nullptr;
-  std::unique_ptr<int32_t[]> values = nullptr;
-  uint32_t count = 0;
-
-  token_map()
-      : hashes(std::make_unique<uint32_t[]>(k_token_hash_size)),
-        values(std::make_unique<int32_t[]>(k_token_hash_size)) {
-    clear();
-  }
-
-  void clear() {
-    std::fill_n(hashes.get(), k_token_hash_size, 0u);
-    std::fill_n(values.get(), k_token_hash_size, k_token_null);
-    count = 0;
-  }
-
-  bool empty() const {
-    return count == 0;
-  }
-};
-
 struct merge_map {
   std::unique_ptr<uint32_t[]> hashes = nullptr;
   std::unique_ptr<int32_t[]> values = nullptr;
@@ -188,6 +564,60 @@ struct encode_scratch {
   uint32_t symbol_count = 0;
 };
 
+// Every merge pops one heap entry and pushes at most two replacement pairs, so a word of n
+// symbols never pushes more than 3 * (n - 1) entries. The trailing slot is a write sink for
+// suppressed pushes.
+constexpr size_t k_bpe_merge_heap_capacity = k_max_encode_symbols * 3u;
+
+struct bpe_merge_heap {
+  std::unique_ptr<bpe_bigram[]> entries = nullptr;
+  size_t count = 0;
+
+  bpe_merge_heap()
+      : entries(std::make_unique<bpe_bigram[]>(k_bpe_merge_heap_capacity + 1u)) {}
+
+  void clear() {
+    count = 0;
+  }
+};
+
+constexpr size_t k_bpe_word_cache_slots = 4096;
+constexpr size_t k_bpe_word_cache_max_bytes = 48;
+constexpr size_t k_bpe_word_cache_max_tokens = 16;
+static_assert((k_bpe_word_cache_slots & (k_bpe_word_cache_slots - 1)) == 0,
+              "bpe word cache slots");
+
+struct bpe_word_cache_slot {
+  uint32_t hash = 0;
+  uint32_t word_length = 0;
+  uint32_t token_count = 0;
+  std::array<char, k_bpe_word_cache_max_bytes> word = {};
+  std::array<int32_t, k_bpe_word_cache_max_tokens> tokens = {};
+};
+
+// Direct-mapped word -> token ids memo owned by one encoder actor. Slots are written only by
+// the owning actor during its RTC chain, so lookups never take a lock; a colliding word simply
+// replaces the resident entry, which keeps the footprint fixed regardless of corpus size.
+struct bpe_word_cache {
+  std::unique_ptr<bpe_word_cache_slot[]> slots = nullptr;
+  bpe_word_cache_slot sink = {};
+  uint32_t count = 0;
+
+  bpe_word_cache()
+      : slots(std::make_unique<bpe_word_cache_slot[]>(k_bpe_word_cache_slots)) {
+    clear();
+  }
+
+  void clear() {
+    for (size_t idx = 0; idx < k_bpe_word_cache_slots; ++idx) {
+      slots[idx].hash = 0u;
+      slots[idx].word_length = 0u;
+      slots[idx].token_count = 0u;
+    }
+    count = 0;
+  }
+};
+
 struct encode_result {
   int32_t token_count = 0;
   int32_t error = emel::text::encoders::error::to_emel(emel::text::encoders::error::code::ok);
@@ -61,34 +61,6 @@ inline int32_t lookup_token_exact(const emel::model::data::vocab & vocab,
   return resolved;
 }
 
-inline bool ugm_read_has_value_none(const emel::text::encoders::detail::naive_trie::node *) noexcept {
-  return false;
-}
-
-inline bool ugm_read_has_value_some(const emel::text::encoders::detail::naive_trie::node * node) noexcept {
-  return node->has_value;
-}
-
-inline int32_t ugm_read_token_none(const emel::text::encoders::detail::naive_trie::node *) noexcept {
-  return 0;
-}
-
-inline int32_t ugm_read_token_some(const emel::text::encoders::detail::naive_trie::node * node) noexcept {
-  return node->value;
-}
-
-inline const emel::text::encoders::detail::naive_trie::node * ugm_trie_step_none(
-  const emel::text::encoders::detail::naive_trie::node *,
-  const char) noexcept {
-  return nullptr;
-}
-
-inline const emel::text::encoders::detail::naive_trie::node * ugm_trie_step_some(
-  const emel::text::encoders::detail::naive_trie::node * node,
-  const char c) noexcept {
-  return emel::text::encoders::ugm::detail::ugm_trie_step(*node, c);
-}
-
 inline void run_dp_forward(const runtime::encode_runtime & ev, context & ctx) noexcept {
   const auto & vocab = *ctx.vocab;
   const std::string_view normalized = ev.normalized;
@@ -100,40 +72,26 @@ inline void run_dp_forward(const runtime::encode_runtime & ev, context & ctx) no
       safe_input_len - input_offset);
     bool single_codepoint_token_found = false;
     const auto current_best = ctx.best[input_offset];
-    const auto *node = emel::text::encoders::ugm::detail::ugm_trie_root(
-      ctx.token_matcher, normalized[input_offset]);
-    using read_bool_handler_t = bool (*)(const emel::text::encoders::detail::naive_trie::node *) noexcept;
-    const read_bool_handler_t read_has_value_handlers[2] = {
-      ugm_read_has_value_none,
-      ugm_read_has_value_some,
-    };
-    using read_i32_handler_t = int32_t (*)(const emel::text::encoders::detail::naive_trie::node *) noexcept;
-    const read_i32_handler_t read_token_handlers[2] = {
-      ugm_read_token_none,
-      ugm_read_token_some,
-    };
-    using step_handler_t = const emel::text::encoders::detail::naive_trie::node * (*)(
-      const emel::text::encoders::detail::naive_trie::node *,
-      char) noexcept;
-    const step_handler_t step_handlers[2] = {
-      ugm_trie_step_none,
-      ugm_trie_step_some,
-    };
-
-    const size_t max_prefix_steps = safe_input_len - input_offset;
+    const auto & trie = ctx.token_trie;
+    int32_t state = trie.k_root;
+
+    // No vocab piece is longer than the trie's deepest key, so the lattice
+    // only has edges within that window.
+    const size_t max_prefix_steps = std::min(
+      safe_input_len - input_offset, static_cast<size_t>(trie.max_key_length));
     for (size_t step = 0; step < max_prefix_steps; ++step) {
       const size_t prefix_offset = input_offset + step + 1u;
-      const bool active = node != nullptr;
-      const bool has_value =
-        read_has_value_handlers[static_cast<size_t>(active)](node);
-      const bool single_codepoint = prefix_offset - input_offset == n_utf8_code_units;
-      single_codepoint_token_found = single_codepoint_token_found || (has_value && single_codepoint);
-      const int32_t token_id = read_token_handlers[static_cast<size_t>(active)](node);
+      state = trie.step(state, static_cast<uint8_t>(normalized[input_offset + step]));
+      const int32_t token_id = trie.value(state);
       const bool token_id_valid = token_id >= 0 && static_cast<uint32_t>(token_id) < vocab.n_tokens;
       const uint32_t safe_token_id = emel::text::encoders::ugm::detail::select_u32(
         token_id_valid, static_cast<uint32_t>(token_id), 0u);
       const auto & token_data = vocab.entries[safe_token_id];
-      const bool scored_value = has_value && token_id_valid;
+      const bool has_value = token_id_valid &&
+        emel::text::encoders::ugm::detail::ugm_matchable_type(token_data.type);
+      const bool single_codepoint = prefix_offset - input_offset == n_utf8_code_units;
+      single_codepoint_token_found = single_codepoint_token_found || (has_value && single_codepoint);
+      const bool scored_value = has_value;
       const bool is_user_defined = token_data.type == 4;
       const std::array<double, 2> score_table{
         static_cast<double>(token_data.score),
@@ -149,17 +107,6 @@ inline void run_dp_forward(const runtime::encode_runtime & ev, context & ctx) no
         better, static_cast<uint32_t>(input_offset), current_champ.input_offset);
       current_champ.score_sum = emel::text::encoders::ugm::detail::select_f64(
         better, challenger_score, current_champ.score_sum);
-
-      const bool can_advance = active && prefix_offset < safe_input_len;
-      const size_t safe_offset =
-        emel::text::encoders::ugm::detail::select_size(can_advance, prefix_offset, input_offset);
-      const auto *next_node =
-        step_handlers[static_cast<size_t>(active)](node, normalized[safe_offset]);
-      const std::array<const emel::text::encoders::detail::naive_trie::node *, 2> options{
-        node,
-        next_node,
-      };
-      node = options[static_cast<size_t>(can_advance)];
     }
 
     const bool use_unk =
@@ -262,8 +209,6 @@ struct begin_encode_sync_vocab {
     emel::text::encoders::action::sync_vocab(ev.event_, ctx);
     ctx.ugm_tables_ready = false;
     ctx.ugm_vocab = nullptr;
-    ctx.token_matcher = emel::text::encoders::detail::naive_trie{};
-    ctx.user_defined_token_matcher = emel::text::encoders::detail::naive_trie{};
     ev.unk_id = emel::text::encoders::detail::k_token_null;
     ev.normalized = std::string_view{};
     ev.traced_count = 0u;
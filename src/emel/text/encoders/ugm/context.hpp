@@ -17,8 +17,6 @@ struct best_tokenization {
 };
 
 struct context : emel::text::encoders::action::context {
-  emel::text::encoders::detail::naive_trie token_matcher = {};
-  emel::text::encoders::detail::naive_trie user_defined_token_matcher = {};
   const uint32_t *xcda_table = nullptr;
   size_t xcda_table_size = 0;
   const char *prefix_replacements = nullptr;
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <limits>
 #include <string>
+#include <string_view>
 
 #include "emel/text/encoders/ugm/context.hpp"
 #include "emel/text/encoders/detail.hpp"
@@ -75,35 +76,6 @@ inline std::string_view ugm_token_text(const emel::model::data::vocab &vocab,
                           static_cast<size_t>(length));
 }
 
-inline const emel::text::encoders::detail::naive_trie::node *ugm_trie_root(
-  const emel::text::encoders::detail::naive_trie &trie,
-  const char c) noexcept {
-  const int32_t idx = trie.nodes[0].next[static_cast<uint8_t>(c)];
-  const bool valid = idx >= 0 && static_cast<size_t>(idx) < trie.nodes.size();
-  const size_t safe_idx = select_size(valid, static_cast<size_t>(idx), static_cast<size_t>(0));
-  const auto *candidate = &trie.nodes[safe_idx];
-  const std::array<const emel::text::encoders::detail::naive_trie::node *, 2> options{
-    nullptr,
-    candidate,
-  };
-  return options[static_cast<size_t>(valid)];
-}
-
-inline const emel::text::encoders::detail::naive_trie::node *ugm_trie_step(
-  const emel::text::encoders::detail::naive_trie::node &node,
-  const char c) noexcept {
-  const int32_t idx = node.next[static_cast<uint8_t>(c)];
-  const auto &nodes = *node.nodes_ref;
-  const bool valid = idx >= 0 && static_cast<size_t>(idx) < nodes.size();
-  const size_t safe_idx = select_size(valid, static_cast<size_t>(idx), static_cast<size_t>(0));
-  const auto *candidate = &nodes[safe_idx];
-  const std::array<const emel::text::encoders::detail::naive_trie::node *, 2> options{
-    nullptr,
-    candidate,
-  };
-  return options[static_cast<size_t>(valid)];
-}
-
 struct xcda_blob_info {
   const uint8_t *data = nullptr;
   uint32_t blob_size = 0u;
@@ -168,59 +140,35 @@ inline bool ugm_tables_ready(const emel::text::encoders::ugm::action::context &c
   return ctx.ugm_tables_ready && ctx.ugm_vocab == &vocab;
 }
 
-inline void ugm_insert_token_none(emel::text::encoders::detail::naive_trie &,
-                                  const std::string_view,
-                                  const int32_t) noexcept {}
-
-inline void ugm_insert_token_some(emel::text::encoders::detail::naive_trie &trie,
-                                  const std::string_view text,
-                                  const int32_t id) noexcept {
-  trie.insert(text.data(), text.size(), id);
-}
+using emel::text::encoders::detail::ugm_matchable_type;
 
 inline bool rebuild_ugm_tables(emel::text::encoders::ugm::action::context &ctx,
                                const emel::model::data::vocab &vocab) noexcept {
   ctx.ugm_vocab = &vocab;
   ctx.ugm_tables_ready = false;
-  ctx.token_matcher = emel::text::encoders::detail::naive_trie{};
-  ctx.user_defined_token_matcher = emel::text::encoders::detail::naive_trie{};
   ctx.min_score = std::numeric_limits<float>::max();
   ctx.max_score = -std::numeric_limits<float>::max();
 
+  // Lattice pieces and user-defined pieces both match through the vocab's
+  // token trie, which the loader builds from matchable pieces only.
+  const bool trie_ready =
+      emel::text::encoders::detail::bind_token_trie(ctx.token_trie, vocab);
   for (uint32_t id = 0; id < vocab.n_tokens; ++id) {
     const auto &entry = vocab.entries[id];
-    const std::string_view text = ugm_token_text(vocab, static_cast<int32_t>(id));
-    const bool has_text = !text.empty();
-    const int32_t type = entry.type;
-    const bool is_normal = type == 1;
-    const bool is_user_defined = type == 4;
-    const bool is_unused = type == 5;
-    const bool insert_general = has_text && (is_normal || is_user_defined || is_unused);
-    const bool insert_user_defined = has_text && is_user_defined;
-    const bool update_min = has_text && is_normal;
+    const bool has_text = !ugm_token_text(vocab, static_cast<int32_t>(id)).empty();
+    const bool update_min = has_text && entry.type == 1;
     const float min_candidate = std::min(ctx.min_score, entry.score);
     const float max_candidate = std::max(ctx.max_score, entry.score);
     ctx.min_score = select_f32(update_min, min_candidate, ctx.min_score);
     ctx.max_score = select_f32(update_min, max_candidate, ctx.max_score);
-
-    using insert_handler_t =
-        void (*)(emel::text::encoders::detail::naive_trie &, std::string_view, int32_t) noexcept;
-    const insert_handler_t insert_handlers[2] = {
-        ugm_insert_token_none,
-        ugm_insert_token_some,
-    };
-    insert_handlers[static_cast<size_t>(insert_general)](
-        ctx.token_matcher, text, static_cast<int32_t>(id));
-    insert_handlers[static_cast<size_t>(insert_user_defined)](
-        ctx.user_defined_token_matcher, text, static_cast<int32_t>(id));
   }
 
   const bool has_normal_scores = ctx.min_score != std::numeric_limits<float>::max();
   ctx.min_score = select_f32(has_normal_scores, ctx.min_score, 0.0f);
   ctx.unknown_token_score = ctx.min_score - ctx.unknown_token_score_penalty;
   init_xcda_tables(ctx);
-  ctx.ugm_tables_ready = true;
-  return true;
+  ctx.ugm_tables_ready = trie_ready;
+  return trie_ready;
 }
 
 inline bool keep_ugm_tables(emel::text::encoders::ugm::action::context &,
@@ -283,52 +231,25 @@ struct normalization_result {
   size_t consumed_input = 0;
 };
 
-inline size_t trie_longest_prefix_none(const emel::text::encoders::detail::naive_trie &,
-                                       const char *,
-                                       const size_t) noexcept {
-  return 0u;
-}
-
-inline size_t trie_longest_prefix_some(const emel::text::encoders::detail::naive_trie &trie,
-                                       const char *text,
-                                       const size_t len) noexcept {
-  using node = emel::text::encoders::detail::naive_trie::node;
-  using step_handler_t = const node *(*)(const node *, char) noexcept;
-  const auto step_inactive = +[](const node *, const char) noexcept -> const node * {
-    return nullptr;
-  };
-  const auto step_active = +[](const node *current, const char c) noexcept -> const node * {
-    return ugm_trie_step(*current, c);
-  };
-  const step_handler_t step_handlers[2] = {
-      step_inactive,
-      step_active,
-  };
-
+// Longest prefix of `text` that spells a user-defined piece.
+inline size_t user_defined_prefix(const emel::text::encoders::detail::double_array_trie &trie,
+                                  const emel::model::data::vocab &vocab,
+                                  const char *text,
+                                  const size_t len) noexcept {
+  const size_t bounded_len = std::min(len, static_cast<size_t>(trie.max_key_length));
   size_t matched = 0;
-  const node *current = ugm_trie_root(trie, text[0]);
-  matched = select_size(current != nullptr && current->has_value, static_cast<size_t>(1), matched);
-  for (size_t offset = 1; offset < len; ++offset) {
-    const bool step_active = current != nullptr;
-    current = step_handlers[static_cast<size_t>(step_active)](current, text[offset]);
-    matched = select_size(current != nullptr && current->has_value, offset + 1u, matched);
+  int32_t state = trie.k_root;
+  for (size_t offset = 0; offset < bounded_len; ++offset) {
+    state = trie.step(state, static_cast<uint8_t>(text[offset]));
+    const int32_t id = trie.value(state);
+    const bool valid_id = id >= 0 && static_cast<uint32_t>(id) < vocab.n_tokens;
+    const uint32_t safe_id = select_u32(valid_id, static_cast<uint32_t>(id), 0u);
+    const bool user_defined = valid_id && vocab.entries[safe_id].type == 4;
+    matched = select_size(user_defined, offset + 1u, matched);
   }
   return matched;
 }
 
-inline size_t trie_longest_prefix(const emel::text::encoders::detail::naive_trie &trie,
-                                  const char *text,
-                                  const size_t len) noexcept {
-  using prefix_handler_t = size_t (*)(const emel::text::encoders::detail::naive_trie &,
-                                      const char *,
-                                      size_t) noexcept;
-  const prefix_handler_t prefix_handlers[2] = {
-      trie_longest_prefix_none,
-      trie_longest_prefix_some,
-  };
-  return prefix_handlers[static_cast<size_t>(len > 0u)](trie, text, len);
-}
-
 inline normalization_result normalize_prefix_at_end(const std::string_view input,
                                                     const size_t input_offset) noexcept {
   return {input.data() + input_offset, 0, 0};
@@ -461,10 +382,9 @@ inline normalization_result normalize_prefix_not_end(const emel::model::data::vo
                                                      emel::text::encoders::ugm::action::context &ctx,
                                                      const std::string_view input,
                                                      const size_t input_offset) noexcept {
-  (void)vocab;
   const size_t remaining = input.size() - input_offset;
-  const size_t user_len = trie_longest_prefix(
-      ctx.user_defined_token_matcher, input.data() + input_offset, remaining);
+  const size_t user_len = user_defined_prefix(
+      ctx.token_trie, vocab, input.data() + input_offset, remaining);
   const bool user_hit = user_len > 0u;
   using user_handler_t = normalization_result (*)(std::string_view, size_t, size_t) noexcept;
   const user_handler_t user_handlers[2] = {
@@ -6,6 +6,7 @@
 #include <cstring>
 #include <string>
 #include <string_view>
+#include <utility>
 #include <vector>
 
 #include "emel/text/encoders/wpm/context.hpp"
@@ -40,22 +41,6 @@ inline size_t select_size(const bool choose_true,
   return (false_value & ~mask) | (true_value & mask);
 }
 
-constexpr uint32_t k_fnv_offset = 2166136261u;
-constexpr uint32_t k_fnv_prime = 16777619u;
-
-inline uint32_t wpm_hash_bytes(const uint32_t seed, const std::string_view text) noexcept {
-  uint32_t hash = seed;
-  for (const unsigned char byte : text) {
-    hash ^= byte;
-    hash *= k_fnv_prime;
-  }
-  return select_u32(hash != 0u, hash, 1u);
-}
-
-inline uint32_t wpm_hash_sv(const std::string_view text) noexcept {
-  return wpm_hash_bytes(k_fnv_offset, text);
-}
-
 inline std::string_view wpm_token_text(const emel::model::data::vocab &vocab,
                                        const int32_t id) noexcept {
   const bool valid_id = id >= 0 && static_cast<uint32_t>(id) < vocab.n_tokens;
@@ -69,40 +54,6 @@ inline std::string_view wpm_token_text(const emel::model::data::vocab &vocab,
     static_cast<size_t>(length));
 }
 
-inline bool wpm_insert_token_map(emel::text::encoders::detail::token_map &map,
-                                 const emel::model::data::vocab &vocab,
-                                 const std::string_view text,
-                                 const int32_t id) noexcept {
-  const bool text_empty = text.empty();
-  bool done = text_empty;
-  bool success = text_empty;
-  const uint32_t hash = wpm_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = map.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t existing_id = map.values[slot];
-    const std::string_view existing_text = wpm_token_text(vocab, existing_id);
-    const bool same_text = hash_match && existing_text == text;
-    const bool claim_slot = empty_slot || same_text;
-
-    map.hashes[slot] = select_u32(claim_slot, hash, slot_hash);
-    map.values[slot] = select_i32(claim_slot, id, existing_id);
-    map.count += static_cast<uint32_t>(claim_slot && empty_slot);
-
-    success = success || claim_slot;
-    done = done || claim_slot;
-    slot = (slot + 1u) & mask;
-  }
-
-  return success;
-}
-
 inline void ensure_wpm_tables_rebuild_none(emel::text::encoders::action::context &,
                                            const emel::model::data::vocab &,
                                            bool &) noexcept {}
@@ -112,18 +63,8 @@ inline void ensure_wpm_tables_rebuild_some(emel::text::encoders::action::context
                                            bool &ok) noexcept {
   ctx.vocab = &vocab;
   ctx.tables_ready = false;
-  ctx.token_to_id.clear();
-  ctx.max_token_len = 0;
-
-  for (uint32_t id = 0; id < vocab.n_tokens; ++id) {
-    const std::string_view text = wpm_token_text(vocab, static_cast<int32_t>(id));
-    const bool inserted = wpm_insert_token_map(
-      ctx.token_to_id, vocab, text, static_cast<int32_t>(id));
-    ok = ok && inserted;
-    const int32_t text_len = static_cast<int32_t>(text.size());
-    const bool longer = text_len > ctx.max_token_len;
-    ctx.max_token_len = select_i32(longer, text_len, ctx.max_token_len);
-  }
+  ok = ok && emel::text::encoders::detail::bind_token_trie(ctx.token_trie, vocab);
+  ctx.max_token_len = static_cast<int32_t>(ctx.token_trie.max_key_length);
 
   ctx.tables_ready = ok;
 }
@@ -144,30 +85,9 @@ inline bool ensure_wpm_tables(emel::text::encoders::action::context &ctx,
 }
 
 inline int32_t wpm_lookup_token(const emel::text::encoders::action::context &ctx,
-                                const emel::model::data::vocab &vocab,
+                                const emel::model::data::vocab &,
                                 const std::string_view text) noexcept {
-  const bool active = !text.empty();
-  bool done = !active;
-  int32_t resolved = k_token_null;
-  const uint32_t hash = wpm_hash_sv(text);
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1u;
-  uint32_t slot = hash & mask;
-
-  for (uint32_t probes = 0;
-       probes < emel::text::encoders::detail::k_token_hash_size && !done;
-       ++probes) {
-    const uint32_t slot_hash = ctx.token_to_id.hashes[slot];
-    const bool empty_slot = slot_hash == 0u;
-    const bool hash_match = slot_hash == hash;
-    const int32_t id = ctx.token_to_id.values[slot];
-    const bool exact = hash_match && wpm_token_text(vocab, id) == text;
-
-    resolved = select_i32(exact, id, resolved);
-    done = done || empty_slot || exact;
-    slot = (slot + 1u) & mask;
-  }
-
-  return resolved;
+  return ctx.token_trie.find(text);
 }
 
 inline bool wpm_push_token(const event::encode &ev, const int32_t token, int32_t &count) noexcept {
@@ -306,36 +226,6 @@ inline void wpm_copy_word_some(emel::text::encoders::action::context &ctx,
   std::memcpy(ctx.scratch.buffer.data(), word.data(), word.size());
 }
 
-inline void wpm_copy_continuation_piece_none(
-    emel::text::encoders::action::context &,
-    const std::string_view) noexcept {}
-
-inline void wpm_copy_continuation_piece_some(
-    emel::text::encoders::action::context &ctx,
-    const std::string_view piece) noexcept {
-  std::memcpy(ctx.scratch.buffer_alt.data(),
-              k_wpm_continuation_prefix,
-              k_wpm_continuation_prefix_len);
-  std::memcpy(ctx.scratch.buffer_alt.data() + k_wpm_continuation_prefix_len,
-              piece.data(),
-              piece.size());
-}
-
-inline void wpm_copy_word_start_piece_none(
-    emel::text::encoders::action::context &,
-    const std::string_view) noexcept {}
-
-inline void wpm_copy_word_start_piece_some(
-    emel::text::encoders::action::context &ctx,
-    const std::string_view piece) noexcept {
-  std::memcpy(ctx.scratch.buffer_alt.data(),
-              k_wpm_word_start_prefix,
-              k_wpm_word_start_prefix_len);
-  std::memcpy(ctx.scratch.buffer_alt.data() + k_wpm_word_start_prefix_len,
-              piece.data(),
-              piece.size());
-}
-
 inline void wpm_push_candidate_none(const event::encode &,
                                     const int32_t,
                                     int32_t &,
@@ -360,18 +250,6 @@ inline void wpm_resolve_unk_some(const emel::text::encoders::action::context &ct
   unk = wpm_lookup_token(ctx, vocab, "<unk>");
 }
 
-inline int32_t wpm_lookup_candidate_none(const emel::text::encoders::action::context &,
-                                         const emel::model::data::vocab &,
-                                         const std::string_view) noexcept {
-  return k_token_null;
-}
-
-inline int32_t wpm_lookup_candidate_some(const emel::text::encoders::action::context &ctx,
-                                         const emel::model::data::vocab &vocab,
-                                         const std::string_view piece) noexcept {
-  return wpm_lookup_token(ctx, vocab, piece);
-}
-
 inline bool encode_wpm_process_word_none(const event::encode &,
                                          emel::text::encoders::action::context &,
                                          const emel::model::data::vocab &,
@@ -405,11 +283,19 @@ inline bool encode_wpm_process_word_some(const event::encode &ev,
   const int32_t n = static_cast<int32_t>(word_view.size());
   int32_t cursor = 0;
 
+  const auto &trie = ctx.token_trie;
+  const std::array<std::string_view, 2> markers = {
+      std::string_view(k_wpm_word_start_prefix, k_wpm_word_start_prefix_len),
+      std::string_view(k_wpm_continuation_prefix, k_wpm_continuation_prefix_len),
+  };
+  const std::array<int32_t, 2> marker_states = {
+      trie.walk(trie.k_root, markers[0]),
+      trie.walk(trie.k_root, markers[1]),
+  };
+
   for (int32_t step = 0; step < n; ++step) {
     const bool step_active = ok && cursor < n;
     const int32_t i = select_i32(step_active, cursor, 0);
-    bool found = false;
-    int32_t matched_end = i;
     const bool continuation = step_active && i > 0;
     const int32_t prefix_len = select_i32(
       continuation,
@@ -417,91 +303,45 @@ inline bool encode_wpm_process_word_some(const event::encode &ev,
       0);
     const int32_t max_piece_len = std::max(1, ctx.max_token_len - prefix_len);
     const int32_t end = select_i32(step_active, std::min(n, i + max_piece_len), i);
-    bool scan_active = step_active;
-    for (int32_t j = end; j > i; --j) {
-      const bool scan_step_active = scan_active;
-      const size_t piece_offset = static_cast<size_t>(select_i32(scan_step_active, i, 0));
-      const size_t piece_size = static_cast<size_t>(select_i32(
-        scan_step_active,
-        j - i,
-        0));
-      const std::string_view raw_piece(word_view.data() + piece_offset, piece_size);
-      const bool continuation_piece = scan_step_active && i > 0;
-
-      for (int32_t candidate_index = 0; candidate_index < 2; ++candidate_index) {
-        const bool candidate_scan_active = scan_active;
-        const bool prefixed_candidate =
-            candidate_scan_active && candidate_index == 0;
-        const size_t prefix_len = select_size(
-            continuation_piece,
-            k_wpm_continuation_prefix_len,
-            k_wpm_word_start_prefix_len);
-        const size_t candidate_size =
-            piece_size + (prefix_len * static_cast<size_t>(prefixed_candidate));
-        const bool candidate_fits =
-            !prefixed_candidate || candidate_size <= ctx.scratch.buffer_alt.size();
-
-        using prefixed_handler_t = void (*)(emel::text::encoders::action::context &,
-                                            const std::string_view) noexcept;
-        const prefixed_handler_t prefixed_handlers[2][2] = {
-            {
-                wpm_copy_word_start_piece_none,
-                wpm_copy_word_start_piece_some,
-            },
-            {
-                wpm_copy_continuation_piece_none,
-                wpm_copy_continuation_piece_some,
-            },
-        };
-        prefixed_handlers[static_cast<size_t>(continuation_piece)]
-                         [static_cast<size_t>(prefixed_candidate && candidate_fits)](
-                             ctx, raw_piece);
-
-        const char *candidate_bases[2] = {raw_piece.data(), ctx.scratch.buffer_alt.data()};
-        const char *candidate_data =
-            candidate_bases[static_cast<size_t>(prefixed_candidate)];
-        const size_t safe_candidate_size = select_size(candidate_fits, candidate_size, 0u);
-        const std::string_view piece(candidate_data, safe_candidate_size);
-
-        using lookup_handler_t = int32_t (*)(const emel::text::encoders::action::context &,
-                                             const emel::model::data::vocab &,
-                                             const std::string_view) noexcept;
-        const lookup_handler_t lookup_handlers[2] = {
-            wpm_lookup_candidate_none,
-            wpm_lookup_candidate_some,
-        };
-        const int32_t token =
-            lookup_handlers[static_cast<size_t>(candidate_scan_active && candidate_fits)](
-                ctx, vocab, piece);
-        const bool hit = token != k_token_null;
-
-        bool pushed = true;
-        using push_handler_t = void (*)(const event::encode &,
-                                        int32_t,
-                                        int32_t &,
-                                        bool &) noexcept;
-        const push_handler_t push_handlers[2] = {
-            wpm_push_candidate_none,
-            wpm_push_candidate_some,
-        };
-        push_handlers[static_cast<size_t>(candidate_scan_active && hit)](
-            ev, token, count, pushed);
-
-        const bool found_step = candidate_scan_active && hit;
-        const bool push_fail = found_step && !pushed;
-        result.error = select_i32(
-            push_fail,
-            emel::text::encoders::error::to_emel(
-                emel::text::encoders::error::code::invalid_argument),
-            result.error);
-        ok = ok && !push_fail;
-        found = found || found_step;
-        matched_end = select_i32(found_step, j, matched_end);
-        scan_active = scan_active && !push_fail && !found_step;
-      }
+
+    // The marked and raw candidates share the piece bytes, so one forward walk
+    // finds the longest match; at equal length the marked piece wins.
+    int32_t marked_state = marker_states[static_cast<size_t>(continuation)];
+    int32_t raw_state = trie.k_root;
+    int32_t token = k_token_null;
+    int32_t matched_end = i;
+    for (int32_t j = i; j < end; ++j) {
+      const uint8_t c = static_cast<uint8_t>(word_view[static_cast<size_t>(j)]);
+      marked_state = trie.step(marked_state, c);
+      raw_state = trie.step(raw_state, c);
+      const int32_t marked_id = trie.value(marked_state);
+      const int32_t raw_id = trie.value(raw_state);
+      const int32_t candidate = select_i32(marked_id != k_token_null, marked_id, raw_id);
+      const bool hit = candidate != k_token_null;
+      token = select_i32(hit, candidate, token);
+      matched_end = select_i32(hit, j + 1, matched_end);
     }
 
-    const bool advance_cursor = step_active && found;
+    const bool found = step_active && token != k_token_null;
+    bool pushed = true;
+    using push_handler_t = void (*)(const event::encode &,
+                                    int32_t,
+                                    int32_t &,
+                                    bool &) noexcept;
+    const push_handler_t push_handlers[2] = {
+        wpm_push_candidate_none,
+        wpm_push_candidate_some,
+    };
+    push_handlers[static_cast<size_t>(found)](ev, token, count, pushed);
+    const bool push_fail = found && !pushed;
+    result.error = select_i32(
+        push_fail,
+        emel::text::encoders::error::to_emel(
+            emel::text::encoders::error::code::invalid_argument),
+        result.error);
+    ok = ok && !push_fail;
+
+    const bool advance_cursor = found && !push_fail;
     cursor = select_i32(advance_cursor, matched_end, cursor);
     const bool rollback = step_active && !found;
     count = select_i32(rollback, word_token_start, count);
@@ -132,7 +132,8 @@ struct reject_initialize {
 };
 
 struct begin_generate {
-  void operator()(const event::generate_run & ev, context &) const noexcept {
+  void operator()(const event::generate_run & ev, context & ctx) const noexcept {
+    latency::begin_request(ctx.runtime_policy.latency);
     ev.ctx.err = emel::error::cast(error::none);
     ev.ctx.phase_accepted = false;
     ev.ctx.phase_code = 0;
@@ -263,7 +264,10 @@ struct request_initializer {
 struct request_prefill {
   void operator()(const event::generate_run & ev, context & ctx) const noexcept {
     const emel::text::generator::prefill::event::run runtime{ev.request, ev.ctx};
+    const uint64_t started_ns = latency::now(ctx.runtime_policy.latency);
     ev.ctx.phase_accepted = ctx.dispatch_prefill(ctx.prefill_actor, runtime);
+    latency::record_prefill(ctx.runtime_policy.latency, started_ns,
+                            ev.ctx.prompt_token_count);
   }
 };
 
@@ -906,7 +910,10 @@ struct request_decode_sample {
       ev.ctx.selected_token,
       sample_error,
     };
+    const uint64_t started_ns = latency::now(ctx.runtime_policy.latency);
     ev.ctx.phase_accepted = ctx.sampler.process_event(sample_ev);
+    latency::record(ctx.runtime_policy.latency, latency::metric::sampler,
+                    started_ns);
     ev.ctx.phase_code = static_cast<int32_t>(sample_error);
   }
 };
@@ -937,7 +944,10 @@ struct request_decode_sample_preselected {
       ev.ctx.selected_token,
       sample_error,
     };
+    const uint64_t started_ns = latency::now(ctx.runtime_policy.latency);
     ev.ctx.phase_accepted = ctx.sampler.process_event(sample_ev);
+    latency::record(ctx.runtime_policy.latency, latency::metric::sampler,
+                    started_ns);
     ev.ctx.phase_code = static_cast<int32_t>(sample_error);
   }
 };
@@ -955,7 +965,10 @@ struct request_decode_render {
     render_ev.output_length_out = &ev.ctx.phase_output_length;
     render_ev.status_out = &ev.ctx.render_status;
     render_ev.error_out = &ev.ctx.phase_code;
+    const uint64_t started_ns = latency::now(ctx.runtime_policy.latency);
     ev.ctx.phase_accepted = ctx.renderer.process_event(render_ev);
+    latency::record(ctx.runtime_policy.latency, latency::metric::renderer,
+                    started_ns);
   }
 };
 
@@ -1013,7 +1026,8 @@ struct advance_kv_cache {
 };
 
 struct commit_render_output {
-  void operator()(const event::generate_run & ev, context &) const noexcept {
+  void operator()(const event::generate_run & ev, context & ctx) const noexcept {
+    latency::record_token(ctx.runtime_policy.latency);
     const int32_t token_index = ev.ctx.tokens_generated;
     if (token_index >= 0 &&
         static_cast<size_t>(token_index) < ev.request.generated_token_ids_out.size()) {
@@ -1176,6 +1190,9 @@ struct capture_diagnostics {
     ev.out.native_q8_0_dispatch_calls = backend.native_q8_0_dispatch_calls;
     ev.out.packed_q8_0_dispatch_calls = backend.packed_q8_0_dispatch_calls;
     ev.out.flash_attention_dispatch_calls = backend.flash_attention_dispatch_calls;
+    ev.out.roofline_flops = backend.roofline.flops;
+    ev.out.roofline_bytes = backend.roofline.bytes;
+    latency::summarize(ctx.runtime_policy.latency, ev.out.latency);
     ev.out.optimized_flash_dispatch_calls =
         total(&emel::kernel::sm::optimized_flash_dispatch_count,
               matmul.optimized_flash_dispatch_calls);
@@ -1292,6 +1309,52 @@ struct capture_graph_lifecycle_with_runtime_tensor {
   }
 };
 
+struct effect_capture_prepared_weights {
+  void operator()(const event::capture_prepared_weights & ev,
+                  const context & ctx) const noexcept {
+    detail::capture_prepared_weights(ctx.compute.backend, ev.out);
+  }
+};
+
+struct effect_capture_prepared_weights_unprepared {
+  void operator()(const event::capture_prepared_weights & ev,
+                  const context &) const noexcept {
+    ev.out.image_bytes = 0u;
+    ev.out.layout_count = 0u;
+    ev.out.cache_hits = 0u;
+    ev.out.cache_misses = 0u;
+    ev.out.written = false;
+  }
+};
+
+// Logits and the sampler's candidate ids/scores are vocab-sized; the prompt and
+// position arrays are fixed.
+inline uint64_t session_buffer_bytes(const session_buffers & buffers) noexcept {
+  const uint64_t vocab = static_cast<uint64_t>(std::max(buffers.vocab_size, 0));
+  return vocab * (sizeof(float) + sizeof(int32_t) + sizeof(float)) +
+         emel::memory::footprint::bytes_of(buffers.prompt_tokens) +
+         emel::memory::footprint::bytes_of(buffers.positions);
+}
+
+struct effect_capture_memory_footprint {
+  void operator()(const event::capture_memory_footprint & ev,
+                  const context & ctx) const noexcept {
+    ev.out = {};
+    emel::memory::footprint::add_model(ev.out, *ctx.model, ev.residency);
+    detail::capture_memory_footprint(ctx.compute.backend, ev.out);
+    ev.out.scratch_bytes += session_buffer_bytes(ctx.buffers);
+  }
+};
+
+// Before initialize only the session buffers exist; no weights are bound.
+struct effect_capture_memory_footprint_unprepared {
+  void operator()(const event::capture_memory_footprint & ev,
+                  const context & ctx) const noexcept {
+    ev.out = {};
+    ev.out.scratch_bytes = session_buffer_bytes(ctx.buffers);
+  }
+};
+
 inline void apply_benchmark_lane_policy(context & ctx) noexcept {
   ctx.compute.backend.parallel_lanes_enabled =
       ctx.benchmark_parallel_lanes_enabled;
@@ -1466,5 +1529,11 @@ inline constexpr capture_graph_lifecycle_without_runtime_tensor
     capture_graph_lifecycle_without_runtime_tensor{};
 inline constexpr capture_graph_lifecycle_with_runtime_tensor
     capture_graph_lifecycle_with_runtime_tensor{};
+inline constexpr effect_capture_prepared_weights effect_capture_prepared_weights{};
+inline constexpr effect_capture_prepared_weights_unprepared
+    effect_capture_prepared_weights_unprepared{};
+inline constexpr effect_capture_memory_footprint effect_capture_memory_footprint{};
+inline constexpr effect_capture_memory_footprint_unprepared
+    effect_capture_memory_footprint_unprepared{};
 
 }  // namespace emel::text::generator::action
@@ -4,6 +4,7 @@
 #include <cstddef>
 #include <cstdint>
 #include <memory>
+#include <span>
 
 #include "emel/batch/planner/sm.hpp"
 #include "emel/text/generator/detail.hpp"
@@ -126,6 +127,9 @@ struct context {
   // owner's bind_window_done streaming_active report).
   emel::model::tensor::window::sm * stream_window = nullptr;
   bool stream_active = false;
+  // Prepared-weight sidecar the owner mapped read-only; prepare() binds packed
+  // layouts from it when its key matches and repacks otherwise.
+  std::span<const uint8_t> prepared_weights = {};
 
   emel::text::renderer::sm renderer = {};
   emel::batch::planner::sm planner = {};
@@ -5,6 +5,7 @@
 #include "emel/graph/sm.hpp"
 #include "emel/text/generator/decode_wavefront/context.hpp"
 #include "emel/text/generator/decode_wavefront/events.hpp"
+#include "emel/trace.hpp"
 
 namespace emel::text::generator::decode_wavefront::action {
 
@@ -50,6 +51,8 @@ template <size_t lane_index>
 struct effect_dispatch_lane {
   void operator()(const event::run & ev, context &) const noexcept {
     auto & lane = ev.lanes[lane_index];
+    const emel::trace::span traced{emel::trace::category::lane,
+                                   "wavefront/lane"};
     const emel::graph::event::compute_reserved reserved_compute{lane.compute};
     lane.accepted = lane.graph.process_event(reserved_compute);
     ev.out.dispatched_lanes = static_cast<int32_t>(lane_index + 1u);
@@ -73,6 +76,8 @@ struct effect_dispatch_parallel_lanes {
       const bool submitted =
           ctx.pool->try_submit(group, [lane_ptr, &gate]() noexcept {
         gate.arrive_and_wait();
+        const emel::trace::span traced{emel::trace::category::lane,
+                                       "wavefront/lane"};
         auto & current_lane = *lane_ptr;
         const emel::graph::event::compute_reserved reserved_compute{
             current_lane.compute};
@@ -84,6 +89,8 @@ struct effect_dispatch_parallel_lanes {
     }
     gate.open_after_arrivals(submitted_lanes);
     ev.out.all_submitted = all_submitted;
+    const emel::trace::span traced{emel::trace::category::lane,
+                                   "wavefront/join"};
     ev.out.joined = group.wait();
     ev.out.dispatched_lanes = static_cast<int32_t>(ev.lanes.size());
   }
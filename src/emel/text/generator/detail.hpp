@@ -19,14 +19,20 @@
 
 #include "emel/graph/processor/errors.hpp"
 #include "emel/kernel/events.hpp"
+#include "emel/kernel/profile.hpp"
+#include "emel/kernel/roofline.hpp"
 #include "emel/kernel/matmul/sm.hpp"
 #include "emel/kernel/sm.hpp"
+#include "emel/memory/footprint.hpp"
+#include "emel/memory/huge_pages.hpp"
+#include "emel/memory/numa_replicas.hpp"
 #include "emel/memory/view.hpp"
 #include "emel/model/data.hpp"
 #include "emel/model/generation/any.hpp"
 #include "emel/model/loader/errors.hpp"
 #include "emel/model/tensor/window/sm.hpp"
 #include "emel/text/generator/events.hpp"
+#include "emel/text/generator/prepared_cache.hpp"
 
 namespace emel::text::generator::detail {
 
@@ -51,7 +57,7 @@ inline constexpr rope_pairing neox_rope_pairing() noexcept {
 
 struct packed_matrix_binding {
   emel::model::data::tensor_record tensor = {};
-  std::vector<uint8_t> storage = {};
+  emel::memory::huge_pages::vector<uint8_t> storage = {};
   // The raw model record the packed layout was prepared from. Streamed slots
   // hold raw GGUF bytes, so the streamed rebase must clone this record (its
   // dtype/extents describe the slot bytes) while resident restore keeps the
@@ -197,6 +203,12 @@ struct native_backend {
   emel::model::generation::step_plan prefill_plan = {};
   emel::model::generation::step_plan decode_plan = {};
   emel::kernel::sm kernel = {};
+  // Owner-injected hardware-counter recorder (runtime_policy::kernel_profile);
+  // the layer and logits stages below attribute dispatches to it.
+  emel::kernel::profile::recorder *kernel_profile = nullptr;
+  // Owner-injected latency recorder (runtime_policy::latency); streamed
+  // layer acquires charge their wait to window_stall.
+  emel::text::generator::latency::recorder *latency = nullptr;
   emel::kernel::matmul::sm *matmul_actor = nullptr;
   route_policy routes = {};
   emel::kernel::matmul::lane_mode matmul_lane_mode =
@@ -207,6 +219,8 @@ struct native_backend {
   uint64_t native_q8_0_dispatch_calls = 0;
   uint64_t packed_q8_0_dispatch_calls = 0;
   uint64_t flash_attention_dispatch_calls = 0;
+  // Static flop/byte cost of every op dispatched so far (kernel::roofline).
+  emel::kernel::roofline::cost roofline = {};
 
   tensor_matrix token_embedding = {};
   std::vector<float> output_norm = {};
@@ -214,13 +228,13 @@ struct native_backend {
   tensor_matrix output = {};
   tensor_matrix output_argmax = {};
   emel::model::data::tensor_record output_packed_tensor = {};
-  std::vector<uint8_t> output_packed_storage = {};
+  emel::memory::huge_pages::vector<uint8_t> output_packed_storage = {};
   emel::model::data::tensor_record output_prepared_tensor = {};
-  std::vector<uint8_t> output_prepared_storage = {};
+  emel::memory::huge_pages::vector<uint8_t> output_prepared_storage = {};
   emel::model::data::tensor_record output_argmax_packed_tensor = {};
-  std::vector<uint8_t> output_argmax_packed_storage = {};
+  emel::memory::huge_pages::vector<uint8_t> output_argmax_packed_storage = {};
   emel::model::data::tensor_record output_argmax_prepared_tensor = {};
-  std::vector<uint8_t> output_argmax_prepared_storage = {};
+  emel::memory::huge_pages::vector<uint8_t> output_argmax_prepared_storage = {};
   std::vector<emel::kernel::detail::quant::block_q8_k> q8_input_storage = {};
   std::vector<emel::kernel::detail::quant::block_q8_k> q8_input_chunk4_storage =
       {};
@@ -234,6 +248,9 @@ struct native_backend {
   emel::model::generation::quantized_path_audit quantized_audit = {};
   std::vector<block_weights> blocks = {};
   stream_binding stream = {};
+  // Packed layouts bound by prepare(), and the owner-mapped sidecar they may
+  // be bound from instead of repacking.
+  prepared_cache::binding prepared_cache = {};
 
   int32_t n_vocab = 0;
   int32_t n_embd = 0;
@@ -253,10 +270,18 @@ struct native_backend {
   float rms_epsilon = 1.0e-5f;
   float rope_freq_base = 10000.0f;
 
-  std::vector<uint16_t> key_cache = {};
-  std::vector<uint16_t> value_cache = {};
-  std::vector<uint16_t> flash_key_cache = {};
-  std::vector<uint16_t> flash_value_cache = {};
+  // KV and packed-weight storage come from huge-page arenas: decode sweeps
+  // all of it every token, so TLB reach dominates once it spans gigabytes.
+  emel::memory::huge_pages::policy huge_page_policy =
+      emel::memory::huge_pages::policy::transparent;
+  emel::memory::numa::placement arena_placement = {};
+  // Per-node copies of the matmul weights under numa::policy::replicate; the
+  // matmul actor resolves each lane's src0 through this table.
+  emel::memory::numa::replica_table weight_replicas = {};
+  emel::memory::huge_pages::vector<uint16_t> key_cache = {};
+  emel::memory::huge_pages::vector<uint16_t> value_cache = {};
+  emel::memory::huge_pages::vector<uint16_t> flash_key_cache = {};
+  emel::memory::huge_pages::vector<uint16_t> flash_value_cache = {};
   std::vector<size_t> layer_cache_offsets = {};
   std::vector<size_t> flash_layer_cache_offsets = {};
   std::vector<float> recurrent_shortconv_cache = {};
@@ -1143,6 +1168,43 @@ inline bool requires_attention_v_norm(const native_backend &backend,
              emel::model::generation_attention_v_norm_route::rms;
 }
 
+inline emel::memory::numa::placement
+select_arena_placement(const emel::memory::numa::policy requested) noexcept {
+  // Replicated weights still share one KV cache across sockets, so both
+  // multi-node policies interleave the arenas.
+  return emel::memory::numa::placement{
+      .mode = requested == emel::memory::numa::policy::first_touch
+                  ? emel::memory::numa::placement::kind::first_touch
+                  : emel::memory::numa::placement::kind::interleave,
+  };
+}
+
+// Re-seeds the arena-backed buffers with the runtime's huge-page policy and
+// NUMA placement before anything sizes them; block packed storage is seeded
+// per matrix.
+inline void bind_huge_page_arenas(
+    native_backend &backend, const emel::memory::huge_pages::policy requested,
+    const emel::memory::numa::placement where) noexcept {
+  using emel::memory::huge_pages::allocator;
+  using emel::memory::huge_pages::vector;
+  backend.huge_page_policy = requested;
+  backend.arena_placement = where;
+  backend.output_packed_storage =
+      vector<uint8_t>(allocator<uint8_t>{requested, where});
+  backend.output_prepared_storage =
+      vector<uint8_t>(allocator<uint8_t>{requested, where});
+  backend.output_argmax_packed_storage =
+      vector<uint8_t>(allocator<uint8_t>{requested, where});
+  backend.output_argmax_prepared_storage =
+      vector<uint8_t>(allocator<uint8_t>{requested, where});
+  backend.key_cache = vector<uint16_t>(allocator<uint16_t>{requested, where});
+  backend.value_cache = vector<uint16_t>(allocator<uint16_t>{requested, where});
+  backend.flash_key_cache =
+      vector<uint16_t>(allocator<uint16_t>{requested, where});
+  backend.flash_value_cache =
+      vector<uint16_t>(allocator<uint16_t>{requested, where});
+}
+
 inline void reset_output_logits(native_backend &backend) noexcept {
   backend.output = backend.output_native;
   backend.output_argmax = backend.output_native;
@@ -1156,11 +1218,33 @@ inline void reset_output_logits(native_backend &backend) noexcept {
   backend.output_argmax_prepared_storage.clear();
 }
 
-template <uint8_t packed_dtype>
+// Binds the bytes for one packed layout: the mapped prepared-weight image on a
+// cache hit, otherwise owned storage filled by `pack`.
+template <class storage_type, class pack_fn>
+inline const uint8_t *
+bind_packed_bytes(prepared_cache::binding *cache, const uint8_t packed_dtype,
+                  const tensor_record &source, const uint64_t bytes,
+                  storage_type &storage, pack_fn &&pack) noexcept {
+  const uint8_t *cached =
+      prepared_cache::claim(cache, packed_dtype, source, bytes);
+  if (cached != nullptr) {
+    storage.clear();
+    prepared_cache::note(cache, packed_dtype, source, cached, bytes);
+    return cached;
+  }
+  storage.resize(static_cast<size_t>(bytes));
+  if (!pack(storage.data())) {
+    return nullptr;
+  }
+  prepared_cache::note(cache, packed_dtype, source, storage.data(), bytes);
+  return storage.data();
+}
+
+template <uint8_t packed_dtype, class storage_type>
 inline bool prepare_packed_q8_0_tensor_layout(
     const tensor_record &source, const int32_t rows, const int32_t cols,
-    tensor_record &packed_tensor,
-    std::vector<uint8_t> &packed_storage) noexcept {
+    tensor_record &packed_tensor, storage_type &packed_storage,
+    prepared_cache::binding *cache = nullptr) noexcept {
   if (source.data == nullptr ||
       static_cast<uint8_t>(source.type) != emel::kernel::detail::dtype_q8_0 ||
       rows <= 0 || cols <= 0) {
@@ -1179,34 +1263,39 @@ inline bool prepare_packed_q8_0_tensor_layout(
     return false;
   }
 
-  packed_storage.resize(static_cast<size_t>(storage_bytes));
   const auto *src =
       reinterpret_cast<const emel::kernel::detail::quant::block_q8_0 *>(
           source.data);
-  bool packed_ok = false;
-  if constexpr (packed_dtype == emel::kernel::detail::dtype_q8_0_x4_bl8) {
-    packed_ok = emel::kernel::detail::quant::pack_q8_0_rows_x4_bl8(
-        src, urows, ucols, packed_storage.data());
-  } else if constexpr (packed_dtype ==
-                       emel::kernel::detail::dtype_q8_0_x4_bl4) {
-    packed_ok = emel::kernel::detail::quant::pack_q8_0_rows_x4_bl4(
-        src, urows, ucols, packed_storage.data());
-  }
-  if (!packed_ok) {
+  const uint8_t *packed_data = bind_packed_bytes(
+      cache, packed_dtype, source, storage_bytes, packed_storage,
+      [src, urows, ucols](uint8_t *dst) noexcept {
+        bool packed_ok = false;
+        if constexpr (packed_dtype ==
+                      emel::kernel::detail::dtype_q8_0_x4_bl8) {
+          packed_ok = emel::kernel::detail::quant::pack_q8_0_rows_x4_bl8(
+              src, urows, ucols, dst);
+        } else if constexpr (packed_dtype ==
+                             emel::kernel::detail::dtype_q8_0_x4_bl4) {
+          packed_ok = emel::kernel::detail::quant::pack_q8_0_rows_x4_bl4(
+              src, urows, ucols, dst);
+        }
+        return packed_ok;
+      });
+  if (packed_data == nullptr) {
     return false;
   }
 
   packed_tensor = source;
   packed_tensor.type = packed_dtype;
-  packed_tensor.data = packed_storage.data();
+  packed_tensor.data = packed_data;
   packed_tensor.data_size = storage_bytes;
   return true;
 }
 
 template <uint8_t packed_dtype>
-inline bool
-prepare_packed_q8_0_matrix_layout(tensor_matrix &matrix,
-                                  packed_matrix_binding &packed) noexcept {
+inline bool prepare_packed_q8_0_matrix_layout(
+    tensor_matrix &matrix, packed_matrix_binding &packed,
+    prepared_cache::binding *cache = nullptr) noexcept {
   if (matrix.tensor == nullptr) {
     return false;
   }
@@ -1216,7 +1305,7 @@ prepare_packed_q8_0_matrix_layout(tensor_matrix &matrix,
   }
   if (!prepare_packed_q8_0_tensor_layout<packed_dtype>(
           *matrix.tensor, matrix.rows, matrix.cols, packed.tensor,
-          packed.storage)) {
+          packed.storage, cache)) {
     return false;
   }
   packed.source = matrix.tensor;
@@ -1224,12 +1313,11 @@ prepare_packed_q8_0_matrix_layout(tensor_matrix &matrix,
   return true;
 }
 
-template <uint8_t packed_dtype>
-inline bool
-prepare_packed_q4_tensor_layout(const tensor_record &source, const int32_t rows,
-                                const int32_t cols,
-                                tensor_record &packed_tensor,
-                                std::vector<uint8_t> &packed_storage) noexcept {
+template <uint8_t packed_dtype, class storage_type>
+inline bool prepare_packed_q4_tensor_layout(
+    const tensor_record &source, const int32_t rows, const int32_t cols,
+    tensor_record &packed_tensor, storage_type &packed_storage,
+    prepared_cache::binding *cache = nullptr) noexcept {
   if (source.data == nullptr ||
       static_cast<uint8_t>(source.type) != emel::kernel::detail::dtype_q4_k ||
       rows <= 0 || cols <= 0) {
@@ -1248,34 +1336,39 @@ prepare_packed_q4_tensor_layout(const tensor_record &source, const int32_t rows,
     return false;
   }
 
-  packed_storage.resize(static_cast<size_t>(storage_bytes));
   const auto *src =
       reinterpret_cast<const emel::kernel::detail::quant::block_q4_k *>(
           source.data);
-  bool packed_ok = false;
-  if constexpr (packed_dtype == emel::kernel::detail::dtype_q4_k_x8_bl8) {
-    packed_ok = emel::kernel::detail::quant::pack_q4_k_rows_x8_bl8(
-        src, urows, ucols, packed_storage.data());
-  } else if constexpr (packed_dtype ==
-                       emel::kernel::detail::dtype_q4_k_x8_bl4) {
-    packed_ok = emel::kernel::detail::quant::pack_q4_k_rows_x8_bl4(
-        src, urows, ucols, packed_storage.data());
-  }
-  if (!packed_ok) {
+  const uint8_t *packed_data = bind_packed_bytes(
+      cache, packed_dtype, source, storage_bytes, packed_storage,
+      [src, urows, ucols](uint8_t *dst) noexcept {
+        bool packed_ok = false;
+        if constexpr (packed_dtype ==
+                      emel::kernel::detail::dtype_q4_k_x8_bl8) {
+          packed_ok = emel::kernel::detail::quant::pack_q4_k_rows_x8_bl8(
+              src, urows, ucols, dst);
+        } else if constexpr (packed_dtype ==
+                             emel::kernel::detail::dtype_q4_k_x8_bl4) {
+          packed_ok = emel::kernel::detail::quant::pack_q4_k_rows_x8_bl4(
+              src, urows, ucols, dst);
+        }
+        return packed_ok;
+      });
+  if (packed_data == nullptr) {
     return false;
   }
 
   packed_tensor = source;
   packed_tensor.type = packed_dtype;
-  packed_tensor.data = packed_storage.data();
+  packed_tensor.data = packed_data;
   packed_tensor.data_size = storage_bytes;
   return true;
 }
 
 template <uint8_t packed_dtype>
-inline bool
-prepare_packed_q4_matrix_layout(tensor_matrix &matrix,
-                                packed_matrix_binding &packed) noexcept {
+inline bool prepare_packed_q4_matrix_layout(
+    tensor_matrix &matrix, packed_matrix_binding &packed,
+    prepared_cache::binding *cache = nullptr) noexcept {
   if (matrix.tensor == nullptr) {
     return false;
   }
@@ -1285,7 +1378,7 @@ prepare_packed_q4_matrix_layout(tensor_matrix &matrix,
   }
   if (!prepare_packed_q4_tensor_layout<packed_dtype>(
           *matrix.tensor, matrix.rows, matrix.cols, packed.tensor,
-          packed.storage)) {
+          packed.storage, cache)) {
     return false;
   }
   packed.source = matrix.tensor;
@@ -1293,12 +1386,11 @@ prepare_packed_q4_matrix_layout(tensor_matrix &matrix,
   return true;
 }
 
-template <uint8_t packed_dtype>
-inline bool
-prepare_packed_q6_tensor_layout(const tensor_record &source, const int32_t rows,
-                                const int32_t cols,
-                                tensor_record &packed_tensor,
-                                std::vector<uint8_t> &packed_storage) noexcept {
+template <uint8_t packed_dtype, class storage_type>
+inline bool prepare_packed_q6_tensor_layout(
+    const tensor_record &source, const int32_t rows, const int32_t cols,
+    tensor_record &packed_tensor, storage_type &packed_storage,
+    prepared_cache::binding *cache = nullptr) noexcept {
   if (source.data == nullptr ||
       static_cast<uint8_t>(source.type) != emel::kernel::detail::dtype_q6_k ||
       rows <= 0 || cols <= 0) {
@@ -1321,34 +1413,40 @@ prepare_packed_q6_tensor_layout(const tensor_record &source, const int32_t rows,
     return false;
   }
 
-  packed_storage.resize(static_cast<size_t>(storage_bytes));
   const auto *src =
       reinterpret_cast<const emel::kernel::detail::quant::block_q6_k *>(
           source.data);
-  bool packed_ok = false;
-  if constexpr (packed_dtype ==
-                emel::kernel::detail::dtype_q6_k_x8_q8_prepared) {
-    packed_ok = emel::kernel::detail::quant::pack_q6_k_rows_x8_q8_prepared(
-        src, urows, ucols, packed_storage.data());
-  } else if constexpr (packed_dtype == emel::kernel::detail::dtype_q6_k_x8) {
-    packed_ok = emel::kernel::detail::quant::pack_q6_k_rows_x8(
-        src, urows, ucols, packed_storage.data());
-  }
-  if (!packed_ok) {
+  const uint8_t *packed_data = bind_packed_bytes(
+      cache, packed_dtype, source, storage_bytes, packed_storage,
+      [src, urows, ucols](uint8_t *dst) noexcept {
+        bool packed_ok = false;
+        if constexpr (packed_dtype ==
+                      emel::kernel::detail::dtype_q6_k_x8_q8_prepared) {
+          packed_ok =
+              emel::kernel::detail::quant::pack_q6_k_rows_x8_q8_prepared(
+                  src, urows, ucols, dst);
+        } else if constexpr (packed_dtype ==
+                             emel::kernel::detail::dtype_q6_k_x8) {
+          packed_ok = emel::kernel::detail::quant::pack_q6_k_rows_x8(
+              src, urows, ucols, dst);
+        }
+        return packed_ok;
+      });
+  if (packed_data == nullptr) {
     return false;
   }
 
   packed_tensor = source;
   packed_tensor.type = packed_dtype;
-  packed_tensor.data = packed_storage.data();
+  packed_tensor.data = packed_data;
   packed_tensor.data_size = storage_bytes;
   return true;
 }
 
 template <uint8_t packed_dtype>
-inline bool
-prepare_packed_q6_matrix_layout(tensor_matrix &matrix,
-                                packed_matrix_binding &packed) noexcept {
+inline bool prepare_packed_q6_matrix_layout(
+    tensor_matrix &matrix, packed_matrix_binding &packed,
+    prepared_cache::binding *cache = nullptr) noexcept {
   if (matrix.tensor == nullptr) {
     return false;
   }
@@ -1358,7 +1456,7 @@ prepare_packed_q6_matrix_layout(tensor_matrix &matrix,
   }
   if (!prepare_packed_q6_tensor_layout<packed_dtype>(
           *matrix.tensor, matrix.rows, matrix.cols, packed.tensor,
-          packed.storage)) {
+          packed.storage, cache)) {
     return false;
   }
   packed.source = matrix.tensor;
@@ -1369,7 +1467,9 @@ prepare_packed_q6_matrix_layout(tensor_matrix &matrix,
 inline bool
 prepare_native_matrix_layout(native_backend &backend, tensor_matrix &matrix,
                              packed_matrix_binding &packed) noexcept {
-  (void)packed;
+  packed.storage = emel::memory::huge_pages::vector<uint8_t>(
+      emel::memory::huge_pages::allocator<uint8_t>{backend.huge_page_policy,
+                                                   backend.arena_placement});
   if (matrix.tensor == nullptr) {
     return false;
   }
@@ -1382,11 +1482,13 @@ prepare_native_matrix_layout(native_backend &backend, tensor_matrix &matrix,
 #if defined(__aarch64__) && defined(__ARM_NEON) &&                             \
     defined(__ARM_FEATURE_MATMUL_INT8)
     return prepare_packed_q4_matrix_layout<
-        emel::kernel::detail::dtype_q4_k_x8_bl8>(matrix, packed);
+        emel::kernel::detail::dtype_q4_k_x8_bl8>(
+            matrix, packed, &backend.prepared_cache);
 #elif defined(__aarch64__) && defined(__ARM_NEON) &&                           \
     defined(__ARM_FEATURE_DOTPROD)
     return prepare_packed_q4_matrix_layout<
-        emel::kernel::detail::dtype_q4_k_x8_bl4>(matrix, packed);
+        emel::kernel::detail::dtype_q4_k_x8_bl4>(
+            matrix, packed, &backend.prepared_cache);
 #else
     return true;
 #endif
@@ -1399,11 +1501,12 @@ prepare_native_matrix_layout(native_backend &backend, tensor_matrix &matrix,
 #if defined(__aarch64__) && defined(__ARM_NEON) &&                             \
     defined(__ARM_FEATURE_MATMUL_INT8)
     return prepare_packed_q6_matrix_layout<
-        emel::kernel::detail::dtype_q6_k_x8_q8_prepared>(matrix, packed);
+        emel::kernel::detail::dtype_q6_k_x8_q8_prepared>(
+            matrix, packed, &backend.prepared_cache);
 #elif defined(__aarch64__) && defined(__ARM_NEON) &&                           \
     defined(__ARM_FEATURE_DOTPROD)
     return prepare_packed_q6_matrix_layout<emel::kernel::detail::dtype_q6_k_x8>(
-        matrix, packed);
+        matrix, packed, &backend.prepared_cache);
 #else
     return true;
 #endif
@@ -1416,11 +1519,13 @@ prepare_native_matrix_layout(native_backend &backend, tensor_matrix &matrix,
 #if defined(__aarch64__) && defined(__ARM_NEON) &&                             \
     defined(__ARM_FEATURE_MATMUL_INT8)
   return prepare_packed_q8_0_matrix_layout<
-      emel::kernel::detail::dtype_q8_0_x4_bl8>(matrix, packed);
+      emel::kernel::detail::dtype_q8_0_x4_bl8>(
+          matrix, packed, &backend.prepared_cache);
 #elif defined(__aarch64__) && defined(__ARM_NEON) &&                           \
     defined(__ARM_FEATURE_DOTPROD)
   return prepare_packed_q8_0_matrix_layout<
-      emel::kernel::detail::dtype_q8_0_x4_bl4>(matrix, packed);
+      emel::kernel::detail::dtype_q8_0_x4_bl4>(
+          matrix, packed, &backend.prepared_cache);
 #else
   (void)backend;
   return true;
@@ -1437,7 +1542,8 @@ prepare_packed_q8_0_output_logits_layout(native_backend &backend) noexcept {
 
   if (!prepare_packed_q8_0_tensor_layout<packed_dtype>(
           *tensor, backend.output_native.rows, backend.output_native.cols,
-          backend.output_packed_tensor, backend.output_packed_storage)) {
+          backend.output_packed_tensor, backend.output_packed_storage,
+          &backend.prepared_cache)) {
     return false;
   }
 
@@ -1487,32 +1593,45 @@ inline bool prepare_prepared_output_logits(native_backend &backend) noexcept {
     return false;
   }
 
-  backend.output_prepared_storage.resize(
-      static_cast<size_t>(prepared_storage_bytes));
-  backend.output_argmax_prepared_storage.resize(
-      static_cast<size_t>(argmax_prepared_storage_bytes));
   const auto *src =
       reinterpret_cast<const emel::kernel::detail::quant::block_q6_k *>(
           tensor->data);
-  if (!emel::kernel::detail::quant::pack_q6_k_rows_x8_q8_prepared(
-          src, rows, cols, backend.output_prepared_storage.data()) ||
-      !emel::kernel::detail::quant::pack_q6_k_rows_x8_q8_argmax_prepared(
-          src, rows, cols, backend.output_argmax_prepared_storage.data())) {
+  const uint8_t *prepared_data = bind_packed_bytes(
+      &backend.prepared_cache,
+      emel::kernel::detail::dtype_q6_k_x8_q8_prepared, *tensor,
+      prepared_storage_bytes, backend.output_prepared_storage,
+      [src, rows, cols](uint8_t *dst) noexcept {
+        return emel::kernel::detail::quant::pack_q6_k_rows_x8_q8_prepared(
+            src, rows, cols, dst);
+      });
+  const uint8_t *argmax_prepared_data =
+      prepared_data == nullptr
+          ? nullptr
+          : bind_packed_bytes(
+                &backend.prepared_cache,
+                emel::kernel::detail::dtype_q6_k_x8_q8_argmax_prepared,
+                *tensor, argmax_prepared_storage_bytes,
+                backend.output_argmax_prepared_storage,
+                [src, rows, cols](uint8_t *dst) noexcept {
+                  return emel::kernel::detail::quant::
+                      pack_q6_k_rows_x8_q8_argmax_prepared(src, rows, cols,
+                                                           dst);
+                });
+  if (argmax_prepared_data == nullptr) {
     return false;
   }
 
   backend.output_prepared_tensor = *tensor;
   backend.output_prepared_tensor.type =
       emel::kernel::detail::dtype_q6_k_x8_q8_prepared;
-  backend.output_prepared_tensor.data = backend.output_prepared_storage.data();
+  backend.output_prepared_tensor.data = prepared_data;
   backend.output_prepared_tensor.data_size = prepared_storage_bytes;
   backend.output.tensor = &backend.output_prepared_tensor;
 
   backend.output_argmax_prepared_tensor = *tensor;
   backend.output_argmax_prepared_tensor.type =
       emel::kernel::detail::dtype_q6_k_x8_q8_argmax_prepared;
-  backend.output_argmax_prepared_tensor.data =
-      backend.output_argmax_prepared_storage.data();
+  backend.output_argmax_prepared_tensor.data = argmax_prepared_data;
   backend.output_argmax_prepared_tensor.data_size =
       argmax_prepared_storage_bytes;
   backend.output_argmax.tensor = &backend.output_argmax_prepared_tensor;
@@ -1537,18 +1656,23 @@ inline bool prepare_packed_output_logits(native_backend &backend) noexcept {
     return false;
   }
 
-  backend.output_packed_storage.resize(
-      static_cast<size_t>(packed_storage_bytes));
-  if (!emel::kernel::detail::quant::pack_q6_k_rows_x8(
-          reinterpret_cast<const emel::kernel::detail::quant::block_q6_k *>(
-              tensor->data),
-          rows, cols, backend.output_packed_storage.data())) {
+  const auto *src =
+      reinterpret_cast<const emel::kernel::detail::quant::block_q6_k *>(
+          tensor->data);
+  const uint8_t *packed_data = bind_packed_bytes(
+      &backend.prepared_cache, emel::kernel::detail::dtype_q6_k_x8, *tensor,
+      packed_storage_bytes, backend.output_packed_storage,
+      [src, rows, cols](uint8_t *dst) noexcept {
+        return emel::kernel::detail::quant::pack_q6_k_rows_x8(src, rows, cols,
+                                                              dst);
+      });
+  if (packed_data == nullptr) {
     return false;
   }
 
   backend.output_packed_tensor = *tensor;
   backend.output_packed_tensor.type = emel::kernel::detail::dtype_q6_k_x8;
-  backend.output_packed_tensor.data = backend.output_packed_storage.data();
+  backend.output_packed_tensor.data = packed_data;
   backend.output_packed_tensor.data_size = packed_storage_bytes;
   backend.output.tensor = &backend.output_packed_tensor;
   backend.output_argmax_packed_tensor = backend.output_packed_tensor;
@@ -1614,6 +1738,93 @@ inline bool prepare_block_native_matrices(native_backend &backend) noexcept {
   return true;
 }
 
+// Bytes the output-stage repack materialized (packed and prepared layouts).
+inline uint64_t output_packed_bytes(const native_backend &backend) noexcept {
+  return backend.output_packed_storage.size() +
+         backend.output_prepared_storage.size() +
+         backend.output_argmax_packed_storage.size() +
+         backend.output_argmax_prepared_storage.size();
+}
+
+inline uint64_t block_packed_bytes(const native_backend &backend) noexcept {
+  uint64_t bytes = 0u;
+  for (const auto &block : backend.blocks) {
+    bytes += block.attention_q_packed.storage.size() +
+             block.attention_k_packed.storage.size() +
+             block.attention_v_packed.storage.size() +
+             block.attention_output_packed.storage.size() +
+             block.shortconv_in_proj_packed.storage.size() +
+             block.shortconv_out_proj_packed.storage.size() +
+             block.feed_forward_gate_packed.storage.size() +
+             block.feed_forward_down_packed.storage.size() +
+             block.feed_forward_up_packed.storage.size();
+  }
+  return bytes;
+}
+
+inline void
+replicate_record(native_backend &backend,
+                 const emel::model::data::tensor_record *record) noexcept {
+  if (record == nullptr) {
+    return;
+  }
+  // Tied or shared records alias an already registered span; add() rejects
+  // the overlap, and a budget miss just leaves the matrix on first touch.
+  (void)backend.weight_replicas.add(record->data, record->data_size);
+}
+
+inline void replicate_matrix(native_backend &backend,
+                             const tensor_matrix &matrix) noexcept {
+  replicate_record(backend, matrix.tensor);
+}
+
+// Resident decode: the output projection is the largest single matrix every
+// token reads, then layers in execution order.
+inline void replicate_resident_decode_weights(native_backend &backend) noexcept {
+  replicate_matrix(backend, backend.output);
+  replicate_matrix(backend, backend.output_argmax);
+  for (const auto &block : backend.blocks) {
+    replicate_matrix(backend, block.attention_q);
+    replicate_matrix(backend, block.attention_k);
+    replicate_matrix(backend, block.attention_v);
+    replicate_matrix(backend, block.attention_output);
+    replicate_matrix(backend, block.shortconv_in_proj);
+    replicate_matrix(backend, block.shortconv_out_proj);
+    replicate_matrix(backend, block.feed_forward_gate);
+    replicate_matrix(backend, block.feed_forward_down);
+    replicate_matrix(backend, block.feed_forward_up);
+  }
+}
+
+// Streamed decode reads layer weights from window slots, so copying their
+// mapped bytes would only fault the whole file in; the output stage runs on
+// the raw output records (scan_stream_pristine_records).
+inline void replicate_streamed_decode_weights(native_backend &backend) noexcept {
+  replicate_record(backend, backend.stream.raw_output);
+  replicate_record(backend, backend.stream.raw_output_argmax);
+}
+
+// Replica budget for the policy: only numa::policy::replicate copies weights.
+inline uint64_t replica_budget_bytes(const runtime_policy &policy) noexcept {
+  return policy.numa == emel::memory::numa::policy::replicate
+             ? policy.numa_replica_budget_bytes
+             : 0u;
+}
+
+// Decode weight replicas are rebuilt once the packed layouts are final (lanes
+// read the packed bytes) and the stream binding is attached; the initializer
+// routes to the resident or streamed set between these two calls.
+inline void begin_weight_replicas(native_backend &backend,
+                                  const uint64_t budget_bytes) noexcept {
+  backend.weight_replicas.reset(budget_bytes);
+}
+
+inline void publish_weight_replicas(native_backend &backend) noexcept {
+  backend.matmul_actor->process_event(
+      emel::kernel::matmul::event::configure_weight_replicas{
+          &backend.weight_replicas});
+}
+
 inline bool update_q8_input_requirement(const tensor_matrix &matrix,
                                         size_t &max_block_count) noexcept {
   if (!q8_input_workspace_candidate(matrix)) {
@@ -2227,6 +2438,8 @@ template <matmul_lane_mode lanes = matmul_lane_mode::serial>
 inline bool
 compute_mul_mat(native_backend &backend,
                 const emel::kernel::event::op_mul_mat &ev) noexcept {
+  emel::kernel::roofline::accumulate(backend.roofline,
+                                     emel::kernel::roofline::op_cost(ev));
   if constexpr (lanes == matmul_lane_mode::parallel) {
     return compute_mul_mat_sliced_parallel(backend, ev);
   } else {
@@ -2333,6 +2546,16 @@ inline bool matmul_vector_routed(native_backend &backend,
   }
 }
 
+// Direct (non-matmul-actor) kernel dispatch.
+template <class event_type>
+inline bool dispatch_kernel_op(native_backend &backend,
+                               const event_type &ev) noexcept {
+  emel::kernel::roofline::accumulate(backend.roofline,
+                                     emel::kernel::roofline::op_cost(ev));
+  backend.kernel.set_kind(backend.kernel_kind);
+  return backend.kernel.process_event(ev);
+}
+
 inline bool matmul_vector_argmax(native_backend &backend,
                                  const tensor_matrix &matrix,
                                  std::span<const float> input,
@@ -2352,8 +2575,7 @@ inline bool matmul_vector_argmax(native_backend &backend,
                            static_cast<uint64_t>(1u)),
       .index_out = &selected_index,
   };
-  backend.kernel.set_kind(backend.kernel_kind);
-  const bool ok = backend.kernel.process_event(ev);
+  const bool ok = dispatch_kernel_op(backend, ev);
   backend.kernel_dispatch_calls += 1;
   backend.native_q8_0_dispatch_calls += static_cast<uint64_t>(
       matrix.tensor != nullptr && static_cast<uint8_t>(matrix.tensor->type) ==
@@ -2726,8 +2948,7 @@ inline bool matmul_vector_q8_input_argmax(
                            static_cast<uint64_t>(1u)),
       .index_out = &selected_index,
   };
-  backend.kernel.set_kind(backend.kernel_kind);
-  const bool ok = backend.kernel.process_event(ev);
+  const bool ok = dispatch_kernel_op(backend, ev);
   backend.kernel_dispatch_calls += 1;
   return ok;
 }
@@ -3284,6 +3505,8 @@ inline bool dispatch_flash_attention(native_backend &backend,
                                      const int32_t position) noexcept {
   const auto request =
       make_flash_attn_request(backend, block, layer_index, position);
+  emel::kernel::roofline::accumulate(backend.roofline,
+                                     emel::kernel::roofline::op_cost(request));
   backend.kernel.set_kind(backend.kernel_kind);
   const bool ok = backend.kernel.process_event(request);
   ++backend.kernel_dispatch_calls;
@@ -3728,7 +3951,10 @@ inline bool acquire_streamed_layer(native_backend &backend,
   emel::model::tensor::window::event::acquire_layer_window acquire{layer_index};
   acquire.on_done = {&capture, &stream_acquire_capture::on_done};
   acquire.on_error = {&capture, &stream_acquire_capture::on_error};
-  if (!backend.stream.window->process_event(acquire) || !capture.done) {
+  const uint64_t started_ns = latency::now(backend.latency);
+  const bool acquired = backend.stream.window->process_event(acquire);
+  latency::record(backend.latency, latency::metric::window_stall, started_ns);
+  if (!acquired || !capture.done) {
     return false;
   }
   return bind_streamed_block_views(backend, layer_index, capture.slot_base,
@@ -3758,6 +3984,9 @@ inline bool compute_layer_attention_residual(native_backend &backend,
   auto v = std::span<float>(backend.v.data(), static_cast<size_t>(kv_dim));
   auto attn_ctx = std::span<const float>(backend.attn_ctx.data(),
                                          static_cast<size_t>(q_dim));
+  const emel::kernel::profile::scope profile_stage{
+      backend.kernel_profile, layer_index,
+      emel::kernel::profile::stage::attention_projection};
   if constexpr (route == scalar_matmul_route::packed_q8_0) {
     if (!prepare_packed_q8_0_input(backend, backend.norm) ||
         !matmul_vector_prepared_packed_q8_0_input<lanes>(
@@ -3823,10 +4052,17 @@ inline bool compute_layer_attention_residual(native_backend &backend,
                        effective_attention_head_dim_kv(backend, block),
                        effective_attention_rope_dim(backend, block), position,
                        effective_attention_rope_freq_base(backend, block));
+  emel::kernel::profile::attribute(backend.kernel_profile, layer_index,
+                                   emel::kernel::profile::stage::attention);
   if (!store_attention_kv_cache(backend, kv, block, layer_index, position, k,
                                 v) ||
-      !run_attention<mode>(backend, kv, block, layer_index, position) ||
-      !matmul_vector_routed<route, lanes>(backend, block.attention_output,
+      !run_attention<mode>(backend, kv, block, layer_index, position)) {
+    return false;
+  }
+  emel::kernel::profile::attribute(
+      backend.kernel_profile, layer_index,
+      emel::kernel::profile::stage::attention_output);
+  if (!matmul_vector_routed<route, lanes>(backend, block.attention_output,
                                           attn_ctx, backend.projected)) {
     return false;
   }
@@ -3846,6 +4082,9 @@ compute_layer_shortconv_residual(native_backend &backend,
                                  const int32_t layer_index,
                                  const kv_addressing_view &kv) noexcept {
   auto &block = backend.blocks[static_cast<size_t>(layer_index)];
+  const emel::kernel::profile::scope profile_stage{
+      backend.kernel_profile, layer_index,
+      emel::kernel::profile::stage::attention};
   return run_shortconv_block<route, lanes>(backend, kv, block, layer_index);
 }
 
@@ -3854,6 +4093,9 @@ template <scalar_matmul_route route,
 inline bool compute_layer_feed_forward(native_backend &backend,
                                        const int32_t layer_index) noexcept {
   auto &block = backend.blocks[static_cast<size_t>(layer_index)];
+  const emel::kernel::profile::scope profile_stage{
+      backend.kernel_profile, layer_index,
+      emel::kernel::profile::stage::feed_forward};
   if (!rms_norm(backend.hidden, block.feed_forward_norm, backend.rms_epsilon,
                 backend.norm)) {
     return false;
@@ -3997,6 +4239,8 @@ namespace emel::text::generator::detail {
 template <scalar_matmul_route route,
           matmul_lane_mode lanes = matmul_lane_mode::serial>
 inline bool compute_logits(native_backend &backend) noexcept {
+  const emel::kernel::profile::scope profile_stage{
+      backend.kernel_profile, -1, emel::kernel::profile::stage::logits};
   if (!rms_norm(backend.hidden, backend.output_norm, backend.rms_epsilon,
                 backend.norm)) {
     return false;
@@ -4036,6 +4280,8 @@ template <scalar_argmax_route route>
 inline bool compute_logits_preselected_argmax(native_backend &backend,
                                               int32_t &selected_index,
                                               float &selected_score) noexcept {
+  const emel::kernel::profile::scope profile_stage{
+      backend.kernel_profile, -1, emel::kernel::profile::stage::logits};
   if (!rms_norm(backend.hidden, backend.output_norm, backend.rms_epsilon,
                 backend.norm)) {
     return false;
@@ -5005,7 +5251,9 @@ inline emel::error::type prepare(
     emel::kernel::matmul::sm &matmul_actor, const runtime_policy &policy,
     const int32_t kv_block_tokens = emel::memory::view::DEFAULT_BLOCK_TOKENS,
     const emel::kernel::matmul::lane_mode matmul_lane_mode =
-        emel::kernel::matmul::lane_mode::parallel) noexcept {
+        emel::kernel::matmul::lane_mode::parallel,
+    const std::span<const uint8_t> prepared_weights = {},
+    emel::model::load_profile::recorder *const profile = nullptr) noexcept {
   if (emel::model::generation::validate_contract(generation_contract) !=
           emel::error::cast(emel::model::loader::error::none) ||
       kv_block_tokens <= 0) {
@@ -5018,9 +5266,20 @@ inline emel::error::type prepare(
   backend.matmul_lane_mode = matmul_lane_mode;
   backend.routes = policy.routes;
   backend.kernel_kind = policy.kernel_kind;
+  bind_huge_page_arenas(backend, policy.huge_pages,
+                        select_arena_placement(policy.numa));
   backend.kernel.set_kind(backend.kernel_kind);
   backend.matmul_actor->process_event(
       emel::kernel::matmul::event::configure_kernel_kind{backend.kernel_kind});
+  backend.kernel_profile = policy.kernel_profile;
+  backend.latency = policy.latency;
+  backend.kernel.process_event(
+      emel::kernel::event::configure_profile{policy.kernel_profile});
+  backend.matmul_actor->process_event(
+      emel::kernel::matmul::event::configure_profile{policy.kernel_profile});
+  // The previous backend's replicas died with it above.
+  backend.matmul_actor->process_event(
+      emel::kernel::matmul::event::configure_weight_replicas{});
 
   const auto &model_data = *generation_contract.execution.model;
   backend.execution = generation_contract.execution;
@@ -5034,6 +5293,12 @@ inline emel::error::type prepare(
   backend.prefill_plan.graph = &backend.topology;
   backend.decode_plan.graph = &backend.topology;
   backend.model = &model_data;
+  prepared_cache::open(
+      backend.prepared_cache, prepared_weights,
+      prepared_cache::key{
+          .model_fingerprint = prepared_cache::model_fingerprint(model_data),
+          .kernel_kind = static_cast<uint32_t>(backend.kernel_kind),
+      });
   backend.n_vocab = model_data.params.n_vocab;
   backend.n_embd = model_data.params.n_embd;
   backend.n_head = model_data.params.n_head;
@@ -5064,6 +5329,7 @@ inline emel::error::type prepare(
   if (backend.kv_positions_capacity < backend.n_ctx) {
     return emel::error::cast(emel::model::loader::error::model_invalid);
   }
+  const uint64_t output_started = emel::model::load_profile::start(profile);
   if (!bind_tensor_rows(*backend.execution.token_embedding.tensor,
                         backend.token_embedding) ||
       !dequantize_tensor_vector(*backend.execution.output_norm.tensor,
@@ -5071,6 +5337,9 @@ inline emel::error::type prepare(
       !bind_output_projection(backend) || !prepare_output_logits(backend)) {
     return emel::error::cast(emel::model::loader::error::model_invalid);
   }
+  emel::model::load_profile::stop(
+      profile, emel::model::load_profile::phase::weight_repack, output_started,
+      output_packed_bytes(backend));
 
   if (backend.token_embedding.cols != backend.n_embd ||
       backend.token_embedding.rows < backend.n_vocab ||
@@ -5169,6 +5438,7 @@ inline emel::error::type prepare(
                 weights.shortconv_conv.size() * sizeof(float));
   }
 
+  const uint64_t blocks_started = emel::model::load_profile::start(profile);
   if (!prepare_block_native_matrices(backend) ||
       !prepare_q8_input_workspace(backend) ||
       !prepare_q8_input_chunk4_workspace(backend) ||
@@ -5177,6 +5447,9 @@ inline emel::error::type prepare(
       !prepare_packed_q8_0_chunk4_input_workspace(backend)) {
     return emel::error::cast(emel::model::loader::error::model_invalid);
   }
+  emel::model::load_profile::stop(
+      profile, emel::model::load_profile::phase::weight_repack, blocks_started,
+      block_packed_bytes(backend));
 
   const block_weights *attention_block = first_attention_block(backend);
   if (attention_block == nullptr) {
@@ -5287,10 +5560,15 @@ inline emel::error::type prepare(
     return emel::error::cast(emel::model::loader::error::model_invalid);
   }
 
+  // Resizing zero-fills, so this is where the KV arenas fault in.
+  const uint64_t kv_started = emel::model::load_profile::start(profile);
   backend.key_cache.resize(cache_offset);
   backend.value_cache.resize(cache_offset);
   backend.flash_key_cache.resize(flash_cache_offset);
   backend.flash_value_cache.resize(flash_cache_offset);
+  emel::model::load_profile::stop(
+      profile, emel::model::load_profile::phase::kv_allocate, kv_started,
+      (2u * cache_offset + 2u * flash_cache_offset) * sizeof(uint16_t));
   backend.recurrent_shortconv_cache.resize(
       static_cast<size_t>(backend.n_layer) *
       static_cast<size_t>(backend.shortconv_state_size) *
@@ -5359,6 +5637,87 @@ inline emel::error::type prepare(
   return emel::error::cast(emel::model::loader::error::none);
 }
 
+inline void
+capture_prepared_weights(const native_backend &backend,
+                         prepared_weights_snapshot &out) noexcept {
+  const auto &cache = backend.prepared_cache;
+  out.layout_count = static_cast<uint32_t>(cache.records.size());
+  out.cache_hits = cache.hits;
+  out.cache_misses = cache.misses;
+  out.image_bytes =
+      cache.records.empty() ? 0u : prepared_cache::image_bytes(cache);
+  out.written = prepared_cache::write_image(cache, out.image);
+}
+
+// Everything prepare() allocated, by holder. Norm vectors are f32 copies of
+// model tensors and count as prepared weights; the lifecycle manifests and
+// plan tables are a few KiB and are left out.
+inline void
+capture_memory_footprint(const native_backend &backend,
+                         emel::memory::footprint::report &out) noexcept {
+  using emel::memory::footprint::bytes_of;
+  uint64_t prepared = bytes_of(backend.output_norm) +
+                      bytes_of(backend.output_packed_storage) +
+                      bytes_of(backend.output_prepared_storage) +
+                      bytes_of(backend.output_argmax_packed_storage) +
+                      bytes_of(backend.output_argmax_prepared_storage) +
+                      backend.weight_replicas.replicated_bytes();
+  for (const block_weights &block : backend.blocks) {
+    prepared += bytes_of(block.attention_norm) +
+                bytes_of(block.attention_q_packed.storage) +
+                bytes_of(block.attention_k_packed.storage) +
+                bytes_of(block.attention_v_packed.storage) +
+                bytes_of(block.attention_q_norm) +
+                bytes_of(block.attention_k_norm) +
+                bytes_of(block.attention_output_packed.storage) +
+                bytes_of(block.shortconv_conv) +
+                bytes_of(block.shortconv_in_proj_packed.storage) +
+                bytes_of(block.shortconv_out_proj_packed.storage) +
+                bytes_of(block.feed_forward_norm) +
+                bytes_of(block.feed_forward_gate_packed.storage) +
+                bytes_of(block.feed_forward_down_packed.storage) +
+                bytes_of(block.feed_forward_up_packed.storage);
+  }
+  out.prepared_weight_bytes += prepared;
+  out.kv_cache_bytes += bytes_of(backend.key_cache) +
+                        bytes_of(backend.value_cache) +
+                        bytes_of(backend.flash_key_cache) +
+                        bytes_of(backend.flash_value_cache);
+  out.recurrent_state_bytes += bytes_of(backend.recurrent_shortconv_cache);
+  out.scratch_bytes +=
+      bytes_of(backend.q8_input_storage) +
+      bytes_of(backend.q8_input_chunk4_storage) +
+      bytes_of(backend.q8_input_chunk8_storage) +
+      bytes_of(backend.packed_q8_0_input_storage) +
+      bytes_of(backend.packed_q8_0_chunk4_rows) +
+      bytes_of(backend.packed_q8_0_chunk4_input_storage) +
+      bytes_of(backend.bound_tokens) + bytes_of(backend.bound_positions) +
+      bytes_of(backend.bound_logits) + bytes_of(backend.hidden) +
+      bytes_of(backend.hidden_chunk4) + bytes_of(backend.hidden_chunk8) +
+      bytes_of(backend.norm) + bytes_of(backend.norm_chunk4) +
+      bytes_of(backend.norm_chunk8) + bytes_of(backend.shortconv_bcx) +
+      bytes_of(backend.shortconv_bx) + bytes_of(backend.shortconv_conv_out) +
+      bytes_of(backend.shortconv_bcx_chunk4) +
+      bytes_of(backend.shortconv_conv_out_chunk4) +
+      bytes_of(backend.shortconv_bcx_chunk8) +
+      bytes_of(backend.shortconv_conv_out_chunk8) + bytes_of(backend.q) +
+      bytes_of(backend.q_attn) + bytes_of(backend.q_chunk4) +
+      bytes_of(backend.q_chunk8) + bytes_of(backend.k) +
+      bytes_of(backend.k_chunk4) + bytes_of(backend.k_chunk8) +
+      bytes_of(backend.v) + bytes_of(backend.v_chunk4) +
+      bytes_of(backend.v_chunk8) + bytes_of(backend.attn_scores) +
+      bytes_of(backend.attn_probs) + bytes_of(backend.attn_probs_rounded) +
+      bytes_of(backend.attn_value_column) + bytes_of(backend.attn_ctx) +
+      bytes_of(backend.attn_ctx_chunk4) + bytes_of(backend.attn_ctx_chunk8) +
+      bytes_of(backend.projected) + bytes_of(backend.projected_chunk4) +
+      bytes_of(backend.projected_chunk8) + bytes_of(backend.gate) +
+      bytes_of(backend.gate_chunk4) + bytes_of(backend.gate_chunk8) +
+      bytes_of(backend.up) + bytes_of(backend.up_chunk4) +
+      bytes_of(backend.up_chunk8) + bytes_of(backend.ffn_hidden) +
+      bytes_of(backend.ffn_hidden_chunk4) +
+      bytes_of(backend.ffn_hidden_chunk8);
+}
+
 inline uint32_t quantized_contract_stage_count(
     const native_backend &backend,
     const emel::model::generation::quantized_contract_kind kind) noexcept {
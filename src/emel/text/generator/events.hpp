@@ -9,11 +9,17 @@
 #include "emel/callback.hpp"
 #include "emel/error/error.hpp"
 #include "emel/kernel/any.hpp"
+#include "emel/kernel/profile.hpp"
+#include "emel/memory/footprint.hpp"
+#include "emel/memory/huge_pages.hpp"
+#include "emel/memory/numa.hpp"
 #include "emel/text/generator/errors.hpp"
+#include "emel/text/generator/latency.hpp"
 #include "emel/graph/events.hpp"
 #include "emel/graph/tensor/events.hpp"
 #include "emel/logits/sampler/events.hpp"
 #include "emel/model/data.hpp"
+#include "emel/model/load_profile.hpp"
 #include "emel/text/conditioner/errors.hpp"
 #include "emel/text/formatter/format.hpp"
 #include "emel/text/renderer/events.hpp"
@@ -55,6 +61,24 @@ struct route_policy {
 struct runtime_policy {
   emel::kernel::kernel_kind kernel_kind = emel::kernel::kernel_kind::x86_64;
   route_policy routes = {};
+  // Backing for KV caches and packed weights; falls back toward base pages
+  // when the requested huge pages are unavailable.
+  emel::memory::huge_pages::policy huge_pages =
+      emel::memory::huge_pages::policy::transparent;
+  // Multi-socket placement: interleave spreads the KV and packed-weight
+  // arenas over the allowed nodes; replicate additionally copies the matmul
+  // weights onto every node, output projection first and then layers in
+  // order, until numa_replica_budget_bytes (0 replicates nothing) runs out.
+  // Layers streamed through a tensor window are never replicated.
+  emel::memory::numa::policy numa = emel::memory::numa::policy::first_touch;
+  uint64_t numa_replica_budget_bytes =
+      emel::memory::numa::k_unlimited_replica_budget;
+  // Opt-in per-dispatch hardware counters (kernel::profile); the owner keeps
+  // the recorder alive for the generator's lifetime.
+  emel::kernel::profile::recorder *kernel_profile = nullptr;
+  // Opt-in request latency histograms (generator::latency), reported by
+  // capture_diagnostics; the owner keeps the recorder alive likewise.
+  emel::text::generator::latency::recorder *latency = nullptr;
 };
 
 inline constexpr int32_t k_prefill_q8_chunk_rows = 4;
@@ -112,6 +136,10 @@ struct diagnostics {
   uint64_t native_q8_0_dispatch_calls = 0u;
   uint64_t packed_q8_0_dispatch_calls = 0u;
   uint64_t flash_attention_dispatch_calls = 0u;
+  // Static cost of the dispatched ops (kernel::roofline); divide deltas by
+  // the step's wall time for achieved GFLOP/s and GB/s.
+  uint64_t roofline_flops = 0u;
+  uint64_t roofline_bytes = 0u;
   uint64_t optimized_flash_dispatch_calls = 0u;
   uint64_t shared_flash_dispatch_calls = 0u;
   uint64_t optimized_q2_dispatch_calls = 0u;
@@ -138,6 +166,8 @@ struct diagnostics {
   uint32_t approved_dense_f32_stage_count = 0u;
   uint32_t disallowed_fallback_stage_count = 0u;
   uint32_t explicit_no_claim_stage_count = 0u;
+  // p50/p90/p99 per latency metric; empty without runtime_policy::latency.
+  emel::text::generator::latency::summary latency = {};
 };
 
 struct graph_lifecycle_snapshot {
@@ -150,6 +180,17 @@ struct graph_lifecycle_snapshot {
   bool runtime_tensor_captured = false;
 };
 
+// Prepared-weight sidecar export. `image_bytes` always reports the size the
+// last prepare() needs; the image is written only when `image` can hold it.
+struct prepared_weights_snapshot {
+  std::span<uint8_t> image = {};
+  uint64_t image_bytes = 0u;
+  uint32_t layout_count = 0u;
+  uint32_t cache_hits = 0u;
+  uint32_t cache_misses = 0u;
+  bool written = false;
+};
+
 }  // namespace emel::text::generator
 
 namespace emel::text::generator::event {
@@ -182,6 +223,9 @@ struct initialize {
   int32_t block_tokens = 0;
   bool strip_leading_space = false;
   std::span<const std::string_view> stop_sequences = {};
+  // Optional cold-start recorder (the one the model load used): backend
+  // prepare adds its weight repack and KV allocation phases.
+  emel::model::load_profile::recorder * load_profile = nullptr;
   emel::error::type * error_out = nullptr;
   emel::callback<void(const events::initialize_done &)> on_done = {};
   emel::callback<void(const events::initialize_error &)> on_error = {};
@@ -257,6 +301,9 @@ struct capture_diagnostics {
   emel::text::generator::diagnostics & out;
 };
 
+// Resident bytes of the session by holder (emel::memory::footprint).
+using capture_memory_footprint = emel::memory::footprint::capture;
+
 struct configure_benchmark_lane {
   emel::text::generator::benchmark_lane lane =
       emel::text::generator::benchmark_lane::multithreaded;
@@ -270,6 +317,14 @@ struct capture_graph_lifecycle {
   emel::text::generator::graph_lifecycle_snapshot & out;
 };
 
+struct capture_prepared_weights {
+  explicit capture_prepared_weights(
+      emel::text::generator::prepared_weights_snapshot & out_ref) noexcept
+    : out(out_ref) {}
+
+  emel::text::generator::prepared_weights_snapshot & out;
+};
+
 }  // namespace emel::text::generator::event
 
 namespace emel::text::generator::events {
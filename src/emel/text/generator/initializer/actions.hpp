@@ -52,7 +52,9 @@ struct request_backend_prepare {
         *generator.matmul_actor,
         generator.runtime_policy,
         generator.limits.block_tokens,
-        generator.matmul_lane_mode));
+        generator.matmul_lane_mode,
+        generator.prepared_weights,
+        ev.request.load_profile));
     ev.ctx.phase_accepted =
         ev.ctx.phase_code ==
         static_cast<int32_t>(emel::error::cast(emel::model::loader::error::none));
@@ -69,9 +71,30 @@ struct request_backend_prepare {
   }
 };
 
-struct accept_prepared_backend {
+// NUMA weight replicas need the final packed layouts and the stream binding
+// attached above; a budget of 0 (non-replicate policy) registers nothing.
+struct accept_prepared_resident_backend {
   void operator()(const event::run &, context & ctx) const noexcept {
     auto & generator = ctx.generator;
+    auto & backend = generator.compute.backend;
+    emel::text::generator::detail::begin_weight_replicas(
+        backend, emel::text::generator::detail::replica_budget_bytes(
+                     generator.runtime_policy));
+    emel::text::generator::detail::replicate_resident_decode_weights(backend);
+    emel::text::generator::detail::publish_weight_replicas(backend);
+    generator.compute.backend_ready = true;
+  }
+};
+
+struct accept_prepared_streamed_backend {
+  void operator()(const event::run &, context & ctx) const noexcept {
+    auto & generator = ctx.generator;
+    auto & backend = generator.compute.backend;
+    emel::text::generator::detail::begin_weight_replicas(
+        backend, emel::text::generator::detail::replica_budget_bytes(
+                     generator.runtime_policy));
+    emel::text::generator::detail::replicate_streamed_decode_weights(backend);
+    emel::text::generator::detail::publish_weight_replicas(backend);
     generator.compute.backend_ready = true;
   }
 };
@@ -203,7 +226,8 @@ struct on_unexpected {
 
 inline constexpr begin_initialize begin_initialize{};
 inline constexpr request_backend_prepare request_backend_prepare{};
-inline constexpr accept_prepared_backend accept_prepared_backend{};
+inline constexpr accept_prepared_resident_backend accept_prepared_resident_backend{};
+inline constexpr accept_prepared_streamed_backend accept_prepared_streamed_backend{};
 inline constexpr request_conditioner_bind request_conditioner_bind{};
 inline constexpr request_renderer_initialize request_renderer_initialize{};
 inline constexpr request_memory_reserve request_memory_reserve{};
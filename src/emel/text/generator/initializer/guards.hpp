@@ -185,6 +185,20 @@ struct backend_prepare_ok {
   }
 };
 
+// Streamed decode replicates only the raw output records; resident decode
+// replicates every block matrix.
+struct backend_prepare_ok_resident {
+  bool operator()(const event::run & ev, const action::context & ctx) const noexcept {
+    return backend_prepare_ok{}(ev, ctx) && !ctx.generator.compute.backend.stream.active;
+  }
+};
+
+struct backend_prepare_ok_streamed {
+  bool operator()(const event::run & ev, const action::context & ctx) const noexcept {
+    return backend_prepare_ok{}(ev, ctx) && ctx.generator.compute.backend.stream.active;
+  }
+};
+
 struct backend_prepare_invalid_request {
   bool operator()(const event::run & ev, const action::context &) const noexcept {
     return !detail::has_phase_success(ev) && detail::loader_invalid_code(ev.ctx.phase_code);
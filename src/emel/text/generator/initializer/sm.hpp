@@ -53,8 +53,13 @@ struct model {
 
       , sml::state<binding_conditioner> <= sml::state<preparing_backend_decision>
                  + sml::completion<event::run>
-                 [ guard::backend_prepare_ok{} ]
-                 / action::accept_prepared_backend
+                 [ guard::backend_prepare_ok_resident{} ]
+                 / action::accept_prepared_resident_backend
+
+      , sml::state<binding_conditioner> <= sml::state<preparing_backend_decision>
+                 + sml::completion<event::run>
+                 [ guard::backend_prepare_ok_streamed{} ]
+                 / action::accept_prepared_streamed_backend
 
       , sml::state<idle> <= sml::state<preparing_backend_decision>
                  + sml::completion<event::run>
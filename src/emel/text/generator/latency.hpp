@@ -0,0 +1,205 @@
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "emel/clock.hpp"
+
+// Opt-in request latency histograms for the generator: time to first token,
+// inter-token latency, prefill, sampler, renderer and streamed-window stalls.
+//
+// The recorder reaches the generator through runtime_policy::latency
+// (injection and null-recorder contract: emel/clock.hpp);
+// capture_diagnostics reports p50/p90/p99 of every metric. Histograms are
+// HDR-style log-linear: 16 sub-buckets per power of two, so a reported
+// percentile is the upper edge of its bucket and at most 1/16 above the
+// recorded value, from 1 ns to the full uint64 range. Reset the recorder
+// between runs to scope the percentiles; recording is single-threaded (the
+// generator's dispatch thread).
+namespace emel::text::generator::latency {
+
+using emel::clock_fn;
+
+enum class metric : uint8_t {
+  time_to_first_token = 0,  // generate accepted -> first token rendered
+  inter_token = 1,          // token rendered -> next token rendered
+  prefill = 2,              // prefill actor dispatch over the whole prompt
+  sampler = 3,              // one logits sampler dispatch
+  renderer = 4,             // one renderer dispatch
+  window_stall = 5,         // acquire of a streamed layer's window slot
+  count = 6,
+};
+
+inline constexpr size_t k_metric_count = static_cast<size_t>(metric::count);
+inline constexpr uint32_t k_sub_bucket_bits = 4u;
+inline constexpr uint64_t k_sub_bucket_count = uint64_t{1} << k_sub_bucket_bits;
+// Values below k_sub_bucket_count are exact; every octave above adds one row.
+inline constexpr size_t k_bucket_count =
+    (64u - k_sub_bucket_bits + 1u) * k_sub_bucket_count;
+
+inline constexpr std::string_view metric_name(const metric which) noexcept {
+  constexpr std::array<std::string_view, k_metric_count> names = {
+      "ttft", "inter_token", "prefill", "sampler", "renderer", "window_stall",
+  };
+  const auto index = static_cast<size_t>(which);
+  return index < k_metric_count ? names[index] : std::string_view{};
+}
+
+struct histogram {
+  std::array<uint64_t, k_bucket_count> buckets = {};
+  uint64_t count = 0u;
+  uint64_t total_ns = 0u;
+  uint64_t max_ns = 0u;
+};
+
+struct recorder {
+  clock_fn clock = nullptr;
+  std::array<histogram, k_metric_count> histograms = {};
+  uint64_t prefill_tokens = 0u;
+  uint64_t request_start_ns = 0u;
+  uint64_t last_token_ns = 0u;
+  bool token_emitted = false;
+};
+
+struct percentiles {
+  uint64_t count = 0u;
+  uint64_t p50_ns = 0u;
+  uint64_t p90_ns = 0u;
+  uint64_t p99_ns = 0u;
+  uint64_t max_ns = 0u;
+  uint64_t total_ns = 0u;
+};
+
+// What capture_diagnostics reports; prefill throughput is prefill_tokens
+// over metrics[prefill].total_ns.
+struct summary {
+  std::array<percentiles, k_metric_count> metrics = {};
+  uint64_t prefill_tokens = 0u;
+};
+
+inline size_t bucket_index(const uint64_t value) noexcept {
+  if (value < k_sub_bucket_count) {
+    return static_cast<size_t>(value);
+  }
+  const uint32_t octave = static_cast<uint32_t>(std::bit_width(value)) - 1u;
+  const uint32_t shift = octave - k_sub_bucket_bits;
+  const uint64_t sub = (value >> shift) & (k_sub_bucket_count - 1u);
+  return static_cast<size_t>((shift + 1u) * k_sub_bucket_count + sub);
+}
+
+// Largest value that lands in `index`.
+inline uint64_t bucket_upper(const size_t index) noexcept {
+  if (index < k_sub_bucket_count) {
+    return static_cast<uint64_t>(index);
+  }
+  const uint64_t shift = index / k_sub_bucket_count - 1u;
+  const uint64_t sub = index % k_sub_bucket_count;
+  const uint64_t lower = (k_sub_bucket_count + sub) << shift;
+  return lower + ((uint64_t{1} << shift) - 1u);
+}
+
+inline void add(histogram &into, const uint64_t value_ns) noexcept {
+  into.buckets[bucket_index(value_ns)] += 1u;
+  into.count += 1u;
+  into.total_ns += value_ns;
+  into.max_ns = value_ns > into.max_ns ? value_ns : into.max_ns;
+}
+
+// Upper edge of the bucket holding the q-th quantile (0 < q <= 1), clamped
+// to the recorded maximum; 0 for an empty histogram.
+inline uint64_t value_at(const histogram &from, const double quantile) noexcept {
+  if (from.count == 0u) {
+    return 0u;
+  }
+  const double scaled = quantile * static_cast<double>(from.count);
+  uint64_t rank = static_cast<uint64_t>(scaled);
+  rank += static_cast<double>(rank) < scaled ? 1u : 0u;
+  rank = rank == 0u ? 1u : rank;
+  uint64_t seen = 0u;
+  for (size_t index = 0; index < k_bucket_count; ++index) {
+    seen += from.buckets[index];
+    if (seen >= rank) {
+      const uint64_t upper = bucket_upper(index);
+      return upper < from.max_ns ? upper : from.max_ns;
+    }
+  }
+  return from.max_ns;
+}
+
+inline void reset(recorder &latency, const clock_fn clock) noexcept {
+  latency = recorder{};
+  latency.clock = clock;
+}
+
+inline uint64_t now(const recorder *latency) noexcept {
+  return latency == nullptr || latency->clock == nullptr ? 0u
+                                                         : latency->clock();
+}
+
+// Charges now - started_ns to `which`.
+inline void record(recorder *latency, const metric which,
+                   const uint64_t started_ns) noexcept {
+  if (latency == nullptr || latency->clock == nullptr) {
+    return;
+  }
+  add(latency->histograms[static_cast<size_t>(which)],
+      latency->clock() - started_ns);
+}
+
+inline void begin_request(recorder *latency) noexcept {
+  if (latency == nullptr || latency->clock == nullptr) {
+    return;
+  }
+  latency->request_start_ns = latency->clock();
+  latency->token_emitted = false;
+}
+
+inline void record_prefill(recorder *latency, const uint64_t started_ns,
+                           const int32_t prompt_tokens) noexcept {
+  if (latency == nullptr || latency->clock == nullptr) {
+    return;
+  }
+  record(latency, metric::prefill, started_ns);
+  latency->prefill_tokens +=
+      prompt_tokens > 0 ? static_cast<uint64_t>(prompt_tokens) : 0u;
+}
+
+// The first token of a request closes time-to-first-token, every later one
+// an inter-token interval.
+inline void record_token(recorder *latency) noexcept {
+  if (latency == nullptr || latency->clock == nullptr) {
+    return;
+  }
+  const uint64_t stamp = latency->clock();
+  const metric which = latency->token_emitted ? metric::inter_token
+                                              : metric::time_to_first_token;
+  const uint64_t since = latency->token_emitted ? latency->last_token_ns
+                                                : latency->request_start_ns;
+  add(latency->histograms[static_cast<size_t>(which)], stamp - since);
+  latency->last_token_ns = stamp;
+  latency->token_emitted = true;
+}
+
+inline void summarize(const recorder *latency, summary &out) noexcept {
+  out = summary{};
+  if (latency == nullptr) {
+    return;
+  }
+  for (size_t index = 0; index < k_metric_count; ++index) {
+    const histogram &from = latency->histograms[index];
+    out.metrics[index] = percentiles{
+        .count = from.count,
+        .p50_ns = value_at(from, 0.50),
+        .p90_ns = value_at(from, 0.90),
+        .p99_ns = value_at(from, 0.99),
+        .max_ns = from.max_ns,
+        .total_ns = from.total_ns,
+    };
+  }
+  out.prefill_tokens = latency->prefill_tokens;
+}
+
+}  // namespace emel::text::generator::latency
@@ -0,0 +1,248 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <span>
+#include <vector>
+
+#include "emel/model/data.hpp"
+#include "emel/model/fingerprint.hpp"
+
+// Persistent prepared-weight cache.
+//
+// prepare() repacks quantized matrices (q8_0/q4_k/q6_k -> the x4/x8 kernel
+// layouts) on every startup. The sidecar image below records those packed
+// bytes once so a later prepare() can bind the packed tensor_records straight
+// at an owner-mapped, read-only copy (io/mmap) instead of repacking.
+//
+// Image layout (little-endian, host struct layout; the pack flavor and layout
+// version reject images from a different build):
+//   header | entry[entry_count] | padding | payload (k_payload_alignment)
+//
+// Entries are recorded in prepare()'s deterministic pack order. A lookup only
+// hits the entry at the cursor, and the first mismatch disables the image for
+// the rest of the pass so a stale sidecar degrades to a plain repack.
+namespace emel::text::generator::prepared_cache {
+
+inline constexpr uint32_t k_magic = 0x43575045u;  // "EPWC"
+inline constexpr uint32_t k_layout_version = 1u;
+inline constexpr uint64_t k_payload_alignment = 64u;
+inline constexpr uint32_t k_max_entries = 1u << 16u;
+
+// Which packed layouts this build produces; part of the key because the
+// aarch64 feature macros select different packers for the same kernel_kind.
+inline constexpr uint32_t pack_flavor() noexcept {
+#if defined(__aarch64__) && defined(__ARM_NEON) &&                             \
+    defined(__ARM_FEATURE_MATMUL_INT8)
+  return 2u;
+#elif defined(__aarch64__) && defined(__ARM_NEON) &&                           \
+    defined(__ARM_FEATURE_DOTPROD)
+  return 1u;
+#else
+  return 0u;
+#endif
+}
+
+struct key {
+  uint64_t model_fingerprint = 0u;
+  uint32_t kernel_kind = 0u;
+  uint32_t layout_version = k_layout_version;
+  uint32_t pack_flavor = prepared_cache::pack_flavor();
+};
+
+struct header {
+  uint32_t magic = k_magic;
+  uint32_t layout_version = k_layout_version;
+  uint32_t kernel_kind = 0u;
+  uint32_t pack_flavor = 0u;
+  uint64_t model_fingerprint = 0u;
+  uint32_t entry_count = 0u;
+  uint32_t reserved = 0u;
+  uint64_t image_bytes = 0u;
+};
+
+struct entry {
+  uint32_t packed_dtype = 0u;
+  int32_t source_type = 0;
+  uint64_t source_file_offset = 0u;
+  uint64_t source_data_size = 0u;
+  uint64_t source_probe = 0u;
+  uint64_t payload_offset = 0u;
+  uint64_t payload_bytes = 0u;
+};
+
+// One packed layout bound during prepare(); data points at owned storage on a
+// repack or at the mapped image on a hit.
+struct record {
+  uint32_t packed_dtype = 0u;
+  const emel::model::data::tensor_record *source = nullptr;
+  const uint8_t *data = nullptr;
+  uint64_t bytes = 0u;
+};
+
+struct binding {
+  std::span<const uint8_t> image = {};
+  key expected = {};
+  uint32_t entry_count = 0u;
+  uint32_t cursor = 0u;
+  bool usable = false;
+  uint32_t hits = 0u;
+  uint32_t misses = 0u;
+  std::vector<record> records = {};
+};
+
+using emel::model::model_fingerprint;
+
+// Sampled source probe per entry: catches a re-quantized model with an
+// identical tensor table.
+inline uint64_t
+source_probe(const emel::model::data::tensor_record &source) noexcept {
+  return emel::model::source_probe(static_cast<const uint8_t *>(source.data),
+                                   source.data_size);
+}
+
+inline uint64_t align_payload(const uint64_t offset) noexcept {
+  return (offset + k_payload_alignment - 1u) & ~(k_payload_alignment - 1u);
+}
+
+inline uint64_t payload_begin(const uint32_t entry_count) noexcept {
+  return align_payload(sizeof(header) +
+                       static_cast<uint64_t>(entry_count) * sizeof(entry));
+}
+
+inline const entry *entry_at(const binding &cache,
+                             const uint32_t index) noexcept {
+  return reinterpret_cast<const entry *>(cache.image.data() + sizeof(header)) +
+         index;
+}
+
+// Validates the mapped image against the expected key and payload bounds.
+// Any mismatch leaves the binding unusable and prepare() repacks everything.
+inline void open(binding &cache, const std::span<const uint8_t> image,
+                 const key &expected) noexcept {
+  cache = binding{};
+  cache.expected = expected;
+  if (image.size() < sizeof(header) ||
+      (reinterpret_cast<uintptr_t>(image.data()) % alignof(entry)) != 0u) {
+    return;
+  }
+  header head = {};
+  std::memcpy(&head, image.data(), sizeof(head));
+  if (head.magic != k_magic || head.layout_version != expected.layout_version ||
+      head.kernel_kind != expected.kernel_kind ||
+      head.pack_flavor != expected.pack_flavor ||
+      head.model_fingerprint != expected.model_fingerprint ||
+      head.entry_count > k_max_entries || head.image_bytes != image.size() ||
+      payload_begin(head.entry_count) > image.size()) {
+    return;
+  }
+  cache.image = image;
+  cache.entry_count = head.entry_count;
+  for (uint32_t i = 0; i < head.entry_count; ++i) {
+    const entry &item = *entry_at(cache, i);
+    if (item.payload_offset < payload_begin(head.entry_count) ||
+        item.payload_bytes > image.size() ||
+        item.payload_offset > image.size() - item.payload_bytes) {
+      cache.image = {};
+      cache.entry_count = 0u;
+      return;
+    }
+  }
+  cache.usable = true;
+}
+
+// Returns mapped packed bytes for the next layout in pack order, or nullptr
+// when the caller must repack.
+inline const uint8_t *
+claim(binding *cache, const uint32_t packed_dtype,
+      const emel::model::data::tensor_record &source,
+      const uint64_t bytes) noexcept {
+  if (cache == nullptr) {
+    return nullptr;
+  }
+  if (!cache->usable || cache->cursor >= cache->entry_count) {
+    cache->usable = false;
+    cache->misses += 1u;
+    return nullptr;
+  }
+  const entry &item = *entry_at(*cache, cache->cursor);
+  if (item.packed_dtype != packed_dtype || item.source_type != source.type ||
+      item.source_file_offset != source.file_offset ||
+      item.source_data_size != source.data_size ||
+      item.payload_bytes != bytes || item.source_probe != source_probe(source)) {
+    cache->usable = false;
+    cache->misses += 1u;
+    return nullptr;
+  }
+  cache->cursor += 1u;
+  cache->hits += 1u;
+  return cache->image.data() + item.payload_offset;
+}
+
+inline void note(binding *cache, const uint32_t packed_dtype,
+                 const emel::model::data::tensor_record &source,
+                 const uint8_t *data, const uint64_t bytes) noexcept {
+  if (cache == nullptr) {
+    return;
+  }
+  cache->records.push_back(record{
+      .packed_dtype = packed_dtype,
+      .source = &source,
+      .data = data,
+      .bytes = bytes,
+  });
+}
+
+inline uint64_t image_bytes(const binding &cache) noexcept {
+  const auto count = static_cast<uint32_t>(cache.records.size());
+  uint64_t offset = payload_begin(count);
+  for (const auto &item : cache.records) {
+    offset = align_payload(offset) + item.bytes;
+  }
+  return offset;
+}
+
+// Serializes every layout bound by the last prepare() into `out`. The owner
+// persists the image next to the model and maps it read-only on the next run.
+inline bool write_image(const binding &cache, const std::span<uint8_t> out) noexcept {
+  const uint64_t total = image_bytes(cache);
+  if (cache.records.empty() || cache.records.size() > k_max_entries ||
+      out.size() < total) {
+    return false;
+  }
+  const auto count = static_cast<uint32_t>(cache.records.size());
+  std::memset(out.data(), 0, static_cast<size_t>(total));
+  const header head{
+      .magic = k_magic,
+      .layout_version = cache.expected.layout_version,
+      .kernel_kind = cache.expected.kernel_kind,
+      .pack_flavor = cache.expected.pack_flavor,
+      .model_fingerprint = cache.expected.model_fingerprint,
+      .entry_count = count,
+      .reserved = 0u,
+      .image_bytes = total,
+  };
+  std::memcpy(out.data(), &head, sizeof(head));
+  uint64_t offset = payload_begin(count);
+  for (uint32_t i = 0; i < count; ++i) {
+    const auto &item = cache.records[i];
+    offset = align_payload(offset);
+    const entry row{
+        .packed_dtype = item.packed_dtype,
+        .source_type = item.source->type,
+        .source_file_offset = item.source->file_offset,
+        .source_data_size = item.source->data_size,
+        .source_probe = source_probe(*item.source),
+        .payload_offset = offset,
+        .payload_bytes = item.bytes,
+    };
+    std::memcpy(out.data() + sizeof(header) + i * sizeof(entry), &row,
+                sizeof(row));
+    std::memcpy(out.data() + offset, item.data, static_cast<size_t>(item.bytes));
+    offset += item.bytes;
+  }
+  return true;
+}
+
+}  // namespace emel::text::generator::prepared_cache
@@ -2,6 +2,7 @@
 
 #include <new>
 #include <optional>
+#include <span>
 #include <utility>
 
 #include "emel/text/generator/actions.hpp"
@@ -83,6 +84,8 @@ struct dependencies {
   emel::model::tensor::window::sm * stream_window = nullptr;
   bool stream_active = false;
   emel::memory::hybrid::kv_binding kv_cache = {};
+  // Owner-mapped (io/mmap, read-only) prepared-weight sidecar; empty repacks.
+  std::span<const uint8_t> prepared_weights = {};
 };
 
 struct uninitialized {};
@@ -1028,6 +1031,22 @@ struct model {
                  [ guard::graph_lifecycle_runtime_tensor_available{} ]
                  / action::capture_graph_lifecycle_with_runtime_tensor
 
+      , sml::state<uninitialized> <= sml::state<uninitialized>
+                 + sml::event<event::capture_prepared_weights>
+                 / action::effect_capture_prepared_weights_unprepared
+
+      , sml::state<ready> <= sml::state<ready>
+                 + sml::event<event::capture_prepared_weights>
+                 / action::effect_capture_prepared_weights
+
+      , sml::state<uninitialized> <= sml::state<uninitialized>
+                 + sml::event<event::capture_memory_footprint>
+                 / action::effect_capture_memory_footprint_unprepared
+
+      , sml::state<ready> <= sml::state<ready>
+                 + sml::event<event::capture_memory_footprint>
+                 / action::effect_capture_memory_footprint
+
       //------------------------------------------------------------------------------//
       // Unexpected events.
       , sml::state<uninitialized> <= sml::state<uninitialized> + sml::unexpected_event<sml::_>
@@ -1151,6 +1170,7 @@ struct sm : public emel::sm<model, action::context> {
     this->context_.format_prompt = deps.format_prompt;
     this->context_.stream_window = deps.stream_window;
     this->context_.stream_active = deps.stream_active;
+    this->context_.prepared_weights = deps.prepared_weights;
     // Session scratch is sized once from the injected loaded model before the initialize pipeline.
     if (this->context_.model != nullptr) {
       detail::reserve_session_buffers(this->context_, *this->context_.model);
@@ -1188,6 +1208,14 @@ struct sm : public emel::sm<model, action::context> {
     return base_type::process_event(ev);
   }
 
+  bool process_event(const event::capture_prepared_weights & ev) {
+    return base_type::process_event(ev);
+  }
+
+  bool process_event(const event::capture_memory_footprint & ev) {
+    return base_type::process_event(ev);
+  }
+
  private:
   std::optional<emel::kernel::matmul::sm> matmul_actor_ = {};
   std::optional<emel::text::generator::initializer::sm> initializer_actor_ = {};
@@ -3,8 +3,17 @@
 #include <array>
 #include <cstddef>
 #include <cstdint>
+#include <cstring>
 #include <string_view>
 
+#if defined(__AVX2__) || defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#if defined(__ARM_NEON) && defined(__aarch64__)
+#include <arm_neon.h>
+#endif
+
 #include "emel/text/unicode.hpp"
 #include "emel/text/tokenizer/bpe/regex.hpp"
 
@@ -262,6 +271,187 @@ inline bool decode_utf8_to_cpts(const std::string_view text,
   return true;
 }
 
+// Byte-level BPE maps every input byte to one printable codepoint; the mapped UTF-8 is at most
+// two bytes, so the per-byte expansion is precomputed once.
+struct bpe_byte_encoding {
+  std::array<char, 2> bytes = {};
+  uint8_t length = 0;
+};
+
+inline constexpr std::array<bpe_byte_encoding, 256> bpe_byte_encoding_map() {
+  std::array<bpe_byte_encoding, 256> table = {};
+  for (size_t byte = 0; byte < table.size(); ++byte) {
+    const uint32_t mapped = k_bpe_byte_to_unicode[byte];
+    if (mapped <= 0x7Fu) {
+      table[byte].bytes[0] = static_cast<char>(mapped);
+      table[byte].length = 1;
+    } else {
+      table[byte].bytes[0] = static_cast<char>(0xC0u | ((mapped >> 6) & 0x1Fu));
+      table[byte].bytes[1] = static_cast<char>(0x80u | (mapped & 0x3Fu));
+      table[byte].length = 2;
+    }
+  }
+  return table;
+}
+
+inline constexpr std::array<bpe_byte_encoding, 256> k_bpe_byte_encoding =
+    bpe_byte_encoding_map();
+
+// Unicode category, case and whitespace flags for the ASCII range, matching
+// `unicode_cpt_flags_from_cpt` so the byte-level splitter takes exactly the same regex decisions
+// as the codepoint splitter. The NFD bit is not consulted by any splitter and is left clear.
+inline constexpr std::array<uint16_t, 128> ascii_cpt_flags_map() {
+  using flags = emel::text::unicode_cpt_flags;
+  std::array<uint16_t, 128> table = {};
+  for (size_t cpt = 0; cpt < table.size(); ++cpt) {
+    const bool lower = cpt >= 'a' && cpt <= 'z';
+    const bool upper = cpt >= 'A' && cpt <= 'Z';
+    const bool digit = cpt >= '0' && cpt <= '9';
+    const bool control = cpt < 0x20u || cpt == 0x7Fu;
+    const bool whitespace = (cpt >= 0x09u && cpt <= 0x0Du) || cpt == 0x20u;
+    const bool symbol = cpt == '$' || cpt == '+' || cpt == '<' || cpt == '=' ||
+                        cpt == '>' || cpt == '^' || cpt == '`' || cpt == '|' ||
+                        cpt == '~';
+    uint16_t value = 0;
+    if (lower) {
+      value = flags::LETTER | flags::LOWERCASE;
+    } else if (upper) {
+      value = flags::LETTER | flags::UPPERCASE;
+    } else if (digit) {
+      value = flags::NUMBER;
+    } else if (cpt == 0x20u) {
+      value = flags::SEPARATOR;
+    } else if (control) {
+      value = flags::CONTROL;
+    } else if (symbol) {
+      value = flags::SYMBOL;
+    } else {
+      value = flags::PUNCTUATION;
+    }
+    if (whitespace) {
+      value = static_cast<uint16_t>(value | flags::WHITESPACE);
+    }
+    table[cpt] = value;
+  }
+  return table;
+}
+
+inline constexpr std::array<uint16_t, 128> k_ascii_cpt_flags = ascii_cpt_flags_map();
+
+// Character sources for the splitters: the generic path reads decoded codepoints, the fast
+// path reads pure-ASCII bytes in place, where codepoint positions equal byte positions.
+struct cpt_source {
+  const uint32_t * cpts = nullptr;
+
+  uint32_t cpt(const size_t pos) const noexcept { return cpts[pos]; }
+
+  emel::text::unicode_cpt_flags flags(const size_t pos) const {
+    return emel::text::unicode_cpt_flags_from_cpt(cpts[pos]);
+  }
+
+  static uint32_t tolower(const uint32_t cpt) { return emel::text::unicode_tolower(cpt); }
+
+  static bool is_han(const uint32_t cpt) { return emel::text::unicode_cpt_is_han(cpt); }
+};
+
+struct ascii_source {
+  const char * bytes = nullptr;
+
+  uint32_t cpt(const size_t pos) const noexcept {
+    return static_cast<uint8_t>(bytes[pos]);
+  }
+
+  emel::text::unicode_cpt_flags flags(const size_t pos) const noexcept {
+    return emel::text::unicode_cpt_flags(k_ascii_cpt_flags[cpt(pos) & 0x7Fu]);
+  }
+
+  static uint32_t tolower(const uint32_t cpt) noexcept {
+    const bool upper = cpt - static_cast<uint32_t>('A') < 26u;
+    return cpt | (static_cast<uint32_t>(upper) << 5u);
+  }
+
+  static bool is_han(const uint32_t) noexcept { return false; }
+};
+
+// Returns the length of the leading run of bytes below 0x80, scanning a vector at a time.
+inline size_t ascii_prefix_length(const std::string_view text) noexcept {
+  const char * data = text.data();
+  const size_t size = text.size();
+  size_t pos = 0;
+#if defined(__AVX2__)
+  for (; pos + 32u <= size; pos += 32u) {
+    const __m256i block =
+        _mm256_loadu_si256(reinterpret_cast<const __m256i *>(data + pos));
+    const uint32_t high = static_cast<uint32_t>(_mm256_movemask_epi8(block));
+    if (high != 0u) {
+      return pos + static_cast<size_t>(__builtin_ctz(high));
+    }
+  }
+#endif
+#if defined(__SSE2__)
+  for (; pos + 16u <= size; pos += 16u) {
+    const __m128i block =
+        _mm_loadu_si128(reinterpret_cast<const __m128i *>(data + pos));
+    const uint32_t high = static_cast<uint32_t>(_mm_movemask_epi8(block));
+    if (high != 0u) {
+      return pos + static_cast<size_t>(__builtin_ctz(high));
+    }
+  }
+#elif defined(__ARM_NEON) && defined(__aarch64__)
+  for (; pos + 16u <= size; pos += 16u) {
+    const uint8x16_t block = vld1q_u8(reinterpret_cast<const uint8_t *>(data + pos));
+    if (vmaxvq_u8(block) >= 0x80u) {
+      break;
+    }
+  }
+#endif
+  for (; pos < size; ++pos) {
+    if ((static_cast<uint8_t>(data[pos]) & 0x80u) != 0u) {
+      return pos;
+    }
+  }
+  return size;
+}
+
+inline bool ascii_non_whitespace(const char byte) noexcept {
+  const uint8_t value = static_cast<uint8_t>(byte);
+  return value < 0x80u &&
+         (k_ascii_cpt_flags[value] & emel::text::unicode_cpt_flags::WHITESPACE) == 0u;
+}
+
+// A lone '\n' between two ASCII non-whitespace characters always ends a pre-token in every
+// split profile, and no profile looks behind, so splitting on either side of it yields the
+// same pre-tokens as splitting the whole text.
+inline bool is_safe_split_cut(const std::string_view text, const size_t pos) noexcept {
+  return pos >= 2u && pos < text.size() && text[pos - 1u] == '\n' &&
+         ascii_non_whitespace(text[pos - 2u]) && ascii_non_whitespace(text[pos]);
+}
+
+inline size_t last_safe_split_cut(const std::string_view text, const size_t begin,
+                                  const size_t end) noexcept {
+  for (size_t pos = end; pos > begin; --pos) {
+    if (is_safe_split_cut(text, pos)) {
+      return pos;
+    }
+  }
+  return begin;
+}
+
+inline size_t next_safe_split_cut(const std::string_view text, const size_t begin) noexcept {
+  size_t pos = begin;
+  while (pos < text.size()) {
+    const void * newline = std::memchr(text.data() + pos, '\n', text.size() - pos);
+    if (newline == nullptr) {
+      return text.size();
+    }
+    pos = static_cast<size_t>(static_cast<const char *>(newline) - text.data()) + 1u;
+    if (is_safe_split_cut(text, pos)) {
+      return pos;
+    }
+  }
+  return text.size();
+}
+
 inline bool push_offset(size_t value, size_t * out, size_t capacity,
                         size_t & out_count) {
   if (value == 0) {
@@ -274,10 +464,11 @@ inline bool push_offset(size_t value, size_t * out, size_t capacity,
   return true;
 }
 
-inline bool split_gpt2(const uint32_t * cpts, size_t cpt_count,
-                       const size_t * offsets_in, size_t offsets_in_count,
-                       size_t * offsets_out, size_t out_capacity,
-                       size_t & out_count) {
+template <class source_type>
+inline bool split_gpt2_from(const source_type & source, size_t cpt_count,
+                            const size_t * offsets_in, size_t offsets_in_count,
+                            size_t * offsets_out, size_t out_capacity,
+                            size_t & out_count) {
   out_count = 0;
   size_t start = 0;
   for (size_t idx = 0; idx < offsets_in_count; ++idx) {
@@ -289,12 +480,12 @@ inline bool split_gpt2(const uint32_t * cpts, size_t cpt_count,
     start = offset_end;
 
     auto get_cpt = [&](const size_t pos) -> uint32_t {
-      return (offset_ini <= pos && pos < offset_end) ? cpts[pos]
+      return (offset_ini <= pos && pos < offset_end) ? source.cpt(pos)
                                                      : bpe_out_of_range;
     };
     auto get_flags = [&](const size_t pos) -> emel::text::unicode_cpt_flags {
       return (offset_ini <= pos && pos < offset_end)
-                 ? emel::text::unicode_cpt_flags_from_cpt(cpts[pos])
+                 ? source.flags(pos)
                  : emel::text::unicode_cpt_flags{};
     };
 
@@ -401,10 +592,19 @@ inline bool split_gpt2(const uint32_t * cpts, size_t cpt_count,
   return true;
 }
 
-inline bool split_llama3(const uint32_t * cpts, size_t cpt_count,
-                         const size_t * offsets_in, size_t offsets_in_count,
-                         size_t * offsets_out, size_t out_capacity,
-                         size_t & out_count) {
+inline bool split_gpt2(const uint32_t * cpts, size_t cpt_count,
+                       const size_t * offsets_in, size_t offsets_in_count,
+                       size_t * offsets_out, size_t out_capacity,
+                       size_t & out_count) {
+  return split_gpt2_from(cpt_source{cpts}, cpt_count, offsets_in, offsets_in_count,
+                         offsets_out, out_capacity, out_count);
+}
+
+template <class source_type>
+inline bool split_llama3_from(const source_type & source, size_t cpt_count,
+                              const size_t * offsets_in, size_t offsets_in_count,
+                              size_t * offsets_out, size_t out_capacity,
+                              size_t & out_count) {
   out_count = 0;
   size_t start = 0;
   for (size_t idx = 0; idx < offsets_in_count; ++idx) {
@@ -416,12 +616,12 @@ inline bool split_llama3(const uint32_t * cpts, size_t cpt_count,
     start = offset_end;
 
     auto get_cpt = [&](const size_t pos) -> uint32_t {
-      return (offset_ini <= pos && pos < offset_end) ? cpts[pos]
+      return (offset_ini <= pos && pos < offset_end) ? source.cpt(pos)
                                                      : bpe_out_of_range;
     };
     auto get_flags = [&](const size_t pos) -> emel::text::unicode_cpt_flags {
       return (offset_ini <= pos && pos < offset_end)
-                 ? emel::text::unicode_cpt_flags_from_cpt(cpts[pos])
+                 ? source.flags(pos)
                  : emel::text::unicode_cpt_flags{};
     };
 
@@ -440,7 +640,7 @@ inline bool split_llama3(const uint32_t * cpts, size_t cpt_count,
       const auto flags = get_flags(pos);
 
       if (cpt == '\'' && pos + 1 < offset_end) {
-        const uint32_t cpt_next = emel::text::unicode_tolower(get_cpt(pos + 1));
+        const uint32_t cpt_next = source.tolower(get_cpt(pos + 1));
         if (cpt_next == 's' || cpt_next == 't' || cpt_next == 'm' ||
             cpt_next == 'd') {
           if (!add_token(pos + 2)) {
@@ -451,7 +651,7 @@ inline bool split_llama3(const uint32_t * cpts, size_t cpt_count,
         }
         if (pos + 2 < offset_end) {
           const uint32_t cpt_next_next =
-              emel::text::unicode_tolower(get_cpt(pos + 2));
+              source.tolower(get_cpt(pos + 2));
           if ((cpt_next == 'r' && cpt_next_next == 'e') ||
               (cpt_next == 'v' && cpt_next_next == 'e') ||
               (cpt_next == 'l' && cpt_next_next == 'l')) {
@@ -555,10 +755,19 @@ inline bool split_llama3(const uint32_t * cpts, size_t cpt_count,
   return true;
 }
 
-inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
-                          const size_t * offsets_in, size_t offsets_in_count,
-                          size_t * offsets_out, size_t out_capacity,
-                          size_t & out_count) {
+inline bool split_llama3(const uint32_t * cpts, size_t cpt_count,
+                         const size_t * offsets_in, size_t offsets_in_count,
+                         size_t * offsets_out, size_t out_capacity,
+                         size_t & out_count) {
+  return split_llama3_from(cpt_source{cpts}, cpt_count, offsets_in, offsets_in_count,
+                           offsets_out, out_capacity, out_count);
+}
+
+template <class source_type>
+inline bool split_kimi_k2_from(const source_type & source, size_t cpt_count,
+                               const size_t * offsets_in, size_t offsets_in_count,
+                               size_t * offsets_out, size_t out_capacity,
+                               size_t & out_count) {
   out_count = 0;
   size_t start = 0;
   for (size_t idx = 0; idx < offsets_in_count; ++idx) {
@@ -580,12 +789,12 @@ inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
     };
 
     for (size_t pos = offset_ini; pos < offset_end;) {
-      const uint32_t cpt = cpts[pos];
-      const auto flags = emel::text::unicode_cpt_flags_from_cpt(cpt);
+      const uint32_t cpt = source.cpt(pos);
+      const auto flags = source.flags(pos);
 
-      if (emel::text::unicode_cpt_is_han(cpt)) {
+      if (source.is_han(cpt)) {
         ++pos;
-        while (pos < offset_end && emel::text::unicode_cpt_is_han(cpts[pos])) {
+        while (pos < offset_end && source.is_han(source.cpt(pos))) {
           ++pos;
         }
         if (!add_token(pos)) {
@@ -597,9 +806,9 @@ inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
       if (flags.is_letter) {
         ++pos;
         while (pos < offset_end) {
-          const uint32_t next = cpts[pos];
-          const auto next_flags = emel::text::unicode_cpt_flags_from_cpt(next);
-          if (!next_flags.is_letter || emel::text::unicode_cpt_is_han(next)) {
+          const uint32_t next = source.cpt(pos);
+          const auto next_flags = source.flags(pos);
+          if (!next_flags.is_letter || source.is_han(next)) {
             break;
           }
           ++pos;
@@ -614,7 +823,7 @@ inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
         ++pos;
         size_t digits = 1;
         while (pos < offset_end &&
-               emel::text::unicode_cpt_flags_from_cpt(cpts[pos]).is_number &&
+               source.flags(pos).is_number &&
                digits < 3) {
           ++pos;
           ++digits;
@@ -628,7 +837,7 @@ inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
       if (flags.is_whitespace) {
         ++pos;
         while (pos < offset_end &&
-               emel::text::unicode_cpt_flags_from_cpt(cpts[pos]).is_whitespace) {
+               source.flags(pos).is_whitespace) {
           ++pos;
         }
         if (!add_token(pos)) {
@@ -646,10 +855,19 @@ inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
   return true;
 }
 
-inline bool split_afmoe(const uint32_t * cpts, size_t cpt_count,
-                        const size_t * offsets_in, size_t offsets_in_count,
-                        size_t * offsets_out, size_t out_capacity,
-                        size_t & out_count) {
+inline bool split_kimi_k2(const uint32_t * cpts, size_t cpt_count,
+                          const size_t * offsets_in, size_t offsets_in_count,
+                          size_t * offsets_out, size_t out_capacity,
+                          size_t & out_count) {
+  return split_kimi_k2_from(cpt_source{cpts}, cpt_count, offsets_in, offsets_in_count,
+                            offsets_out, out_capacity, out_count);
+}
+
+template <class source_type>
+inline bool split_afmoe_from(const source_type & source, size_t cpt_count,
+                             const size_t * offsets_in, size_t offsets_in_count,
+                             size_t * offsets_out, size_t out_capacity,
+                             size_t & out_count) {
   out_count = 0;
   size_t start = 0;
   for (size_t idx = 0; idx < offsets_in_count; ++idx) {
@@ -671,7 +889,7 @@ inline bool split_afmoe(const uint32_t * cpts, size_t cpt_count,
     };
 
     for (size_t pos = offset_ini; pos < offset_end;) {
-      const auto flags = emel::text::unicode_cpt_flags_from_cpt(cpts[pos]);
+      const auto flags = source.flags(pos);
       if (!flags.is_number) {
         ++pos;
         if (!add_token(pos)) {
@@ -682,7 +900,7 @@ inline bool split_afmoe(const uint32_t * cpts, size_t cpt_count,
 
       const size_t digit_start = pos;
       while (pos < offset_end &&
-             emel::text::unicode_cpt_flags_from_cpt(cpts[pos]).is_number) {
+             source.flags(pos).is_number) {
         ++pos;
       }
 
@@ -706,6 +924,42 @@ inline bool split_afmoe(const uint32_t * cpts, size_t cpt_count,
   return true;
 }
 
+inline bool split_afmoe(const uint32_t * cpts, size_t cpt_count,
+                        const size_t * offsets_in, size_t offsets_in_count,
+                        size_t * offsets_out, size_t out_capacity,
+                        size_t & out_count) {
+  return split_afmoe_from(cpt_source{cpts}, cpt_count, offsets_in, offsets_in_count,
+                          offsets_out, out_capacity, out_count);
+}
+
+inline bool append_encoded_word(const size_t segment_offset, split_scratch & scratch) {
+  const size_t encoded_len = scratch.encoded_size - segment_offset;
+  if (encoded_len == 0) {
+    return true;
+  }
+  if (scratch.word_count >= scratch.words.size()) {
+    return false;
+  }
+  scratch.words[scratch.word_count++] =
+      std::string_view(scratch.encoded.data() + segment_offset, encoded_len);
+  return true;
+}
+
+inline bool encode_bpe_bytes(const char * bytes, const size_t len,
+                             split_scratch & scratch) {
+  for (size_t idx = 0; idx < len; ++idx) {
+    const bpe_byte_encoding & encoded =
+        k_bpe_byte_encoding[static_cast<uint8_t>(bytes[idx])];
+    if (scratch.encoded_size + encoded.length > scratch.encoded.size()) {
+      return false;
+    }
+    for (size_t k = 0; k < encoded.length; ++k) {
+      scratch.encoded[scratch.encoded_size++] = encoded.bytes[k];
+    }
+  }
+  return true;
+}
+
 inline bool encode_bpe_segment(const uint32_t * cpts, size_t start,
                                size_t len, split_scratch & scratch) {
   size_t segment_offset = scratch.encoded_size;
@@ -715,46 +969,35 @@ inline bool encode_bpe_segment(const uint32_t * cpts, size_t start,
     if (utf8_len == 0) {
       return false;
     }
-    for (size_t j = 0; j < utf8_len; ++j) {
-      const uint8_t byte = static_cast<uint8_t>(utf8[j]);
-      const uint32_t mapped = k_bpe_byte_to_unicode[byte];
-      char encoded[4];
-      const size_t encoded_len = encode_utf8(mapped, encoded, sizeof(encoded));
-      if (encoded_len == 0) {
-        return false;
-      }
-      if (scratch.encoded_size + encoded_len > scratch.encoded.size()) {
-        return false;
-      }
-      for (size_t k = 0; k < encoded_len; ++k) {
-        scratch.encoded[scratch.encoded_size++] = encoded[k];
-      }
+    if (!encode_bpe_bytes(utf8, utf8_len, scratch)) {
+      return false;
     }
   }
-  const size_t encoded_len = scratch.encoded_size - segment_offset;
-  if (encoded_len == 0) {
-    return true;
-  }
-  if (scratch.word_count >= scratch.words.size()) {
+  return append_encoded_word(segment_offset, scratch);
+}
+
+inline bool encode_bpe_ascii_segment(const char * bytes, size_t start, size_t len,
+                                     split_scratch & scratch) {
+  const size_t segment_offset = scratch.encoded_size;
+  if (!encode_bpe_bytes(bytes + start, len, scratch)) {
     return false;
   }
-  scratch.words[scratch.word_count++] =
-      std::string_view(scratch.encoded.data() + segment_offset, encoded_len);
-  return true;
+  return append_encoded_word(segment_offset, scratch);
 }
 
-inline bool split_offsets_for_profile(const split_profile profile,
-                                      const uint32_t * cpts,
-                                      const size_t cpt_count,
-                                      const size_t * offsets_in,
-                                      const size_t offsets_in_count,
-                                      size_t * offsets_out,
-                                      const size_t out_capacity,
-                                      size_t & out_count) {
+template <class source_type>
+inline bool split_offsets_for_profile_from(const split_profile profile,
+                                           const source_type & source,
+                                           const size_t cpt_count,
+                                           const size_t * offsets_in,
+                                           const size_t offsets_in_count,
+                                           size_t * offsets_out,
+                                           const size_t out_capacity,
+                                           size_t & out_count) {
   switch (profile) {
     case split_profile::gpt2:
-      return split_gpt2(cpts, cpt_count, offsets_in, offsets_in_count, offsets_out,
-                        out_capacity, out_count);
+      return split_gpt2_from(source, cpt_count, offsets_in, offsets_in_count, offsets_out,
+                             out_capacity, out_count);
     case split_profile::llama3:
     case split_profile::jais2:
     case split_profile::deepseek_llm:
@@ -775,30 +1018,36 @@ inline bool split_offsets_for_profile(const split_profile profile,
     case split_profile::seed_coder:
     case split_profile::exaone_moe:
     case split_profile::default_profile:
-      return split_llama3(cpts, cpt_count, offsets_in, offsets_in_count, offsets_out,
-                          out_capacity, out_count);
+      return split_llama3_from(source, cpt_count, offsets_in, offsets_in_count, offsets_out,
+                               out_capacity, out_count);
     case split_profile::kimi_k2:
-      return split_kimi_k2(cpts, cpt_count, offsets_in, offsets_in_count, offsets_out,
-                           out_capacity, out_count);
+      return split_kimi_k2_from(source, cpt_count, offsets_in, offsets_in_count,
+                                offsets_out, out_capacity, out_count);
     case split_profile::superbpe:
     case split_profile::afmoe:
-      return split_afmoe(cpts, cpt_count, offsets_in, offsets_in_count, offsets_out,
-                         out_capacity, out_count);
+      return split_afmoe_from(source, cpt_count, offsets_in, offsets_in_count, offsets_out,
+                              out_capacity, out_count);
   }
   return false;
 }
 
-inline bool split_and_encode_profile(const std::string_view text,
-                                     const split_profile profile,
-                                     split_scratch & scratch) {
-  scratch.word_count = 0;
-  scratch.encoded_size = 0;
-  if (text.empty()) {
-    return true;
-  }
-  if (text.size() > scratch.encoded.size()) {
-    return false;
-  }
+inline bool split_offsets_for_profile(const split_profile profile,
+                                      const uint32_t * cpts,
+                                      const size_t cpt_count,
+                                      const size_t * offsets_in,
+                                      const size_t offsets_in_count,
+                                      size_t * offsets_out,
+                                      const size_t out_capacity,
+                                      size_t & out_count) {
+  return split_offsets_for_profile_from(profile, cpt_source{cpts}, cpt_count, offsets_in,
+                                        offsets_in_count, offsets_out, out_capacity,
+                                        out_count);
+}
+
+// Codepoint path: decodes the chunk and consults the full unicode category tables.
+inline bool split_and_encode_cpts(const std::string_view text,
+                                  const split_profile profile,
+                                  split_scratch & scratch) {
   if (!decode_utf8_to_cpts(text, scratch)) {
     return false;
   }
@@ -831,6 +1080,73 @@ inline bool split_and_encode_profile(const std::string_view text,
   return true;
 }
 
+// ASCII path: splits and byte-encodes the chunk in place without decoding codepoints.
+inline bool split_and_encode_ascii(const std::string_view text,
+                                   const split_profile profile,
+                                   split_scratch & scratch) {
+  scratch.offsets_a[0] = text.size();
+  scratch.offset_count = 1;
+  size_t out_count = 0;
+  if (!split_offsets_for_profile_from(profile,
+                                      ascii_source{text.data()},
+                                      text.size(),
+                                      scratch.offsets_a.data(),
+                                      scratch.offset_count,
+                                      scratch.offsets_b.data(),
+                                      scratch.offsets_b.size(),
+                                      out_count)) {
+    return false;
+  }
+
+  size_t start = 0;
+  for (size_t idx = 0; idx < out_count; ++idx) {
+    const size_t len = scratch.offsets_b[idx];
+    if (!encode_bpe_ascii_segment(text.data(), start, len, scratch)) {
+      return false;
+    }
+    start += len;
+  }
+  return true;
+}
+
+// Splits pure-ASCII stretches on the byte path and hands only the chunks around non-ASCII
+// bytes to the codepoint path. Chunks are separated at safe cuts, so the concatenated
+// pre-tokens match a single codepoint pass over the whole text.
+inline bool split_and_encode_profile(const std::string_view text,
+                                     const split_profile profile,
+                                     split_scratch & scratch) {
+  scratch.word_count = 0;
+  scratch.encoded_size = 0;
+  if (text.empty()) {
+    return true;
+  }
+  if (text.size() > scratch.encoded.size()) {
+    return false;
+  }
+
+  size_t pos = 0;
+  while (pos < text.size()) {
+    const std::string_view rest = text.substr(pos);
+    const size_t ascii_end = pos + ascii_prefix_length(rest);
+    if (ascii_end == text.size()) {
+      return split_and_encode_ascii(rest, profile, scratch);
+    }
+
+    const size_t cut = last_safe_split_cut(text, pos, ascii_end);
+    if (cut > pos &&
+        !split_and_encode_ascii(text.substr(pos, cut - pos), profile, scratch)) {
+      return false;
+    }
+
+    const size_t next = next_safe_split_cut(text, ascii_end);
+    if (!split_and_encode_cpts(text.substr(cut, next - cut), profile, scratch)) {
+      return false;
+    }
+    pos = next;
+  }
+  return true;
+}
+
 inline bool split_and_encode_fallback(const std::string_view text,
                                       const regex_list & regex,
                                       split_scratch & scratch) {
@@ -0,0 +1,232 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "emel/text/tokenizer/document/context.hpp"
+#include "emel/text/tokenizer/document/detail.hpp"
+#include "emel/text/tokenizer/document/events.hpp"
+#include "emel/text/tokenizer/errors.hpp"
+#include "emel/text/tokenizer/preprocessor/detail.hpp"
+
+namespace emel::text::tokenizer::document::action {
+
+struct begin_document {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    const auto &request = ev.request;
+    const bool add_special = request.add_special;
+    ev.ctx.prefix_count =
+        static_cast<int32_t>(add_special && request.vocab->add_bos);
+    ev.ctx.suffix_count =
+        static_cast<int32_t>(add_special && request.vocab->add_eos);
+    ev.ctx.token_count = 0;
+    ev.ctx.span_count = 0;
+    ev.ctx.all_submitted = false;
+    ev.ctx.joined = false;
+    ev.ctx.err = error_code(error::none);
+    ev.ctx.result = false;
+    ctx.specials_ready = emel::text::tokenizer::preprocessor::detail::build_special_tokens(
+        ctx.specials, *request.vocab);
+  }
+};
+
+struct reject_invalid {
+  template <class runtime_event_type>
+  void operator()(const runtime_event_type &ev, context &) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.err = error_code(error::invalid_request);
+    ev.ctx.result = false;
+  }
+};
+
+// Documents that cannot be cut are forwarded to lane 0 as one tokenize request,
+// so the result is exactly what a direct tokenize dispatch would produce.
+struct dispatch_single_pass {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    const auto &request = ev.request;
+    span_job &span = ctx.spans[0];
+    detail::plan_single_span(request, 0, request.token_capacity, span);
+    emel::text::tokenizer::event::tokenize tokenize_ev = {};
+    tokenize_ev.vocab = request.vocab;
+    tokenize_ev.text = request.text;
+    tokenize_ev.add_special = request.add_special;
+    tokenize_ev.parse_special = request.parse_special;
+    tokenize_ev.token_ids_out = request.token_ids_out;
+    tokenize_ev.token_capacity = request.token_capacity;
+    tokenize_ev.token_count_out = &span.token_count;
+    tokenize_ev.error_out = &span.err;
+    span.accepted = span.lane->process_event(tokenize_ev) &&
+                    span.err == error_code(error::none);
+    ev.ctx.span_count = 1;
+  }
+};
+
+struct dispatch_serial_spans {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    const auto &request = ev.request;
+    const int32_t capacity =
+        request.token_capacity - ev.ctx.prefix_count - ev.ctx.suffix_count;
+    detail::plan_single_span(request, ev.ctx.prefix_count, capacity, ctx.spans[0]);
+    detail::encode_span(request, ctx.specials, ctx.spans[0]);
+    ev.ctx.span_count = 1;
+    ev.ctx.all_submitted = true;
+    ev.ctx.joined = true;
+  }
+};
+
+// Fork/join over contiguous spans of the document. Every span writes into its
+// own window of the output buffer (tokens never outnumber bytes), so workers
+// share no mutable state; commit_spans compacts the windows afterwards.
+struct dispatch_parallel_spans {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    const auto &request = ev.request;
+    const size_t span_count =
+        detail::planned_span_count(request.text.size(), request.lanes.size());
+    detail::plan_spans(request, span_count, ev.ctx.prefix_count, ctx.specials,
+                       ctx.spans);
+
+    lane_pool::join_group group{};
+    bool all_submitted = true;
+    const auto *request_ptr = &request;
+    const auto *specials_ptr = &ctx.specials;
+    for (size_t idx = 0; idx < span_count; ++idx) {
+      span_job *span_ptr = &ctx.spans[idx];
+      const bool submitted = ctx.pool->try_submit(
+          group, [request_ptr, specials_ptr, span_ptr]() noexcept {
+            detail::encode_span(*request_ptr, *specials_ptr, *span_ptr);
+          });
+      all_submitted = all_submitted && submitted;
+    }
+    ev.ctx.span_count = span_count;
+    ev.ctx.all_submitted = all_submitted;
+    ev.ctx.joined = group.wait();
+  }
+};
+
+// Every item runs on the batch lane inside this one action; the lane's own
+// machine makes the per-item decisions.
+struct dispatch_batch {
+  void operator()(const event::tokenize_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.item_index = 0;
+    ev.ctx.accepted = false;
+    ev.ctx.err = error_code(error::none);
+    ev.ctx.result = false;
+    detail::encode_batch(ev.request, ev.ctx);
+  }
+};
+
+struct commit_single_pass {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    ev.ctx.token_count = ctx.spans[0].token_count;
+    ev.ctx.err = error_code(error::none);
+    ev.ctx.result = true;
+  }
+};
+
+struct commit_spans {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    const auto &request = ev.request;
+    detail::compact_spans(request, ev.ctx, ctx.spans, ev.ctx.span_count);
+
+    int32_t sink = 0;
+    const std::array<int32_t *, 2> bos_targets = {&sink, request.token_ids_out};
+    *bos_targets[static_cast<size_t>(ev.ctx.prefix_count)] = request.vocab->bos_id;
+    const std::array<int32_t *, 2> eos_targets = {
+        &sink, request.token_ids_out + ev.ctx.token_count};
+    *eos_targets[static_cast<size_t>(ev.ctx.suffix_count)] = request.vocab->eos_id;
+
+    ev.ctx.token_count += ev.ctx.suffix_count;
+    ev.ctx.err = error_code(error::none);
+    ev.ctx.result = true;
+  }
+};
+
+struct commit_batch {
+  void operator()(const event::tokenize_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.ctx.err = error_code(error::none);
+    ev.ctx.result = true;
+  }
+};
+
+struct set_error_from_batch {
+  void operator()(const event::tokenize_batch_runtime &ev,
+                  context &) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.result = false;
+  }
+};
+
+struct set_error_from_spans {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &ctx) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.err = detail::first_span_error(ctx.spans, ev.ctx.span_count);
+    ev.ctx.result = false;
+  }
+};
+
+struct set_backend_error {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.err = error_code(error::backend_error);
+    ev.ctx.result = false;
+  }
+};
+
+struct set_invalid_request_error {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.err = error_code(error::invalid_request);
+    ev.ctx.result = false;
+  }
+};
+
+struct set_invalid_id_error {
+  void operator()(const event::tokenize_document_runtime &ev,
+                  context &) const noexcept {
+    ev.ctx.token_count = 0;
+    ev.ctx.err = error_code(error::model_invalid);
+    ev.ctx.result = false;
+  }
+};
+
+struct on_unexpected {
+  template <class event_type>
+  void operator()(const event_type &ev, context &) const noexcept {
+    if constexpr (requires { ev.ctx.err; }) {
+      ev.ctx.token_count = 0;
+      ev.ctx.err = error_code(error::invalid_request);
+      ev.ctx.result = false;
+    }
+  }
+};
+
+inline constexpr begin_document begin_document{};
+inline constexpr reject_invalid reject_invalid{};
+inline constexpr dispatch_single_pass dispatch_single_pass{};
+inline constexpr dispatch_serial_spans dispatch_serial_spans{};
+inline constexpr dispatch_parallel_spans dispatch_parallel_spans{};
+inline constexpr dispatch_batch dispatch_batch{};
+inline constexpr commit_single_pass commit_single_pass{};
+inline constexpr commit_spans commit_spans{};
+inline constexpr commit_batch commit_batch{};
+inline constexpr set_error_from_batch set_error_from_batch{};
+inline constexpr set_error_from_spans set_error_from_spans{};
+inline constexpr set_backend_error set_backend_error{};
+inline constexpr set_invalid_request_error set_invalid_request_error{};
+inline constexpr set_invalid_id_error set_invalid_id_error{};
+inline constexpr on_unexpected on_unexpected{};
+
+} // namespace emel::text::tokenizer::document::action
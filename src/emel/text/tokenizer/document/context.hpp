@@ -0,0 +1,37 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
+#include "emel/sm.hpp"
+#include "emel/text/tokenizer/document/events.hpp"
+#include "emel/text/tokenizer/errors.hpp"
+#include "emel/text/tokenizer/preprocessor/types.hpp"
+
+namespace emel::text::tokenizer::document::action {
+
+using lane_pool =
+    emel::policy::fork_join_lane_pool<event::k_max_lanes, 128u, 1048576u>;
+
+// One contiguous byte range of the document and the tokenizer lane that owns
+// it. Workers write only their own span slot and their own output window.
+struct span_job {
+  emel::text::tokenizer::sm *lane = nullptr;
+  size_t begin = 0;
+  size_t end = 0;
+  int32_t *tokens_out = nullptr;
+  int32_t token_capacity = 0;
+  int32_t token_count = 0;
+  int32_t err = error_code(error::none);
+  bool accepted = false;
+};
+
+struct context {
+  lane_pool *pool = nullptr;
+  emel::text::tokenizer::preprocessor::special_token_cache specials = {};
+  bool specials_ready = false;
+  std::array<span_job, event::k_max_lanes> spans = {};
+};
+
+} // namespace emel::text::tokenizer::document::action
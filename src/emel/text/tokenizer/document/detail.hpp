@@ -0,0 +1,268 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+#include "emel/text/tokenizer/bpe/split.hpp"
+#include "emel/text/tokenizer/document/context.hpp"
+#include "emel/text/tokenizer/document/events.hpp"
+#include "emel/text/tokenizer/events.hpp"
+#include "emel/text/tokenizer/preprocessor/types.hpp"
+#include "emel/text/tokenizer/sm.hpp"
+
+namespace emel::text::tokenizer::document::detail {
+
+// Upper bound on the bytes handed to one tokenize dispatch. BPE pre-tokenization
+// emits at least one byte per word and per special-token fragment, so a segment
+// of this size never exceeds the per-dispatch word or fragment budgets.
+inline constexpr size_t k_segment_bytes = 1024u;
+static_assert(k_segment_bytes <= emel::text::tokenizer::bpe::detail::k_max_bpe_words,
+              "document segment exceeds the split word budget");
+static_assert(k_segment_bytes <= emel::text::tokenizer::preprocessor::k_max_fragments,
+              "document segment exceeds the fragment budget");
+
+// Special tokens closer than this to a cut could be split by it or could strip
+// the whitespace that forms it.
+inline constexpr size_t k_cut_guard_bytes = 2u;
+
+inline bool ascii_non_whitespace(const std::string_view text,
+                                 const size_t pos) noexcept {
+  return emel::text::tokenizer::bpe::detail::ascii_non_whitespace(text[pos]);
+}
+
+// A single space between two ASCII non-whitespace bytes always starts a new
+// pre-token in every BPE split profile, so the cut goes before the space.
+inline bool is_lone_space_cut(const std::string_view text,
+                              const size_t pos) noexcept {
+  return pos >= 1u && pos + 1u < text.size() && text[pos] == ' ' &&
+         ascii_non_whitespace(text, pos - 1u) &&
+         ascii_non_whitespace(text, pos + 1u);
+}
+
+// A single '\n' between two ASCII non-whitespace bytes always ends a pre-token,
+// so the cut goes after the newline.
+inline bool is_lone_newline_cut(const std::string_view text,
+                                const size_t pos) noexcept {
+  return emel::text::tokenizer::bpe::detail::is_safe_split_cut(text, pos);
+}
+
+inline bool special_token_near_cut(
+    const std::string_view text, const size_t pos,
+    const emel::text::tokenizer::preprocessor::special_token &token) noexcept {
+  const size_t reach = k_cut_guard_bytes + token.text.size();
+  const size_t window_begin = pos - std::min(pos, reach);
+  const size_t window_end = std::min(text.size(), pos + reach);
+  const std::string_view window =
+      text.substr(window_begin, window_end - window_begin);
+  return !token.text.empty() &&
+         window.find(token.text) != std::string_view::npos;
+}
+
+inline bool special_tokens_near_cut(
+    const std::string_view text, const size_t pos,
+    const emel::text::tokenizer::preprocessor::special_token_cache &specials) noexcept {
+  bool near = false;
+  for (size_t idx = 0; idx < specials.count; ++idx) {
+    near = near || special_token_near_cut(text, pos, specials.tokens[idx]);
+  }
+  return near;
+}
+
+// A cut is safe when serial tokenization already ends a pre-token there and no
+// special token (or its lstrip/rstrip whitespace) reaches across it. Tokenizing
+// both sides independently then yields exactly the serial token stream.
+inline bool is_safe_cut(
+    const std::string_view text, const size_t pos,
+    const emel::text::tokenizer::preprocessor::special_token_cache &specials) noexcept {
+  return (is_lone_space_cut(text, pos) || is_lone_newline_cut(text, pos)) &&
+         !special_tokens_near_cut(text, pos, specials);
+}
+
+inline size_t next_safe_cut(
+    const std::string_view text, const size_t from, const size_t end,
+    const emel::text::tokenizer::preprocessor::special_token_cache &specials) noexcept {
+  size_t pos = from;
+  while (pos < end && !is_safe_cut(text, pos, specials)) {
+    ++pos;
+  }
+  return pos;
+}
+
+// Ends the segment at the last safe cut inside the byte budget. When the budget
+// holds no cut, the segment runs on to the first cut after it.
+inline size_t segment_end(
+    const std::string_view text, const size_t begin, const size_t end,
+    const emel::text::tokenizer::preprocessor::special_token_cache &specials) noexcept {
+  const size_t limit = begin + std::min(end - begin, k_segment_bytes);
+  size_t cut = limit;
+  while (cut > begin && cut < end && !is_safe_cut(text, cut, specials)) {
+    --cut;
+  }
+  const bool found_back = cut > begin;
+  size_t forward = limit;
+  while (!found_back && forward < end && !is_safe_cut(text, forward, specials)) {
+    ++forward;
+  }
+  const std::array<size_t, 2> ends = {forward, cut};
+  return ends[static_cast<size_t>(found_back)];
+}
+
+inline size_t planned_span_count(const size_t text_size,
+                                 const size_t lane_count) noexcept {
+  const size_t segments = (text_size + k_segment_bytes - 1u) / k_segment_bytes;
+  return std::max<size_t>(1u, std::min(segments, lane_count));
+}
+
+// Splits [0, text.size()) into `span_count` contiguous spans whose inner
+// boundaries sit on safe cuts near equal byte offsets. Trailing spans may be
+// empty when the document has too few cuts.
+inline void plan_spans(
+    const event::tokenize_document &request, const size_t span_count,
+    const int32_t prefix_count,
+    const emel::text::tokenizer::preprocessor::special_token_cache &specials,
+    std::array<action::span_job, event::k_max_lanes> &spans) noexcept {
+  const std::string_view text = request.text;
+  size_t begin = 0;
+  for (size_t idx = 0; idx < span_count; ++idx) {
+    const size_t target = (text.size() * (idx + 1u)) / span_count;
+    const size_t from = std::min(text.size(), std::max(target, begin + 1u));
+    const size_t end = next_safe_cut(text, from, text.size(), specials);
+    action::span_job &span = spans[idx];
+    span.lane = request.lanes[idx];
+    span.begin = begin;
+    span.end = end;
+    span.tokens_out = request.token_ids_out + prefix_count + begin;
+    span.token_capacity = static_cast<int32_t>(end - begin);
+    span.token_count = 0;
+    span.err = error_code(error::none);
+    span.accepted = false;
+    begin = end;
+  }
+}
+
+inline void plan_single_span(const event::tokenize_document &request,
+                             const int32_t prefix_count,
+                             const int32_t token_capacity,
+                             action::span_job &span) noexcept {
+  span.lane = request.lanes[0];
+  span.begin = 0;
+  span.end = request.text.size();
+  span.tokens_out = request.token_ids_out + prefix_count;
+  span.token_capacity = token_capacity;
+  span.token_count = 0;
+  span.err = error_code(error::none);
+  span.accepted = false;
+}
+
+// Walks one span segment by segment on its lane. After the first rejected
+// segment the remaining ones are dispatched empty, which keeps the walk
+// monotonic while leaving the first error in place.
+inline void encode_span(
+    const event::tokenize_document &request,
+    const emel::text::tokenizer::preprocessor::special_token_cache &specials,
+    action::span_job &span) noexcept {
+  bool ok = true;
+  int32_t err = error_code(error::none);
+  int32_t produced = 0;
+  size_t pos = span.begin;
+  while (pos < span.end) {
+    const size_t next = segment_end(request.text, pos, span.end, specials);
+    int32_t count = 0;
+    int32_t segment_err = error_code(error::none);
+    emel::text::tokenizer::event::tokenize segment = {};
+    segment.vocab = request.vocab;
+    segment.text = request.text.substr(pos, (next - pos) * static_cast<size_t>(ok));
+    segment.add_special = false;
+    segment.parse_special = request.parse_special;
+    segment.token_ids_out = span.tokens_out + produced;
+    segment.token_capacity = span.token_capacity - produced;
+    segment.token_count_out = &count;
+    segment.error_out = &segment_err;
+    const bool accepted = span.lane->process_event(segment) &&
+                          segment_err == error_code(error::none);
+    const std::array<int32_t, 2> errors = {
+        emel::text::tokenizer::detail::select_error_code(false, segment_err), err};
+    err = errors[static_cast<size_t>(!ok || accepted)];
+    produced += count * static_cast<int32_t>(ok && accepted);
+    ok = ok && accepted;
+    pos = next;
+  }
+  span.token_count = produced;
+  span.err = err;
+  span.accepted = ok;
+}
+
+// Runs every batch item on the lane, packing the ids back to back. Items after
+// the first rejected one are dispatched empty and report a zero count, so the
+// walk stays monotonic and the first failing index is kept.
+inline void encode_batch(const event::tokenize_batch &request,
+                         event::tokenize_batch_ctx &ctx) noexcept {
+  bool ok = true;
+  int32_t err = error_code(error::none);
+  int32_t produced = 0;
+  size_t failed_index = 0;
+  const size_t item_count = request.texts.size();
+  for (size_t idx = 0; idx < item_count; ++idx) {
+    const std::string_view text = request.texts[idx];
+    int32_t count = 0;
+    int32_t item_err = error_code(error::none);
+    emel::text::tokenizer::event::tokenize item = {};
+    item.vocab = request.vocab;
+    item.text = text.substr(0, text.size() * static_cast<size_t>(ok));
+    item.add_special = request.add_special;
+    item.parse_special = request.parse_special;
+    item.token_ids_out = request.token_ids_out + produced;
+    item.token_capacity = request.token_capacity - produced;
+    item.token_count_out = &count;
+    item.error_out = &item_err;
+    const bool accepted = request.lane->process_event(item) &&
+                          item_err == error_code(error::none);
+    const bool keep = !ok || accepted;
+    const std::array<int32_t, 2> errors = {
+        emel::text::tokenizer::detail::select_error_code(false, item_err), err};
+    err = errors[static_cast<size_t>(keep)];
+    const std::array<size_t, 2> indices = {idx, failed_index};
+    failed_index = indices[static_cast<size_t>(keep)];
+    ok = ok && accepted;
+    const int32_t committed = count * static_cast<int32_t>(ok);
+    request.token_counts_out[idx] = committed;
+    produced += committed;
+  }
+  ctx.token_count = produced;
+  ctx.item_index = failed_index;
+  ctx.accepted = ok;
+  ctx.err = err;
+}
+
+inline void compact_spans(const event::tokenize_document &request,
+                          event::tokenize_document_ctx &ctx,
+                          const std::array<action::span_job, event::k_max_lanes> &spans,
+                          const size_t span_count) noexcept {
+  int32_t cursor = ctx.prefix_count;
+  for (size_t idx = 0; idx < span_count; ++idx) {
+    const action::span_job &span = spans[idx];
+    // Spans only move toward the front of the buffer, so a forward copy is
+    // safe even when the source and destination windows overlap.
+    std::copy(span.tokens_out, span.tokens_out + span.token_count,
+              request.token_ids_out + cursor);
+    cursor += span.token_count;
+  }
+  ctx.token_count = cursor;
+}
+
+inline int32_t first_span_error(
+    const std::array<action::span_job, event::k_max_lanes> &spans,
+    const size_t span_count) noexcept {
+  int32_t err = error_code(error::none);
+  for (size_t idx = 0; idx < span_count; ++idx) {
+    const bool keep = err != error_code(error::none);
+    const std::array<int32_t, 2> errors = {spans[idx].err, err};
+    err = errors[static_cast<size_t>(keep)];
+  }
+  return emel::text::tokenizer::detail::select_error_code(false, err);
+}
+
+} // namespace emel::text::tokenizer::document::detail
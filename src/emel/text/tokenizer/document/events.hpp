@@ -0,0 +1,122 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "emel/model/data.hpp"
+#include "emel/text/tokenizer/errors.hpp"
+
+namespace emel::text::tokenizer {
+struct sm;
+} // namespace emel::text::tokenizer
+
+namespace emel::text::tokenizer::document::events {
+struct document_done;
+struct document_error;
+struct batch_done;
+struct batch_error;
+} // namespace emel::text::tokenizer::document::events
+
+namespace emel::text::tokenizer::document::event {
+
+inline constexpr size_t k_max_lanes = 8u;
+
+// Tokenizes a whole document through caller-owned tokenizer lanes. Every lane
+// must already be bound to `vocab`; lanes are dispatched as independent actors,
+// so a lane must not appear twice when a lane pool is attached.
+struct tokenize_document {
+  const emel::model::data::vocab *vocab = nullptr;
+  std::string_view text = {};
+  bool add_special = false;
+  bool parse_special = false;
+  std::span<emel::text::tokenizer::sm *const> lanes = {};
+  int32_t *token_ids_out = nullptr;
+  int32_t token_capacity = 0;
+  int32_t *token_count_out = nullptr;
+  int32_t *error_out = nullptr;
+  void *owner_sm = nullptr;
+  bool (*dispatch_done)(void *owner_sm,
+                        const events::document_done &) = nullptr;
+  bool (*dispatch_error)(void *owner_sm,
+                         const events::document_error &) = nullptr;
+};
+
+struct tokenize_document_ctx {
+  int32_t prefix_count = 0;
+  int32_t suffix_count = 0;
+  int32_t token_count = 0;
+  size_t span_count = 0;
+  bool all_submitted = false;
+  bool joined = false;
+  int32_t err = error_code(error::none);
+  bool result = false;
+};
+
+struct tokenize_document_runtime {
+  const tokenize_document &request;
+  tokenize_document_ctx &ctx;
+};
+
+// Tokenizes every text through one caller-owned lane, bound to `vocab`, in a
+// single dispatch. Token ids are packed back to back in `token_ids_out` and
+// `token_counts_out[i]` receives the count for `texts[i]`; each item matches a
+// standalone tokenize with the same flags.
+struct tokenize_batch {
+  const emel::model::data::vocab *vocab = nullptr;
+  std::span<const std::string_view> texts = {};
+  bool add_special = false;
+  bool parse_special = false;
+  emel::text::tokenizer::sm *lane = nullptr;
+  int32_t *token_ids_out = nullptr;
+  int32_t token_capacity = 0;
+  int32_t *token_counts_out = nullptr;
+  int32_t *token_count_out = nullptr;
+  int32_t *error_out = nullptr;
+  void *owner_sm = nullptr;
+  bool (*dispatch_done)(void *owner_sm, const events::batch_done &) = nullptr;
+  bool (*dispatch_error)(void *owner_sm, const events::batch_error &) = nullptr;
+};
+
+struct tokenize_batch_ctx {
+  int32_t token_count = 0;
+  size_t item_index = 0;
+  bool accepted = false;
+  int32_t err = error_code(error::none);
+  bool result = false;
+};
+
+struct tokenize_batch_runtime {
+  const tokenize_batch &request;
+  tokenize_batch_ctx &ctx;
+};
+
+} // namespace emel::text::tokenizer::document::event
+
+namespace emel::text::tokenizer::document::events {
+
+struct document_done {
+  const event::tokenize_document *request = nullptr;
+  int32_t token_count = 0;
+  int32_t span_count = 0;
+};
+
+struct document_error {
+  const event::tokenize_document *request = nullptr;
+  int32_t err = 0;
+};
+
+struct batch_done {
+  const event::tokenize_batch *request = nullptr;
+  int32_t token_count = 0;
+  size_t item_count = 0;
+};
+
+struct batch_error {
+  const event::tokenize_batch *request = nullptr;
+  int32_t err = 0;
+  size_t item_index = 0;
+};
+
+} // namespace emel::text::tokenizer::document::events
@@ -0,0 +1,201 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+#include "emel/text/tokenizer/document/context.hpp"
+#include "emel/text/tokenizer/document/detail.hpp"
+#include "emel/text/tokenizer/document/events.hpp"
+#include "emel/text/tokenizer/errors.hpp"
+
+namespace emel::text::tokenizer::document::guard {
+
+namespace detail {
+
+inline bool lanes_present(const event::tokenize_document &ev) noexcept {
+  bool present = ev.lanes.size() > 0u && ev.lanes.size() <= event::k_max_lanes;
+  for (const auto *lane : ev.lanes) {
+    present = present && lane != nullptr;
+  }
+  return present;
+}
+
+// Parallel spans require one tokenizer actor per span: concurrent
+// process_event on a shared lane would break the RTC single-writer contract.
+inline bool lanes_distinct(const event::tokenize_document &ev) noexcept {
+  const size_t lane_count = ev.lanes.size();
+  for (size_t i = 0u; i < lane_count; ++i) {
+    for (size_t j = i + 1u; j < lane_count; ++j) {
+      if (ev.lanes[i] == ev.lanes[j]) {
+        return false;
+      }
+    }
+  }
+  return true;
+}
+
+// Only the named BPE split profiles have cut rules that are proven to preserve
+// the serial token stream; vocabs that resolve to the fallback regex profile and
+// other tokenizer models take the document in one pass.
+inline bool segmentable(const event::tokenize_document &ev,
+                        const action::context &ctx) noexcept {
+  namespace bpe_split = emel::text::tokenizer::bpe::detail;
+  return ev.vocab->tokenizer_model_id == emel::model::data::tokenizer_model::BPE &&
+         bpe_split::split_profile_for(ev.vocab->tokenizer_pre_id) !=
+             bpe_split::split_profile::default_profile &&
+         ev.text.size() > document::detail::k_segment_bytes && ctx.specials_ready;
+}
+
+inline int32_t segment_capacity(const event::tokenize_document_runtime &ev) noexcept {
+  return ev.request.token_capacity - ev.ctx.prefix_count - ev.ctx.suffix_count;
+}
+
+inline bool bos_id_invalid(const event::tokenize_document_runtime &ev) noexcept {
+  return ev.ctx.prefix_count > 0 && ev.request.vocab->bos_id < 0;
+}
+
+inline bool eos_id_invalid(const event::tokenize_document_runtime &ev) noexcept {
+  return ev.ctx.suffix_count > 0 && ev.request.vocab->eos_id < 0;
+}
+
+inline bool parallel_ready(const event::tokenize_document_runtime &ev,
+                           const action::context &ctx) noexcept {
+  const size_t required = static_cast<size_t>(ev.ctx.prefix_count) +
+                          static_cast<size_t>(ev.ctx.suffix_count) +
+                          ev.request.text.size();
+  return ctx.pool != nullptr && ev.request.lanes.size() > 1u &&
+         static_cast<size_t>(ev.request.token_capacity) >= required &&
+         lanes_distinct(ev.request);
+}
+
+inline bool spans_accepted(const action::context &ctx,
+                           const size_t span_count) noexcept {
+  bool accepted = true;
+  for (size_t idx = 0; idx < span_count; ++idx) {
+    accepted = accepted && ctx.spans[idx].accepted;
+  }
+  return accepted;
+}
+
+} // namespace detail
+
+struct valid_request {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &) const noexcept {
+    const auto &request = ev.request;
+    return request.vocab != nullptr && request.token_ids_out != nullptr &&
+           request.token_count_out != nullptr && request.token_capacity > 0 &&
+           detail::lanes_present(request);
+  }
+};
+
+struct single_pass {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return !detail::segmentable(ev.request, ctx);
+  }
+};
+
+struct segmented_special_id_invalid {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return detail::segmentable(ev.request, ctx) &&
+           (detail::bos_id_invalid(ev) || detail::eos_id_invalid(ev));
+  }
+};
+
+struct segmented_no_capacity {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return detail::segmentable(ev.request, ctx) && !detail::bos_id_invalid(ev) &&
+           !detail::eos_id_invalid(ev) && detail::segment_capacity(ev) <= 0;
+  }
+};
+
+struct segmented_parallel {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return detail::segmentable(ev.request, ctx) && !detail::bos_id_invalid(ev) &&
+           !detail::eos_id_invalid(ev) && detail::segment_capacity(ev) > 0 &&
+           detail::parallel_ready(ev, ctx);
+  }
+};
+
+struct segmented_serial {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return detail::segmentable(ev.request, ctx) && !detail::bos_id_invalid(ev) &&
+           !detail::eos_id_invalid(ev) && detail::segment_capacity(ev) > 0 &&
+           !detail::parallel_ready(ev, ctx);
+  }
+};
+
+struct single_pass_accepted {
+  bool operator()(const event::tokenize_document_runtime &,
+                  const action::context &ctx) const noexcept {
+    return ctx.spans[0].accepted;
+  }
+};
+
+struct single_pass_rejected {
+  bool operator()(const event::tokenize_document_runtime &,
+                  const action::context &ctx) const noexcept {
+    return !ctx.spans[0].accepted;
+  }
+};
+
+struct spans_submission_failed {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &) const noexcept {
+    return !ev.ctx.all_submitted || !ev.ctx.joined;
+  }
+};
+
+struct spans_rejected {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return ev.ctx.all_submitted && ev.ctx.joined &&
+           !detail::spans_accepted(ctx, ev.ctx.span_count);
+  }
+};
+
+struct spans_accepted {
+  bool operator()(const event::tokenize_document_runtime &ev,
+                  const action::context &ctx) const noexcept {
+    return ev.ctx.all_submitted && ev.ctx.joined &&
+           detail::spans_accepted(ctx, ev.ctx.span_count);
+  }
+};
+
+struct valid_batch {
+  bool operator()(const event::tokenize_batch_runtime &ev,
+                  const action::context &) const noexcept {
+    const auto &request = ev.request;
+    return request.vocab != nullptr && request.lane != nullptr &&
+           !request.texts.empty() && request.token_ids_out != nullptr &&
+           request.token_counts_out != nullptr && request.token_capacity > 0;
+  }
+};
+
+struct batch_empty {
+  bool operator()(const event::tokenize_batch_runtime &ev,
+                  const action::context &) const noexcept {
+    return ev.request.texts.empty();
+  }
+};
+
+struct batch_accepted {
+  bool operator()(const event::tokenize_batch_runtime &ev,
+                  const action::context &) const noexcept {
+    return ev.ctx.accepted;
+  }
+};
+
+struct batch_rejected {
+  bool operator()(const event::tokenize_batch_runtime &ev,
+                  const action::context &) const noexcept {
+    return !ev.ctx.accepted;
+  }
+};
+
+} // namespace emel::text::tokenizer::document::guard
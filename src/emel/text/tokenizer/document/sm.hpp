@@ -0,0 +1,287 @@
+#pragma once
+// benchmark: designed
+
+#include <cstdint>
+
+#include "emel/sm.hpp"
+#include "emel/text/tokenizer/detail.hpp"
+#include "emel/text/tokenizer/document/actions.hpp"
+#include "emel/text/tokenizer/document/guards.hpp"
+
+namespace emel::text::tokenizer::document {
+
+// Public alias for the lane pool the parallel constructor takes, so callers can
+// name it without reaching into the action namespace.
+using lane_pool = action::lane_pool;
+
+struct idle {};
+struct route_decision {};
+struct single_pass_decision {};
+struct span_decision {};
+struct batch_decision {};
+struct done {};
+struct errored {};
+struct unexpected {};
+
+struct model {
+  auto operator()() const {
+    namespace sml = stateforward::sml;
+
+    // clang-format off
+    return sml::make_transition_table(
+      //------------------------------------------------------------------------------//
+      // External request validation.
+        sml::state<route_decision> <= *sml::state<idle>
+                   + sml::event<event::tokenize_document_runtime>[ guard::valid_request{} ]
+                   / action::begin_document
+      , sml::state<errored> <= sml::state<idle> + sml::event<event::tokenize_document_runtime>
+                   / action::reject_invalid
+
+      , sml::state<route_decision> <= sml::state<done>
+                   + sml::event<event::tokenize_document_runtime>[ guard::valid_request{} ]
+                   / action::begin_document
+      , sml::state<errored> <= sml::state<done> + sml::event<event::tokenize_document_runtime>
+                   / action::reject_invalid
+
+      , sml::state<route_decision> <= sml::state<errored>
+                   + sml::event<event::tokenize_document_runtime>[ guard::valid_request{} ]
+                   / action::begin_document
+      , sml::state<errored> <= sml::state<errored> + sml::event<event::tokenize_document_runtime>
+                   / action::reject_invalid
+
+      , sml::state<route_decision> <= sml::state<unexpected>
+                   + sml::event<event::tokenize_document_runtime>[ guard::valid_request{} ]
+                   / action::begin_document
+      , sml::state<unexpected> <= sml::state<unexpected>
+                   + sml::event<event::tokenize_document_runtime>
+                   / action::reject_invalid
+
+      //------------------------------------------------------------------------------//
+      // Batch validation; every item runs inside dispatch_batch.
+      , sml::state<batch_decision> <= sml::state<idle>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::valid_batch{} ]
+                   / action::dispatch_batch
+      , sml::state<errored> <= sml::state<idle>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::batch_empty{} ]
+                   / action::reject_invalid
+      , sml::state<errored> <= sml::state<idle> + sml::event<event::tokenize_batch_runtime>
+                   / action::reject_invalid
+
+      , sml::state<batch_decision> <= sml::state<done>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::valid_batch{} ]
+                   / action::dispatch_batch
+      , sml::state<errored> <= sml::state<done>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::batch_empty{} ]
+                   / action::reject_invalid
+      , sml::state<errored> <= sml::state<done> + sml::event<event::tokenize_batch_runtime>
+                   / action::reject_invalid
+
+      , sml::state<batch_decision> <= sml::state<errored>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::valid_batch{} ]
+                   / action::dispatch_batch
+      , sml::state<errored> <= sml::state<errored>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::batch_empty{} ]
+                   / action::reject_invalid
+      , sml::state<errored> <= sml::state<errored> + sml::event<event::tokenize_batch_runtime>
+                   / action::reject_invalid
+
+      , sml::state<batch_decision> <= sml::state<unexpected>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::valid_batch{} ]
+                   / action::dispatch_batch
+      , sml::state<unexpected> <= sml::state<unexpected>
+                   + sml::event<event::tokenize_batch_runtime>[ guard::batch_empty{} ]
+                   / action::reject_invalid
+      , sml::state<unexpected> <= sml::state<unexpected> + sml::event<event::tokenize_batch_runtime>
+                   / action::reject_invalid
+
+      //------------------------------------------------------------------------------//
+      // Routing: one pass, serial segments on lane 0, or parallel spans.
+      , sml::state<single_pass_decision> <= sml::state<route_decision>
+                   + sml::completion<event::tokenize_document_runtime>[ guard::single_pass{} ]
+                   / action::dispatch_single_pass
+      , sml::state<errored> <= sml::state<route_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::segmented_special_id_invalid{} ]
+                   / action::set_invalid_id_error
+      , sml::state<errored> <= sml::state<route_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::segmented_no_capacity{} ]
+                   / action::set_invalid_request_error
+      , sml::state<span_decision> <= sml::state<route_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::segmented_parallel{} ]
+                   / action::dispatch_parallel_spans
+      , sml::state<span_decision> <= sml::state<route_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::segmented_serial{} ]
+                   / action::dispatch_serial_spans
+
+      //------------------------------------------------------------------------------//
+      // Outcomes.
+      , sml::state<done> <= sml::state<single_pass_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::single_pass_accepted{} ]
+                   / action::commit_single_pass
+      , sml::state<errored> <= sml::state<single_pass_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::single_pass_rejected{} ]
+                   / action::set_error_from_spans
+
+      , sml::state<errored> <= sml::state<span_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::spans_submission_failed{} ]
+                   / action::set_backend_error
+      , sml::state<errored> <= sml::state<span_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::spans_rejected{} ]
+                   / action::set_error_from_spans
+      , sml::state<done> <= sml::state<span_decision>
+                   + sml::completion<event::tokenize_document_runtime>
+                     [ guard::spans_accepted{} ]
+                   / action::commit_spans
+
+      , sml::state<done> <= sml::state<batch_decision>
+                   + sml::completion<event::tokenize_batch_runtime>[ guard::batch_accepted{} ]
+                   / action::commit_batch
+      , sml::state<errored> <= sml::state<batch_decision>
+                   + sml::completion<event::tokenize_batch_runtime>[ guard::batch_rejected{} ]
+                   / action::set_error_from_batch
+
+      //------------------------------------------------------------------------------//
+      // Unexpected events.
+      , sml::state<unexpected> <= sml::state<idle> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<route_decision> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<single_pass_decision>
+                   + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<span_decision> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<batch_decision> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<done> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<errored> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+      , sml::state<unexpected> <= sml::state<unexpected> + sml::unexpected_event<sml::_>
+                   / action::on_unexpected
+    );
+    // clang-format on
+  }
+};
+
+namespace detail {
+
+inline void dispatch_document_done(const event::tokenize_document &request,
+                                   const events::document_done &done_ev,
+                                   const events::document_error &) noexcept {
+  emel::text::tokenizer::detail::dispatch_optional_callback(
+      request.owner_sm, request.dispatch_done, done_ev);
+}
+
+inline void
+dispatch_document_error(const event::tokenize_document &request,
+                        const events::document_done &,
+                        const events::document_error &error_ev) noexcept {
+  emel::text::tokenizer::detail::dispatch_optional_callback(
+      request.owner_sm, request.dispatch_error, error_ev);
+}
+
+inline void dispatch_batch_done(const event::tokenize_batch &request,
+                                const events::batch_done &done_ev,
+                                const events::batch_error &) noexcept {
+  emel::text::tokenizer::detail::dispatch_optional_callback(
+      request.owner_sm, request.dispatch_done, done_ev);
+}
+
+inline void dispatch_batch_error(const event::tokenize_batch &request,
+                                 const events::batch_done &,
+                                 const events::batch_error &error_ev) noexcept {
+  emel::text::tokenizer::detail::dispatch_optional_callback(
+      request.owner_sm, request.dispatch_error, error_ev);
+}
+
+} // namespace detail
+
+// Document-scale tokenization over caller-owned tokenizer lanes. Without a lane
+// pool every segment runs on lane 0; with one, spans fork across the pool and
+// join before the result is committed, inside a single RTC chain. Batches of
+// short texts run item by item on one lane in the same way.
+struct sm : public emel::sm<model, action::context> {
+  using base_type = emel::sm<model, action::context>;
+
+  sm() = default;
+  explicit sm(lane_pool &pool) : base_type(action::context{.pool = &pool}) {}
+
+  bool process_event(const event::tokenize_document &ev) {
+    namespace sml = stateforward::sml;
+
+    event::tokenize_document_ctx runtime_ctx{};
+    event::tokenize_document_runtime runtime_ev{ev, runtime_ctx};
+    const bool accepted = base_type::process_event(runtime_ev);
+    const bool ok = this->is(sml::state<done>);
+    const int32_t err =
+        emel::text::tokenizer::detail::select_error_code(ok, runtime_ctx.err);
+    last_error_ = err;
+    token_count_ = runtime_ctx.token_count;
+    span_count_ = static_cast<int32_t>(runtime_ctx.span_count);
+
+    int32_t token_count_sink = 0;
+    emel::text::tokenizer::detail::write_optional(
+        ev.token_count_out, token_count_sink, runtime_ctx.token_count);
+    int32_t error_sink = error_code(error::none);
+    emel::text::tokenizer::detail::write_optional(ev.error_out, error_sink, err);
+
+    const events::document_done done_ev{&ev, runtime_ctx.token_count, span_count_};
+    const events::document_error error_ev{&ev, err};
+    emel::text::tokenizer::detail::dispatch_result_callback(
+        ok, ev, done_ev, error_ev, detail::dispatch_document_done,
+        detail::dispatch_document_error);
+
+    return accepted && ok;
+  }
+
+  bool process_event(const event::tokenize_batch &ev) {
+    namespace sml = stateforward::sml;
+
+    event::tokenize_batch_ctx runtime_ctx{};
+    event::tokenize_batch_runtime runtime_ev{ev, runtime_ctx};
+    const bool accepted = base_type::process_event(runtime_ev);
+    const bool ok = this->is(sml::state<done>);
+    const int32_t err =
+        emel::text::tokenizer::detail::select_error_code(ok, runtime_ctx.err);
+    last_error_ = err;
+    token_count_ = runtime_ctx.token_count;
+    span_count_ = 0;
+
+    int32_t token_count_sink = 0;
+    emel::text::tokenizer::detail::write_optional(
+        ev.token_count_out, token_count_sink, runtime_ctx.token_count);
+    int32_t error_sink = error_code(error::none);
+    emel::text::tokenizer::detail::write_optional(ev.error_out, error_sink, err);
+
+    const events::batch_done done_ev{&ev, runtime_ctx.token_count, ev.texts.size()};
+    const events::batch_error error_ev{&ev, err, runtime_ctx.item_index};
+    emel::text::tokenizer::detail::dispatch_result_callback(
+        ok, ev, done_ev, error_ev, detail::dispatch_batch_done,
+        detail::dispatch_batch_error);
+
+    return accepted && ok;
+  }
+
+  using base_type::is;
+  using base_type::process_event;
+  using base_type::visit_current_states;
+
+  int32_t last_error() const noexcept { return last_error_; }
+  int32_t token_count() const noexcept { return token_count_; }
+  int32_t span_count() const noexcept { return span_count_; }
+
+private:
+  int32_t last_error_ = error_code(error::none);
+  int32_t token_count_ = 0;
+  int32_t span_count_ = 0;
+};
+
+} // namespace emel::text::tokenizer::document
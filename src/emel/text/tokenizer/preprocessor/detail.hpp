@@ -305,7 +305,7 @@ inline std::string_view token_text(const emel::model::data::vocab & vocab,
 
 inline bool flag_set(
     const emel::model::data::vocab & vocab,
-    const std::array<uint8_t, emel::model::data::vocab::k_attr_flag_bytes> & flags,
+    const emel::model::data::vocab::attr_flags & flags,
     const uint32_t id) noexcept {
   const bool id_valid = id < vocab.n_tokens;
   const uint32_t safe_id = static_cast<uint32_t>(select_size(id_valid, id, 0u));
@@ -0,0 +1,304 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <span>
+#include <string_view>
+
+#include "emel/clock.hpp"
+
+#if !defined(EMEL_TRACE)
+#define EMEL_TRACE 0
+#endif
+
+// Timeline tracing: timestamped begin/end records of state-machine dispatches,
+// kernel ops, matmul lane fork/join, window slot loads and decode wavefront
+// lanes, exported as Chrome trace JSON (chrome://tracing, ui.perfetto.dev).
+//
+// Compiled out unless EMEL_TRACE=1 (CMake option EMEL_ENABLE_TRACE): span is
+// empty and the hooks touch no trace state. Compiled in, nothing is recorded
+// until the owner starts a session with its clock (emel/clock.hpp) and its
+// ring storage. Each recording thread claims one ring on its
+// first record and is that ring's only writer, so a record is one clock read,
+// a plain slot store and a release bump of the ring's count: no locks and no
+// allocation. A full ring overwrites its oldest records; threads beyond the
+// ring count are counted in dropped_threads and go unrecorded.
+//
+// Stop the session and let the traced threads go idle (request returned, lane
+// pools parked) before exporting: export does not synchronize with writers
+// still inside a span.
+namespace emel::trace {
+
+inline constexpr bool k_enabled = EMEL_TRACE != 0;
+
+using emel::clock_fn;
+
+enum class category : uint8_t {
+  sm = 0,      // emel::sm / co_sm process_event: model name, event as detail
+  kernel = 1,  // one kernel op dispatch
+  lane = 2,    // lane pool fork/join: matmul lanes, wavefront lanes
+  io = 3,      // tensor window slot loads
+  count = 4,
+};
+
+enum class phase : uint8_t {
+  begin = 0,
+  end = 1,
+  instant = 2,
+};
+
+// Names point at static storage (literals, op names, type names); records
+// keep the pointer, never a copy.
+struct record {
+  uint64_t ts_ns = 0u;
+  const char *name = nullptr;
+  const char *detail = nullptr;
+  uint32_t name_size = 0u;
+  uint32_t detail_size = 0u;
+  category cat = category::sm;
+  phase ph = phase::begin;
+};
+
+inline constexpr uint32_t k_ring_capacity = 1u << 16u;
+
+struct ring {
+  std::atomic<uint64_t> written = 0u;
+  std::array<record, k_ring_capacity> records = {};
+};
+
+struct session {
+  clock_fn clock = nullptr;
+  std::span<ring> rings = {};
+  uint64_t origin_ns = 0u;
+  uint64_t generation = 0u;
+  std::atomic<uint32_t> claimed = 0u;
+  std::atomic<uint64_t> dropped_threads = 0u;
+};
+
+inline std::string_view category_name(const category cat) noexcept {
+  switch (cat) {
+  case category::sm:
+    return "sm";
+  case category::kernel:
+    return "kernel";
+  case category::lane:
+    return "lane";
+  case category::io:
+    return "io";
+  case category::count:
+    break;
+  }
+  return "unknown";
+}
+
+// Readable name of `type` from the compiler's function signature, in static
+// storage: the sm hooks label their spans with the model and event types.
+template <class type>
+constexpr std::string_view type_name() noexcept {
+#if defined(__clang__) || defined(__GNUC__)
+  constexpr std::string_view signature = __PRETTY_FUNCTION__;
+  constexpr std::string_view marker = "type = ";
+  constexpr size_t first = signature.find(marker) + marker.size();
+  constexpr size_t last = signature.find_first_of(";]", first);
+#else
+  constexpr std::string_view signature = __FUNCSIG__;
+  constexpr std::string_view marker = "type_name<";
+  constexpr size_t first = signature.find(marker) + marker.size();
+  constexpr size_t last = signature.rfind(">(");
+#endif
+  return signature.substr(first, last - first);
+}
+
+template <class type>
+inline constexpr std::string_view type_name_v = type_name<type>();
+
+namespace detail {
+
+inline std::atomic<session *> active_session = nullptr;
+inline std::atomic<uint64_t> session_generation = 0u;
+
+struct thread_claim {
+  uint64_t generation = 0u;
+  ring *claimed = nullptr;
+};
+
+inline thread_local thread_claim local_claim = {};
+
+inline ring *claim_ring(session &trace) noexcept {
+  if (local_claim.generation == trace.generation) {
+    return local_claim.claimed;
+  }
+  const uint32_t index = trace.claimed.fetch_add(1u, std::memory_order_relaxed);
+  ring *claimed = index < trace.rings.size() ? &trace.rings[index] : nullptr;
+  if (claimed == nullptr) {
+    trace.dropped_threads.fetch_add(1u, std::memory_order_relaxed);
+  }
+  local_claim = thread_claim{.generation = trace.generation, .claimed = claimed};
+  return claimed;
+}
+
+inline void append(ring &into, const record &entry) noexcept {
+  const uint64_t slot = into.written.load(std::memory_order_relaxed);
+  into.records[slot % k_ring_capacity] = entry;
+  into.written.store(slot + 1u, std::memory_order_release);
+}
+
+}  // namespace detail
+
+// Records one entry on the calling thread's ring of `trace`. The hooks below
+// go through the active session; this is the layer they share.
+inline void emit(session &trace, const phase ph, const category cat,
+                 const std::string_view name,
+                 const std::string_view detail_name = {}) noexcept {
+  ring *into = detail::claim_ring(trace);
+  if (into == nullptr) {
+    return;
+  }
+  detail::append(*into, record{
+                            .ts_ns = trace.clock(),
+                            .name = name.data(),
+                            .detail = detail_name.data(),
+                            .name_size = static_cast<uint32_t>(name.size()),
+                            .detail_size = static_cast<uint32_t>(detail_name.size()),
+                            .cat = cat,
+                            .ph = ph,
+                        });
+}
+
+// Resets `rings` and publishes `trace` as the process-wide active session.
+inline void start(session &trace, const clock_fn clock,
+                  const std::span<ring> rings) noexcept {
+  detail::active_session.store(nullptr, std::memory_order_release);
+  for (ring &entry : rings) {
+    entry.written.store(0u, std::memory_order_relaxed);
+  }
+  trace.clock = clock;
+  trace.rings = rings;
+  trace.origin_ns = clock();
+  trace.generation =
+      detail::session_generation.fetch_add(1u, std::memory_order_relaxed) + 1u;
+  trace.claimed.store(0u, std::memory_order_relaxed);
+  trace.dropped_threads.store(0u, std::memory_order_relaxed);
+  detail::active_session.store(&trace, std::memory_order_release);
+}
+
+inline void stop() noexcept {
+  detail::active_session.store(nullptr, std::memory_order_release);
+}
+
+inline void mark(const phase ph, const category cat,
+                 const std::string_view name,
+                 const std::string_view detail_name = {}) noexcept {
+  if constexpr (k_enabled) {
+    session *trace = detail::active_session.load(std::memory_order_acquire);
+    if (trace != nullptr) {
+      emit(*trace, ph, cat, name, detail_name);
+    }
+  } else {
+    (void)ph;
+    (void)cat;
+    (void)name;
+    (void)detail_name;
+  }
+}
+
+// Begin/end pair around the enclosing scope.
+class span {
+ public:
+#if EMEL_TRACE
+  span(const category cat, const std::string_view name,
+       const std::string_view detail_name = {}) noexcept
+      : name_(name), cat_(cat) {
+    mark(phase::begin, cat, name, detail_name);
+  }
+  ~span() { mark(phase::end, cat_, name_); }
+#else
+  constexpr span(const category, const std::string_view,
+                 const std::string_view = {}) noexcept {}
+#endif
+
+  span(const span &) = delete;
+  span & operator=(const span &) = delete;
+
+ private:
+#if EMEL_TRACE
+  std::string_view name_;
+  category cat_;
+#endif
+};
+
+namespace detail {
+
+template <class write_fn>
+void write_escaped(write_fn &write, const char *text, const uint32_t size) {
+  uint32_t run = 0u;
+  for (uint32_t index = 0u; index < size; ++index) {
+    const char ch = text[index];
+    if (ch != '"' && ch != '\\' && static_cast<unsigned char>(ch) >= 0x20u) {
+      continue;
+    }
+    write(std::string_view{text + run, index - run});
+    if (ch == '"' || ch == '\\') {
+      const char escaped[2] = {'\\', ch};
+      write(std::string_view{escaped, 2u});
+    }
+    run = index + 1u;
+  }
+  write(std::string_view{text + run, size - run});
+}
+
+}  // namespace detail
+
+// Streams the session as Chrome trace JSON through `write(std::string_view)`;
+// the owner decides where the bytes go. One tid per ring, timestamps in
+// microseconds from start(). A ring that wrapped can open with end records
+// whose begin was overwritten; the viewers drop those.
+template <class write_fn>
+void export_chrome_json(const session &trace, write_fn &&write) {
+  write(std::string_view{"{\"traceEvents\":["});
+  bool first = true;
+  const size_t ring_count =
+      std::min<size_t>(trace.claimed.load(std::memory_order_acquire),
+                       trace.rings.size());
+  for (size_t tid = 0u; tid < ring_count; ++tid) {
+    const ring &from = trace.rings[tid];
+    const uint64_t written = from.written.load(std::memory_order_acquire);
+    const uint64_t oldest =
+        written > k_ring_capacity ? written - k_ring_capacity : 0u;
+    for (uint64_t index = oldest; index < written; ++index) {
+      const record &entry = from.records[index % k_ring_capacity];
+      const uint64_t ts =
+          entry.ts_ns > trace.origin_ns ? entry.ts_ns - trace.origin_ns : 0u;
+      const char ph = entry.ph == phase::begin ? 'B'
+                      : entry.ph == phase::end ? 'E'
+                                               : 'i';
+      const std::string_view cat = category_name(entry.cat);
+      char head[160];
+      const int head_size = std::snprintf(
+          head, sizeof(head),
+          "%s{\"ph\":\"%c\",\"cat\":\"%.*s\",\"pid\":1,\"tid\":%zu,"
+          "\"ts\":%llu.%03llu,%s\"name\":\"",
+          first ? "" : ",", ph, static_cast<int>(cat.size()), cat.data(), tid,
+          static_cast<unsigned long long>(ts / 1000u),
+          static_cast<unsigned long long>(ts % 1000u),
+          entry.ph == phase::instant ? "\"s\":\"t\"," : "");
+      write(std::string_view{head, static_cast<size_t>(head_size)});
+      detail::write_escaped(write, entry.name, entry.name_size);
+      if (entry.detail_size != 0u) {
+        write(std::string_view{"\",\"args\":{\"detail\":\""});
+        detail::write_escaped(write, entry.detail, entry.detail_size);
+        write(std::string_view{"\"}}"});
+      } else {
+        write(std::string_view{"\"}"});
+      }
+      first = false;
+    }
+  }
+  write(std::string_view{"],\"displayTimeUnit\":\"ns\"}\n"});
+}
+
+}  // namespace emel::trace
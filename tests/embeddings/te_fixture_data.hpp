@@ -20,6 +20,7 @@
 #include "emel/gguf/loader/sm.hpp"
 #include "emel/model/data.hpp"
 #include "emel/model/detail.hpp"
+#include "emel/text/encoders/types.hpp"
 #include "emel/text/tokenizer/detail.hpp"
 #include "emel/text/tokenizer/preprocessor/detail.hpp"
 #include "emel/text/tokenizer/sm.hpp"
@@ -223,7 +224,7 @@ inline bool load_te_vocab_from_file(const std::filesystem::path & path,
       vocab_out, vocab_out.sep_id, emel::model::detail::k_token_type_control);
   emel::model::detail::mark_special_token_type(
       vocab_out, vocab_out.mask_id, emel::model::detail::k_token_type_control);
-  return stream.eof();
+  return emel::text::encoders::detail::prepare_token_trie(vocab_out) && stream.eof();
 }
 
 inline loaded_te_fixture load_te_fixture(const std::filesystem::path & model_path) {
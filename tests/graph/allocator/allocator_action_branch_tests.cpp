@@ -1,10 +1,14 @@
 #include <doctest/doctest.h>
 
+#include <algorithm>
+#include <array>
 #include <cstdint>
 #include <limits>
+#include <span>
 
 #include "emel/error/error.hpp"
 #include "emel/graph/allocator/actions.hpp"
+#include "emel/graph/allocator/detail.hpp"
 #include "emel/graph/allocator/events.hpp"
 #include "emel/graph/allocator/guards.hpp"
 #include "emel/graph/allocator/liveness_pass/actions.hpp"
@@ -268,3 +272,159 @@ TEST_CASE("graph_allocator_pass_action_and_guard_branches") {
   emel::graph::allocator::placement_pass::action::mark_failed_internal(ev, machine_ctx);
   emel::graph::allocator::placement_pass::action::on_unexpected(ev, machine_ctx);
 }
+
+TEST_CASE("graph_allocator_described_plan_reuses_dead_slots") {
+  namespace event = emel::graph::allocator::event;
+  namespace liveness = emel::graph::allocator::liveness_pass;
+  namespace ordering = emel::graph::allocator::ordering_pass;
+  namespace placement = emel::graph::allocator::placement_pass;
+  using allocator_error = emel::graph::allocator::error;
+
+  // Chain of four nodes: t0 -> t1 -> t2 -> t3, each read only by the next op;
+  // t2 overwrites t1 in place. Sizes are multiples of the default alignment.
+  const std::array<event::tensor_desc, 4> tensors = {{
+    {.bytes = 256u, .producer = 0u, .last_consumer = 1u},
+    {.bytes = 128u, .producer = 1u, .last_consumer = 2u},
+    {.bytes = 128u, .producer = 2u, .last_consumer = 3u, .inplace_source = 1},
+    {.bytes = 64u, .producer = 3u, .last_consumer = 3u},
+  }};
+  std::array<event::tensor_placement, 4> placements = {};
+  std::array<uint32_t, 4> order = {};
+  event::allocation_plan plan{};
+  allocator_dispatch_state state{};
+  event::allocate_graph request = make_valid_request(&plan, &state);
+  request.node_count = 4u;
+  request.tensor_count = 4u;
+  request.tensors = tensors;
+  request.placements_out = placements;
+  request.allocation_order = order;
+  event::allocate_graph_ctx phase_ctx{};
+  event::allocate_graph_plan ev{request, phase_ctx};
+  emel::graph::allocator::action::context machine_ctx{};
+
+  CHECK_FALSE(liveness::guard::phase_done{}(ev, machine_ctx));
+  REQUIRE(liveness::guard::phase_done_described{}(ev, machine_ctx));
+  liveness::action::mark_done_described(ev, machine_ctx);
+  CHECK(ev.ctx.required_intervals == 3u);
+  CHECK(ev.ctx.inplace_count == 1u);
+  CHECK(ev.ctx.naive_buffer_bytes == 576u);
+  CHECK(ev.ctx.peak_live_bytes == 384u);
+  CHECK(placements[2].inplace_of == 1);
+  CHECK(placements[1].live_end == 3u);
+
+  CHECK_FALSE(ordering::guard::phase_done{}(ev, machine_ctx));
+  REQUIRE(ordering::guard::phase_done_described{}(ev, machine_ctx));
+  ordering::action::mark_done_described(ev, machine_ctx);
+  CHECK(ev.ctx.sorted_tensor_count == 4u);
+  CHECK(order[0] == 0u);
+  CHECK(order[3] == 2u);
+
+  CHECK_FALSE(placement::guard::phase_done{}(ev, machine_ctx));
+  REQUIRE(placement::guard::phase_plan_described{}(ev, machine_ctx));
+  placement::action::assign_offsets(ev, machine_ctx);
+  CHECK(ev.ctx.required_buffer_bytes == 384u);
+  CHECK(placements[0].offset == 0u);
+  CHECK(placements[1].offset == 256u);
+  CHECK(placements[2].offset == placements[1].offset);
+  // t3 only overlaps the t1/t2 slot, so it drops into t0's dead bytes.
+  CHECK(placements[3].offset == 0u);
+  CHECK(placement::guard::planned_fits{}(ev, machine_ctx));
+  request.workspace_capacity_bytes = 256u;
+  CHECK(placement::guard::planned_capacity_exceeded{}(ev, machine_ctx));
+
+  placements = {};
+  request.allocation_order = std::span<uint32_t>{order.data(), 3u};
+  ev.ctx.err = emel::error::cast(allocator_error::none);
+  CHECK(liveness::guard::phase_invalid_described{}(ev, machine_ctx));
+  CHECK_FALSE(liveness::guard::phase_done_described{}(ev, machine_ctx));
+}
+
+TEST_CASE("graph_allocator_described_plan_keeps_live_slots_disjoint") {
+  namespace event = emel::graph::allocator::event;
+  namespace detail = emel::graph::allocator::detail;
+
+  // Pseudo-random sizes, alignments and live ranges: every pair of slots
+  // whose ranges intersect must land on disjoint aligned bytes.
+  constexpr uint32_t k_count = 48u;
+  std::array<event::tensor_desc, k_count> tensors = {};
+  std::array<event::tensor_placement, k_count> placements = {};
+  std::array<uint32_t, k_count> order = {};
+  uint32_t state = 0x2545f491u;
+  const auto next = [&state](const uint32_t bound) noexcept {
+    state = state * 1664525u + 1013904223u;
+    return (state >> 8u) % bound;
+  };
+  for (uint32_t index = 0; index < k_count; ++index) {
+    const uint32_t producer = next(32u);
+    tensors[index] = {
+      .bytes = 1u + next(4096u),
+      .alignment = next(2u) == 0u ? 0u : 16u,
+      .producer = producer,
+      .last_consumer = producer + next(8u),
+    };
+    placements[index] = {
+      .bytes = tensors[index].bytes,
+      .live_begin = tensors[index].producer,
+      .live_end = tensors[index].last_consumer,
+    };
+    order[index] = index;
+  }
+  std::sort(order.begin(), order.end(), [&placements](const uint32_t lhs, const uint32_t rhs) {
+    return placements[lhs].bytes > placements[rhs].bytes;
+  });
+  event::allocate_graph request{};
+  request.node_count = 40u;
+  request.tensor_count = k_count;
+  request.tensors = tensors;
+  request.placements_out = placements;
+  request.allocation_order = order;
+
+  const uint64_t arena_bytes = detail::assign_offsets(request, k_count);
+  for (uint32_t index = 0; index < k_count; ++index) {
+    const event::tensor_placement & slot = placements[index];
+    CHECK(slot.offset % detail::alignment_of(tensors[index]) == 0u);
+    CHECK(slot.offset + slot.bytes <= arena_bytes);
+    for (uint32_t other_index = index + 1u; other_index < k_count; ++other_index) {
+      const event::tensor_placement & other = placements[other_index];
+      if (detail::live_ranges_overlap(slot, other)) {
+        CHECK((slot.offset + slot.bytes <= other.offset ||
+               other.offset + other.bytes <= slot.offset));
+      }
+    }
+  }
+}
+
+TEST_CASE("graph_allocator_described_plan_folds_one_output_per_node") {
+  namespace event = emel::graph::allocator::event;
+  namespace detail = emel::graph::allocator::detail;
+
+  // Node 1 reads t0 for the last time and writes t1 and t2, both naming t0
+  // as their in-place source. t1 is unread, so after folding it the slot
+  // still ends at node 1; t2 must not fold on top of it.
+  const std::array<event::tensor_desc, 3> tensors = {{
+    {.bytes = 128u, .producer = 0u, .last_consumer = 1u},
+    {.bytes = 128u, .producer = 1u, .last_consumer = 1u, .inplace_source = 0},
+    {.bytes = 128u, .producer = 1u, .last_consumer = 2u, .inplace_source = 0},
+  }};
+  std::array<event::tensor_placement, 3> placements = {};
+  std::array<uint32_t, 3> order = {};
+  event::allocate_graph request{};
+  request.node_count = 3u;
+  request.tensor_count = 3u;
+  request.tensors = tensors;
+  request.placements_out = placements;
+  request.allocation_order = order;
+
+  REQUIRE(detail::described_request_valid(request));
+  const detail::liveness_summary summary = detail::build_live_intervals(request);
+  CHECK(summary.inplace_count == 1u);
+  CHECK(summary.slot_count == 2u);
+  CHECK(placements[1].inplace_of == 0);
+  CHECK(placements[2].inplace_of == -1);
+  CHECK(placements[0].live_end == 1u);
+
+  const uint32_t slot_count = detail::order_slots_by_size(request);
+  REQUIRE(slot_count == 2u);
+  CHECK(detail::assign_offsets(request, slot_count) == 256u);
+  CHECK(placements[2].offset != placements[0].offset);
+}
@@ -1,5 +1,6 @@
 #include <doctest/doctest.h>
 
+#include <array>
 #include <cstdint>
 
 #include "emel/error/error.hpp"
@@ -93,3 +94,46 @@ TEST_CASE("graph_allocator_rejects_invalid_request_with_dispatchable_error") {
   CHECK(plan.interval_count == 0u);
   CHECK(plan.required_buffer_bytes == 0u);
 }
+
+TEST_CASE("graph_allocator_plans_described_tensors_by_live_set") {
+  namespace event = emel::graph::allocator::event;
+  emel::graph::allocator::sm machine{};
+  event::allocation_plan plan{};
+  allocation_callbacks callbacks{};
+
+  // Six 1 KiB activations, each read only by the next node: at most two are
+  // live at once, so the arena needs two slots instead of six.
+  std::array<event::tensor_desc, 6> tensors = {};
+  for (uint32_t index = 0; index < tensors.size(); ++index) {
+    tensors[index] = {.bytes = 1024u, .producer = index, .last_consumer = index + 1u};
+  }
+  tensors.back().last_consumer = 5u;
+  std::array<event::tensor_placement, 6> placements = {};
+  std::array<uint32_t, 6> order = {};
+
+  const event::allocate_graph request{
+    .graph_topology = reinterpret_cast<const void *>(0x1),
+    .plan_out = &plan,
+    .node_count = 6u,
+    .tensor_count = 6u,
+    .tensor_capacity = 6u,
+    .interval_capacity = 6u,
+    .bytes_per_tensor = 1024u,
+    .workspace_capacity_bytes = 4096u,
+    .dispatch_done = {&callbacks, allocation_callbacks::on_done},
+    .dispatch_error = {&callbacks, allocation_callbacks::on_error},
+    .tensors = tensors,
+    .placements_out = placements,
+    .allocation_order = order,
+  };
+
+  CHECK(machine.process_event(request));
+  CHECK(callbacks.done_called);
+  CHECK(plan.tensor_count == 6u);
+  CHECK(plan.naive_buffer_bytes == 6u * 1024u);
+  CHECK(plan.peak_live_bytes == 2u * 1024u);
+  CHECK(plan.required_buffer_bytes == 2u * 1024u);
+  for (uint32_t index = 1; index < placements.size(); ++index) {
+    CHECK(placements[index].offset != placements[index - 1u].offset);
+  }
+}
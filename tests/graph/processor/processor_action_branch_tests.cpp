@@ -1,6 +1,7 @@
 #include <doctest/doctest.h>
 
 #include <array>
+#include <atomic>
 #include <cstdint>
 
 #include "emel/error/error.hpp"
@@ -18,6 +19,7 @@
 #include "emel/graph/processor/kernel_step/guards.hpp"
 #include "emel/graph/processor/prepare_step/actions.hpp"
 #include "emel/graph/processor/prepare_step/guards.hpp"
+#include "emel/graph/processor/schedule.hpp"
 #include "emel/graph/processor/sm.hpp"
 #include "emel/graph/processor/validate_step/actions.hpp"
 #include "emel/graph/processor/validate_step/guards.hpp"
@@ -94,6 +96,7 @@ struct dispatch_state {
   emel::graph::processor::event::execution_output done_output = {};
   emel::graph::processor::event::execution_output error_output = {};
   int32_t error_code = 0;
+  int32_t error_failed_node = 0;
 
   static bool on_done(void * owner,
                       const emel::graph::processor::events::execution_done & ev) noexcept {
@@ -109,6 +112,7 @@ struct dispatch_state {
     self->error_called = true;
     self->error_output = ev.output;
     self->error_code = ev.err;
+    self->error_failed_node = ev.failed_node;
     return true;
   }
 };
@@ -385,11 +389,14 @@ TEST_CASE("graph_processor_action_and_guard_branches") {
 
   state = {};
   ev.ctx.err = emel::error::cast(processor_error::kernel_failed);
+  ev.ctx.kernel_failed_node = 3;
   action::dispatch_error(ev, machine_ctx);
   CHECK_FALSE(state.done_called);
   CHECK(state.error_called);
   CHECK(state.error_code ==
         static_cast<int32_t>(emel::error::cast(processor_error::kernel_failed)));
+  CHECK(state.error_failed_node == 3);
+  ev.ctx.kernel_failed_node = -1;
 
   state = {};
   output = {.outputs_produced = 3, .graph_reused = 1u};
@@ -739,3 +746,205 @@ TEST_CASE("graph_processor_step_action_and_guard_branches") {
   request.prepare_graph = prepare_needs_alloc;
   emel::graph::processor::prepare_step::action::run_callback(ev, prepare_ctx);
 }
+
+namespace {
+
+namespace schedule = emel::graph::processor::schedule;
+
+// norm -> {q, k, v} -> attn -> {gate, up} -> glu: the shapes the scheduler
+// is meant to overlap, with the projections split into uneven slice counts.
+struct schedule_fixture {
+  static constexpr uint32_t k_nodes = 8u;
+  std::array<uint32_t, 1> norm_out{0u};
+  std::array<uint32_t, 3> qkv_out{1u, 2u, 3u};
+  std::array<uint32_t, 1> attn_out{4u};
+  std::array<uint32_t, 2> gate_up_out{5u, 6u};
+  std::array<schedule::node, k_nodes> nodes{{
+      {.slices = 1u},
+      {.deps = norm_out.data(), .dep_count = 1u, .slices = 4u},
+      {.deps = norm_out.data(), .dep_count = 1u, .slices = 2u},
+      {.deps = norm_out.data(), .dep_count = 1u, .slices = 2u},
+      {.deps = qkv_out.data(), .dep_count = 3u, .slices = 1u},
+      {.deps = attn_out.data(), .dep_count = 1u, .slices = 3u},
+      {.deps = attn_out.data(), .dep_count = 1u, .slices = 3u},
+      {.deps = gate_up_out.data(), .dep_count = 2u, .slices = 32u},
+  }};
+  std::array<uint32_t, k_nodes> wave_of{};
+  std::array<uint32_t, k_nodes> order{};
+  std::array<uint32_t, k_nodes + 1u> wave_begin{};
+  std::array<uint32_t, k_nodes + 1u> task_begin{};
+  schedule::plan dag{
+      .nodes = nodes,
+      .wave_of = wave_of,
+      .order = order,
+      .wave_begin = wave_begin,
+      .task_begin = task_begin,
+  };
+};
+
+struct schedule_probe {
+  const schedule_fixture * fixture = nullptr;
+  std::array<std::atomic<uint32_t>, schedule_fixture::k_nodes> slice_mask{};
+  std::array<std::atomic<bool>, schedule_fixture::k_nodes> committed{};
+  std::atomic<bool> deps_ready = true;
+  std::array<std::atomic<bool>, schedule::k_max_slices> lane_busy{};
+  std::atomic<bool> lanes_exclusive = true;
+  std::atomic<uint32_t> lane_mask = 0u;
+  std::array<uint32_t, schedule_fixture::k_nodes> commit_order{};
+  uint32_t commit_count = 0u;
+  uint32_t fail_node = schedule::k_no_node;
+};
+
+bool probe_run_slice(void * ctx, const uint32_t lane, const uint32_t node,
+                     const uint32_t slice, const uint32_t slice_count) noexcept {
+  auto & probe = *static_cast<schedule_probe *>(ctx);
+  if (lane >= schedule::k_max_slices ||
+      probe.lane_busy[lane].exchange(true, std::memory_order_acquire)) {
+    probe.lanes_exclusive.store(false, std::memory_order_relaxed);
+    return false;
+  }
+  probe.lane_mask.fetch_or(1u << lane, std::memory_order_relaxed);
+  const schedule::node & item = probe.fixture->nodes[node];
+  for (uint32_t dep = 0; dep < item.dep_count; ++dep) {
+    if (!probe.committed[item.deps[dep]].load(std::memory_order_acquire)) {
+      probe.deps_ready.store(false, std::memory_order_relaxed);
+    }
+  }
+  if (slice_count != schedule::slice_count(item)) {
+    probe.deps_ready.store(false, std::memory_order_relaxed);
+  }
+  probe.slice_mask[node].fetch_or(1u << slice, std::memory_order_relaxed);
+  probe.lane_busy[lane].store(false, std::memory_order_release);
+  return node != probe.fail_node;
+}
+
+bool probe_commit(void * ctx, const uint32_t node) noexcept {
+  auto & probe = *static_cast<schedule_probe *>(ctx);
+  probe.committed[node].store(true, std::memory_order_release);
+  probe.commit_order[probe.commit_count++] = node;
+  return true;
+}
+
+}  // namespace
+
+TEST_CASE("graph_processor_schedule_levels_independent_nodes_into_waves") {
+  schedule_fixture fixture{};
+  REQUIRE(schedule::build_plan(fixture.dag));
+
+  CHECK(fixture.dag.wave_count == 5u);
+  CHECK(fixture.dag.task_count == 1u + 4u + 2u + 2u + 1u + 3u + 3u + schedule::k_max_slices);
+  CHECK(fixture.wave_of == std::array<uint32_t, 8>{0u, 1u, 1u, 1u, 2u, 3u, 3u, 4u});
+  CHECK(fixture.order == std::array<uint32_t, 8>{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u});
+  CHECK(fixture.wave_begin[1] == 1u);
+  CHECK(fixture.wave_begin[2] == 4u);
+  CHECK(fixture.wave_begin[5] == 8u);
+  CHECK(fixture.task_begin[2] == 5u);
+
+  // A dependency on a later node is not a topological numbering.
+  std::array<uint32_t, 1> forward{7u};
+  fixture.nodes[1].deps = forward.data();
+  CHECK_FALSE(schedule::build_plan(fixture.dag));
+  CHECK(fixture.dag.wave_count == 0u);
+  CHECK_FALSE(schedule::ready(&fixture.dag, nullptr));
+
+  schedule::plan undersized = fixture.dag;
+  undersized.task_begin = std::span<uint32_t>{fixture.task_begin}.first(3);
+  CHECK_FALSE(schedule::build_plan(undersized));
+}
+
+TEST_CASE("graph_processor_schedule_runs_every_slice_and_commits_in_node_order") {
+  schedule_fixture fixture{};
+  REQUIRE(schedule::build_plan(fixture.dag));
+  schedule::lane_pool pool{};
+
+  for (schedule::lane_pool * lanes_pool : {static_cast<schedule::lane_pool *>(nullptr), &pool}) {
+    schedule_probe probe{.fixture = &fixture};
+    const schedule::dispatch lanes{
+        .pool = lanes_pool,
+        .ctx = &probe,
+        .run_slice = probe_run_slice,
+        .commit = probe_commit,
+    };
+    REQUIRE(schedule::ready(&fixture.dag, &lanes));
+    const schedule::run_result result = schedule::run_plan(fixture.dag, lanes);
+    CHECK(result.ok);
+    CHECK(result.waves_run == 5u);
+    CHECK(probe.deps_ready.load());
+    CHECK(probe.lanes_exclusive.load());
+    // Lane 0 is the calling thread; without a pool nothing else runs.
+    CHECK((probe.lane_mask.load() & 1u) == 1u);
+    CHECK((lanes_pool != nullptr || probe.lane_mask.load() == 1u));
+    CHECK(probe.commit_count == schedule_fixture::k_nodes);
+    CHECK(probe.commit_order == std::array<uint32_t, 8>{0u, 1u, 2u, 3u, 4u, 5u, 6u, 7u});
+    for (uint32_t node = 0; node < schedule_fixture::k_nodes; ++node) {
+      const uint32_t slices = schedule::slice_count(fixture.nodes[node]);
+      CHECK(probe.slice_mask[node].load() == (1u << slices) - 1u);
+    }
+  }
+}
+
+TEST_CASE("graph_processor_schedule_reports_the_lowest_failing_node") {
+  schedule_fixture fixture{};
+  REQUIRE(schedule::build_plan(fixture.dag));
+  schedule::lane_pool pool{};
+
+  for (int repeat = 0; repeat < 16; ++repeat) {
+    schedule_probe probe{.fixture = &fixture, .fail_node = 2u};
+    const schedule::dispatch lanes{
+        .pool = &pool,
+        .ctx = &probe,
+        .run_slice = probe_run_slice,
+        .commit = probe_commit,
+    };
+    const schedule::run_result result = schedule::run_plan(fixture.dag, lanes);
+    CHECK_FALSE(result.ok);
+    CHECK(result.failed_node == 2u);
+    CHECK(result.waves_run == 2u);
+    // Node 1 finished before the failure in node order; nothing after it is
+    // committed and no later wave starts.
+    CHECK(probe.commit_count == 2u);
+    CHECK(probe.commit_order[1] == 1u);
+    CHECK(probe.slice_mask[4].load() == 0u);
+  }
+}
+
+TEST_CASE("graph_processor_kernel_step_prefers_a_ready_schedule") {
+  namespace event = emel::graph::processor::event;
+  namespace kernel_step = emel::graph::processor::kernel_step;
+
+  lifecycle_fixture lifecycle{};
+  event::execution_output output{};
+  dispatch_state dispatch{};
+  event::execute request = make_valid_execute(&output, &dispatch, lifecycle);
+  event::execute_ctx ctx{};
+  event::execute_step ev{request, ctx};
+  kernel_step::action::context kernel_ctx{};
+
+  schedule_fixture fixture{};
+  REQUIRE(schedule::build_plan(fixture.dag));
+  schedule_probe probe{.fixture = &fixture};
+  schedule::dispatch lanes{.ctx = &probe, .run_slice = probe_run_slice, .commit = probe_commit};
+  request.kernel_plan = &fixture.dag;
+  request.kernel_dispatch = &lanes;
+
+  ev.ctx.err = emel::error::cast(processor_error::none);
+  CHECK(kernel_step::guard::phase_request_schedule{}(ev, kernel_ctx));
+  CHECK_FALSE(kernel_step::guard::phase_request_callback{}(ev, kernel_ctx));
+  CHECK_FALSE(kernel_step::guard::phase_missing_callback{}(ev, kernel_ctx));
+  kernel_step::action::run_schedule(ev, kernel_ctx);
+  CHECK(kernel_step::guard::callback_ok{}(ev, kernel_ctx));
+  CHECK(probe.commit_count == schedule_fixture::k_nodes);
+  CHECK(ev.ctx.kernel_failed_node == -1);
+
+  schedule_probe failing{.fixture = &fixture, .fail_node = 5u};
+  lanes.ctx = &failing;
+  kernel_step::action::run_schedule(ev, kernel_ctx);
+  CHECK(kernel_step::guard::callback_failed_without_error{}(ev, kernel_ctx));
+  CHECK(ev.ctx.kernel_failed_node == 5);
+
+  // A plan without a runnable dispatch must not fall back to run_kernel.
+  lanes.run_slice = nullptr;
+  CHECK_FALSE(kernel_step::guard::phase_request_schedule{}(ev, kernel_ctx));
+  CHECK_FALSE(kernel_step::guard::phase_request_callback{}(ev, kernel_ctx));
+  CHECK(kernel_step::guard::phase_missing_callback{}(ev, kernel_ctx));
+}
@@ -0,0 +1,526 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "emel/error/error.hpp"
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/async_read/events.hpp"
+#include "emel/io/async_read/sm.hpp"
+#include "emel/machines.hpp"
+#include <stateforward/sml.hpp>
+
+namespace {
+
+struct async_owner_state {
+  bool done = false;
+  bool error = false;
+  emel::io::async_read::event::engine_kind engine =
+      emel::io::async_read::event::engine_kind::none;
+  uint32_t done_count = 0u;
+  uint64_t bytes_read = 0u;
+  uint32_t peak_in_flight = 0u;
+  emel::error::type err = emel::error::cast(emel::io::async_read::error::none);
+  uint32_t failed_index = 0u;
+};
+
+void on_async_done(
+    void *object,
+    const emel::io::async_read::events::read_batch_done &ev) noexcept {
+  auto *owner = static_cast<async_owner_state *>(object);
+  owner->done = true;
+  owner->engine = ev.engine;
+  owner->done_count = ev.done_count;
+  owner->bytes_read = ev.bytes_read;
+  owner->peak_in_flight = ev.peak_in_flight;
+}
+
+struct tensor_completions {
+  std::vector<uint32_t> indices = {};
+  uint64_t bytes = 0u;
+};
+
+void on_async_tensor_done(
+    void *object,
+    const emel::io::async_read::events::read_tensor_done &ev) noexcept {
+  auto *completions = static_cast<tensor_completions *>(object);
+  completions->indices.push_back(ev.tensor_index);
+  completions->bytes += ev.bytes_read;
+}
+
+void on_async_error(
+    void *object,
+    const emel::io::async_read::events::read_batch_error &ev) noexcept {
+  auto *owner = static_cast<async_owner_state *>(object);
+  owner->error = true;
+  owner->err = ev.err;
+  owner->failed_index = ev.failed_index;
+}
+
+std::vector<uint8_t> make_payload(const uint64_t bytes) {
+  std::vector<uint8_t> data(static_cast<size_t>(bytes));
+  uint32_t state = 0x9E3779B9u;
+  for (auto &byte : data) {
+    state = state * 1664525u + 1013904223u;
+    byte = static_cast<uint8_t>(state >> 24);
+  }
+  return data;
+}
+
+std::filesystem::path make_temp_file(const std::string_view tag,
+                                     const std::vector<uint8_t> &payload) {
+  const auto path =
+      std::filesystem::temp_directory_path() /
+      (std::string{"emel_io_async_read_"} + std::string{tag} + ".bin");
+  std::ofstream out{path, std::ios::binary | std::ios::trunc};
+  REQUIRE(out.good());
+  out.write(reinterpret_cast<const char *>(payload.data()),
+            static_cast<std::streamsize>(payload.size()));
+  out.close();
+  return path;
+}
+
+// Tensors of mixed sizes at unaligned offsets: several span more than one
+// block so their slices interleave with the small ones in the queue.
+struct batch_fixture {
+  std::vector<std::vector<uint8_t>> targets = {};
+  std::vector<emel::io::event::tensor_load_span> spans = {};
+
+  batch_fixture(const std::string &path, const uint64_t file_bytes) {
+    const std::array<uint64_t, 6> sizes{
+        17u,
+        emel::io::async_read::k_block_bytes * 3u + 5u,
+        4096u,
+        1u,
+        emel::io::async_read::k_block_bytes + 4095u,
+        300000u,
+    };
+    targets.resize(sizes.size());
+    uint64_t offset = 3u;
+    for (size_t index = 0u; index < sizes.size(); ++index) {
+      REQUIRE(offset + sizes[index] <= file_bytes);
+      targets[index].assign(static_cast<size_t>(sizes[index]), 0u);
+      spans.push_back(emel::io::event::tensor_load_span{
+          .tensor_id = static_cast<int32_t>(index),
+          .file_index = 0u,
+          .file_offset = offset,
+          .byte_size = sizes[index],
+          .file_path = path,
+          .target = targets[index].data(),
+          .target_bytes = sizes[index],
+      });
+      offset += sizes[index] + 4099u;
+    }
+  }
+
+  bool matches(const std::vector<uint8_t> &payload) const {
+    for (size_t index = 0u; index < spans.size(); ++index) {
+      if (std::memcmp(targets[index].data(),
+                      payload.data() + spans[index].file_offset,
+                      static_cast<size_t>(spans[index].byte_size)) != 0) {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  uint64_t total_bytes() const {
+    uint64_t total = 0u;
+    for (const auto &span : spans) {
+      total += span.byte_size;
+    }
+    return total;
+  }
+};
+
+emel::io::async_read::action::engine *fake_engine() noexcept {
+  static int storage = 0;
+  return reinterpret_cast<emel::io::async_read::action::engine *>(&storage);
+}
+
+emel::io::async_read::action::platform_ops failing_read_ops() noexcept {
+  emel::io::async_read::action::platform_ops ops{};
+  ops.create = [](const emel::io::async_read::action::engine_config &) noexcept {
+    return fake_engine();
+  };
+  ops.destroy = [](emel::io::async_read::action::engine *) noexcept {};
+  ops.kind = [](const emel::io::async_read::action::engine *) noexcept {
+    return emel::io::async_read::event::engine_kind::thread_pool;
+  };
+  ops.read_batch =
+      [](emel::io::async_read::action::engine *,
+         const emel::io::async_read::detail::read_batch_plan &,
+         emel::io::async_read::detail::read_batch_attempt_status
+             &status) noexcept {
+        status.err = emel::error::cast(emel::io::async_read::error::read_failed);
+        status.ok = false;
+        status.failed_index = 1u;
+      };
+  return ops;
+}
+
+emel::io::async_read::action::platform_ops unavailable_engine_ops() noexcept {
+  auto ops = failing_read_ops();
+  ops.create = [](const emel::io::async_read::action::engine_config &) noexcept
+      -> emel::io::async_read::action::engine * { return nullptr; };
+  ops.kind = [](const emel::io::async_read::action::engine *) noexcept {
+    return emel::io::async_read::event::engine_kind::none;
+  };
+  return ops;
+}
+
+} // namespace
+
+TEST_CASE("io async_read exposes canonical machine alias") {
+  emel::IoAsyncRead machine{};
+  CHECK(machine.is(stateforward::sml::state<emel::io::async_read::state_ready>));
+}
+
+TEST_CASE("io async_read batch matches file bytes on every available engine") {
+  const uint64_t file_bytes = emel::io::async_read::k_block_bytes * 8u;
+  const auto payload = make_payload(file_bytes);
+  const auto path = make_temp_file("engines", payload);
+  const std::string path_str = path.string();
+
+  for (const auto preference :
+       {emel::io::async_read::action::engine_preference::automatic,
+        emel::io::async_read::action::engine_preference::io_uring,
+        emel::io::async_read::action::engine_preference::thread_pool}) {
+    CAPTURE(static_cast<int>(preference));
+    emel::io::async_read::action::lane_pool lanes{3u};
+    emel::io::async_read::sm machine{
+        std::in_place, emel::io::async_read::action::engine_config{
+                           .preference = preference, .lanes = &lanes}};
+    batch_fixture fixture{path_str, file_bytes};
+    async_owner_state owner{};
+    emel::io::async_read::event::read_batch request{fixture.spans};
+    request.on_done = {&owner, on_async_done};
+    request.on_error = {&owner, on_async_error};
+
+    const bool ok = machine.process_event(request);
+    if (preference ==
+            emel::io::async_read::action::engine_preference::io_uring &&
+        !ok) {
+      // Kernels without io_uring (or sandboxes that deny it) only offer the
+      // worker engine; an explicit io_uring preference fails closed.
+      CHECK(owner.err ==
+            emel::error::cast(emel::io::async_read::error::engine_unavailable));
+      continue;
+    }
+    REQUIRE(ok);
+    CHECK(owner.done);
+    CHECK_FALSE(owner.error);
+    CHECK(owner.engine != emel::io::async_read::event::engine_kind::none);
+    CHECK(owner.done_count == fixture.spans.size());
+    CHECK(owner.bytes_read == fixture.total_bytes());
+    CHECK(owner.peak_in_flight > 1u);
+    CHECK(fixture.matches(payload));
+    CHECK(
+        machine.is(stateforward::sml::state<emel::io::async_read::state_ready>));
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("io async_read sharded batch spreads split files over lanes") {
+  const uint64_t file_bytes = emel::io::async_read::k_block_bytes * 8u;
+  const auto payload = make_payload(file_bytes);
+  const std::array<std::filesystem::path, 3> paths{
+      make_temp_file("split_0", payload),
+      make_temp_file("split_1", payload),
+      make_temp_file("split_2", payload),
+  };
+  std::array<std::string, 3> path_strs{};
+  for (size_t index = 0u; index < paths.size(); ++index) {
+    path_strs[index] = paths[index].string();
+  }
+
+  for (const auto preference :
+       {emel::io::async_read::action::engine_preference::automatic,
+        emel::io::async_read::action::engine_preference::thread_pool}) {
+    CAPTURE(static_cast<int>(preference));
+    emel::io::async_read::action::lane_pool lanes{3u};
+    emel::io::async_read::sm machine{
+        std::in_place, emel::io::async_read::action::engine_config{
+                           .preference = preference, .lanes = &lanes}};
+    batch_fixture fixture{path_strs[0], file_bytes};
+    // Spread consecutive tensors over the split files like a sharded GGUF.
+    for (size_t index = 0u; index < fixture.spans.size(); ++index) {
+      fixture.spans[index].file_path =
+          path_strs[(index * path_strs.size()) / fixture.spans.size()];
+    }
+    async_owner_state owner{};
+    tensor_completions completions{};
+    emel::io::async_read::event::read_batch request{fixture.spans};
+    request.mode = emel::io::async_read::event::read_mode::sharded;
+    request.on_done = {&owner, on_async_done};
+    request.on_error = {&owner, on_async_error};
+    request.on_tensor_done = {&completions, on_async_tensor_done};
+
+    REQUIRE(machine.process_event(request));
+    CHECK(owner.done);
+    CHECK(owner.done_count == fixture.spans.size());
+    CHECK(owner.bytes_read == fixture.total_bytes());
+    CHECK(owner.peak_in_flight > 1u);
+    CHECK(owner.peak_in_flight <= 4u);
+    CHECK(fixture.matches(payload));
+    REQUIRE(completions.indices.size() == fixture.spans.size());
+    for (uint32_t index = 0u; index < completions.indices.size(); ++index) {
+      CHECK(completions.indices[index] == index);
+    }
+    CHECK(completions.bytes == fixture.total_bytes());
+  }
+  for (const auto &path : paths) {
+    std::filesystem::remove(path);
+  }
+}
+
+TEST_CASE("io async_read reports completed tensors of a failed batch") {
+  const auto payload = make_payload(8192u);
+  const auto path = make_temp_file("partial", payload);
+  const std::string path_str = path.string();
+  emel::io::async_read::sm machine{};
+  std::array<uint8_t, 64> first{};
+  std::array<uint8_t, 256> second{};
+  std::array<uint8_t, 64> third{};
+  const std::array<emel::io::event::tensor_load_span, 3> spans{{
+      {.file_offset = 0u,
+       .byte_size = first.size(),
+       .file_path = path_str,
+       .target = first.data(),
+       .target_bytes = first.size()},
+      {.file_offset = payload.size() - 100u,
+       .byte_size = second.size(),
+       .file_path = path_str,
+       .target = second.data(),
+       .target_bytes = second.size()},
+      {.file_offset = 128u,
+       .byte_size = third.size(),
+       .file_path = path_str,
+       .target = third.data(),
+       .target_bytes = third.size()},
+  }};
+  for (const auto mode : {emel::io::async_read::event::read_mode::queued,
+                          emel::io::async_read::event::read_mode::sharded}) {
+    CAPTURE(static_cast<int>(mode));
+    async_owner_state owner{};
+    tensor_completions completions{};
+    emel::io::async_read::event::read_batch request{spans};
+    request.mode = mode;
+    request.on_done = {&owner, on_async_done};
+    request.on_error = {&owner, on_async_error};
+    request.on_tensor_done = {&completions, on_async_tensor_done};
+
+    CHECK_FALSE(machine.process_event(request));
+    CHECK(owner.err ==
+          emel::error::cast(emel::io::async_read::error::short_read));
+    CHECK(owner.failed_index == 1u);
+    // The short tensor never completes; the others may or may not have
+    // started before the failure stopped the readers.
+    for (const uint32_t index : completions.indices) {
+      CHECK(index != 1u);
+    }
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("io async_read rejects batches above the tensor capacity") {
+  emel::io::async_read::sm machine{
+      std::in_place,
+      emel::io::async_read::action::engine_config{.max_batch_tensors = 1u}};
+  std::array<uint8_t, 8> target{};
+  const std::array<emel::io::event::tensor_load_span, 2> spans{{
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_done = {&owner, on_async_done};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK(owner.err ==
+        emel::error::cast(emel::io::async_read::error::resource_exhausted));
+  CHECK(owner.failed_index == 1u);
+  CHECK(machine.is(stateforward::sml::state<emel::io::async_read::state_ready>));
+}
+
+TEST_CASE("io async_read reports short reads past end of file") {
+  const auto payload = make_payload(8192u);
+  const auto path = make_temp_file("short", payload);
+  const std::string path_str = path.string();
+  emel::io::async_read::sm machine{};
+  std::array<uint8_t, 64> first{};
+  std::array<uint8_t, 256> second{};
+  const std::array<emel::io::event::tensor_load_span, 2> spans{{
+      {.file_offset = 0u,
+       .byte_size = first.size(),
+       .file_path = path_str,
+       .target = first.data(),
+       .target_bytes = first.size()},
+      {.file_offset = payload.size() - 100u,
+       .byte_size = second.size(),
+       .file_path = path_str,
+       .target = second.data(),
+       .target_bytes = second.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_done = {&owner, on_async_done};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK(owner.error);
+  CHECK(owner.err == emel::error::cast(emel::io::async_read::error::short_read));
+  CHECK(owner.failed_index == 1u);
+  CHECK(machine.is(stateforward::sml::state<emel::io::async_read::state_ready>));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("io async_read surfaces file_open_failed with the tensor index") {
+  const auto payload = make_payload(4096u);
+  const auto path = make_temp_file("open", payload);
+  const std::string path_str = path.string();
+  const std::string missing =
+      (std::filesystem::temp_directory_path() / "emel_io_async_read_missing.bin")
+          .string();
+  std::filesystem::remove(missing);
+  emel::io::async_read::sm machine{};
+  std::array<uint8_t, 16> first{};
+  std::array<uint8_t, 16> second{};
+  const std::array<emel::io::event::tensor_load_span, 2> spans{{
+      {.byte_size = first.size(),
+       .file_path = path_str,
+       .target = first.data(),
+       .target_bytes = first.size()},
+      {.byte_size = second.size(),
+       .file_path = missing,
+       .target = second.data(),
+       .target_bytes = second.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_done = {&owner, on_async_done};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK(owner.err ==
+        emel::error::cast(emel::io::async_read::error::file_open_failed));
+  CHECK(owner.failed_index == 1u);
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("io async_read rejects invalid spans before reading") {
+  emel::io::async_read::sm machine{};
+  std::array<uint8_t, 8> target{};
+  const std::array<emel::io::event::tensor_load_span, 3> spans{{
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+      {.byte_size = target.size(),
+       .file_path = {},
+       .target = target.data(),
+       .target_bytes = target.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_done = {&owner, on_async_done};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK(owner.err ==
+        emel::error::cast(emel::io::async_read::error::invalid_request));
+  CHECK(owner.failed_index == 2u);
+
+  async_owner_state empty_owner{};
+  emel::io::async_read::event::read_batch empty{{}};
+  empty.on_done = {&empty_owner, on_async_done};
+  empty.on_error = {&empty_owner, on_async_error};
+  CHECK_FALSE(machine.process_event(empty));
+  CHECK(empty_owner.err ==
+        emel::error::cast(emel::io::async_read::error::invalid_request));
+}
+
+TEST_CASE("io async_read rejects a batch without callbacks") {
+  emel::io::async_read::sm machine{};
+  std::array<uint8_t, 8> target{};
+  const std::array<emel::io::event::tensor_load_span, 1> spans{{
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK(owner.err ==
+        emel::error::cast(emel::io::async_read::error::invalid_callbacks));
+  CHECK(machine.is(stateforward::sml::state<emel::io::async_read::state_ready>));
+}
+
+TEST_CASE("io async_read fails closed when no engine could be created") {
+  emel::io::async_read::sm machine{
+      std::in_place, unavailable_engine_ops(),
+      emel::io::async_read::action::engine_config{}};
+  std::array<uint8_t, 8> target{};
+  const std::array<emel::io::event::tensor_load_span, 1> spans{{
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_done = {&owner, on_async_done};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK(owner.err ==
+        emel::error::cast(emel::io::async_read::error::engine_unavailable));
+}
+
+TEST_CASE("io async_read publishes engine failures through the error leg") {
+  emel::io::async_read::sm machine{
+      std::in_place, failing_read_ops(),
+      emel::io::async_read::action::engine_config{}};
+  std::array<uint8_t, 8> target{};
+  const std::array<emel::io::event::tensor_load_span, 2> spans{{
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+      {.byte_size = target.size(),
+       .file_path = "fixtures.bin",
+       .target = target.data(),
+       .target_bytes = target.size()},
+  }};
+  async_owner_state owner{};
+  emel::io::async_read::event::read_batch request{spans};
+  request.on_done = {&owner, on_async_done};
+  request.on_error = {&owner, on_async_error};
+
+  CHECK_FALSE(machine.process_event(request));
+  CHECK_FALSE(owner.done);
+  CHECK(owner.err == emel::error::cast(emel::io::async_read::error::read_failed));
+  CHECK(owner.failed_index == 1u);
+  CHECK(machine.is(stateforward::sml::state<emel::io::async_read::state_ready>));
+}
@@ -5,10 +5,13 @@
 #include <fstream>
 #include <iterator>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <doctest/doctest.h>
 
+#include "emel/io/async_read/errors.hpp"
+#include "emel/io/async_read/sm.hpp"
 #include "emel/io/loader/errors.hpp"
 #include "emel/io/loader/events.hpp"
 #include "emel/io/loader/sm.hpp"
@@ -187,6 +190,7 @@ TEST_CASE("io loader fails closed for absent and explicit strategies") {
       emel::io::loader::event::strategy_kind::read_copy,
       emel::io::loader::event::strategy_kind::staged_read,
       emel::io::loader::event::strategy_kind::external_buffer,
+      emel::io::loader::event::strategy_kind::async_read,
   };
 
   for (const auto strategy : strategies) {
@@ -455,6 +459,190 @@ TEST_CASE("io loader staged-read batch routes once through staged actor") {
   CHECK(loader.is(stateforward::sml::state<emel::io::loader::state_ready>));
 }
 
+TEST_CASE("io loader async-read batch reads files through async actor") {
+  const auto path = std::filesystem::temp_directory_path() /
+                    "emel_io_loader_async_read_batch.bin";
+  {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    REQUIRE(out.good());
+    out << "abcdefghij";
+  }
+  const std::string path_str = path.string();
+  emel::io::async_read::sm async_actor{};
+  emel::io::loader::sm loader{{.io_async_read = &async_actor}};
+  owner_state owner{};
+  std::array<char, 3> first_target{};
+  std::array<char, 4> second_target{};
+  const std::array<emel::io::loader::event::tensor_load_span, 2> tensors{{
+      {
+          .tensor_id = 20,
+          .file_offset = 1u,
+          .byte_size = first_target.size(),
+          .file_path = path_str,
+          .target = first_target.data(),
+          .target_bytes = first_target.size(),
+      },
+      {
+          .tensor_id = 21,
+          .file_offset = 5u,
+          .byte_size = second_target.size(),
+          .file_path = path_str,
+          .target = second_target.data(),
+          .target_bytes = second_target.size(),
+      },
+  }};
+  const emel::io::loader::event::strategy_policy policy{
+      emel::io::loader::event::strategy_kind::async_read,
+  };
+  emel::io::loader::event::load_tensor_batch request{tensors, policy};
+  request.on_done = {&owner, on_load_batch_done};
+  request.on_error = {&owner, on_load_batch_error};
+
+  CHECK(loader.process_event(request));
+  CHECK(owner.done);
+  CHECK_FALSE(owner.error);
+  CHECK(owner.strategy == emel::io::loader::event::strategy_kind::async_read);
+  CHECK(owner.done_count == tensors.size());
+  CHECK(owner.bytes_done == first_target.size() + second_target.size());
+  CHECK(std::string_view{first_target.data(), first_target.size()} == "bcd");
+  CHECK(std::string_view{second_target.data(), second_target.size()} ==
+        "fghi");
+  CHECK(loader.is(stateforward::sml::state<emel::io::loader::state_ready>));
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("io loader parallel copy batches read files through async actor") {
+  const auto path = std::filesystem::temp_directory_path() /
+                    "emel_io_loader_parallel_batch.bin";
+  {
+    std::ofstream out{path, std::ios::binary | std::ios::trunc};
+    REQUIRE(out.good());
+    out << "abcdefghij";
+  }
+  const std::string path_str = path.string();
+  emel::io::async_read::sm async_actor{};
+  emel::io::loader::sm loader{{.io_async_read = &async_actor}};
+
+  for (const auto strategy : {emel::io::loader::event::strategy_kind::read_copy,
+                              emel::io::loader::event::strategy_kind::staged_read,
+                              emel::io::loader::event::strategy_kind::async_read}) {
+    CAPTURE(static_cast<uint32_t>(strategy));
+    owner_state owner{};
+    std::vector<uint32_t> completed{};
+    std::array<char, 3> first_target{};
+    std::array<char, 4> second_target{};
+    const std::array<emel::io::loader::event::tensor_load_span, 2> tensors{{
+        {
+            .tensor_id = 23,
+            .file_offset = 1u,
+            .byte_size = first_target.size(),
+            .file_path = path_str,
+            .target = first_target.data(),
+            .target_bytes = first_target.size(),
+        },
+        {
+            .tensor_id = 24,
+            .file_offset = 5u,
+            .byte_size = second_target.size(),
+            .file_path = path_str,
+            .target = second_target.data(),
+            .target_bytes = second_target.size(),
+        },
+    }};
+    const emel::io::loader::event::strategy_policy policy{
+        .strategy = strategy,
+        .batch = emel::io::loader::event::batch_mode::parallel,
+    };
+    emel::io::loader::event::load_tensor_batch request{tensors, policy};
+    request.on_done = {&owner, on_load_batch_done};
+    request.on_error = {&owner, on_load_batch_error};
+    request.on_tensor_done = {
+        &completed,
+        [](void *object,
+           const emel::io::loader::events::load_tensor_batch_tensor_done &ev)
+            noexcept {
+          static_cast<std::vector<uint32_t> *>(object)->push_back(
+              ev.tensor_index);
+        }};
+
+    CHECK(loader.process_event(request));
+    CHECK(owner.done);
+    CHECK(owner.strategy == strategy);
+    CHECK(owner.done_count == tensors.size());
+    CHECK(owner.bytes_done == first_target.size() + second_target.size());
+    CHECK(std::string_view{first_target.data(), first_target.size()} == "bcd");
+    CHECK(std::string_view{second_target.data(), second_target.size()} ==
+          "fghi");
+    CHECK(completed == std::vector<uint32_t>{0u, 1u});
+  }
+  std::filesystem::remove(path);
+}
+
+TEST_CASE("io loader parallel copy batch fails closed without async actor") {
+  emel::io::read::sm read_actor{};
+  emel::io::loader::sm loader{{.io_read = &read_actor}};
+  owner_state owner{};
+  constexpr char source[] = "abcdef";
+  std::array<char, 3> target{};
+  const std::array<emel::io::loader::event::tensor_load_span, 1> tensors{{
+      {
+          .tensor_id = 25,
+          .file_offset = 1u,
+          .byte_size = target.size(),
+          .file_path = "fixtures.bin",
+          .source_buffer = source,
+          .source_buffer_bytes = sizeof(source) - 1u,
+          .target = target.data(),
+          .target_bytes = target.size(),
+      },
+  }};
+  const emel::io::loader::event::strategy_policy policy{
+      .strategy = emel::io::loader::event::strategy_kind::read_copy,
+      .batch = emel::io::loader::event::batch_mode::parallel,
+  };
+  emel::io::loader::event::load_tensor_batch request{tensors, policy};
+  request.on_done = {&owner, on_load_batch_done};
+  request.on_error = {&owner, on_load_batch_error};
+
+  CHECK_FALSE(loader.process_event(request));
+  CHECK(owner.error);
+  CHECK(owner.err ==
+        emel::error::cast(emel::io::loader::error::unsupported_strategy));
+  CHECK(loader.is(stateforward::sml::state<emel::io::loader::state_ready>));
+}
+
+TEST_CASE("io loader async-read tensor reports strategy failures") {
+  emel::io::async_read::sm async_actor{};
+  emel::io::loader::sm loader{{.io_async_read = &async_actor}};
+  owner_state owner{};
+  const std::string missing =
+      (std::filesystem::temp_directory_path() /
+       "emel_io_loader_async_read_missing.bin")
+          .string();
+  std::filesystem::remove(missing);
+  std::array<char, 4> target{};
+  const emel::io::loader::event::tensor_load_span tensor{
+      .tensor_id = 22,
+      .byte_size = target.size(),
+      .file_path = missing,
+      .target = target.data(),
+      .target_bytes = target.size(),
+  };
+  const emel::io::loader::event::strategy_policy policy{
+      emel::io::loader::event::strategy_kind::async_read,
+  };
+  emel::io::loader::event::load_tensor request{tensor, policy};
+  request.on_done = {&owner, on_load_done};
+  request.on_error = {&owner, on_load_error};
+
+  CHECK_FALSE(loader.process_event(request));
+  CHECK_FALSE(owner.done);
+  CHECK(owner.error);
+  CHECK(owner.strategy_err ==
+        emel::error::cast(emel::io::async_read::error::file_open_failed));
+  CHECK(loader.is(stateforward::sml::state<emel::io::loader::state_ready>));
+}
+
 TEST_CASE("io loader read copy batch fails closed without read actor") {
   emel::io::loader::sm loader{};
   owner_state owner{};
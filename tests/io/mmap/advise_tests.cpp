@@ -13,8 +13,9 @@
 #include "emel/io/mmap/sm.hpp"
 
 // Coverage for the advise_mapping surface: access-pattern hints on a live
-// mapping (sequential readahead, willneed prefetch, dontneed release) with the
-// validation chain handle -> ownership -> range -> platform -> kind routing.
+// mapping (sequential readahead, willneed prefetch, dontneed release, huge-page
+// promotion) with the validation chain handle -> ownership -> range ->
+// platform -> kind routing.
 
 namespace {
 
@@ -130,6 +131,14 @@ TEST_CASE("io mmap advise applies each hint kind to a live mapping") {
                         emel::io::mmap::event::advice::k_dontneed));
   CHECK(dontneed_owner.done);
 
+  // Huge-page advice succeeds whether or not the host kernel can promote the
+  // span: unavailable huge pages fall back to base pages, not an error.
+  advise_owner_state hugepage_owner{};
+  CHECK(dispatch_advise(fixture, hugepage_owner, fixture.map_owner.handle, 0u,
+                        8192u, emel::io::mmap::event::advice::k_hugepage));
+  CHECK(hugepage_owner.done);
+  CHECK_FALSE(hugepage_owner.error);
+
   CHECK(fixture.strategy.is(
       stateforward::sml::state<emel::io::mmap::state_ready>));
 }
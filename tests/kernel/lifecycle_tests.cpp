@@ -309,6 +309,8 @@ TEST_CASE("kernel_mul_mat_argmax_accepts_q8_0_weights") {
         doctest::Approx(q8_0_unit * q8_0_unit * static_cast<float>(QK8_0)).epsilon(1.0e-6f));
 }
 
+}
+
 TEST_CASE("kernel_mul_mat_rejects_packed_q6_q8_requests_without_explicit_simd_route") {
   using emel::kernel::detail::quant::QK_K;
   constexpr uint64_t k_rows = 8u;
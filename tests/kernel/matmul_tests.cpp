@@ -492,6 +492,56 @@ TEST_CASE("parallel matmul explicitly dispatches two and four lane bodies") {
   check_fixed_parallel_lane_count(4u);
 }
 
+TEST_CASE("matmul lanes read src0 through configured weight replicas") {
+  // 2 MiB of f32 weights: the smallest span the replica table accepts.
+  constexpr int32_t rows = 1024;
+  constexpr int32_t cols = 512;
+  std::vector<float> weights(static_cast<size_t>(rows * cols), 0.25f);
+  std::vector<float> input(static_cast<size_t>(cols), 0.5f);
+  std::vector<float> output(static_cast<size_t>(rows), 0.0f);
+  auto record = make_tensor_record(weights.data(),
+                                   emel::kernel::detail::dtype_f32, cols, rows);
+  gen_detail::tensor_matrix matrix{&record, rows, cols};
+  emel::kernel::event::op_mul_mat request{
+      .src0 = gen_detail::make_src_view(matrix),
+      .src1 = gen_detail::make_src_view(input.data(), 1u, input.size()),
+      .dst = gen_detail::make_dst_view(output.data(), 1u, output.size()),
+  };
+
+  // Force two nodes so single-socket hosts still materialize the copies,
+  // then clobber the original: only the replicas hold the real weights.
+  emel::memory::numa::replica_table replicas = {};
+  replicas.reset(emel::memory::numa::k_unlimited_replica_budget, 0b11u);
+  REQUIRE(replicas.add(record.data, record.data_size));
+  std::fill(weights.begin(), weights.end(), -1.0f);
+
+  matmul::lane_pool pool = {};
+  const auto policy = matmul::make_execution_policy(
+      pool, emel::kernel::detect_host_kind(), 4u);
+  matmul::sm actor{policy};
+  REQUIRE(actor.process_event(
+      matmul::event::configure_weight_replicas{&replicas}));
+
+  matmul::event::dispatch_result result = {};
+  bool accepted = false;
+  const matmul::event::execute_parallel run{request, result, accepted};
+  REQUIRE(actor.process_event(run));
+  REQUIRE(accepted);
+  CHECK(std::all_of(output.begin(), output.end(),
+                    [](const float value) { return value == 64.0f; }));
+
+  const matmul::event::execute_serial serial{request, result, accepted};
+  std::fill(output.begin(), output.end(), 0.0f);
+  REQUIRE(actor.process_event(serial));
+  CHECK(std::all_of(output.begin(), output.end(),
+                    [](const float value) { return value == 64.0f; }));
+
+  REQUIRE(actor.process_event(matmul::event::configure_weight_replicas{}));
+  REQUIRE(actor.process_event(serial));
+  CHECK(std::all_of(output.begin(), output.end(),
+                    [](const float value) { return value == -256.0f; }));
+}
+
 TEST_CASE(
     "parallel matmul partial submission rejection drains accepted workers") {
   constexpr int32_t rows = 8;
@@ -0,0 +1,151 @@
+#include "doctest/doctest.h"
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+#include "test_helpers.hpp"
+#include "emel/kernel/any.hpp"
+#include "emel/kernel/events.hpp"
+#include "emel/kernel/profile.hpp"
+
+namespace {
+
+namespace profile = emel::kernel::profile;
+using emel::kernel::event::dtype;
+
+struct fake_counters {
+  profile::counters now = {};
+  bool fail = false;
+};
+
+bool fake_read(void *owner, profile::counters &out) noexcept {
+  auto &source = *static_cast<fake_counters *>(owner);
+  source.now.cycles += 100u;
+  source.now.instructions += 40u;
+  source.now.llc_misses += 2u;
+  out = source.now;
+  return !source.fail;
+}
+
+emel::kernel::event::op_mul_mat make_mul_mat(const float *lhs, const float *rhs,
+                                             float *out, const uint64_t cols,
+                                             const uint64_t rows) {
+  emel::kernel::event::op_mul_mat ev{};
+  ev.src0.data = lhs;
+  ev.src0.type = dtype::f32;
+  ev.src0.ne = {cols, rows, 1u, 1u};
+  ev.src0.nb = {sizeof(float), cols * sizeof(float), rows * cols * sizeof(float),
+                rows * cols * sizeof(float)};
+  ev.src1.data = rhs;
+  ev.src1.type = dtype::f32;
+  ev.src1.ne = {cols, 1u, 1u, 1u};
+  ev.src1.nb = {sizeof(float), cols * sizeof(float), cols * sizeof(float),
+                cols * sizeof(float)};
+  ev.dst.data = out;
+  ev.dst.type = dtype::f32;
+  ev.dst.ne = {rows, 1u, 1u, 1u};
+  ev.dst.nb = {sizeof(float), rows * sizeof(float), rows * sizeof(float),
+               rows * sizeof(float)};
+  return ev;
+}
+
+}  // namespace
+
+TEST_CASE("kernel_profile charges counter deltas and source bytes to route and stage") {
+  fake_counters source{};
+  auto recorder = std::make_unique<profile::recorder>();
+  profile::reset(*recorder, fake_read, &source);
+
+  std::array<float, 8> lhs = {};
+  std::array<float, 4> rhs = {};
+  std::array<float, 2> out = {};
+  const auto ev = make_mul_mat(lhs.data(), rhs.data(), out.data(), 4u, 2u);
+
+  profile::attribute(recorder.get(), 3, profile::stage::feed_forward);
+  profile::mark opened = profile::begin(recorder.get());
+  REQUIRE(opened.armed);
+  profile::end(recorder.get(), emel::kernel::kernel_kind::x86_64, ev, opened);
+  opened = profile::begin(recorder.get());
+  profile::end(recorder.get(), emel::kernel::kernel_kind::x86_64, ev, opened);
+
+  REQUIRE(recorder->route_count == 1u);
+  const profile::route_sample &route = recorder->routes[0];
+  CHECK(route.key.op == emel::kernel::op_id::op_mul_mat);
+  CHECK(route.key.src0 == dtype::f32);
+  CHECK(route.total.calls == 2u);
+  CHECK(route.total.cycles == 200u);
+  CHECK(route.total.instructions == 80u);
+  CHECK(route.total.llc_misses == 4u);
+  CHECK(route.total.bytes_read == 2u * (sizeof(lhs) + sizeof(rhs)));
+
+  const profile::totals &stage =
+      profile::stage_totals(*recorder, 3, profile::stage::feed_forward);
+  CHECK(stage.calls == 2u);
+  CHECK(stage.cycles == 200u);
+  CHECK(profile::stage_totals(*recorder, 3, profile::stage::logits).calls == 0u);
+}
+
+TEST_CASE("kernel_profile scope restores unattributed and a failed read drops the sample") {
+  fake_counters source{};
+  auto recorder = std::make_unique<profile::recorder>();
+  profile::reset(*recorder, fake_read, &source);
+  {
+    const profile::scope logits{recorder.get(), -1, profile::stage::logits};
+    CHECK(recorder->current == profile::stage::logits);
+  }
+  CHECK(recorder->current == profile::stage::unattributed);
+  CHECK(recorder->layer == -1);
+
+  std::array<float, 4> data = {};
+  const auto ev = make_mul_mat(data.data(), data.data(), data.data(), 2u, 2u);
+  const profile::mark opened = profile::begin(recorder.get());
+  source.fail = true;
+  profile::end(recorder.get(), emel::kernel::kernel_kind::x86_64, ev, opened);
+  CHECK(recorder->dropped == 1u);
+  CHECK(recorder->route_count == 0u);
+  CHECK_FALSE(profile::begin(recorder.get()).armed);
+}
+
+TEST_CASE("kernel_profile is inert without a recorder") {
+  CHECK_FALSE(profile::begin(nullptr).armed);
+  profile::attribute(nullptr, 0, profile::stage::attention);
+  const profile::scope unprofiled{nullptr, 0, profile::stage::attention};
+  CHECK(profile::stage_name(profile::stage::attention_output) == "attention_output");
+  CHECK(profile::stage_name(profile::stage::count).empty());
+  CHECK(emel::kernel::op_name(emel::kernel::op_id::op_mul_mat) == "op_mul_mat");
+}
+
+TEST_CASE("kernel_any profiles the ops it dispatches once a recorder is attached") {
+  using emel::kernel::test::make_dst;
+  using emel::kernel::test::make_src;
+  fake_counters source{};
+  auto recorder = std::make_unique<profile::recorder>();
+  profile::reset(*recorder, fake_read, &source);
+
+  std::array<float, 4> lhs = {1.0f, 2.0f, 3.0f, 4.0f};
+  std::array<float, 4> rhs = {0.5f, 0.5f, 0.5f, 0.5f};
+  std::array<float, 4> out = {};
+  const emel::kernel::event::op_add ev{
+      .src0 = make_src(lhs.data(), dtype::f32, 4u),
+      .src1 = make_src(rhs.data(), dtype::f32, 4u),
+      .dst = make_dst(out.data(), dtype::f32, 4u),
+  };
+
+  emel::kernel::sm machine{};
+  CHECK(machine.process_event(ev));
+  CHECK(recorder->route_count == 0u);
+
+  CHECK(machine.process_event(emel::kernel::event::configure_profile{recorder.get()}));
+  CHECK(machine.profiler() == recorder.get());
+  CHECK(machine.process_event(ev));
+  REQUIRE(recorder->route_count == 1u);
+  CHECK(recorder->routes[0].key.op == emel::kernel::op_id::op_add);
+  CHECK(recorder->routes[0].key.kind == machine.kind());
+  CHECK(recorder->routes[0].total.calls == 1u);
+  CHECK(out[3] == 4.5f);
+
+  CHECK(machine.process_event(emel::kernel::event::configure_profile{}));
+  CHECK(machine.process_event(ev));
+  CHECK(recorder->routes[0].total.calls == 1u);
+}
@@ -0,0 +1,119 @@
+#include "doctest/doctest.h"
+
+#include <array>
+#include <cstdint>
+
+#include "emel/kernel/detail.hpp"
+#include "emel/kernel/events.hpp"
+#include "emel/kernel/roofline.hpp"
+
+namespace {
+
+namespace roofline = emel::kernel::roofline;
+using emel::kernel::detail::quant::block_q8_0;
+using emel::kernel::detail::quant::QK8_0;
+using emel::kernel::event::dtype;
+using emel::kernel::event::tensor_view;
+using emel::kernel::event::tensor_view_mut;
+
+template <class view_type>
+void set_dense(view_type &view, const dtype type, const uint64_t elem_size,
+               const uint64_t ne0, const uint64_t ne1, const uint64_t ne2 = 1u) {
+  view.type = type;
+  view.ne = {ne0, ne1, ne2, 1u};
+  view.nb[0] = elem_size;
+  view.nb[1] = elem_size * ne0;
+  view.nb[2] = view.nb[1] * ne1;
+  view.nb[3] = view.nb[2] * ne2;
+}
+
+}  // namespace
+
+TEST_CASE("kernel_roofline charges a quantized gemv its packed weight bytes") {
+  constexpr uint64_t k = 2u * QK8_0;
+  constexpr uint64_t m = 3u;
+  std::array<block_q8_0, 2u * m> weights = {};
+  std::array<float, k> input = {};
+  std::array<float, m> output = {};
+
+  emel::kernel::event::op_mul_mat ev{};
+  ev.src0.data = weights.data();
+  ev.src0.type = dtype::q8_0;
+  ev.src0.ne = {k, m, 1u, 1u};
+  ev.src0.nb = {1u, 2u * sizeof(block_q8_0), sizeof(weights), sizeof(weights)};
+  // Generator vector layout: [1, k] input, [1, m] output.
+  ev.src1.data = input.data();
+  set_dense(ev.src1, dtype::f32, sizeof(float), 1u, k);
+  ev.dst.data = output.data();
+  set_dense(ev.dst, dtype::f32, sizeof(float), 1u, m);
+
+  const roofline::cost cost = roofline::op_cost(ev);
+  CHECK(cost.flops == 2u * k * m);
+  CHECK(cost.bytes == sizeof(weights) + sizeof(input) + sizeof(output));
+}
+
+TEST_CASE("kernel_roofline charges flash attention the active window only") {
+  constexpr uint64_t head_dim = 8u;
+  constexpr uint64_t heads = 2u;
+  constexpr uint64_t capacity = 16u;
+  constexpr uint64_t active = 5u;
+  std::array<float, head_dim * heads> q = {};
+  std::array<uint16_t, head_dim * capacity * heads> k_cache = {};
+  std::array<uint16_t, head_dim * capacity * heads> v_cache = {};
+  std::array<float, head_dim * heads> out = {};
+
+  emel::kernel::event::op_flash_attn_ext ev{};
+  ev.src0.data = q.data();
+  set_dense(ev.src0, dtype::f32, sizeof(float), head_dim, 1u, heads);
+  const auto strided_window = [&](tensor_view &view, const void *data) {
+    view.data = data;
+    view.type = dtype::f16;
+    view.ne = {head_dim, active, heads, 1u};
+    view.nb = {sizeof(uint16_t), head_dim * sizeof(uint16_t),
+               capacity * head_dim * sizeof(uint16_t),
+               heads * capacity * head_dim * sizeof(uint16_t)};
+  };
+  strided_window(ev.src1, k_cache.data());
+  strided_window(ev.src2, v_cache.data());
+  ev.dst.data = out.data();
+  set_dense(ev.dst, dtype::f32, sizeof(float), head_dim, 1u, heads);
+
+  const roofline::cost cost = roofline::op_cost(ev);
+  CHECK(cost.flops == heads * active * (4u * head_dim + 5u));
+  CHECK(cost.bytes == sizeof(q) + sizeof(out) +
+                          2u * head_dim * active * heads * sizeof(uint16_t));
+}
+
+TEST_CASE("kernel_roofline counts rows for norms and gathers for get_rows") {
+  std::array<float, 16> input = {};
+  std::array<float, 16> output = {};
+  emel::kernel::event::op_rms_norm norm{};
+  norm.src0.data = input.data();
+  set_dense(norm.src0, dtype::f32, sizeof(float), 16u, 1u);
+  norm.dst.data = output.data();
+  set_dense(norm.dst, dtype::f32, sizeof(float), 16u, 1u);
+  const roofline::cost norm_cost = roofline::op_cost(norm);
+  CHECK(norm_cost.flops == 3u * 16u);
+  CHECK(norm_cost.bytes == 2u * sizeof(input));
+
+  std::array<float, 4u * 8u> table = {};
+  std::array<int32_t, 2> rows = {1, 3};
+  std::array<float, 2u * 8u> gathered = {};
+  emel::kernel::event::op_get_rows gather{};
+  gather.src0.data = table.data();
+  set_dense(gather.src0, dtype::f32, sizeof(float), 8u, 4u);
+  gather.src1.data = rows.data();
+  set_dense(gather.src1, dtype::i32, sizeof(int32_t), 2u, 1u);
+  gather.dst.data = gathered.data();
+  set_dense(gather.dst, dtype::f32, sizeof(float), 8u, 2u);
+  const roofline::cost gather_cost = roofline::op_cost(gather);
+  CHECK(gather_cost.flops == 0u);
+  CHECK(gather_cost.bytes == 2u * sizeof(gathered) + sizeof(rows));
+
+  roofline::cost total{};
+  roofline::accumulate(total, norm_cost);
+  roofline::accumulate(total, gather_cost);
+  CHECK(total.flops == norm_cost.flops);
+  CHECK(total.bytes == norm_cost.bytes + gather_cost.bytes);
+  CHECK(roofline::view_bytes(tensor_view_mut{}) == 0u);
+}
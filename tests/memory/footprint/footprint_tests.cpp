@@ -0,0 +1,89 @@
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "emel/memory/footprint.hpp"
+#include "emel/model/data.hpp"
+
+// Coverage for the shared footprint accounting: weights are counted from the
+// tensor records, residency only through the injected probe, and the summary
+// helpers keep mapped weights out of the per-session total.
+
+namespace {
+
+namespace footprint = emel::memory::footprint;
+
+uint64_t half_resident(const void *, const uint64_t size, void *user) noexcept {
+  *static_cast<uint32_t *>(user) += 1u;
+  return size / 2u;
+}
+
+} // namespace
+
+TEST_CASE("footprint counts mapped weights and asks the probe for residency") {
+  auto model = std::make_unique<emel::model::data>();
+  std::array<float, 64> weights = {};
+  model->n_tensors = 3u;
+  model->tensors[0].data = weights.data();
+  model->tensors[0].data_size = 128u;
+  model->tensors[1].data = weights.data() + 32;
+  model->tensors[1].data_size = 64u;
+  // Unloaded records contribute nothing and are never probed.
+  model->tensors[2].data_size = 4096u;
+
+  footprint::report unprobed{};
+  footprint::add_weights(unprobed, *model, {});
+  CHECK(unprobed.mapped_weight_bytes == 192u);
+  CHECK_FALSE(unprobed.weights_probed);
+  CHECK(footprint::untouched_weight_bytes(unprobed) == 0u);
+  CHECK(footprint::resident_bytes(unprobed) == 192u);
+
+  uint32_t probes = 0u;
+  footprint::report probed{};
+  footprint::add_weights(probed, *model, {&half_resident, &probes});
+  CHECK(probes == 2u);
+  CHECK(probed.weights_probed);
+  CHECK(probed.mapped_weight_touched_bytes == 96u);
+  CHECK(footprint::untouched_weight_bytes(probed) == 96u);
+  CHECK(footprint::resident_bytes(probed) == 96u);
+}
+
+TEST_CASE("footprint tokenizer bytes follow what the loader wrote") {
+  auto model = std::make_unique<emel::model::data>();
+  footprint::report out{};
+  footprint::add_model(out, *model, {});
+  const uint64_t empty = out.tokenizer_bytes;
+  CHECK(out.mapped_weight_bytes == 0u);
+
+  auto &vocab = model->vocab_data;
+  vocab.n_tokens = 10u;
+  vocab.token_bytes_used = 40u;
+  vocab.n_merges = 3u;
+  vocab.merge_bytes_used = 12u;
+  out = {};
+  footprint::add_model(out, *model, {});
+  CHECK(out.tokenizer_bytes ==
+        empty + 10u * sizeof(emel::model::data::vocab_entry) + 40u + 12u +
+            3u * 2u * sizeof(uint32_t));
+}
+
+TEST_CASE("footprint session bytes exclude shared mapped weights") {
+  std::vector<float> scratch{};
+  scratch.reserve(100u);
+  const std::array<int32_t, 8> lanes = {};
+  CHECK(footprint::bytes_of(scratch) == 400u);
+  CHECK(footprint::bytes_of(lanes) == 32u);
+
+  footprint::report out{};
+  out.mapped_weight_bytes = 1000u;
+  out.prepared_weight_bytes = 10u;
+  out.kv_cache_bytes = 20u;
+  out.recurrent_state_bytes = 30u;
+  out.scratch_bytes = 40u;
+  out.tokenizer_bytes = 50u;
+  CHECK(footprint::session_bytes(out) == 150u);
+  CHECK(footprint::resident_bytes(out) == 1150u);
+}
@@ -0,0 +1,80 @@
+#include <cstdint>
+#include <cstring>
+#include <utility>
+
+#include <doctest/doctest.h>
+
+#include "emel/memory/huge_pages.hpp"
+
+// Coverage for the huge-page arena: every policy yields an aligned, writable
+// span whatever the host reserves, small requests stay on the heap, and the
+// allocator is interchangeable across policies.
+
+namespace {
+
+namespace huge_pages = emel::memory::huge_pages;
+
+constexpr uint64_t k_arena_bytes = 5u * 1024u * 1024u;
+
+bool huge_page_aligned(const void *base) {
+  return (reinterpret_cast<uintptr_t>(base) % huge_pages::k_huge_page_bytes) ==
+         0u;
+}
+
+} // namespace
+
+TEST_CASE("huge page arena serves every policy with a fallback backing") {
+  for (const auto requested :
+       {huge_pages::policy::none, huge_pages::policy::transparent,
+        huge_pages::policy::explicit_pages}) {
+    const huge_pages::allocation block =
+        huge_pages::allocate(k_arena_bytes, requested);
+    REQUIRE(block.base != nullptr);
+    CHECK(huge_page_aligned(block.base));
+    CHECK(block.kind != huge_pages::backing::unavailable);
+    CHECK(block.kind != huge_pages::backing::heap);
+    std::memset(block.base, 0x5a, static_cast<size_t>(k_arena_bytes));
+    huge_pages::release(block.base, k_arena_bytes);
+  }
+
+  const huge_pages::allocation plain =
+      huge_pages::allocate(k_arena_bytes, huge_pages::policy::none);
+  REQUIRE(plain.base != nullptr);
+  CHECK(plain.kind == huge_pages::backing::base_pages);
+  huge_pages::release(plain.base, k_arena_bytes);
+}
+
+TEST_CASE("huge page arena keeps small requests on the heap") {
+  const huge_pages::allocation block =
+      huge_pages::allocate(256u, huge_pages::policy::explicit_pages);
+  REQUIRE(block.base != nullptr);
+  CHECK(block.kind == huge_pages::backing::heap);
+  huge_pages::release(block.base, 256u);
+
+  CHECK(huge_pages::allocate(0u, huge_pages::policy::transparent).base ==
+        nullptr);
+  huge_pages::release(nullptr, k_arena_bytes);
+  CHECK(huge_pages::mapped_bytes_for(1u) == huge_pages::k_huge_page_bytes);
+  CHECK(huge_pages::mapped_bytes_for(huge_pages::k_huge_page_bytes) ==
+        huge_pages::k_huge_page_bytes);
+}
+
+TEST_CASE("huge page vectors grow, shrink and move across policies") {
+  huge_pages::vector<uint16_t> cache(
+      huge_pages::allocator<uint16_t>{huge_pages::policy::explicit_pages});
+  cache.resize(3u * 1024u * 1024u, 1u);
+  CHECK(huge_page_aligned(cache.data()));
+  cache[12345u] = 7u;
+  cache.resize(16u);
+  cache.shrink_to_fit();
+  CHECK(cache.size() == 16u);
+
+  huge_pages::vector<uint16_t> other(
+      huge_pages::allocator<uint16_t>{huge_pages::policy::none});
+  other = std::move(cache);
+  CHECK(other.size() == 16u);
+  CHECK(other.get_allocator().requested ==
+        huge_pages::policy::explicit_pages);
+  CHECK(huge_pages::allocator<uint8_t>{} ==
+        huge_pages::allocator<uint16_t>{huge_pages::policy::none});
+}
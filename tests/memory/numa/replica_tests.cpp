@@ -0,0 +1,116 @@
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "emel/memory/huge_pages.hpp"
+#include "emel/memory/numa.hpp"
+#include "emel/memory/numa_replicas.hpp"
+
+// Coverage for NUMA placement: the node probe always reports a usable set,
+// placement degrades to first touch on any host, and the replica table
+// translates registered spans offset-exactly while leaving everything else
+// untouched. Node masks are forced so single-node hosts exercise the copies.
+
+namespace {
+
+namespace huge_pages = emel::memory::huge_pages;
+namespace numa = emel::memory::numa;
+
+constexpr uint64_t k_span_bytes = 3u * 1024u * 1024u;
+constexpr uint32_t k_two_nodes = 0b11u;
+
+std::vector<uint8_t> make_span(const uint64_t bytes, const uint8_t seed) {
+  std::vector<uint8_t> span(static_cast<size_t>(bytes));
+  for (size_t index = 0; index < span.size(); ++index) {
+    span[index] = static_cast<uint8_t>(index * 31u + seed);
+  }
+  return span;
+}
+
+} // namespace
+
+TEST_CASE("numa probe reports at least one node and a node within it") {
+  CHECK(numa::node_count() >= 1u);
+  CHECK((numa::allowed_node_mask() & (1u << numa::current_node())) != 0u);
+  CHECK_FALSE(numa::apply(nullptr, k_span_bytes, {}));
+
+  const huge_pages::allocation block = huge_pages::allocate(
+      k_span_bytes, huge_pages::policy::transparent,
+      numa::placement{.mode = numa::placement::kind::interleave});
+  REQUIRE(block.base != nullptr);
+  std::memset(block.base, 0x5a, static_cast<size_t>(k_span_bytes));
+  huge_pages::release(block.base, k_span_bytes);
+}
+
+TEST_CASE("numa replica table resolves registered spans per node") {
+  const std::vector<uint8_t> weights = make_span(k_span_bytes, 7u);
+  numa::replica_table table{};
+  table.reset(numa::k_unlimited_replica_budget, k_two_nodes);
+  REQUIRE(table.add(weights.data(), weights.size()));
+  CHECK(table.region_count() == 1u);
+  CHECK(table.replicated_bytes() == 2u * k_span_bytes);
+
+  const uint8_t *inside = weights.data() + 12345u;
+  for (uint32_t node = 0; node < 2u; ++node) {
+    const auto *local = static_cast<const uint8_t *>(table.resolve(inside, node));
+    CHECK(local != inside);
+    CHECK(std::memcmp(local, inside, 4096u) == 0);
+  }
+  CHECK(table.resolve(inside, 0u) != table.resolve(inside, 1u));
+  CHECK(table.resolve(inside, 2u) == inside);
+  CHECK(table.resolve(weights.data() + weights.size(), 0u) ==
+        weights.data() + weights.size());
+  int unrelated = 0;
+  CHECK(table.resolve(&unrelated, 0u) == &unrelated);
+  CHECK(table.resolve_local(&unrelated) == &unrelated);
+
+  CHECK_FALSE(table.add(weights.data() + 4096u, huge_pages::k_arena_min_bytes));
+  CHECK(table.region_count() == 1u);
+}
+
+TEST_CASE("numa replica table honours its budget and node mask") {
+  const std::vector<uint8_t> first = make_span(k_span_bytes, 1u);
+  const std::vector<uint8_t> second = make_span(k_span_bytes, 2u);
+  numa::replica_table table{};
+  table.reset(3u * k_span_bytes, k_two_nodes);
+  CHECK(table.add(first.data(), first.size()));
+  CHECK_FALSE(table.add(second.data(), second.size()));
+  CHECK(table.resolve(second.data(), 1u) == second.data());
+
+  table.reset(0u, k_two_nodes);
+  CHECK_FALSE(table.add(first.data(), first.size()));
+  CHECK(table.replicated_bytes() == 0u);
+
+  table.reset(numa::k_unlimited_replica_budget, 0b1u);
+  CHECK(table.region_count() == 0u);
+  CHECK_FALSE(table.add(first.data(), first.size()));
+  CHECK_FALSE(table.add(first.data(), huge_pages::k_arena_min_bytes - 1u));
+  CHECK(table.resolve(first.data(), 0u) == first.data());
+}
+
+TEST_CASE("numa replica table keeps spans ordered and drops copies on reset") {
+  const std::vector<uint8_t> low = make_span(k_span_bytes, 3u);
+  const std::vector<uint8_t> high = make_span(k_span_bytes, 4u);
+  const bool low_first = low.data() < high.data();
+  const std::vector<uint8_t> &first = low_first ? high : low;
+  const std::vector<uint8_t> &second = low_first ? low : high;
+  numa::replica_table table{};
+  table.reset(numa::k_unlimited_replica_budget, k_two_nodes);
+  REQUIRE(table.add(first.data(), first.size()));
+  REQUIRE(table.add(second.data(), second.size()));
+  CHECK(table.region_count() == 2u);
+
+  for (const auto *span : {&first, &second}) {
+    const uint8_t *inside = span->data() + 777u;
+    const auto *local = static_cast<const uint8_t *>(table.resolve(inside, 1u));
+    CHECK(local != inside);
+    CHECK(std::memcmp(local, inside, 4096u) == 0);
+  }
+
+  table.reset(numa::k_unlimited_replica_budget, k_two_nodes);
+  CHECK(table.region_count() == 0u);
+  CHECK(table.replicated_bytes() == 0u);
+  CHECK(table.resolve(first.data(), 1u) == first.data());
+}
@@ -0,0 +1,102 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <string_view>
+#include <utility>
+
+#include "emel/model/data.hpp"
+#include "emel/model/lazy_array.hpp"
+
+TEST_CASE("lazy_array reads zero until first write") {
+  const emel::model::lazy_array<uint32_t, 1024> values{};
+  CHECK_FALSE(values.materialized());
+  CHECK(values.size() == 1024u);
+  CHECK(values[0] == 0u);
+  CHECK(values[1023] == 0u);
+  CHECK_FALSE(values.materialized());
+}
+
+TEST_CASE("lazy_array copies and moves reserved blocks") {
+  emel::model::lazy_array<uint32_t, 64> source{};
+  emel::model::lazy_array<uint32_t, 64> untouched{};
+
+  emel::model::lazy_array<uint32_t, 64> copy_of_untouched = untouched;
+  CHECK_FALSE(copy_of_untouched.materialized());
+
+  source[3] = 7u;
+  CHECK(source.materialized());
+  emel::model::lazy_array<uint32_t, 64> copy = source;
+  CHECK(copy[3] == 7u);
+  copy[3] = 9u;
+  CHECK(source[3] == 7u);
+
+  copy = untouched;
+  CHECK_FALSE(copy.materialized());
+  CHECK(std::as_const(copy)[3] == 0u);
+
+  emel::model::lazy_array<uint32_t, 64> moved = std::move(source);
+  CHECK(moved[3] == 7u);
+  CHECK_FALSE(source.materialized());
+
+  const std::span<const uint32_t> view{std::as_const(moved)};
+  CHECK(view.size() == 64u);
+  CHECK(view[3] == 7u);
+}
+
+TEST_CASE("model data leaves untouched tables unreserved") {
+  auto model = std::make_unique<emel::model::data>();
+  CHECK_FALSE(model->tensors.materialized());
+  CHECK_FALSE(model->vocab_data.entries.materialized());
+  CHECK_FALSE(model->vocab_data.merge_storage.materialized());
+  CHECK_FALSE(model->meta.blob.materialized());
+
+  constexpr std::string_view name = "mel_filters";
+  for (size_t i = 0; i < name.size(); ++i) {
+    model->name_storage[i] = name[i];
+  }
+  model->name_bytes_used = static_cast<uint32_t>(name.size());
+  model->tensors[0].name_length = static_cast<uint32_t>(name.size());
+  model->n_tensors = 1u;
+  emel::model::build_tensor_name_index(*model);
+
+  const auto &view = *model;
+  CHECK(emel::model::find_tensor(view, name) == &view.tensors[0]);
+  CHECK_FALSE(model->vocab_data.entries.materialized());
+  CHECK_FALSE(model->vocab_data.token_storage.materialized());
+}
+
+TEST_CASE("lazy_array reserves once and keeps the block") {
+  emel::model::lazy_array<uint32_t, 256> values{};
+  REQUIRE(values.reserve());
+  const uint32_t *block = std::as_const(values).data();
+  CHECK(values.reserve());
+  values[7] = 5u;
+  CHECK(values.data() == block);
+  CHECK(std::as_const(values)[7] == 5u);
+}
+
+TEST_CASE("model reserve_tables follows the gguf header counts") {
+  auto model = std::make_unique<emel::model::data>();
+  CHECK_FALSE(emel::model::reserve_tables(
+      *model, static_cast<uint32_t>(emel::model::data::k_max_tensors) + 1u, 0u));
+
+  REQUIRE(emel::model::reserve_tables(*model, 4u, 0u));
+  CHECK(model->tensors.materialized());
+  CHECK(model->name_storage.materialized());
+  CHECK(model->tensor_name_index.materialized());
+  CHECK_FALSE(model->meta.blob.materialized());
+  CHECK_FALSE(model->vocab_data.entries.materialized());
+
+  REQUIRE(emel::model::reserve_tables(*model, 4u, 12u));
+  CHECK(model->meta.blob.materialized());
+  CHECK(model->vocab_data.entries.materialized());
+  CHECK(model->vocab_data.pieces.materialized());
+
+  const auto *entries = std::as_const(model->vocab_data.entries).data();
+  model->vocab_data.n_tokens = 3u;
+  emel::model::reset_vocab(model->vocab_data);
+  CHECK(model->vocab_data.n_tokens == 0u);
+  CHECK(std::as_const(model->vocab_data.entries).data() == entries);
+}
@@ -0,0 +1,74 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "emel/model/data.hpp"
+#include "emel/model/detail.hpp"
+#include "emel/model/load_profile.hpp"
+
+namespace {
+
+namespace load_profile = emel::model::load_profile;
+
+uint64_t fake_now = 0u;
+
+uint64_t fake_clock() noexcept {
+  fake_now += 10u;
+  return fake_now;
+}
+
+}  // namespace
+
+TEST_CASE("load_profile accumulates time and bytes per phase") {
+  load_profile::recorder profile{};
+  load_profile::reset(profile, fake_clock);
+
+  uint64_t started = load_profile::start(&profile);
+  load_profile::stop(&profile, load_profile::phase::tensor_read, started, 4096u);
+  started = load_profile::start(&profile);
+  load_profile::stop(&profile, load_profile::phase::tensor_read, started, 1024u);
+  started = load_profile::start(&profile);
+  load_profile::stop(&profile, load_profile::phase::kv_allocate, started, 64u);
+
+  const load_profile::report report = load_profile::make_report(profile);
+  const auto &read = report.phases[static_cast<size_t>(load_profile::phase::tensor_read)];
+  CHECK(read.calls == 2u);
+  CHECK(read.ns == 20u);
+  CHECK(read.bytes == 5120u);
+  CHECK(report.phases[static_cast<size_t>(load_profile::phase::kv_allocate)].calls == 1u);
+  CHECK(report.total_ns == 30u);
+  CHECK(report.total_bytes == 5184u);
+
+  load_profile::reset(profile, fake_clock);
+  CHECK(load_profile::make_report(profile).total_ns == 0u);
+}
+
+TEST_CASE("load_profile is inert without a recorder or clock") {
+  CHECK(load_profile::start(nullptr) == 0u);
+  load_profile::stop(nullptr, load_profile::phase::hparams, 0u, 1u);
+
+  load_profile::recorder unclocked{};
+  CHECK(load_profile::start(&unclocked) == 0u);
+  load_profile::stop(&unclocked, load_profile::phase::hparams, 0u, 1u);
+  load_profile::stop(&unclocked, load_profile::phase::count, 0u, 1u);
+  CHECK(load_profile::make_report(unclocked).total_bytes == 0u);
+}
+
+TEST_CASE("load_profile names every phase") {
+  CHECK(load_profile::phase_name(load_profile::phase::gguf_header) == "gguf_header");
+  CHECK(load_profile::phase_name(load_profile::phase::kv_allocate) == "kv_allocate");
+  CHECK(load_profile::phase_name(load_profile::phase::count).empty());
+}
+
+TEST_CASE("load_profile records the hparams phase through kv_binding") {
+  load_profile::recorder profile{};
+  load_profile::reset(profile, fake_clock);
+  const emel::model::detail::kv_binding binding{.profile = &profile};
+  auto model = std::make_unique<emel::model::data>();
+
+  CHECK_FALSE(emel::model::detail::load_hparams_from_gguf(binding, *model));
+  const auto &hparams = profile.phases[static_cast<size_t>(load_profile::phase::hparams)];
+  CHECK(hparams.calls == 1u);
+  CHECK(hparams.ns == 10u);
+}
@@ -272,6 +272,19 @@ void append_tensor_name(emel::model::data &model,
   tensor.data_size = 64u;
 }
 
+emel::error::type
+parse_named_tensors_ok(void *,
+                       const emel::model::loader::event::load &req) noexcept {
+  auto &model = req.model_data;
+  append_tensor_name(model, model.tensors[0], "token_embd.weight");
+  append_tensor_name(model, model.tensors[1], "blk.0.attn_q.weight");
+  append_tensor_name(model, model.tensors[2], "blk.0.attn_k.weight");
+  append_tensor_name(model, model.tensors[3], "blk.0.attn_q.weight");
+  model.n_tensors = 4;
+  model.n_layers = 1;
+  return emel::error::cast(emel::model::loader::error::none);
+}
+
 void append_tensor_with_shape(emel::model::data &model,
                               emel::model::data::tensor_record &tensor,
                               const std::string_view name,
@@ -1106,6 +1119,49 @@ TEST_CASE("model loader lifecycle succeeds on full load path") {
   CHECK_FALSE(owner.used_mmap);
 }
 
+TEST_CASE("model loader builds the tensor name index after parse") {
+  auto model = std::make_unique<emel::model::data>();
+  emel::model::loader::sm machine{};
+  owner_state owner{};
+  emel::model::loader::event::parse_model_fn parse_model{
+      nullptr, parse_named_tensors_ok};
+  tensor_loader_fixture tensor_loader{};
+
+  uint8_t file_bytes[8] = {};
+  emel::model::loader::event::load request{*model, parse_model};
+  request.file_image = file_bytes;
+  request.file_size = sizeof(file_bytes);
+  tensor_loader.bind(request);
+  request.map_layers = {nullptr, map_layers_ok};
+  request.validate_structure = {nullptr, validate_structure_ok};
+  request.validate_architecture_impl = {nullptr, validate_architecture_ok};
+  request.on_done = {&owner, on_done};
+  request.on_error = {&owner, on_error};
+
+  CHECK(machine.process_event(request));
+  CHECK(owner.done);
+  CHECK(model->tensor_name_index_count == model->n_tensors);
+  CHECK(emel::model::find_tensor(*model, "token_embd.weight") ==
+        &model->tensors[0]);
+  CHECK(emel::model::find_tensor(*model, "blk.0.attn_k.weight") ==
+        &model->tensors[2]);
+  // Duplicate names resolve to the first record, matching a linear scan.
+  CHECK(emel::model::find_tensor(*model, "blk.0.attn_q.weight") ==
+        &model->tensors[1]);
+  CHECK(emel::model::find_tensor(*model, "blk.0.attn_v.weight") == nullptr);
+  CHECK(emel::model::find_tensor(*model, "") == nullptr);
+
+  // Records appended after the build fall back to a scan until re-indexed.
+  append_tensor_name(*model, model->tensors[4], "blk.0.attn_v.weight");
+  model->n_tensors = 5;
+  CHECK(emel::model::find_tensor(*model, "blk.0.attn_v.weight") ==
+        &model->tensors[4]);
+  emel::model::build_tensor_name_index(*model);
+  CHECK(model->tensor_name_index_count == 5u);
+  CHECK(emel::model::find_tensor(*model, "blk.0.attn_v.weight") ==
+        &model->tensors[4]);
+}
+
 TEST_CASE("model loader rejects io strategy when no io actor is bound") {
   auto model = std::make_unique<emel::model::data>();
   emel::model::loader::sm machine{};
@@ -170,6 +170,19 @@ TEST_CASE("tensor window rejects invalid streaming slot configuration") {
   CHECK(fixture.unbind(unbind));
 }
 
+TEST_CASE("tensor window rejects adaptive prefetch without a clock") {
+  stream_file file{"adaptive_no_clock"};
+  window_fixture fixture{};
+  bind_capture capture{};
+
+  CHECK_FALSE(fixture.bind(file, capture, streaming_budget(), /*slots=*/4u,
+                           /*prefetch_depth=*/2u, {}, false,
+                           /*clock=*/nullptr, /*adaptive_prefetch=*/true));
+  CHECK(capture.error);
+  CHECK(capture.err == emel::error::cast(window::error::invalid_request));
+  CHECK(fixture.machine.is(stateforward::sml::state<window::state_unbound>));
+}
+
 namespace {
 
 // Test-owned platform boundary: production ops with unmap overridden to fail
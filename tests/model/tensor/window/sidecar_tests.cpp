@@ -0,0 +1,176 @@
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "emel/model/tensor/window/codec.hpp"
+#include "emel/model/tensor/window/sidecar.hpp"
+#include "window_test_fixture.hpp"
+
+// Compressed streaming coverage: codec round trips and corruption rejection,
+// sidecar image validation, and streamed acquires decoding sidecar extents
+// into slots.
+
+using namespace emel_window_test;
+
+namespace codec = emel::model::tensor::window::codec;
+namespace sidecar = emel::model::tensor::window::sidecar;
+
+namespace {
+
+// Quantized-looking payload: a repeated 2-byte scale then noisy nibbles per
+// 34-byte block, spanning several codec blocks with a partial tail.
+std::vector<uint8_t> make_quantized_payload(const size_t bytes) {
+  std::vector<uint8_t> payload(bytes);
+  uint32_t state = 0x1234567u;
+  for (size_t index = 0; index < bytes; ++index) {
+    state = state * 1103515245u + 12345u;
+    payload[index] = index % 34u < 2u ? static_cast<uint8_t>(0x3cu + index % 2u)
+                                      : static_cast<uint8_t>((state >> 16u) & 0x0fu);
+  }
+  return payload;
+}
+
+// Stands in for emel::model::model_fingerprint() of the fixture's model file.
+constexpr uint64_t k_model_fingerprint = 0x5eed5eed5eed5eedull;
+
+std::vector<uint8_t> read_file(const std::filesystem::path &path) {
+  std::ifstream in{path, std::ios::binary};
+  return {std::istreambuf_iterator<char>{in}, std::istreambuf_iterator<char>{}};
+}
+
+}  // namespace
+
+TEST_CASE("tensor window codec round trips shuffled block streams") {
+  const std::vector<uint8_t> payload =
+      make_quantized_payload(2u * codec::k_block_bytes + 1000u);
+  codec::block_scratch scratch{};
+  for (const uint32_t stride : {1u, 2u, 34u}) {
+    std::vector<uint8_t> stream(codec::stream_bound(payload.size()));
+    const uint64_t stream_bytes = codec::encode_stream(
+        payload.data(), payload.size(), stride, stream.data(), scratch);
+    CHECK(stream_bytes < payload.size());
+
+    std::vector<uint8_t> decoded(payload.size(), 0u);
+    CHECK(codec::decode_stream(stream.data(), stream_bytes, decoded.data(),
+                               decoded.size(), stride, scratch));
+    CHECK(decoded == payload);
+  }
+}
+
+TEST_CASE("tensor window codec rejects truncated and corrupt streams") {
+  const std::vector<uint8_t> payload =
+      make_quantized_payload(codec::k_block_bytes + 77u);
+  codec::block_scratch scratch{};
+  std::vector<uint8_t> stream(codec::stream_bound(payload.size()));
+  const uint64_t stream_bytes = codec::encode_stream(
+      payload.data(), payload.size(), 34u, stream.data(), scratch);
+  std::vector<uint8_t> decoded(payload.size(), 0u);
+
+  CHECK_FALSE(codec::decode_stream(stream.data(), stream_bytes - 1u,
+                                   decoded.data(), decoded.size(), 34u,
+                                   scratch));
+  // A block header claiming more payload than the stream holds.
+  std::vector<uint8_t> corrupt(stream.begin(), stream.begin() + stream_bytes);
+  const uint32_t oversized = static_cast<uint32_t>(stream_bytes);
+  std::memcpy(corrupt.data(), &oversized, sizeof(oversized));
+  CHECK_FALSE(codec::decode_stream(corrupt.data(), corrupt.size(),
+                                   decoded.data(), decoded.size(), 34u,
+                                   scratch));
+  // Decoding into a different extent length must not succeed.
+  CHECK_FALSE(codec::decode_stream(stream.data(), stream_bytes, decoded.data(),
+                                   decoded.size() - 1u, 34u, scratch));
+}
+
+TEST_CASE("tensor window sidecar open rejects mismatched extents") {
+  stream_file file{"sidecar_mismatch"};
+  const std::vector<uint8_t> source = read_file(file.path);
+  std::vector<uint8_t> image(sidecar::image_bytes_bound(file.extents));
+  const uint64_t image_bytes =
+      sidecar::write_image(source, file.extents, {}, k_model_fingerprint,
+                           image);
+  REQUIRE(image_bytes > 0u);
+  image.resize(static_cast<size_t>(image_bytes));
+
+  std::vector<window::detail::weight_extent> shifted = file.extents;
+  shifted[3].file_offset += 1u;
+  CHECK_FALSE(sidecar::open(image, source, k_model_fingerprint, shifted));
+  CHECK(shifted[0].codec == window::detail::extent_codec::raw);
+
+  std::vector<window::detail::weight_extent> fewer(file.extents.begin(),
+                                                   file.extents.end() - 1);
+  CHECK_FALSE(sidecar::open(image, source, k_model_fingerprint, fewer));
+}
+
+TEST_CASE("tensor window sidecar open rejects another model or changed weights") {
+  stream_file file{"sidecar_identity"};
+  const std::vector<uint8_t> source = read_file(file.path);
+  std::vector<uint8_t> image(sidecar::image_bytes_bound(file.extents));
+  const uint64_t image_bytes =
+      sidecar::write_image(source, file.extents, {}, k_model_fingerprint,
+                           image);
+  REQUIRE(image_bytes > 0u);
+  image.resize(static_cast<size_t>(image_bytes));
+
+  std::vector<window::detail::weight_extent> extents = file.extents;
+  CHECK_FALSE(
+      sidecar::open(image, source, k_model_fingerprint + 1u, extents));
+  CHECK(extents[0].codec == window::detail::extent_codec::raw);
+
+  // Same extent table, re-quantized contents: the source probe misses.
+  std::vector<uint8_t> requantized = source;
+  const window::detail::weight_extent &last = file.extents.back();
+  requantized[static_cast<size_t>(last.file_offset + last.byte_size - 1u)] ^=
+      0xffu;
+  CHECK_FALSE(sidecar::open(image, requantized, k_model_fingerprint, extents));
+  CHECK(extents.back().codec == window::detail::extent_codec::raw);
+
+  CHECK(sidecar::open(image, source, k_model_fingerprint, extents));
+}
+
+TEST_CASE("tensor window streams compressed sidecar extents with correct content") {
+  stream_file file{"sidecar_stream"};
+  const std::vector<uint8_t> source = read_file(file.path);
+  std::vector<uint8_t> image(sidecar::image_bytes_bound(file.extents));
+  const uint64_t image_bytes =
+      sidecar::write_image(source, file.extents, {}, k_model_fingerprint,
+                           image);
+  REQUIRE(image_bytes > 0u);
+  // Sentinel-filled weights collapse to a few bytes per codec block.
+  CHECK(image_bytes < file.file_size / 4u);
+  image.resize(static_cast<size_t>(image_bytes));
+  REQUIRE(sidecar::open(image, source, k_model_fingerprint, file.extents));
+
+  const std::filesystem::path sidecar_path =
+      file.path.string() + ".stream";
+  {
+    std::ofstream out{sidecar_path, std::ios::binary | std::ios::trunc};
+    out.write(reinterpret_cast<const char *>(image.data()),
+              static_cast<std::streamsize>(image.size()));
+  }
+  file.path_str = sidecar_path.string();
+  file.file_size = image_bytes;
+
+  {
+    window_fixture fixture{};
+    bind_capture capture{};
+    REQUIRE(fixture.bind(file, capture, streaming_budget()));
+    REQUIRE(capture.streaming_active);
+
+    for (uint32_t pass = 0; pass < 2u; ++pass) {
+      for (uint32_t layer = 0; layer < k_layers; ++layer) {
+        acquire_capture acquire{};
+        CHECK(fixture.acquire(static_cast<int32_t>(layer), acquire));
+        CHECK(acquire.done);
+        CHECK(slot_content_matches(acquire, layer));
+      }
+    }
+
+    unbind_capture unbind{};
+    CHECK(fixture.unbind(unbind));
+  }
+  std::filesystem::remove(sidecar_path);
+}
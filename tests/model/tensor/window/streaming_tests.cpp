@@ -1,3 +1,5 @@
+#include <atomic>
+
 #include <doctest/doctest.h>
 
 #include "window_test_fixture.hpp"
@@ -8,6 +10,17 @@
 
 using namespace emel_window_test;
 
+namespace {
+
+// Test clock: every read advances one millisecond, from any thread.
+std::atomic<uint64_t> g_fake_clock_ns{0u};
+
+uint64_t fake_clock_ns() noexcept {
+  return g_fake_clock_ns.fetch_add(1000u * 1000u) + 1000u * 1000u;
+}
+
+}  // namespace
+
 TEST_CASE("tensor window streams every layer with correct content") {
   stream_file file{"content"};
   window_fixture fixture{};
@@ -91,3 +104,72 @@ TEST_CASE("tensor window unbind joins in-flight prefetch loads") {
   unbind_capture unbind_again{};
   CHECK(fixture.unbind(unbind_again));
 }
+
+TEST_CASE("tensor window adaptive prefetch streams correctly within the ring") {
+  stream_file file{"adaptive"};
+  window_fixture fixture{};
+  bind_capture capture{};
+  REQUIRE(fixture.bind(file, capture, streaming_budget(), /*slots=*/4u,
+                       /*prefetch_depth=*/1u, {}, false, &fake_clock_ns,
+                       /*adaptive_prefetch=*/true));
+  REQUIRE(capture.streaming_active);
+
+  for (uint32_t pass = 0; pass < 3u; ++pass) {
+    for (uint32_t layer = 0; layer < k_layers; ++layer) {
+      acquire_capture acquire{};
+      CHECK(fixture.acquire(static_cast<int32_t>(layer), acquire));
+      CHECK(slot_content_matches(acquire, layer));
+      CHECK(acquire.prefetch_depth >= 1u);
+      CHECK(acquire.prefetch_depth < 4u);
+      CHECK(acquire.stage_chunk_bytes >=
+            window::detail::k_min_stream_chunk_bytes);
+      CHECK(acquire.stage_chunk_bytes <=
+            window::detail::k_max_stream_chunk_bytes);
+    }
+  }
+
+  unbind_capture unbind{};
+  CHECK(fixture.unbind(unbind));
+}
+
+TEST_CASE("tensor window adaptive retune follows load and compute estimates") {
+  window::detail::window_state state{};
+  state.slot_count = 8u;
+  state.adaptive = true;
+  state.prefetch_depth = 2u;
+  state.stage_chunk_bytes = window::detail::k_default_stream_chunk_bytes;
+  state.compute_samples = 1u;
+  state.load_samples = 1u;
+
+  // A load costs three layers of compute: keep three in flight plus the
+  // consumed one, and open the ring advance from the previous depth.
+  state.compute_ns_estimate = 1000u * 1000u;
+  state.load_ns_estimate = 3u * 1000u * 1000u;
+  state.load_bytes_estimate = 2u * 1024u * 1024u;
+  window::detail::retune_adaptive_prefetch(state);
+  CHECK(state.prefetch_depth == 4u);
+  CHECK(state.prefetch_cursor == 2u);
+  // ~700 MB/s copies a 1 MiB chunk inside the 2 ms target, not a 2 MiB one.
+  CHECK(state.stage_chunk_bytes == window::detail::k_min_stream_chunk_bytes);
+
+  // Loads far slower than compute clamp to the ring invariant.
+  state.load_ns_estimate = 100u * 1000u * 1000u;
+  window::detail::retune_adaptive_prefetch(state);
+  CHECK(state.prefetch_depth == 7u);
+  CHECK(state.prefetch_cursor == 4u);
+
+  // Fast loads shrink the lookahead and widen the chunk to the cap.
+  state.load_ns_estimate = 500u * 1000u;
+  state.load_bytes_estimate = 64u * 1024u * 1024u;
+  window::detail::retune_adaptive_prefetch(state);
+  CHECK(state.prefetch_depth == 2u);
+  CHECK(state.prefetch_cursor == 2u);
+  CHECK(state.stage_chunk_bytes == window::detail::k_max_stream_chunk_bytes);
+
+  // Fixed mode keeps the bound configuration and covers only its depth.
+  state.adaptive = false;
+  state.load_ns_estimate = 100u * 1000u * 1000u;
+  window::detail::hold_prefetch(state);
+  CHECK(state.prefetch_depth == 2u);
+  CHECK(state.prefetch_cursor == 2u);
+}
@@ -98,6 +98,8 @@ struct acquire_capture {
   bool error = false;
   const uint8_t *slot_base = nullptr;
   const window::detail::layer_descriptor *layout = nullptr;
+  uint32_t prefetch_depth = 0u;
+  uint64_t stage_chunk_bytes = 0u;
   emel::error::type err = 0u;
 };
 
@@ -107,6 +109,8 @@ inline void on_acquire_done(
   capture->done = true;
   capture->slot_base = ev.slot_base;
   capture->layout = &ev.layout;
+  capture->prefetch_depth = ev.prefetch_depth;
+  capture->stage_chunk_bytes = ev.stage_chunk_bytes;
 }
 
 inline void on_acquire_error(
@@ -181,7 +185,9 @@ struct window_fixture {
             const uint64_t budget_bytes, const uint32_t slots = 4u,
             const uint32_t prefetch_depth = 2u,
             std::span<uint8_t> storage_override = {},
-            const bool use_override = false) {
+            const bool use_override = false,
+            const window::detail::clock_fn clock = nullptr,
+            const bool adaptive_prefetch = false) {
     const window::event::bind_window_request request{
         .file_path = file.path_str,
         .file_size_bytes = file.file_size,
@@ -193,6 +199,8 @@ struct window_fixture {
         .window_slots = slots,
         .prefetch_depth = prefetch_depth,
         .stage_chunk_bytes = window::detail::k_default_stream_chunk_bytes,
+        .adaptive_prefetch = adaptive_prefetch,
+        .clock = clock,
     };
     window::event::bind_window bind_request{request};
     bind_request.on_done = {&capture, on_bind_done};
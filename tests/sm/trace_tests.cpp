@@ -0,0 +1,94 @@
+#include <doctest/doctest.h>
+
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <thread>
+
+#include "emel/trace.hpp"
+
+namespace {
+
+uint64_t g_fake_ns = 0u;
+
+uint64_t fake_clock() noexcept {
+  g_fake_ns += 1500u;
+  return g_fake_ns;
+}
+
+struct traced_model {};
+
+std::string export_json(const emel::trace::session &trace) {
+  std::string json{};
+  emel::trace::export_chrome_json(
+      trace, [&json](const std::string_view chunk) { json.append(chunk); });
+  return json;
+}
+
+}  // namespace
+
+TEST_CASE("trace type_name reads the type out of the signature") {
+  // gcc and clang spell the anonymous namespace differently.
+  CHECK(emel::trace::type_name_v<traced_model>.ends_with("::traced_model"));
+  CHECK(emel::trace::type_name_v<int> == "int");
+}
+
+TEST_CASE("trace exports per-thread rings as chrome trace json") {
+  auto rings = std::make_unique<emel::trace::ring[]>(2u);
+  emel::trace::session trace{};
+  g_fake_ns = 0u;
+  emel::trace::start(trace, &fake_clock, {rings.get(), 2u});
+  emel::trace::stop();
+
+  emel::trace::emit(trace, emel::trace::phase::begin,
+                    emel::trace::category::sm, "model\"x", "event");
+  emel::trace::emit(trace, emel::trace::phase::end, emel::trace::category::sm,
+                    "model\"x");
+  std::thread([&trace] {
+    emel::trace::emit(trace, emel::trace::phase::instant,
+                      emel::trace::category::io, "window/slot_load");
+  }).join();
+  std::thread([&trace] {
+    emel::trace::emit(trace, emel::trace::phase::begin,
+                      emel::trace::category::lane, "dropped");
+  }).join();
+
+  CHECK(rings[0].written.load() == 2u);
+  CHECK(rings[1].written.load() == 1u);
+  CHECK(trace.dropped_threads.load() == 1u);
+  CHECK(export_json(trace) ==
+        "{\"traceEvents\":["
+        "{\"ph\":\"B\",\"cat\":\"sm\",\"pid\":1,\"tid\":0,\"ts\":1.500,"
+        "\"name\":\"model\\\"x\",\"args\":{\"detail\":\"event\"}},"
+        "{\"ph\":\"E\",\"cat\":\"sm\",\"pid\":1,\"tid\":0,\"ts\":3.000,"
+        "\"name\":\"model\\\"x\"},"
+        "{\"ph\":\"i\",\"cat\":\"io\",\"pid\":1,\"tid\":1,\"ts\":4.500,"
+        "\"s\":\"t\",\"name\":\"window/slot_load\"}"
+        "],\"displayTimeUnit\":\"ns\"}\n");
+}
+
+TEST_CASE("trace rings keep the newest records once full") {
+  auto rings = std::make_unique<emel::trace::ring[]>(1u);
+  emel::trace::session trace{};
+  emel::trace::start(trace, &fake_clock, {rings.get(), 1u});
+  emel::trace::stop();
+  for (uint32_t index = 0u; index < emel::trace::k_ring_capacity + 3u;
+       ++index) {
+    emel::trace::emit(trace, emel::trace::phase::instant,
+                      emel::trace::category::kernel, "op");
+  }
+  CHECK(rings[0].written.load() == emel::trace::k_ring_capacity + 3u);
+  const uint64_t newest = rings[0].records[2u].ts_ns;
+  CHECK(newest == rings[0].records[1u].ts_ns + 1500u);
+  CHECK(rings[0].records[3u].ts_ns < rings[0].records[2u].ts_ns);
+
+  // A new session re-claims rings on threads that recorded into the old one.
+  emel::trace::session next{};
+  emel::trace::start(next, &fake_clock, {rings.get(), 1u});
+  emel::trace::stop();
+  CHECK(rings[0].written.load() == 0u);
+  emel::trace::emit(next, emel::trace::phase::instant,
+                    emel::trace::category::kernel, "op");
+  CHECK(rings[0].written.load() == 1u);
+}
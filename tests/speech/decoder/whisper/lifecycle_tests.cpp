@@ -1064,9 +1064,12 @@ TEST_CASE("whisper_decoder_runs_first_q8_token_from_public_event") {
   stop_policy.timestamp_begin = 0;
   stop_policy.space = -7;
   emel::kernel::sm stop_kernel{emel::kernel::detect_host_kind()};
+  decoder::detail::decoder_tensors stop_tensors{};
+  decoder::detail::bind_decoder_tensors(*loaded.decoder_contract.model,
+                                        stop_tensors);
   const uint64_t stop_digest = decoder::detail::run_decoder_sequence<
       decoder::detail::linear_weight_variant::q8_0>(
-      stop_kernel, *loaded.decoder_contract.model, encoded.encoder_state.data(),
+      stop_kernel, stop_tensors, encoded.encoder_state.data(),
       static_cast<uint64_t>(encoded.frames), stop_policy,
       policy.prompt_tokens.data(), policy.prompt_tokens.size(),
       workspace.data(), logits.data(), stop_generated_tokens.data(),
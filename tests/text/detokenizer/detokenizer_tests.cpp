@@ -6,6 +6,7 @@
 #include <doctest/doctest.h>
 
 #include "emel/model/data.hpp"
+#include "emel/text/detokenizer/detail.hpp"
 #include "emel/text/detokenizer/errors.hpp"
 #include "emel/text/detokenizer/sm.hpp"
 
@@ -510,3 +511,164 @@ TEST_CASE("detokenizer_action_and_guard_paths") {
   CHECK(emel::text::detokenizer::guard::bind_error_unknown{}(bind_ev));
   CHECK(emel::text::detokenizer::guard::detokenize_error_unknown{}(bad_detok));
 }
+
+TEST_CASE("detokenizer_batch_matches_sequential_detokenize") {
+  auto & vocab = make_vocab();
+  const int32_t plain_id = add_token(vocab, "A");
+  const int32_t lead_id = add_token(vocab, "<0xC3>");
+  const int32_t tail_id = add_token(vocab, "<0xA9>");
+  const int32_t special_id = add_token(vocab, "<s>", 3);
+  const int32_t detok_none =
+      detokenizer_error_code(emel::text::detokenizer::error::none);
+  emel::text::detokenizer::detail::prepare_piece_table(vocab);
+
+  emel::text::detokenizer::sm detokenizer{};
+  int32_t bind_err = detok_none;
+  emel::text::detokenizer::event::bind bind_ev{vocab, bind_err};
+  REQUIRE(detokenizer.process_event(bind_ev));
+
+  const std::array<int32_t, 7> ids = {
+      plain_id, lead_id, tail_id, special_id, plain_id, lead_id, tail_id};
+
+  for (const bool emit_special : {false, true}) {
+    std::array<uint8_t, 4> pending = {};
+    std::array<char, 32> expected = {};
+    size_t expected_length = 0;
+    size_t pending_length = 0;
+    for (const int32_t id : ids) {
+      size_t out_len = 0;
+      size_t pending_out = 0;
+      int32_t err = detok_none;
+      emel::text::detokenizer::event::detokenize detok_ev{
+          id, emit_special, pending.data(), pending_length, pending.size(),
+          expected.data() + expected_length, expected.size() - expected_length,
+          out_len, pending_out, err};
+      REQUIRE(detokenizer.process_event(detok_ev));
+      expected_length += out_len;
+      pending_length = pending_out;
+    }
+
+    std::array<uint8_t, 4> batch_pending = {};
+    std::array<char, 32> output = {};
+    size_t output_length = 0;
+    size_t batch_pending_length = 0;
+    size_t token_count = 0;
+    int32_t err = detok_none;
+    emel::text::detokenizer::event::detokenize_batch batch_ev{
+        ids, emit_special, batch_pending.data(), 0, batch_pending.size(),
+        output.data(), output.size(), output_length, batch_pending_length,
+        token_count, err};
+    CHECK(detokenizer.process_event(batch_ev));
+    CHECK(err == detok_none);
+    CHECK(token_count == ids.size());
+    CHECK(batch_pending_length == pending_length);
+    CHECK(std::string_view(output.data(), output_length) ==
+          std::string_view(expected.data(), expected_length));
+  }
+}
+
+TEST_CASE("detokenizer_batch_reports_failing_token") {
+  auto & vocab = make_vocab();
+  const int32_t plain_id = add_token(vocab, "A");
+  const int32_t detok_none =
+      detokenizer_error_code(emel::text::detokenizer::error::none);
+  const int32_t detok_model_invalid =
+      detokenizer_error_code(emel::text::detokenizer::error::model_invalid);
+  emel::text::detokenizer::detail::prepare_piece_table(vocab);
+
+  emel::text::detokenizer::sm detokenizer{};
+  int32_t bind_err = detok_none;
+  emel::text::detokenizer::event::bind bind_ev{vocab, bind_err};
+  REQUIRE(detokenizer.process_event(bind_ev));
+
+  struct batch_probe {
+    int done = 0;
+    int error = 0;
+    size_t token_index = 0;
+  } probe = {};
+
+  const std::array<int32_t, 3> ids = {plain_id, plain_id, 99};
+  std::array<uint8_t, 4> pending = {};
+  std::array<char, 8> output = {};
+  size_t output_length = 0;
+  size_t pending_length = 0;
+  size_t token_count = 0;
+  int32_t err = detok_none;
+  emel::text::detokenizer::event::detokenize_batch batch_ev{
+      ids, true, pending.data(), 0, pending.size(), output.data(), output.size(),
+      output_length, pending_length, token_count, err, &probe,
+      [](void * owner, const emel::text::detokenizer::events::detokenize_batch_done &) {
+        static_cast<batch_probe *>(owner)->done += 1;
+        return true;
+      },
+      [](void * owner, const emel::text::detokenizer::events::detokenize_batch_error & ev) {
+        auto * state = static_cast<batch_probe *>(owner);
+        state->error += 1;
+        state->token_index = ev.token_index;
+        return true;
+      }};
+
+  CHECK_FALSE(detokenizer.process_event(batch_ev));
+  CHECK(err == detok_model_invalid);
+  CHECK(token_count == 2);
+  CHECK(probe.done == 0);
+  CHECK(probe.error == 1);
+  CHECK(probe.token_index == 2);
+
+  const std::array<int32_t, 2> good_ids = {plain_id, plain_id};
+  batch_ev.token_ids = good_ids;
+  CHECK(detokenizer.process_event(batch_ev));
+  CHECK(err == detok_none);
+  CHECK(std::string_view(output.data(), output_length) == "AA");
+  CHECK(probe.done == 1);
+}
+
+TEST_CASE("detokenizer_bind_shares_the_loader_piece_table") {
+  auto & vocab = make_vocab();
+  const int32_t plain_id = add_token(vocab, "A");
+  const int32_t lead_id = add_token(vocab, "<0xC3>");
+  const int32_t tail_id = add_token(vocab, "<0xA9>");
+  const int32_t detok_none =
+      detokenizer_error_code(emel::text::detokenizer::error::none);
+  const int32_t detok_invalid_request =
+      detokenizer_error_code(emel::text::detokenizer::error::invalid_request);
+
+  int32_t bind_err = detok_none;
+  emel::text::detokenizer::event::bind bind_ev{vocab, bind_err};
+  const std::array<int32_t, 3> ids = {plain_id, lead_id, tail_id};
+  std::array<uint8_t, 4> pending = {};
+  std::array<char, 8> output = {};
+  size_t output_length = 0;
+  size_t pending_length = 0;
+  size_t token_count = 0;
+  int32_t err = detok_none;
+  emel::text::detokenizer::event::detokenize_batch batch_ev{
+      ids, false, pending.data(), 0, pending.size(), output.data(), output.size(),
+      output_length, pending_length, token_count, err};
+
+  // A vocab assembled without the loader has no table, so bind still succeeds
+  // for single-token decode but batches are rejected.
+  emel::text::detokenizer::sm unprepared{};
+  REQUIRE(unprepared.process_event(bind_ev));
+  CHECK_FALSE(unprepared.process_event(batch_ev));
+  CHECK(err == detok_invalid_request);
+
+  emel::text::detokenizer::detail::prepare_piece_table(vocab);
+  REQUIRE(vocab.n_pieces == vocab.n_tokens);
+  const auto & shared_vocab = vocab;
+
+  emel::text::detokenizer::action::context first = {};
+  emel::text::detokenizer::action::context second = {};
+  for (auto * ctx : {&first, &second}) {
+    emel::text::detokenizer::action::detail::begin_bind(bind_ev, *ctx);
+    emel::text::detokenizer::action::detail::commit_bind(bind_ev, *ctx);
+    CHECK(ctx->pieces == shared_vocab.pieces.data());
+    CHECK(ctx->piece_count == vocab.n_tokens);
+  }
+
+  emel::text::detokenizer::sm detokenizer{};
+  REQUIRE(detokenizer.process_event(bind_ev));
+  CHECK(detokenizer.process_event(batch_ev));
+  CHECK(err == detok_none);
+  CHECK(std::string_view(output.data(), output_length) == "A\xC3\xA9");
+}
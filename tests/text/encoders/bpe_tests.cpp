@@ -242,3 +242,103 @@ TEST_CASE("encoder_detail_bpe_byte_push_overflow") {
   const auto result = emel::text::encoders::bpe::detail::encode_bpe(ev, ctx, *builder.vocab);
   CHECK(result.error == emel::text::encoders::error::to_emel(emel::text::encoders::error::code::invalid_argument));
 }
+
+TEST_CASE("encoder_detail_bpe_heap_merges_lowest_rank_first") {
+  vocab_builder builder{};
+  builder.set_model("gpt2");
+  builder.set_pre("gpt2");
+  const int32_t a_id = builder.add_token("a", 0.1f, 1);
+  builder.add_token("b", 0.1f, 1);
+  builder.add_token("c", 0.1f, 1);
+  builder.add_token("bc", 0.1f, 1);
+  builder.add_token("ab", 0.1f, 1);
+  const int32_t abc_id = builder.add_token("abc", 0.1f, 1);
+  builder.add_merge("b c");
+  builder.add_merge("a b");
+  builder.add_merge("a bc");
+
+  emel::text::encoders::bpe::action::context ctx{};
+  ctx.vocab = builder.vocab;
+  CHECK(emel::text::encoders::bpe::detail::ensure_bpe_tables(ctx));
+
+  std::array<int32_t, 8> tokens = {};
+  emel::text::encoders::event::encode ev{
+    .vocab = *builder.vocab,
+    .text = "abca",
+    .preprocessed = true,
+    .token_ids = std::span<int32_t>(tokens.data(), tokens.size()),
+  };
+
+  const auto result = emel::text::encoders::bpe::detail::encode_bpe_merge_path(
+    ev, ctx, *builder.vocab);
+  CHECK(result.error == emel::text::encoders::error::to_emel(emel::text::encoders::error::code::ok));
+  REQUIRE(result.token_count == 2);
+  CHECK(tokens[0] == abc_id);
+  CHECK(tokens[1] == a_id);
+  CHECK(ctx.merge_heap.count == 0u);
+}
+
+TEST_CASE("encoder_detail_bpe_word_cache_replays_and_resets") {
+  vocab_builder builder{};
+  builder.set_model("gpt2");
+  builder.set_pre("gpt2");
+  builder.add_token("h", 0.1f, 1);
+  builder.add_token("e", 0.1f, 1);
+  const int32_t he_id = builder.add_token("he", 0.5f, 1);
+  const int32_t y_id = builder.add_token("y", 0.1f, 1);
+  builder.add_merge("h e");
+
+  emel::text::encoders::bpe::action::context ctx{};
+  ctx.vocab = builder.vocab;
+  CHECK(emel::text::encoders::bpe::detail::ensure_bpe_tables(ctx));
+  CHECK(ctx.word_cache.count == 0u);
+
+  std::array<int32_t, 4> first = {};
+  emel::text::encoders::event::encode first_ev{
+    .vocab = *builder.vocab,
+    .text = "hey",
+    .preprocessed = true,
+    .token_ids = std::span<int32_t>(first.data(), first.size()),
+  };
+  const auto first_result = emel::text::encoders::bpe::detail::encode_bpe_merge_path(
+    first_ev, ctx, *builder.vocab);
+  CHECK(first_result.error == emel::text::encoders::error::to_emel(emel::text::encoders::error::code::ok));
+  REQUIRE(first_result.token_count == 2);
+  CHECK(first[0] == he_id);
+  CHECK(first[1] == y_id);
+  CHECK(ctx.word_cache.count == 1u);
+
+  std::array<int32_t, 4> second = {};
+  emel::text::encoders::event::encode second_ev{
+    .vocab = *builder.vocab,
+    .text = "hey",
+    .preprocessed = true,
+    .token_ids = std::span<int32_t>(second.data(), second.size()),
+  };
+  CHECK(emel::text::encoders::bpe::detail::bpe_word_cache_hit(ctx, second_ev.text));
+  CHECK_FALSE(emel::text::encoders::bpe::detail::bpe_word_cache_hit(ctx, "he"));
+  const auto second_result = emel::text::encoders::bpe::detail::encode_bpe_cached_word(
+    second_ev, ctx);
+  CHECK(second_result.error == emel::text::encoders::error::to_emel(emel::text::encoders::error::code::ok));
+  REQUIRE(second_result.token_count == 2);
+  CHECK(second[0] == he_id);
+  CHECK(second[1] == y_id);
+  CHECK(ctx.word_cache.count == 1u);
+
+  std::array<int32_t, 1> short_buffer = {};
+  emel::text::encoders::event::encode short_ev{
+    .vocab = *builder.vocab,
+    .text = "hey",
+    .preprocessed = true,
+    .token_ids = std::span<int32_t>(short_buffer.data(), short_buffer.size()),
+  };
+  const auto short_result = emel::text::encoders::bpe::detail::encode_bpe_cached_word(
+    short_ev, ctx);
+  CHECK(short_result.error == emel::text::encoders::error::to_emel(emel::text::encoders::error::code::invalid_argument));
+  CHECK(short_result.token_count == 0);
+
+  ctx.tables_ready = false;
+  CHECK(emel::text::encoders::bpe::detail::ensure_bpe_tables(ctx));
+  CHECK(ctx.word_cache.count == 0u);
+  CHECK_FALSE(emel::text::encoders::bpe::detail::bpe_word_cache_hit(ctx, second_ev.text));
+}
@@ -1,3 +1,6 @@
+#include <map>
+#include <memory>
+
 #include "test_support.hpp"
 
 TEST_CASE("unicode_helpers_cover_common_paths") {
@@ -191,7 +194,7 @@ TEST_CASE("encoder_ensure_tables_populates_state") {
 
   CHECK(emel::text::encoders::detail::ensure_tables(ctx));
   CHECK(ctx.tables_ready);
-  CHECK(!ctx.token_to_id.empty());
+  CHECK(ctx.token_trie.find("a") != emel::text::encoders::detail::k_token_null);
   CHECK(!ctx.bpe_ranks.empty());
   CHECK(ctx.ugm_ready);
 }
@@ -744,15 +747,6 @@ TEST_CASE("encoder_detail_merge_and_token_helpers") {
   CHECK(emel::text::encoders::detail::hash_sv("token") != 0u);
   CHECK(emel::text::encoders::detail::hash_pair("a", "b") != 0u);
 
-  emel::text::encoders::detail::token_map token_map{};
-  CHECK(emel::text::encoders::detail::insert_token_map(
-    token_map, *builder.vocab, "", token_id));
-  CHECK(emel::text::encoders::detail::insert_token_map(
-    token_map, *builder.vocab, "token", token_id));
-  CHECK(emel::text::encoders::detail::insert_token_map(
-    token_map, *builder.vocab, "token", token_id + 1));
-  CHECK(token_map.count >= 1);
-
   emel::text::encoders::detail::merge_map merge_map{};
   CHECK(!emel::text::encoders::detail::insert_merge_map(
     merge_map, "", "b", 0, *builder.vocab));
@@ -763,6 +757,39 @@ TEST_CASE("encoder_detail_merge_and_token_helpers") {
   CHECK(merge_map.count >= 1);
 }
 
+TEST_CASE("encoder_detail_binds_the_loader_token_trie") {
+  vocab_builder builder{};
+  builder.set_model("gpt2");
+  builder.set_pre("gpt2");
+  const int32_t token_a = builder.add_token("a", 0.1f, 1);
+  const int32_t token_ab = builder.add_token("ab", 0.1f, 1);
+  builder.add_merge("a b");
+
+  REQUIRE(emel::text::encoders::detail::prepare_token_trie(*builder.vocab));
+  REQUIRE(builder.vocab->token_trie_units != 0u);
+  CHECK(builder.vocab->token_trie_max_key == 2u);
+
+  emel::text::encoders::action::context ctx{};
+  ctx.vocab = builder.vocab;
+  REQUIRE(emel::text::encoders::detail::ensure_tables(ctx));
+  CHECK(ctx.token_trie.borrowed());
+  CHECK(ctx.token_trie.cells() == builder.vocab->token_trie.data());
+  CHECK(ctx.max_token_len == 2);
+  CHECK(emel::text::encoders::detail::lookup_token(ctx, "a") == token_a);
+  CHECK(emel::text::encoders::detail::lookup_token(ctx, "ab") == token_ab);
+  CHECK(emel::text::encoders::detail::lookup_token(ctx, "b") ==
+        emel::text::encoders::detail::k_token_null);
+
+  const emel::text::encoders::detail::double_array_trie copy = ctx.token_trie;
+  CHECK(copy.cells() == builder.vocab->token_trie.data());
+
+  // Encoders never build a trie during dispatch; an unprepared vocab is rejected.
+  builder.vocab->token_trie_units = 0u;
+  emel::text::encoders::action::context unprepared{};
+  unprepared.vocab = builder.vocab;
+  CHECK_FALSE(emel::text::encoders::detail::ensure_tables(unprepared));
+}
+
 TEST_CASE("encoder_detail_lookup_helpers") {
   vocab_builder builder{};
   builder.set_model("gpt2");
@@ -782,24 +809,12 @@ TEST_CASE("encoder_detail_lookup_helpers") {
   CHECK(emel::text::encoders::detail::lookup_token(ctx, "missing") ==
         emel::text::encoders::detail::k_token_null);
 
-  const uint32_t hash = emel::text::encoders::detail::hash_concat("a", "b");
-  const uint32_t mask = emel::text::encoders::detail::k_token_hash_size - 1;
-  const uint32_t slot = hash & mask;
-
-  ctx.token_to_id.hashes[slot] = hash;
-  ctx.token_to_id.values[slot] = token_cb;
-  int32_t concat = emel::text::encoders::detail::lookup_token_concat(ctx, "a", "b");
-  CHECK((concat == token_ab || concat == emel::text::encoders::detail::k_token_null));
-
-  ctx.token_to_id.hashes[slot] = hash;
-  ctx.token_to_id.values[slot] = token_ac;
-  concat = emel::text::encoders::detail::lookup_token_concat(ctx, "a", "b");
-  CHECK((concat == token_ab || concat == emel::text::encoders::detail::k_token_null));
-
-  ctx.token_to_id.hashes[slot] = hash;
-  ctx.token_to_id.values[slot] = token_a;
-  concat = emel::text::encoders::detail::lookup_token_concat(ctx, "a", "b");
-  CHECK((concat == token_ab || concat == emel::text::encoders::detail::k_token_null));
+  CHECK(emel::text::encoders::detail::lookup_token_concat(ctx, "a", "b") == token_ab);
+  CHECK(emel::text::encoders::detail::lookup_token_concat(ctx, "a", "c") == token_ac);
+  CHECK(emel::text::encoders::detail::lookup_token_concat(ctx, "c", "b") == token_cb);
+  CHECK(emel::text::encoders::detail::lookup_token_concat(ctx, "", "a") == token_a);
+  CHECK(emel::text::encoders::detail::lookup_token_concat(ctx, "b", "a") ==
+        emel::text::encoders::detail::k_token_null);
 
   CHECK(emel::text::encoders::detail::lookup_merge_rank(ctx, *builder.vocab, "", "b") ==
         emel::text::encoders::detail::k_token_null);
@@ -928,25 +943,6 @@ TEST_CASE("encoder_detail_charsmap_into_paths") {
   CHECK(!emel::text::encoders::ugm::detail::init_xcda_tables(ctx_no_table));
 }
 
-TEST_CASE("encoder_detail_insert_token_map_full") {
-  vocab_builder builder{};
-  builder.set_model("gpt2");
-  const int32_t token_x = builder.add_token("x", 0.0f, 1);
-  const int32_t token_y = builder.add_token("y", 0.0f, 1);
-
-  emel::text::encoders::detail::token_map map{};
-  const std::string_view target = "y";
-  const uint32_t hash = emel::text::encoders::detail::hash_sv(target);
-  for (uint32_t i = 0; i < emel::text::encoders::detail::k_token_hash_size; ++i) {
-    map.hashes.get()[i] = hash;
-    map.values.get()[i] = token_x;
-  }
-
-  const bool ok =
-      emel::text::encoders::detail::insert_token_map(map, *builder.vocab, target, token_y);
-  CHECK_FALSE(ok);
-}
-
 TEST_CASE("encoder_detail_insert_merge_map_full") {
   vocab_builder builder{};
   builder.set_model("gpt2");
@@ -966,25 +962,6 @@ TEST_CASE("encoder_detail_insert_merge_map_full") {
   CHECK_FALSE(ok);
 }
 
-TEST_CASE("encoder_detail_lookup_token_full_probe") {
-  vocab_builder builder{};
-  builder.set_model("gpt2");
-  const int32_t token_x = builder.add_token("x", 0.0f, 1);
-  builder.add_token("y", 0.0f, 1);
-
-  emel::text::encoders::action::context ctx{};
-  ctx.vocab = builder.vocab;
-  const std::string_view target = "y";
-  const uint32_t hash = emel::text::encoders::detail::hash_sv(target);
-  for (uint32_t i = 0; i < emel::text::encoders::detail::k_token_hash_size; ++i) {
-    ctx.token_to_id.hashes.get()[i] = hash;
-    ctx.token_to_id.values.get()[i] = token_x;
-  }
-
-  const int32_t id = emel::text::encoders::detail::lookup_token(ctx, target);
-  CHECK(id == emel::text::encoders::detail::k_token_null);
-}
-
 TEST_CASE("encoder_encode_branch_cases") {
   vocab_builder base_builder{};
   base_builder.set_model("unknown");
@@ -1073,6 +1050,89 @@ TEST_CASE("encoder_naive_trie_branches") {
   CHECK(trie.traverse('z') == nullptr);
 }
 
+TEST_CASE("encoder_double_array_trie_matches_key_set") {
+  using trie_type = emel::text::encoders::detail::double_array_trie;
+  std::vector<std::string> texts{};
+  std::map<std::string, int32_t> expected{};
+  uint32_t seed = 0x1234567u;
+  for (int32_t id = 0; id < 2000; ++id) {
+    seed = seed * 1664525u + 1013904223u;
+    const size_t len = 1u + (seed >> 24u) % 7u;
+    std::string text{};
+    for (size_t idx = 0; idx < len; ++idx) {
+      seed = seed * 1664525u + 1013904223u;
+      text.push_back(static_cast<char>("ab\xC4\xA0z"[(seed >> 20u) % 5u]));
+    }
+    texts.push_back(text);
+    expected[text] = id;
+  }
+  texts.push_back("");
+
+  std::vector<trie_type::key> keys{};
+  for (size_t id = 0; id < texts.size(); ++id) {
+    keys.push_back({texts[id], static_cast<int32_t>(id)});
+  }
+  // The empty text is skipped and repeated texts keep the last id.
+  trie_type trie{};
+  trie.build(keys);
+
+  CHECK(trie.find("") == emel::text::encoders::detail::k_token_null);
+  CHECK(trie.find("q") == emel::text::encoders::detail::k_token_null);
+  CHECK(trie.max_key_length == 7u);
+  for (const auto & [text, id] : expected) {
+    CHECK(trie.find(text) == id);
+  }
+
+  const int32_t dead = trie.step(trie.step(trie.k_root, 'q'), 'a');
+  CHECK(dead < 0);
+  CHECK(trie.value(dead) == emel::text::encoders::detail::k_token_null);
+
+}
+
+TEST_CASE("encoder_token_trie_image_restores_the_vocab_trie") {
+  vocab_builder builder{};
+  builder.set_model("t5");
+  const int32_t piece = builder.add_token("ab", 0.1f, 1);
+  (void)builder.add_token("ab", 0.0f, 3);
+  const int32_t user = builder.add_token("u", 0.0f, 4);
+  const emel::model::data::vocab & vocab = *builder.vocab;
+  REQUIRE(vocab.token_trie_units != 0u);
+
+  // A UGM trie keeps the matchable id when a control piece repeats its text.
+  emel::text::encoders::detail::double_array_trie trie{};
+  REQUIRE(emel::text::encoders::detail::bind_token_trie(trie, vocab));
+  CHECK(trie.find("ab") == piece);
+  CHECK(trie.find("u") == user);
+
+  std::vector<uint32_t> image(emel::text::encoders::detail::token_trie_image_words(vocab));
+  CHECK_FALSE(emel::text::encoders::detail::serialize_token_trie(
+      vocab, image.data(), image.size() - 1u));
+  REQUIRE(emel::text::encoders::detail::serialize_token_trie(vocab, image.data(), image.size()));
+  std::vector<uint8_t> bytes(image.size() * sizeof(uint32_t));
+  std::memcpy(bytes.data(), image.data(), bytes.size());
+
+  auto restored = std::make_unique<emel::model::data::vocab>();
+  restored->token_storage = vocab.token_storage;
+  restored->entries = vocab.entries;
+  restored->n_tokens = vocab.n_tokens;
+  CHECK_FALSE(emel::text::encoders::detail::deserialize_token_trie(
+      *restored, bytes.data(), bytes.size() - 1u));
+  CHECK(restored->token_trie_units == 0u);
+  restored->n_tokens = vocab.n_tokens + 1u;
+  CHECK_FALSE(emel::text::encoders::detail::deserialize_token_trie(
+      *restored, bytes.data(), bytes.size()));
+  restored->n_tokens = vocab.n_tokens;
+  REQUIRE(emel::text::encoders::detail::deserialize_token_trie(
+      *restored, bytes.data(), bytes.size()));
+  CHECK(restored->token_trie_units == vocab.token_trie_units);
+  CHECK(restored->token_trie_max_key == vocab.token_trie_max_key);
+
+  emel::text::encoders::detail::double_array_trie restored_trie{};
+  REQUIRE(emel::text::encoders::detail::bind_token_trie(restored_trie, *restored));
+  CHECK(restored_trie.find("ab") == piece);
+  CHECK(restored_trie.find("u") == user);
+}
+
 TEST_CASE("encoder_bigram_comparators") {
   using spm_bigram = emel::text::encoders::detail::spm_bigram;
   std::priority_queue<spm_bigram, spm_bigram::queue_storage, spm_bigram::comparator> spm_queue;
@@ -166,6 +166,7 @@ struct vocab_builder {
     } else {
       vocab->tokenizer_model_id = emel::model::data::tokenizer_model::UNKNOWN;
     }
+    prepare_trie();
   }
 
   void set_pre(const char * value) {
@@ -195,9 +196,16 @@ struct vocab_builder {
     vocab->entries[id].type = type;
     vocab->token_bytes_used += len;
     vocab->n_tokens = id + 1;
+    prepare_trie();
     return static_cast<int32_t>(id);
   }
 
+  // Stands in for the loader, which builds the shared token trie once the
+  // vocab is complete; encoders only bind it.
+  void prepare_trie() {
+    REQUIRE(emel::text::encoders::detail::prepare_token_trie(*vocab));
+  }
+
   void add_merge(const char * text) {
     const uint32_t len = static_cast<uint32_t>(std::strlen(text));
     const uint32_t offset = vocab->merge_bytes_used;
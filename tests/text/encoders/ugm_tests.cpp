@@ -84,11 +84,11 @@ TEST_CASE("encoder_detail_ugm_helper_branches") {
   CHECK(emel::text::encoders::ugm::detail::ensure_ugm_tables(ctx, *builder.vocab));
   CHECK(emel::text::encoders::ugm::detail::ensure_ugm_tables(ctx, *builder.vocab));
 
-  emel::text::encoders::detail::naive_trie trie{};
-  trie.insert("a", 1, 1);
-  CHECK(emel::text::encoders::ugm::detail::trie_longest_prefix(trie, "a", 1) == 1);
-  CHECK(emel::text::encoders::ugm::detail::trie_longest_prefix(trie, "b", 1) == 0);
-  CHECK(emel::text::encoders::ugm::detail::trie_longest_prefix(trie, "a", 0) == 0);
+  const auto & vocab = *builder.vocab;
+  CHECK(emel::text::encoders::ugm::detail::user_defined_prefix(ctx.token_trie, vocab, "user", 4) == 4);
+  CHECK(emel::text::encoders::ugm::detail::user_defined_prefix(ctx.token_trie, vocab, "a", 1) == 0);
+  CHECK(emel::text::encoders::ugm::detail::user_defined_prefix(ctx.token_trie, vocab, "b", 1) == 0);
+  CHECK(emel::text::encoders::ugm::detail::user_defined_prefix(ctx.token_trie, vocab, "user", 0) == 0);
 
   emel::text::encoders::ugm::detail::xcda_view view{};
   CHECK(view.node(1) == 0);
@@ -211,15 +211,13 @@ TEST_CASE("encoder_detail_ugm_rebuild_preserves_inserted_trie_paths") {
 
   for (size_t i = 0; i < tokens.size(); ++i) {
     const std::string_view token = tokens[i];
-    const auto *node = emel::text::encoders::ugm::detail::ugm_trie_root(
-      ctx.token_matcher, token[0]);
-    REQUIRE(node != nullptr);
-    for (size_t j = 1; j < token.size() && node != nullptr; ++j) {
-      node = emel::text::encoders::ugm::detail::ugm_trie_step(*node, token[j]);
+    const auto & trie = ctx.token_trie;
+    int32_t state = trie.k_root;
+    for (size_t j = 0; j < token.size() && state >= 0; ++j) {
+      state = trie.step(state, static_cast<uint8_t>(token[j]));
     }
-    REQUIRE(node != nullptr);
-    CHECK(node->has_value);
-    CHECK(node->value == token_ids[i]);
+    REQUIRE(state >= 0);
+    CHECK(trie.value(state) == token_ids[i]);
   }
 }
 
@@ -247,14 +245,14 @@ TEST_CASE("encoder_detail_ugm_append_space_and_overflow") {
 }
 
 TEST_CASE("encoder_detail_ugm_xcda_break_and_trie_paths") {
-  emel::text::encoders::detail::naive_trie trie{};
-  trie.insert("a", 1, 1);
-  trie.insert("ab", 2, 2);
-  CHECK(emel::text::encoders::ugm::detail::trie_longest_prefix(trie, "ac", 2) == 1);
-
   vocab_builder builder{};
   builder.set_model("t5");
-  builder.add_token("a", 0.0f, 1);
+  builder.add_token("a", 0.0f, 4);
+  builder.add_token("ab", 0.0f, 4);
+  emel::text::encoders::detail::double_array_trie trie{};
+  REQUIRE(emel::text::encoders::detail::bind_token_trie(trie, *builder.vocab));
+  CHECK(emel::text::encoders::ugm::detail::user_defined_prefix(trie, *builder.vocab, "ac", 2) == 1);
+
   emel::text::encoders::ugm::action::context ctx{};
   ctx.vocab = builder.vocab;
   std::array<uint32_t, 1> table = {0};
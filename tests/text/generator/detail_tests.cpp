@@ -3383,6 +3383,76 @@ TEST_CASE(
                                                    packed_tensor, storage));
 }
 
+TEST_CASE("generator_detail_prepared_cache_rebinds_packed_layouts_from_image") {
+  namespace prepared_cache = emel::text::generator::prepared_cache;
+  constexpr int32_t rows = 4;
+  constexpr int32_t cols = 64;
+  std::vector<block_q8_0> blocks(static_cast<size_t>(rows * cols / 32));
+  for (size_t i = 0; i < blocks.size(); ++i) {
+    blocks[i].d = static_cast<uint16_t>(0x3c00u + i);
+    for (size_t q = 0; q < blocks[i].qs.size(); ++q) {
+      blocks[i].qs[q] = static_cast<int8_t>((i * 7u + q) & 0x3fu);
+    }
+  }
+  emel::model::data::tensor_record source{};
+  source.type = static_cast<int32_t>(emel::kernel::detail::dtype_q8_0);
+  source.data = blocks.data();
+  source.data_size = blocks.size() * sizeof(block_q8_0);
+  source.file_offset = 4096u;
+  const prepared_cache::key key{.model_fingerprint = 0x1234u,
+                                .kernel_kind = 1u};
+
+  prepared_cache::binding recorder{};
+  prepared_cache::open(recorder, {}, key);
+  std::vector<uint8_t> packed_storage;
+  emel::model::data::tensor_record packed{};
+  REQUIRE(emel::text::generator::detail::prepare_packed_q8_0_tensor_layout<
+          emel::kernel::detail::dtype_q8_0_x4_bl8>(
+      source, rows, cols, packed, packed_storage, &recorder));
+  CHECK(recorder.misses == 1u);
+  REQUIRE(recorder.records.size() == 1u);
+
+  std::vector<uint8_t> image(prepared_cache::image_bytes(recorder));
+  CHECK_FALSE(prepared_cache::write_image(
+      recorder, std::span<uint8_t>(image.data(), image.size() - 1u)));
+  REQUIRE(prepared_cache::write_image(recorder, image));
+
+  prepared_cache::binding cached{};
+  prepared_cache::open(cached, image, key);
+  REQUIRE(cached.usable);
+  std::vector<uint8_t> cached_storage;
+  emel::model::data::tensor_record rebound{};
+  REQUIRE(emel::text::generator::detail::prepare_packed_q8_0_tensor_layout<
+          emel::kernel::detail::dtype_q8_0_x4_bl8>(
+      source, rows, cols, rebound, cached_storage, &cached));
+  CHECK(cached.hits == 1u);
+  CHECK(cached_storage.empty());
+  CHECK(rebound.type == packed.type);
+  REQUIRE(rebound.data_size == packed.data_size);
+  CHECK(static_cast<const uint8_t *>(rebound.data) >= image.data());
+  CHECK(std::memcmp(rebound.data, packed.data,
+                    static_cast<size_t>(packed.data_size)) == 0);
+
+  prepared_cache::binding stale_key{};
+  prepared_cache::open(stale_key, image,
+                       prepared_cache::key{.model_fingerprint = 0x4321u,
+                                           .kernel_kind = 1u});
+  CHECK_FALSE(stale_key.usable);
+
+  blocks[1].qs[3] = static_cast<int8_t>(blocks[1].qs[3] + 1);
+  prepared_cache::binding stale_source{};
+  prepared_cache::open(stale_source, image, key);
+  REQUIRE(stale_source.usable);
+  std::vector<uint8_t> repacked_storage;
+  emel::model::data::tensor_record repacked{};
+  REQUIRE(emel::text::generator::detail::prepare_packed_q8_0_tensor_layout<
+          emel::kernel::detail::dtype_q8_0_x4_bl8>(
+      source, rows, cols, repacked, repacked_storage, &stale_source));
+  CHECK(stale_source.hits == 0u);
+  CHECK(stale_source.misses == 1u);
+  CHECK(repacked.data == repacked_storage.data());
+}
+
 TEST_CASE("generator_detail_graph_callbacks_accept_guarded_requests_without_"
           "error_channel") {
   auto fixture = std::make_unique<runtime_request_fixture>();
@@ -0,0 +1,84 @@
+#include "doctest/doctest.h"
+
+#include <cstdint>
+#include <memory>
+
+#include "emel/text/generator/latency.hpp"
+
+namespace {
+
+namespace latency = emel::text::generator::latency;
+
+uint64_t g_now_ns = 0u;
+
+uint64_t test_clock() noexcept { return g_now_ns; }
+
+}  // namespace
+
+TEST_CASE("generator_latency buckets stay within one sub-bucket of the value") {
+  for (uint64_t value : {0ull, 1ull, 15ull, 16ull, 17ull, 31ull, 32ull, 33ull,
+                         1000ull, 123456789ull, ~0ull}) {
+    const size_t index = latency::bucket_index(value);
+    REQUIRE(index < latency::k_bucket_count);
+    const uint64_t upper = latency::bucket_upper(index);
+    CHECK(upper >= value);
+    CHECK(upper - value <= value / latency::k_sub_bucket_count);
+    CHECK(latency::bucket_index(upper) == index);
+  }
+}
+
+TEST_CASE("generator_latency percentiles expose the tail an average hides") {
+  auto recorder = std::make_unique<latency::recorder>();
+  latency::reset(*recorder, &test_clock);
+
+  g_now_ns = 1'000'000u;
+  latency::begin_request(recorder.get());
+  g_now_ns += 50'000'000u;
+  latency::record_token(recorder.get());
+  // 98 steady 10 ms tokens and two 200 ms stalls.
+  for (int token = 0; token < 100; ++token) {
+    g_now_ns += token % 50 == 49 ? 200'000'000u : 10'000'000u;
+    latency::record_token(recorder.get());
+  }
+
+  latency::summary out{};
+  latency::summarize(recorder.get(), out);
+  const auto &ttft =
+      out.metrics[static_cast<size_t>(latency::metric::time_to_first_token)];
+  const auto &itl =
+      out.metrics[static_cast<size_t>(latency::metric::inter_token)];
+  CHECK(ttft.count == 1u);
+  CHECK(ttft.p50_ns == 50'000'000u);
+  CHECK(itl.count == 100u);
+  CHECK(itl.p50_ns >= 10'000'000u);
+  CHECK(itl.p50_ns <= 10'000'000u + 10'000'000u / 16u);
+  CHECK(itl.p90_ns == itl.p50_ns);
+  CHECK(itl.p99_ns == 200'000'000u);
+  CHECK(itl.max_ns == 200'000'000u);
+  CHECK(itl.total_ns == 98u * 10'000'000u + 2u * 200'000'000u);
+}
+
+TEST_CASE("generator_latency without a recorder reports nothing") {
+  latency::begin_request(nullptr);
+  latency::record_token(nullptr);
+  latency::record(nullptr, latency::metric::sampler, 0u);
+  latency::record_prefill(nullptr, 0u, 4);
+  CHECK(latency::now(nullptr) == 0u);
+
+  latency::summary out{};
+  out.prefill_tokens = 7u;
+  latency::summarize(nullptr, out);
+  CHECK(out.prefill_tokens == 0u);
+  CHECK(out.metrics[0].count == 0u);
+
+  auto recorder = std::make_unique<latency::recorder>();
+  latency::reset(*recorder, &test_clock);
+  g_now_ns = 100u;
+  const uint64_t started = latency::now(recorder.get());
+  g_now_ns = 340u;
+  latency::record_prefill(recorder.get(), started, 12);
+  latency::summarize(recorder.get(), out);
+  CHECK(out.prefill_tokens == 12u);
+  CHECK(out.metrics[static_cast<size_t>(latency::metric::prefill)].total_ns ==
+        240u);
+}
@@ -46,6 +46,18 @@ std::filesystem::path repo_root() {
 #endif
 }
 
+uint64_t g_latency_ticks = 0u;
+
+// Advances 1 us per read so every latency interval is non-zero.
+uint64_t latency_test_clock() noexcept {
+  g_latency_ticks += 1000u;
+  return g_latency_ticks;
+}
+
+uint64_t half_resident(const void *, const uint64_t size, void *) noexcept {
+  return size / 2u;
+}
+
 constexpr bool host_is_aarch64() noexcept {
 #if defined(__aarch64__) || defined(_M_ARM64)
   return true;
@@ -120,6 +132,8 @@ int32_t add_token(emel::model::data::vocab &vocab, const char *text,
   vocab.entries[id].type = type;
   vocab.token_bytes_used += length;
   vocab.n_tokens = id + 1;
+  // Stands in for the loader, which builds the shared token trie.
+  (void)emel::text::encoders::detail::prepare_token_trie(vocab);
   return static_cast<int32_t>(id);
 }
 
@@ -955,6 +969,7 @@ struct generator_fixture {
   emel::text::conditioner::sm conditioner{};
   emel::kernel::matmul::lane_pool parallel_matmul_lanes = {};
   emel::model::generation::contract generation_contract = {};
+  emel::text::generator::latency::recorder latency = {};
   std::unique_ptr<emel::text::generator::sm> generator = {};
   std::array<emel::logits::sampler::fn, 1> samplers = {
       emel::logits::sampler::fn::from<sampler_select_argmax>(),
@@ -999,13 +1014,16 @@ struct generator_fixture {
             emel::error::type{0});
     const auto matmul_policy = emel::kernel::matmul::make_execution_policy(
         parallel_matmul_lanes, emel::kernel::detect_host_kind(), matmul_lanes);
+    emel::text::generator::latency::reset(latency, &latency_test_clock);
+    auto runtime_policy =
+        emel::text::generator::test::make_auto_runtime_policy(model);
+    runtime_policy.latency = &latency;
     generator = std::make_unique<emel::text::generator::sm>(
         emel::text::generator::dependencies{
             .generation_contract = generation_contract,
             .conditioner = conditioner,
             .matmul_policy = matmul_policy,
-            .runtime_policy =
-                emel::text::generator::test::make_auto_runtime_policy(model),
+            .runtime_policy = runtime_policy,
             .formatter_ctx = formatter_ctx,
             .format_prompt = format_prompt,
             .kv_cache = kv_cache,
@@ -1190,6 +1208,7 @@ TEST_CASE("generator diagnostics are available before initialization") {
       stateforward::sml::state<emel::text::generator::uninitialized>));
   CHECK(diagnostics.kernel_dispatch_calls == 0u);
   CHECK(diagnostics.optimized_q4_dispatch_calls == 0u);
+  CHECK(diagnostics.roofline_bytes == 0u);
 }
 
 TEST_CASE(
@@ -1454,6 +1473,20 @@ TEST_CASE("generator_generate_runs_native_generator_contract") {
   const auto diagnostics = capture_generator_diagnostics(*fixture->generator);
   CHECK(diagnostics.kernel_dispatch_calls > 0u);
   CHECK(diagnostics.flash_attention_dispatch_calls > 0u);
+  CHECK(diagnostics.roofline_flops > 0u);
+  CHECK(diagnostics.roofline_bytes > 0u);
+  using emel::text::generator::latency::metric;
+  const auto latency_of = [&diagnostics](const metric which) {
+    return diagnostics.latency.metrics[static_cast<size_t>(which)];
+  };
+  CHECK(latency_of(metric::time_to_first_token).count == 1u);
+  CHECK(latency_of(metric::time_to_first_token).p99_ns > 0u);
+  CHECK(latency_of(metric::inter_token).count == 0u);
+  CHECK(latency_of(metric::prefill).count == 1u);
+  CHECK(latency_of(metric::sampler).count == 1u);
+  CHECK(latency_of(metric::renderer).count == 1u);
+  CHECK(latency_of(metric::window_stall).count == 0u);
+  CHECK(diagnostics.latency.prefill_tokens > 0u);
   if (host_is_aarch64() || host_is_x86_64()) {
     CHECK(diagnostics.optimized_flash_dispatch_calls > 0u);
     CHECK(diagnostics.shared_flash_dispatch_calls == 0u);
@@ -1463,6 +1496,95 @@ TEST_CASE("generator_generate_runs_native_generator_contract") {
   }
 }
 
+TEST_CASE("generator_latency_summary_stays_empty_without_a_recorder") {
+  auto fixture = std::make_unique<generator_fixture>();
+  auto runtime_policy = emel::text::generator::test::make_auto_runtime_policy(
+      stabilize_model(fixture->prepared));
+  runtime_policy.latency = nullptr;
+  fixture->generator = std::make_unique<emel::text::generator::sm>(
+      emel::text::generator::dependencies{
+          .generation_contract = fixture->generation_contract,
+          .conditioner = fixture->conditioner,
+          .matmul_policy = emel::kernel::matmul::make_execution_policy(
+              fixture->parallel_matmul_lanes,
+              emel::kernel::detect_host_kind(), 8u),
+          .runtime_policy = runtime_policy,
+      });
+  const uint64_t ticks_before = g_latency_ticks;
+
+  callback_tracker initialize_tracker{};
+  emel::error::type initialize_error =
+      emel::error::cast(emel::text::generator::error::backend);
+  const auto initialize_request =
+      fixture->make_initialize(initialize_tracker, &initialize_error);
+  REQUIRE(fixture->generator->process_event(initialize_request));
+
+  callback_tracker generate_tracker{};
+  std::array<char, 32> output = {};
+  size_t output_length = 0;
+  emel::error::type generate_error =
+      emel::error::cast(emel::text::generator::error::backend);
+  const auto generate_request =
+      fixture->make_generate(generate_tracker, output.data(), output.size(),
+                             output_length, &generate_error);
+
+  CHECK(fixture->generator->process_event(generate_request));
+  CHECK(generate_tracker.generate_done_called);
+  CHECK(generate_error ==
+        emel::error::cast(emel::text::generator::error::none));
+  CHECK(std::string_view(output.data(), output_length) == "world");
+  CHECK(g_latency_ticks == ticks_before);
+  const auto diagnostics = capture_generator_diagnostics(*fixture->generator);
+  for (const auto &metric : diagnostics.latency.metrics) {
+    CHECK(metric.count == 0u);
+    CHECK(metric.p99_ns == 0u);
+  }
+  CHECK(diagnostics.latency.prefill_tokens == 0u);
+}
+
+TEST_CASE("generator_memory_footprint_counts_kv_cache_and_mapped_weights") {
+  auto fixture = std::make_unique<generator_fixture>();
+  emel::memory::footprint::report before{};
+  CHECK(fixture->generator->process_event(
+      emel::text::generator::event::capture_memory_footprint{before}));
+  CHECK(before.mapped_weight_bytes == 0u);
+  CHECK(before.kv_cache_bytes == 0u);
+
+  callback_tracker initialize_tracker{};
+  emel::error::type initialize_error =
+      emel::error::cast(emel::text::generator::error::backend);
+  const auto initialize_request =
+      fixture->make_initialize(initialize_tracker, &initialize_error);
+  REQUIRE(fixture->generator->process_event(initialize_request));
+
+  uint64_t weight_bytes = 0u;
+  for (uint32_t index = 0u; index < fixture->prepared.data.n_tensors;
+       ++index) {
+    weight_bytes += fixture->prepared.data.tensors[index].data_size;
+  }
+  // n_ctx 8 in blocks of 4 tokens, one layer of kv_dim 4, fp16 key/value in
+  // both the row and the flash layouts.
+  constexpr uint64_t k_kv_cache_bytes = 4u * 8u * 4u * sizeof(uint16_t);
+
+  emel::memory::footprint::report unprobed{};
+  CHECK(fixture->generator->process_event(
+      emel::text::generator::event::capture_memory_footprint{unprobed}));
+  CHECK(unprobed.mapped_weight_bytes == weight_bytes);
+  CHECK(unprobed.kv_cache_bytes == k_kv_cache_bytes);
+  CHECK_FALSE(unprobed.weights_probed);
+  CHECK(unprobed.prepared_weight_bytes > 0u);
+  CHECK(unprobed.scratch_bytes > 0u);
+
+  emel::memory::footprint::report probed{};
+  CHECK(fixture->generator->process_event(
+      emel::text::generator::event::capture_memory_footprint{
+          probed, {&half_resident, nullptr}}));
+  CHECK(probed.weights_probed);
+  CHECK(probed.mapped_weight_bytes == weight_bytes);
+  CHECK(probed.mapped_weight_touched_bytes == weight_bytes / 2u);
+  CHECK(probed.kv_cache_bytes == k_kv_cache_bytes);
+}
+
 TEST_CASE("generator unsupported lane policy stays serial through prefill and "
           "decode") {
   auto fixture = std::make_unique<generator_fixture>(
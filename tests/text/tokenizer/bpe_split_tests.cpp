@@ -1,6 +1,8 @@
 #include <array>
 #include <cstring>
+#include <memory>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include <doctest/doctest.h>
@@ -336,3 +338,69 @@ TEST_CASE("tokenizer_bpe_split_fallback_overflow") {
   CHECK_FALSE(emel::text::tokenizer::bpe::detail::split_and_encode_fallback(
       too_long, regex, scratch));
 }
+
+TEST_CASE("tokenizer_bpe_split_ascii_flags_match_unicode_tables") {
+  constexpr uint16_t k_split_bits =
+      emel::text::unicode_cpt_flags::MASK_CATEGORIES |
+      emel::text::unicode_cpt_flags::WHITESPACE |
+      emel::text::unicode_cpt_flags::LOWERCASE |
+      emel::text::unicode_cpt_flags::UPPERCASE;
+  for (uint32_t cpt = 0; cpt < 128u; ++cpt) {
+    const auto expected = emel::text::unicode_cpt_flags_from_cpt(cpt);
+    const emel::text::unicode_cpt_flags actual(
+        emel::text::tokenizer::bpe::detail::k_ascii_cpt_flags[cpt]);
+    CHECK((actual.as_uint() & k_split_bits) == (expected.as_uint() & k_split_bits));
+    CHECK(emel::text::tokenizer::bpe::detail::ascii_source::tolower(cpt) ==
+          emel::text::unicode_tolower(cpt));
+  }
+}
+
+TEST_CASE("tokenizer_bpe_split_ascii_prefix_and_safe_cuts") {
+  const std::string ascii(100, 'a');
+  CHECK(emel::text::tokenizer::bpe::detail::ascii_prefix_length(ascii) == ascii.size());
+
+  std::string mixed = ascii;
+  mixed[70] = '\xC3';
+  CHECK(emel::text::tokenizer::bpe::detail::ascii_prefix_length(mixed) == 70u);
+  CHECK(emel::text::tokenizer::bpe::detail::ascii_prefix_length(std::string_view{}) == 0u);
+
+  const std::string_view text = "ab\ncd  \nef\n\ngh";
+  CHECK(emel::text::tokenizer::bpe::detail::is_safe_split_cut(text, 3u));
+  CHECK_FALSE(emel::text::tokenizer::bpe::detail::is_safe_split_cut(text, 8u));
+  CHECK_FALSE(emel::text::tokenizer::bpe::detail::is_safe_split_cut(text, 12u));
+  CHECK(emel::text::tokenizer::bpe::detail::next_safe_split_cut(text, 4u) == text.size());
+  CHECK(emel::text::tokenizer::bpe::detail::last_safe_split_cut(text, 0u, 10u) == 3u);
+}
+
+TEST_CASE("tokenizer_bpe_split_ascii_fast_path_matches_codepoint_path") {
+  const std::array<std::string_view, 6> texts = {{
+      "int main() {\n  return x + 42;\n}\n",
+      "I'm 123!!  caf\xC3\xA9\nnext line\nhere's\xC2\xA0more\ttext \n\n done",
+      "The QUICK brown fox'LL jump\r\nover 1234567 dogs\x1c\x7f ",
+      "\xE6\xB1\x89\xE5\xAD\x97" "abc\ndef\n\xE4\xB8\x96\nxyz",
+      "a\nb\nc\nd\xC3\xA9\ne\nf",
+      "   \n\n  trailing   ",
+  }};
+  constexpr std::array<emel::text::tokenizer::bpe::detail::split_profile, 4> profiles = {{
+      emel::text::tokenizer::bpe::detail::split_profile::gpt2,
+      emel::text::tokenizer::bpe::detail::split_profile::llama3,
+      emel::text::tokenizer::bpe::detail::split_profile::kimi_k2,
+      emel::text::tokenizer::bpe::detail::split_profile::afmoe,
+  }};
+
+  auto fast = std::make_unique<emel::text::tokenizer::bpe::detail::split_scratch>();
+  auto reference = std::make_unique<emel::text::tokenizer::bpe::detail::split_scratch>();
+  for (const auto profile : profiles) {
+    for (const std::string_view text : texts) {
+      CHECK(emel::text::tokenizer::bpe::detail::split_and_encode_profile(
+          text, profile, *fast));
+      reference->reset();
+      CHECK(emel::text::tokenizer::bpe::detail::split_and_encode_cpts(
+          text, profile, *reference));
+      REQUIRE(fast->word_count == reference->word_count);
+      for (size_t idx = 0; idx < fast->word_count; ++idx) {
+        CHECK(fast->words[idx] == reference->words[idx]);
+      }
+    }
+  }
+}
@@ -0,0 +1,380 @@
+#include <array>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include <doctest/doctest.h>
+
+#include "emel/model/data.hpp"
+#include "emel/text/tokenizer/document/sm.hpp"
+#include "emel/text/tokenizer/sm.hpp"
+#include "emel/text/unicode.hpp"
+
+namespace {
+
+constexpr int32_t k_error_none =
+    emel::text::tokenizer::error_code(emel::text::tokenizer::error::none);
+
+int32_t add_token(emel::model::data::vocab & vocab, const std::string & text,
+                  const int32_t type) {
+  const uint32_t len = static_cast<uint32_t>(text.size());
+  const uint32_t offset = vocab.token_bytes_used;
+  std::memcpy(vocab.token_storage.data() + offset, text.data(), len);
+  const uint32_t id = vocab.n_tokens;
+  vocab.entries[id].text_offset = offset;
+  vocab.entries[id].text_length = len;
+  vocab.entries[id].score = 0.0f;
+  vocab.entries[id].type = type;
+  vocab.token_bytes_used += len;
+  vocab.n_tokens = id + 1;
+  // Stands in for the loader, which builds the shared token trie.
+  (void)emel::text::encoders::detail::prepare_token_trie(vocab);
+  return static_cast<int32_t>(id);
+}
+
+void add_merge(emel::model::data::vocab & vocab, const std::string & text) {
+  const uint32_t len = static_cast<uint32_t>(text.size());
+  const uint32_t offset = vocab.merge_bytes_used;
+  std::memcpy(vocab.merge_storage.data() + offset, text.data(), len);
+  const uint32_t id = vocab.n_merges;
+  vocab.merge_offsets[id] = offset;
+  vocab.merge_lengths[id] = len;
+  vocab.merge_bytes_used += len;
+  vocab.n_merges = id + 1;
+}
+
+std::unique_ptr<emel::model::data::vocab> make_document_vocab() {
+  auto vocab = std::make_unique<emel::model::data::vocab>();
+  vocab->tokenizer_model_id = emel::model::data::tokenizer_model::BPE;
+  vocab->tokenizer_pre_id = emel::model::data::tokenizer_pre::LLAMA3;
+  for (int value = 0; value < 256; ++value) {
+    (void)add_token(*vocab, emel::text::unicode_byte_to_utf8(static_cast<uint8_t>(value)), 6);
+  }
+  const std::string space = "\xC4\xA0";
+  (void)add_token(*vocab, "he", 1);
+  (void)add_token(*vocab, space + "t", 1);
+  (void)add_token(*vocab, space + "the", 1);
+  (void)add_token(*vocab, space + "a", 1);
+  (void)add_token(*vocab, space + "an", 1);
+  (void)add_token(*vocab, space + "and", 1);
+  add_merge(*vocab, "h e");
+  add_merge(*vocab, space + " t");
+  add_merge(*vocab, space + "t he");
+  add_merge(*vocab, space + " a");
+  add_merge(*vocab, space + "a n");
+  add_merge(*vocab, space + "an d");
+
+  vocab->bos_id = add_token(*vocab, "<s>", 3);
+  vocab->eos_id = add_token(*vocab, "</s>", 3);
+  (void)add_token(*vocab, "<|sep|>", 4);
+  vocab->add_bos = true;
+  vocab->add_eos = true;
+  return vocab;
+}
+
+bool bind_lane(emel::text::tokenizer::sm & lane,
+               const emel::model::data::vocab & vocab) {
+  emel::text::tokenizer::event::bind bind_ev = {};
+  bind_ev.vocab = &vocab;
+  bind_ev.preprocessor_variant = emel::text::tokenizer::preprocessor::preprocessor_kind::bpe;
+  bind_ev.encoder_variant = emel::text::encoders::encoder_kind::bpe;
+  return lane.process_event(bind_ev);
+}
+
+std::string make_document(const size_t min_bytes) {
+  static constexpr std::array<std::string_view, 8> k_pieces = {{
+      "the quick brown fox and the lazy dog",
+      " <|sep|> an answer",
+      "\nthe end\n",
+      "   spaced  out\t\ttext ",
+      " caf\xC3\xA9 na\xC3\xAFve 12345 67",
+      "\n\nnew paragraph, and then<|sep|>glued",
+      " don't stop it's fine",
+      " 100 + 200 = 300;\n",
+  }};
+  std::string out;
+  size_t index = 0;
+  while (out.size() < min_bytes) {
+    out += k_pieces[index % k_pieces.size()];
+    index = index * 5u + 3u;
+  }
+  return out;
+}
+
+struct lane_set {
+  std::vector<std::unique_ptr<emel::text::tokenizer::sm>> owned = {};
+  std::vector<emel::text::tokenizer::sm *> lanes = {};
+
+  lane_set(const size_t count, const emel::model::data::vocab & vocab) {
+    for (size_t idx = 0; idx < count; ++idx) {
+      owned.push_back(std::make_unique<emel::text::tokenizer::sm>());
+      CHECK(bind_lane(*owned.back(), vocab));
+      lanes.push_back(owned.back().get());
+    }
+  }
+};
+
+std::vector<int32_t> tokenize_document(emel::text::tokenizer::document::sm & machine,
+                                       const emel::model::data::vocab & vocab,
+                                       const lane_set & lanes,
+                                       const std::string_view text,
+                                       const bool add_special,
+                                       int32_t & err) {
+  std::vector<int32_t> tokens(text.size() + 8u, -1);
+  int32_t count = 0;
+  emel::text::tokenizer::document::event::tokenize_document ev = {};
+  ev.vocab = &vocab;
+  ev.text = text;
+  ev.add_special = add_special;
+  ev.parse_special = true;
+  ev.lanes = lanes.lanes;
+  ev.token_ids_out = tokens.data();
+  ev.token_capacity = static_cast<int32_t>(tokens.size());
+  ev.token_count_out = &count;
+  ev.error_out = &err;
+  (void)machine.process_event(ev);
+  tokens.resize(static_cast<size_t>(count));
+  return tokens;
+}
+
+std::vector<int32_t> tokenize_serial(const emel::model::data::vocab & vocab,
+                                     const std::string_view text,
+                                     const bool add_special) {
+  emel::text::tokenizer::sm machine{};
+  REQUIRE(bind_lane(machine, vocab));
+  std::vector<int32_t> tokens(text.size() + 8u, -1);
+  int32_t count = 0;
+  int32_t err = k_error_none;
+  emel::text::tokenizer::event::tokenize ev = {};
+  ev.vocab = &vocab;
+  ev.text = text;
+  ev.add_special = add_special;
+  ev.parse_special = true;
+  ev.token_ids_out = tokens.data();
+  ev.token_capacity = static_cast<int32_t>(tokens.size());
+  ev.token_count_out = &count;
+  ev.error_out = &err;
+  REQUIRE(machine.process_event(ev));
+  REQUIRE(err == k_error_none);
+  tokens.resize(static_cast<size_t>(count));
+  return tokens;
+}
+
+}  // namespace
+
+TEST_CASE("tokenizer_document_cuts_only_at_lone_whitespace") {
+  namespace detail = emel::text::tokenizer::document::detail;
+  emel::text::tokenizer::preprocessor::special_token_cache specials = {};
+  const std::string_view text = "ab cd  ef\ngh\n\nij";
+
+  CHECK(detail::is_safe_cut(text, 2u, specials));
+  CHECK_FALSE(detail::is_safe_cut(text, 3u, specials));
+  CHECK_FALSE(detail::is_safe_cut(text, 5u, specials));
+  CHECK_FALSE(detail::is_safe_cut(text, 6u, specials));
+  CHECK(detail::is_safe_cut(text, 10u, specials));
+  CHECK_FALSE(detail::is_safe_cut(text, 13u, specials));
+  CHECK_FALSE(detail::is_safe_cut(text, 14u, specials));
+
+  const std::string_view tagged = "ab<x> cd";
+  specials.tokens[0].text = "<x>";
+  specials.count = 1;
+  CHECK_FALSE(detail::is_safe_cut(tagged, 5u, specials));
+}
+
+TEST_CASE("tokenizer_document_segments_only_named_bpe_split_profiles") {
+  namespace guard = emel::text::tokenizer::document::guard;
+  auto vocab = make_document_vocab();
+  const std::string text = make_document(3000u);
+  emel::text::tokenizer::document::action::context ctx{};
+  ctx.specials_ready = true;
+  emel::text::tokenizer::document::event::tokenize_document ev = {};
+  ev.vocab = vocab.get();
+  ev.text = text;
+
+  CHECK(guard::detail::segmentable(ev, ctx));
+
+  vocab->tokenizer_pre_id = emel::model::data::tokenizer_pre::DEFAULT;
+  CHECK_FALSE(guard::detail::segmentable(ev, ctx));
+
+  vocab->tokenizer_pre_id = emel::model::data::tokenizer_pre::UNKNOWN;
+  CHECK_FALSE(guard::detail::segmentable(ev, ctx));
+}
+
+TEST_CASE("tokenizer_document_segments_match_serial_tokenize") {
+  auto vocab = make_document_vocab();
+  const std::string text = make_document(3000u);
+  const std::vector<int32_t> expected = tokenize_serial(*vocab, text, true);
+
+  lane_set lanes(1u, *vocab);
+  emel::text::tokenizer::document::sm machine{};
+  int32_t err = k_error_none;
+  const std::vector<int32_t> actual =
+      tokenize_document(machine, *vocab, lanes, text, true, err);
+
+  CHECK(err == k_error_none);
+  CHECK(machine.span_count() == 1);
+  CHECK(actual == expected);
+  CHECK(actual.front() == vocab->bos_id);
+  CHECK(actual.back() == vocab->eos_id);
+}
+
+TEST_CASE("tokenizer_document_parallel_spans_match_serial_tokenize") {
+  auto vocab = make_document_vocab();
+  const std::string text = make_document(3000u);
+  const std::vector<int32_t> expected = tokenize_serial(*vocab, text, true);
+
+  emel::text::tokenizer::document::lane_pool pool{3u};
+  lane_set lanes(3u, *vocab);
+  emel::text::tokenizer::document::sm machine{pool};
+  int32_t err = k_error_none;
+  const std::vector<int32_t> actual =
+      tokenize_document(machine, *vocab, lanes, text, true, err);
+
+  CHECK(err == k_error_none);
+  CHECK(machine.span_count() == 3);
+  CHECK(actual == expected);
+}
+
+TEST_CASE("tokenizer_document_handles_text_beyond_single_dispatch_budget") {
+  auto vocab = make_document_vocab();
+  const std::string text = make_document(64u * 1024u);
+
+  lane_set serial_lanes(1u, *vocab);
+  emel::text::tokenizer::document::sm serial{};
+  int32_t serial_err = k_error_none;
+  const std::vector<int32_t> serial_tokens =
+      tokenize_document(serial, *vocab, serial_lanes, text, false, serial_err);
+
+  emel::text::tokenizer::document::lane_pool pool{4u};
+  lane_set parallel_lanes(4u, *vocab);
+  emel::text::tokenizer::document::sm parallel{pool};
+  int32_t parallel_err = k_error_none;
+  const std::vector<int32_t> parallel_tokens =
+      tokenize_document(parallel, *vocab, parallel_lanes, text, false, parallel_err);
+
+  CHECK(serial_err == k_error_none);
+  CHECK(parallel_err == k_error_none);
+  CHECK_FALSE(serial_tokens.empty());
+  CHECK(parallel_tokens == serial_tokens);
+}
+
+TEST_CASE("tokenizer_document_short_text_is_single_pass") {
+  auto vocab = make_document_vocab();
+  const std::string text = "the answer and the end";
+  const std::vector<int32_t> expected = tokenize_serial(*vocab, text, true);
+
+  emel::text::tokenizer::document::lane_pool pool{2u};
+  lane_set lanes(2u, *vocab);
+  emel::text::tokenizer::document::sm machine{pool};
+  int32_t err = k_error_none;
+  const std::vector<int32_t> actual =
+      tokenize_document(machine, *vocab, lanes, text, true, err);
+
+  CHECK(err == k_error_none);
+  CHECK(machine.span_count() == 1);
+  CHECK(actual == expected);
+}
+
+TEST_CASE("tokenizer_document_rejects_missing_lanes") {
+  auto vocab = make_document_vocab();
+  lane_set lanes(0u, *vocab);
+  emel::text::tokenizer::document::sm machine{};
+  int32_t err = k_error_none;
+  const std::vector<int32_t> tokens =
+      tokenize_document(machine, *vocab, lanes, "the end", false, err);
+
+  CHECK(err == emel::text::tokenizer::error_code(
+                   emel::text::tokenizer::error::invalid_request));
+  CHECK(tokens.empty());
+}
+
+TEST_CASE("tokenizer_document_batch_packs_items_like_serial_tokenize") {
+  auto vocab = make_document_vocab();
+  const std::array<std::string_view, 3> texts = {"the answer", "and the end", " the"};
+  std::vector<int32_t> expected = {};
+  std::array<int32_t, 3> expected_counts = {};
+  for (size_t idx = 0; idx < texts.size(); ++idx) {
+    const std::vector<int32_t> item = tokenize_serial(*vocab, texts[idx], true);
+    expected_counts[idx] = static_cast<int32_t>(item.size());
+    expected.insert(expected.end(), item.begin(), item.end());
+  }
+
+  lane_set lanes(1u, *vocab);
+  emel::text::tokenizer::document::sm machine{};
+  std::vector<int32_t> tokens(64u, -1);
+  std::array<int32_t, 3> counts = {};
+  int32_t total = 0;
+  int32_t err = k_error_none;
+  emel::text::tokenizer::document::event::tokenize_batch ev = {};
+  ev.vocab = vocab.get();
+  ev.texts = texts;
+  ev.add_special = true;
+  ev.parse_special = true;
+  ev.lane = lanes.lanes[0];
+  ev.token_ids_out = tokens.data();
+  ev.token_capacity = static_cast<int32_t>(tokens.size());
+  ev.token_counts_out = counts.data();
+  ev.token_count_out = &total;
+  ev.error_out = &err;
+
+  CHECK(machine.process_event(ev));
+  CHECK(err == k_error_none);
+  CHECK(counts == expected_counts);
+  REQUIRE(total == static_cast<int32_t>(expected.size()));
+  tokens.resize(static_cast<size_t>(total));
+  CHECK(tokens == expected);
+}
+
+TEST_CASE("tokenizer_document_batch_reports_failing_item") {
+  auto vocab = make_document_vocab();
+  const std::array<std::string_view, 3> texts = {"the answer", "and the end", " the"};
+  const std::vector<int32_t> first = tokenize_serial(*vocab, texts[0], true);
+
+  struct error_probe {
+    size_t item_index = 0;
+    int calls = 0;
+  } probe = {};
+  lane_set lanes(1u, *vocab);
+  emel::text::tokenizer::document::sm machine{};
+  std::vector<int32_t> tokens(first.size() + 1u, -1);
+  std::array<int32_t, 3> counts = {};
+  int32_t total = 0;
+  int32_t err = k_error_none;
+  emel::text::tokenizer::document::event::tokenize_batch ev = {};
+  ev.vocab = vocab.get();
+  ev.texts = texts;
+  ev.add_special = true;
+  ev.parse_special = true;
+  ev.lane = lanes.lanes[0];
+  ev.token_ids_out = tokens.data();
+  ev.token_capacity = static_cast<int32_t>(tokens.size());
+  ev.token_counts_out = counts.data();
+  ev.token_count_out = &total;
+  ev.error_out = &err;
+  ev.owner_sm = &probe;
+  ev.dispatch_error =
+      [](void * owner, const emel::text::tokenizer::document::events::batch_error & error_ev) {
+        auto * state = static_cast<error_probe *>(owner);
+        state->item_index = error_ev.item_index;
+        state->calls += 1;
+        return true;
+      };
+
+  CHECK_FALSE(machine.process_event(ev));
+  CHECK(err != k_error_none);
+  CHECK(counts[0] == static_cast<int32_t>(first.size()));
+  CHECK(counts[1] == 0);
+  CHECK(counts[2] == 0);
+  CHECK(probe.calls == 1);
+  CHECK(probe.item_index == 1u);
+
+  ev.texts = {};
+  ev.owner_sm = nullptr;
+  CHECK_FALSE(machine.process_event(ev));
+  CHECK(err == emel::text::tokenizer::error_code(
+                   emel::text::tokenizer::error::invalid_request));
+  CHECK(total == 0);
+}
@@ -31,6 +31,8 @@ int32_t add_token(emel::model::data::vocab & vocab, const char * text,
   vocab.entries[id].type = type;
   vocab.token_bytes_used += len;
   vocab.n_tokens = id + 1;
+  // Stands in for the loader, which builds the shared token trie.
+  (void)emel::text::encoders::detail::prepare_token_trie(vocab);
   return static_cast<int32_t>(id);
 }
 
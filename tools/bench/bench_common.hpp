@@ -8,6 +8,8 @@
 #include <string>
 #include <vector>
 
+#include "bench_statistics.hpp"
+
 namespace emel::bench {
 
 enum class generation_lane_mode {
@@ -21,6 +23,9 @@ struct config {
   std::size_t runs = 0;
   std::uint64_t warmup_iterations = 0;
   std::size_t warmup_runs = 0;
+  // Non-zero switches measure_case to robust mode: this many timed trials
+  // (overriding runs), summarized by statistics::summarize.
+  std::size_t robust_trials = 0;
 };
 
 struct result {
@@ -51,6 +56,15 @@ struct result {
   double ns_min_per_op = 0.0;
   double ns_mean_per_op = 0.0;
   double ns_max_per_op = 0.0;
+  // Robust mode only: bootstrap interval of ns_per_op (the retained median)
+  // and how many trials were trimmed as warmup or rejected as outliers.
+  bool robust = false;
+  double ns_ci_low_per_op = 0.0;
+  double ns_ci_high_per_op = 0.0;
+  double ci_confidence = 0.0;
+  std::size_t warmup_trials_dropped = 0;
+  std::size_t outlier_trials_rejected = 0;
+  std::size_t retained_trials = 0;
   double prepare_ns_per_op = 0.0;
   double encode_ns_per_op = 0.0;
   double publish_ns_per_op = 0.0;
@@ -142,7 +156,8 @@ inline double compute_tokens_per_second(const std::uint64_t output_tokens,
 
 template <class fn_type>
 result measure_case(const char *name, const config &cfg, fn_type &&fn) {
-  const auto runs = std::max<std::size_t>(cfg.runs, 1u);
+  const auto runs = cfg.robust_trials != 0u ? cfg.robust_trials
+                                            : std::max<std::size_t>(cfg.runs, 1u);
   const auto iterations = std::max<std::uint64_t>(cfg.iterations, 1u);
   std::vector<double> samples;
   samples.reserve(runs);
@@ -166,8 +181,13 @@ result measure_case(const char *name, const config &cfg, fn_type &&fn) {
                       static_cast<double>(iterations));
   }
 
+  // Summarized before sorting: warmup detection needs measurement order.
+  const statistics::summary robust_summary =
+      cfg.robust_trials != 0u ? statistics::summarize(samples) : statistics::summary{};
   std::sort(samples.begin(), samples.end());
-  const double reported_ns_per_op = select_reported_ns_per_op(samples);
+  const double reported_ns_per_op = cfg.robust_trials != 0u
+                                        ? robust_summary.median
+                                        : select_reported_ns_per_op(samples);
   double sum = 0.0;
   for (const double sample : samples) {
     sum += sample;
@@ -181,6 +201,13 @@ result measure_case(const char *name, const config &cfg, fn_type &&fn) {
   out.ns_max_per_op = samples.back();
   out.iterations = iterations;
   out.runs = runs;
+  out.robust = cfg.robust_trials != 0u;
+  out.ns_ci_low_per_op = robust_summary.ci.low;
+  out.ns_ci_high_per_op = robust_summary.ci.high;
+  out.ci_confidence = out.robust ? robust_summary.confidence : 0.0;
+  out.warmup_trials_dropped = robust_summary.warmup_dropped;
+  out.outlier_trials_rejected = robust_summary.outliers_rejected;
+  out.retained_trials = robust_summary.retained;
   return out;
 }
 
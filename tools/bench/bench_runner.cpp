@@ -14,12 +14,17 @@
 #include <utility>
 #include <vector>
 
+#if defined(__linux__)
+#include <sched.h>
+#endif
+
 #include "bench_cases.hpp"
 #include "bench_common.hpp"
 #include "bench_dependency_manifest.hpp"
 #include "bench_runner.hpp"
 #include "bench_runner_contract.hpp"
 #include "bench_runner_registry.hpp"
+#include "bench_statistics.hpp"
 #include "diarization_compare_contract.hpp"
 #include "generation_compare_contract.hpp"
 
@@ -72,6 +77,10 @@ constexpr std::size_t k_default_runs = 3;
 constexpr std::uint64_t k_default_warmup_iterations = 10;
 constexpr std::size_t k_default_warmup_runs = 1;
 constexpr std::size_t k_max_runs = 25;
+// Robust mode trades run length for trial count; more trials tighten the
+// bootstrap interval roughly with their square root.
+constexpr std::size_t k_max_robust_trials = 1000;
+constexpr int k_exit_ab_regression = 4;
 constexpr std::string_view k_generation_suite = "generation";
 constexpr std::string_view k_diarization_sortformer_suite =
     "diarization_sortformer";
@@ -323,13 +332,62 @@ void print_benchmark_config(const bench::config &cfg) {
   const auto generation_warmup_runs =
       read_env_size("EMEL_BENCH_GENERATION_WARMUP_RUNS", 0u);
   std::printf("# benchmark_config: iterations=%" PRIu64
-              " runs=%zu sample_policy=median warmup_iterations=%" PRIu64
+              " runs=%zu sample_policy=%s warmup_iterations=%" PRIu64
               " warmup_runs=%zu generation_iterations=%" PRIu64
               " generation_runs=%zu generation_warmup_iterations=%" PRIu64
               " generation_warmup_runs=%zu\n",
-              cfg.iterations, cfg.runs, cfg.warmup_iterations, cfg.warmup_runs,
-              generation_iterations, generation_runs,
-              generation_warmup_iterations, generation_warmup_runs);
+              cfg.iterations, cfg.runs,
+              cfg.robust_trials != 0u ? "robust_median" : "median",
+              cfg.warmup_iterations, cfg.warmup_runs, generation_iterations,
+              generation_runs, generation_warmup_iterations,
+              generation_warmup_runs);
+  if (cfg.robust_trials != 0u) {
+    std::printf("# robust_config: trials=%zu confidence=%.3f "
+                "bootstrap_resamples=%zu outlier_fence_mad=%.2f "
+                "warmup_detection=mser\n",
+                cfg.robust_trials, bench::statistics::k_default_confidence,
+                bench::statistics::k_bootstrap_resamples,
+                bench::statistics::k_outlier_fence);
+  }
+}
+
+// EMEL_BENCH_PIN_CPUS="2", "2,3" or "2-5": binds the runner to those CPUs
+// before any case starts, so lane pools spawned by the cases inherit the
+// mask. Reported on stderr to keep jsonl stdout clean.
+void apply_cpu_pinning() {
+  const char *cpus = std::getenv("EMEL_BENCH_PIN_CPUS");
+  if (cpus == nullptr || cpus[0] == '\0') {
+    return;
+  }
+#if defined(__linux__)
+  cpu_set_t mask;
+  CPU_ZERO(&mask);
+  bool valid = true;
+  std::string_view remaining{cpus};
+  while (valid && !remaining.empty()) {
+    const std::size_t comma = remaining.find(',');
+    const std::string_view item = remaining.substr(0u, comma);
+    remaining = comma == std::string_view::npos ? std::string_view{}
+                                                : remaining.substr(comma + 1u);
+    const std::size_t dash = item.find('-');
+    const std::string_view last_text =
+        dash == std::string_view::npos ? item : item.substr(dash + 1u);
+    std::uint64_t first = 0u;
+    std::uint64_t last = 0u;
+    valid = bench::parse_runner_u64(item.substr(0u, dash), first) &&
+            bench::parse_runner_u64(last_text, last) && first <= last &&
+            last < CPU_SETSIZE;
+    for (std::uint64_t cpu = first; valid && cpu <= last; ++cpu) {
+      CPU_SET(static_cast<int>(cpu), &mask);
+    }
+  }
+  const bool applied =
+      valid && ::sched_setaffinity(0, sizeof(mask), &mask) == 0;
+  std::fprintf(stderr, "# cpu_pinning: cpus=%s status=%s\n", cpus,
+               applied ? "applied" : (valid ? "failed" : "invalid"));
+#else
+  std::fprintf(stderr, "# cpu_pinning: cpus=%s status=unsupported\n", cpus);
+#endif
 }
 
 std::vector<bench::result>
@@ -407,6 +465,17 @@ void print_snapshot(const std::vector<bench::result> &results,
           entry.fixture_id.c_str(), entry.workload_id.c_str(), entry.output_dim,
           entry.output_checksum, entry.note.c_str());
     }
+    if (entry.robust) {
+      std::printf("%s ns_per_op=%.3f ci_low=%.3f ci_high=%.3f "
+                  "confidence=%.3f iter=%" PRIu64
+                  " trials=%zu retained=%zu warmup_dropped=%zu "
+                  "outliers_rejected=%zu\n",
+                  entry.name.c_str(), entry.ns_per_op, entry.ns_ci_low_per_op,
+                  entry.ns_ci_high_per_op, entry.ci_confidence,
+                  entry.iterations, entry.runs, entry.retained_trials,
+                  entry.warmup_trials_dropped, entry.outlier_trials_rejected);
+      continue;
+    }
     if (is_generation_case_name(entry.name)) {
       std::printf("%s ns_per_op=%.3f tokens_per_second=%.3f iter=%" PRIu64
                   " runs=%zu\n",
@@ -420,6 +489,90 @@ void print_snapshot(const std::vector<bench::result> &results,
   }
 }
 
+// EMEL_BENCH_ROBUST_JSONL=<path>: appends one statistics::record per robust
+// result, the input --ab-compare reads back.
+void write_robust_records(const std::vector<bench::result> &results,
+                          const std::string_view lane) {
+  const char *path = std::getenv("EMEL_BENCH_ROBUST_JSONL");
+  if (path == nullptr || path[0] == '\0') {
+    return;
+  }
+  std::ofstream output(path, std::ios::binary | std::ios::app);
+  for (const bench::result &entry : results) {
+    if (!entry.robust) {
+      continue;
+    }
+    bench::statistics::record record{};
+    record.case_name = entry.name;
+    record.lane = std::string{lane};
+    record.iterations = entry.iterations;
+    record.stats.median = entry.ns_per_op;
+    record.stats.ci = {entry.ns_ci_low_per_op, entry.ns_ci_high_per_op};
+    record.stats.confidence = entry.ci_confidence;
+    record.stats.trials = entry.runs;
+    record.stats.warmup_dropped = entry.warmup_trials_dropped;
+    record.stats.outliers_rejected = entry.outlier_trials_rejected;
+    record.stats.retained = entry.retained_trials;
+    output << bench::statistics::serialize_record(record) << '\n';
+  }
+  if (!output) {
+    std::fprintf(stderr, "error: failed to write robust records to %s\n",
+                 path);
+  }
+}
+
+bool read_robust_records(const std::string &path,
+                         std::vector<bench::statistics::record> &out) {
+  std::ifstream input(path, std::ios::binary);
+  if (!input) {
+    return false;
+  }
+  std::string line = {};
+  while (std::getline(input, line)) {
+    if (line.empty()) {
+      continue;
+    }
+    bench::statistics::record record{};
+    if (!bench::statistics::parse_record(line, record)) {
+      return false;
+    }
+    out.push_back(std::move(record));
+  }
+  return true;
+}
+
+// bench_runner --ab-compare <baseline.jsonl> <candidate.jsonl>: one bench_ab
+// line per case and lane present in both; exits k_exit_ab_regression when
+// any candidate interval lies wholly above its baseline interval.
+int run_ab_compare(const std::string &baseline_path,
+                   const std::string &candidate_path) {
+  std::vector<bench::statistics::record> baseline = {};
+  std::vector<bench::statistics::record> candidate = {};
+  if (!read_robust_records(baseline_path, baseline) ||
+      !read_robust_records(candidate_path, candidate)) {
+    std::fprintf(stderr, "error: unreadable robust records (%s, %s)\n",
+                 baseline_path.c_str(), candidate_path.c_str());
+    return 2;
+  }
+  bool regressed = false;
+  for (const bench::statistics::record &after : candidate) {
+    const auto before = std::find_if(
+        baseline.begin(), baseline.end(),
+        [&after](const bench::statistics::record &entry) {
+          return entry.case_name == after.case_name && entry.lane == after.lane;
+        });
+    if (before == baseline.end()) {
+      std::fprintf(stderr, "warning: no baseline for %s (%s)\n",
+                   after.case_name.c_str(), after.lane.c_str());
+      continue;
+    }
+    regressed = regressed || bench::statistics::compare(before->stats, after.stats) ==
+                                 bench::statistics::verdict::regression;
+    std::printf("%s\n", bench::statistics::serialize_ab(*before, after).c_str());
+  }
+  return regressed ? k_exit_ab_regression : 0;
+}
+
 void print_generation_jsonl(const std::vector<bench::result> &results) {
   std::vector<bench::result> sorted = results;
   std::sort(sorted.begin(), sorted.end(),
@@ -1327,6 +1480,11 @@ validate_process_runner_request(const bench::runner_request &request) {
         2, "invalid_request",
         "serialized request warmup_runs must be at most 25");
   }
+  if (request.cfg.robust_trials > k_max_robust_trials) {
+    return make_runner_error(
+        2, "invalid_request",
+        "serialized request robust_trials must be at most 1000");
+  }
   if (!k_bench_compiled_suite.empty() &&
       request.suite != k_bench_compiled_suite) {
     return make_runner_error(
@@ -1359,6 +1517,7 @@ int execute_runner_request(const bench::runner_request &request) {
     const auto results = run_benchmarks(
         request.cfg, bench::kernel_runner_cases(), false, false, request.suite);
     print_snapshot(results, request.cfg);
+    write_robust_records(results, "emel");
     return 0;
   }
 
@@ -1366,6 +1525,7 @@ int execute_runner_request(const bench::runner_request &request) {
     const auto results = run_benchmarks(
         request.cfg, bench::kernel_runner_cases(), true, false, request.suite);
     print_snapshot(results, request.cfg);
+    write_robust_records(results, "reference");
     return 0;
   }
 
@@ -1375,6 +1535,8 @@ int execute_runner_request(const bench::runner_request &request) {
     const auto ref_results = run_benchmarks(
         request.cfg, bench::kernel_runner_cases(), true, false, request.suite);
     print_compare(emel_results, ref_results, request.cfg);
+    write_robust_records(emel_results, "emel");
+    write_robust_records(ref_results, "reference");
     return 0;
   }
 
@@ -1389,6 +1551,7 @@ int execute_runner_request(const bench::runner_request &request) {
     } else {
       print_snapshot(results, request.cfg);
     }
+    write_robust_records(results, "emel");
     return 0;
   }
 
@@ -1403,6 +1566,7 @@ int execute_runner_request(const bench::runner_request &request) {
     } else {
       print_snapshot(results, request.cfg);
     }
+    write_robust_records(results, "reference");
     return 0;
   }
 
@@ -1412,6 +1576,8 @@ int execute_runner_request(const bench::runner_request &request) {
   const auto ref_results = run_benchmarks(
       request.cfg, bench::default_runner_cases(), true, true, request.suite);
   print_compare(emel_results, ref_results, request.cfg);
+  write_robust_records(emel_results, "emel");
+  write_robust_records(ref_results, "reference");
   return 0;
 }
 
@@ -1454,6 +1620,15 @@ int emel::bench::run_bench_cli(int argc, char **argv) {
     return run_serialized_process_request(process_request);
   }
 
+  if (argc >= 2 && std::string_view{argv[1]} == "--ab-compare") {
+    if (argc != 4) {
+      std::fprintf(stderr, "error: usage: --ab-compare <baseline.jsonl> "
+                           "<candidate.jsonl>\n");
+      return 2;
+    }
+    return run_ab_compare(argv[2], argv[3]);
+  }
+
   manifest_args manifest = {};
   if (!parse_manifest_args(argc, argv, manifest)) {
     std::fprintf(stderr, "error: invalid dependency manifest arguments\n");
@@ -1496,6 +1671,9 @@ int emel::bench::run_bench_cli(int argc, char **argv) {
                    std::min(cfg.iterations, k_default_warmup_iterations));
   cfg.warmup_runs =
       read_env_size("EMEL_BENCH_WARMUP_RUNS", k_default_warmup_runs);
+  cfg.robust_trials = static_cast<std::size_t>(std::min<std::uint64_t>(
+      read_env_u64("EMEL_BENCH_ROBUST_TRIALS", 0u), k_max_robust_trials));
+  apply_cpu_pinning();
 
   const char *selected_suite = std::getenv("EMEL_BENCH_SUITE");
   const bench::runner_request request{
@@ -171,6 +171,9 @@ inline std::string serialize_runner_request(const runner_request & request) {
   append_runner_contract_line(out,
                               "warmup_runs",
                               static_cast<std::uint64_t>(request.cfg.warmup_runs));
+  append_runner_contract_line(out,
+                              "robust_trials",
+                              static_cast<std::uint64_t>(request.cfg.robust_trials));
   append_runner_contract_line(out, "generation_jsonl", request.generation_jsonl ? "1" : "0");
   append_runner_contract_line(out, "diarization_jsonl", request.diarization_jsonl ? "1" : "0");
   return out;
@@ -224,6 +227,10 @@ inline bool parse_runner_request_line(const std::string_view key,
     saw_warmup_runs = parse_runner_size(value, out.cfg.warmup_runs);
     return saw_warmup_runs;
   }
+  if (key == "robust_trials") {
+    // Optional: requests written before robust mode leave it off.
+    return parse_runner_size(value, out.cfg.robust_trials);
+  }
   if (key == "generation_jsonl") {
     saw_generation_jsonl = parse_runner_bool(value, out.generation_jsonl);
     return saw_generation_jsonl;
@@ -627,6 +627,7 @@ TEST_CASE("bench runner contract serializes requests and results for a process "
   request.cfg.runs = 3u;
   request.cfg.warmup_iterations = 5u;
   request.cfg.warmup_runs = 1u;
+  request.cfg.robust_trials = 40u;
   request.generation_jsonl = true;
 
   const std::string serialized = emel::bench::serialize_runner_request(request);
@@ -643,6 +644,7 @@ TEST_CASE("bench runner contract serializes requests and results for a process "
   CHECK(parsed.cfg.runs == 3u);
   CHECK(parsed.cfg.warmup_iterations == 5u);
   CHECK(parsed.cfg.warmup_runs == 1u);
+  CHECK(parsed.cfg.robust_trials == 40u);
   CHECK(parsed.generation_jsonl);
   CHECK_FALSE(parsed.diarization_jsonl);
 
@@ -694,6 +696,105 @@ TEST_CASE("benchmark measurement clamps zero runs and iterations") {
   CHECK(measured.runs == 1u);
 }
 
+TEST_CASE("robust statistics trim warmup and outliers before the interval") {
+  namespace statistics = emel::bench::statistics;
+  std::vector<double> trials{};
+  // Eight slow cold trials, then a noisy steady state around 100 ns with two
+  // preempted trials.
+  for (int trial = 0; trial < 8; ++trial) {
+    trials.push_back(400.0 - 30.0 * trial);
+  }
+  for (int trial = 0; trial < 40; ++trial) {
+    trials.push_back(trial == 17 || trial == 31 ? 900.0
+                                                : 100.0 + (trial % 5) - 2.0);
+  }
+
+  const statistics::summary stats = statistics::summarize(trials);
+  CHECK(stats.trials == 48u);
+  CHECK(stats.warmup_dropped >= 8u);
+  CHECK(stats.outliers_rejected == 2u);
+  CHECK(stats.retained + stats.warmup_dropped + stats.outliers_rejected == 48u);
+  CHECK(stats.median == doctest::Approx(100.0));
+  CHECK(stats.ci.low <= stats.median);
+  CHECK(stats.ci.high >= stats.median);
+  CHECK(stats.ci.high - stats.ci.low <= 2.0);
+  // Seeded bootstrap: the same trials give the same interval.
+  const statistics::summary again = statistics::summarize(trials);
+  CHECK(again.ci.low == stats.ci.low);
+  CHECK(again.ci.high == stats.ci.high);
+}
+
+TEST_CASE("robust A/B verdicts need separated intervals") {
+  namespace statistics = emel::bench::statistics;
+  statistics::summary baseline{};
+  baseline.median = 100.0;
+  baseline.ci = {98.0, 102.0};
+  baseline.retained = 30u;
+  statistics::summary candidate = baseline;
+
+  candidate.median = 101.5;
+  candidate.ci = {99.5, 103.5};
+  CHECK(statistics::compare(baseline, candidate) ==
+        statistics::verdict::unchanged);
+  candidate.median = 105.0;
+  candidate.ci = {103.0, 107.0};
+  CHECK(statistics::compare(baseline, candidate) ==
+        statistics::verdict::regression);
+  CHECK(statistics::relative_change(baseline, candidate) ==
+        doctest::Approx(0.05));
+  candidate.median = 95.0;
+  candidate.ci = {93.0, 97.0};
+  CHECK(statistics::compare(baseline, candidate) ==
+        statistics::verdict::improvement);
+  candidate.retained = 3u;
+  CHECK(statistics::compare(baseline, candidate) ==
+        statistics::verdict::insufficient);
+
+  statistics::record before{};
+  before.case_name = "kernel/x86_64/\"dot\"";
+  before.lane = "emel";
+  before.iterations = 100u;
+  before.stats = baseline;
+  before.stats.trials = 32u;
+  before.stats.warmup_dropped = 2u;
+  statistics::record parsed{};
+  REQUIRE(statistics::parse_record(statistics::serialize_record(before), parsed));
+  CHECK(parsed.case_name == before.case_name);
+  CHECK(parsed.lane == "emel");
+  CHECK(parsed.iterations == 100u);
+  CHECK(parsed.stats.median == baseline.median);
+  CHECK(parsed.stats.ci.high == baseline.ci.high);
+  CHECK(parsed.stats.trials == 32u);
+  CHECK(parsed.stats.warmup_dropped == 2u);
+  CHECK(parsed.stats.retained == 30u);
+
+  statistics::record after = parsed;
+  after.stats.median = 105.0;
+  after.stats.ci = {103.0, 107.0};
+  const std::string ab = statistics::serialize_ab(before, after);
+  CHECK(ab.find("\"schema\":\"bench_ab/v1\"") != std::string::npos);
+  CHECK(ab.find("\"verdict\":\"regression\"") != std::string::npos);
+}
+
+TEST_CASE("benchmark measurement in robust mode reports an interval") {
+  emel::bench::config cfg = {};
+  cfg.runs = 3u;
+  cfg.robust_trials = 12u;
+  std::uint32_t calls = 0;
+  const auto measured =
+      emel::bench::measure_case("bench/robust", cfg, [&]() { ++calls; });
+
+  CHECK(calls == 12u);
+  CHECK(measured.robust);
+  CHECK(measured.runs == 12u);
+  CHECK(measured.retained_trials + measured.warmup_trials_dropped +
+            measured.outlier_trials_rejected ==
+        12u);
+  CHECK(measured.ns_ci_low_per_op <= measured.ns_per_op);
+  CHECK(measured.ns_ci_high_per_op >= measured.ns_per_op);
+  CHECK(measured.ci_confidence == doctest::Approx(0.95));
+}
+
 TEST_CASE("bench runner contract rejects malformed process payloads") {
   emel::bench::runner_request request = {};
   CHECK_FALSE(emel::bench::parse_runner_request(
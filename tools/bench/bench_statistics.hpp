@@ -0,0 +1,371 @@
+#pragma once
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <span>
+#include <string>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+// Robust per-case timing for bench_runner (EMEL_BENCH_ROBUST_TRIALS): many
+// short trials instead of a few long runs, the warmup transient trimmed off
+// the front (MSER), outliers dropped by a median/MAD fence, and the median
+// reported with a percentile-bootstrap confidence interval. An A/B compare
+// of two recorded runs calls a change a regression or an improvement only
+// when the two intervals do not overlap, so 3-5% kernel wins are claimed
+// when they clear run-to-run noise and not before.
+namespace emel::bench::statistics {
+
+inline constexpr double k_default_confidence = 0.95;
+inline constexpr std::size_t k_bootstrap_resamples = 2000u;
+// Modified z-score fence (Iglewicz and Hoaglin); 1.4826 * MAD estimates sigma.
+inline constexpr double k_outlier_fence = 3.5;
+inline constexpr double k_mad_to_sigma = 1.4826;
+// Fewer retained trials than this cannot support an interval verdict.
+inline constexpr std::size_t k_min_retained_trials = 5u;
+inline constexpr std::uint64_t k_bootstrap_seed = 0x9e3779b97f4a7c15u;
+
+struct interval {
+  double low = 0.0;
+  double high = 0.0;
+};
+
+struct summary {
+  double median = 0.0;
+  interval ci = {};
+  double confidence = k_default_confidence;
+  std::size_t trials = 0u;
+  std::size_t warmup_dropped = 0u;
+  std::size_t outliers_rejected = 0u;
+  std::size_t retained = 0u;
+};
+
+enum class verdict : std::uint8_t {
+  unchanged,
+  regression,
+  improvement,
+  insufficient,
+};
+
+inline std::string_view verdict_name(const verdict value) noexcept {
+  switch (value) {
+    case verdict::unchanged:
+      return "unchanged";
+    case verdict::regression:
+      return "regression";
+    case verdict::improvement:
+      return "improvement";
+    case verdict::insufficient:
+      return "insufficient";
+  }
+  return "insufficient";
+}
+
+inline double median_of_sorted(const std::span<const double> sorted) noexcept {
+  if (sorted.empty()) {
+    return 0.0;
+  }
+  const std::size_t mid = sorted.size() / 2u;
+  return sorted.size() % 2u == 1u ? sorted[mid]
+                                  : 0.5 * (sorted[mid - 1u] + sorted[mid]);
+}
+
+inline double median_of(std::vector<double> values) {
+  std::sort(values.begin(), values.end());
+  return median_of_sorted(values);
+}
+
+// Median and robust sigma (1.4826 * median absolute deviation).
+struct spread {
+  double center = 0.0;
+  double sigma = 0.0;
+};
+
+inline spread median_and_sigma(const std::span<const double> samples) {
+  const double center = median_of({samples.begin(), samples.end()});
+  std::vector<double> deviations;
+  deviations.reserve(samples.size());
+  for (const double sample : samples) {
+    deviations.push_back(std::fabs(sample - center));
+  }
+  return {center, k_mad_to_sigma * median_of(std::move(deviations))};
+}
+
+// Marginal Standard Error Rule: the truncation point d in [0, n/2] that
+// minimizes the variance of samples[d, n) over (n - d)^2. A run still ramping
+// up (cold caches, frequency scaling, page faults) has a biased head whose
+// removal shrinks that ratio; a stationary series keeps d at or near 0.
+// Samples are clamped to the outlier fence first so one preempted trial in
+// the tail cannot outweigh the whole warmup transient.
+inline std::size_t detect_warmup(const std::span<const double> samples) {
+  const std::size_t count = samples.size();
+  if (count < 2u * k_min_retained_trials) {
+    return 0u;
+  }
+  const spread fence = median_and_sigma(samples);
+  const double low = fence.center - k_outlier_fence * fence.sigma;
+  const double high = fence.center + k_outlier_fence * fence.sigma;
+  std::vector<double> suffix_sum(count + 1u, 0.0);
+  std::vector<double> suffix_square(count + 1u, 0.0);
+  for (std::size_t index = count; index > 0u; --index) {
+    const double value = std::clamp(samples[index - 1u], low, high);
+    suffix_sum[index - 1u] = suffix_sum[index] + value;
+    suffix_square[index - 1u] = suffix_square[index] + value * value;
+  }
+  std::size_t best = 0u;
+  double best_score = 0.0;
+  for (std::size_t cut = 0u; cut <= count / 2u; ++cut) {
+    const double kept = static_cast<double>(count - cut);
+    const double mean = suffix_sum[cut] / kept;
+    const double deviation =
+        std::max(0.0, suffix_square[cut] - kept * mean * mean);
+    const double score = deviation / (kept * kept);
+    if (cut == 0u || score < best_score) {
+      best = cut;
+      best_score = score;
+    }
+  }
+  return best;
+}
+
+// Samples within k_outlier_fence robust sigmas of the median, in input
+// order. A zero MAD (over half the samples identical) keeps everything.
+inline std::vector<double> reject_outliers(const std::span<const double> samples,
+                                           std::size_t &rejected_out) {
+  rejected_out = 0u;
+  const auto [center, sigma] = median_and_sigma(samples);
+  std::vector<double> kept;
+  kept.reserve(samples.size());
+  for (const double sample : samples) {
+    if (sigma > 0.0 && std::fabs(sample - center) > k_outlier_fence * sigma) {
+      rejected_out += 1u;
+      continue;
+    }
+    kept.push_back(sample);
+  }
+  return kept;
+}
+
+inline std::uint64_t next_random(std::uint64_t &state) noexcept {
+  state += 0x9e3779b97f4a7c15u;
+  std::uint64_t mixed = state;
+  mixed = (mixed ^ (mixed >> 30u)) * 0xbf58476d1ce4e5b9u;
+  mixed = (mixed ^ (mixed >> 27u)) * 0x94d049bb133111ebu;
+  return mixed ^ (mixed >> 31u);
+}
+
+// Percentile bootstrap interval of the median. Seeded, so the same samples
+// always give the same interval.
+inline interval bootstrap_median(const std::span<const double> samples,
+                                 const double confidence,
+                                 const std::size_t resamples,
+                                 std::uint64_t seed) {
+  if (samples.empty() || resamples == 0u) {
+    return {};
+  }
+  std::vector<double> medians;
+  medians.reserve(resamples);
+  std::vector<double> draw(samples.size());
+  const double scale = 0x1.0p-53 * static_cast<double>(samples.size());
+  for (std::size_t round = 0u; round < resamples; ++round) {
+    for (double &value : draw) {
+      const auto index =
+          static_cast<std::size_t>(static_cast<double>(next_random(seed) >> 11u) * scale);
+      value = samples[std::min(index, samples.size() - 1u)];
+    }
+    std::sort(draw.begin(), draw.end());
+    medians.push_back(median_of_sorted(draw));
+  }
+  std::sort(medians.begin(), medians.end());
+  const double tail = 0.5 * (1.0 - confidence);
+  const auto low = static_cast<std::size_t>(tail * static_cast<double>(resamples));
+  const auto high = static_cast<std::size_t>(
+      std::ceil((1.0 - tail) * static_cast<double>(resamples)));
+  return {medians[std::min(low, resamples - 1u)],
+          medians[std::min(high == 0u ? 0u : high - 1u, resamples - 1u)]};
+}
+
+// Trials in measurement order: trims warmup, then outliers, then bootstraps.
+inline summary summarize(const std::span<const double> trials,
+                         const double confidence = k_default_confidence) {
+  summary out{};
+  out.confidence = confidence;
+  out.trials = trials.size();
+  out.warmup_dropped = detect_warmup(trials);
+  const std::vector<double> kept =
+      reject_outliers(trials.subspan(out.warmup_dropped), out.outliers_rejected);
+  out.retained = kept.size();
+  out.median = median_of(kept);
+  out.ci = bootstrap_median(kept, confidence, k_bootstrap_resamples, k_bootstrap_seed);
+  return out;
+}
+
+// Lower is better (ns per op).
+inline verdict compare(const summary &baseline, const summary &candidate) noexcept {
+  if (baseline.retained < k_min_retained_trials ||
+      candidate.retained < k_min_retained_trials) {
+    return verdict::insufficient;
+  }
+  if (candidate.ci.low > baseline.ci.high) {
+    return verdict::regression;
+  }
+  if (candidate.ci.high < baseline.ci.low) {
+    return verdict::improvement;
+  }
+  return verdict::unchanged;
+}
+
+inline double relative_change(const summary &baseline, const summary &candidate) noexcept {
+  return baseline.median > 0.0 ? candidate.median / baseline.median - 1.0 : 0.0;
+}
+
+// One JSONL line per case, written by a robust run and read back by
+// --ab-compare.
+struct record {
+  std::string case_name = {};
+  std::string lane = {};
+  std::uint64_t iterations = 0u;
+  summary stats = {};
+};
+
+inline constexpr std::string_view k_record_schema = "bench_robust/v1";
+inline constexpr std::string_view k_ab_schema = "bench_ab/v1";
+
+inline void append_json_string(std::string &out, const std::string_view text) {
+  out.push_back('"');
+  for (const char ch : text) {
+    if (ch == '"' || ch == '\\') {
+      out.push_back('\\');
+    }
+    out.push_back(ch);
+  }
+  out.push_back('"');
+}
+
+inline void append_json_number(std::string &out, const double value) {
+  char buffer[64] = {};
+  std::snprintf(buffer, sizeof(buffer), "%.17g", value);
+  out += buffer;
+}
+
+inline std::string serialize_record(const record &entry) {
+  std::string out = "{\"schema\":";
+  append_json_string(out, k_record_schema);
+  out += ",\"case\":";
+  append_json_string(out, entry.case_name);
+  out += ",\"lane\":";
+  append_json_string(out, entry.lane);
+  out += ",\"iterations\":" + std::to_string(entry.iterations);
+  out += ",\"median_ns\":";
+  append_json_number(out, entry.stats.median);
+  out += ",\"ci_low_ns\":";
+  append_json_number(out, entry.stats.ci.low);
+  out += ",\"ci_high_ns\":";
+  append_json_number(out, entry.stats.ci.high);
+  out += ",\"confidence\":";
+  append_json_number(out, entry.stats.confidence);
+  out += ",\"trials\":" + std::to_string(entry.stats.trials);
+  out += ",\"warmup_dropped\":" + std::to_string(entry.stats.warmup_dropped);
+  out += ",\"outliers_rejected\":" + std::to_string(entry.stats.outliers_rejected);
+  out += ",\"retained\":" + std::to_string(entry.stats.retained);
+  out += "}";
+  return out;
+}
+
+// Value text of "key": in a flat object written by serialize_record; strings
+// come back unescaped.
+inline bool find_json_field(const std::string_view line, const std::string_view key,
+                            std::string &value_out) {
+  const std::string needle = "\"" + std::string{key} + "\":";
+  const std::size_t start = line.find(needle);
+  if (start == std::string_view::npos) {
+    return false;
+  }
+  std::size_t cursor = start + needle.size();
+  value_out.clear();
+  if (cursor < line.size() && line[cursor] == '"') {
+    for (cursor += 1u; cursor < line.size() && line[cursor] != '"'; ++cursor) {
+      cursor += line[cursor] == '\\' ? 1u : 0u;
+      if (cursor < line.size()) {
+        value_out.push_back(line[cursor]);
+      }
+    }
+    return cursor < line.size();
+  }
+  for (; cursor < line.size() && line[cursor] != ',' && line[cursor] != '}'; ++cursor) {
+    value_out.push_back(line[cursor]);
+  }
+  return !value_out.empty();
+}
+
+inline bool parse_record(const std::string_view line, record &out) {
+  std::string schema = {};
+  std::string field = {};
+  if (!find_json_field(line, "schema", schema) || schema != k_record_schema ||
+      !find_json_field(line, "case", out.case_name) ||
+      !find_json_field(line, "lane", out.lane)) {
+    return false;
+  }
+  const auto read_number = [&](const std::string_view key, double &value) {
+    if (!find_json_field(line, key, field)) {
+      return false;
+    }
+    char *end = nullptr;
+    value = std::strtod(field.c_str(), &end);
+    return end != field.c_str();
+  };
+  double iterations = 0.0;
+  double trials = 0.0;
+  double warmup = 0.0;
+  double outliers = 0.0;
+  double retained = 0.0;
+  const bool parsed = read_number("iterations", iterations) &&
+                      read_number("median_ns", out.stats.median) &&
+                      read_number("ci_low_ns", out.stats.ci.low) &&
+                      read_number("ci_high_ns", out.stats.ci.high) &&
+                      read_number("confidence", out.stats.confidence) &&
+                      read_number("trials", trials) &&
+                      read_number("warmup_dropped", warmup) &&
+                      read_number("outliers_rejected", outliers) &&
+                      read_number("retained", retained);
+  out.iterations = static_cast<std::uint64_t>(iterations);
+  out.stats.trials = static_cast<std::size_t>(trials);
+  out.stats.warmup_dropped = static_cast<std::size_t>(warmup);
+  out.stats.outliers_rejected = static_cast<std::size_t>(outliers);
+  out.stats.retained = static_cast<std::size_t>(retained);
+  return parsed;
+}
+
+inline std::string serialize_ab(const record &baseline, const record &candidate) {
+  std::string out = "{\"schema\":";
+  append_json_string(out, k_ab_schema);
+  out += ",\"case\":";
+  append_json_string(out, candidate.case_name);
+  out += ",\"lane\":";
+  append_json_string(out, candidate.lane);
+  out += ",\"baseline_median_ns\":";
+  append_json_number(out, baseline.stats.median);
+  out += ",\"baseline_ci_low_ns\":";
+  append_json_number(out, baseline.stats.ci.low);
+  out += ",\"baseline_ci_high_ns\":";
+  append_json_number(out, baseline.stats.ci.high);
+  out += ",\"candidate_median_ns\":";
+  append_json_number(out, candidate.stats.median);
+  out += ",\"candidate_ci_low_ns\":";
+  append_json_number(out, candidate.stats.ci.low);
+  out += ",\"candidate_ci_high_ns\":";
+  append_json_number(out, candidate.stats.ci.high);
+  out += ",\"change\":";
+  append_json_number(out, relative_change(baseline.stats, candidate.stats));
+  out += ",\"verdict\":";
+  append_json_string(out, verdict_name(compare(baseline.stats, candidate.stats)));
+  out += "}";
+  return out;
+}
+
+}  // namespace emel::bench::statistics
@@ -0,0 +1,92 @@
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstdio>
+
+#if defined(__linux__) || defined(__APPLE__)
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+#include "emel/memory/footprint.hpp"
+
+// Owner side of emel::memory::footprint for the bench tools: the mincore(2)
+// residency probe the actors call per weight tensor, and the process RSS the
+// per-session breakdown is printed next to. Hosts without mincore get an
+// empty probe and the footprint reports mapped weights unprobed.
+namespace emel::bench::footprint_probe {
+
+#if defined(__linux__) || defined(__APPLE__)
+
+// Bytes of [data, data + size) on resident pages; pages a range only partly
+// covers count for the covered part so neighbouring tensors never share a
+// page's bytes.
+inline std::uint64_t resident_bytes(const void *data, const std::uint64_t size,
+                                    void *) noexcept {
+  const long page_size = ::sysconf(_SC_PAGESIZE);
+  if (data == nullptr || size == 0u || page_size <= 0) {
+    return 0u;
+  }
+  const std::uint64_t page = static_cast<std::uint64_t>(page_size);
+  const std::uint64_t begin = reinterpret_cast<std::uintptr_t>(data);
+  const std::uint64_t end = begin + size;
+  constexpr std::uint64_t k_chunk_pages = 4096u;
+#if defined(__APPLE__)
+  std::array<char, k_chunk_pages> residency = {};
+#else
+  std::array<unsigned char, k_chunk_pages> residency = {};
+#endif
+  std::uint64_t resident = 0u;
+  for (std::uint64_t chunk = begin - begin % page; chunk < end;
+       chunk += k_chunk_pages * page) {
+    const std::uint64_t chunk_end = std::min(end, chunk + k_chunk_pages * page);
+    const std::uint64_t pages = (chunk_end - chunk + page - 1u) / page;
+    if (::mincore(reinterpret_cast<void *>(chunk),
+                  static_cast<size_t>(pages * page), residency.data()) != 0) {
+      continue;
+    }
+    for (std::uint64_t index = 0u; index < pages; ++index) {
+      if ((residency[index] & 1) == 0) {
+        continue;
+      }
+      const std::uint64_t lo = std::max(begin, chunk + index * page);
+      const std::uint64_t hi = std::min(end, chunk + (index + 1u) * page);
+      resident += hi - lo;
+    }
+  }
+  return resident;
+}
+
+inline emel::memory::footprint::probe probe() noexcept {
+  return {&resident_bytes, nullptr};
+}
+
+#else
+
+inline emel::memory::footprint::probe probe() noexcept { return {}; }
+
+#endif
+
+// Resident set size of the process, 0 where /proc/self/statm is unavailable.
+inline std::uint64_t process_rss_bytes() noexcept {
+#if defined(__linux__)
+  std::FILE *statm = std::fopen("/proc/self/statm", "r");
+  if (statm == nullptr) {
+    return 0u;
+  }
+  unsigned long long total_pages = 0u;
+  unsigned long long resident_pages = 0u;
+  const int read = std::fscanf(statm, "%llu %llu", &total_pages, &resident_pages);
+  std::fclose(statm);
+  const long page_size = ::sysconf(_SC_PAGESIZE);
+  return read == 2 && page_size > 0
+             ? resident_pages * static_cast<std::uint64_t>(page_size)
+             : 0u;
+#else
+  return 0u;
+#endif
+}
+
+}  // namespace emel::bench::footprint_probe
@@ -5,6 +5,10 @@
 #include "embedding_generator_bench_helpers.hpp"
 #include "generation_compare_contract.hpp"
 #include "generation_workload_manifest.hpp"
+#include "kernel/roofline_host.hpp"
+#include "footprint_probe.hpp"
+#include "kernel_profile_perf.hpp"
+#include "trace_export.hpp"
 #include "model_load_strategy.hpp"
 
 #include <algorithm>
@@ -155,6 +159,20 @@ constexpr char k_generation_reference_batch_threads_env[] =
 constexpr char k_legacy_generation_reference_threads_env[] =
     "EMEL_BENCH_REFERENCE_THREADS";
 constexpr char k_generation_stage_probe_env[] = "EMEL_GENERATION_STAGE_PROBE";
+// CSV path; when set, emel-lane cases record per-dispatch hardware counters
+// (emel::kernel::profile) and print a route/stage table to stderr.
+constexpr char k_generation_kernel_profile_env[] = "EMEL_BENCH_KERNEL_PROFILE";
+// Any value but "0" prints each emel-lane case's kernel roofline to stderr.
+constexpr char k_generation_roofline_env[] = "EMEL_BENCH_ROOFLINE";
+// Path prefix; when set, each emel-lane case writes a Chrome trace of its
+// timed runs to <prefix>.<case>.json (needs an EMEL_ENABLE_TRACE build).
+constexpr char k_generation_trace_env[] = "EMEL_BENCH_TRACE";
+// Any value but "0" records generator latency histograms (TTFT, inter-token,
+// prefill, sampler, renderer, window stalls) and prints p50/p90/p99 per case.
+constexpr char k_generation_latency_env[] = "EMEL_BENCH_LATENCY";
+// Any value but "0" prints each emel-lane case's memory footprint before and
+// after its runs, broken down by what holds the bytes, next to process RSS.
+constexpr char k_generation_footprint_env[] = "EMEL_BENCH_FOOTPRINT";
 constexpr std::string_view k_generation_benchmark_lane_single = "single";
 constexpr std::string_view k_generation_benchmark_lane_multithreaded =
     "multithreaded";
@@ -843,6 +861,10 @@ struct emel_session {
   generation_seam_audit seam = {};
   initialize_capture initialize = {};
   generation_capture generation = {};
+  emel::bench::kernel_profile::perf_group kernel_perf = {};
+  std::unique_ptr<emel::kernel::profile::recorder> kernel_profile = {};
+  std::unique_ptr<emel::bench::trace_export::recording> trace = {};
+  std::unique_ptr<emel::text::generator::latency::recorder> latency = {};
 };
 
 struct prepared_generation_fixture {
@@ -960,6 +982,16 @@ bool capture_generator_diagnostics(
       emel::text::generator::event::capture_diagnostics{diagnostics_out});
 }
 
+bool capture_generator_footprint(emel_session &session,
+                                 emel::memory::footprint::report &report_out) {
+  if (session.generator == nullptr) {
+    return false;
+  }
+  return session.generator->process_event(
+      emel::text::generator::event::capture_memory_footprint{
+          report_out, emel::bench::footprint_probe::probe()});
+}
+
 bool configure_generator_benchmark_lane(emel_session &session) {
   if (session.generator == nullptr) {
     return false;
@@ -1680,7 +1712,9 @@ emel::error::type prebind_emel_gguf_storage(emel_fixture &fixture) {
 
   const uint64_t arena_bytes =
       emel::gguf::loader::required_kv_arena_bytes(requirements);
-  if (arena_bytes == std::numeric_limits<uint64_t>::max()) {
+  if (arena_bytes == std::numeric_limits<uint64_t>::max() ||
+      !emel::model::reserve_tables(fixture.model_data, requirements.tensor_count,
+                                   requirements.kv_count)) {
     return emel::error::cast(emel::model::loader::error::backend_error);
   }
 
@@ -1953,6 +1987,205 @@ make_reference_context(llama_model *model,
   return probe;
 }
 
+// Opens the counter group and arms the session's recorder when the kernel
+// profile was requested; nullptr leaves the generator unprofiled.
+emel::kernel::profile::recorder *open_kernel_profile(emel_session &session) {
+  const char *path = std::getenv(k_generation_kernel_profile_env);
+  if (path == nullptr || path[0] == '\0') {
+    return nullptr;
+  }
+  if (!session.kernel_perf.open()) {
+    std::fprintf(stderr,
+                 "warning: %s set but perf_event_open is unavailable; "
+                 "running unprofiled\n",
+                 k_generation_kernel_profile_env);
+    return nullptr;
+  }
+  session.kernel_profile = std::make_unique<emel::kernel::profile::recorder>();
+  emel::kernel::profile::reset(*session.kernel_profile,
+                               &emel::bench::kernel_profile::perf_group::read,
+                               &session.kernel_perf);
+  return session.kernel_profile.get();
+}
+
+void publish_kernel_profile(const emel_session &session,
+                            const std::string_view case_name) {
+  const char *path = std::getenv(k_generation_kernel_profile_env);
+  if (session.kernel_profile == nullptr || path == nullptr) {
+    return;
+  }
+  emel::bench::kernel_profile::print_table(stderr, case_name,
+                                           *session.kernel_profile);
+  if (!emel::bench::kernel_profile::append_csv(path, case_name,
+                                               *session.kernel_profile)) {
+    std::fprintf(stderr, "warning: failed to write kernel profile to %s\n",
+                 path);
+  }
+}
+
+// Prints the case's kernel roofline against the host ceilings (measured
+// once per process) when EMEL_BENCH_ROOFLINE is set. The case time spans the
+// whole request, so the achieved rates are lower bounds for the kernels.
+void publish_roofline(const std::string_view case_name,
+                      const emel::kernel::roofline::cost &cost,
+                      const emel::bench::result &measured) {
+  const char *enabled = std::getenv(k_generation_roofline_env);
+  if (enabled == nullptr || enabled[0] == '\0' || enabled[0] == '0') {
+    return;
+  }
+  static const emel::bench::roofline::host_peak peak =
+      emel::bench::roofline::measure_host_peak(static_cast<std::uint32_t>(
+          std::max<int32_t>(1, generation_emel_thread_count())));
+  emel::bench::roofline::print_line(stderr, case_name, cost,
+                                    measured.ns_per_op * 1.0e-9, peak);
+}
+
+// Starts the case's timeline when EMEL_BENCH_TRACE is set. Rings cover the
+// caller, the matmul lanes and a few pool workers; more threads are dropped.
+void start_trace(emel_session &session) {
+  const char *prefix = std::getenv(k_generation_trace_env);
+  if (prefix == nullptr || prefix[0] == '\0') {
+    return;
+  }
+  if constexpr (!emel::trace::k_enabled) {
+    static const bool warned = [] {
+      std::fprintf(stderr,
+                   "warning: %s set but the build has no EMEL_ENABLE_TRACE; "
+                   "running untraced\n",
+                   k_generation_trace_env);
+      return true;
+    }();
+    (void)warned;
+    return;
+  }
+  if (session.trace == nullptr) {
+    session.trace = std::make_unique<emel::bench::trace_export::recording>(
+        static_cast<size_t>(std::max<int32_t>(1, generation_emel_thread_count())) +
+        4u);
+  }
+  session.trace->start();
+}
+
+void publish_trace(emel_session &session, const std::string_view case_name) {
+  const char *prefix = std::getenv(k_generation_trace_env);
+  if (session.trace == nullptr || prefix == nullptr) {
+    return;
+  }
+  session.trace->stop();
+  std::string path = std::string{prefix} + ".";
+  for (const char ch : case_name) {
+    path.push_back(ch == '/' || ch == ' ' ? '_' : ch);
+  }
+  path += ".json";
+  if (!session.trace->write(path.c_str())) {
+    std::fprintf(stderr, "warning: failed to write trace to %s\n",
+                 path.c_str());
+  }
+}
+
+bool generation_latency_requested() {
+  const char *enabled = std::getenv(k_generation_latency_env);
+  return enabled != nullptr && enabled[0] != '\0' && enabled[0] != '0';
+}
+
+// Allocates the session's latency recorder when EMEL_BENCH_LATENCY is set;
+// nullptr leaves the generator unrecorded.
+emel::text::generator::latency::recorder *open_latency(emel_session &session) {
+  if (!generation_latency_requested()) {
+    return nullptr;
+  }
+  session.latency =
+      std::make_unique<emel::text::generator::latency::recorder>();
+  emel::text::generator::latency::reset(
+      *session.latency, &emel::bench::trace_export::steady_ns);
+  return session.latency.get();
+}
+
+// Clears the histograms so a case's percentiles cover its own runs only.
+void start_latency(emel_session &session) {
+  if (session.latency != nullptr) {
+    emel::text::generator::latency::reset(
+        *session.latency, &emel::bench::trace_export::steady_ns);
+  }
+}
+
+void publish_latency(emel_session &session, const std::string_view case_name) {
+  emel::text::generator::diagnostics diagnostics = {};
+  if (session.latency == nullptr ||
+      !capture_generator_diagnostics(session, diagnostics)) {
+    return;
+  }
+  namespace latency = emel::text::generator::latency;
+  const latency::summary &summary = diagnostics.latency;
+  for (size_t index = 0; index < latency::k_metric_count; ++index) {
+    const latency::percentiles &sample = summary.metrics[index];
+    if (sample.count == 0u) {
+      continue;
+    }
+    const std::string_view name =
+        latency::metric_name(static_cast<latency::metric>(index));
+    std::fprintf(stderr,
+                 "# latency: case=%.*s metric=%.*s count=%llu p50_us=%.3f "
+                 "p90_us=%.3f p99_us=%.3f max_us=%.3f mean_us=%.3f\n",
+                 static_cast<int>(case_name.size()), case_name.data(),
+                 static_cast<int>(name.size()), name.data(),
+                 static_cast<unsigned long long>(sample.count),
+                 static_cast<double>(sample.p50_ns) * 1.0e-3,
+                 static_cast<double>(sample.p90_ns) * 1.0e-3,
+                 static_cast<double>(sample.p99_ns) * 1.0e-3,
+                 static_cast<double>(sample.max_ns) * 1.0e-3,
+                 static_cast<double>(sample.total_ns) /
+                     static_cast<double>(sample.count) * 1.0e-3);
+  }
+  const uint64_t prefill_ns =
+      summary.metrics[static_cast<size_t>(latency::metric::prefill)].total_ns;
+  if (prefill_ns != 0u) {
+    std::fprintf(stderr,
+                 "# latency: case=%.*s prefill_tokens=%llu "
+                 "prefill_tokens_per_s=%.3f\n",
+                 static_cast<int>(case_name.size()), case_name.data(),
+                 static_cast<unsigned long long>(summary.prefill_tokens),
+                 static_cast<double>(summary.prefill_tokens) * 1.0e9 /
+                     static_cast<double>(prefill_ns));
+  }
+}
+
+bool generation_footprint_requested() {
+  const char *enabled = std::getenv(k_generation_footprint_env);
+  return enabled != nullptr && enabled[0] != '\0' && enabled[0] != '0';
+}
+
+void print_footprint(emel_session &session, const std::string_view case_name,
+                     const std::string_view phase) {
+  namespace footprint = emel::memory::footprint;
+  footprint::report report = {};
+  if (!generation_footprint_requested() ||
+      !capture_generator_footprint(session, report)) {
+    return;
+  }
+  std::fprintf(stderr,
+               "# footprint: case=%.*s phase=%.*s mapped_weights=%llu "
+               "touched_weights=%llu untouched_weights=%llu "
+               "prepared_weights=%llu kv_cache=%llu recurrent_state=%llu "
+               "scratch=%llu tokenizer=%llu session=%llu resident=%llu "
+               "process_rss=%llu\n",
+               static_cast<int>(case_name.size()), case_name.data(),
+               static_cast<int>(phase.size()), phase.data(),
+               static_cast<unsigned long long>(report.mapped_weight_bytes),
+               static_cast<unsigned long long>(report.mapped_weight_touched_bytes),
+               static_cast<unsigned long long>(
+                   footprint::untouched_weight_bytes(report)),
+               static_cast<unsigned long long>(report.prepared_weight_bytes),
+               static_cast<unsigned long long>(report.kv_cache_bytes),
+               static_cast<unsigned long long>(report.recurrent_state_bytes),
+               static_cast<unsigned long long>(report.scratch_bytes),
+               static_cast<unsigned long long>(report.tokenizer_bytes),
+               static_cast<unsigned long long>(footprint::session_bytes(report)),
+               static_cast<unsigned long long>(footprint::resident_bytes(report)),
+               static_cast<unsigned long long>(
+                   emel::bench::footprint_probe::process_rss_bytes()));
+}
+
 bool prepare_emel_session(const emel_fixture &fixture, emel_session &session) {
   session.model_data = fixture.model_data;
   session.formatter_binding = fixture.formatter_binding;
@@ -1964,14 +2197,17 @@ bool prepare_emel_session(const emel_fixture &fixture, emel_session &session) {
   const auto matmul_policy =
       emel::kernel::matmul::make_auto_execution_policy(
           session.parallel_matmul_lanes);
+  auto runtime_policy =
+      emel::tools::generation_route::make_current_runtime_policy(
+          session.model_data);
+  runtime_policy.kernel_profile = open_kernel_profile(session);
+  runtime_policy.latency = open_latency(session);
   session.generator = std::make_unique<emel::text::generator::sm>(
       emel::text::generator::dependencies{
           .generation_contract = session.generation_contract,
           .conditioner = session.conditioner,
           .matmul_policy = matmul_policy,
-          .runtime_policy =
-              emel::tools::generation_route::make_current_runtime_policy(
-                  session.model_data),
+          .runtime_policy = runtime_policy,
           .formatter_ctx = session.formatter_binding.formatter_ctx,
           .format_prompt = session.formatter_binding.format_prompt,
       });
@@ -2878,6 +3114,7 @@ void append_emel_generation_cases_for_current_benchmark_lane(
         volatile std::size_t sink = 0u;
         generation_seam_audit seam = {};
         std::uint64_t kernel_dispatch_calls = 0u;
+        emel::kernel::roofline::cost roofline_cost = {};
         std::uint64_t flash_dispatch_calls = 0u;
         std::uint64_t optimized_flash_dispatch_calls = 0u;
         std::uint64_t shared_flash_dispatch_calls = 0u;
@@ -2937,6 +3174,10 @@ void append_emel_generation_cases_for_current_benchmark_lane(
                              generation_case.name.data());
           }
           seam = session->seam;
+          roofline_cost = {
+              .flops = after.roofline_flops - before.roofline_flops,
+              .bytes = after.roofline_bytes - before.roofline_bytes,
+          };
           kernel_dispatch_calls = after.kernel_dispatch_calls -
                                   before.kernel_dispatch_calls;
           flash_dispatch_calls = after.flash_attention_dispatch_calls -
@@ -2971,7 +3212,15 @@ void append_emel_generation_cases_for_current_benchmark_lane(
 
         const std::string case_name =
             generation_benchmark_case_name(generation_case.name);
+        start_trace(*session);
+        start_latency(*session);
+        print_footprint(*session, case_name, "start");
         results.push_back(measure_case(case_name.c_str(), case_cfg, fn));
+        publish_trace(*session, case_name);
+        publish_latency(*session, case_name);
+        print_footprint(*session, case_name, "end");
+        publish_kernel_profile(*session, case_name);
+        publish_roofline(case_name, roofline_cost, results.back());
         result &compare_record = results.back();
         compare_record.compare_group = generation_case.manifest.compare_group;
         compare_record.benchmark_lane =
@@ -3101,6 +3350,7 @@ void append_emel_generation_cases_for_current_benchmark_lane(
       volatile std::size_t sink = 0u;
       generation_seam_audit seam = {};
       std::uint64_t kernel_dispatch_calls = 0u;
+      emel::kernel::roofline::cost roofline_cost = {};
       std::uint64_t flash_dispatch_calls = 0u;
       std::uint64_t optimized_flash_dispatch_calls = 0u;
       std::uint64_t shared_flash_dispatch_calls = 0u;
@@ -3159,6 +3409,10 @@ void append_emel_generation_cases_for_current_benchmark_lane(
                            generation_case.name.data());
         }
         seam = session->seam;
+        roofline_cost = {
+            .flops = after.roofline_flops - before.roofline_flops,
+            .bytes = after.roofline_bytes - before.roofline_bytes,
+        };
         kernel_dispatch_calls = after.kernel_dispatch_calls -
                                 before.kernel_dispatch_calls;
         flash_dispatch_calls = after.flash_attention_dispatch_calls -
@@ -3192,7 +3446,15 @@ void append_emel_generation_cases_for_current_benchmark_lane(
 
       const std::string case_name =
           generation_benchmark_case_name(generation_case.name);
+      start_trace(*session);
+      start_latency(*session);
+      print_footprint(*session, case_name, "start");
       results.push_back(measure_case(case_name.c_str(), case_cfg, fn));
+      publish_trace(*session, case_name);
+      publish_latency(*session, case_name);
+      print_footprint(*session, case_name, "end");
+      publish_kernel_profile(*session, case_name);
+      publish_roofline(case_name, roofline_cost, results.back());
       result &compare_record = results.back();
       compare_record.compare_group = generation_case.manifest.compare_group;
       compare_record.benchmark_lane =
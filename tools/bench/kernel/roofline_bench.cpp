@@ -0,0 +1,197 @@
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <string_view>
+#include <vector>
+
+#include "emel/kernel/detail.hpp"
+#include "emel/kernel/events.hpp"
+#include "emel/kernel/roofline.hpp"
+#include "emel/kernel/sm.hpp"
+
+#include "kernel/roofline_host.hpp"
+
+// Standalone roofline case: measures the host ceilings, then times the
+// decode-shaped kernel routes (one GEMV per weight dtype, a fused norm and a
+// flash-attention step) on the host kernel and prints each against the roof.
+//
+//   roofline_bench [samples] [threads]
+//
+// Kernel routes run on the calling thread, so compare them with the
+// single-thread ceiling; `threads` only widens the ceiling measurement.
+namespace {
+
+using dtype = emel::kernel::event::dtype;
+namespace roofline = emel::kernel::roofline;
+
+constexpr uint64_t k_decode_cols = 2048u;
+constexpr uint64_t k_decode_rows = 2048u;
+constexpr uint64_t k_head_dim = 64u;
+constexpr uint64_t k_head_count = 32u;
+constexpr uint64_t k_kv_head_count = 8u;
+constexpr uint64_t k_kv_tokens = 1024u;
+
+template <class tensor_type>
+void fill_dense_nb(tensor_type &tensor, const uint64_t elem_size) {
+  tensor.nb[0] = elem_size;
+  tensor.nb[1] = tensor.nb[0] * tensor.ne[0];
+  tensor.nb[2] = tensor.nb[1] * tensor.ne[1];
+  tensor.nb[3] = tensor.nb[2] * tensor.ne[2];
+}
+
+emel::kernel::event::tensor_view make_dense_src(const void *data,
+                                                const dtype type,
+                                                const uint64_t elem_size,
+                                                const uint64_t ne0,
+                                                const uint64_t ne1,
+                                                const uint64_t ne2 = 1u) {
+  emel::kernel::event::tensor_view tensor{};
+  tensor.data = data;
+  tensor.type = type;
+  tensor.ne = {ne0, ne1, ne2, 1u};
+  fill_dense_nb(tensor, elem_size);
+  return tensor;
+}
+
+emel::kernel::event::tensor_view_mut make_f32_dst(float *data,
+                                                  const uint64_t ne0,
+                                                  const uint64_t ne1,
+                                                  const uint64_t ne2 = 1u) {
+  emel::kernel::event::tensor_view_mut tensor{};
+  tensor.data = data;
+  tensor.type = dtype::f32;
+  tensor.ne = {ne0, ne1, ne2, 1u};
+  fill_dense_nb(tensor, sizeof(float));
+  return tensor;
+}
+
+template <class event_type>
+bool run_case(emel::kernel::sm &machine, const std::string_view name,
+              const event_type &ev, const int samples,
+              const emel::bench::roofline::host_peak &peak) {
+  if (!machine.process_event(ev)) {
+    std::fprintf(stderr, "roofline case %.*s rejected by the kernel\n",
+                 static_cast<int>(name.size()), name.data());
+    return false;
+  }
+  double best = 0.0;
+  for (int sample = 0; sample < samples; ++sample) {
+    const auto begin = std::chrono::steady_clock::now();
+    (void)machine.process_event(ev);
+    const double seconds = std::chrono::duration<double>(
+                               std::chrono::steady_clock::now() - begin)
+                               .count();
+    best = sample == 0 ? seconds : std::min(best, seconds);
+  }
+  emel::bench::roofline::print_line(stdout, name, roofline::op_cost(ev), best,
+                                    peak);
+  return true;
+}
+
+bool run_gemv(emel::kernel::sm &machine, const std::string_view name,
+              const dtype type, const int samples,
+              const emel::bench::roofline::host_peak &peak) {
+  const uint8_t code = emel::kernel::detail::dtype_code(type);
+  const size_t row_bytes =
+      type == dtype::f32
+          ? k_decode_cols * sizeof(float)
+          : emel::kernel::detail::quantized_row_storage_bytes(code,
+                                                              k_decode_cols);
+  // Small normal f16 scales everywhere; the values do not move the timing.
+  std::vector<uint8_t> weights(row_bytes * k_decode_rows, 0x11u);
+  std::vector<float> input(k_decode_cols, 0.25f);
+  std::vector<float> output(k_decode_rows, 0.0f);
+
+  emel::kernel::event::op_mul_mat ev{};
+  ev.src0.data = weights.data();
+  ev.src0.type = type;
+  ev.src0.ne = {k_decode_cols, k_decode_rows, 1u, 1u};
+  ev.src0.nb = {type == dtype::f32 ? sizeof(float) : 1u, row_bytes,
+                row_bytes * k_decode_rows, row_bytes * k_decode_rows};
+  if (type == dtype::f32) {
+    std::fill_n(reinterpret_cast<float *>(weights.data()),
+                k_decode_cols * k_decode_rows, 0.001f);
+  }
+  ev.src1 = make_dense_src(input.data(), dtype::f32, sizeof(float), 1u,
+                           k_decode_cols);
+  ev.dst = make_f32_dst(output.data(), 1u, k_decode_rows);
+  return run_case(machine, name, ev, samples, peak);
+}
+
+bool run_rms_norm(emel::kernel::sm &machine, const int samples,
+                  const emel::bench::roofline::host_peak &peak) {
+  std::vector<float> input(k_decode_cols, 0.5f);
+  std::vector<float> output(k_decode_cols, 0.0f);
+  emel::kernel::event::op_rms_norm ev{
+      .src0 = make_dense_src(input.data(), dtype::f32, sizeof(float),
+                             k_decode_cols, 1u),
+      .dst = make_f32_dst(output.data(), k_decode_cols, 1u),
+  };
+  const float epsilon = 1.0e-6f;
+  std::memcpy(ev.op_params.data(), &epsilon, sizeof(epsilon));
+  ev.op_params_size = sizeof(epsilon);
+  return run_case(machine, "kernel/roofline/op_rms_norm", ev, samples, peak);
+}
+
+bool run_flash_attention(emel::kernel::sm &machine, const int samples,
+                         const emel::bench::roofline::host_peak &peak) {
+  std::vector<float> q(k_head_dim * k_head_count, 0.125f);
+  const uint16_t half = emel::kernel::detail::quant::fp32_to_fp16(0.0625f);
+  std::vector<uint16_t> k(k_head_dim * k_kv_tokens * k_kv_head_count, half);
+  std::vector<uint16_t> v(k.size(), half);
+  std::vector<float> out(q.size(), 0.0f);
+
+  emel::kernel::event::op_flash_attn_ext ev{
+      .src0 = make_dense_src(q.data(), dtype::f32, sizeof(float), k_head_dim,
+                             1u, k_head_count),
+      .src1 = make_dense_src(k.data(), dtype::f16, sizeof(uint16_t),
+                             k_head_dim, k_kv_tokens, k_kv_head_count),
+      .src2 = make_dense_src(v.data(), dtype::f16, sizeof(uint16_t),
+                             k_head_dim, k_kv_tokens, k_kv_head_count),
+      .dst = make_f32_dst(out.data(), k_head_dim, 1u, k_head_count),
+  };
+  const float scale = 1.0f / std::sqrt(static_cast<float>(k_head_dim));
+  const auto masked_total_tokens = static_cast<uint32_t>(k_kv_tokens);
+  std::memcpy(ev.op_params.data(), &scale, sizeof(scale));
+  std::memcpy(ev.op_params.data() + sizeof(scale), &masked_total_tokens,
+              sizeof(masked_total_tokens));
+  ev.op_params_size = sizeof(scale) + sizeof(masked_total_tokens);
+  return run_case(machine, "kernel/roofline/op_flash_attn_ext_decode", ev,
+                  samples, peak);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  const int samples = argc > 1 ? std::max(5, std::atoi(argv[1])) : 21;
+  const auto threads =
+      static_cast<uint32_t>(argc > 2 ? std::max(1, std::atoi(argv[2])) : 1);
+  const emel::bench::roofline::host_peak single =
+      emel::bench::roofline::measure_host_peak(1u);
+  std::printf("# roofline_host: threads=1 peak_gbps=%.3f peak_gflops=%.3f\n",
+              single.gbps, single.gflops);
+  if (threads > 1u) {
+    const emel::bench::roofline::host_peak wide =
+        emel::bench::roofline::measure_host_peak(threads);
+    std::printf("# roofline_host: threads=%u peak_gbps=%.3f peak_gflops=%.3f\n",
+                wide.threads, wide.gbps, wide.gflops);
+  }
+
+  emel::kernel::sm machine{};
+  const bool ok =
+      run_gemv(machine, "kernel/roofline/op_mul_mat_f32", dtype::f32, samples,
+               single) &&
+      run_gemv(machine, "kernel/roofline/op_mul_mat_q8_0", dtype::q8_0,
+               samples, single) &&
+      run_gemv(machine, "kernel/roofline/op_mul_mat_q4_k", dtype::q4_k,
+               samples, single) &&
+      run_gemv(machine, "kernel/roofline/op_mul_mat_q6_k", dtype::q6_k,
+               samples, single) &&
+      run_rms_norm(machine, samples, single) &&
+      run_flash_attention(machine, samples, single);
+  return ok ? 0 : 1;
+}
@@ -0,0 +1,141 @@
+#pragma once
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+#include <thread>
+#include <vector>
+
+#include "emel/kernel/roofline.hpp"
+
+// Host ceilings for emel::kernel::roofline costs: a STREAM-style triad for
+// memory bandwidth and an FMA-chain loop for compute, each the best of a few
+// timed passes over `threads` threads, plus the line both the roofline bench
+// and the generation bench print.
+//
+// The triad counts 3 * 4 bytes per element (two loads, one store; no
+// write-allocate), as STREAM does. The compute loop is plain float code the
+// compiler vectorizes for the build flags, so its peak is what this binary
+// can reach, not the datasheet number.
+namespace emel::bench::roofline {
+
+struct host_peak {
+  double gbps = 0.0;
+  double gflops = 0.0;
+  std::uint32_t threads = 1u;
+};
+
+template <class body_fn>
+inline double best_seconds(const std::uint32_t threads, const int passes,
+                           body_fn &&body) {
+  double best = 0.0;
+  std::vector<std::thread> workers{};
+  for (int pass = 0; pass < passes; ++pass) {
+    workers.clear();
+    const auto begin = std::chrono::steady_clock::now();
+    for (std::uint32_t lane = 1u; lane < threads; ++lane) {
+      workers.emplace_back(body, lane);
+    }
+    body(0u);
+    for (std::thread &worker : workers) {
+      worker.join();
+    }
+    const double seconds =
+        std::chrono::duration<double>(std::chrono::steady_clock::now() - begin)
+            .count();
+    best = pass == 0 ? seconds : std::min(best, seconds);
+  }
+  return best;
+}
+
+// a = b + s * c over arrays far larger than the last-level cache.
+inline double stream_triad_gbps(const std::size_t elements,
+                                const std::uint32_t threads,
+                                const int passes) {
+  std::vector<float> a(elements, 0.0f);
+  std::vector<float> b(elements, 1.0f);
+  std::vector<float> c(elements, 2.0f);
+  const std::size_t per_lane = (elements + threads - 1u) / threads;
+  const double seconds = best_seconds(threads, passes, [&](const std::uint32_t lane) {
+    const std::size_t first = std::min(elements, per_lane * lane);
+    const std::size_t last = std::min(elements, first + per_lane);
+    float *const out = a.data();
+    const float *const lhs = b.data();
+    const float *const rhs = c.data();
+    for (std::size_t index = first; index < last; ++index) {
+      out[index] = lhs[index] + 3.0f * rhs[index];
+    }
+  });
+  const double bytes = 3.0 * static_cast<double>(elements) * sizeof(float);
+  return seconds > 0.0 && a[elements / 2u] == 7.0f ? bytes / seconds * 1.0e-9
+                                                   : 0.0;
+}
+
+// Independent multiply-add chains, wide enough to cover FMA latency.
+inline double fma_gflops(const std::uint32_t threads, const int passes) {
+  constexpr std::size_t k_chains = 64u;
+  constexpr std::uint64_t k_rounds = 1u << 20u;
+  std::vector<float> sinks(threads, 0.0f);
+  const double seconds = best_seconds(threads, passes, [&](const std::uint32_t lane) {
+    float acc[k_chains];
+    for (std::size_t chain = 0; chain < k_chains; ++chain) {
+      acc[chain] = static_cast<float>(chain + lane) * 1.0e-3f;
+    }
+    for (std::uint64_t round = 0; round < k_rounds; ++round) {
+      for (std::size_t chain = 0; chain < k_chains; ++chain) {
+        acc[chain] = acc[chain] * 0.999999f + 1.0e-7f;
+      }
+    }
+    float sum = 0.0f;
+    for (const float value : acc) {
+      sum += value;
+    }
+    sinks[lane] = sum;
+  });
+  const double flops = 2.0 * static_cast<double>(k_chains) *
+                       static_cast<double>(k_rounds) * threads;
+  return seconds > 0.0 && sinks[0] != 0.0f ? flops / seconds * 1.0e-9 : 0.0;
+}
+
+inline host_peak measure_host_peak(const std::uint32_t threads) {
+  const std::uint32_t lanes = std::max(1u, threads);
+  constexpr std::size_t k_triad_elements = std::size_t{32} << 20u;  // 3 x 128 MiB
+  return host_peak{
+      .gbps = stream_triad_gbps(k_triad_elements, lanes, 5),
+      .gflops = fma_gflops(lanes, 5),
+      .threads = lanes,
+  };
+}
+
+// Achieved rates of `cost` run in `seconds`, and the share of the roof at its
+// arithmetic intensity (min(compute peak, intensity * bandwidth peak)).
+inline void print_line(std::FILE *out, const std::string_view name,
+                       const emel::kernel::roofline::cost &cost,
+                       const double seconds, const host_peak &peak) {
+  const double gbps =
+      seconds > 0.0 ? static_cast<double>(cost.bytes) / seconds * 1.0e-9 : 0.0;
+  const double gflops =
+      seconds > 0.0 ? static_cast<double>(cost.flops) / seconds * 1.0e-9 : 0.0;
+  const double intensity =
+      cost.bytes == 0u ? 0.0
+                       : static_cast<double>(cost.flops) /
+                             static_cast<double>(cost.bytes);
+  const double roof = std::min(peak.gflops, intensity * peak.gbps);
+  const bool memory_bound = intensity * peak.gbps < peak.gflops;
+  const double attained =
+      roof > 0.0 ? gflops / roof : (peak.gbps > 0.0 ? gbps / peak.gbps : 0.0);
+  std::fprintf(out,
+               "# roofline: case=%.*s flops=%llu bytes=%llu seconds=%.6f "
+               "gbps=%.3f gflops=%.3f flops_per_byte=%.3f peak_gbps=%.3f "
+               "peak_gflops=%.3f threads=%u bound=%s roof_fraction=%.3f\n",
+               static_cast<int>(name.size()), name.data(),
+               static_cast<unsigned long long>(cost.flops),
+               static_cast<unsigned long long>(cost.bytes), seconds, gbps,
+               gflops, intensity, peak.gbps, peak.gflops, peak.threads,
+               memory_bound ? "memory" : "compute", attained);
+}
+
+}  // namespace emel::bench::roofline
@@ -0,0 +1,215 @@
+#pragma once
+
+#include <cinttypes>
+#include <cstdint>
+#include <cstdio>
+#include <string_view>
+
+#if defined(__linux__)
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+#include "emel/kernel/profile.hpp"
+
+// Owner side of emel::kernel::profile for the bench tools: one perf_event_open
+// group (cycles leading instructions and LLC misses) on the calling thread,
+// read as a unit around every profiled dispatch, plus the table and CSV
+// writers. Without perf events (non-Linux, or perf_event_paranoid too strict)
+// open() fails and the bench runs unprofiled.
+namespace emel::bench::kernel_profile {
+
+class perf_group {
+ public:
+  perf_group() = default;
+  perf_group(const perf_group &) = delete;
+  perf_group &operator=(const perf_group &) = delete;
+  ~perf_group() { close(); }
+
+  bool open() noexcept {
+#if defined(__linux__)
+    close();
+    leader_ = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+    if (leader_ >= 0) {
+      instructions_ = open_counter(PERF_COUNT_HW_INSTRUCTIONS, leader_);
+      llc_misses_ = open_counter(PERF_COUNT_HW_CACHE_MISSES, leader_);
+    }
+    if (leader_ < 0 || instructions_ < 0 || llc_misses_ < 0) {
+      close();
+      return false;
+    }
+    ioctl(leader_, PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+    ioctl(leader_, PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+    return true;
+#else
+    return false;
+#endif
+  }
+
+  void close() noexcept {
+#if defined(__linux__)
+    for (int *fd : {&llc_misses_, &instructions_, &leader_}) {
+      if (*fd >= 0) {
+        ::close(*fd);
+        *fd = -1;
+      }
+    }
+#endif
+  }
+
+  // emel::kernel::profile::read_fn
+  static bool read(void *owner,
+                   emel::kernel::profile::counters &out) noexcept {
+#if defined(__linux__)
+    const auto &group = *static_cast<const perf_group *>(owner);
+    // PERF_FORMAT_GROUP layout: nr, then one value per member in open order.
+    std::uint64_t values[4] = {};
+    if (group.leader_ < 0 ||
+        ::read(group.leader_, values, sizeof(values)) !=
+            static_cast<ssize_t>(sizeof(values)) ||
+        values[0] != 3u) {
+      return false;
+    }
+    out.cycles = values[1];
+    out.instructions = values[2];
+    out.llc_misses = values[3];
+    return true;
+#else
+    (void)owner;
+    (void)out;
+    return false;
+#endif
+  }
+
+ private:
+#if defined(__linux__)
+  // User-space counts of the calling thread on any CPU; the leader starts
+  // disabled and enables the whole group at once.
+  static int open_counter(const std::uint64_t config,
+                          const int group_fd) noexcept {
+    perf_event_attr attr{};
+    attr.size = sizeof(attr);
+    attr.type = PERF_TYPE_HARDWARE;
+    attr.config = config;
+    attr.disabled = group_fd == -1 ? 1u : 0u;
+    attr.exclude_kernel = 1u;
+    attr.exclude_hv = 1u;
+    attr.read_format = PERF_FORMAT_GROUP;
+    return static_cast<int>(
+        syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0ul));
+  }
+#endif
+
+  int leader_ = -1;
+  int instructions_ = -1;
+  int llc_misses_ = -1;
+};
+
+inline double ratio(const std::uint64_t num, const std::uint64_t den) noexcept {
+  return den == 0u ? 0.0 : static_cast<double>(num) / static_cast<double>(den);
+}
+
+inline std::string_view kind_name(const emel::kernel::kernel_kind kind) noexcept {
+  return kind == emel::kernel::kernel_kind::aarch64 ? "aarch64" : "x86_64";
+}
+
+// Human-readable summary: routes by cycles, then the per-stage split summed
+// over layers.
+inline void print_table(std::FILE *out, const std::string_view case_name,
+                        const emel::kernel::profile::recorder &profile) {
+  namespace profile_ns = emel::kernel::profile;
+  std::fprintf(out, "kernel profile: %.*s (dropped %" PRIu64 ")\n",
+               static_cast<int>(case_name.size()), case_name.data(),
+               profile.dropped);
+  std::fprintf(out, "  %-8s %-22s %5s %5s %10s %14s %6s %10s %10s\n", "kind",
+               "op", "src0", "src1", "calls", "cycles", "ipc", "cyc/byte",
+               "llc/kib");
+  for (std::uint32_t index = 0; index < profile.route_count; ++index) {
+    const profile_ns::route_sample &route = profile.routes[index];
+    const std::string_view op = emel::kernel::op_name(route.key.op);
+    const std::string_view kind = kind_name(route.key.kind);
+    std::fprintf(out,
+                 "  %-8.*s %-22.*s %5u %5u %10" PRIu64 " %14" PRIu64
+                 " %6.2f %10.3f %10.3f\n",
+                 static_cast<int>(kind.size()), kind.data(),
+                 static_cast<int>(op.size()), op.data(),
+                 static_cast<unsigned>(route.key.src0),
+                 static_cast<unsigned>(route.key.src1), route.total.calls,
+                 route.total.cycles,
+                 ratio(route.total.instructions, route.total.cycles),
+                 ratio(route.total.cycles, route.total.bytes_read),
+                 ratio(route.total.llc_misses * 1024u, route.total.bytes_read));
+  }
+  for (std::size_t which = 0; which < profile_ns::k_stage_count; ++which) {
+    const auto stage = static_cast<profile_ns::stage>(which);
+    profile_ns::totals sum{};
+    for (std::int32_t layer = 0; layer <= profile_ns::k_max_layers; ++layer) {
+      profile_ns::accumulate(sum, profile_ns::stage_totals(profile, layer, stage));
+    }
+    if (sum.calls == 0u) {
+      continue;
+    }
+    const std::string_view name = profile_ns::stage_name(stage);
+    std::fprintf(out, "  stage %-22.*s calls %10" PRIu64 " cycles %14" PRIu64
+                      " ipc %6.2f\n",
+                 static_cast<int>(name.size()), name.data(), sum.calls,
+                 sum.cycles, ratio(sum.instructions, sum.cycles));
+  }
+}
+
+// Appends one row per route and per (layer, stage) with samples; writes the
+// header when the file is new or empty.
+inline bool append_csv(const char *path, const std::string_view case_name,
+                       const emel::kernel::profile::recorder &profile) {
+  namespace profile_ns = emel::kernel::profile;
+  std::FILE *file = std::fopen(path, "a");
+  if (file == nullptr) {
+    return false;
+  }
+  if (std::fseek(file, 0, SEEK_END) == 0 && std::ftell(file) == 0) {
+    std::fputs("case,table,kind,op,src0_dtype,src1_dtype,layer,stage,calls,"
+               "cycles,instructions,llc_misses,bytes_read\n",
+               file);
+  }
+  const auto write_row = [&](const std::string_view table,
+                             const std::string_view kind,
+                             const std::string_view op, const int src0,
+                             const int src1, const int layer,
+                             const std::string_view stage,
+                             const profile_ns::totals &total) {
+    std::fprintf(file,
+                 "%.*s,%.*s,%.*s,%.*s,%d,%d,%d,%.*s,%" PRIu64 ",%" PRIu64
+                 ",%" PRIu64 ",%" PRIu64 ",%" PRIu64 "\n",
+                 static_cast<int>(case_name.size()), case_name.data(),
+                 static_cast<int>(table.size()), table.data(),
+                 static_cast<int>(kind.size()), kind.data(),
+                 static_cast<int>(op.size()), op.data(), src0, src1, layer,
+                 static_cast<int>(stage.size()), stage.data(), total.calls,
+                 total.cycles, total.instructions, total.llc_misses,
+                 total.bytes_read);
+  };
+  for (std::uint32_t index = 0; index < profile.route_count; ++index) {
+    const profile_ns::route_sample &route = profile.routes[index];
+    write_row("route", kind_name(route.key.kind),
+              emel::kernel::op_name(route.key.op),
+              static_cast<int>(route.key.src0), static_cast<int>(route.key.src1),
+              -1, "", route.total);
+  }
+  for (std::int32_t layer = 0; layer <= profile_ns::k_max_layers; ++layer) {
+    for (std::size_t which = 0; which < profile_ns::k_stage_count; ++which) {
+      const auto stage = static_cast<profile_ns::stage>(which);
+      const profile_ns::totals &total =
+          profile_ns::stage_totals(profile, layer, stage);
+      if (total.calls != 0u) {
+        write_row("stage", "", "", -1, -1,
+                  layer == profile_ns::k_max_layers ? -1 : layer,
+                  profile_ns::stage_name(stage), total);
+      }
+    }
+  }
+  return std::fclose(file) == 0;
+}
+
+}  // namespace emel::bench::kernel_profile
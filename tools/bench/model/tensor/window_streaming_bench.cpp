@@ -21,6 +21,7 @@
 
 #include <algorithm>
 #include <array>
+#include <chrono>
 #include <cstdint>
 #include <cstdio>
 #include <cstdlib>
@@ -43,6 +44,7 @@
 #include "emel/memory/view.hpp"
 #include "emel/model/detail.hpp"
 #include "emel/model/generation/any.hpp"
+#include "emel/model/load_profile.hpp"
 #include "emel/model/loader/sm.hpp"
 #include "emel/model/tensor/sm.hpp"
 #include "emel/model/tensor/window/sm.hpp"
@@ -182,6 +184,8 @@ struct emel_fixture {
   emel::model::loader::sm model_loader = {};
   gguf_capture gguf = {};
   load_capture load = {};
+  // Cold-start case only: phase recorder threaded through every load event.
+  emel::model::load_profile::recorder *profile = nullptr;
 };
 
 void on_probe_done(void *owner,
@@ -263,12 +267,13 @@ bool prebind_gguf_storage(emel_fixture &fixture,
                                                                on_probe_done};
   const emel::gguf::loader::event::probe_error_fn probe_error_cb{
       &fixture, on_probe_error};
-  const emel::gguf::loader::event::probe probe_ev{
+  emel::gguf::loader::event::probe probe_ev{
       file_image,
       requirements,
       probe_done_cb,
       probe_error_cb,
   };
+  probe_ev.profile = fixture.profile;
   if (!fixture.gguf_loader.process_event(probe_ev) ||
       !fixture.gguf.probe_done || fixture.gguf.probe_error) {
     return false;
@@ -322,11 +327,12 @@ emel::error::type run_parse_model(void *owner,
                                                                on_parse_done};
   const emel::gguf::loader::event::parse_error_fn parse_error_cb{
       &fixture, on_parse_error};
-  const emel::gguf::loader::event::parse parse_ev{
+  emel::gguf::loader::event::parse parse_ev{
       file_image,
       parse_done_cb,
       parse_error_cb,
   };
+  parse_ev.profile = fixture.profile;
   if (!fixture.gguf_loader.process_event(parse_ev) ||
       !fixture.gguf.parse_done || fixture.gguf.parse_error) {
     return emel::error::cast(emel::model::loader::error::model_invalid);
@@ -343,6 +349,7 @@ emel::error::type run_parse_model(void *owner,
       .entries =
           std::span<const emel::gguf::loader::kv_entry>{
               fixture.kv_entries.data(), fixture.kv_entries.size()},
+      .profile = fixture.profile,
   };
   return emel::model::detail::load_hparams_from_gguf(binding, req.model_data)
              ? emel::error::cast(emel::model::loader::error::none)
@@ -414,6 +421,7 @@ bool load_model_from_image(emel_fixture &fixture, const std::string &model_path,
   load_ev.validate_architecture_impl = {nullptr, run_validate_architecture};
   load_ev.on_done = {&fixture, on_load_done};
   load_ev.on_error = {&fixture, on_load_error};
+  load_ev.profile = fixture.profile;
   if (!fixture.model_loader.process_event(load_ev) || !fixture.load.done ||
       fixture.load.error) {
     return false;
@@ -424,6 +432,7 @@ bool load_model_from_image(emel_fixture &fixture, const std::string &model_path,
       .entries =
           std::span<const emel::gguf::loader::kv_entry>{
               fixture.kv_entries.data(), fixture.kv_entries.size()},
+      .profile = fixture.profile,
   };
   if (!emel::model::detail::load_vocab_from_gguf(
           binding, fixture.model_data.vocab_data)) {
@@ -805,7 +814,9 @@ bool prepare_session(const emel_fixture &fixture, emel_session &session,
   return true;
 }
 
-bool initialize_session(emel_session &session, const int32_t max_tokens) {
+bool initialize_session(
+    emel_session &session, const int32_t max_tokens,
+    emel::model::load_profile::recorder *const profile = nullptr) {
   const int32_t prompt_capacity = 64;
   const int32_t decode_capacity = std::max<int32_t>(4, max_tokens);
   session.initialize = {};
@@ -836,6 +847,7 @@ bool initialize_session(emel_session &session, const int32_t max_tokens) {
                                session.model_data.params.n_ctx)));
   request.block_tokens = emel::memory::view::DEFAULT_BLOCK_TOKENS;
   request.strip_leading_space = false;
+  request.load_profile = profile;
   request.on_done = {&session, on_initialize_done};
   request.on_error = {&session, on_initialize_error};
   return session.generator->process_event(request) && session.initialize.done &&
@@ -1064,6 +1076,121 @@ void append_emel_lane_cases(std::vector<result> &results, const config &cfg,
   }
 }
 
+//------------------------------------------------------------------------------//
+// Cold start: one full load (map, GGUF scan, model load, prefault, generator
+// initialize) per iteration with the phase recorder threaded through every
+// load event. The note carries the per-phase breakdown of the last iteration.
+
+uint64_t steady_clock_ns() noexcept {
+  return static_cast<uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+uint64_t prefault_pages(const void *base, const uint64_t bytes) {
+  constexpr uint64_t k_page_bytes = 4096u;
+  const auto *pages = static_cast<const volatile uint8_t *>(base);
+  uint64_t sum = 0u;
+  for (uint64_t offset = 0u; offset < bytes; offset += k_page_bytes) {
+    sum += pages[offset];
+  }
+  return sum;
+}
+
+bool run_cold_start(const std::string &model_path, const uint64_t file_size,
+                    emel::model::load_profile::recorder &profile,
+                    volatile uint64_t &sink) {
+  namespace load_profile = emel::model::load_profile;
+  auto fixture = std::make_unique<emel_fixture>();
+  fixture->profile = &profile;
+
+  metadata_mapping mapping{};
+  uint64_t started = load_profile::start(&profile);
+  if (!mapping.map(model_path, file_size)) {
+    return false;
+  }
+  load_profile::stop(&profile, load_profile::phase::map_file, started,
+                     mapping.bytes);
+
+  const std::span<const uint8_t> image{
+      static_cast<const uint8_t *>(mapping.base),
+      static_cast<size_t>(mapping.bytes)};
+  if (!prebind_gguf_storage(*fixture, image) ||
+      !load_model_from_image(*fixture, model_path, mapping.base,
+                             mapping.bytes)) {
+    return false;
+  }
+
+  started = load_profile::start(&profile);
+  sink = sink + prefault_pages(mapping.base, mapping.bytes);
+  load_profile::stop(&profile, load_profile::phase::prefault, started,
+                     mapping.bytes);
+
+  // Declared after the mapping so the session drops its tensor views first.
+  auto session = std::make_unique<emel_session>();
+  return prepare_session(*fixture, *session, nullptr) &&
+         initialize_session(*session, 1, &profile);
+}
+
+std::string format_load_report(const emel::model::load_profile::report &report) {
+  std::string note = "total_ns=" + std::to_string(report.total_ns) +
+                     " total_bytes=" + std::to_string(report.total_bytes);
+  for (size_t index = 0; index < emel::model::load_profile::k_phase_count;
+       ++index) {
+    const auto which = static_cast<emel::model::load_profile::phase>(index);
+    const emel::model::load_profile::phase_sample &sample =
+        report.phases[index];
+    note += " " + std::string(emel::model::load_profile::phase_name(which)) +
+            "=" + std::to_string(sample.ns) + "ns/" +
+            std::to_string(sample.bytes) + "B";
+  }
+  return note;
+}
+
+void append_emel_cold_start_case(std::vector<result> &results,
+                                 const config &cfg) {
+  if (!std::filesystem::exists(fixture_path())) {
+    report_missing_fixture();
+    return;
+  }
+  std::error_code size_error{};
+  const uint64_t file_size =
+      std::filesystem::file_size(fixture_path(), size_error);
+  if (size_error || file_size == 0u) {
+    return;
+  }
+  const std::string model_path = fixture_path().string();
+
+  emel::model::load_profile::recorder profile{};
+  emel::model::load_profile::report latest{};
+  volatile uint64_t sink = 0u;
+  auto fn = [&]() {
+    emel::model::load_profile::reset(profile, steady_clock_ns);
+    if (!run_cold_start(model_path, file_size, profile, sink)) {
+      std::fprintf(stderr, "error: weight_streaming cold start load failed\n");
+      std::exit(1);
+    }
+    latest = emel::model::load_profile::make_report(profile);
+  };
+
+  const std::string case_name =
+      "weight_streaming/cold_start/lfm2_5_230m_q8_0";
+  results.push_back(measure_case(case_name.c_str(), cfg, fn));
+  result &record = results.back();
+  record.compare_group = case_name;
+  record.lane = "emel";
+  record.backend_id = "emel.cold_start";
+  record.backend_language = "cpp";
+  record.comparison_mode = "load_breakdown";
+  record.model_id = std::string(k_model_id);
+  record.fixture_id = std::string(k_fixture_rel);
+  record.comparable = false;
+  // Page-cache warm after the first iteration: the split measures parse,
+  // repack and allocation cost, not disk latency.
+  record.note = format_load_report(latest);
+}
+
 //------------------------------------------------------------------------------//
 // Reference lane (llama.cpp, mmap loading, 8 threads).
 
@@ -1231,6 +1358,7 @@ void append_emel_weight_streaming_cases(std::vector<result> &results,
   }
   append_emel_lane_cases(results, cfg, /*streamed=*/false);
   append_emel_lane_cases(results, cfg, /*streamed=*/true);
+  append_emel_cold_start_case(results, cfg);
 }
 
 void append_reference_weight_streaming_cases(std::vector<result> &results,
@@ -17,6 +17,7 @@
 #include "emel/emel.h"
 #include "emel/model/data.hpp"
 #include "emel/text/encoders/events.hpp"
+#include "emel/text/encoders/types.hpp"
 #include "emel/text/unicode.hpp"
 
 namespace emel::bench::encoder_bench {
@@ -50,6 +51,8 @@ inline int32_t add_token(emel::model::data::vocab & vocab,
   vocab.entries[id].type = type;
   vocab.token_bytes_used += len;
   vocab.n_tokens = id + 1;
+  // Stands in for the loader, which builds the shared token trie.
+  (void)emel::text::encoders::detail::prepare_token_trie(vocab);
   return static_cast<int32_t>(id);
 }
 
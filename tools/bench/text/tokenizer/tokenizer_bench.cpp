@@ -6,17 +6,23 @@
 #include <cstdio>
 #include <cstring>
 #include <memory>
+#include <span>
 #include <string>
+#include <string_view>
+#include <utility>
 #include <vector>
 
 #include "emel/emel.h"
 #include "emel/model/data.hpp"
+#include "emel/text/tokenizer/document/sm.hpp"
 #include "emel/text/tokenizer/errors.hpp"
 #include "emel/text/tokenizer/sm.hpp"
 
 namespace {
 
 constexpr size_t k_token_capacity = 4096;
+constexpr int k_document_repeats = 8192;
+constexpr size_t k_document_lanes = 4;
 constexpr int32_t k_error_none =
     emel::text::tokenizer::error_code(emel::text::tokenizer::error::none);
 
@@ -34,6 +40,8 @@ int32_t add_token(emel::model::data::vocab & vocab,
   vocab.entries[id].type = type;
   vocab.token_bytes_used += len;
   vocab.n_tokens = id + 1;
+  // Stands in for the loader, which builds the shared token trie.
+  (void)emel::text::encoders::detail::prepare_token_trie(vocab);
   return static_cast<int32_t>(id);
 }
 
@@ -225,6 +233,57 @@ void ensure_tokenizes(emel::text::tokenizer::sm & machine,
   }
 }
 
+// Tokenizes one document through the document actor and reports whether every
+// lane accepted its spans.
+bool tokenize_document_once(emel::text::tokenizer::document::sm & machine,
+                            const emel::model::data::vocab & vocab,
+                            const std::string_view text,
+                            std::span<emel::text::tokenizer::sm * const> lanes,
+                            std::vector<int32_t> & tokens,
+                            int32_t & token_count,
+                            int32_t & err) {
+  err = k_error_none;
+  emel::text::tokenizer::document::event::tokenize_document doc_ev = {};
+  doc_ev.vocab = &vocab;
+  doc_ev.text = text;
+  doc_ev.add_special = false;
+  doc_ev.parse_special = false;
+  doc_ev.lanes = lanes;
+  doc_ev.token_ids_out = tokens.data();
+  doc_ev.token_capacity = static_cast<int32_t>(tokens.size());
+  doc_ev.token_count_out = &token_count;
+  doc_ev.error_out = &err;
+  const bool accepted = machine.process_event(doc_ev);
+  return accepted && err == k_error_none;
+}
+
+void append_document_case(std::vector<emel::bench::result> & results,
+                          const emel::bench::config & cfg,
+                          const char * name,
+                          emel::text::tokenizer::document::sm & machine,
+                          const emel::model::data::vocab & vocab,
+                          const std::string_view text,
+                          std::span<emel::text::tokenizer::sm * const> lanes) {
+  std::vector<int32_t> tokens(text.size() + 2u, 0);
+  int32_t token_count = 0;
+  int32_t err = k_error_none;
+  if (!tokenize_document_once(machine, vocab, text, lanes, tokens, token_count, err)) {
+    std::fprintf(stderr, "error: document tokenizer failed (%s, err=%d)\n", name, err);
+    std::abort();
+  }
+  const int32_t expected_tokens = token_count;
+
+  auto fn = [&]() {
+    (void)tokenize_document_once(machine, vocab, text, lanes, tokens, token_count, err);
+  };
+  emel::bench::result entry = emel::bench::measure_case(name, cfg, fn);
+  entry.output_tokens = static_cast<uint64_t>(expected_tokens);
+  entry.output_bytes = static_cast<uint64_t>(text.size());
+  entry.tokens_per_second =
+      emel::bench::compute_tokens_per_second(entry.output_tokens, entry.ns_per_op);
+  results.push_back(std::move(entry));
+}
+
 struct tokenizer_case {
   const char * name = nullptr;
   std::unique_ptr<emel::model::data::vocab> (*build_vocab)() = nullptr;
@@ -281,6 +340,31 @@ void append_emel_tokenizer_cases(std::vector<result> & results, const config & c
     const std::string long_name = std::string(entry.name) + "_long";
     results.push_back(measure_case(long_name.c_str(), cfg, long_fn));
   }
+
+  // Document-scale BPE: the same text on one lane (segment loop only) and
+  // forked across a lane pool.
+  const std::string document_text = make_repeated_text(k_document_repeats);
+  auto document_vocab = make_bpe_vocab();
+  std::array<std::unique_ptr<emel::text::tokenizer::sm>, k_document_lanes> owned_lanes = {};
+  std::array<emel::text::tokenizer::sm *, k_document_lanes> lanes = {};
+  for (size_t idx = 0; idx < k_document_lanes; ++idx) {
+    owned_lanes[idx] = std::make_unique<emel::text::tokenizer::sm>();
+    if (!bind_tokenizer(*owned_lanes[idx], *document_vocab)) {
+      std::fprintf(stderr, "error: tokenizer bind failed\n");
+      std::abort();
+    }
+    lanes[idx] = owned_lanes[idx].get();
+  }
+
+  emel::text::tokenizer::document::sm serial_document{};
+  append_document_case(results, cfg, "tokenizer/document_bpe_serial", serial_document,
+                       *document_vocab, document_text,
+                       std::span<emel::text::tokenizer::sm * const>(lanes.data(), 1u));
+
+  emel::text::tokenizer::document::lane_pool pool{k_document_lanes};
+  emel::text::tokenizer::document::sm parallel_document{pool};
+  append_document_case(results, cfg, "tokenizer/document_bpe_parallel", parallel_document,
+                       *document_vocab, document_text, lanes);
 }
 
 void append_reference_tokenizer_cases(std::vector<result> & results, const config & cfg) {
@@ -0,0 +1,70 @@
+#pragma once
+
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <memory>
+#include <span>
+#include <string_view>
+
+#include "emel/trace.hpp"
+
+// Owner side of emel::trace for the bench tools: the steady-clock timestamp
+// source, heap-owned ring storage (one ring per recording thread) and the
+// Chrome trace JSON file writer. Without EMEL_ENABLE_TRACE the hooks are
+// compiled out and a recording stays empty.
+namespace emel::bench::trace_export {
+
+inline std::uint64_t steady_ns() noexcept {
+  return static_cast<std::uint64_t>(
+      std::chrono::duration_cast<std::chrono::nanoseconds>(
+          std::chrono::steady_clock::now().time_since_epoch())
+          .count());
+}
+
+class recording {
+ public:
+  explicit recording(const std::size_t ring_count)
+      : rings_(std::make_unique<emel::trace::ring[]>(ring_count)),
+        ring_count_(ring_count) {}
+
+  recording(const recording &) = delete;
+  recording &operator=(const recording &) = delete;
+  ~recording() { emel::trace::stop(); }
+
+  void start() noexcept {
+    emel::trace::start(session_, &steady_ns,
+                       std::span<emel::trace::ring>{rings_.get(), ring_count_});
+  }
+
+  void stop() noexcept { emel::trace::stop(); }
+
+  const emel::trace::session &session() const noexcept { return session_; }
+
+  // Call after stop(), once the traced threads are idle.
+  bool write(const char *path) const {
+    std::FILE *file = std::fopen(path, "w");
+    if (file == nullptr) {
+      return false;
+    }
+    emel::trace::export_chrome_json(session_, [file](const std::string_view chunk) {
+      std::fwrite(chunk.data(), 1u, chunk.size(), file);
+    });
+    const std::uint64_t dropped =
+        session_.dropped_threads.load(std::memory_order_relaxed);
+    if (dropped != 0u) {
+      std::fprintf(stderr,
+                   "warning: trace %s dropped %llu threads beyond %zu rings\n",
+                   path, static_cast<unsigned long long>(dropped), ring_count_);
+    }
+    return std::fclose(file) == 0;
+  }
+
+ private:
+  std::unique_ptr<emel::trace::ring[]> rings_;
+  std::size_t ring_count_ = 0u;
+  emel::trace::session session_ = {};
+};
+
+}  // namespace emel::bench::trace_export
@@ -424,6 +424,7 @@ int main(int argc, char **argv) {
     std::fprintf(stderr, "error: invalid Whisper tensor name metadata\n");
     return 2;
   }
+  emel::model::build_tensor_name_index(*model);
   const uint64_t binding_ns = elapsed_ns(binding_start, steady_clock::now());
 
   const auto initialize_start = steady_clock::now();
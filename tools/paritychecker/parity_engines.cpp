@@ -1244,7 +1244,9 @@ prebind_gguf_kv_storage(generation_load_state &state,
 
   const uint64_t arena_bytes =
       emel::gguf::loader::required_kv_arena_bytes(requirements);
-  if (arena_bytes == std::numeric_limits<uint64_t>::max()) {
+  if (arena_bytes == std::numeric_limits<uint64_t>::max() ||
+      !emel::model::reserve_tables(*state.model_data, requirements.tensor_count,
+                                   requirements.kv_count)) {
     return emel::error::cast(emel::model::loader::error::backend_error);
   }
 
@@ -1579,7 +1581,8 @@ bool load_emel_vocab_from_gguf_file(const std::string &model_path,
     return false;
   }
 
-  return emel::model::load_vocab_from_gguf(kv_binding_from_state(state),
+  return emel::model::reserve_vocab_tables(vocab_out) &&
+         emel::model::load_vocab_from_gguf(kv_binding_from_state(state),
                                            vocab_out);
 }
 